@@ -892,6 +892,12 @@ void achievements_tracker::clear()
     achievements_status_.clear();
 }
 
+bool achievements_tracker::wants( const event_type type ) const
+{
+    // The achievements themselves watch the stats_tracker.
+    return type == event_type::game_start;
+}
+
 void achievements_tracker::notify( const cata::event &e )
 {
     if( e.type() == event_type::game_start ) {
@@ -227,6 +227,7 @@ class achievements_tracker : public event_subscriber
         void clear();
         using event_subscriber::notify;
         void notify( const cata::event & ) override;
+        bool wants( event_type ) const override;
 
         void serialize( JsonOut & ) const;
         void deserialize( const JsonObject &jo );
@@ -1,7 +1,9 @@
 #include "active_item_cache.h"
 
 #include <algorithm>
+#include <functional>
 #include <numeric>
+#include <optional>
 #include <utility>
 
 #include "item.h"
@@ -47,24 +49,14 @@ bool active_item_cache::add( item &it, point_rel_ms location, item *parent,
     if( speed == item::NO_PROCESSING ) {
         return ret;
     }
-    std::unordered_map<item *, safe_reference<item>> &target_index = active_items_index[speed];
-    std::list<item_reference> &target_list = active_items[speed];
-    if( target_index.empty() && !target_index.empty() ) {
-        // If the index has been cleared, rebuild it first.
-        for( item_reference &iter : target_list ) {
-            // Omit those expired references
-            if( iter.item_ref ) {
-                target_index.emplace( iter.item_ref.get(), iter.item_ref );
-            }
-        }
-    }
+    const time_point now = calendar::turn;
     // If the item is already in the cache for some reason, don't add a second reference
-    auto iter = target_index.find( &it );
-    if( iter != target_index.end() ) {
-        // Ensure it's really what we want, and hasn't expired
-        if( iter->second && iter->second.get() == &it ) {
-            return true;
+    if( cached_item *entry = find( it ) ) {
+        // It may have changed in a way that needs processing before it was due.
+        if( entry->due > now ) {
+            schedule_at( *entry, now );
         }
+        return true;
     }
     item_reference ref{ location, it.get_safe_reference(), parent, pocket_chain };
     if( it.can_revive() ) {
@@ -73,30 +65,65 @@ bool active_item_cache::add( item &it, point_rel_ms location, item *parent,
     if( it.get_use( "explosion" ) ) {
         special_items[special_item_type::explosive].emplace_back( ref );
     }
-    target_list.emplace_back( std::move( ref ) );
-    target_index.emplace( &it, it.get_safe_reference() );
+    auto iter = active_items_index.find( &it );
+    if( iter == active_items_index.end() ) {
+        iter = active_items_index.emplace( &it, items.size() ).first;
+        items.emplace_back();
+    }
+    // Otherwise a destroyed item was cached at the same address, the new one takes its place.
+    cached_item &entry = items[iter->second];
+    entry = cached_item{ std::move( ref ), &it, speed, next_generation++, now };
+    // Items added together, like a stack of food dropped at once, come due on different turns.
+    schedule_at( entry, now + time_duration::from_turns( num_added++ % static_cast<unsigned int>
+                 ( speed ) ) );
     return true;
 }
 
+void active_item_cache::schedule_at( cached_item &entry, const time_point &due )
+{
+    entry.due = due;
+    schedule.push_back( due_item{ due, entry.key, entry.generation } );
+    std::push_heap( schedule.begin(), schedule.end(), std::greater<>() );
+}
+
+active_item_cache::cached_item *active_item_cache::find( const item &it )
+{
+    auto iter = active_items_index.find( const_cast<item *>( &it ) );
+    if( iter == active_items_index.end() ) {
+        return nullptr;
+    }
+    cached_item &entry = items[iter->second];
+    // Ensure it's really what we want, and hasn't expired
+    return entry.ref.item_ref.get() == &it ? &entry : nullptr;
+}
+
+void active_item_cache::remove_at( size_t pos )
+{
+    active_items_index.erase( items[pos].key );
+    if( pos + 1 != items.size() ) {
+        items[pos] = std::move( items.back() );
+        active_items_index[items[pos].key] = pos;
+    }
+    items.pop_back();
+}
+
 bool active_item_cache::empty() const
 {
-    return std::all_of( active_items.begin(), active_items.end(), []( const auto & active_queue ) {
-        return active_queue.second.empty();
+    return std::none_of( items.begin(), items.end(), []( const cached_item & entry ) {
+        return !!entry.ref.item_ref;
     } );
 }
 
 std::vector<item_reference> active_item_cache::get()
 {
     std::vector<item_reference> all_cached_items;
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        for( std::list<item_reference>::iterator it = kv.second.begin(); it != kv.second.end(); ) {
-            if( it->item_ref ) {
-                all_cached_items.emplace_back( *it );
-                ++it;
-            } else {
-                active_items_index[kv.first].clear();
-                it = kv.second.erase( it );
-            }
+    all_cached_items.reserve( items.size() );
+    for( size_t i = 0; i < items.size(); ) {
+        if( items[i].ref.item_ref ) {
+            all_cached_items.emplace_back( items[i].ref );
+            ++i;
+        } else {
+            remove_at( i );
         }
     }
     return all_cached_items;
@@ -104,76 +131,96 @@ std::vector<item_reference> active_item_cache::get()
 
 std::vector<item_reference> active_item_cache::get_for_processing()
 {
+    const time_point now = calendar::turn;
+    if( now < last_processed ) {
+        // The clock was turned back, so the schedule is of no use.
+        schedule.clear();
+        for( cached_item &entry : items ) {
+            schedule_at( entry, now );
+        }
+    }
+    last_processed = now;
+
     std::vector<item_reference> items_to_process;
-    items_to_process.reserve( std::accumulate( active_items.begin(), active_items.end(), std::size_t{ 0 },
-    []( size_t prev, const auto & kv ) {
-        return prev + kv.second.size() / static_cast<size_t>( kv.first );
-    } ) );
-    for( std::pair<const int, std::list<item_reference>> &kv : active_items ) {
-        // Rely on iteration logic to make sure the number is sane.
-        int num_to_process = kv.second.size() / kv.first;
-        std::list<item_reference>::iterator it = kv.second.begin();
-        for( ; it != kv.second.end() && num_to_process >= 0; ) {
-            if( it->item_ref ) {
-                items_to_process.push_back( *it );
-                --num_to_process;
-                ++it;
-            } else {
-                // The item has been destroyed, so remove the reference from the cache
-                active_items_index[kv.first].clear();
-                it = kv.second.erase( it );
-            }
+    while( !schedule.empty() && schedule.front().due <= now ) {
+        const due_item next_due = schedule.front();
+        std::pop_heap( schedule.begin(), schedule.end(), std::greater<>() );
+        schedule.pop_back();
+        auto iter = active_items_index.find( next_due.key );
+        if( iter == active_items_index.end() ) {
+            continue;
+        }
+        const size_t pos = iter->second;
+        cached_item &entry = items[pos];
+        if( entry.generation != next_due.generation || entry.due != next_due.due ) {
+            // Rescheduled or replaced since.
+            continue;
+        }
+        if( !entry.ref.item_ref ) {
+            // The item has been destroyed, so remove the reference from the cache
+            remove_at( pos );
+            continue;
+        }
+        items_to_process.push_back( entry.ref );
+
+        const item &it = *entry.ref.item_ref;
+        const int speed = it.processing_speed();
+        // Items that no longer need processing keep their old pace, as they used to.
+        time_point next = now + time_duration::from_turns( speed == item::NO_PROCESSING ? entry.speed :
+                          speed );
+        const std::optional<time_point> idle_until = it.idle_until();
+        if( idle_until && *idle_until > next ) {
+            // Still look at it now and then, in case it changed without being added again.
+            next = std::min( *idle_until, now + max_idle_time );
         }
-        // Rotate the returned items to the end of their list so that the items that weren't
-        // returned this time will be first in line on the next call
-        kv.second.splice( kv.second.end(), kv.second, kv.second.begin(), it );
+        schedule_at( entry, next );
     }
     return items_to_process;
 }
 
-std::vector<item_reference> active_item_cache::get_special( special_item_type type )
+void active_item_cache::sleep_until( const item &it, const time_point &until )
 {
-    std::vector<item_reference> matching_items;
-    std::list<item_reference> &items = special_items[type];
-    for( auto it = items.begin(); it != items.end(); ) {
-        if( it->item_ref ) {
-            matching_items.push_back( *it );
-            ++it;
-        } else {
-            it = items.erase( it );
-        }
+    cached_item *entry = find( it );
+    if( entry == nullptr ) {
+        return;
     }
-    return matching_items;
+    const time_point wake = std::min( until, calendar::turn + max_sleep_time );
+    if( wake > entry->due ) {
+        schedule_at( *entry, wake );
+    }
+}
+
+std::vector<item_reference> active_item_cache::get_special( special_item_type type )
+{
+    std::vector<item_reference> &special = special_items[type];
+    special.erase( std::remove_if( special.begin(), special.end(), []( const item_reference & ref ) {
+        return !ref.item_ref;
+    } ), special.end() );
+    return special;
 }
 
 void active_item_cache::subtract_locations( const point_rel_ms &delta )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            ir.location -= delta;
-        }
+    for( cached_item &entry : items ) {
+        entry.ref.location -= delta;
     }
 }
 
 void active_item_cache::rotate_locations( int turns, const point_rel_ms &dim )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            // Should 'rotate' be propaged up to the typed coordinates?
-            ir.location = ir.location.rotate( turns, dim.raw() );
-        }
+    for( cached_item &entry : items ) {
+        // Should 'rotate' be propaged up to the typed coordinates?
+        entry.ref.location = entry.ref.location.rotate( turns, dim.raw() );
     }
 }
 
 void active_item_cache::mirror( const point_rel_ms &dim, bool horizontally )
 {
-    for( std::pair<const int, std::list<item_reference>> &pair : active_items ) {
-        for( item_reference &ir : pair.second ) {
-            if( horizontally ) {
-                ir.location.x() = dim.x() - 1 - ir.location.x();
-            } else {
-                ir.location.y() = dim.y() - 1 - ir.location.y();
-            }
+    for( cached_item &entry : items ) {
+        if( horizontally ) {
+            entry.ref.location.x() = dim.x() - 1 - entry.ref.location.x();
+        } else {
+            entry.ref.location.y() = dim.y() - 1 - entry.ref.location.y();
         }
     }
 }
@@ -3,10 +3,11 @@
 #define CATA_SRC_ACTIVE_ITEM_CACHE_H
 
 #include <cstddef>
-#include <list>
+#include <cstdint>
 #include <unordered_map>
 #include <vector>
 
+#include "calendar.h"
 #include "coordinates.h"
 #include "safe_reference.h"
 
@@ -51,13 +52,59 @@ struct hash<special_item_type> {
 class active_item_cache
 {
     private:
-        std::unordered_map<int, std::list<item_reference>> active_items;
-        std::unordered_map<special_item_type, std::list<item_reference>> special_items;
-        std::unordered_map<int, std::unordered_map<item *, safe_reference<item>>> active_items_index;
+        struct cached_item {
+            item_reference ref;
+            // Key of the item in active_items_index, also once the reference has expired.
+            item *key = nullptr;
+            // item::processing_speed() when added, kept for items that stop needing processing.
+            int speed = 1;
+            // Tells this item apart from others that were cached at the same address before.
+            uint64_t generation = 0;
+            time_point due;
+        };
+        // A handle on a cached item in the schedule, outdated once the item is rescheduled or gone.
+        struct due_item {
+            time_point due;
+            item *key = nullptr;
+            uint64_t generation = 0;
+
+            bool operator>( const due_item &rhs ) const {
+                return due > rhs.due;
+            }
+        };
+        /**
+         * All cached items, in no particular order so that removing one only moves the last one
+         * into its place.  An item is rescheduled when it is handed out for processing, so it
+         * sleeps until its processing speed says it needs attention again, or until its
+         * countdown is up if it has nothing else to do until then.
+         */
+        std::vector<cached_item> items;
+        // Position of each item in items.
+        std::unordered_map<item *, size_t> active_items_index;
+        // Min-heap of the turns items are due, outdated handles are dropped as they come up.
+        std::vector<due_item> schedule;
+        std::unordered_map<special_item_type, std::vector<item_reference>> special_items;
+        // Spreads the first processing of items that get added together over their interval.
+        unsigned int num_added = 0;
+        uint64_t next_generation = 0;
+        // When items were last handed out, to notice the clock being turned back.
+        time_point last_processed = calendar::before_time_starts;
+
+        // Longest an idle item goes unprocessed.
+        static constexpr time_duration max_idle_time = 10_minutes;
+        // Longest stored food goes unprocessed, beyond that catching up replays the weather.
+        static constexpr time_duration max_sleep_time = 1_hours;
+
+        /** Sets when @p entry is next due. */
+        void schedule_at( cached_item &entry, const time_point &due );
+        /** The entry of @p it, or nullptr if it isn't cached. */
+        cached_item *find( const item &it );
+        /** Removes the entry at @p pos, the last entry takes its place. */
+        void remove_at( size_t pos );
     public:
         /**
-         * Adds the reference to the cache. Does nothing if the reference is already in the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
+         * Adds the reference to the cache. If the reference is already in the cache, it is only
+         * woken up to be processed on the next call to @ref get_for_processing.
          * These two operations are really the same, but tailored to their usages.
          * The submap coordinates are for submaps, and the relative ones are for vehicles.
          */
@@ -67,7 +114,7 @@ class active_item_cache
                   std::vector<item_pocket const *> const &pocket_chain = {} );
 
         /**
-         * Returns true if the cache is empty
+         * Returns true if the cache holds no item that still exists
          */
         bool empty() const;
 
@@ -78,15 +125,21 @@ class active_item_cache
         std::vector<item_reference> get();
 
         /**
-         * Returns the first size() / processing_speed() elements of each list, rounded up.
-         * Items returned are rotated to the back of their respective lists, otherwise only the
-         * first n items will ever be processed.
+         * Returns the items due to be processed by now, and schedules each of them again
+         * item::processing_speed() turns later, or at the end of its countdown if it is idle
+         * until then.  Calling it again in the same turn returns nothing.
          * Broken references encountered when collecting the items to be processed are removed from
          * the cache.
-         * Relies on the fact that item::processing_speed() is a constant.
          */
         std::vector<item_reference> get_for_processing();
 
+        /**
+         * Leaves the item that was just handed out for processing alone until @p until, but no
+         * longer than an hour, for food whose temperature and rot have nothing to do until then.
+         * See @ref item::temperature_rot_settled_until.
+         */
+        void sleep_until( const item &it, const time_point &until );
+
         /**
          * Returns the currently tracked list of special active items.
          */
@@ -10,6 +10,7 @@
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -145,6 +146,7 @@ static const zone_type_id zone_type_LOOT_CORPSE( "LOOT_CORPSE" );
 static const zone_type_id zone_type_LOOT_CUSTOM( "LOOT_CUSTOM" );
 static const zone_type_id zone_type_LOOT_IGNORE( "LOOT_IGNORE" );
 static const zone_type_id zone_type_LOOT_IGNORE_FAVORITES( "LOOT_IGNORE_FAVORITES" );
+static const zone_type_id zone_type_LOOT_ITEM_GROUP( "LOOT_ITEM_GROUP" );
 static const zone_type_id zone_type_LOOT_UNSORTED( "LOOT_UNSORTED" );
 static const zone_type_id zone_type_LOOT_WOOD( "LOOT_WOOD" );
 static const zone_type_id zone_type_MINING( "MINING" );
@@ -1768,6 +1770,86 @@ void _tidy_move_items( Character &you, item_stack &stack, tripoint_bub_ms const
     }
 }
 
+// Destinations and their free space for the items of one loot source tile.  Zone lookups and
+// capacity checks are done once per destination and then shared by all items going there.
+class loot_move_plan
+{
+    public:
+        loot_move_plan( const tripoint_abs_ms &abspos, const faction_id &fac )
+            : abspos( abspos ), fac( fac ) {}
+
+        // Tiles of zone @p id within reach that may take @p it.
+        const std::unordered_set<tripoint_abs_ms> &destinations( const zone_type_id &id,
+                const item &it ) {
+            const zone_manager &mgr = zone_manager::get_manager();
+            // Custom zones filter by item, so they can't be shared.
+            if( id == zone_type_LOOT_CUSTOM || id == zone_type_LOOT_ITEM_GROUP ) {
+                item_destinations = mgr.get_near( id, abspos, ACTIVITY_SEARCH_DISTANCE, &it, fac );
+                return item_destinations;
+            }
+            auto found = zone_destinations.find( id );
+            if( found == zone_destinations.end() ) {
+                found = zone_destinations.emplace( id, mgr.get_near( id, abspos,
+                                                   ACTIVITY_SEARCH_DISTANCE, &it, fac ) ).first;
+            }
+            return found->second;
+        }
+
+        // The first of @p dests with room left for @p it, which is then taken from that tile.
+        std::optional<tripoint_abs_ms> reserve( const std::unordered_set<tripoint_abs_ms> &dests,
+                                                const item &it ) {
+            const units::volume volume = it.volume();
+            for( const tripoint_abs_ms &dest : dests ) {
+                tile_capacity &cap = capacity_at( dest );
+                if( cap.usable && cap.item_count < MAX_ITEM_IN_SQUARE &&
+                    cap.free_space >= volume ) {
+                    cap.free_space -= volume;
+                    ++cap.item_count;
+                    return dest;
+                }
+            }
+            return std::nullopt;
+        }
+
+        // Forget what is known about @p p after items were put there by other means.
+        void invalidate( const tripoint_abs_ms &p ) {
+            capacities.erase( p );
+        }
+
+    private:
+        struct tile_capacity {
+            bool usable = false;
+            int item_count = 0;
+            units::volume free_space = 0_ml;
+        };
+
+        tile_capacity &capacity_at( const tripoint_abs_ms &p ) {
+            auto found = capacities.find( p );
+            if( found != capacities.end() ) {
+                return found->second;
+            }
+            map &here = get_map();
+            const tripoint_bub_ms loc = here.bub_from_abs( p );
+            tile_capacity cap;
+            // skip tiles with inaccessible furniture, like filled charcoal kiln
+            cap.usable = here.can_put_items_ter_furn( loc );
+            cap.item_count = static_cast<int>( here.i_at( loc ).size() );
+            //Check destination for cargo part
+            if( const std::optional<vpart_reference> ovp = here.veh_at( loc ).cargo() ) {
+                cap.free_space = ovp->items().free_volume();
+            } else {
+                cap.free_space = here.free_volume( loc );
+            }
+            return capacities.emplace( p, cap ).first->second;
+        }
+
+        tripoint_abs_ms abspos;
+        faction_id fac;
+        std::unordered_map<zone_type_id, std::unordered_set<tripoint_abs_ms>> zone_destinations;
+        std::unordered_set<tripoint_abs_ms> item_destinations;
+        std::unordered_map<tripoint_abs_ms, tile_capacity> capacities;
+};
+
 } // namespace
 
 static bool construction_activity( Character &you, const zone_data * /*zone*/,
@@ -2199,6 +2281,12 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
             unload_always |= options.unload_always();
         }
 
+        const bool ignore_favorites = mgr.has( zone_type_LOOT_IGNORE_FAVORITES, src,
+                                               _fac_id( you ) );
+        const bool near_unload = mgr.has_near( zone_type_UNLOAD_ALL, abspos, 1, _fac_id( you ) );
+        const bool near_strip = mgr.has_near( zone_type_STRIP_CORPSES, abspos, 1, _fac_id( you ) );
+        loot_move_plan plan( abspos, _fac_id( you ) );
+
         //Skip items that have already been processed
         for( auto it = items.begin() + num_processed; it < items.end(); ++it ) {
             ++num_processed;
@@ -2215,7 +2303,7 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
             }
 
             // skip favorite items in ignore favorite zones
-            if( thisitem.is_favorite && mgr.has( zone_type_LOOT_IGNORE_FAVORITES, src, _fac_id( you ) ) ) {
+            if( thisitem.is_favorite && ignore_favorites ) {
                 continue;
             }
 
@@ -2236,8 +2324,7 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
                 continue;
             }
 
-            const std::unordered_set<tripoint_abs_ms> dest_set =
-                mgr.get_near( id, abspos, ACTIVITY_SEARCH_DISTANCE, &thisitem, _fac_id( you ) );
+            const std::unordered_set<tripoint_abs_ms> &dest_set = plan.destinations( id, thisitem );
 
             // if this item isn't going anywhere and its not sealed
             // check if it is in a unload zone or a strip corpse zone
@@ -2245,8 +2332,7 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
             bool move_and_reset = false;
             bool moved_something = false;
 
-            if( mgr.has_near( zone_type_UNLOAD_ALL, abspos, 1, _fac_id( you ) ) ||
-                ( mgr.has_near( zone_type_STRIP_CORPSES, abspos, 1, _fac_id( you ) ) && it->first->is_corpse() ) ) {
+            if( near_unload || ( near_strip && it->first->is_corpse() ) ) {
                 if( dest_set.empty() || unload_always ) {
                     if( you.rate_action_unload( *it->first ) == hint_rating::good &&
                         !it->first->any_pockets_sealed() ) {
@@ -2294,7 +2380,7 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
                             }
                         }
                         moved_something = true;
-
+                        plan.invalidate( src );
                     }
 
                     // if unloading mods
@@ -2316,6 +2402,7 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
                             item removed = it->first->get_contents().remove_pocket( 0 );
                             move_item( you, removed, 1, src_loc, src_loc, vpr_src );
                             moved_something = true;
+                            plan.invalidate( src );
                         }
                     }
                     if( it->first->has_flag( flag_MAG_DESTROY ) && it->first->ammo_remaining() == 0 ) {
@@ -2341,32 +2428,13 @@ void activity_on_turn_move_loot( player_activity &act, Character &you )
 
             }
 
-            for( const tripoint_abs_ms &dest : dest_set ) {
-                const tripoint_bub_ms dest_loc = here.bub_from_abs( dest );
-                units::volume free_space;
-
-                //Check destination for cargo part
-                if( const std::optional<vpart_reference> ovp = here.veh_at( dest_loc ).cargo() ) {
-                    free_space = ovp->items().free_volume();
-                } else {
-                    free_space = here.free_volume( dest_loc );
-                }
+            if( const std::optional<tripoint_abs_ms> dest = plan.reserve( dest_set, thisitem ) ) {
+                move_item( you, thisitem, thisitem.count(), src_loc, here.bub_from_abs( *dest ),
+                           vpr_src );
 
-                // skip tiles with inaccessible furniture, like filled charcoal kiln
-                if( !here.can_put_items_ter_furn( dest_loc ) ||
-                    static_cast<int>( here.i_at( dest_loc ).size() ) >= MAX_ITEM_IN_SQUARE ) {
-                    continue;
-                }
-
-                // check free space at destination
-                if( free_space >= thisitem.volume() ) {
-                    move_item( you, thisitem, thisitem.count(), src_loc, dest_loc, vpr_src );
-
-                    // moved item away from source so decrement
-                    if( num_processed > 0 ) {
-                        --num_processed;
-                    }
-                    break;
+                // moved item away from source so decrement
+                if( num_processed > 0 ) {
+                    --num_processed;
                 }
             }
             if( you.get_moves() <= 0 || move_and_reset ) {
@@ -2493,6 +2561,110 @@ static void check_npc_revert( Character &you )
     }
 }
 
+namespace
+{
+
+// Work spots of the multi-tile activities shared by every worker on the map.  The scans that
+// don't depend on the worker are done once per turn, and each worker claims the spot it heads
+// for, so that the others pick a different one instead of all walking to the same tile.
+class activity_work_board
+{
+    public:
+        static activity_work_board &get() {
+            static activity_work_board board;
+            return board;
+        }
+
+        // Unfinished constructions on z-level @p z of the map.
+        const std::vector<tripoint_abs_ms> &partial_constructions( int z ) {
+            refresh();
+            auto found = partial_cons.find( z );
+            if( found == partial_cons.end() ) {
+                found = partial_cons.emplace( z, scan_partial_constructions( z ) ).first;
+            }
+            return found->second;
+        }
+
+        // Whether someone other than @p you works at or heads for @p p.
+        bool taken_by_other( const Character &you, const tripoint_abs_ms &p ) {
+            refresh();
+            const auto working = working_at.find( p );
+            if( working != working_at.end() && working->second != you.getID() ) {
+                return true;
+            }
+            const auto found = claims.find( p );
+            return found != claims.end() && found->second.who != you.getID();
+        }
+
+        void claim( const Character &you, const tripoint_abs_ms &p ) {
+            claims[p] = { you.getID(), calendar::turn };
+        }
+
+        // Give up the spots claimed by @p you, done before looking for new work.
+        void release( const Character &you ) {
+            for( auto it = claims.begin(); it != claims.end(); ) {
+                if( it->second.who == you.getID() ) {
+                    it = claims.erase( it );
+                } else {
+                    ++it;
+                }
+            }
+        }
+
+    private:
+        struct work_claim {
+            character_id who;
+            time_point when;
+        };
+        // A worker that neither reached its spot nor looked for other work in this time is
+        // assumed to have given up on it.
+        static constexpr time_duration claim_expiry = 10_minutes;
+
+        void refresh() {
+            const tripoint_abs_sm origin = get_map().get_abs_sub();
+            if( scanned == calendar::turn && scanned_origin == origin ) {
+                return;
+            }
+            scanned = calendar::turn;
+            scanned_origin = origin;
+            partial_cons.clear();
+            working_at.clear();
+            for( auto it = claims.begin(); it != claims.end(); ) {
+                if( it->second.when > calendar::turn ||
+                    calendar::turn - it->second.when > claim_expiry ) {
+                    it = claims.erase( it );
+                } else {
+                    ++it;
+                }
+            }
+            for( const npc &guy : g->all_npcs() ) {
+                if( guy.has_player_activity() ) {
+                    working_at.emplace( guy.activity.placement, guy.getID() );
+                }
+            }
+        }
+
+        static std::vector<tripoint_abs_ms> scan_partial_constructions( int z ) {
+            std::vector<tripoint_abs_ms> found;
+            map &here = get_map();
+            for( const tripoint_bub_ms &p : here.points_on_zlevel( z ) ) {
+                if( here.partial_con_at( p ) != nullptr ) {
+                    found.push_back( here.getglobal( p ) );
+                }
+            }
+            return found;
+        }
+
+        time_point scanned = calendar::before_time_starts;
+        tripoint_abs_sm scanned_origin;
+        std::unordered_map<int, std::vector<tripoint_abs_ms>> partial_cons;
+        // Where the npcs with an activity are working this turn.
+        std::unordered_map<tripoint_abs_ms, character_id> working_at;
+        std::unordered_map<tripoint_abs_ms, work_claim> claims;
+};
+
+} // namespace
+
 static zone_type_id get_zone_for_act( const tripoint_bub_ms &src_loc, const zone_manager &mgr,
                                       const activity_id &act_id, const faction_id &fac_id )
 {
@@ -2541,6 +2713,14 @@ static zone_type_id get_zone_for_act( const tripoint_bub_ms &src_loc, const zone
 
 /** Determine all locations for this generic activity */
 /** Returns locations */
+// Activities that can't have multiple characters working on the same tile.
+static bool is_exclusive_work( const activity_id &act_id )
+{
+    return act_id == ACT_MULTIPLE_CHOP_TREES ||
+           act_id == ACT_MULTIPLE_CONSTRUCTION ||
+           act_id == ACT_MULTIPLE_MINE;
+}
+
 static std::unordered_set<tripoint_abs_ms> generic_multi_activity_locations(
     Character &you, const activity_id &act_id )
 {
@@ -2617,10 +2797,10 @@ static std::unordered_set<tripoint_abs_ms> generic_multi_activity_locations(
         src_set = mgr.get_near( zone_type, abspos, ACTIVITY_SEARCH_DISTANCE, nullptr, _fac_id( you ) );
         // multiple construction will form a list of targets based on blueprint zones and unfinished constructions
         if( act_id == ACT_MULTIPLE_CONSTRUCTION ) {
-            for( const tripoint_bub_ms &elem : here.points_in_radius( localpos, ACTIVITY_SEARCH_DISTANCE ) ) {
-                partial_con *pc = here.partial_con_at( elem );
-                if( pc ) {
-                    src_set.insert( here.getglobal( elem ) );
+            for( const tripoint_abs_ms &elem :
+                 activity_work_board::get().partial_constructions( localpos.z() ) ) {
+                if( square_dist( abspos, elem ) <= ACTIVITY_SEARCH_DISTANCE ) {
+                    src_set.insert( elem );
                 }
             }
             // farming activities encompass tilling, planting, harvesting.
@@ -2673,23 +2853,9 @@ static std::unordered_set<tripoint_abs_ms> generic_multi_activity_locations(
                 ++it2;
             }
         } else //  Exclude activities that can't have multiple characters working on the same tile.
-            if( act_id == ACT_MULTIPLE_CHOP_TREES ||
-                act_id == ACT_MULTIPLE_CONSTRUCTION ||
-                act_id == ACT_MULTIPLE_MINE ) {
-                bool skip = false;
-
-                for( const npc &guy : g->all_npcs() ) {
-                    if( &guy == &you ) {
-                        continue;
-                    }
-                    if( guy.has_player_activity() && tripoint_abs_ms( guy.activity.placement ) == *it2 ) {
-                        it2 = src_set.erase( it2 );
-                        skip = true;
-                        break;
-                    }
-                }
-                if( skip ) {
-                    continue;
+            if( is_exclusive_work( act_id ) ) {
+                if( activity_work_board::get().taken_by_other( you, *it2 ) ) {
+                    it2 = src_set.erase( it2 );
                 } else {
                     ++it2;
                 }
@@ -3192,6 +3358,7 @@ bool generic_multi_activity_handler( player_activity &act, Character &you, bool
     // Nuke the current activity, leaving the backlog alone
     if( !check_only ) {
         you.activity = player_activity();
+        activity_work_board::get().release( you );
     }
     // now we setup the target spots based on which activity is occurring
     // the set of target work spots - potentially after we have fetched required tools.
@@ -3236,6 +3403,9 @@ bool generic_multi_activity_handler( player_activity &act, Character &you, bool
                 continue;
             }
             you.set_moves( 0 );
+            if( is_exclusive_work( activity_to_restore ) ) {
+                activity_work_board::get().claim( you, src );
+            }
             you.set_destination( route, player_activity( activity_to_restore ) );
             return false;
         }
@@ -3306,6 +3476,9 @@ bool generic_multi_activity_handler( player_activity &act, Character &you, bool
                 // we don't need to check for safe mode,
                 // activity will be restarted only if
                 // player arrives on destination tile
+                if( is_exclusive_work( activity_to_restore ) ) {
+                    activity_work_board::get().claim( you, src );
+                }
                 you.set_destination( route, player_activity( activity_to_restore ) );
                 return true;
             }
@@ -3325,6 +3498,9 @@ bool generic_multi_activity_handler( player_activity &act, Character &you, bool
             return false;
         }
         if( !check_only ) {
+            if( is_exclusive_work( activity_to_restore ) ) {
+                activity_work_board::get().claim( you, src );
+            }
             if( !generic_multi_activity_do( you, activity_to_restore, act_info, src, src_loc ) ) {
                 // if the activity was successful
                 // then a new activity was assigned
@@ -1,10 +1,11 @@
 #include "advanced_inv_pane.h"
 
+#include <algorithm>
 #include <cstddef>
-#include <iterator>
 #include <list>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "advanced_inv_area.h"
@@ -102,15 +103,12 @@ bool advanced_inventory_pane::is_filtered( const item &it ) const
         return false;
     }
 
-    const std::string str = it.tname();
-    if( filtercache.find( str ) == filtercache.end() ) {
-        const auto filter_fn = item_filter_from_string( filter );
-        filtercache[str] = filter_fn;
-
-        return !filter_fn( it );
+    // The filter may also be assigned directly when the settings are restored.
+    if( !compiled_filter || compiled_filter_text != filter ) {
+        compiled_filter = item_filter_from_string( filter );
+        compiled_filter_text = filter;
     }
-
-    return !filtercache[str]( it );
+    return !compiled_filter( it );
 }
 
 /** converts a raw list of items to "stacks" - items that are not count_by_charges that otherwise stack go into one stack */
@@ -118,17 +116,19 @@ static std::vector<std::vector<item_location>> item_list_to_stack(
             const item_location &parent, std::list<item *> item_list )
 {
     std::vector<std::vector<item_location>> ret;
-    for( auto iter_outer = item_list.begin(); iter_outer != item_list.end(); ++iter_outer ) {
-        std::vector<item_location> item_stack( { item_location( parent, *iter_outer ) } );
-        for( auto iter_inner = std::next( iter_outer ); iter_inner != item_list.end(); ) {
-            if( ( *iter_outer )->display_stacked_with( **iter_inner ) ) {
-                item_stack.emplace_back( parent, *iter_inner );
-                iter_inner = item_list.erase( iter_inner );
-            } else {
-                ++iter_inner;
-            }
+    // Only items of the same type stack, so each item is compared with the stacks of its type.
+    std::unordered_map<itype_id, std::vector<size_t>> stacks_by_type;
+    for( item *it : item_list ) {
+        std::vector<size_t> &candidates = stacks_by_type[it->typeId()];
+        auto found = std::find_if( candidates.begin(), candidates.end(), [&]( size_t idx ) {
+            return ret[idx].front()->display_stacked_with( *it );
+        } );
+        if( found != candidates.end() ) {
+            ret[*found].emplace_back( parent, it );
+        } else {
+            candidates.push_back( ret.size() );
+            ret.push_back( { item_location( parent, it ) } );
         }
-        ret.push_back( item_stack );
     }
     return ret;
 }
@@ -476,6 +476,5 @@ void advanced_inventory_pane::set_filter( const std::string &new_filter )
         return;
     }
     filter = new_filter;
-    filtercache.clear();
     recalc = true;
 }
@@ -4,7 +4,6 @@
 
 #include <array>
 #include <functional>
-#include <map>
 #include <string>
 #include <vector>
 
@@ -146,6 +145,8 @@ class advanced_inventory_pane
         /** Only add offset to index, but wrap around! */
         void mod_index( int offset );
 
-        mutable std::map<std::string, std::function<bool( const item & )>> filtercache;
+        /** @ref filter compiled once, along with the filter text it was compiled from. */
+        mutable std::string compiled_filter_text;
+        mutable std::function<bool( const item & )> compiled_filter;
 };
 #endif // CATA_SRC_ADVANCED_INV_PANE_H
@@ -0,0 +1,231 @@
+#include "alloc_profiler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <ostream>
+
+namespace alloc_profiler
+{
+
+std::string tag_name( const tag t )
+{
+    switch( t ) {
+        // *INDENT-OFF*
+        case tag::untagged: return "untagged";
+        case tag::mapbuffer: return "mapbuffer";
+        case tag::overmapbuffer: return "overmapbuffer";
+        case tag::items: return "items";
+        case tag::creatures: return "creatures";
+        case tag::map_memory: return "map_memory";
+        case tag::tiles: return "tiles";
+        // *INDENT-ON*
+        case tag::last:
+            break;
+    }
+    return "unknown";
+}
+
+#if defined(CATA_ALLOC_PROFILER)
+
+namespace detail
+{
+thread_local tag current = tag::untagged;
+} // namespace detail
+
+namespace
+{
+
+// Plain atomics with constexpr constructors, so they work before any dynamic initialization.
+struct tag_counters {
+    std::atomic<int64_t> live_bytes{ 0 };
+    std::atomic<int64_t> live_blocks{ 0 };
+    std::atomic<uint64_t> allocations{ 0 };
+    std::atomic<uint64_t> allocated_bytes{ 0 };
+};
+std::array<tag_counters, num_tags> counters;
+
+// Keeps the block after it aligned as operator new promises.
+struct alignas( std::max_align_t ) block_header {
+    size_t size;
+    tag t;
+};
+
+void *tracked_alloc( const size_t size ) noexcept
+{
+    void *raw = std::malloc( sizeof( block_header ) + size );
+    if( raw == nullptr ) {
+        return nullptr;
+    }
+    block_header *header = static_cast<block_header *>( raw );
+    header->size = size;
+    header->t = detail::current;
+    tag_counters &c = counters[static_cast<size_t>( header->t )];
+    c.live_bytes.fetch_add( static_cast<int64_t>( size ), std::memory_order_relaxed );
+    c.live_blocks.fetch_add( 1, std::memory_order_relaxed );
+    c.allocations.fetch_add( 1, std::memory_order_relaxed );
+    c.allocated_bytes.fetch_add( size, std::memory_order_relaxed );
+    return header + 1;
+}
+
+void tracked_free( void *p ) noexcept
+{
+    if( p == nullptr ) {
+        return;
+    }
+    block_header *header = static_cast<block_header *>( p ) - 1;
+    tag_counters &c = counters[static_cast<size_t>( header->t )];
+    c.live_bytes.fetch_sub( static_cast<int64_t>( header->size ), std::memory_order_relaxed );
+    c.live_blocks.fetch_sub( 1, std::memory_order_relaxed );
+    std::free( header );
+}
+
+void *tracked_new( size_t size )
+{
+    size = std::max<size_t>( size, 1 );
+    while( true ) {
+        if( void *p = tracked_alloc( size ) ) {
+            return p;
+        }
+        std::new_handler handler = std::get_new_handler();
+        if( handler == nullptr ) {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+} // namespace
+
+tag current_tag()
+{
+    return detail::current;
+}
+
+snapshot take_snapshot()
+{
+    snapshot ret;
+    ret.time = clock_type::now();
+    for( size_t i = 0; i < num_tags; ++i ) {
+        tag_stats &s = ret.stats[i];
+        s.t = static_cast<tag>( i );
+        s.live_bytes = counters[i].live_bytes.load( std::memory_order_relaxed );
+        s.live_blocks = counters[i].live_blocks.load( std::memory_order_relaxed );
+        s.allocations = counters[i].allocations.load( std::memory_order_relaxed );
+        s.allocated_bytes = counters[i].allocated_bytes.load( std::memory_order_relaxed );
+    }
+    return ret;
+}
+
+#else
+
+tag current_tag()
+{
+    return tag::untagged;
+}
+
+snapshot take_snapshot()
+{
+    snapshot ret;
+    ret.time = clock_type::now();
+    for( size_t i = 0; i < num_tags; ++i ) {
+        ret.stats[i].t = static_cast<tag>( i );
+    }
+    return ret;
+}
+
+#endif // CATA_ALLOC_PROFILER
+
+std::vector<tag_rates> rates_between( const snapshot &earlier, const snapshot &later )
+{
+    const double seconds = std::max( 1e-9,
+                                     std::chrono::duration<double>( later.time - earlier.time ).count() );
+    std::vector<tag_rates> ret;
+    for( size_t i = 0; i < num_tags; ++i ) {
+        tag_rates r;
+        r.t = static_cast<tag>( i );
+        r.allocations_per_second = ( later.stats[i].allocations - earlier.stats[i].allocations ) /
+                                   seconds;
+        r.bytes_per_second = ( later.stats[i].allocated_bytes - earlier.stats[i].allocated_bytes ) /
+                             seconds;
+        ret.push_back( r );
+    }
+    return ret;
+}
+
+void write_csv( std::ostream &out )
+{
+    const snapshot now = take_snapshot();
+    out << "tag,live_bytes,live_blocks,allocations,allocated_bytes\n";
+    for( const tag_stats &s : now.stats ) {
+        out << tag_name( s.t ) << ',' << s.live_bytes << ',' << s.live_blocks << ','
+            << s.allocations << ',' << s.allocated_bytes << '\n';
+    }
+}
+
+} // namespace alloc_profiler
+
+#if defined(CATA_ALLOC_PROFILER)
+
+// The replaceable global allocation functions.  The aligned ones are left alone, they pair
+// with their own deallocation functions and are not counted.
+void *operator new( size_t size )
+{
+    return alloc_profiler::tracked_new( size );
+}
+
+void *operator new[]( size_t size )
+{
+    return alloc_profiler::tracked_new( size );
+}
+
+void *operator new( size_t size, const std::nothrow_t & ) noexcept
+{
+    try {
+        return alloc_profiler::tracked_new( size );
+    } catch( const std::bad_alloc & ) {
+        return nullptr;
+    }
+}
+
+void *operator new[]( size_t size, const std::nothrow_t & ) noexcept
+{
+    try {
+        return alloc_profiler::tracked_new( size );
+    } catch( const std::bad_alloc & ) {
+        return nullptr;
+    }
+}
+
+void operator delete( void *p ) noexcept
+{
+    alloc_profiler::tracked_free( p );
+}
+
+void operator delete[]( void *p ) noexcept
+{
+    alloc_profiler::tracked_free( p );
+}
+
+void operator delete( void *p, size_t ) noexcept
+{
+    alloc_profiler::tracked_free( p );
+}
+
+void operator delete[]( void *p, size_t ) noexcept
+{
+    alloc_profiler::tracked_free( p );
+}
+
+void operator delete( void *p, const std::nothrow_t & ) noexcept
+{
+    alloc_profiler::tracked_free( p );
+}
+
+void operator delete[]( void *p, const std::nothrow_t & ) noexcept
+{
+    alloc_profiler::tracked_free( p );
+}
+
+#endif // CATA_ALLOC_PROFILER
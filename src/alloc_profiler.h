@@ -0,0 +1,124 @@
+#pragma once
+#ifndef CATA_SRC_ALLOC_PROFILER_H
+#define CATA_SRC_ALLOC_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * Optional accounting of heap memory by subsystem.
+ *
+ * When built with CATA_ALLOC_PROFILER (make ALLOC_PROFILER=1, or the CMake option of the same
+ * name), the global operator new and delete keep a small header in front of every block with
+ * its size and the tag that was current on the allocating thread.  Live bytes and blocks and
+ * the number of allocations are counted per tag, and a block is credited back to the tag it
+ * was allocated under, wherever it is freed.
+ *
+ * Subsystems mark their work with @ref alloc_profiler::scoped_tag; the innermost tag on a
+ * thread wins.  Without the define the tags compile to nothing, no allocator is replaced and
+ * @ref is_available returns false.
+ */
+namespace alloc_profiler
+{
+
+enum class tag : int {
+    untagged,
+    mapbuffer,
+    overmapbuffer,
+    items,
+    creatures,
+    map_memory,
+    tiles,
+    last
+};
+
+constexpr size_t num_tags = static_cast<size_t>( tag::last );
+
+std::string tag_name( tag t );
+
+constexpr bool is_available()
+{
+#if defined(CATA_ALLOC_PROFILER)
+    return true;
+#else
+    return false;
+#endif
+}
+
+struct tag_stats {
+    tag t = tag::untagged;
+    /** Bytes and blocks allocated under the tag and not freed yet. */
+    int64_t live_bytes = 0;
+    int64_t live_blocks = 0;
+    /** Allocations made under the tag since the start. */
+    uint64_t allocations = 0;
+    uint64_t allocated_bytes = 0;
+};
+
+using clock_type = std::chrono::steady_clock;
+
+/** The counters of every tag at one point in time. */
+struct snapshot {
+    clock_type::time_point time;
+    std::array<tag_stats, num_tags> stats;
+};
+
+/** All zero when the profiler is not available. */
+snapshot take_snapshot();
+
+/** How fast each tag allocated between two snapshots. */
+struct tag_rates {
+    tag t = tag::untagged;
+    double allocations_per_second = 0.0;
+    double bytes_per_second = 0.0;
+};
+std::vector<tag_rates> rates_between( const snapshot &earlier, const snapshot &later );
+
+/** One row per tag with the counters of @ref take_snapshot. */
+void write_csv( std::ostream &out );
+
+/** The tag allocations on the calling thread are made under. */
+tag current_tag();
+
+namespace detail
+{
+#if defined(CATA_ALLOC_PROFILER)
+// Constant initialized, so it can be read from operator new before main.
+extern thread_local tag current;
+#endif
+} // namespace detail
+
+/** Counts the allocations of the calling thread in the enclosing scope as @p t. */
+class scoped_tag
+{
+    public:
+        explicit scoped_tag( tag t ) {
+#if defined(CATA_ALLOC_PROFILER)
+            previous = detail::current;
+            detail::current = t;
+#else
+            static_cast<void>( t );
+#endif
+        }
+        ~scoped_tag() {
+#if defined(CATA_ALLOC_PROFILER)
+            detail::current = previous;
+#endif
+        }
+        scoped_tag( const scoped_tag & ) = delete;
+        scoped_tag &operator=( const scoped_tag & ) = delete;
+
+#if defined(CATA_ALLOC_PROFILER)
+    private:
+        tag previous;
+#endif
+};
+
+} // namespace alloc_profiler
+
+#endif // CATA_SRC_ALLOC_PROFILER_H
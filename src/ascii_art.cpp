@@ -33,7 +33,7 @@ bool string_id<ascii_art>::is_valid() const
 
 void ascii_art::load_ascii_art( const JsonObject &jo, const std::string &src )
 {
-    ascii_art_factory.load( jo, src );
+    ascii_art_factory.load_lazily( jo, src );
 }
 
 void ascii_art::load( const JsonObject &jo, const std::string_view )
@@ -46,9 +46,6 @@ using namespace auto_pickup;
 
 static const ammotype ammo_battery( "battery" );
 
-static bool check_special_rule( const std::map<material_id, int> &materials,
-                                std::string_view rule );
-
 auto_pickup::player_settings &get_auto_pickup()
 {
     static auto_pickup::player_settings single_instance;
@@ -79,14 +76,14 @@ static bool within_autopickup_limits( const item *pickup_item )
  */
 static rule_state get_autopickup_rule( const item *pickup_item )
 {
-    std::string item_name = pickup_item->tname( 1, false );
+    const std::string item_name = pickup_item->tname( 1, false );
     rule_state pickup_state = get_auto_pickup().check_item( item_name );
 
     if( pickup_state == rule_state::WHITELISTED ) {
         return rule_state::WHITELISTED;
     } else if( pickup_state != rule_state::BLACKLISTED ) {
         //No prematched pickup rule found, check rules in more detail
-        get_auto_pickup().create_rule( pickup_item );
+        get_auto_pickup().create_rule( pickup_item, item_name );
 
         if( get_auto_pickup().check_item( item_name ) == rule_state::WHITELISTED ) {
             return rule_state::WHITELISTED;
@@ -645,9 +642,10 @@ void rule::test_pattern() const
 
     //Loop through all itemfactory items
     //APU now ignores prefixes, bottled items and suffix combinations still not generated
+    const compiled_rule compiled( *this );
     for( const itype *e : item_controller->all() ) {
         const std::string sItemName = e->nname( 1 );
-        if( !check_special_rule( e->materials, sRule ) && !wildcard_match( sItemName, sRule ) ) {
+        if( !compiled.matches( sItemName, e->materials ) ) {
             continue;
         }
 
@@ -756,8 +754,14 @@ bool player_settings::has_rule( const item *it )
 
 void player_settings::add_rule( const item *it, bool include )
 {
-    character_rules.push_back( rule( it->tname( 1, false ), true, !include ) );
-    create_rule( it );
+    const std::string to_match = it->tname( 1, false );
+    character_rules.push_back( rule( to_match, true, !include ) );
+    if( map_items.ready ) {
+        // The new rule applies last, and only to items of this name
+        map_items.rules.emplace_back( character_rules.back() );
+        map_items.erase( to_match );
+    }
+    create_rule( it, to_match );
 
     if( !get_option<bool>( "AUTO_PICKUP" ) &&
         query_yn( _( "Auto pickup is not enabled in the options.  Enable it now?" ) ) ) {
@@ -785,128 +789,104 @@ bool player_settings::empty() const
     return global_rules.empty() && character_rules.empty();
 }
 
-bool check_special_rule( const std::map<material_id, int> &materials, const std::string_view rule )
+compiled_rule::compiled_rule( const rule &r ) : bExclude( r.bExclude ), pattern( r.sRule )
 {
-    char type = ' ';
-    std::vector<std::string> filter;
-    if( rule[1] == ':' ) {
-        type = rule[0];
-        filter = string_split( rule.substr( 2 ), ',' );
+    if( r.sRule.size() < 2 || r.sRule[1] != ':' || ( r.sRule[0] != 'm' && r.sRule[0] != 'M' ) ) {
+        return;
     }
-
-    if( filter.empty() || materials.empty() ) {
-        return false;
+    const std::vector<std::string> filter = string_split( std::string_view( r.sRule ).substr( 2 ),
+                                            ',' );
+    if( filter.empty() ) {
+        return;
     }
+    material_rule = r.sRule[0];
+
+    const std::vector<lcmatcher> matchers( filter.begin(), filter.end() );
+    for( const material_type &mat : materials::get_all() ) {
+        const std::string name = mat.name();
+        if( std::any_of( matchers.begin(), matchers.end(), [&name]( const lcmatcher & m ) {
+        return m( name );
+        } ) ) {
+            materials.insert( mat.id );
+        }
+    }
+}
 
-    if( type == 'm' ) {
-        return std::any_of( materials.begin(),
-        materials.end(), [&filter]( const std::pair<material_id, int> &mat ) {
-            return std::any_of( filter.begin(), filter.end(), [&mat]( const std::string_view search ) {
-                return lcmatch( mat.first->name(), search );
-            } );
-        } );
-
-    } else if( type == 'M' ) {
-        return std::all_of( materials.begin(),
-        materials.end(), [&filter]( const std::pair<material_id, int> &mat ) {
-            return std::any_of( filter.begin(), filter.end(), [&mat]( const std::string_view search ) {
-                return lcmatch( mat.first->name(), search );
-            } );
-        } );
+bool compiled_rule::matches( const std::string &name,
+                             const std::map<material_id, int> &item_materials ) const
+{
+    if( material_rule != ' ' && !item_materials.empty() ) {
+        const auto named = [this]( const std::pair<const material_id, int> &mat ) {
+            return materials.count( mat.first ) > 0;
+        };
+        if( material_rule == 'm' ?
+            std::any_of( item_materials.begin(), item_materials.end(), named ) :
+            std::all_of( item_materials.begin(), item_materials.end(), named ) ) {
+            return true;
+        }
     }
+    return pattern( name );
+}
 
-    return false;
+bool compiled_rule::matches( const std::string &name ) const
+{
+    return pattern( name );
 }
 
 //Special case. Required for NPC harvest auto pickup. Ignores material rules.
 void npc_settings::create_rule( const std::string &to_match )
 {
-    rules.create_rule( map_items, to_match );
-}
+    ensure_ready();
+    if( map_items.count( to_match ) ) {
+        return;
+    }
 
-void rule_list::create_rule( cache &map_items, const std::string &to_match )
-{
-    for( const rule &elem : *this ) {
-        if( !elem.bActive || !wildcard_match( to_match, elem.sRule ) ) {
-            continue;
+    rule_state state = rule_state::NONE;
+    for( const compiled_rule &elem : map_items.rules ) {
+        if( elem.matches( to_match ) ) {
+            state = elem.bExclude ? rule_state::BLACKLISTED : rule_state::WHITELISTED;
         }
-
-        map_items[ to_match ] = elem.bExclude ? rule_state::BLACKLISTED : rule_state::WHITELISTED;
     }
+    map_items.emplace( to_match, state );
 }
 
-void player_settings::create_rule( const item *it )
+void player_settings::create_rule( const item *it, const std::string &to_match )
 {
-    // TODO: change it to be a reference
-    global_rules.create_rule( map_items, *it );
-    character_rules.create_rule( map_items, *it );
-}
-
-void rule_list::create_rule( cache &map_items, const item &it )
-{
-    const std::string to_match = it.tname( 1, false );
+    ensure_ready();
+    if( map_items.count( to_match ) ) {
+        return;
+    }
 
-    for( const rule &elem : *this ) {
-        if( !elem.bActive ) {
-            continue;
-        }
-        if( !check_special_rule( it.made_of(), elem.sRule ) &&
-            !wildcard_match( to_match, elem.sRule ) ) {
-            continue;
+    // TODO: change it to be a reference
+    const std::map<material_id, int> &materials = it->made_of();
+    rule_state state = rule_state::NONE;
+    for( const compiled_rule &elem : map_items.rules ) {
+        if( elem.matches( to_match, materials ) ) {
+            state = elem.bExclude ? rule_state::BLACKLISTED : rule_state::WHITELISTED;
         }
-
-        map_items[ to_match ] = elem.bExclude ? rule_state::BLACKLISTED : rule_state::WHITELISTED;
     }
+    map_items.emplace( to_match, state );
 }
 
-void player_settings::refresh_map_items( cache &map_items ) const
+void player_settings::compile( std::vector<compiled_rule> &rules ) const
 {
-    //process include/exclude in order of rules, global first, then character specific
-    //if a specific item is being added, all the rules need to be checked now
-    //may have some performance issues since exclusion needs to check all items also
-    global_rules.refresh_map_items( map_items );
-    character_rules.refresh_map_items( map_items );
+    //global first, then character specific
+    global_rules.compile( rules );
+    character_rules.compile( rules );
 }
 
-void rule_list::refresh_map_items( cache &map_items ) const
+void rule_list::compile( std::vector<compiled_rule> &rules ) const
 {
     for( const rule &elem : *this ) {
-        if( elem.sRule.empty() || !elem.bActive ) {
-            continue;
-        }
-
-        if( !elem.bExclude ) {
-            //Check include patterns against all itemfactory items
-            for( const itype *e : item_controller->all() ) {
-                const std::string &cur_item = e->nname( 1 );
-
-                if( !check_special_rule( e->materials, elem.sRule ) && !wildcard_match( cur_item, elem.sRule ) ) {
-                    continue;
-                }
-
-                map_items[ cur_item ] = rule_state::WHITELISTED;
-                map_items.temp_items[ cur_item ] = e;
-            }
-        } else {
-            //only re-exclude items from the existing mapping for now
-            //new exclusions will process during pickup attempts
-            for( auto &map_item : map_items ) {
-                if( !check_special_rule( map_items.temp_items[ map_item.first ]->materials, elem.sRule ) &&
-                    !wildcard_match( map_item.first, elem.sRule ) ) {
-                    continue;
-                }
-
-                map_items[ map_item.first ] = rule_state::BLACKLISTED;
-            }
+        if( !elem.sRule.empty() && elem.bActive ) {
+            rules.emplace_back( elem );
         }
     }
 }
 
 rule_state base_settings::check_item( const std::string &sItemName ) const
 {
-    if( !map_items.ready ) {
-        recreate();
-    }
+    ensure_ready();
 
     const auto iter = map_items.find( sItemName );
     if( iter != map_items.end() ) {
@@ -1035,9 +1015,9 @@ void npc_settings::deserialize( const JsonArray &ja )
     rules.deserialize( ja );
 }
 
-void npc_settings::refresh_map_items( cache &map_items ) const
+void npc_settings::compile( std::vector<compiled_rule> &rules ) const
 {
-    rules.refresh_map_items( map_items );
+    this->rules.compile( rules );
 }
 
 bool npc_settings::empty() const
@@ -1049,11 +1029,54 @@ void base_settings::recreate() const
 {
     map_items.clear();
     map_items.temp_items.clear();
-    refresh_map_items( map_items );
+    map_items.rules.clear();
+    compile( map_items.rules );
+
+    //process include/exclude in order of rules
+    //may have some performance issues since exclusion needs to check all items also
+    std::vector<std::pair<std::string, const itype *>> all_items;
+    for( const compiled_rule &elem : map_items.rules ) {
+        if( !elem.bExclude ) {
+            //Check include patterns against all itemfactory items
+            if( all_items.empty() ) {
+                for( const itype *e : item_controller->all() ) {
+                    all_items.emplace_back( e->nname( 1 ), e );
+                }
+            }
+            for( const std::pair<std::string, const itype *> &e : all_items ) {
+                if( !elem.matches( e.first, e.second->materials ) ) {
+                    continue;
+                }
+
+                map_items[ e.first ] = rule_state::WHITELISTED;
+                map_items.temp_items[ e.first ] = e.second;
+            }
+        } else {
+            //only re-exclude items from the existing mapping for now
+            //new exclusions will process during pickup attempts
+            for( auto &map_item : map_items ) {
+                const itype *e = map_items.temp_items[ map_item.first ];
+                if( !elem.matches( map_item.first, e->materials ) ) {
+                    continue;
+                }
+
+                map_item.second = rule_state::BLACKLISTED;
+            }
+        }
+    }
+
+    map_items.language_version = detail::get_current_language_version();
     map_items.ready = true;
     map_items.temp_items.clear();
 }
 
+void base_settings::ensure_ready() const
+{
+    if( !map_items.ready || map_items.language_version != detail::get_current_language_version() ) {
+        recreate();
+    }
+}
+
 void base_settings::invalidate()
 {
     map_items.ready = false;
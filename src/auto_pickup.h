@@ -4,13 +4,17 @@
 
 #include <functional>
 #include <list>
+#include <map>
+#include <set>
 #include <string>
 #include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "cata_utility.h"
 #include "enums.h"
 #include "item_stack.h"
+#include "type_id.h"
 
 class JsonArray;
 class JsonObject;
@@ -24,17 +28,51 @@ namespace auto_pickup
 {
 std::list<std::pair<item_location, int>> select_items(
         const std::vector<item_stack::iterator> &from, const tripoint &location );
+
+class rule;
+
+/**
+ * A @ref rule converted once for matching many items against it: the wildcard pattern is
+ * split up front and a material rule ("m:" or "M:") is resolved to the ids of the materials
+ * it names.
+ */
+class compiled_rule
+{
+    public:
+        explicit compiled_rule( const rule &r );
+
+        bool bExclude = false;
+
+        /** Whether an item of this name, made of these materials, matches the rule. */
+        bool matches( const std::string &name, const std::map<material_id, int> &materials ) const;
+        /** Whether an item of this name matches the rule, ignoring material rules. */
+        bool matches( const std::string &name ) const;
+
+    private:
+        wildcard_matcher pattern;
+        // 'm' if any, 'M' if all of the materials of an item have to be named, ' ' otherwise
+        char material_rule = ' ';
+        std::set<material_id> materials;
+};
+
 /**
  * The currently-active set of auto-pickup rules, in a form that allows quick
  * lookup. When this is filled (by @ref auto_pickup::create_rule()), every
  * item existing in the game that matches a rule (either white- or blacklist)
  * is added as the key, with rule_state::WHITELISTED or rule_state::BLACKLISTED as the values.
+ * Items matched by @ref player_settings::create_rule() are added as well, with
+ * rule_state::NONE if no rule matches them, so they are not matched again.
  */
 class cache : public std::unordered_map<std::string, rule_state>
 {
     public:
         /// Defines whether this cache has been filled.
         bool ready = false;
+        /// Language the item names were in when this cache was filled.
+        int language_version = 0;
+
+        /// The active rules, in the order they apply, compiled when this cache was filled.
+        std::vector<compiled_rule> rules;
 
         /// Temporary data used while filling the cache.
         std::unordered_map<std::string, const itype *> temp_items;
@@ -71,10 +109,8 @@ class rule_list : public std::vector<rule>
         void serialize( JsonOut &jsout ) const;
         void deserialize( const JsonArray &ja );
 
-        void refresh_map_items( cache &map_items ) const;
-
-        void create_rule( cache &map_items, const std::string &to_match );
-        void create_rule( cache &map_items, const item &it );
+        /** Adds the active rules to @p rules, in order. */
+        void compile( std::vector<compiled_rule> &rules ) const;
 };
 
 class user_interface
@@ -104,9 +140,11 @@ class base_settings
         mutable cache map_items;
 
         void invalidate();
+        /** Fills the cache if it is empty or the language has changed since. */
+        void ensure_ready() const;
 
     private:
-        virtual void refresh_map_items( cache &map_items ) const = 0;
+        virtual void compile( std::vector<compiled_rule> &rules ) const = 0;
 
         void recreate() const;
 
@@ -124,11 +162,12 @@ class player_settings : public base_settings
         rule_list global_rules;
         rule_list character_rules;
 
-        void refresh_map_items( cache &map_items ) const override;
+        void compile( std::vector<compiled_rule> &rules ) const override;
 
     public:
         ~player_settings() override = default;
-        void create_rule( const item *it );
+        /** Matches the rules against an item named @p to_match not matched before. */
+        void create_rule( const item *it, const std::string &to_match );
         bool has_rule( const item *it );
         void add_rule( const item *it, bool include );
         void remove_rule( const item *it );
@@ -149,7 +188,7 @@ class npc_settings : public base_settings
     private:
         rule_list rules;
 
-        void refresh_map_items( cache &map_items ) const override;
+        void compile( std::vector<compiled_rule> &rules ) const override;
 
     public:
         ~npc_settings() override = default;
@@ -514,9 +514,13 @@ void basecamp::update_in_progress( const std::string &bldg, const point &dir )
 void basecamp::reset_camp_resources( map &here )
 {
     reset_camp_workers();
+    // The provides add up, so they are only added once.  The resources are collected anew,
+    // before they grew by all of them every time a camp menu was opened.
+    resources.clear();
+    fuel_types.clear();
     for( auto &e : expansions ) {
         expansion_data &e_data = e.second;
-        for( int level = 0; level <= e_data.cur_level; level++ ) {
+        for( int level = 0; !legacy_provides_added && level <= e_data.cur_level; level++ ) {
             const std::string &bldg = base_camps::faction_encode_abs( e_data, level );
             if( bldg == "null" ) {
                 break;
@@ -530,6 +534,7 @@ void basecamp::reset_camp_resources( map &here )
             add_resource( it );
         }
     }
+    legacy_provides_added = true;
     form_crafting_inventory( here );
 }
 
@@ -453,6 +453,10 @@ class basecamp
         bool farm_return( const mission_id &miss_id, const point &dir );
         std::pair<size_t, std::string> farm_action( const point &dir, farm_ops op,
                 const npc_ptr &comp = nullptr );
+        /** @ref farm_action on the already loaded @p farm_map of the expansion at @p dir. */
+        std::pair<size_t, std::string> farm_action( smallmap &farm_map,
+                std::unique_ptr<small_fake_map> &farm_json, const point &dir, farm_ops op,
+                const npc_ptr &comp );
         void fortifications_return( const mission_id &miss_id );
         bool salt_water_pipe_swamp_return( const mission_id &miss_id,
                                            const comp_list &npc_list );
@@ -508,6 +512,15 @@ class basecamp
         std::set<itype_id> fuel_types; // NOLINT(cata-serialize)
         std::vector<basecamp_fuel> fuels; // NOLINT(cata-serialize)
         std::vector<basecamp_resource> resources; // NOLINT(cata-serialize)
+        // Whether the provides of the levels of legacy expansions were added since loading
+        bool legacy_provides_added = false; // NOLINT(cata-serialize)
+        // Results of farm_action without a companion, by expansion.  A mission menu asks for
+        // every operation of every farm, these share one load of the farm map per turn.
+        struct farm_survey {
+            time_point taken;
+            std::map<farm_ops, std::pair<size_t, std::string>> results;
+        };
+        std::map<point, farm_survey> farm_surveys; // NOLINT(cata-serialize)
         std::vector<std::vector<ui_mission_id>> temp_ui_mission_keys;   // NOLINT(cata-serialize)
         inventory _inv; // NOLINT(cata-serialize)
         bool by_radio = false; // NOLINT(cata-serialize)
@@ -5,6 +5,7 @@ bool keycode_mode;
 bool log_from_top;
 int message_ttl;
 int message_cooldown;
+int ui_redraw_fps = 30;
 bool test_mode;
 int prevent_occlusion;
 bool prevent_occlusion_retract;
@@ -15,6 +15,7 @@ extern bool keycode_mode;
 extern bool log_from_top;
 extern int message_ttl;
 extern int message_cooldown;
+extern int ui_redraw_fps;
 extern int prevent_occlusion;
 extern bool prevent_occlusion_retract;
 extern bool prevent_occlusion_transp;
@@ -44,4 +44,61 @@ void tiny_bitset::resize_heap( size_t requested_bits ) noexcept
 void tiny_bitset::set_storage( block_t *data )
 {
     memcpy( &storage_, &data, sizeof( data ) );
-}
\ No newline at end of file
+}
+void tiny_bitset::clear_from( size_t first_bit ) noexcept
+{
+    const size_t bits_used = size();
+    if( first_bit >= bits_used ) {
+        return;
+    }
+    if( is_inline() ) {
+        const block_t cleared = first_bit == 0 ? ~block_t( 0 ) :
+                                ( kLowBit << ( kBitsPerBlock - first_bit ) ) - 1;
+        storage_ &= ~( cleared & ~kMetaMask );
+        return;
+    }
+    block_t *blocks = bits();
+    size_t block_idx = first_bit / kBitsPerBlock;
+    const size_t offset = first_bit % kBitsPerBlock;
+    if( offset != 0 ) {
+        blocks[block_idx] &= ~( ( kLowBit << ( kBitsPerBlock - offset ) ) - 1 );
+        ++block_idx;
+    }
+    const size_t end = used_blocks();
+    if( block_idx < end ) {
+        memset( blocks + block_idx, 0, ( end - block_idx ) * sizeof( block_t ) );
+    }
+}
+
+void tiny_bitset::set_union( const tiny_bitset &rhs )
+{
+    if( size() < rhs.size() ) {
+        resize( rhs.size() );
+    }
+    if( rhs.is_inline() ) {
+        bits()[0] |= rhs.storage_ & ~kMetaMask;
+        return;
+    }
+    block_t *blocks = bits();
+    const block_t *rhs_blocks = rhs.bits();
+    for( size_t i = 0, end = rhs.used_blocks(); i < end; ++i ) {
+        blocks[i] |= rhs_blocks[i];
+    }
+}
+
+void tiny_bitset::set_intersection( const tiny_bitset &rhs )
+{
+    if( is_inline() ) {
+        storage_ &= ( rhs.is_inline() ? rhs.storage_ : rhs.bits()[0] ) | kMetaMask;
+        return;
+    }
+    block_t *blocks = bits();
+    const size_t rhs_end = rhs.is_inline() ? 1 : rhs.used_blocks();
+    for( size_t i = 0, end = used_blocks(); i < end; ++i ) {
+        if( i >= rhs_end ) {
+            blocks[i] = 0;
+        } else {
+            blocks[i] &= i == 0 && rhs.is_inline() ? rhs.storage_ & ~kMetaMask : rhs.bits()[i];
+        }
+    }
+}
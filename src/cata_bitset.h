@@ -59,8 +59,9 @@ class tiny_bitset
             if( rhs.is_inline() ) {
                 storage_ = rhs.storage_;
             } else {
+                storage_ = kStorageIsInlineMask;
                 resize( rhs.capacity() );
-                memcpy( bits(), rhs.bits(), rhs.size() / kBitsPerBlock );
+                memcpy( bits(), rhs.bits(), rhs.used_blocks() * sizeof( block_t ) );
             }
         }
 
@@ -76,7 +77,7 @@ class tiny_bitset
                 storage_ = rhs.storage_;
             } else {
                 resize( rhs.capacity() );
-                memcpy( bits(), rhs.bits(), rhs.size() / kBitsPerBlock );
+                memcpy( bits(), rhs.bits(), rhs.used_blocks() * sizeof( block_t ) );
             }
             return *this;
         }
@@ -105,7 +106,7 @@ class tiny_bitset
         }
 
         // NOLINTNEXTLINE(cata-large-inline-function)
-        bool test( size_t idx ) {
+        bool test( size_t idx ) const {
             cata_assert( idx < size() );
             size_t block_idx = idx / kBitsPerBlock;
             block_t bit_mask = kHighBit >> ( idx % kBitsPerBlock );
@@ -122,12 +123,17 @@ class tiny_bitset
             bits()[block_idx] &= ~bit_mask;
         }
 
+        // NOLINTNEXTLINE(cata-large-inline-function)
         void resize( size_t requested_bits ) noexcept {
+            const size_t old_size = size();
             if( is_inline() && requested_bits <= kMaxInlineBits ) {
                 set_size( requested_bits );
-                return;
+            } else {
+                resize_heap( requested_bits );
+            }
+            if( requested_bits > old_size ) {
+                clear_from( old_size );
             }
-            resize_heap( requested_bits );
         }
 
         bool is_inline() const {
@@ -192,6 +198,11 @@ class tiny_bitset
             map( bit_setter<true> {} );
         }
 
+        /** Sets the bits that are set in @p rhs, growing to its size if this is smaller. */
+        void set_union( const tiny_bitset &rhs );
+        /** Clears the bits that are not set in @p rhs, including those past its size. */
+        void set_intersection( const tiny_bitset &rhs );
+
     private:
         // foldl helpers
         struct and_mapper {
@@ -309,6 +320,12 @@ class tiny_bitset
 
         void resize_heap( size_t requested_bits ) noexcept;
         void set_storage( block_t *data );
+        // Clears the bits from @p first_bit up to the size, they may be stale after growing.
+        void clear_from( size_t first_bit ) noexcept;
+
+        size_t used_blocks() const {
+            return ( size() + kBitsPerBlock - 1 ) / kBitsPerBlock;
+        }
 
         // NOLINTNEXTLINE(cata-large-inline-function)
         void set_size( size_t number_of_bits ) {
@@ -4,6 +4,7 @@
 
 #include <functional>
 #include <string>
+#include <string_view>
 #include <type_traits>
 
 #include "json.h"
@@ -143,7 +144,7 @@ struct has_archive_tag : std::false_type {
     static void write( JsonOut &stream, const S &value ) {
         stream.write( value );
     }
-    static bool read( const JsonObject &obj, const std::string &key, T &value ) {
+    static bool read( const JsonObject &obj, const std::string_view key, T &value ) {
         return obj.read( key, value );
     }
     static bool read( JsonArray &arr, T &value ) {
@@ -216,7 +217,7 @@ class JsonObjectInputArchive : public JsonObject
          * If the archive does not have the requested member, the value is not changed at all.
          */
         template<typename T>
-        bool io( const std::string &name, T &value ) {
+        bool io( const std::string_view name, T &value ) {
             return io::detail::has_archive_tag<T>::read( *this, name, value );
         }
         /**
@@ -224,7 +225,7 @@ class JsonObjectInputArchive : public JsonObject
          * The function still returns false if the default value had been used.
          */
         template<typename T>
-        bool io( const std::string &name, T &value, const T &default_value ) {
+        bool io( const std::string_view name, T &value, const T &default_value ) {
             if( io( name, value ) ) {
                 return true;
             }
@@ -236,7 +237,7 @@ class JsonObjectInputArchive : public JsonObject
          * Roughly equivalent to \code io<T>( name, value, T() ); \endcode
          */
         template<typename T>
-        bool io( const std::string &name, T &value, default_tag ) {
+        bool io( const std::string_view name, T &value, default_tag ) {
             static const T default_value = T();
             return io( name, value, default_value );
         }
@@ -245,7 +246,7 @@ class JsonObjectInputArchive : public JsonObject
          * value, this may be used for containers (e.g. std::map).
          */
         template<typename T>
-        bool io( const std::string &name, T &value, empty_default_tag ) {
+        bool io( const std::string_view name, T &value, empty_default_tag ) {
             if( io( name, value ) ) {
                 return true;
             }
@@ -284,7 +285,7 @@ class JsonObjectInputArchive : public JsonObject
          * JsonOutputArchive, so it can be used when the archive type is a template parameter.
          */
         template<typename T>
-        bool io( const std::string &name, T *&pointer,
+        bool io( const std::string_view name, T *&pointer,
                  const std::function<void( const std::string & )> &load,
                  const std::function<std::string( const T & )> &save, bool required = false ) {
             // Only used by the matching function in the output archive classes.
@@ -292,7 +293,7 @@ class JsonObjectInputArchive : public JsonObject
             std::string ident;
             if( !io( name, ident ) ) {
                 if( required ) {
-                    JsonObject::throw_error( std::string( "required member is missing: " ) + name );
+                    JsonObject::throw_error( "required member is missing: " + std::string( name ) );
                 }
                 pointer = nullptr;
                 return false;
@@ -304,7 +305,7 @@ class JsonObjectInputArchive : public JsonObject
          * The 'I-give-up' template for gun variant data
          */
         template<typename T, typename LoadFunc, typename SaveFunc>
-        bool io( const std::string &name, T &pointer,
+        bool io( const std::string_view name, T &pointer,
                  const LoadFunc &load,
                  const SaveFunc &save, bool required = false ) {
             // Only used by the matching function in the output archive classes.
@@ -312,7 +313,7 @@ class JsonObjectInputArchive : public JsonObject
             std::string ident;
             if( !io( name, ident ) ) {
                 if( required ) {
-                    JsonObject::throw_error( std::string( "required member is missing: " ) + name );
+                    JsonObject::throw_error( "required member is missing: " + std::string( name ) );
                 }
                 pointer = nullptr;
                 return false;
@@ -321,7 +322,7 @@ class JsonObjectInputArchive : public JsonObject
             return true;
         }
         template<typename T>
-        bool io( const std::string &name, T *&pointer,
+        bool io( const std::string_view name, T *&pointer,
                  const std::function<void( const std::string & )> &load,
                  const std::function<std::string( const T & )> &save, required_tag ) {
             return io<T>( name, pointer, load, save, true );
@@ -410,19 +411,19 @@ class JsonObjectOutputArchive
             return false;
         }
         template<typename T>
-        bool io( const std::string &name, const T &value, const T &default_value ) {
+        bool io( const std::string_view name, const T &value, const T &default_value ) {
             if( value == default_value ) {
                 return false;
             }
             return io( name, value );
         }
         template<typename T>
-        bool io( const std::string &name, const T &value, default_tag ) {
+        bool io( const std::string_view name, const T &value, default_tag ) {
             static const T default_value = T();
             return io<T>( name, value, default_value );
         }
         template<typename T>
-        bool io( const std::string &name, const T &value, empty_default_tag ) {
+        bool io( const std::string_view name, const T &value, empty_default_tag ) {
             if( !value.empty() ) {
                 io<T>( name, value );
             }
@@ -439,12 +440,12 @@ class JsonObjectOutputArchive
          * @ref JsonObjectInputArchive, so it can be used when the archive type is a template parameter.
          */
         template<typename T>
-        bool io( const std::string &name, const T *pointer,
+        bool io( const std::string_view name, const T *pointer,
                  const std::function<void( const std::string & )> &,
                  const std::function<std::string( const T & )> &save, bool required = false ) {
             if( pointer == nullptr ) {
                 if( required ) {
-                    throw JsonError( "a required member is null: " + name );
+                    throw JsonError( "a required member is null: " + std::string( name ) );
                 }
                 return false;
             }
@@ -454,19 +455,19 @@ class JsonObjectOutputArchive
          * The I-give-up load function for gun variants
          */
         template<typename T, typename LoadFunc, typename SaveFunc>
-        bool io( const std::string &name, const T &pointer,
+        bool io( const std::string_view name, const T &pointer,
                  const LoadFunc &,
                  const SaveFunc &save, bool required = false ) {
             if( pointer == nullptr ) {
                 if( required ) {
-                    throw JsonError( "a required member is null: " + name );
+                    throw JsonError( "a required member is null: " + std::string( name ) );
                 }
                 return false;
             }
             return io( name, save( pointer ) );
         }
         template<typename T>
-        bool io( const std::string &name, const T *pointer,
+        bool io( const std::string_view name, const T *pointer,
                  const std::function<void( const std::string & )> &load,
                  const std::function<std::string( const T & )> &save, required_tag ) {
             return io<T>( name, pointer, load, save, true );
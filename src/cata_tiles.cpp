@@ -12,8 +12,10 @@
 #include <stdexcept>
 #include <tuple>
 #include <unordered_set>
+#include <utility>
 
 #include "action.h"
+#include "alloc_profiler.h"
 #include "avatar.h"
 #include "cached_options.h"
 #include "calendar.h"
@@ -50,6 +52,7 @@
 #include "mtype.h"
 #include "mutation.h"
 #include "npc.h"
+#include "options.h"
 #include "output.h"
 #include "overlay_ordering.h"
 #include "overmap.h"
@@ -64,6 +67,7 @@
 #include "string_formatter.h"
 #include "string_id.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "translations.h"
 #include "trap.h"
@@ -88,6 +92,11 @@ static const trap_str_id tr_unfinished_construction( "tr_unfinished_construction
 static const std::string ITEM_HIGHLIGHT( "highlight_item" );
 static const std::string ZOMBIE_REVIVAL_INDICATOR( "zombie_revival_indicator" );
 
+// Read for every drawn sprite or tile.
+static const option_ref<bool> option_nv_green_toggle( "NV_GREEN_TOGGLE" );
+static const option_ref<std::string> option_use_celsius( "USE_CELSIUS" );
+static const option_ref<bool> option_animation_sct_use_font( "ANIMATION_SCT_USE_FONT" );
+
 static const std::array<std::string, 8> multitile_keys = {{
         "center",
         "corner",
@@ -209,6 +218,7 @@ cata_tiles::cata_tiles( const SDL_Renderer_Ptr &renderer, const GeometryRenderer
     renderer( renderer ),
     geometry( geometry ),
     cache( cache ),
+    sprites( renderer ),
     minimap( renderer, geometry )
 {
     cata_assert( renderer );
@@ -334,6 +344,13 @@ tile_type &tileset::create_tile_type( const std::string &id, tile_type &&new_til
 void cata_tiles::load_tileset( const std::string &tileset_id, const bool precheck,
                                const bool force, const bool pump_events, const bool terrain )
 {
+    const alloc_profiler::scoped_tag alloc_tag( alloc_profiler::tag::tiles );
+    // The looks_like chains may have changed with the loaded mods even if the tileset didn't.
+    for( auto &by_category : tile_lookups ) {
+        for( tile_lookup_cache &lookups : by_category ) {
+            lookups.clear();
+        }
+    }
     if( tileset_ptr && tileset_ptr->get_tileset_id() == tileset_id && !force ) {
         return;
     }
@@ -1265,6 +1282,7 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                        std::multimap<point, formatted_text> &overlay_strings,
                        color_block_overlay_container &color_blocks )
 {
+    const alloc_profiler::scoped_tag alloc_tag( alloc_profiler::tag::tiles );
     if( !g ) {
         return;
     }
@@ -1419,6 +1437,7 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
         }
     }
 
+    const bool draw_points_rebuilt = here.draw_points_cache_dirty;
     if( here.draw_points_cache_dirty ) {
         here.draw_points_cache_dirty = false;
         // overlay_strings and color_blocks are generated with draw_points and thus are cleared together
@@ -1442,12 +1461,25 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
         }
 
         // Generate new draw points
-        creature_tracker &creatures = get_creature_tracker();
-        for( int row = min_row; row < max_row; row ++ ) {
+        // Creatures in the dark that can be seen anyway are found up front, the checks use caches
+        // that can't be shared between the threads building the rows.
+        std::unordered_set<tripoint> seen_in_dark;
+        for( const Creature &critter : g->all_creatures() ) {
+            if( critter.has_flag( mon_flag_ALWAYS_VISIBLE ) || you.sees_with_infrared( critter ) ||
+                you.sees_with_specials( critter ) ) {
+                seen_in_dark.insert( critter.pos() );
+            }
+        }
+        for( int zlevel = center.z; zlevel >= draw_min_z; zlevel -- ) {
+            // Level caches are made on first access, which must not happen on the worker threads.
+            here.access_cache( zlevel );
+            std::map<int, std::vector<tile_render_info>> &rows = here.draw_points_cache[zlevel];
             // Reserve columns on each row
-            for( int zlevel = center.z; zlevel >= draw_min_z; zlevel -- ) {
-                here.draw_points_cache[zlevel][row].reserve( std::max( 0, max_col - min_col ) );
+            for( int row = min_row; row < max_row; row ++ ) {
+                rows[row].reserve( std::max( 0, max_col - min_col ) );
             }
+        }
+        const auto build_row = [&]( const int row ) {
             for( int col = min_col; col < max_col; col ++ ) {
                 const std::optional<point> temp = tile_to_player( { col, row } );
                 if( !temp.has_value() ) {
@@ -1461,6 +1493,7 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                     const int &y = pos.y();
                     const bool is_center_z = zlevel == center.z;
                     const level_cache &ch2 = here.access_cache( zlevel );
+                    std::vector<tile_render_info> &points = here.draw_points_cache.at( zlevel ).at( row );
 
                     // light level is used for choosing between grayscale filter and normal lit tiles.
                     lit_level ll;
@@ -1477,8 +1510,8 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                             invisible[0] = true;
                         } else {
                             if( would_apply_vision_effects( offscreen_type ) ) {
-                                here.draw_points_cache[zlevel][row].emplace_back( tile_render_info::common{ pos.raw(), 0},
-                                        tile_render_info::vision_effect{ offscreen_type } );
+                                points.emplace_back( tile_render_info::common{ pos.raw(), 0},
+                                                     tile_render_info::vision_effect{ offscreen_type } );
                             }
                             break;
                         }
@@ -1566,9 +1599,10 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                             }
 
                             std::string temp_str;
-                            if( get_option<std::string>( "USE_CELSIUS" ) == "celsius" ) {
+                            const std::string &temp_unit = option_use_celsius.get();
+                            if( temp_unit == "celsius" ) {
                                 temp_str = string_format( "%.0f", celsius_temp_value );
-                            } else if( get_option<std::string>( "USE_CELSIUS" ) == "kelvin" ) {
+                            } else if( temp_unit == "kelvin" ) {
                                 temp_str = string_format( "%.0f", units::to_kelvin( temp_value ) );
                             } else {
                                 temp_str = string_format( "%.0f", units::to_fahrenheit( temp_value ) );
@@ -1639,16 +1673,12 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                     if( !invisible[0] ) {
                         const visibility_type vis_type = here.get_visibility( ll, cache );
                         if( would_apply_vision_effects( vis_type ) ) {
-                            const Creature *critter = creatures.creature_at( pos, true );
                             if( has_draw_override( pos.raw() ) || has_memory_at( pos_global ) ||
-                                ( critter &&
-                                  ( critter->has_flag( mon_flag_ALWAYS_VISIBLE )
-                                    || you.sees_with_infrared( *critter )
-                                    || you.sees_with_specials( *critter ) ) ) ) {
+                                seen_in_dark.count( pos.raw() ) > 0 ) {
                                 invisible[0] = true;
                             } else {
-                                here.draw_points_cache[zlevel][row].emplace_back( tile_render_info::common{ pos.raw(), 0},
-                                        tile_render_info::vision_effect{ vis_type } );
+                                points.emplace_back( tile_render_info::common{ pos.raw(), 0},
+                                                     tile_render_info::vision_effect{ vis_type } );
                                 break;
                             }
                         }
@@ -1658,14 +1688,44 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                         invisible[1 + i] = apply_visible( np.raw(), ch2, here );
                     }
 
-                    here.draw_points_cache[zlevel][row].emplace_back( tile_render_info::common{ pos.raw(), 0},
-                            tile_render_info::sprite{ ll, invisible } );
+                    points.emplace_back( tile_render_info::common{ pos.raw(), 0},
+                                         tile_render_info::sprite{ ll, invisible } );
                     // Stop building draw points below when floor reached
                     if( here.dont_draw_lower_floor( pos ) ) {
                         break;
                     }
                 }
             }
+        };
+
+        // The debug overlays add to caches shared by all rows, so no parallel building with them.
+        const bool with_overlays = g->display_overlay_state( ACTION_DISPLAY_SCENT ) ||
+                                   g->display_overlay_state( ACTION_DISPLAY_SCENT_TYPE ) ||
+                                   g->display_overlay_state( ACTION_DISPLAY_RADIATION ) ||
+                                   g->display_overlay_state( ACTION_DISPLAY_NPC_ATTACK_POTENTIAL ) ||
+                                   g->display_overlay_state( ACTION_DISPLAY_TEMPERATURE ) ||
+                                   g->display_overlay_state( ACTION_DISPLAY_VISIBILITY ) ||
+                                   g->display_overlay_state( ACTION_DISPLAY_LIGHTING ) ||
+                                   g->display_overlay_state( ACTION_DISPLAY_TRANSPARENCY );
+        // Below this many rows per task handing them to the workers costs more than it saves.
+        constexpr int min_rows_per_task = 8;
+        const unsigned int num_threads = num_parallel_threads();
+        const int num_rows = max_row - min_row;
+        if( with_overlays || num_threads < 2 || num_rows < 2 * min_rows_per_task ) {
+            for( int row = min_row; row < max_row; row ++ ) {
+                build_row( row );
+            }
+        } else {
+            const int rows_per_task = std::max( min_rows_per_task,
+                                                num_rows / static_cast<int>( 2 * num_threads ) );
+            const int num_tasks = ( num_rows + rows_per_task - 1 ) / rows_per_task;
+            parallel_for( num_tasks, [&build_row, min_row, max_row, rows_per_task]( size_t task ) {
+                const int first = min_row + static_cast<int>( task ) * rows_per_task;
+                const int last = std::min( first + rows_per_task, max_row );
+                for( int row = first; row < last; row ++ ) {
+                    build_row( row );
+                }
+            } );
         }
     }
     overlay_strings = here.overlay_strings_cache;
@@ -1698,41 +1758,24 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
         do_draw_shadow = true;
     }
 
-    if( max_draw_depth <= 0 ) {
-        // Legacy draw mode
-        for( int row = min_row; row < max_row; row ++ ) {
-            for( auto f : drawing_layers_legacy ) {
-                for( tile_render_info &p : here.draw_points_cache[center.z][row] ) {
-                    if( const tile_render_info::vision_effect * const
-                        var = std::get_if<tile_render_info::vision_effect>( &p.var ) ) {
-                        if( f == &cata_tiles::draw_terrain ) {
-                            apply_vision_effects( p.com.pos, var->vis, p.com.height_3d );
-                        }
-                    } else if( const tile_render_info::sprite * const
-                               var = std::get_if<tile_render_info::sprite>( &p.var ) ) {
-                        ( this->*f )( p.com.pos, var->ll, p.com.height_3d, var->invisible, false );
-                    }
-                }
-            }
-        }
+    // The layers only change with the draw points, unless something is drawn in place of the
+    // map or a sprite is animated, so the last ones drawn can be copied over again.
+    const map_frame_key frame_key{ dest, point( width, height ), center,
+                                   point( tile_width, tile_height ), tileset_ptr.get(),
+                                   calendar::turn, nv_goggles_activated };
+    const bool reuse_map_frame = !draw_points_rebuilt && map_frame_drawn_with == frame_key &&
+                                 !has_any_draw_override();
+    if( reuse_map_frame ) {
+        const SDL_Rect frame_rect{ dest.x, dest.y, width, height };
+        RenderCopy( renderer, map_frame, nullptr, &frame_rect );
     } else {
-        // Multi z-level draw mode
-        // Start drawing from the lowest visible z-level (some off-screen tiles
-        // are considered visible here to simplify the logic.)
-        int cur_zlevel = draw_min_z;
-        while( cur_zlevel <= center.z ) {
-            const half_open_rectangle<point> &cur_any_tile_range = is_isometric()
-                    ? z_any_tile_range[center.z - cur_zlevel] : top_any_tile_range;
-            // For each row
-            for( int row = cur_any_tile_range.p_min.y; row < cur_any_tile_range.p_max.y; row ++ ) {
-                // Set base height for each tile
-                for( tile_render_info &p : here.draw_points_cache[cur_zlevel][row] ) {
-                    p.com.height_3d = ( cur_zlevel - center.z ) * zlevel_height;
-                }
-                // For each layer
-                for( auto f : drawing_layers ) {
-                    // For each tile
-                    for( tile_render_info &p : here.draw_points_cache[cur_zlevel][row] ) {
+        const bool into_map_frame = begin_map_frame( frame_key );
+        sprites.begin();
+        if( max_draw_depth <= 0 ) {
+            // Legacy draw mode
+            for( int row = min_row; row < max_row; row ++ ) {
+                for( auto f : drawing_layers_legacy ) {
+                    for( tile_render_info &p : here.draw_points_cache[center.z][row] ) {
                         if( const tile_render_info::vision_effect * const
                             var = std::get_if<tile_render_info::vision_effect>( &p.var ) ) {
                             if( f == &cata_tiles::draw_terrain ) {
@@ -1740,36 +1783,71 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
                             }
                         } else if( const tile_render_info::sprite * const
                                    var = std::get_if<tile_render_info::sprite>( &p.var ) ) {
-
-                            // Get visibility variables
-                            lit_level ll = var->ll;
-                            std::array<bool, 5> invisible = var->invisible;
-
-                            if( f == &cata_tiles::draw_vpart_no_roof || f == &cata_tiles::draw_vpart_roof ) {
-                                int temp_height_3d = p.com.height_3d;
-                                // Reset height_3d to base when drawing vehicles
-                                p.com.height_3d = ( cur_zlevel - center.z ) * zlevel_height;
-                                // Draw
-                                if( !( this->*f )( p.com.pos, ll, p.com.height_3d, invisible, false ) ) {
-                                    // If no vpart drawn, revert height_3d changes
-                                    p.com.height_3d = temp_height_3d;
+                            ( this->*f )( p.com.pos, var->ll, p.com.height_3d, var->invisible, false );
+                        }
+                    }
+                }
+            }
+        } else {
+            // Multi z-level draw mode
+            // Start drawing from the lowest visible z-level (some off-screen tiles
+            // are considered visible here to simplify the logic.)
+            int cur_zlevel = draw_min_z;
+            while( cur_zlevel <= center.z ) {
+                const half_open_rectangle<point> &cur_any_tile_range = is_isometric()
+                        ? z_any_tile_range[center.z - cur_zlevel] : top_any_tile_range;
+                // For each row
+                for( int row = cur_any_tile_range.p_min.y; row < cur_any_tile_range.p_max.y; row ++ ) {
+                    // Set base height for each tile
+                    for( tile_render_info &p : here.draw_points_cache[cur_zlevel][row] ) {
+                        p.com.height_3d = ( cur_zlevel - center.z ) * zlevel_height;
+                    }
+                    // For each layer
+                    for( auto f : drawing_layers ) {
+                        // For each tile
+                        for( tile_render_info &p : here.draw_points_cache[cur_zlevel][row] ) {
+                            if( const tile_render_info::vision_effect * const
+                                var = std::get_if<tile_render_info::vision_effect>( &p.var ) ) {
+                                if( f == &cata_tiles::draw_terrain ) {
+                                    apply_vision_effects( p.com.pos, var->vis, p.com.height_3d );
                                 }
-                            } else if( f == &cata_tiles::draw_critter_at ) {
-                                // Draw
-                                if( !( this->*f )( p.com.pos, ll, p.com.height_3d, invisible, false ) && do_draw_shadow &&
-                                    here.dont_draw_lower_floor( tripoint_bub_ms( p.com.pos ) ) ) {
-                                    // Draw shadow of flying critters on bottom-most tile if no other critter drawn
-                                    draw_critter_above( p.com.pos, ll, p.com.height_3d, invisible );
+                            } else if( const tile_render_info::sprite * const
+                                       var = std::get_if<tile_render_info::sprite>( &p.var ) ) {
+
+                                // Get visibility variables
+                                lit_level ll = var->ll;
+                                std::array<bool, 5> invisible = var->invisible;
+
+                                if( f == &cata_tiles::draw_vpart_no_roof || f == &cata_tiles::draw_vpart_roof ) {
+                                    int temp_height_3d = p.com.height_3d;
+                                    // Reset height_3d to base when drawing vehicles
+                                    p.com.height_3d = ( cur_zlevel - center.z ) * zlevel_height;
+                                    // Draw
+                                    if( !( this->*f )( p.com.pos, ll, p.com.height_3d, invisible, false ) ) {
+                                        // If no vpart drawn, revert height_3d changes
+                                        p.com.height_3d = temp_height_3d;
+                                    }
+                                } else if( f == &cata_tiles::draw_critter_at ) {
+                                    // Draw
+                                    if( !( this->*f )( p.com.pos, ll, p.com.height_3d, invisible, false ) && do_draw_shadow &&
+                                        here.dont_draw_lower_floor( tripoint_bub_ms( p.com.pos ) ) ) {
+                                        // Draw shadow of flying critters on bottom-most tile if no other critter drawn
+                                        draw_critter_above( p.com.pos, ll, p.com.height_3d, invisible );
+                                    }
+                                } else {
+                                    // Draw
+                                    ( this->*f )( p.com.pos, ll, p.com.height_3d, invisible, false );
                                 }
-                            } else {
-                                // Draw
-                                ( this->*f )( p.com.pos, ll, p.com.height_3d, invisible, false );
                             }
                         }
                     }
                 }
+                cur_zlevel += 1;
             }
-            cur_zlevel += 1;
+        }
+        sprites.end();
+        if( into_map_frame ) {
+            end_map_frame( frame_key );
         }
     }
 
@@ -1813,37 +1891,40 @@ void cata_tiles::draw( const point &dest, const tripoint &center, int width, int
     void_monster_override();
 
     //Memorize everything the character just saw even if it wasn't displayed.
-    for( int mem_y = min_visible.y; mem_y <= max_visible.y; mem_y++ ) {
-        for( int mem_x = min_visible.x; mem_x <= max_visible.x; mem_x++ ) {
-            const point colrow = player_to_tile( { mem_x, mem_y } );
-            if( is_isometric() && top_any_tile_range.contains( colrow ) ) {
-                continue;
-            }
-            const tripoint_bub_ms p( mem_x, mem_y, center.z );
-            lit_level lighting = ch.visibility_cache[p.x()][p.y()];
-            // `apply_vision_effects` does not memorize anything so we only need
-            // to call `would_apply_vision_effects` here.
-            if( would_apply_vision_effects( here.get_visibility( lighting, cache ) ) ) {
-                continue;
-            }
-            int height_3d = 0;
-            std::array<bool, 5> invisible;
-            invisible[0] = false;
-            for( int i = 0; i < 4; i++ ) {
-                const tripoint_bub_ms np = p + neighborhood[i];
-                invisible[1 + i] = apply_visible( np.raw(), ch, here );
-            }
-            //calling draw to memorize (and only memorize) everything.
-            //bypass cache check in case we learn something new about the terrain's connections
-            draw_terrain( p.raw(), lighting, height_3d, invisible, true );
-            if( here.memory_cache_dec_is_dirty( p ) ) {
-                you.memorize_clear_decoration( here.getglobal( p ), "" );
-                draw_furniture( p.raw(), lighting, height_3d, invisible, true );
-                draw_trap( p.raw(), lighting, height_3d, invisible, true );
-                draw_part_con( p.raw(), lighting, height_3d, invisible, true );
-                draw_vpart_no_roof( p.raw(), lighting, height_3d, invisible, true );
-                draw_vpart_roof( p.raw(), lighting, height_3d, invisible, true );
-                here.memory_cache_dec_set_dirty( p, false );
+    //Already done when the map frame was drawn if it could be reused.
+    if( !reuse_map_frame ) {
+        for( int mem_y = min_visible.y; mem_y <= max_visible.y; mem_y++ ) {
+            for( int mem_x = min_visible.x; mem_x <= max_visible.x; mem_x++ ) {
+                const point colrow = player_to_tile( { mem_x, mem_y } );
+                if( is_isometric() && top_any_tile_range.contains( colrow ) ) {
+                    continue;
+                }
+                const tripoint_bub_ms p( mem_x, mem_y, center.z );
+                lit_level lighting = ch.visibility_cache[p.x()][p.y()];
+                // `apply_vision_effects` does not memorize anything so we only need
+                // to call `would_apply_vision_effects` here.
+                if( would_apply_vision_effects( here.get_visibility( lighting, cache ) ) ) {
+                    continue;
+                }
+                int height_3d = 0;
+                std::array<bool, 5> invisible;
+                invisible[0] = false;
+                for( int i = 0; i < 4; i++ ) {
+                    const tripoint_bub_ms np = p + neighborhood[i];
+                    invisible[1 + i] = apply_visible( np.raw(), ch, here );
+                }
+                //calling draw to memorize (and only memorize) everything.
+                //bypass cache check in case we learn something new about the terrain's connections
+                draw_terrain( p.raw(), lighting, height_3d, invisible, true );
+                if( here.memory_cache_dec_is_dirty( p ) ) {
+                    you.memorize_clear_decoration( here.getglobal( p ), "" );
+                    draw_furniture( p.raw(), lighting, height_3d, invisible, true );
+                    draw_trap( p.raw(), lighting, height_3d, invisible, true );
+                    draw_part_con( p.raw(), lighting, height_3d, invisible, true );
+                    draw_vpart_no_roof( p.raw(), lighting, height_3d, invisible, true );
+                    draw_vpart_roof( p.raw(), lighting, height_3d, invisible, true );
+                    here.memory_cache_dec_set_dirty( p, false );
+                }
             }
         }
     }
@@ -1920,6 +2001,52 @@ void cata_tiles::set_draw_cache_dirty()
     get_map().draw_points_cache_dirty = true;
 }
 
+void cata_tiles::invalidate_map_frame()
+{
+    map_frame_drawn_with.reset();
+}
+
+bool cata_tiles::map_frame_key::operator==( const map_frame_key &rhs ) const
+{
+    return dest == rhs.dest && size == rhs.size && center == rhs.center &&
+           tile_size == rhs.tile_size && tiles == rhs.tiles && turn == rhs.turn &&
+           nv_goggles == rhs.nv_goggles;
+}
+
+bool cata_tiles::begin_map_frame( const map_frame_key &key )
+{
+    map_frame_drawn_with.reset();
+    map_frame_animated = false;
+    if( !map_frame || map_frame_size != key.size ) {
+        map_frame = CreateTexture( renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET,
+                                   key.size.x, key.size.y );
+        map_frame_size = key.size;
+    }
+    if( !map_frame ) {
+        return false;
+    }
+    SetRenderTarget( renderer, map_frame );
+    printErrorIf( SDL_RenderSetClipRect( renderer.get(), nullptr ) != 0,
+                  "SDL_RenderSetClipRect failed" );
+    geometry->rect( renderer, SDL_Rect{ 0, 0, key.size.x, key.size.y }, SDL_Color() );
+    // Positions on screen are relative to the texture now.
+    op = point_zero;
+    return true;
+}
+
+void cata_tiles::end_map_frame( const map_frame_key &key )
+{
+    set_displaybuffer_rendertarget();
+    const SDL_Rect frame_rect{ key.dest.x, key.dest.y, key.size.x, key.size.y };
+    printErrorIf( SDL_RenderSetClipRect( renderer.get(), &frame_rect ) != 0,
+                  "SDL_RenderSetClipRect failed" );
+    op = key.dest;
+    RenderCopy( renderer, map_frame, nullptr, &frame_rect );
+    if( !map_frame_animated ) {
+        map_frame_drawn_with = key;
+    }
+}
+
 void cata_tiles::draw_minimap( const point &dest, const tripoint &center, int width, int height )
 {
     minimap->set_type( is_isometric() ? pixel_minimap_type::iso : pixel_minimap_type::ortho );
@@ -2283,6 +2410,29 @@ std::optional<tile_lookup_res>
 cata_tiles::find_tile_looks_like( const std::string &id, TILE_CATEGORY category,
                                   const std::string &variant,
                                   const int looks_like_jumps_limit ) const
+{
+    if( looks_like_jumps_limit != max_looks_like_jumps || category >= TILE_CATEGORY::last ) {
+        return resolve_tile_looks_like( id, category, variant, looks_like_jumps_limit );
+    }
+    // Drawing asks for the same few hundred ids every frame, each of which may take several
+    // string concatenations, map lookups and a walk down the looks_like chain to resolve.
+    const season_type season = season_of_year( calendar::turn );
+    tile_lookup_cache &lookups = tile_lookups[season][static_cast<size_t>( category )];
+    std::unordered_map<std::string, std::optional<tile_lookup_res>> &by_variant = lookups[id];
+    const auto iter = by_variant.find( variant );
+    if( iter != by_variant.end() ) {
+        return iter->second;
+    }
+    std::optional<tile_lookup_res> ret = resolve_tile_looks_like( id, category, variant,
+                                         looks_like_jumps_limit );
+    by_variant.emplace( variant, ret );
+    return ret;
+}
+
+std::optional<tile_lookup_res>
+cata_tiles::resolve_tile_looks_like( const std::string &id, TILE_CATEGORY category,
+                                     const std::string &variant,
+                                     const int looks_like_jumps_limit ) const
 {
     if( id.empty() || looks_like_jumps_limit <= 0 ) {
         return std::nullopt;
@@ -2490,7 +2640,7 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
         int intensity_level, const std::string &variant,
         const point &offset )
 {
-    bool nv_color_active = apply_night_vision_goggles && get_option<bool>( "NV_GREEN_TOGGLE" );
+    bool nv_color_active = apply_night_vision_goggles && option_nv_green_toggle.get();
     // If the ID string does not produce a drawable tile
     // it will revert to the "unknown" tile.
     // The "unknown" tile is one that is highly visible so you kinda can't miss it :D
@@ -2905,6 +3055,7 @@ bool cata_tiles::draw_from_id_string_internal( const std::string &id, TILE_CATEG
 
         // idle tile animations:
         if( display_tile.animated ) {
+            map_frame_animated = true;
             // idle animations run during the user's turn, and the animation speed
             // needs to be defined by the tileset to look good, so we use system clock:
             std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
@@ -3018,16 +3169,14 @@ bool cata_tiles::draw_sprite_at(
     if( rotate_sprite ) {
         if( rota == -1 ) {
             // flip horizontally
-            ret = sprite_tex->render_copy_ex(
-                      renderer, &destination, 0, nullptr,
-                      static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL ) );
+            ret = sprite_tex->render_copy_ex( sprites, destination, 0,
+                                              static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL ) );
         } else {
             switch( rota % 4 ) {
                 default:
                 case 0:
                     // unrotated (and 180, with just two sprites)
-                    ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                      SDL_FLIP_NONE );
+                    ret = sprite_tex->render_copy_ex( sprites, destination, 0, SDL_FLIP_NONE );
                     break;
                 case 1:
                     // 90 degrees (and 270, with just two sprites)
@@ -3040,11 +3189,9 @@ bool cata_tiles::draw_sprite_at(
 #endif
                     if( !is_isometric() ) {
                         // never rotate isometric tiles
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, -90, nullptr,
-                                                          SDL_FLIP_NONE );
+                        ret = sprite_tex->render_copy_ex( sprites, destination, -90, SDL_FLIP_NONE );
                     } else {
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                          SDL_FLIP_NONE );
+                        ret = sprite_tex->render_copy_ex( sprites, destination, 0, SDL_FLIP_NONE );
                     }
                     break;
                 case 2:
@@ -3052,11 +3199,10 @@ bool cata_tiles::draw_sprite_at(
                     if( !is_isometric() ) {
                         // never flip isometric tiles vertically
                         ret = sprite_tex->render_copy_ex(
-                                  renderer, &destination, 0, nullptr,
+                                  sprites, destination, 0,
                                   static_cast<SDL_RendererFlip>( SDL_FLIP_HORIZONTAL | SDL_FLIP_VERTICAL ) );
                     } else {
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                          SDL_FLIP_NONE );
+                        ret = sprite_tex->render_copy_ex( sprites, destination, 0, SDL_FLIP_NONE );
                     }
                     break;
                 case 3:
@@ -3070,21 +3216,19 @@ bool cata_tiles::draw_sprite_at(
 #endif
                     if( !is_isometric() ) {
                         // never rotate isometric tiles
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 90, nullptr,
-                                                          SDL_FLIP_NONE );
+                        ret = sprite_tex->render_copy_ex( sprites, destination, 90, SDL_FLIP_NONE );
                     } else {
-                        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr,
-                                                          SDL_FLIP_NONE );
+                        ret = sprite_tex->render_copy_ex( sprites, destination, 0, SDL_FLIP_NONE );
                     }
                     break;
             }
         }
     } else {
         // don't rotate, same as case 0 above
-        ret = sprite_tex->render_copy_ex( renderer, &destination, 0, nullptr, SDL_FLIP_NONE );
+        ret = sprite_tex->render_copy_ex( sprites, destination, 0, SDL_FLIP_NONE );
     }
 
-    printErrorIf( ret != 0, "SDL_RenderCopyEx() failed" );
+    printErrorIf( ret != 0, "Drawing a sprite failed" );
     // this reference passes all the way back up the call chain back to
     // cata_tiles::draw() here.draw_points_cache[z][row][col].com.height_3d
     // where we are accumulating the height of every sprite stacked up in a tile
@@ -3222,6 +3366,7 @@ void cata_tiles::draw_square_below( const point &p, const nc_color &col, const i
         sdlrect.x = screen.x + divide_round_down( tile_width - sdlrect.w, 2 );
         sdlrect.y = screen.y + divide_round_down( tile_height - sdlrect.h, 2 );
     }
+    sprites.flush();
     geometry->rect( renderer, sdlrect, sdlcol );
 }
 
@@ -3596,7 +3741,10 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
     const auto fld_override = field_override.find( tripoint_bub_ms( p ) );
     const bool fld_overridden = fld_override != field_override.end();
     map &here = get_map();
-    const field &f = here.field_at( p );
+    // Most tiles hold no field, those don't need the submap looked up.
+    static const field no_field;
+    const field &f = here.has_field_at( tripoint_bub_ms( p ) ) ?
+                     std::as_const( here ).field_at( tripoint_bub_ms( p ) ) : no_field;
     const field_type_id &fld = fld_overridden ?
                                fld_override->second : f.displayed_field_type();
     bool ret_draw_field = false;
@@ -3614,10 +3762,12 @@ bool cata_tiles::draw_field_or_item( const tripoint &p, const lit_level ll, int
                 auto has_field = [&]( field_type_id fld, const tripoint & q, const bool invis ) -> field_type_id {
                     // go through the fields and see if they are equal
                     field_type_id found = fd_null;
-                    for( std::pair<const field_type_id, field_entry> &this_fld : here.field_at( q ) )
-                    {
-                        if( this_fld.first == fld ) {
-                            found = fld;
+                    if( here.has_field_at( tripoint_bub_ms( q ) ) ) {
+                        for( const std::pair<const field_type_id, field_entry> &this_fld :
+                             std::as_const( here ).field_at( tripoint_bub_ms( q ) ) ) {
+                            if( this_fld.first == fld ) {
+                                found = fld;
+                            }
                         }
                     }
                     const auto it = field_override.find( tripoint_bub_ms( q ) );
@@ -4336,6 +4486,7 @@ void cata_tiles::draw_zlevel_overlay( const tripoint &p, const lit_level ll, int
 
     // Change blend mode for transparency to work
     // Disable after to avoid visual bugs
+    sprites.flush();
     SetRenderDrawBlendMode( renderer, SDL_BLENDMODE_BLEND );
     geometry->rect( renderer, draw_rect, fog_color );
     SetRenderDrawBlendMode( renderer, SDL_BLENDMODE_NONE );
@@ -4670,6 +4821,14 @@ void cata_tiles::void_monster_override()
     monster_override.clear();
 }
 
+bool cata_tiles::has_any_draw_override() const
+{
+    return !radiation_override.empty() || !terrain_override.empty() ||
+           !furniture_override.empty() || !graffiti_override.empty() || !trap_override.empty() ||
+           !field_override.empty() || !item_override.empty() || !vpart_override.empty() ||
+           !draw_below_override.empty() || !monster_override.empty();
+}
+
 bool cata_tiles::has_draw_override( const tripoint &p ) const
 {
     return radiation_override.find( tripoint_bub_ms( p ) ) != radiation_override.end() ||
@@ -4863,7 +5022,7 @@ void cata_tiles::draw_weather_frame()
 
 void cata_tiles::draw_sct_frame( std::multimap<point, formatted_text> &overlay_strings )
 {
-    const bool use_font = get_option<bool>( "ANIMATION_SCT_USE_FONT" );
+    const bool use_font = option_animation_sct_use_font.get();
     tripoint player_pos = get_player_character().pos();
 
     for( const scrollingcombattext::cSCT &sct : SCT.vSCT ) {
@@ -2,9 +2,11 @@
 #ifndef CATA_SRC_CATA_TILES_H
 #define CATA_SRC_CATA_TILES_H
 
+#include <array>
 #include <cstddef>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <tuple>
 #include <unordered_map>
@@ -12,6 +14,7 @@
 #include <vector>
 
 #include "animation.h"
+#include "calendar.h"
 #include "cata_type_traits.h"
 #include "creature.h"
 #include "cuboid_rectangle.h"
@@ -25,6 +28,7 @@
 #include "point.h"
 #include "sdl_wrappers.h"
 #include "sdl_geometry.h"
+#include "sdl_sprite_batch.h"
 #include "type_id.h"
 #include "weather.h"
 #include "weighted_list.h"
@@ -140,6 +144,11 @@ class texture
             return SDL_RenderCopyEx( renderer.get(), sdl_texture_ptr.get(), &srcrect, dstrect, angle, center,
                                      flip );
         }
+        /// Same as above, rotating around the center of @p dstrect, through @p batch.
+        int render_copy_ex( sprite_batch &batch, const SDL_Rect &dstrect, const double angle,
+                            const SDL_RendererFlip flip ) const {
+            return batch.add( sdl_texture_ptr.get(), srcrect, dstrect, angle, flip );
+        }
 };
 
 class layer_variant
@@ -462,9 +471,19 @@ class cata_tiles
 
         std::optional<tile_lookup_res> find_tile_with_season( const std::string &id ) const;
 
+        static constexpr int max_looks_like_jumps = 10;
+
+        /**
+         * Tile for @p id with @p variant in the current season, following looks_like up to
+         * @p looks_like_jumps_limit times.  Lookups from the top of the looks_like chain are
+         * remembered until the tileset is loaded again.
+         */
         std::optional<tile_lookup_res>
         find_tile_looks_like( const std::string &id, TILE_CATEGORY category, const std::string &variant,
-                              int looks_like_jumps_limit = 10 ) const;
+                              int looks_like_jumps_limit = max_looks_like_jumps ) const;
+        std::optional<tile_lookup_res>
+        resolve_tile_looks_like( const std::string &id, TILE_CATEGORY category,
+                                 const std::string &variant, int looks_like_jumps_limit ) const;
 
         // this templated method is used only from it's own cpp file, so it's ok to declare it here
         template<typename T>
@@ -672,6 +691,7 @@ class cata_tiles
         void void_monster_override();
 
         bool has_draw_override( const tripoint &p ) const;
+        bool has_any_draw_override() const;
 
         void set_disable_occlusion( bool val );
 
@@ -753,7 +773,14 @@ class cata_tiles
         const SDL_Renderer_Ptr &renderer;
         const GeometryRenderer_Ptr &geometry;
         tileset_cache &cache;
+        // Collects the sprites of the map layers into as few draw calls as possible.
+        sprite_batch sprites;
         std::shared_ptr<const tileset> tileset_ptr;
+        // Results of find_tile_looks_like by season and category, then by id and variant.
+        using tile_lookup_cache = std::unordered_map<std::string,
+              std::unordered_map<std::string, std::optional<tile_lookup_res>>>;
+        mutable std::array<std::array<tile_lookup_cache, static_cast<size_t>( TILE_CATEGORY::last )>,
+              season_type::NUM_SEASONS> tile_lookups;
 
         // the scaled default sprite width and height. in non-isometric mode,
         // the basic tile width and height equal the default sprite width and
@@ -841,11 +868,42 @@ class cata_tiles
          */
         bool nv_goggles_activated = false;
 
+        /** What the map layers in @ref map_frame were drawn for. */
+        struct map_frame_key {
+            point dest;
+            point size;
+            tripoint center;
+            point tile_size;
+            const tileset *tiles = nullptr;
+            time_point turn;
+            bool nv_goggles = false;
+
+            bool operator==( const map_frame_key &rhs ) const;
+        };
+        /**
+         * Redirects drawing of the map layers to @ref map_frame, returns false if the texture
+         * couldn't be created and the layers have to be drawn directly.
+         */
+        bool begin_map_frame( const map_frame_key &key );
+        /** Copies the layers drawn since @ref begin_map_frame to the display buffer. */
+        void end_map_frame( const map_frame_key &key );
+        /**
+         * The map layers as last drawn by @ref draw, copied over again instead of being redrawn
+         * while the draw points are unchanged, see @ref set_draw_cache_dirty.
+         */
+        SDL_Texture_Ptr map_frame;
+        point map_frame_size;
+        std::optional<map_frame_key> map_frame_drawn_with;
+        // Set when an idle animation was drawn, which changes without the map changing.
+        bool map_frame_animated = false;
+
         pimpl<pixel_minimap> minimap;
 
     public:
         // Draw caches persist data between draws and are only recalculated when dirty
         void set_draw_cache_dirty();
+        // Forgets the last drawn map layers, for when the textures lost their contents.
+        void invalidate_map_frame();
 
         std::string memory_map_mode = "color_pixel_sepia";
 };
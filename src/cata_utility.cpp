@@ -13,6 +13,7 @@
 #include <exception>
 #include <fstream>
 #include <iosfwd>
+#include <locale>
 #include <ostream>
 #include <sstream>
 #include <stdexcept>
@@ -94,30 +95,122 @@ bool lcmatch( const std::string_view str, const std::string_view qry )
     if( qry.empty() ) {
         return true;
     }
+    return lcmatcher( qry )( str );
+}
+
+bool lcmatch( const translation &str, const std::string_view qry )
+{
+    return lcmatch( str.translated(), qry );
+}
+
+lcmatcher::lcmatcher( const std::string_view qry ) : qry( utf8_to_utf32( qry ) )
+{
+    std::for_each( this->qry.begin(), this->qry.end(), u32_to_lowercase );
+}
+
+bool lcmatcher::operator()( const std::string_view str ) const
+{
+    if( qry.empty() ) {
+        return true;
+    }
 
     std::u32string u32_str = utf8_to_utf32( str );
-    std::u32string u32_qry = utf8_to_utf32( qry );
     std::for_each( u32_str.begin(), u32_str.end(), u32_to_lowercase );
-    std::for_each( u32_qry.begin(), u32_qry.end(), u32_to_lowercase );
     // First try match their lowercase forms
-    if( u32_str.find( u32_qry ) != std::u32string::npos ) {
+    if( u32_str.find( qry ) != std::u32string::npos ) {
         return true;
     }
     // Then try removing accents from str ONLY
     std::for_each( u32_str.begin(), u32_str.end(), remove_accent );
-    if( u32_str.find( u32_qry ) != std::u32string::npos ) {
+    if( u32_str.find( qry ) != std::u32string::npos ) {
         return true;
     }
     if( use_pinyin_search ) {
         // Finally, try to convert the string to pinyin and compare
-        return pinyin::pinyin_match( u32_str, u32_qry );
+        return pinyin::pinyin_match( u32_str, qry );
     }
     return false;
 }
 
-bool lcmatch( const translation &str, const std::string_view qry )
+wildcard_matcher::wildcard_matcher( const std::string_view pattern )
+    : pieces( string_split( wildcard_trim_rule( std::string( pattern ) ), '*' ) )
 {
-    return lcmatch( str.translated(), qry );
+}
+
+bool wildcard_matcher::operator()( std::string_view text ) const
+{
+    if( text.empty() ) {
+        return false;
+    } else if( text == "*" ) {
+        return true;
+    }
+
+    const std::locale loc;
+    if( pieces.size() == 1 ) { // no * found
+        return text.length() == pieces[0].length() && ci_find_substr( text, pieces[0], loc ) != -1;
+    }
+
+    for( size_t i = 0; i < pieces.size(); ++i ) {
+        const std::string &piece = pieces[i];
+        if( piece.empty() ) {
+            continue;
+        }
+        if( i == 0 ) {
+            if( text.length() < piece.length() ||
+                ci_find_substr( text.substr( 0, piece.length() ), piece, loc ) == -1 ) {
+                return false;
+            }
+            text.remove_prefix( piece.length() );
+        } else if( i == pieces.size() - 1 ) {
+            if( text.length() < piece.length() ||
+                ci_find_substr( text.substr( text.length() - piece.length() ), piece,
+                                loc ) == -1 ) {
+                return false;
+            }
+        } else {
+            const int pos = ci_find_substr( text, piece, loc );
+            if( pos == -1 ) {
+                return false;
+            }
+            text.remove_prefix( pos + piece.length() );
+        }
+    }
+
+    return true;
+}
+
+bool lcmatcher::operator()( const translation &str ) const
+{
+    return ( *this )( str.translated() );
+}
+
+bool lcmatcher::operator()( const lcmatch_subject &str ) const
+{
+    if( qry.empty() ) {
+        return true;
+    }
+    // The same steps as for a plain string, with the conversions done up front
+    if( str.lower.find( qry ) != std::u32string::npos ) {
+        return true;
+    }
+    const std::u32string &unaccented = str.unaccented.empty() ? str.lower : str.unaccented;
+    if( !str.unaccented.empty() && unaccented.find( qry ) != std::u32string::npos ) {
+        return true;
+    }
+    if( use_pinyin_search ) {
+        return pinyin::pinyin_match( unaccented, qry );
+    }
+    return false;
+}
+
+lcmatch_subject::lcmatch_subject( const std::string_view str ) : lower( utf8_to_utf32( str ) )
+{
+    std::for_each( lower.begin(), lower.end(), u32_to_lowercase );
+    std::u32string stripped = lower;
+    std::for_each( stripped.begin(), stripped.end(), remove_accent );
+    if( stripped != lower ) {
+        unaccented = std::move( stripped );
+    }
 }
 
 bool match_include_exclude( const std::string_view text, std::string filter )
@@ -323,6 +416,44 @@ void write_to_file( const cata_path &path, const std::function<void( std::ostrea
     fout.close();
 }
 
+void write_to_file_compressed( const cata_path &path, const int compression_level,
+                               const std::function<void( std::ostream & )> &writer )
+{
+    if( compression_level <= 0 ) {
+        write_to_file( path, writer );
+        return;
+    }
+    std::ostringstream buffer;
+    writer( buffer );
+    const std::string data = gzip_compress( buffer.str(), compression_level );
+    write_to_file( path, [&]( std::ostream & fout ) {
+        fout.write( data.data(), data.size() );
+    } );
+}
+
+bool write_to_file_compressed( const cata_path &path, const int compression_level,
+                               const std::function<void( std::ostream & )> &writer,
+                               const char *const fail_message )
+{
+    try {
+        write_to_file_compressed( path, compression_level, writer );
+        return true;
+
+    } catch( const std::exception &err ) {
+        if( fail_message ) {
+            const std::string msg =
+                string_format( _( "Failed to write %1$s to \"%2$s\": %3$s" ),
+                               fail_message, path.generic_u8string(), err.what() );
+            if( test_mode ) {
+                DebugLog( D_ERROR, DC_ALL ) << msg;
+            } else {
+                popup( "%s", msg );
+            }
+        }
+        return false;
+    }
+}
+
 bool write_to_file( const cata_path &path, const std::function<void( std::ostream & )> &writer,
                     const char *const fail_message )
 {
@@ -388,18 +519,49 @@ std::istream &safe_getline( std::istream &ins, std::string &str )
     }
 }
 
-namespace
+bool is_gzip_data( const std::string_view data )
 {
+    // (byte1 == 0x1f) && (byte2 == 0x8b)
+    return data.size() >= 2 && data[0] == '\x1f' && data[1] == '\x8b';
+}
 
-std::string read_compressed_file_to_string( std::istream &fin )
+std::string gzip_compress( const std::string_view data, const int compression_level )
 {
-    std::string outstring;
+    z_stream zs;
+    memset( &zs, 0, sizeof( zs ) );
 
-    std::ostringstream deflated_contents_stream;
-    std::string str;
+    // MAX_WBITS | 16 selects the gzip wrapper instead of a raw zlib stream.
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+    if( deflateInit2( &zs, clamp( compression_level, 1, 9 ), Z_DEFLATED, MAX_WBITS | 16, 8,
+                      Z_DEFAULT_STRATEGY ) != Z_OK ) {
+#pragma GCC diagnostic pop
+        throw std::runtime_error( "deflateInit failed while compressing." );
+    }
 
-    deflated_contents_stream << fin.rdbuf();
-    str = deflated_contents_stream.str();
+    std::string outstring;
+    outstring.resize( deflateBound( &zs, data.size() ) );
+    zs.next_in = reinterpret_cast<unsigned char *>( const_cast<char *>( data.data() ) );
+    zs.avail_in = data.size();
+    zs.next_out = reinterpret_cast<Bytef *>( outstring.data() );
+    zs.avail_out = outstring.size();
+
+    // The output is sized by deflateBound, so a single call finishes the stream.
+    const int ret = deflate( &zs, Z_FINISH );
+    outstring.resize( zs.total_out );
+    deflateEnd( &zs );
+
+    if( ret != Z_STREAM_END ) {
+        std::ostringstream oss;
+        oss << "Exception during zlib compression: (" << ret << ") " << zs.msg;
+        throw std::runtime_error( oss.str() );
+    }
+    return outstring;
+}
+
+std::string gzip_decompress( const std::string_view data )
+{
+    std::string outstring;
 
     z_stream zs;
     memset( &zs, 0, sizeof( zs ) );
@@ -411,8 +573,8 @@ std::string read_compressed_file_to_string( std::istream &fin )
         throw std::runtime_error( "inflateInit failed while decompressing." );
     }
 
-    zs.next_in = reinterpret_cast<unsigned char *>( const_cast<char *>( str.data() ) );
-    zs.avail_in = str.size();
+    zs.next_in = reinterpret_cast<unsigned char *>( const_cast<char *>( data.data() ) );
+    zs.avail_in = data.size();
 
     int ret;
     std::array<char, 32768> outbuffer;
@@ -442,6 +604,16 @@ std::string read_compressed_file_to_string( std::istream &fin )
     return outstring;
 }
 
+namespace
+{
+
+std::string read_compressed_file_to_string( std::istream &fin )
+{
+    std::ostringstream deflated_contents_stream;
+    deflated_contents_stream << fin.rdbuf();
+    return gzip_decompress( deflated_contents_stream.str() );
+}
+
 } // namespace
 
 bool read_from_file( const cata_path &path, const std::function<void( std::istream & )> &reader )
@@ -15,6 +15,7 @@
 #include <ostream>
 #include <sstream>
 #include <string> // IWYU pragma: keep
+#include <string_view>
 #include <type_traits>
 #include <unordered_set>
 #include <utility>
@@ -112,6 +113,49 @@ bool isBetween( int test, int down, int up );
 bool lcmatch( std::string_view str, std::string_view qry );
 bool lcmatch( const translation &str, std::string_view qry );
 
+/**
+ * A string converted once for lcmatcher, for matching it against many queries.
+ */
+class lcmatch_subject
+{
+    public:
+        lcmatch_subject() = default;
+        explicit lcmatch_subject( std::string_view str );
+    private:
+        friend class lcmatcher;
+        std::u32string lower;
+        // lower with the accents removed, empty if it has none
+        std::u32string unaccented;
+};
+
+/**
+ * lcmatch() with the query converted once, for matching many subjects against the same query.
+ */
+class lcmatcher
+{
+    public:
+        explicit lcmatcher( std::string_view qry );
+        bool operator()( std::string_view str ) const;
+        bool operator()( const translation &str ) const;
+        bool operator()( const lcmatch_subject &str ) const;
+    private:
+        std::u32string qry;
+};
+
+/**
+ * wildcard_match() with the pattern split once, for matching many texts against the same
+ * pattern.
+ */
+class wildcard_matcher
+{
+    public:
+        explicit wildcard_matcher( std::string_view pattern );
+        bool operator()( std::string_view text ) const;
+    private:
+        // The pattern split at each *, after collapsing runs of them
+        std::vector<std::string> pieces;
+};
+
 /**
  * Matches text case insensitive with the include/exclude rules of the filter
  *
@@ -325,6 +369,29 @@ bool write_to_file( const cata_path &path, const std::function<void( std::ostrea
 void write_to_file( const cata_path &path, const std::function<void( std::ostream & )> &writer );
 ///@}
 
+/**
+ * Like @ref write_to_file, but gzip compresses whatever the writer produced before it
+ * reaches the disk. @p compression_level is a zlib level from 1 (fastest) to 9 (smallest),
+ * 0 or less writes the data uncompressed.
+ *
+ * All the reading functions below detect compressed files by their magic bytes, so files
+ * written either way can always be read back.
+ */
+///@{
+bool write_to_file_compressed( const cata_path &path, int compression_level,
+                               const std::function<void( std::ostream & )> &writer,
+                               const char *fail_message );
+void write_to_file_compressed( const cata_path &path, int compression_level,
+                               const std::function<void( std::ostream & )> &writer );
+///@}
+
+/** Whether @p data starts with the gzip magic bytes. */
+bool is_gzip_data( std::string_view data );
+/** Compresses @p data into a gzip stream at the given zlib level. Throws on error. */
+std::string gzip_compress( std::string_view data, int compression_level );
+/** Inflates a gzip stream as made by @ref gzip_compress. Throws on error. */
+std::string gzip_decompress( std::string_view data );
+
 /**
  * Try to open and read from given file using the given callback.
  *
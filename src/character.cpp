@@ -3107,6 +3107,7 @@ std::list<item> Character::remove_worn_items_with( const std::function<bool( ite
 void Character::clear_worn()
 {
     worn.worn.clear();
+    worn.invalidate_derived_stats();
     inv_search_caches.clear();
 }
 
@@ -3989,6 +3990,8 @@ void Character::calc_encumbrance()
 
 void Character::calc_encumbrance( const item &new_item )
 {
+    // Everything derived from the worn items is refreshed along with encumbrance.
+    worn.invalidate_derived_stats();
 
     std::map<bodypart_id, encumbrance_data> enc;
     worn.item_encumb( enc, new_item, *this );
@@ -10430,9 +10433,22 @@ bool Character::is_visible_in_range( const Creature &critter, const int range )
     return sees( critter ) && rl_dist( pos(), critter.pos() ) <= range;
 }
 
+// Like game::get_creatures_if, but only visits the creatures within range of @p you.
+template<typename Predicate>
+static std::vector<Creature *> get_creatures_in_range_if( const Character &you, const int range,
+        Predicate &&pred )
+{
+    std::vector<Creature *> result = get_creature_tracker().creatures_in_radius( you.get_location(),
+                                     range );
+    result.erase( std::remove_if( result.begin(), result.end(), [&pred]( const Creature * critter ) {
+        return !pred( *critter );
+    } ), result.end() );
+    return result;
+}
+
 std::vector<Creature *> Character::get_visible_creatures( const int range ) const
 {
-    return g->get_creatures_if( [this, range]( const Creature & critter ) -> bool {
+    return get_creatures_in_range_if( *this, range, [this, range]( const Creature & critter ) -> bool {
         return this != &critter && pos() != critter.pos() && // TODO: get rid of fake npcs (pos() check)
         rl_dist( pos(), critter.pos() ) <= range && sees( critter );
     } );
@@ -10441,7 +10457,8 @@ std::vector<Creature *> Character::get_visible_creatures( const int range ) cons
 std::vector<Creature *> Character::get_targetable_creatures( const int range, bool melee ) const
 {
     map &here = get_map();
-    return g->get_creatures_if( [this, range, melee, &here]( const Creature & critter ) -> bool {
+    return get_creatures_in_range_if( *this, range, [this, range, melee,
+    &here]( const Creature & critter ) -> bool {
         //the call to map.sees is to make sure that even if we can see it through walls
         //via a mutation or cbm we only attack targets with a line of sight
         bool can_see = ( ( sees( critter ) || sees_with_infrared( critter ) ) && here.sees( pos_bub(), critter.pos_bub(), 100 ) );
@@ -10485,7 +10502,7 @@ int Character::get_mutation_visibility_cap( const Character *observed ) const
 
 std::vector<Creature *> Character::get_hostile_creatures( int range ) const
 {
-    return g->get_creatures_if( [this, range]( const Creature & critter ) -> bool {
+    return get_creatures_in_range_if( *this, range, [this, range]( const Creature & critter ) -> bool {
         // Fixes circular distance range for ranged attacks
         float dist_to_creature = std::round( rl_dist_exact( pos(), critter.pos() ) );
         return this != &critter && pos() != critter.pos() && // TODO: get rid of fake npcs (pos() check)
@@ -3504,6 +3504,12 @@ class Character : public Creature, public visitable
         const inventory &crafting_inventory( const tripoint &src_pos = tripoint_zero,
                                              int radius = PICKUP_RANGE, bool clear_path = true ) const;
         void invalidate_crafting_inventory();
+        /**
+         * Identifies the last crafting inventory built for this character. It is unique across
+         * all characters and changes on every rebuild, so anything derived from the crafting
+         * inventory (like recipe availability) stays valid while the revision stays the same.
+         */
+        int crafting_inventory_revision() const;
 
         /** Returns a value from 1.0 to 11.0 that acts as a multiplier
          * for the time taken to perform tasks that require detail vision,
@@ -4146,6 +4152,8 @@ class Character : public Creature, public visitable
             int moves;
             tripoint position;
             int radius;
+            bool clear_path;
+            int revision = 0;
             pimpl<inventory> crafting_inventory;
         };
         mutable crafting_cache_type crafting_cache;
@@ -340,6 +340,7 @@ std::optional<std::list<item>::iterator> outfit::wear_item( Character &guy, cons
         // this is used for debug and putting on clothing in the wrong order
         worn.push_back( to_wear );
     }
+    invalidate_derived_stats();
 
     item_location loc = new_item_it != worn.end() ?
                         item_location( guy, &*new_item_it ) : item_location();
@@ -1184,6 +1185,7 @@ std::list<item> outfit::remove_worn_items_with( const std::function<bool( item &
             }
             iter->on_takeoff( guy );
             result.splice( result.begin(), worn, iter++ );
+            invalidate_derived_stats();
         } else {
             ++iter;
         }
@@ -1522,6 +1524,7 @@ bool outfit::takeoff( item_location loc, std::list<item> *res, Character &guy )
     it.on_takeoff( guy );
     item takeoff_copy( it );
     worn.erase( iter );
+    invalidate_derived_stats();
     if( res == nullptr ) {
         guy.i_add( takeoff_copy, true, &it, &it, true, !guy.has_weapon() );
     } else {
@@ -1782,6 +1785,7 @@ std::list<item> outfit::use_amount( const itype_id &it, int quantity,
         if( a->use_amount( it, quantity, used, filter ) ) {
             a->on_takeoff( wearer );
             a = worn.erase( a );
+            invalidate_derived_stats();
         } else {
             ++a;
         }
@@ -1910,6 +1914,7 @@ void outfit::absorb_damage( Character &guy, damage_unit &elem, bodypart_id bp,
 
     // generate a single roll for determining if hit
     int roll = rng( 1, 100 );
+    const item::cover_type ctype = item::get_cover_type( elem.type );
 
     // Only the outermost armor can be set on fire
     bool outermost = true;
@@ -1923,14 +1928,26 @@ void outfit::absorb_damage( Character &guy, damage_unit &elem, bodypart_id bp,
             continue;
         }
 
+        item_armor_enchantment_adjust( guy, elem, armor );
+        // FIXME: Hardcoded damage type
+        const bool burns = outermost && elem.type == STATIC( damage_type_id( "heat" ) ) &&
+                           elem.amount >= 1.0f;
+        // Armor the roll misses stays untouched and can't need its name for the destroyed message.
+        const bool misses_secondary = secondary_sbp == sub_bodypart_id() ||
+                                      roll > armor.get_coverage( secondary_sbp, ctype );
+        if( !burns && !armor.is_ablative() && roll > armor.get_coverage( sbp, ctype ) &&
+            misses_secondary ) {
+            ++iter;
+            outermost = false;
+            continue;
+        }
+
         const std::string pre_damage_name = armor.tname();
         bool destroy = false;
 
-        item_armor_enchantment_adjust( guy, elem, armor );
         // Heat damage can set armor on fire
         // Even though it doesn't cause direct physical damage to it
-        // FIXME: Hardcoded damage type
-        if( outermost && elem.type == STATIC( damage_type_id( "heat" ) ) && elem.amount >= 1.0f ) {
+        if( burns ) {
             // TODO: Different fire intensity values based on damage
             fire_data frd{ 2 };
             destroy = !armor.has_flag( flag_INTEGRATED ) && armor.burn( frd );
@@ -1975,6 +1992,7 @@ void outfit::absorb_damage( Character &guy, damage_unit &elem, bodypart_id bp,
             // iterator to the next element, not the one the revers_iterator points to.
             // http://stackoverflow.com/questions/1830158/how-to-call-erase-with-a-reverse-iterator
             iter = decltype( iter )( worn.erase( --iter.base() ) );
+            invalidate_derived_stats();
         } else {
             ++iter;
             outermost = false;
@@ -2008,28 +2026,45 @@ int outfit::get_env_resist( bodypart_id bp ) const
 
 std::map<bodypart_id, int> outfit::warmth( const Character &guy ) const
 {
-    std::map<bodypart_id, int> total_warmth;
-    for( const bodypart_id &bp : guy.get_all_body_parts() ) {
-        double warmth_val = 0.0;
-        const float wetness_pct = guy.get_part_wetness_percentage( bp );
+    if( warmth_cache_dirty ) {
+        warmth_cache.clear();
         for( const item &clothing : worn ) {
-            if( !clothing.covers( bp ) ) {
-                continue;
-            }
-            warmth_val = clothing.get_warmth( bp );
-            // Wool items do not lose their warmth due to being wet.
-            // Warmth is reduced by 0 - 66% based on wetness.
-            if( !clothing.made_of( material_wool ) ) {
-                warmth_val *= 1.0 - 0.66 * wetness_pct;
+            const bool wool = clothing.made_of( material_wool );
+            for( const bodypart_id &bp : guy.get_all_body_parts() ) {
+                if( clothing.covers( bp ) ) {
+                    warmth_cache[bp].emplace_back( clothing.get_warmth( bp ), wool );
+                }
             }
+        }
+        warmth_cache_dirty = false;
+    }
 
-            total_warmth[bp] += warmth_val;
+    std::map<bodypart_id, int> total_warmth;
+    for( const bodypart_id &bp : guy.get_all_body_parts() ) {
+        int &bp_warmth = total_warmth[bp];
+        const auto clothing_warmth = warmth_cache.find( bp );
+        if( clothing_warmth != warmth_cache.end() ) {
+            const float wetness_pct = guy.get_part_wetness_percentage( bp );
+            for( const std::pair<int, bool> &warmth_and_wool : clothing_warmth->second ) {
+                double warmth_val = warmth_and_wool.first;
+                // Wool items do not lose their warmth due to being wet.
+                // Warmth is reduced by 0 - 66% based on wetness.
+                if( !warmth_and_wool.second ) {
+                    warmth_val *= 1.0 - 0.66 * wetness_pct;
+                }
+                bp_warmth += warmth_val;
+            }
         }
-        total_warmth[bp] += guy.get_effect_int( effect_heating_bionic, bp );
+        bp_warmth += guy.get_effect_int( effect_heating_bionic, bp );
     }
     return total_warmth;
 }
 
+void outfit::invalidate_derived_stats()
+{
+    warmth_cache_dirty = true;
+}
+
 std::unordered_set<bodypart_id> outfit::where_discomfort( const Character &guy ) const
 {
     // get all rigid body parts to begin with
@@ -2098,6 +2133,7 @@ void outfit::insert_item_at_index( const item &clothing, int index )
     auto it = worn.begin();
     std::advance( it, index );
     worn.insert( it, clothing );
+    invalidate_derived_stats();
 }
 
 units::length outfit::max_single_item_length() const
@@ -85,6 +85,13 @@ class outfit
         friend class Character;
     private:
         std::list<item> worn;
+        /**
+         * Warmth of each worn item on each body part it covers, in worn order, and whether
+         * it is made of wool (which doesn't lose warmth when wet). Only wetness and effects
+         * change from turn to turn, so this is rebuilt after invalidate_derived_stats() only.
+         */
+        mutable std::map<bodypart_id, std::vector<std::pair<int, bool>>> warmth_cache;
+        mutable bool warmth_cache_dirty = true;
     public:
         outfit() = default;
         explicit outfit( const std::list<item> &items ) : worn( items ) {}
@@ -148,6 +155,11 @@ class outfit
         int collar_warmth() const;
         /** Returns warmth provided by armor, etc. */
         std::map<bodypart_id, int> warmth( const Character &guy ) const;
+        /**
+         * Marks the values derived from the worn items (like their warmth) as out of date.
+         * Called whenever encumbrance is recalculated, see @ref Character::calc_encumbrance.
+         */
+        void invalidate_derived_stats();
         int get_env_resist( bodypart_id bp ) const;
         int sum_filthy_cover( bool ranged, bool melee, bodypart_id bp ) const;
         ret_val<void> power_armor_conflicts( const item &clothing ) const;
@@ -457,7 +457,7 @@ void Character::update_bodytemp()
         vehwindspeed = std::abs( vp->vehicle().velocity / 100 ); // vehicle velocity in mph
     }
     const oter_id &cur_om_ter = overmap_buffer.ter( global_omt_location() );
-    bool sheltered = g->is_sheltered( pos_bub() );
+    const bool sheltered = g->is_sheltered( pos_bub() );
     int bp_windpower = get_local_windpower( weather_man.windspeed + vehwindspeed, cur_om_ter,
                                             get_location(), weather_man.winddirection, sheltered );
     // Let's cache this not to check it for every bodyparts
@@ -499,10 +499,12 @@ void Character::update_bodytemp()
     // Sunlight
     const float scaled_sun_irradiance = incident_sun_irradiance( get_weather().weather_id,
                                         calendar::turn ) / max_sun_irradiance();
-    const units::temperature_delta sunlight_warmth = !g->is_sheltered( pos() ) ? 3_C_delta *
+    const units::temperature_delta sunlight_warmth = !sheltered ? 3_C_delta *
             scaled_sun_irradiance :
             0_C_delta;
-    const int best_fire = get_best_fire( pos() );
+    // One scan of the surroundings serves both the adjacent fire and radiated heat
+    const heat_sources nearby_heat = get_heat_sources( pos() );
+    const int best_fire = nearby_heat.best_fire;
 
     const units::temperature_delta lying_warmth = use_floor_warmth ? floor_warmth( pos() ) : 0_C_delta;
     const units::temperature water_temperature =
@@ -515,7 +517,7 @@ void Character::update_bodytemp()
     // Difference between high and low is the "safe" heat - one we only apply if it's beneficial
     const units::temperature_delta mutation_heat_bonus = mutation_heat_high - mutation_heat_low;
 
-    const units::temperature_delta h_radiation = get_heat_radiation( pos() );
+    const units::temperature_delta h_radiation = nearby_heat.radiation;
 
     // 111F (44C) is a temperature in which proteins break down: https://en.wikipedia.org/wiki/Burn
     // Blisters arbitrarily scale with the sqrt of the temperature difference in fahrenheit.
@@ -974,13 +976,15 @@ void Character::update_stomach( const time_point &from, const time_point &to )
         mod_thirst( -units::to_milliliter<int>( digested_to_guts.water ) / 5 );
         // For vitamins, normal vitamins go through guts.
         // However, drug vitamins skip guts and get absorbed directly into the body.
+        // collect all drug vitamins in a map, then absorb them in one go
+        std::map<vitamin_id, int> drug_vitamins;
         for( const auto &vitamin : digested_to_guts.nutr.vitamins() ) {
-            // collect all drug vitamins in a map
-            std::map<vitamin_id, int> drug_vitamins;
             const vitamin_type &vitamin_type = vitamin.first->type();
             if( vitamin_type == vitamin_type::DRUG ) {
                 drug_vitamins[vitamin.first] = vitamin.second;
             }
+        }
+        if( !drug_vitamins.empty() ) {
             vitamins_mod( effect_vitamin_mod( drug_vitamins ) );
         }
 
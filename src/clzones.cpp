@@ -5,6 +5,7 @@
 #include <functional>
 #include <iosfwd>
 #include <iterator>
+#include <optional>
 #include <string>
 #include <tuple>
 
@@ -872,14 +873,8 @@ void zone_manager::cache_data( bool update_avatar )
             elem.update_cached_shift( cached_shift );
         }
 
-        const std::string &type_hash = elem.get_type_hash();
-        auto &cache = area_cache[type_hash];
-
-        // Draw marked area
-        for( const tripoint_abs_ms &p : tripoint_range<tripoint_abs_ms>(
-                 elem.get_start_point(), elem.get_end_point() ) ) {
-            cache.insert( p );
-        }
+        area_cache[elem.get_type_hash()].emplace_back( elem.get_start_point(),
+                elem.get_end_point() );
     }
 }
 
@@ -921,28 +916,59 @@ void zone_manager::cache_vzones( map *pmap )
             continue;
         }
 
-        const std::string &type_hash = elem->get_type_hash();
-        auto &cache = vzone_cache[type_hash];
-
-        // TODO: looks very similar to the above cache_data - maybe merge it?
+        vzone_cache[elem->get_type_hash()].emplace_back( elem->get_start_point(),
+                elem->get_end_point() );
+    }
+}
 
-        // Draw marked area
-        for( const tripoint_abs_ms &p : tripoint_range<tripoint_abs_ms>(
-                 elem->get_start_point(), elem->get_end_point() ) ) {
-            cache.insert( p );
-        }
+static const std::vector<inclusive_cuboid<tripoint_abs_ms>> &find_areas(
+    const std::unordered_map<std::string, std::vector<inclusive_cuboid<tripoint_abs_ms>>> &cache,
+    const zone_type_id &type, const faction_id &fac )
+{
+    static const std::vector<inclusive_cuboid<tripoint_abs_ms>> no_areas;
+    const auto &type_iter = cache.find( zone_data::make_type_hash( type, fac ) );
+    if( type_iter == cache.end() ) {
+        return no_areas;
     }
+    return type_iter->second;
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_point_set( const zone_type_id &type,
+const std::vector<zone_manager::zone_area> &zone_manager::get_areas( const zone_type_id &type,
         const faction_id &fac ) const
 {
-    const auto &type_iter = area_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == area_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
-    }
+    return find_areas( area_cache, type, fac );
+}
 
-    return type_iter->second;
+const std::vector<zone_manager::zone_area> &zone_manager::get_vzone_areas(
+    const zone_type_id &type, const faction_id &fac ) const
+{
+    return find_areas( vzone_cache, type, fac );
+}
+
+// Square distance from @p where to the closest point of @p area.
+static int square_dist( const inclusive_cuboid<tripoint_abs_ms> &area,
+                        const tripoint_abs_ms &where )
+{
+    return square_dist( clamp( where, area ), where );
+}
+
+// The points of @p area within square distance @p range of @p where, restricted to the
+// z-level of @p where if @p same_z.  Nullopt if there are none, tripoint_range can't be empty.
+static std::optional<tripoint_range<tripoint_abs_ms>> points_near(
+            const inclusive_cuboid<tripoint_abs_ms> &area, const tripoint_abs_ms &where, int range,
+            bool same_z = false )
+{
+    const int z_range = same_z ? 0 : range;
+    const tripoint_abs_ms min( std::max( area.p_min.x(), where.x() - range ),
+                               std::max( area.p_min.y(), where.y() - range ),
+                               std::max( area.p_min.z(), where.z() - z_range ) );
+    const tripoint_abs_ms max( std::min( area.p_max.x(), where.x() + range ),
+                               std::min( area.p_max.y(), where.y() + range ),
+                               std::min( area.p_max.z(), where.z() + z_range ) );
+    if( min.x() > max.x() || min.y() > max.y() || min.z() > max.z() ) {
+        return std::nullopt;
+    }
+    return tripoint_range<tripoint_abs_ms>( min, max );
 }
 
 std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint_abs_ms &where,
@@ -956,35 +982,37 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint_ab
 {
     std::unordered_set<tripoint> res;
     map &here = get_map();
-    for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : area_cache ) {
-        zone_type_id type = zone_data::unhash_type( cache.first );
-        faction_id z_fac = zone_data::unhash_fac( cache.first );
-        if( fac == z_fac && type.str().substr( 0, 4 ) == "LOOT" ) {
-            for( tripoint_abs_ms point : cache.second ) {
-                if( square_dist( where, point ) <= radius ) {
-                    res.emplace( here.bub_from_abs( point ).raw() );
-                }
+    for( const auto *cache : {
+             &area_cache, &vzone_cache
+         } ) {
+        for( const std::pair<const std::string, std::vector<zone_area>> &areas : *cache ) {
+            zone_type_id type = zone_data::unhash_type( areas.first );
+            faction_id z_fac = zone_data::unhash_fac( areas.first );
+            if( fac != z_fac || type.str().substr( 0, 4 ) != "LOOT" ) {
+                continue;
             }
-        }
-    }
-    for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : vzone_cache ) {
-        zone_type_id type = zone_data::unhash_type( cache.first );
-        faction_id z_fac = zone_data::unhash_fac( cache.first );
-        if( fac == z_fac && type.str().substr( 0, 4 ) == "LOOT" ) {
-            for( tripoint_abs_ms point : cache.second ) {
-                if( square_dist( where, point ) <= radius ) {
-                    res.emplace( here.bub_from_abs( point ).raw() );
+            for( const zone_area &area : areas.second ) {
+                if( const auto points = points_near( area, where, radius ) ) {
+                    for( const tripoint_abs_ms &point : *points ) {
+                        res.emplace( here.bub_from_abs( point ).raw() );
+                    }
                 }
             }
         }
     }
 
     if( npc_search ) {
-        for( const std::pair<std::string, std::unordered_set<tripoint_abs_ms>> cache : vzone_cache ) {
-            zone_type_id type = zone_data::unhash_type( cache.first );
-            if( type == zone_type_NO_NPC_PICKUP ) {
-                for( tripoint_abs_ms point : cache.second ) {
-                    res.erase( here.bub_from_abs( point ).raw() );
+        for( const std::pair<const std::string, std::vector<zone_area>> &areas : vzone_cache ) {
+            zone_type_id type = zone_data::unhash_type( areas.first );
+            if( type != zone_type_NO_NPC_PICKUP ) {
+                continue;
+            }
+            for( const zone_area &area : areas.second ) {
+                // Only points near enough can be in the result.
+                if( const auto points = points_near( area, where, radius ) ) {
+                    for( const tripoint_abs_ms &point : *points ) {
+                        res.erase( here.bub_from_abs( point ).raw() );
+                    }
                 }
             }
         }
@@ -993,42 +1021,30 @@ std::unordered_set<tripoint> zone_manager::get_point_set_loot( const tripoint_ab
     return res;
 }
 
-std::unordered_set<tripoint_abs_ms> zone_manager::get_vzone_set( const zone_type_id &type,
-        const faction_id &fac ) const
-{
-    //Only regenerate the vehicle zone cache if any vehicles have moved
-    const auto &type_iter = vzone_cache.find( zone_data::make_type_hash( type, fac ) );
-    if( type_iter == vzone_cache.end() ) {
-        return std::unordered_set<tripoint_abs_ms>();
-    }
-
-    return type_iter->second;
-}
-
 bool zone_manager::has( const zone_type_id &type, const tripoint_abs_ms &where,
                         const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    const auto &vzone_set = get_vzone_set( type, fac );
-    return point_set.find( where ) != point_set.end() || vzone_set.find( where ) != vzone_set.end();
+    const auto contains_where = [&where]( const zone_area & area ) {
+        return area.contains( where );
+    };
+    const std::vector<zone_area> &areas = get_areas( type, fac );
+    const std::vector<zone_area> &vzone_areas = get_vzone_areas( type, fac );
+    return std::any_of( areas.begin(), areas.end(), contains_where ) ||
+           std::any_of( vzone_areas.begin(), vzone_areas.end(), contains_where );
 }
 
 bool zone_manager::has_near( const zone_type_id &type, const tripoint_abs_ms &where, int range,
                              const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
-    for( const tripoint_abs_ms &point : point_set ) {
-        if( square_dist( point, where ) <= range ) {
+    for( const zone_area &area : get_areas( type, fac ) ) {
+        if( square_dist( area, where ) <= range ) {
             return true;
         }
     }
 
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &point : vzone_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
-                return true;
-            }
+    for( const zone_area &area : get_vzone_areas( type, fac ) ) {
+        if( points_near( area, where, range, true ) ) {
+            return true;
         }
     }
 
@@ -1139,28 +1155,28 @@ bool zone_manager::custom_loot_has( const tripoint_abs_ms &where, const item *it
 std::unordered_set<tripoint_abs_ms> zone_manager::get_near( const zone_type_id &type,
         const tripoint_abs_ms &where, int range, const item *it, const faction_id &fac ) const
 {
-    const auto &point_set = get_point_set( type, fac );
     std::unordered_set<tripoint_abs_ms> near_point_set;
-
-    for( const tripoint_abs_ms &point : point_set ) {
-        if( square_dist( point, where ) <= range ) {
-            if( ( type != zone_type_LOOT_CUSTOM && type != zone_type_LOOT_ITEM_GROUP ) ||
-                ( it != nullptr && custom_loot_has( point, it, type, fac ) ) ) {
+    const bool custom = type == zone_type_LOOT_CUSTOM || type == zone_type_LOOT_ITEM_GROUP;
+    if( custom && it == nullptr ) {
+        return near_point_set;
+    }
+    const auto add_near = [&]( const zone_area & area, bool same_z ) {
+        const auto points = points_near( area, where, range, same_z );
+        if( !points ) {
+            return;
+        }
+        for( const tripoint_abs_ms &point : *points ) {
+            if( !custom || custom_loot_has( point, it, type, fac ) ) {
                 near_point_set.insert( point );
             }
         }
-    }
+    };
 
-    const auto &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &point : vzone_set ) {
-        if( point.z() == where.z() ) {
-            if( square_dist( point, where ) <= range ) {
-                if( ( type != zone_type_LOOT_CUSTOM && type != zone_type_LOOT_ITEM_GROUP ) ||
-                    ( it != nullptr && custom_loot_has( point, it, type, fac ) ) ) {
-                    near_point_set.insert( point );
-                }
-            }
-        }
+    for( const zone_area &area : get_areas( type, fac ) ) {
+        add_near( area, false );
+    }
+    for( const zone_area &area : get_vzone_areas( type, fac ) ) {
+        add_near( area, true );
     }
 
     return near_point_set;
@@ -1175,26 +1191,19 @@ std::optional<tripoint_abs_ms> zone_manager::get_nearest( const zone_type_id &ty
 
     tripoint_abs_ms nearest_pos( INT_MIN, INT_MIN, INT_MIN );
     int nearest_dist = range + 1;
-    const std::unordered_set<tripoint_abs_ms> &point_set = get_point_set( type, fac );
-    for( const tripoint_abs_ms &p : point_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
-            }
-        }
-    }
-
-    const std::unordered_set<tripoint_abs_ms> &vzone_set = get_vzone_set( type, fac );
-    for( const tripoint_abs_ms &p : vzone_set ) {
-        int cur_dist = square_dist( p, where );
-        if( cur_dist < nearest_dist ) {
-            nearest_dist = cur_dist;
-            nearest_pos = p;
-            if( nearest_dist == 0 ) {
-                return nearest_pos;
+    for( const std::vector<zone_area> *areas : {
+             &get_areas( type, fac ), &get_vzone_areas( type, fac )
+         } ) {
+        for( const zone_area &area : *areas ) {
+            // The closest point of the area.
+            const tripoint_abs_ms p = clamp( where, area );
+            int cur_dist = square_dist( p, where );
+            if( cur_dist < nearest_dist ) {
+                nearest_dist = cur_dist;
+                nearest_pos = p;
+                if( nearest_dist == 0 ) {
+                    return nearest_pos;
+                }
             }
         }
     }
@@ -533,13 +533,16 @@ class zone_manager
         // a count of the number of personal zones the character has
         int num_personal_zones = 0; // NOLINT(cata-serialize)
 
+        using zone_area = inclusive_cuboid<tripoint_abs_ms>;
+        // The areas of the enabled zones per type hash.  Queries test these boxes directly,
+        // so a large zone costs as much as a small one.
         // NOLINTNEXTLINE(cata-serialize)
-        std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> area_cache;
+        std::unordered_map<std::string, std::vector<zone_area>> area_cache;
         // NOLINTNEXTLINE(cata-serialize)
-        std::unordered_map<std::string, std::unordered_set<tripoint_abs_ms>> vzone_cache;
-        std::unordered_set<tripoint_abs_ms> get_point_set( const zone_type_id &type,
+        std::unordered_map<std::string, std::vector<zone_area>> vzone_cache;
+        const std::vector<zone_area> &get_areas( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
-        std::unordered_set<tripoint_abs_ms> get_vzone_set( const zone_type_id &type,
+        const std::vector<zone_area> &get_vzone_areas( const zone_type_id &type,
                 const faction_id &fac = your_fac ) const;
     public:
         zone_manager();
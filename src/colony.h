@@ -65,11 +65,12 @@
 #include <utility> // std::move
 
 #include "cata_assert.h"
+#include "pooled_allocator.h"
 
 namespace cata
 {
 
-template <class element_type, class element_allocator_type = std::allocator<element_type>, typename element_skipfield_type = unsigned short >
+template <class element_type, class element_allocator_type = cata::pooled_allocator<element_type>, typename element_skipfield_type = unsigned short >
 // Empty base class optimization - inheriting allocator functions
 class colony : private element_allocator_type
 // Note: unsigned short is equivalent to uint_least16_t i.e. Using 16-bit unsigned integer in best-case scenario, greater-than-16-bit unsigned integer where platform doesn't support 16-bit types
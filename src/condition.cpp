@@ -6,6 +6,7 @@
 #include <cmath>
 #include <cstddef>
 #include <functional>
+#include <iterator>
 #include <map>
 #include <memory>
 #include <optional>
@@ -2706,6 +2707,106 @@ parsers_simple = {
     {"has_beta", &conditional_fun::f_has_beta },
 };
 
+namespace
+{
+
+// Conditions that only look at the talker or the calendar, and don't read anything that could be math.
+const std::unordered_set<std::string_view> trivial_conditions = {
+    "has_trait", "has_any_trait", "has_visible_trait", "has_flag", "has_species", "bodytype",
+    "has_proficiency", "has_martial_art", "using_martial_art", "is_season", "is_weather",
+    "mod_is_loaded", "is_day", "male", "female", "is_avatar", "is_npc",
+    "is_character", "is_monster", "is_item", "is_furniture", "exists", "is_alive", "is_riding",
+    "has_weapon", "is_deaf", "is_underwater", "is_outside",
+};
+
+// Conditions without side effects or randomness that may have to look at a lot.
+const std::unordered_set<std::string_view> pure_conditions = {
+    "has_item", "has_item_with_flag", "has_item_category", "has_bionics", "is_wearing",
+    "has_worn_with_flag", "has_wielded_with_flag", "has_wielded_with_weapon_category",
+    "has_wielded_with_skill", "has_wielded_with_ammotype", "is_on_terrain",
+    "is_on_terrain_with_flag", "is_in_field", "can_see_location", "at_om_location",
+    "know_recipe", "has_stolen_item", "can_see",
+};
+
+conditional_t::cost cost_of( std::string_view key )
+{
+    for( const std::string_view prefix : { "u_", "npc_" } ) {
+        if( string_starts_with( key, prefix ) ) {
+            key.remove_prefix( prefix.size() );
+            break;
+        }
+    }
+    if( trivial_conditions.count( key ) ) {
+        return conditional_t::cost::trivial;
+    }
+    if( pure_conditions.count( key ) ) {
+        return conditional_t::cost::pure;
+    }
+    return conditional_t::cost::unknown;
+}
+
+} // namespace
+
+void conditional_t::set_leaf( func f, cost c )
+{
+    condition = std::move( f );
+    kind = node_kind::leaf;
+    cost_ = c;
+    children.clear();
+}
+
+void conditional_t::set_children( node_kind k, std::vector<conditional_t> &&terms )
+{
+    condition = nullptr;
+    kind = k;
+    children.clear();
+    if( k == node_kind::negate && terms.front().kind == node_kind::negate ) {
+        conditional_t inner = std::move( terms.front().children.front() );
+        *this = std::move( inner );
+        return;
+    }
+    for( conditional_t &term : terms ) {
+        if( k != node_kind::negate && term.kind == k ) {
+            std::move( term.children.begin(), term.children.end(), std::back_inserter( children ) );
+        } else {
+            children.emplace_back( std::move( term ) );
+        }
+    }
+    cost_ = cost::trivial;
+    for( const conditional_t &term : children ) {
+        cost_ = std::max( cost_, term.cost_ );
+    }
+    // Reorder each run of side effect free terms, the unknown ones are kept in place between them.
+    for( auto first = children.begin(); first != children.end(); ) {
+        auto last = std::find_if( first, children.end(), []( const conditional_t & term ) {
+            return term.cost_ == cost::unknown;
+        } );
+        std::stable_sort( first, last, []( const conditional_t & l, const conditional_t & r ) {
+            return l.cost_ < r.cost_;
+        } );
+        first = last == children.end() ? last : std::next( last );
+    }
+}
+
+bool conditional_t::eval_children( const_dialogue const &d ) const
+{
+    switch( kind ) {
+        case node_kind::all:
+            return std::all_of( children.begin(), children.end(), [&d]( conditional_t const & cond ) {
+                return cond( d );
+            } );
+        case node_kind::any:
+            return std::any_of( children.begin(), children.end(), [&d]( conditional_t const & cond ) {
+                return cond( d );
+            } );
+        case node_kind::negate:
+            return !children.front()( d );
+        case node_kind::leaf:
+            break;
+    }
+    return false;
+}
+
 conditional_t::conditional_t( const JsonObject &jo )
 {
     // improve the clarity of NPC setter functions
@@ -2725,34 +2826,18 @@ conditional_t::conditional_t( const JsonObject &jo )
         return conditionals;
     };
     if( jo.has_array( "and" ) ) {
-        std::vector<conditional_t> and_conditionals = parse_array( jo, "and" );
         found_sub_member = true;
-        condition = [acs = std::move( and_conditionals )]( const_dialogue const & d ) {
-            return std::all_of( acs.begin(), acs.end(), [&d]( conditional_t const & cond ) {
-                return cond( d );
-            } );
-        };
+        set_children( node_kind::all, parse_array( jo, "and" ) );
     } else if( jo.has_array( "or" ) ) {
-        std::vector<conditional_t> or_conditionals = parse_array( jo, "or" );
         found_sub_member = true;
-        condition = [ocs = std::move( or_conditionals )]( const_dialogue const & d ) {
-            return std::any_of( ocs.begin(), ocs.end(), [&d]( conditional_t const & cond ) {
-                return cond( d );
-            } );
-        };
+        set_children( node_kind::any, parse_array( jo, "or" ) );
     } else if( jo.has_object( "not" ) ) {
         JsonObject cond = jo.get_object( "not" );
-        const conditional_t sub_condition = conditional_t( cond );
         found_sub_member = true;
-        condition = [sub_condition]( const_dialogue const & d ) {
-            return !sub_condition( d );
-        };
+        set_children( node_kind::negate, { conditional_t( cond ) } );
     } else if( jo.has_string( "not" ) ) {
-        const conditional_t sub_condition = conditional_t( jo.get_string( "not" ) );
         found_sub_member = true;
-        condition = [sub_condition]( const_dialogue const & d ) {
-            return !sub_condition( d );
-        };
+        set_children( node_kind::negate, { conditional_t( jo.get_string( "not" ) ) } );
     }
     if( !found_sub_member ) {
         for( const std::string &sub_member : dialogue_data::complex_conds() ) {
@@ -2766,14 +2851,14 @@ conditional_t::conditional_t( const JsonObject &jo )
     for( const condition_parser &p : parsers ) {
         if( p.has_beta ) {
             if( p.check( jo ) ) {
-                condition = p.f_beta( jo, p.key_alpha, false );
+                set_leaf( p.f_beta( jo, p.key_alpha, false ), cost_of( p.key_alpha ) );
                 found = true;
             } else if( p.check( jo, true ) ) {
-                condition = p.f_beta( jo, p.key_beta, true );
+                set_leaf( p.f_beta( jo, p.key_beta, true ), cost_of( p.key_beta ) );
                 found = true;
             }
         } else if( p.check( jo ) ) {
-            condition = p.f( jo, p.key_alpha );
+            set_leaf( p.f( jo, p.key_alpha ), cost_of( p.key_alpha ) );
             if( jo.has_member( "math" ) ) {
                 found_sub_member = true;
             }
@@ -2786,10 +2871,7 @@ conditional_t::conditional_t( const JsonObject &jo )
     if( !found ) {
         for( const std::string &sub_member : dialogue_data::simple_string_conds() ) {
             if( jo.has_string( sub_member ) ) {
-                const conditional_t sub_condition( jo.get_string( sub_member ) );
-                condition = [sub_condition]( const_dialogue const & d ) {
-                    return sub_condition( d );
-                };
+                *this = conditional_t( jo.get_string( sub_member ) );
                 found_sub_member = true;
                 break;
             }
@@ -2806,14 +2888,14 @@ conditional_t::conditional_t( std::string_view type )
     for( const condition_parser &p : parsers_simple ) {
         if( p.has_beta ) {
             if( type == p.key_alpha ) {
-                condition = p.f_beta_simple( false );
+                set_leaf( p.f_beta_simple( false ), cost_of( type ) );
                 found = true;
             } else if( type == p.key_beta ) {
-                condition = p.f_beta_simple( true );
+                set_leaf( p.f_beta_simple( true ), cost_of( type ) );
                 found = true;
             }
         } else if( type == p.key_alpha ) {
-            condition = p.f_simple();
+            set_leaf( p.f_simple(), cost_of( type ) );
             found = true;
         }
         if( found ) {
@@ -2821,9 +2903,9 @@ conditional_t::conditional_t( std::string_view type )
         }
     }
     if( !found ) {
-        condition = []( const_dialogue const & ) {
+        set_leaf( []( const_dialogue const & ) {
             return false;
-        };
+        }, cost::trivial );
     }
 }
 
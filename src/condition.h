@@ -7,6 +7,7 @@
 #include <string>
 #include <string_view>
 #include <unordered_set>
+#include <vector>
 
 #include "calendar.h"
 #include "coords_fwd.h"
@@ -102,14 +103,42 @@ struct conditional_t {
         std::function<void( dialogue &, double )>
         static get_set_dbl( std::string_view checked_value, char scope );
         bool operator()( const_dialogue const &d ) const {
+            if( kind != node_kind::leaf ) {
+                return eval_children( d );
+            }
             if( !condition ) {
                 return false;
             }
             return condition( d );
         }
 
+        /**
+         * How a condition may be reordered among the terms of an "and" or "or".  Side effect
+         * free conditions are checked cheapest first, the others stay where they were written.
+         */
+        enum class cost : int {
+            trivial = 0,
+            pure,
+            unknown,
+        };
+
     private:
+        enum class node_kind : int {
+            leaf = 0,
+            all,
+            any,
+            negate,
+        };
+
         func condition;
+        node_kind kind = node_kind::leaf;
+        cost cost_ = cost::unknown;
+        // Terms of all, any and negate, nested terms of the same kind are merged into these.
+        std::vector<conditional_t> children;
+
+        void set_leaf( func f, cost c );
+        void set_children( node_kind k, std::vector<conditional_t> &&terms );
+        bool eval_children( const_dialogue const &d ) const;
 };
 
 #endif // CATA_SRC_CONDITION_H
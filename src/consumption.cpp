@@ -626,6 +626,9 @@ void Character::clear_vitamins()
 
 std::map<vitamin_id, int> Character::effect_vitamin_mod( const std::map<vitamin_id, int> &vits )
 {
+    if( vits.empty() ) {
+        return vits;
+    }
     std::vector<std::pair<vitamin_id, float>> mods;
     // Yuck!
     // Construct mods, for easy iteration over to modify vitamins
@@ -668,6 +668,7 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
         && radius == crafting_cache.radius
         && calendar::turn == crafting_cache.time
         && inv_pos == crafting_cache.position
+        && clear_path == crafting_cache.clear_path
       ) {
         return *crafting_cache.crafting_inventory;
     }
@@ -711,12 +712,21 @@ const inventory &Character::crafting_inventory( const tripoint &src_pos, int rad
     crafting_cache.time = calendar::turn;
     crafting_cache.position = inv_pos;
     crafting_cache.radius = radius;
+    crafting_cache.clear_path = clear_path;
+    static int last_revision = 0;
+    crafting_cache.revision = ++last_revision;
     return *crafting_cache.crafting_inventory;
 }
 
+int Character::crafting_inventory_revision() const
+{
+    return crafting_cache.revision;
+}
+
 void Character::invalidate_crafting_inventory()
 {
     crafting_cache.valid = false;
+    crafting_cache.revision = 0;
     crafting_cache.crafting_inventory->clear();
 }
 
@@ -239,15 +239,19 @@ struct availability {
                 can_craft = ( !r->is_practice() || has_all_skills ) && has_proficiencies &&
                             req.can_make_with_inventory( inv, all_items_filter, batch_size, craft_flags::start_only );
             }
-            would_use_rotten = !req.can_make_with_inventory( inv, no_rotten_filter, batch_size,
-                               craft_flags::start_only );
-            would_use_favorite = !req.can_make_with_inventory( inv, no_favorite_filter, batch_size,
-                                 craft_flags::start_only );
+            // These only matter for recipes that can be crafted, and can't be met by fewer items
+            // when all of them aren't enough.
+            would_use_rotten = !can_craft || !req.can_make_with_inventory( inv, no_rotten_filter,
+                               batch_size, craft_flags::start_only );
+            would_use_favorite = !can_craft || !req.can_make_with_inventory( inv, no_favorite_filter,
+                                 batch_size, craft_flags::start_only );
             useless_practice = r->is_practice() && cannot_gain_skill_or_prof( crafter, *r );
             is_nested_category = r->is_nested();
+            // Only shown for recipes that can't be crafted.
             const requirement_data &simple_req = r->simple_requirements();
-            apparently_craftable = ( !r->is_practice() || has_all_skills ) && has_proficiencies &&
-                                   simple_req.can_make_with_inventory( inv, all_items_filter, batch_size, craft_flags::start_only );
+            apparently_craftable = can_craft || ( ( !r->is_practice() || has_all_skills ) &&
+                                                  has_proficiencies && simple_req.can_make_with_inventory( inv, all_items_filter, batch_size,
+                                                          craft_flags::start_only ) );
             for( const auto& [skill, skill_lvl] : r->required_skills ) {
                 if( crafter.get_skill_level( skill ) < skill_lvl ) {
                     has_all_skills = false;
@@ -1209,6 +1213,37 @@ static bool selection_ok( const std::vector<const recipe *> &list, const int cur
     return false;
 }
 
+namespace
+{
+/**
+ * Recipe availability of one crafter, kept between openings of the crafting menu for as long
+ * as the crafting inventory it was evaluated against is still current.
+ */
+struct crafter_availability {
+    int inventory_revision = 0;
+    std::map<const recipe *, availability> recipes;
+};
+} // namespace
+
+static std::map<const recipe *, availability> &availability_cache_for( Character &crafter,
+        std::map<character_id, crafter_availability> &session_cache, bool camp_crafting )
+{
+    // Camps craft from an inventory override that has no revision to check against.
+    if( camp_crafting ) {
+        return session_cache[crafter.getID()].recipes;
+    }
+    static std::map<character_id, crafter_availability> kept_caches;
+    crafter_availability &kept = kept_caches[crafter.getID()];
+    // Make sure the revision belongs to the inventory as it is now.
+    crafter.crafting_inventory();
+    const int revision = crafter.crafting_inventory_revision();
+    if( kept.inventory_revision != revision ) {
+        kept.inventory_revision = revision;
+        kept.recipes.clear();
+    }
+    return kept.recipes;
+}
+
 std::pair<Character *, const recipe *> select_crafter_and_crafting_recipe( int &batch_size_out,
         const recipe_id &goto_recipe, Character *crafter, std::string filterstring, bool camp_crafting,
         inventory *inventory_override )
@@ -1352,10 +1387,9 @@ std::pair<Character *, const recipe *> select_crafter_and_crafting_recipe( int &
     // already include get_learned_recipes()?
     const recipe_subset &available_recipes = camp_crafting ? crafter->get_learned_recipes() :
             crafter->get_group_available_recipes();
-    std::map<character_id, std::map<const recipe *, availability>> guy_availability_cache;
-    // next line also inserts empty cache for crafter->getID()
+    std::map<character_id, crafter_availability> guy_availability_cache;
     std::map<const recipe *, availability> *availability_cache =
-        &guy_availability_cache[crafter->getID()];
+        &availability_cache_for( *crafter, guy_availability_cache, camp_crafting );
 
     const std::string new_recipe_str = pgettext( "crafting gui", "NEW!" );
     const nc_color new_recipe_str_col = c_light_green;
@@ -1960,8 +1994,8 @@ std::pair<Character *, const recipe *> select_crafter_and_crafting_recipe( int &
             if( new_crafter_i >= 0 && new_crafter_i != crafter_i ) {
                 crafter_i = new_crafter_i;
                 crafter = crafting_group[crafter_i];
-                // next line also inserts empty cache for crafter->getID() if non existant
-                availability_cache = &guy_availability_cache[crafter->getID()];
+                availability_cache = &availability_cache_for( *crafter, guy_availability_cache,
+                                     camp_crafting );
                 recalc = true;
                 keepline = true;
             }
@@ -11,6 +11,7 @@
 #include <stack>
 #include <string>
 #include <tuple>
+#include <unordered_map>
 
 #include "anatomy.h"
 #include "body_part_set.h"
@@ -39,6 +40,7 @@
 #include "flexbuffer_json.h"
 #include "game.h"
 #include "game_constants.h"
+#include "hash_utils.h"
 #include "item.h"
 #include "item_location.h"
 #include "json_error.h"
@@ -178,6 +180,7 @@ const std::set<material_id> Creature::cmat_flameres{
 
 Creature::Creature()
 {
+    renew_sight_stamp();
     moves = 0;
     pain = 0;
     killer = nullptr;
@@ -514,7 +517,7 @@ bool Creature::sees( const Creature &critter ) const
     }
 
     // If we cannot see without any of the penalties below, bail now.
-    if( !sees( critter.pos_bub(), critter.is_avatar() ) ) {
+    if( !sees_position_of( critter ) ) {
         return false;
     }
 
@@ -595,6 +598,87 @@ bool Creature::sees( const Creature &critter ) const
     return visible( ch );
 }
 
+namespace
+{
+
+struct sight_key {
+    const Creature *observer;
+    uint64_t stamp;
+    tripoint_bub_ms from;
+    tripoint_bub_ms to;
+
+    bool operator==( const sight_key &rhs ) const {
+        return observer == rhs.observer && stamp == rhs.stamp && from == rhs.from && to == rhs.to;
+    }
+};
+
+struct sight_key_hash {
+    size_t operator()( const sight_key &key ) const {
+        size_t seed = std::hash<const Creature *>()( key.observer );
+        cata::hash_combine( seed, key.stamp );
+        cata::hash_combine( seed, key.from.raw() );
+        cata::hash_combine( seed, key.to.raw() );
+        return seed;
+    }
+};
+
+// Which positions monsters could see this turn, as far as Creature::sees( const tripoint_bub_ms & )
+// goes.  Target selection, special attacks and the NPC AI check the same pairs over and over.
+struct sight_matrix {
+    std::unordered_map<sight_key, bool, sight_key_hash> seen;
+    time_point turn = calendar::before_time_starts;
+    tripoint_abs_sm origin;
+    int vision_generation = -1;
+    int light_generation = -1;
+};
+
+// Plenty for a bubble full of monsters, just in case something keeps asking about new tiles.
+constexpr size_t max_sight_matrix_size = 1 << 16;
+
+sight_matrix &current_sight_matrix()
+{
+    static sight_matrix matrix;
+    const map &here = get_map();
+    if( matrix.turn != calendar::turn || matrix.origin != here.get_abs_sub() ||
+        matrix.vision_generation != here.get_vision_generation() ||
+        matrix.light_generation != here.get_light_generation() ||
+        matrix.seen.size() >= max_sight_matrix_size ) {
+        matrix.seen.clear();
+        matrix.turn = calendar::turn;
+        matrix.origin = here.get_abs_sub();
+        matrix.vision_generation = here.get_vision_generation();
+        matrix.light_generation = here.get_light_generation();
+    }
+    return matrix;
+}
+
+uint64_t last_sight_stamp = 0;
+
+} // namespace
+
+void Creature::renew_sight_stamp() const
+{
+    sight_stamp = ++last_sight_stamp;
+}
+
+bool Creature::sees_position_of( const Creature &critter ) const
+{
+    // Characters can put on blindfolds and such at any time, and looking at the avatar goes
+    // by the player's own vision, which is cheap to check anyway.
+    if( !is_monster() || critter.is_avatar() ) {
+        return sees( critter.pos_bub(), critter.is_avatar() );
+    }
+    sight_matrix &matrix = current_sight_matrix();
+    const sight_key key{ this, sight_stamp, pos_bub(), critter.pos_bub() };
+    const auto found = matrix.seen.find( key );
+    if( found != matrix.seen.end() ) {
+        return found->second;
+    }
+    const bool result = sees( critter.pos_bub(), false );
+    matrix.seen.emplace( key, result );
+    return result;
+}
+
 bool Creature::sees( const tripoint &t, bool is_avatar, int range_mod ) const
 {
     return Creature::sees( tripoint_bub_ms( t ), is_avatar, range_mod );
@@ -693,7 +777,12 @@ Creature *Creature::auto_find_hostile_target( int range, int &boo_hoo, int area
         self_area_iff = true;
     }
 
+    const tripoint_bub_ms own_pos = pos_bub();
     std::vector<Creature *> targets = g->get_creatures_if( [&]( const Creature & critter ) {
+        // Out of range, don't bother with the visibility checks below
+        if( rl_dist( own_pos, critter.pos_bub() ) > range ) {
+            return false;
+        }
         if( critter.is_monster() ) {
             // friendly to the player, not a target for us
             return static_cast<const monster *>( &critter )->attitude( &player_character ) == MATT_ATTACK;
@@ -1665,6 +1754,7 @@ void Creature::add_effect( const effect_source &source, const efftype_id &eff_id
     if( !force && is_immune_effect( eff_id ) ) {
         return;
     }
+    renew_sight_stamp();
     if( eff_id == effect_knockdown && ( has_effect( effect_ridden ) ||
                                         has_effect( effect_riding ) ) ) {
         monster *mons = dynamic_cast<monster *>( this );
@@ -1837,6 +1927,7 @@ bool Creature::add_env_effect( const efftype_id &eff_id, const bodypart_id &vect
 
 void Creature::clear_effects()
 {
+    renew_sight_stamp();
     for( auto &elem : *effects ) {
         for( auto &_effect_it : elem.second ) {
             const effect &e = _effect_it.second;
@@ -1851,6 +1942,7 @@ bool Creature::remove_effect( const efftype_id &eff_id, const bodypart_id &bp )
         //Effect doesn't exist, so do nothing
         return false;
     }
+    renew_sight_stamp();
     const effect_type &type = eff_id.obj();
 
     if( Character *ch = as_character() ) {
@@ -2029,8 +2121,8 @@ void Creature::process_effects()
                 on_effect_int_change( e.get_id(), e.get_intensity(), e.get_bp() );
             }
 
-            const bool reduced = resists_effect( e );
-            if( e.kill_roll( reduced ) ) {
+            // Most effects can never kill, so don't bother checking for resistances
+            if( e.can_kill() && e.kill_roll( resists_effect( e ) ) ) {
                 add_msg_if_player( m_bad, e.get_death_message() );
                 if( is_avatar() ) {
                     std::map<std::string, cata_variant> event_data;
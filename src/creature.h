@@ -1252,6 +1252,14 @@ class Creature : public viewer
         time_point last_updated;
 
         bool fake = false;
+
+        /** Whether @p critter's position is in sight, remembered for the turn for monsters. */
+        bool sees_position_of( const Creature &critter ) const;
+        // Changes whenever what this creature can see might, so sight checks remembered for an
+        // earlier creature at the same address don't apply to it.
+        mutable uint64_t sight_stamp = 0; // NOLINT(cata-serialize)
+        void renew_sight_stamp() const;
+
         Creature();
         Creature( const Creature & );
         Creature( Creature && ) noexcept( map_is_noexcept );
@@ -1,6 +1,7 @@
 #include "creature_tracker.h"
 
 #include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <ostream>
 #include <string>
@@ -9,9 +10,12 @@
 
 #include "avatar.h"
 #include "cata_assert.h"
+#include "coordinates.h"
 #include "debug.h"
 #include "flood_fill.h"
+#include "game_constants.h"
 #include "game.h"
+#include "line.h"
 #include "map.h"
 #include "mapdata.h"
 #include "maptile_fwd.h"
@@ -22,6 +26,7 @@
 #include "point.h"
 #include "string_formatter.h"
 #include "submap.h"  // IWYU pragma: keep
+#include "thread_pool.h"
 #include "type_id.h"
 
 static const efftype_id effect_ridden( "ridden" );
@@ -34,6 +39,9 @@ creature_tracker::~creature_tracker() = default;
 
 shared_ptr_fast<monster> creature_tracker::find( const tripoint_abs_ms &pos ) const
 {
+#if !CATA_SHARED_PTR_FAST_IS_ATOMIC
+    cata_assert( !thread_pool::on_worker_thread() );
+#endif
     const auto iter = monsters_by_location.find( pos );
     if( iter != monsters_by_location.end() ) {
         const shared_ptr_fast<monster> &mon_ptr = iter->second;
@@ -44,6 +52,15 @@ shared_ptr_fast<monster> creature_tracker::find( const tripoint_abs_ms &pos ) co
     return nullptr;
 }
 
+monster *creature_tracker::find_living( const tripoint_abs_ms &pos ) const
+{
+    const auto iter = monsters_by_location.find( pos );
+    if( iter != monsters_by_location.end() && !iter->second->is_dead() ) {
+        return iter->second.get();
+    }
+    return nullptr;
+}
+
 int creature_tracker::temporary_id( const monster &critter ) const
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -92,7 +109,8 @@ bool creature_tracker::add( const shared_ptr_fast<monster> &critter_ptr )
     }
 
     monsters_list.emplace_back( critter_ptr );
-    monsters_by_location[critter.get_location()] = critter_ptr;
+    set_location( critter.get_location(), critter_ptr );
+    ++faction_revision_;
     return true;
 }
 
@@ -127,8 +145,8 @@ bool creature_tracker::update_pos( const monster &critter, const tripoint_abs_ms
         return ptr.get() == &critter;
     } );
     if( iter != monsters_list.end() ) {
-        monsters_by_location.erase( old_pos );
-        monsters_by_location[new_pos] = *iter;
+        erase_location( old_pos );
+        set_location( new_pos, *iter );
         return true;
     } else {
         // We're changing the x/y/z coordinates of a zombie that hasn't been added
@@ -145,6 +163,7 @@ void creature_tracker::remove_from_location_map( const monster &critter )
 {
     const auto pos_iter = monsters_by_location.find( critter.get_location() );
     if( pos_iter != monsters_by_location.end() && pos_iter->second.get() == &critter ) {
+        remove_from_submap( critter, pos_iter->first );
         monsters_by_location.erase( pos_iter );
         return;
     }
@@ -156,10 +175,117 @@ void creature_tracker::remove_from_location_map( const monster &critter )
         return v.second.get() == &critter;
     } );
     if( iter != monsters_by_location.end() ) {
+        remove_from_submap( critter, iter->first );
+        monsters_by_location.erase( iter );
+    }
+}
+
+void creature_tracker::set_location( const tripoint_abs_ms &pos,
+                                     const shared_ptr_fast<monster> &critter )
+{
+    shared_ptr_fast<monster> &entry = monsters_by_location[pos];
+    if( entry == critter ) {
+        return;
+    }
+    if( entry ) {
+        remove_from_submap( *entry, pos );
+    }
+    entry = critter;
+    ++location_revision_;
+    monsters_by_submap[project_to<coords::sm>( pos )].push_back( critter.get() );
+}
+
+void creature_tracker::erase_location( const tripoint_abs_ms &pos )
+{
+    const auto iter = monsters_by_location.find( pos );
+    if( iter != monsters_by_location.end() ) {
+        remove_from_submap( *iter->second, pos );
         monsters_by_location.erase( iter );
     }
 }
 
+void creature_tracker::remove_from_submap( const monster &critter, const tripoint_abs_ms &pos )
+{
+    ++location_revision_;
+    const auto bucket = monsters_by_submap.find( project_to<coords::sm>( pos ) );
+    if( bucket == monsters_by_submap.end() ) {
+        return;
+    }
+    std::vector<monster *> &critters = bucket->second;
+    // Keep the order stable, so range queries visit monsters in a reproducible order.
+    const auto iter = std::find( critters.begin(), critters.end(), &critter );
+    if( iter != critters.end() ) {
+        critters.erase( iter );
+    }
+    if( critters.empty() ) {
+        monsters_by_submap.erase( bucket );
+    }
+}
+
+std::vector<Creature *> creature_tracker::creatures_in_box( const tripoint_abs_ms &min,
+        const tripoint_abs_ms &max ) const
+{
+    std::vector<Creature *> result;
+    const auto in_box = [&]( const tripoint_abs_ms & p ) {
+        return p.x() >= min.x() && p.x() <= max.x() && p.y() >= min.y() && p.y() <= max.y() &&
+               p.z() >= min.z() && p.z() <= max.z();
+    };
+    const auto add_monster = [&]( monster * critter ) {
+        if( !critter->is_dead() && in_box( critter->get_location() ) ) {
+            result.push_back( critter );
+        }
+    };
+
+    const tripoint_abs_sm sm_min = project_to<coords::sm>( min );
+    const tripoint_abs_sm sm_max = project_to<coords::sm>( max );
+    const int64_t num_submaps = int64_t( sm_max.x() - sm_min.x() + 1 ) *
+                                ( sm_max.y() - sm_min.y() + 1 ) * ( sm_max.z() - sm_min.z() + 1 );
+    if( num_submaps > static_cast<int64_t>( monsters_by_submap.size() ) ) {
+        // Cheaper to check every monster than every submap of the box.
+        for( const shared_ptr_fast<monster> &critter : monsters_list ) {
+            add_monster( critter.get() );
+        }
+    } else {
+        for( int z = sm_min.z(); z <= sm_max.z(); ++z ) {
+            for( int x = sm_min.x(); x <= sm_max.x(); ++x ) {
+                for( int y = sm_min.y(); y <= sm_max.y(); ++y ) {
+                    const auto bucket = monsters_by_submap.find( tripoint_abs_sm( x, y, z ) );
+                    if( bucket == monsters_by_submap.end() ) {
+                        continue;
+                    }
+                    for( monster *critter : bucket->second ) {
+                        add_monster( critter );
+                    }
+                }
+            }
+        }
+    }
+
+    for( const shared_ptr_fast<npc> &guy : active_npc ) {
+        if( !guy->is_dead() && in_box( guy->get_location() ) ) {
+            result.push_back( guy.get() );
+        }
+    }
+    avatar &you = get_avatar();
+    if( in_box( you.get_location() ) ) {
+        result.push_back( &you );
+    }
+    return result;
+}
+
+std::vector<Creature *> creature_tracker::creatures_in_radius( const tripoint_abs_ms &center,
+        int radius ) const
+{
+    // Nothing is tracked outside of the reality bubble, this keeps the box from overflowing.
+    radius = std::min( radius, MAPSIZE_X );
+    const tripoint offset( radius, radius, radius );
+    std::vector<Creature *> result = creatures_in_box( center - offset, center + offset );
+    result.erase( std::remove_if( result.begin(), result.end(), [&]( const Creature * critter ) {
+        return rl_dist( center, critter->get_location() ) > radius;
+    } ), result.end() );
+    return result;
+}
+
 void creature_tracker::remove( const monster &critter )
 {
     const auto iter = std::find_if( monsters_list.begin(), monsters_list.end(),
@@ -174,22 +300,27 @@ void creature_tracker::remove( const monster &critter )
     remove_from_location_map( critter );
     removed_this_turn_.emplace( *iter );
     monsters_list.erase( iter );
+    ++faction_revision_;
 }
 
 void creature_tracker::clear()
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
     removed_this_turn_.clear();
     creatures_by_zone_and_faction_.clear();
     invalidate_reachability_cache();
+    ++faction_revision_;
+    ++location_revision_;
 }
 
 void creature_tracker::rebuild_cache()
 {
     monsters_by_location.clear();
+    monsters_by_submap.clear();
     for( const shared_ptr_fast<monster> &mon_ptr : monsters_list ) {
-        monsters_by_location[mon_ptr->get_location()] = mon_ptr;
+        set_location( mon_ptr->get_location(), mon_ptr );
     }
 }
 
@@ -232,14 +363,14 @@ void creature_tracker::swap_positions( monster &first, monster &second )
     shared_ptr_fast<monster> first_ptr;
     if( first_iter != monsters_by_location.end() ) {
         first_ptr = first_iter->second;
-        monsters_by_location.erase( first_iter );
     }
 
     shared_ptr_fast<monster> second_ptr;
     if( second_iter != monsters_by_location.end() ) {
         second_ptr = second_iter->second;
-        monsters_by_location.erase( second_iter );
     }
+    erase_location( first.get_location() );
+    erase_location( second.get_location() );
     // implied: (first_ptr != second_ptr) or (first_ptr == nullptr && second_ptr == nullptr)
 
     const tripoint_abs_ms temp = second.get_location();
@@ -248,10 +379,10 @@ void creature_tracker::swap_positions( monster &first, monster &second )
 
     // If the pointers have been taken out of the list, put them back in.
     if( first_ptr ) {
-        monsters_by_location[first.get_location()] = first_ptr;
+        set_location( first.get_location(), first_ptr );
     }
     if( second_ptr ) {
-        monsters_by_location[second.get_location()] = second_ptr;
+        set_location( second.get_location(), second_ptr );
     }
 }
 
@@ -259,6 +390,13 @@ bool creature_tracker::kill_marked_for_death()
 {
     // Important: `Creature::die` must not be called after creature objects (NPCs, monsters) have
     // been removed, the dying creature could still have a pointer (the killer) to another creature.
+    const bool any_dead = std::any_of( monsters_list.begin(), monsters_list.end(),
+    []( const shared_ptr_fast<monster> &mon_ptr ) {
+        return mon_ptr->is_dead();
+    } );
+    if( !any_dead ) {
+        return false;
+    }
     bool monster_is_dead = false;
     // Copy the list so we can iterate the copy safely *and* add new monsters from within monster::die
     // This happens for example with blob monsters (they split into two smaller monsters).
@@ -282,14 +420,17 @@ bool creature_tracker::kill_marked_for_death()
 void creature_tracker::remove_dead()
 {
     // Can't use game::all_monsters() as it would not contain *dead* monsters.
-    for( auto iter = monsters_list.begin(); iter != monsters_list.end(); ) {
-        monster *const critter = iter->get();
-        if( critter->is_dead() ) {
-            remove_from_location_map( *critter );
-            iter = monsters_list.erase( iter );
-        } else {
-            ++iter;
+    // A mass kill leaves many dead monsters, so compact the list once instead of erasing each.
+    const auto first_dead = std::stable_partition( monsters_list.begin(), monsters_list.end(),
+    []( const shared_ptr_fast<monster> &mon_ptr ) {
+        return !mon_ptr->is_dead();
+    } );
+    if( first_dead != monsters_list.end() ) {
+        for( auto iter = first_dead; iter != monsters_list.end(); ++iter ) {
+            remove_from_location_map( **iter );
         }
+        monsters_list.erase( first_dead, monsters_list.end() );
+        ++faction_revision_;
     }
     removed_this_turn_.clear();
 }
@@ -309,7 +450,7 @@ T *creature_tracker::creature_at( const tripoint_bub_ms &p, bool allow_hallucina
 template<typename T>
 T *creature_tracker::creature_at( const tripoint_abs_ms &p, bool allow_hallucination )
 {
-    if( const shared_ptr_fast<monster> mon_ptr = find( p ) ) {
+    if( monster *const mon_ptr = find_living( p ) ) {
         if( !allow_hallucination && mon_ptr->is_hallucination() ) {
             return nullptr;
         }
@@ -323,7 +464,7 @@ T *creature_tracker::creature_at( const tripoint_abs_ms &p, bool allow_hallucina
         if( !mon_ptr->has_effect( effect_ridden ) || ( std::is_same<T, monster>::value ||
                 std::is_same<T, Creature>::value || std::is_same<T, const monster>::value ||
                 std::is_same<T, const Creature>::value ) ) {
-            return dynamic_cast<T *>( mon_ptr.get() );
+            return dynamic_cast<T *>( mon_ptr );
         }
     }
     if( !std::is_same<T, npc>::value && !std::is_same<T, const npc>::value ) {
@@ -352,6 +493,7 @@ void creature_tracker::flood_fill_zone( const Creature &origin )
         zone_tick_ = zone_tick_ > 0 ? -1 : 1;
         zone_number_ = 1;
         dirty_ = false;
+        ++faction_revision_;
     }
 
     // This check insures we only flood fill when the target monster has an uninitialized zone,
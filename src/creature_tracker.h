@@ -30,6 +30,7 @@ class creature_tracker
          * Returns the monster at the given location.
          * If there is no monster, it returns a `nullptr`.
          * Dead monsters are ignored and not returned.
+         * Copies the shared pointer, so it must not be used on worker threads, see memory_fast.h.
          */
         shared_ptr_fast<monster> find( const tripoint_abs_ms &pos ) const;
 
@@ -129,6 +130,18 @@ class creature_tracker
             return monsters_list;
         }
 
+        /**
+         * Returns the living monsters and NPCs and the avatar within the given box,
+         * bounds included on all three axes. Monsters are looked up by submap, so the cost
+         * depends on the size of the box and not on the number of monsters in the reality
+         * bubble. Monsters come first, then NPCs, then the avatar.
+         * Hallucinations are included.
+         */
+        std::vector<Creature *> creatures_in_box( const tripoint_abs_ms &min,
+                const tripoint_abs_ms &max ) const;
+        /** Like @ref creatures_in_box, restricted to `rl_dist( center, pos ) <= radius`. */
+        std::vector<Creature *> creatures_in_radius( const tripoint_abs_ms &center, int radius ) const;
+
         void serialize( JsonOut &jsout ) const;
         void deserialize( const JsonArray &ja );
 
@@ -139,9 +152,28 @@ class creature_tracker
             dirty_ = true;
         }
 
+        /**
+         * Changes whenever monsters are added or removed or the reachable zones are recomputed,
+         * but not when monsters only move.  Lets monsters keep the target they chose while the
+         * creatures around them stay the same.
+         */
+        int get_faction_revision() const {
+            return faction_revision_;
+        }
+        /** Changes whenever monsters are added, removed or moved. */
+        int get_location_revision() const {
+            return location_revision_;
+        }
+
     private:
+        /** Like @ref find, but only borrows the monster. */
+        monster *find_living( const tripoint_abs_ms &pos ) const;
         /** Remove the monsters entry in @ref monsters_by_location */
         void remove_from_location_map( const monster &critter );
+        /** These keep @ref monsters_by_submap in sync with @ref monsters_by_location. */
+        void set_location( const tripoint_abs_ms &pos, const shared_ptr_fast<monster> &critter );
+        void erase_location( const tripoint_abs_ms &pos );
+        void remove_from_submap( const monster &critter, const tripoint_abs_ms &pos );
 
         void flood_fill_zone( const Creature &origin );
 
@@ -154,6 +186,9 @@ class creature_tracker
         std::vector<shared_ptr_fast<monster>> monsters_list;
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map<tripoint_abs_ms, shared_ptr_fast<monster>> monsters_by_location;
+        // The entries of monsters_by_location, bucketed by submap for range queries.
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<tripoint_abs_sm, std::vector<monster *>> monsters_by_submap;
 
         /**
          * Creatures that get removed via @ref remove are stored here until the end of the turn.
@@ -167,6 +202,8 @@ class creature_tracker
         bool dirty_ = true;  // NOLINT(cata-serialize)
         int zone_tick_ = 1;  // NOLINT(cata-serialize)
         int zone_number_ = 0;  // NOLINT(cata-serialize)
+        int faction_revision_ = 0;  // NOLINT(cata-serialize)
+        int location_revision_ = 0;  // NOLINT(cata-serialize)
         std::unordered_map<int, std::unordered_map<mfaction_id, std::vector<shared_ptr_fast<Creature>>>>
         creatures_by_zone_and_faction_;  // NOLINT(cata-serialize)
 
@@ -6,22 +6,27 @@
 // IWYU pragma: no_include <sys/unistd.h>
 #include <clocale>
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
+#include <condition_variable>
 #include <cstring>
 #include <ctime>
+#include <fstream>
 #include <iomanip>
 #include <iterator>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <new>
 #include <optional>
 #include <regex>
 #include <set>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -55,6 +60,9 @@
 #   if 1 // HACK: Hack to prevent reordering of #include "platform_win.h" by IWYU
 #       include "platform_win.h"
 #   endif
+#   if !defined(_MSC_VER)
+#       include "mingw.thread.h"
+#   endif
 #endif
 
 #if defined(BACKTRACE)
@@ -110,6 +118,8 @@ static bool error_observed = false;
 static bool capturing = false;
 /** сaptured debug messages */
 static std::string captured;
+/** If set, the debug messages of this thread are collected here, see defer_debugmsgs_during. */
+static thread_local std::vector<deferred_debugmsg> *deferred = nullptr;
 
 #if defined(_WIN32) and defined(LIBBACKTRACE)
 // Get the image base of a module from its PE header
@@ -204,6 +214,24 @@ capture_debugmsg::~capture_debugmsg()
     capturing = false;
 }
 
+std::vector<deferred_debugmsg> defer_debugmsgs_during( const std::function<void()> &func )
+{
+    std::vector<deferred_debugmsg> messages;
+    std::vector<deferred_debugmsg> *const previous = std::exchange( deferred, &messages );
+    on_out_of_scope restore( [previous]() {
+        deferred = previous;
+    } );
+    func();
+    return messages;
+}
+
+void show_deferred_debugmsgs( const std::vector<deferred_debugmsg> &messages )
+{
+    for( const deferred_debugmsg &msg : messages ) {
+        realDebugmsg( msg.filename, msg.line, msg.funcname, msg.text );
+    }
+}
+
 bool debug_has_error_been_observed()
 {
     return error_observed;
@@ -512,6 +540,7 @@ struct repetition_folder {
 
 static repetition_folder rep_folder;
 static void output_repetitions( std::ostream &out );
+static void output_suppressed( std::ostream &out );
 
 void realDebugmsg( const char *filename, const char *line, const char *funcname,
                    const std::string &text )
@@ -520,6 +549,11 @@ void realDebugmsg( const char *filename, const char *line, const char *funcname,
     cata_assert( line != nullptr );
     cata_assert( funcname != nullptr );
 
+    if( deferred != nullptr ) {
+        deferred->push_back( deferred_debugmsg{ filename, line, funcname, text } );
+        return;
+    }
+
     if( capturing ) {
         captured += text;
     } else {
@@ -642,6 +676,122 @@ static time_info get_time() noexcept
 }
 #endif
 
+/**
+ * Stream buffer of the log file.  The text collects in memory and every flush hands it to
+ * a writer thread, so verbose logging doesn't stall the game on file io.  While
+ * @ref set_urgent is on, a flush also waits until the text is in the file, so an error is
+ * on disk before the game goes on (and maybe crashes).
+ */
+class async_log_buf : public std::stringbuf
+{
+    public:
+        explicit async_log_buf( const std::string &filename )
+            : file( fs::u8path( filename ), std::ios::out | std::ios::app ),
+              worker( &async_log_buf::run, this ) {}
+        async_log_buf( const async_log_buf & ) = delete;
+        async_log_buf &operator=( const async_log_buf & ) = delete;
+        /** Writes everything that is still queued. */
+        ~async_log_buf() override {
+            sync();
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            wake.notify_one();
+            worker.join();
+        }
+
+        void set_urgent( bool urgent ) {
+            this->urgent = urgent;
+        }
+
+    protected:
+        int sync() override;
+
+    private:
+        // A writer that can't keep up holds up the game instead of eating all the memory.
+        static constexpr size_t max_pending_bytes = 8 * 1024 * 1024;
+
+        void run();
+
+        std::ofstream file;
+        // Only touched by the logging thread.
+        bool urgent = false;
+        std::string pending;
+        bool stopping = false;
+        uint64_t num_queued = 0;
+        uint64_t num_written = 0;
+        std::mutex mutex;
+        // Signalled when text is queued or the writer is stopping.
+        std::condition_variable wake;
+        // Signalled when the writer has written the queued text.
+        std::condition_variable written;
+        // Last, so everything it uses is constructed before the thread starts.
+        std::thread worker;
+};
+
+int async_log_buf::sync()
+{
+    if( pptr() == pbase() ) {
+        return 0;
+    }
+    std::string text = str();
+    str( std::string() );
+    std::unique_lock<std::mutex> lock( mutex );
+    written.wait( lock, [this]() {
+        return pending.size() < max_pending_bytes;
+    } );
+    pending += text;
+    const uint64_t ticket = ++num_queued;
+    wake.notify_one();
+    if( urgent ) {
+        written.wait( lock, [this, ticket]() {
+            return num_written >= ticket;
+        } );
+    }
+    return 0;
+}
+
+void async_log_buf::run()
+{
+    std::string text;
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        wake.wait( lock, [this]() {
+            return stopping || !pending.empty();
+        } );
+        if( pending.empty() ) {
+            return;
+        }
+        text.swap( pending );
+        const uint64_t ticket = num_queued;
+        lock.unlock();
+        file << text;
+        file.flush();
+        text.clear();
+        lock.lock();
+        num_written = ticket;
+        written.notify_all();
+    }
+}
+
+/** The log file stream, owning its @ref async_log_buf. */
+class async_log_stream : public std::ostream
+{
+    public:
+        explicit async_log_stream( const std::string &filename )
+            : std::ostream( nullptr ), buf( filename ) {
+            rdbuf( &buf );
+        }
+
+        void set_urgent( bool urgent ) {
+            buf.set_urgent( urgent );
+        }
+
+    private:
+        async_log_buf buf;
+};
+
 struct DebugFile {
     DebugFile();
     ~DebugFile();
@@ -652,6 +802,8 @@ struct DebugFile {
     // Using shared_ptr for the type-erased deleter support, not because
     // it needs to be shared.
     std::shared_ptr<std::ostream> file;
+    // Same object as file when it is the log file, for switching it to urgent writes.
+    async_log_stream *async_file = nullptr;
     std::string filename;
 };
 
@@ -680,10 +832,12 @@ void DebugFile::deinit()
 {
     if( file && file.get() != &std::cerr ) {
         output_repetitions( *file );
+        output_suppressed( *file );
         *file << "\n";
         *file << get_time() << " : Log shutdown.\n";
         *file << "-----------------------------------------\n\n";
     }
+    async_file = nullptr;
     file.reset();
 }
 
@@ -703,6 +857,7 @@ void DebugFile::init( DebugOutput output_mode, const std::string &filename )
     switch( output_mode ) {
         case DebugOutput::std_err:
             file = std::shared_ptr<std::ostream>( &std::cerr, null_deleter() );
+            async_file = nullptr;
             break;
         case DebugOutput::file: {
             this->filename = filename;
@@ -715,8 +870,10 @@ void DebugFile::init( DebugOutput output_mode, const std::string &filename )
                     rename_failed = !rename_file( filename, oldfile );
                 }
             }
-            file = std::make_shared<std::ofstream>(
-                       fs::u8path( filename ), std::ios::out | std::ios::app );
+            std::shared_ptr<async_log_stream> log_file =
+                std::make_shared<async_log_stream>( filename );
+            async_file = log_file.get();
+            file = std::move( log_file );
             *file << "\n\n-----------------------------------------\n";
             *file << get_time() << " : Starting log.";
             DebugLog( D_INFO, D_MAIN ) << "Cataclysm DDA version " << getVersionString();
@@ -1448,18 +1605,82 @@ void output_repetitions( std::ostream &out )
     }
 }
 
+/**
+ * Caps the number of messages of one level and class that are logged per second, so a
+ * chatty class can be enabled without flooding the log.  The dropped messages are counted
+ * and the count is logged once that level and class log again after their second is over.
+ */
+struct debug_rate_limiter {
+    using clock = std::chrono::steady_clock;
+    static constexpr int max_per_second = 1000;
+
+    struct window {
+        clock::time_point start;
+        int count = 0;
+        int suppressed = 0;
+    };
+    std::map<std::pair<DebugLevel, DebugClass>, window> windows;
+
+    bool allow( DebugLevel lev, DebugClass cl ) {
+        window &w = windows[ { lev, cl } ];
+        const clock::time_point now = clock::now();
+        if( now - w.start >= std::chrono::seconds( 1 ) ) {
+            w.start = now;
+            w.count = 0;
+        }
+        if( w.count >= max_per_second ) {
+            ++w.suppressed;
+            return false;
+        }
+        ++w.count;
+        return true;
+    }
+
+    void output( std::ostream &out, bool all ) {
+        const clock::time_point now = clock::now();
+        for( auto &[key, w] : windows ) {
+            if( w.suppressed > 0 && ( all || now - w.start >= std::chrono::seconds( 1 ) ) ) {
+                out << std::endl;
+                out << get_time() << " " << key.first << key.second << ": [ " << w.suppressed
+                    << " messages over the limit of " << max_per_second << " per second dropped ]";
+                w.suppressed = 0;
+            }
+        }
+    }
+};
+
+static debug_rate_limiter &rate_limiter()
+{
+    static debug_rate_limiter limiter;
+    return limiter;
+}
+
+void output_suppressed( std::ostream &out )
+{
+    rate_limiter().output( out, true );
+}
+
 std::ostream &DebugLog( DebugLevel lev, DebugClass cl )
 {
     if( lev & D_ERROR ) {
         error_observed = true;
     }
 
+    static NullStream null_stream;
+
     // Error are always logged, they are important,
     // Messages from D_MAIN come from debugmsg and are equally important.
-    if( ( lev & debugLevel && cl & debugClass ) || lev & D_ERROR || cl & D_MAIN ) {
+    const bool important = lev & D_ERROR || cl & D_MAIN;
+    if( important || ( lev & debugLevel && cl & debugClass ) ) {
+        if( !important && !rate_limiter().allow( lev, cl ) ) {
+            return null_stream;
+        }
         std::ostream &out = debugFile().get_file();
 
         output_repetitions( out );
+        if( !important ) {
+            rate_limiter().output( out, false );
+        }
 
         out << std::endl;
         out << get_time() << " ";
@@ -1485,11 +1706,20 @@ std::ostream &DebugLog( DebugLevel lev, DebugClass cl )
         }
 #endif
 
-        out << std::unitbuf; // flush writes immediately
+        async_log_stream *const async_file = debugFile().async_file;
+        if( async_file != nullptr && !important ) {
+            // Handed to the writer by the std::endl that starts the next message.
+            async_file->set_urgent( false );
+            out << std::nounitbuf;
+        } else {
+            if( async_file != nullptr ) {
+                async_file->set_urgent( true );
+            }
+            out << std::unitbuf; // flush writes immediately
+        }
         return out;
     }
 
-    static NullStream null_stream;
     return null_stream;
 }
 
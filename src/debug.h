@@ -4,6 +4,7 @@
 
 #include "string_formatter.h"
 #include <unordered_set>
+#include <vector>
 
 /**
  *      debugmsg(msg, ...)
@@ -26,6 +27,9 @@
  * newline at the end of your debug message.
  * If the specific debug level or class have been disabled, the message is
  * actually discarded, otherwise it is written to a log file.
+ * The log file is written by a background thread. Errors and D_MAIN messages
+ * are in the file before the next message starts; other messages are capped
+ * at a rate per level and class, and the number dropped is logged.
  * If a single source file contains mostly messages for the same debug class
  * (e.g. mapgen.cpp), create and use the macro dbg.
  *
@@ -212,6 +216,23 @@ bool debug_has_error_been_observed();
  */
 std::string capture_debugmsg_during( const std::function<void()> &func );
 
+/** A debugmsg held back by @ref defer_debugmsgs_during. */
+struct deferred_debugmsg {
+    const char *filename = nullptr;
+    const char *line = nullptr;
+    const char *funcname = nullptr;
+    std::string text;
+};
+
+/**
+ * Collects the debug messages of the calling thread during func instead of showing them,
+ * so work done on a worker thread can have its messages shown by the main thread.
+ */
+std::vector<deferred_debugmsg> defer_debugmsgs_during( const std::function<void()> &func );
+
+/** Shows the messages as if debugmsg was called with each of them now. */
+void show_deferred_debugmsgs( const std::vector<deferred_debugmsg> &messages );
+
 /**
  * Should be called after catacurses::stdscr is initialized.
  * If catacurses::stdscr is available, shows all buffered debugmsg prompts.
@@ -26,6 +26,7 @@
 #include "achievement.h"
 #include "action.h"
 #include "activity_tracker.h"
+#include "alloc_profiler.h"
 #include "avatar.h"
 #include "bionics.h"
 #include "bodypart.h"
@@ -66,6 +67,7 @@
 #include "global_vars.h"
 #include "input.h"
 #include "input_context.h"
+#include "input_journal.h"
 #include "inventory.h"
 #include "item.h"
 #include "item_group.h"
@@ -116,6 +118,7 @@
 #include "translation.h"
 #include "translations.h"
 #include "try_parse_integer.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "ui.h"
 #include "uistate.h"
@@ -272,6 +275,10 @@ std::string enum_to_string<debug_menu::debug_menu_index>( debug_menu::debug_menu
 		case debug_menu::debug_menu_index::EDIT_FACTION: return "EDIT_FACTION";
 		case debug_menu::debug_menu_index::WRITE_CITY_LIST: return "WRITE_CITY_LIST";
         case debug_menu::debug_menu_index::TALK_TOPIC: return "TALK_TOPIC";
+        case debug_menu::debug_menu_index::TURN_PROFILER: return "TURN_PROFILER";
+        case debug_menu::debug_menu_index::OVERMAP_SPECIAL_STATS: return "OVERMAP_SPECIAL_STATS";
+        case debug_menu::debug_menu_index::ALLOC_PROFILER: return "ALLOC_PROFILER";
+        case debug_menu::debug_menu_index::INPUT_JOURNAL: return "INPUT_JOURNAL";
         // *INDENT-ON*
         case debug_menu::debug_menu_index::last:
             break;
@@ -413,8 +420,11 @@ void write_min_archive()
 
     if( _add_dir( tgz, save_root, mb_validate ) &&
         _add_dir( tgz, fs::path( PATH_INFO::config_dir_path() ) ) ) {
-        tgz.finalize();
-        popup( string_format( _( "Minimized archive saved to %s" ), ofile ) );
+        if( tgz.finalize() ) {
+            popup( string_format( _( "Minimized archive saved to %s" ), ofile ) );
+        } else {
+            popup( _( "Failed to create minimized archive" ) );
+        }
     }
 }
 
@@ -887,6 +897,10 @@ static int info_uilist( bool display_all_entries = true )
             { uilist_entry( debug_menu_index::DISPLAY_RADIATION, true, 'R', _( "Toggle display radiation" ) ) },
             { uilist_entry( debug_menu_index::SHOW_MUT_CAT, true, 'm', _( "Show mutation category levels" ) ) },
             { uilist_entry( debug_menu_index::BENCHMARK, true, 'b', _( "Draw benchmark (X seconds)" ) ) },
+            { uilist_entry( debug_menu_index::TURN_PROFILER, true, 'P', _( "Turn profiler" ) ) },
+            { uilist_entry( debug_menu_index::OVERMAP_SPECIAL_STATS, true, 'O', _( "Overmap special placement statistics" ) ) },
+            { uilist_entry( debug_menu_index::ALLOC_PROFILER, true, 'K', _( "Heap memory per subsystem" ) ) },
+            { uilist_entry( debug_menu_index::INPUT_JOURNAL, true, 'J', _( "Record or replay input" ) ) },
             { uilist_entry( debug_menu_index::HOUR_TIMER, true, 'E', _( "Toggle hour timer" ) ) },
             { uilist_entry( debug_menu_index::TRAIT_GROUP, true, 't', _( "Test trait group" ) ) },
             { uilist_entry( debug_menu_index::DISPLAY_NPC_PATH, true, 'n', _( "Toggle NPC pathfinding on map" ) ) },
@@ -3789,6 +3803,220 @@ static void write_city_list()
     popup( string_format( _( "city list written to cities.output" ) ) );
 }
 
+static void turn_profiler_menu()
+{
+    uilist menu;
+    menu.text = turn_profiler::is_enabled() ?
+                _( "The turn profiler is recording." ) : _( "The turn profiler is stopped." );
+    menu.addentry( 0, true, 'r', turn_profiler::is_enabled() ? _( "Stop recording" ) :
+                   _( "Start recording" ) );
+    menu.addentry( 1, true, 's', _( "Show summary" ) );
+    menu.addentry( 2, true, 'c', _( "Write turns to turn_profile.csv" ) );
+    menu.addentry( 3, true, 't', _( "Write Chrome trace to turn_profile.json" ) );
+    menu.query();
+
+    switch( menu.ret ) {
+        case 0:
+            if( !turn_profiler::is_enabled() ) {
+                effect_on_conditions::reset_queued_stats();
+            }
+            turn_profiler::set_enabled( !turn_profiler::is_enabled() );
+            break;
+        case 1: {
+            const std::vector<turn_profiler::turn_record> turns = turn_profiler::recorded_turns();
+            std::string text = string_format( _( "%d turns recorded.\n" ), turns.size() );
+            text += string_format( _( "%d melee sounds waiting to be played.\n\n" ),
+                                   sfx::num_pending_melee_sounds() );
+            text += string_format( "%-18s %10s %10s %10s %8s\n", _( "phase" ), _( "total ms" ),
+                                   _( "avg ms" ), _( "max ms" ), _( "calls" ) );
+            const double num_turns = std::max<size_t>( 1, turns.size() );
+            const auto ms = []( std::chrono::nanoseconds ns ) {
+                return std::chrono::duration<double, std::milli>( ns ).count();
+            };
+            for( const turn_profiler::phase_summary &sum : turn_profiler::summarize( turns ) ) {
+                text += string_format( "%-18s %10.2f %10.3f %10.3f %8d\n",
+                                       turn_profiler::phase_name( sum.p ), ms( sum.total ),
+                                       ms( sum.total ) / num_turns, ms( sum.max ), sum.calls );
+            }
+            std::vector<std::pair<effect_on_condition_id, effect_on_conditions::queued_stats>> eocs(
+                        effect_on_conditions::get_queued_stats().begin(),
+                        effect_on_conditions::get_queued_stats().end() );
+            std::sort( eocs.begin(), eocs.end(), []( const auto & l, const auto & r ) {
+                return l.second.time > r.second.time;
+            } );
+            if( !eocs.empty() ) {
+                text += string_format( "\n%-40s %10s %8s\n", _( "queued effect_on_condition" ),
+                                       _( "total ms" ), _( "runs" ) );
+            }
+            constexpr size_t max_listed_eocs = 30;
+            for( size_t i = 0; i < std::min( eocs.size(), max_listed_eocs ); ++i ) {
+                text += string_format( "%-40s %10.2f %8d\n", eocs[i].first.str(), ms( eocs[i].second.time ),
+                                       eocs[i].second.activations );
+            }
+            const auto new_win = []() {
+                return catacurses::newwin( FULL_SCREEN_HEIGHT, FULL_SCREEN_WIDTH,
+                                           point( std::max( 0, ( TERMX - FULL_SCREEN_WIDTH ) / 2 ),
+                                                  std::max( 0, ( TERMY - FULL_SCREEN_HEIGHT ) / 2 ) ) );
+            };
+            scrollable_text( new_win, _( "Turn profile" ), text );
+            break;
+        }
+        case 2:
+            write_to_file( "turn_profile.csv", []( std::ostream & fout ) {
+                turn_profiler::write_csv( fout );
+            }, "turn profile" );
+            popup( _( "Turn profile written to turn_profile.csv" ) );
+            break;
+        case 3:
+            write_to_file( "turn_profile.json", []( std::ostream & fout ) {
+                turn_profiler::write_chrome_trace( fout );
+            }, "turn profile" );
+            popup( _( "Chrome trace written to turn_profile.json" ) );
+            break;
+        default:
+            break;
+    }
+}
+
+static void alloc_profiler_menu()
+{
+    if( !alloc_profiler::is_available() ) {
+        popup( _( "This build doesn't count heap memory, build with ALLOC_PROFILER=1 for that." ) );
+        return;
+    }
+    // The rates are over the time since the summary was last shown.
+    static alloc_profiler::snapshot last_shown = alloc_profiler::take_snapshot();
+    uilist menu;
+    menu.text = _( "Heap memory per subsystem" );
+    menu.addentry( 0, true, 's', _( "Show summary" ) );
+    menu.addentry( 1, true, 'c', _( "Write counters to alloc_profile.csv" ) );
+    menu.query();
+
+    switch( menu.ret ) {
+        case 0: {
+            const alloc_profiler::snapshot now = alloc_profiler::take_snapshot();
+            const std::vector<alloc_profiler::tag_rates> rates =
+                alloc_profiler::rates_between( last_shown, now );
+            const double seconds = std::chrono::duration<double>( now.time - last_shown.time ).count();
+            std::string text = string_format( _( "Rates over the last %.1f seconds.\n\n" ), seconds );
+            text += string_format( "%-14s %10s %10s %12s %10s\n", _( "subsystem" ), _( "live MiB" ),
+                                   _( "blocks" ), _( "allocs/s" ), _( "MiB/s" ) );
+            constexpr double mib = 1024.0 * 1024.0;
+            for( size_t i = 0; i < alloc_profiler::num_tags; ++i ) {
+                const alloc_profiler::tag_stats &s = now.stats[i];
+                text += string_format( "%-14s %10.2f %10d %12.0f %10.2f\n",
+                                       alloc_profiler::tag_name( s.t ), s.live_bytes / mib,
+                                       s.live_blocks, rates[i].allocations_per_second,
+                                       rates[i].bytes_per_second / mib );
+            }
+            last_shown = now;
+            const auto new_win = []() {
+                return catacurses::newwin( FULL_SCREEN_HEIGHT, FULL_SCREEN_WIDTH,
+                                           point( std::max( 0, ( TERMX - FULL_SCREEN_WIDTH ) / 2 ),
+                                                  std::max( 0, ( TERMY - FULL_SCREEN_HEIGHT ) / 2 ) ) );
+            };
+            scrollable_text( new_win, _( "Heap memory per subsystem" ), text );
+            break;
+        }
+        case 1:
+            write_to_file( "alloc_profile.csv", []( std::ostream & fout ) {
+                alloc_profiler::write_csv( fout );
+            }, "allocation profile" );
+            popup( _( "Counters written to alloc_profile.csv" ) );
+            break;
+        default:
+            break;
+    }
+}
+
+static void input_journal_menu()
+{
+    const cata_path journal_path( cata_path::root_path::unknown, "input_journal.json" );
+    uilist menu;
+    if( input_journal::is_recording() ) {
+        menu.text = _( "Input is being recorded." );
+    } else if( input_journal::is_replaying() ) {
+        menu.text = _( "Input is being replayed." );
+    } else {
+        menu.text = _( "Input is not being recorded." );
+    }
+    menu.addentry( 0, !input_journal::is_replaying(), 'r', input_journal::is_recording() ?
+                   _( "Stop recording and write input_journal.json" ) : _( "Start recording" ) );
+    menu.addentry( 1, !input_journal::is_recording() && !input_journal::is_replaying(), 'p',
+                   _( "Replay input_journal.json" ) );
+    menu.addentry( 2, input_journal::is_replaying(), 's', _( "Stop replaying" ) );
+    menu.query();
+
+    switch( menu.ret ) {
+        case 0:
+            if( input_journal::is_recording() ) {
+                input_journal::journal journal = input_journal::stop_recording();
+                // Drop the input that opened this menu, a replay would open it again.
+                const auto opened = std::find_if( journal.entries.rbegin(), journal.entries.rend(),
+                []( const input_journal::entry & e ) {
+                    return e.action == "debug";
+                } );
+                if( opened != journal.entries.rend() ) {
+                    journal.entries.erase( std::prev( opened.base() ), journal.entries.end() );
+                }
+                if( input_journal::write_journal( journal, journal_path ) ) {
+                    popup( _( "%d input events written to input_journal.json" ),
+                           journal.entries.size() );
+                }
+            } else {
+                popup( _( "Replays start from where the recording started, "
+                          "so keep the last save from before now." ) );
+                input_journal::start_recording();
+            }
+            break;
+        case 1:
+            if( std::optional<input_journal::journal> journal =
+                    input_journal::read_journal( journal_path ) ) {
+                // Before the replay starts, or the popup would take its first event.
+                popup( _( "Replaying %d input events, the turn profiler records their turns." ),
+                       journal->entries.size() );
+                input_journal::start_replay( *journal );
+            }
+            break;
+        case 2:
+            input_journal::stop_replay();
+            break;
+        default:
+            break;
+    }
+}
+
+static void overmap_special_stats_menu()
+{
+    std::vector<std::pair<overmap_special_id, overmap_special_placement_stats>> stats(
+                overmap_specials::placement_stats().begin(), overmap_specials::placement_stats().end() );
+    std::sort( stats.begin(), stats.end(), []( const auto & l, const auto & r ) {
+        return l.second.time > r.second.time;
+    } );
+    const auto ms = []( std::chrono::nanoseconds ns ) {
+        return std::chrono::duration<double, std::milli>( ns ).count();
+    };
+    std::chrono::nanoseconds total = std::chrono::nanoseconds::zero();
+    for( const auto &entry : stats ) {
+        total += entry.second.time;
+    }
+    std::string text = string_format( _( "%d overmaps, %.2f ms spent placing specials.\n\n" ),
+                                      overmap_buffer.get_overmap_count(), ms( total ) );
+    text += string_format( "%-40s %8s %8s %8s %8s %10s\n", _( "special" ), _( "tried" ),
+                           _( "city" ), _( "terrain" ), _( "placed" ), _( "total ms" ) );
+    for( const auto &entry : stats ) {
+        const overmap_special_placement_stats &s = entry.second;
+        text += string_format( "%-40s %8d %8d %8d %8d %10.2f\n", entry.first.str(), s.attempts,
+                               s.rejected_city, s.rejected_terrain, s.placed, ms( s.time ) );
+    }
+    const auto new_win = []() {
+        return catacurses::newwin( FULL_SCREEN_HEIGHT, FULL_SCREEN_WIDTH,
+                                   point( std::max( 0, ( TERMX - FULL_SCREEN_WIDTH ) / 2 ),
+                                          std::max( 0, ( TERMY - FULL_SCREEN_HEIGHT ) / 2 ) ) );
+    };
+    scrollable_text( new_win, _( "Overmap special placement" ), text );
+}
+
 static void write_global_vars()
 {
     write_to_file( "var_list.output", [&]( std::ostream & testfile ) {
@@ -3842,6 +4070,10 @@ void debug()
         debug_menu_index::ENABLE_ACHIEVEMENTS,
         debug_menu_index::UNLOCK_ALL,
         debug_menu_index::BENCHMARK,
+        debug_menu_index::TURN_PROFILER,
+        debug_menu_index::OVERMAP_SPECIAL_STATS,
+        debug_menu_index::ALLOC_PROFILER,
+        debug_menu_index::INPUT_JOURNAL,
         debug_menu_index::SHOW_MSG,
         debug_menu_index::QUICKLOAD,
         debug_menu_index::QUIT_NOSAVE,
@@ -4339,6 +4571,22 @@ void debug()
             display_talk_topic();
             break;
 
+        case debug_menu_index::TURN_PROFILER:
+            turn_profiler_menu();
+            break;
+
+        case debug_menu_index::OVERMAP_SPECIAL_STATS:
+            overmap_special_stats_menu();
+            break;
+
+        case debug_menu_index::ALLOC_PROFILER:
+            alloc_profiler_menu();
+            break;
+
+        case debug_menu_index::INPUT_JOURNAL:
+            input_journal_menu();
+            break;
+
         case debug_menu_index::last:
             return;
     }
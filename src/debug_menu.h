@@ -113,6 +113,10 @@ enum class debug_menu_index : int {
     EDIT_FACTION,
     WRITE_CITY_LIST,
     TALK_TOPIC,
+    TURN_PROFILER,
+    OVERMAP_SPECIAL_STATS,
+    ALLOC_PROFILER,
+    INPUT_JOURNAL,
     last
 };
 
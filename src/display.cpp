@@ -532,7 +532,7 @@ std::string display::activity_malus_str( const Character &u )
     const float act_level = u.instantaneous_activity_level();
     const float exertion_mult = u.exertion_adjusted_move_multiplier( act_level ) ;
     const int malus_value = ( 1 / exertion_mult ) * 100 - 100;
-    return string_format( "+%3d%%", malus_value );
+    return string_format( CATA_FORMAT( "+%3d%%" ), malus_value );
 }
 
 std::pair<std::string, nc_color> display::activity_text_color( const Character &u )
@@ -919,7 +919,7 @@ std::pair<std::string, nc_color> display::vehicle_cruise_text_color( const Chara
         int target = static_cast<int>( convert_velocity( veh->cruise_velocity, VU_VEHICLE ) );
         int current = static_cast<int>( convert_velocity( veh->velocity, VU_VEHICLE ) );
         const std::string units = get_option<std::string> ( "USE_METRIC_SPEEDS" );
-        vel_text = string_format( "%d < %d %s", target, current, units );
+        vel_text = string_format( CATA_FORMAT( "%d < %d %s" ), target, current, units );
 
         const float strain = veh->strain();
         if( strain <= 0 ) {
@@ -959,7 +959,7 @@ std::pair<std::string, nc_color> display::vehicle_fuel_percent_text_color( const
         if( max_fuel != 0 ) {
             int percent = cur_fuel * 100 / max_fuel;
             // Simple percent indicator, yellow under 25%, red under 10%
-            fuel_text = string_format( "%d %%", percent );
+            fuel_text = string_format( CATA_FORMAT( "%d %%" ), percent );
             fuel_color = percent < 10 ? c_red : ( percent < 25 ? c_yellow : c_green );
         }
     }
@@ -979,7 +979,8 @@ std::pair<std::string, nc_color> display::move_mode_letter_color( const Characte
 std::pair<std::string, nc_color> display::move_count_and_mode_text_color( const avatar &u )
 {
     std::pair<std::string, nc_color> mode_pair = display::move_mode_letter_color( u );
-    std::string count_and_mode = string_format( "%d(%s)", u.movecounter, mode_pair.first );
+    std::string count_and_mode = string_format( CATA_FORMAT( "%d(%s)" ), u.movecounter,
+                                 mode_pair.first );
     return std::make_pair( count_and_mode, mode_pair.second );
 }
 
@@ -994,7 +995,7 @@ std::pair<std::string, nc_color> display::carry_weight_text_color( const avatar
         carry_wt = 100;
     }
 
-    std::string weight_text = string_format( "%d%%", carry_wt );
+    std::string weight_text = string_format( CATA_FORMAT( "%d%%" ), carry_wt );
 
     nc_color weight_color = c_green;
     if( carry_wt > 100 ) {
@@ -1019,7 +1020,8 @@ std::pair<std::string, nc_color> display::carry_weight_value_color( const avatar
     float max_wt = convert_weight( ava.weight_capacity() );
 
     // Create a string showing "current_weight / max_weight"
-    std::string weight_text = string_format( "%.1f/%.1f %s", carry_wt, max_wt, weight_units() );
+    std::string weight_text = string_format( CATA_FORMAT( "%.1f/%.1f %s" ), carry_wt, max_wt,
+                              weight_units() );
 
     // Set the color based on carry weight
     nc_color weight_color = c_green;  // Default color
@@ -1329,7 +1331,7 @@ std::string display::colorized_compass_legend_text( int width, int max_height, i
                     name = colorize( "@", c_pink );
                     break;
             }
-            name = string_format( "%s %s", name, n->get_name() );
+            name = string_format( CATA_FORMAT( "%s %s" ), name, n->get_name() );
             names.emplace_back( name );
         }
     }
@@ -1350,9 +1352,10 @@ std::string display::colorized_compass_legend_text( int width, int max_height, i
         } else if( m.first->agro > 0 ) {
             danger = c_light_gray;
         }
-        std::string name = m.second > 1 ? string_format( "%d ", m.second ) : "";
+        std::string name = m.second > 1 ? string_format( CATA_FORMAT( "%d " ), m.second ) : "";
         name += m.first->nname( m.second );
-        name = string_format( "%s %s", colorize( m.first->sym, m.first->color ), colorize( name, danger ) );
+        name = string_format( CATA_FORMAT( "%s %s" ), colorize( m.first->sym, m.first->color ),
+                              colorize( name, danger ) );
         names.emplace_back( name );
     }
     return format_widget_multiline( names, max_height, width, height );
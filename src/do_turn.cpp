@@ -6,6 +6,7 @@
 
 #include <algorithm>
 #include <chrono>
+#include <cstdlib>
 #include <map>
 #include <memory>
 #include <optional>
@@ -53,6 +54,7 @@
 #include "options.h"
 #include "output.h"
 #include "overmapbuffer.h"
+#include "pathfinding.h"
 #include "pimpl.h"
 #include "player_activity.h"
 #include "point.h"
@@ -65,6 +67,7 @@
 #include "string_formatter.h"
 #include "timed_event.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 #include "ui.h"
 #include "ui_manager.h"
@@ -73,6 +76,7 @@
 #include "vpart_position.h"
 #include "weather.h"
 #include "weather_type.h"
+#include "widget.h"
 #include "worldfactory.h"
 
 static const activity_id ACT_AUTODRIVE( "ACT_AUTODRIVE" );
@@ -263,12 +267,51 @@ void handle_key_blocking_activity()
 
 namespace
 {
+// How often wandering monsters far from the avatar and any NPC make plans, in turns.
+constexpr int idle_monster_interval = 4;
+
 void monmove()
 {
     g->cleanup_dead();
     map &m = get_map();
     avatar &u = get_avatar();
 
+    // Wandering monsters that nobody is around to see only think every few turns, spending the
+    // moves they saved up in the meantime all at once.
+    const int detail_distance = get_option<int>( "MONSTER_AI_DETAIL_DISTANCE" );
+    std::vector<tripoint_bub_ms> observers;
+    if( detail_distance > 0 ) {
+        observers.push_back( u.pos_bub() );
+        for( const npc &guy : g->all_npcs() ) {
+            observers.push_back( guy.pos_bub() );
+        }
+    }
+    const int turn_number = to_turns<int>( calendar::turn - calendar::turn_zero );
+    const auto thinks_this_turn = [&]( const monster & critter ) {
+        if( detail_distance <= 0 || !critter.is_wandering() || critter.friendly != 0 ) {
+            return true;
+        }
+        const tripoint_bub_ms pos = critter.pos_bub();
+        // Staggered by position, so the idle ones don't all think on the same turn.
+        if( ( turn_number + std::abs( pos.x() + pos.y() ) ) % idle_monster_interval == 0 ) {
+            return true;
+        }
+        return std::any_of( observers.begin(), observers.end(), [&]( const tripoint_bub_ms & p ) {
+            return rl_dist( p, pos ) <= detail_distance;
+        } ) || m.pl_sees( pos, detail_distance );
+    };
+
+    // Most monsters keep their destination from the last turn, so search their routes up front.
+    std::vector<route_request> requests;
+    for( monster &critter : g->all_monsters() ) {
+        route_request req;
+        if( critter.get_moves() > 0 && !critter.is_dead() && !critter.has_effect( effect_controlled ) &&
+            thinks_this_turn( critter ) && critter.expected_route( req ) ) {
+            requests.push_back( req );
+        }
+    }
+    m.prepare_routes( requests );
+
     for( monster &critter : g->all_monsters() ) {
         // Critters in impassable tiles get pushed away, unless it's not impassable for them
         if( !critter.is_dead() && m.impassable( critter.pos_bub() ) &&
@@ -298,6 +341,7 @@ void monmove()
             critter.process_turn();
         }
 
+        const bool thinks = thinks_this_turn( critter );
         m.creature_in_field( critter );
         if( calendar::once_every( 1_days ) ) {
             if( critter.has_flag( mon_flag_MILKABLE ) ) {
@@ -307,7 +351,8 @@ void monmove()
             critter.try_reproduce();
             critter.digest_food();
         }
-        while( critter.get_moves() > 0 && !critter.is_dead() && !critter.has_effect( effect_ridden ) ) {
+        while( critter.get_moves() > 0 && !critter.is_dead() && !critter.has_effect( effect_ridden ) &&
+               thinks ) {
             critter.made_footstep = false;
             // Controlled critters don't make their own plans
             if( !critter.has_effect( effect_controlled ) ) {
@@ -438,6 +483,27 @@ void overmap_npc_move()
     }
 }
 
+// The player sleeps or works on an activity and no other creature is in the reality bubble,
+// nothing on screen changes but the clock.
+bool is_quiet_wait( const avatar &u )
+{
+    return ( u.has_effect( effect_sleep ) || ( u.activity && u.get_moves() <= 0 ) ) &&
+           g->num_creatures() == 1;
+}
+
+// Quiet waits run through the turns faster than the screen is read, so they redraw at most
+// a few times per second of real time, @p last is the time of the previous redraw.
+bool quiet_redraw_due( std::chrono::steady_clock::time_point &last )
+{
+    static constexpr std::chrono::milliseconds interval( 250 );
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    if( now - last < interval ) {
+        return false;
+    }
+    last = now;
+    return true;
+}
+
 } // namespace
 
 // MAIN GAME LOOP
@@ -448,6 +514,10 @@ bool do_turn()
         return turn_handler::cleanup_at_end();
     }
 
+    using turn_profiler::phase;
+    using turn_profiler::scoped_timer;
+    const turn_profiler::turn_scope profiled_turn( to_turns<int64_t>( calendar::turn - calendar::turn_zero ) );
+
     weather_manager &weather = get_weather();
     // Actual stuff
     if( g->new_game ) {
@@ -474,9 +544,12 @@ bool do_turn()
         g->load_npcs();
     }
 
-    timed_event_manager &timed_events = get_timed_events();
-    timed_events.process();
-    mission::process_all();
+    {
+        const scoped_timer timer( phase::timed_events );
+        timed_event_manager &timed_events = get_timed_events();
+        timed_events.process();
+        mission::process_all();
+    }
     avatar &u = get_avatar();
     map &m = get_map();
     // If controlling a vehicle that is owned by someone else
@@ -500,11 +573,13 @@ bool do_turn()
         u.check_mount_is_spooked();
     }
     if( calendar::once_every( 1_days ) ) {
+        const scoped_timer timer( phase::hordes );
         overmap_buffer.process_mongroups();
     }
 
     // Move hordes every 2.5 min
     if( calendar::once_every( time_duration::from_minutes( 2.5 ) ) ) {
+        const scoped_timer timer( phase::hordes );
 
         if( get_option<bool>( "WANDER_SPAWNS" ) ) {
             overmap_buffer.move_hordes();
@@ -519,34 +594,47 @@ bool do_turn()
 
     g->debug_hour_timer.print_time();
 
-    u.update_body();
+    {
+        const scoped_timer timer( phase::update_body );
+        u.update_body();
+    }
 
     // Auto-save if autosave is enabled
     if( get_option<bool>( "AUTOSAVE" ) &&
         calendar::once_every( 1_turns * get_option<int>( "AUTOSAVE_TURNS" ) ) &&
         !u.is_dead_state() ) {
+        const scoped_timer timer( phase::autosave );
         g->autosave();
     }
 
-    weather.update_weather();
-    g->reset_light_level();
+    {
+        const scoped_timer timer( phase::weather );
+        weather.update_weather();
+        g->reset_light_level();
+    }
 
     g->perhaps_add_random_npc( /* ignore_spawn_timers_and_rates = */ false );
-    while( u.get_moves() > 0 && u.activity ) {
-        u.activity.do_turn( u );
+    {
+        const scoped_timer timer( phase::activity );
+        while( u.get_moves() > 0 && u.activity ) {
+            u.activity.do_turn( u );
+        }
     }
 
-    // Process NPC sound events before they move or they hear themselves talking
-    for( npc &guy : g->all_npcs() ) {
-        if( rl_dist( guy.pos(), u.pos() ) < MAX_VIEW_DISTANCE ) {
-            sounds::process_sound_markers( &guy );
+    {
+        const scoped_timer timer( phase::sound_markers );
+        // Process NPC sound events before they move or they hear themselves talking
+        for( npc &guy : g->all_npcs() ) {
+            if( rl_dist( guy.pos(), u.pos() ) < MAX_VIEW_DISTANCE ) {
+                sounds::process_sound_markers( &guy );
+            }
         }
-    }
 
-    music::deactivate_music_id( music::music_id::sound );
+        music::deactivate_music_id( music::music_id::sound );
 
-    // Process sound events into sound markers for display to the player.
-    sounds::process_sound_markers( &u );
+        // Process sound events into sound markers for display to the player.
+        sounds::process_sound_markers( &u );
+    }
 
     if( u.is_deaf() ) {
         sfx::do_hearing_loss();
@@ -576,7 +664,15 @@ bool do_turn()
                     g->queue_screenshot = false;
                 }
 
-                if( g->handle_action() ) {
+                bool action_handled = false;
+                {
+                    // Includes waiting for input, so the turn total is only meaningful
+                    // while the player isn't taking actions (waiting, sleeping, crafting...).
+                    const scoped_timer timer( phase::player_input );
+                    action_handled = g->handle_action();
+                }
+                widget::invalidate_panel_cache();
+                if( action_handled ) {
                     ++g->moves_since_last_save;
                     u.action_taken();
                 }
@@ -636,29 +732,75 @@ bool do_turn()
         scent.set( u.pos(), u.scent, u.get_type_of_scent() );
         overmap_buffer.set_scent( u.global_omt_location(),  u.scent );
     }
-    scent.update( u.pos(), m );
+    {
+        const scoped_timer timer( phase::scent );
+        scent.update( u.pos(), m );
+    }
 
-    // We need floor cache before checking falling 'n stuff
-    m.build_floor_caches();
+    {
+        const scoped_timer timer( phase::floor_caches );
+        // We need floor cache before checking falling 'n stuff
+        m.build_floor_caches();
+    }
 
-    m.process_falling();
-    m.vehmove();
-    m.process_fields();
-    m.process_items();
-    explosion_handler::process_explosions();
+    {
+        const scoped_timer timer( phase::falling );
+        m.process_falling();
+    }
+    {
+        const scoped_timer timer( phase::vehicle_movement );
+        m.vehmove();
+    }
+    {
+        const scoped_timer timer( phase::fields );
+        m.process_fields();
+    }
+    {
+        const scoped_timer timer( phase::items );
+        m.process_items();
+    }
+    {
+        const scoped_timer timer( phase::explosions );
+        explosion_handler::process_explosions();
+    }
     m.creature_in_field( u );
 
-    // Apply sounds from previous turn to monster and NPC AI.
-    sounds::process_sounds();
+    {
+        const scoped_timer timer( phase::sounds );
+        // Apply sounds from previous turn to monster and NPC AI.
+        sounds::process_sounds();
+    }
     const int levz = m.get_abs_sub().z();
-    // Update vision caches for monsters. If this turns out to be expensive,
-    // consider a stripped down cache just for monsters.
-    m.build_map_cache( levz, true );
-    monmove();
+    {
+        const scoped_timer timer( phase::map_cache );
+        // Update vision caches for monsters. If this turns out to be expensive,
+        // consider a stripped down cache just for monsters.
+        m.build_map_cache( levz, true );
+    }
+    {
+        const scoped_timer timer( phase::monmove );
+        monmove();
+    }
     if( calendar::once_every( time_between_npc_OM_moves ) ) {
+        const scoped_timer timer( phase::overmap_npc_move );
         overmap_npc_move();
     }
+    if( !test_mode ) {
+        // A few milliseconds a turn spread the next overmap over the turns it takes to get there.
+        const scoped_timer timer( phase::overmap_generation );
+        overmap_buffer.generate_ahead( u.global_omt_location(), std::chrono::milliseconds( 5 ) );
+    }
+    if( !test_mode ) {
+        // And the map quads the bubble is heading onto.
+        const scoped_timer timer( phase::map_generation );
+        g->generate_submaps_ahead( std::chrono::milliseconds( 5 ) );
+    }
+    if( calendar::once_every( 10_minutes ) ) {
+        const scoped_timer timer( phase::overmap_generation );
+        overmap_buffer.unload_over_limit();
+    }
     if( calendar::once_every( 10_seconds ) ) {
+        const scoped_timer timer( phase::emissions );
         for( const tripoint_bub_ms &elem : m.get_furn_field_locations() ) {
             const furn_t &furn = *m.furn( elem );
             for( const emit_id &e : furn.emissions ) {
@@ -673,10 +815,19 @@ bool do_turn()
         }
     }
     g->mon_info_update();
-    u.process_turn();
-    if( u.get_moves() < 0 && get_option<bool>( "FORCE_REDRAW" ) ) {
-        ui_manager::redraw();
-        refresh_display();
+    {
+        const scoped_timer timer( phase::player_turn );
+        u.process_turn();
+    }
+    const bool quiet_wait = is_quiet_wait( u );
+    static std::chrono::steady_clock::time_point last_forced_redraw;
+    if( u.get_moves() < 0 && get_option<bool>( "FORCE_REDRAW" ) &&
+        ( !quiet_wait || quiet_redraw_due( last_forced_redraw ) ) ) {
+        const scoped_timer timer( phase::redraw );
+        // Long activities spend a turn per call, no need to draw faster than the screen is read.
+        if( ui_manager::request_redraw() ) {
+            refresh_display();
+        }
     }
 
     if( levz >= 0 && !u.is_underwater() ) {
@@ -706,8 +857,11 @@ bool do_turn()
         }
     }
     if( wait_redraw ) {
+        static std::chrono::steady_clock::time_point last_wait_redraw;
         if( g->first_redraw_since_waiting_started ||
-            calendar::once_every( std::min( 1_minutes, wait_refresh_rate ) ) ) {
+            ( calendar::once_every( std::min( 1_minutes, wait_refresh_rate ) ) &&
+              ( !quiet_wait || quiet_redraw_due( last_wait_redraw ) ) ) ) {
+            const scoped_timer timer( phase::redraw );
             if( g->first_redraw_since_waiting_started || calendar::once_every( wait_refresh_rate ) ) {
                 ui_manager::redraw();
             }
@@ -728,29 +882,35 @@ bool do_turn()
 
     m.invalidate_visibility_cache();
 
-    u.update_bodytemp();
-    u.update_body_wetness( *weather.weather_precise );
-    u.apply_wetness_morale( weather.temperature );
-
-    if( calendar::once_every( 1_minutes ) ) {
-        u.update_morale();
-        for( npc &guy : g->all_npcs() ) {
-            guy.update_morale();
-            guy.check_and_recover_morale();
+    {
+        const scoped_timer timer( phase::body_update );
+        u.update_bodytemp();
+        u.update_body_wetness( *weather.weather_precise );
+        u.apply_wetness_morale( weather.temperature );
+
+        if( calendar::once_every( 1_minutes ) ) {
+            u.update_morale();
+            for( npc &guy : g->all_npcs() ) {
+                guy.update_morale();
+                guy.check_and_recover_morale();
+            }
         }
-    }
 
-    if( calendar::once_every( 9_turns ) ) {
-        u.check_and_recover_morale();
+        if( calendar::once_every( 9_turns ) ) {
+            u.check_and_recover_morale();
+        }
     }
 
-    if( !u.is_deaf() ) {
-        sfx::remove_hearing_loss();
+    {
+        const scoped_timer timer( phase::sfx );
+        if( !u.is_deaf() ) {
+            sfx::remove_hearing_loss();
+        }
+        sfx::do_danger_music();
+        sfx::do_vehicle_engine_sfx();
+        sfx::do_vehicle_exterior_engine_sfx();
+        sfx::do_low_stamina_sfx();
     }
-    sfx::do_danger_music();
-    sfx::do_vehicle_engine_sfx();
-    sfx::do_vehicle_exterior_engine_sfx();
-    sfx::do_low_stamina_sfx();
 
     // reset player noise
     u.volume = 0;
@@ -1575,9 +1575,7 @@ void editmap::recalc_target( shapetype shape )
             map &here = get_map();
             for( const tripoint_bub_ms &p : here.points_in_radius( origin, radius ) ) {
                 if( rl_dist( p, origin ) <= radius ) {
-                    if( here.inbounds( p ) ) {
-                        target_list.push_back( p );
-                    }
+                    target_list.push_back( p );
                 }
             }
         }
@@ -391,6 +391,8 @@ class effect
 
         std::vector<effect_dur_mod> get_effect_dur_scaling() const;
 
+        /** Returns true if this effect has any chance to kill, reduced or not. */
+        bool can_kill() const;
         bool kill_roll( bool reduced ) const;
         std::string get_death_message() const;
         event_type death_event() const;
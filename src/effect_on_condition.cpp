@@ -28,6 +28,7 @@
 #include "string_formatter.h"
 #include "talker.h"
 #include "translations.h"
+#include "turn_profiler.h"
 #include "type_id.h"
 
 namespace io
@@ -229,6 +230,29 @@ void effect_on_conditions::queue_effect_on_condition( time_duration duration,
     }
 }
 
+static std::unordered_map<effect_on_condition_id, effect_on_conditions::queued_stats>
+&queued_stats_storage()
+{
+    static std::unordered_map<effect_on_condition_id, effect_on_conditions::queued_stats> stats;
+    return stats;
+}
+
+const std::unordered_map<effect_on_condition_id, effect_on_conditions::queued_stats>
+&effect_on_conditions::get_queued_stats()
+{
+    return queued_stats_storage();
+}
+
+void effect_on_conditions::reset_queued_stats()
+{
+    queued_stats_storage().clear();
+}
+
+static bool has_due_eocs( const queued_eocs &eoc_queue )
+{
+    return !eoc_queue.empty() && eoc_queue.top().time <= calendar::turn;
+}
+
 static void process_eocs( queued_eocs &eoc_queue, std::vector<effect_on_condition_id> &eoc_vector,
                           dialogue &d )
 {
@@ -245,7 +269,15 @@ static void process_eocs( queued_eocs &eoc_queue, std::vector<effect_on_conditio
         for( const auto &val : top.context ) {
             nested_d.set_value( val.first, val.second );
         }
+        const bool profiling = turn_profiler::is_enabled();
+        const turn_profiler::clock_type::time_point start = profiling ?
+                turn_profiler::clock_type::now() : turn_profiler::clock_type::time_point();
         bool activated = top.eoc->activate( nested_d );
+        if( profiling ) {
+            effect_on_conditions::queued_stats &stats = queued_stats_storage()[top.eoc];
+            stats.activations++;
+            stats.time += turn_profiler::clock_type::now() - start;
+        }
         if( top.eoc->type == eoc_type::RECURRING ) {
             if( activated ) { // It worked so add it back
                 it->time = calendar::turn + next_recurrence( top.eoc, d );
@@ -271,6 +303,11 @@ static void process_eocs( queued_eocs &eoc_queue, std::vector<effect_on_conditio
 
 void effect_on_conditions::process_effect_on_conditions( Character &you )
 {
+    // Most characters have nothing due on most turns, don't make a talker for them.
+    if( !has_due_eocs( you.queued_effect_on_conditions ) &&
+        !( you.is_avatar() && has_due_eocs( g->queued_global_effect_on_conditions ) ) ) {
+        return;
+    }
     dialogue d( get_talker_for( you ), nullptr );
     process_eocs( you.queued_effect_on_conditions, you.inactive_effect_on_condition_vector, d );
     //only handle global eocs on the avatars turn
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_EFFECT_ON_CONDITION_H
 #define CATA_SRC_EFFECT_ON_CONDITION_H
 
+#include <chrono>
 #include <functional>
 #include <map>
 #include <memory>
@@ -102,6 +103,13 @@ void queue_effect_on_condition( time_duration duration, effect_on_condition_id e
                                 Character &you, const std::unordered_map<std::string, std::string> &context );
 /** called every turn to process the queued eocs */
 void process_effect_on_conditions( Character &you );
+/** How often and how long a queued eoc ran while the turn profiler was recording */
+struct queued_stats {
+    int activations = 0;
+    std::chrono::nanoseconds time{};
+};
+const std::unordered_map<effect_on_condition_id, queued_stats> &get_queued_stats();
+void reset_queued_stats();
 /** called after certain events to test whether to reactivate eocs */
 void process_reactivate( Character &you );
 void process_reactivate();
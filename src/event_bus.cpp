@@ -28,6 +28,11 @@ void event_subscriber::notify( const cata::event &e, std::unique_ptr<talker>,
     notify( e );
 }
 
+bool event_subscriber::wants( event_type ) const
+{
+    return true;
+}
+
 void event_subscriber::on_subscribe( event_bus *b )
 {
     if( subscribed_to ) {
@@ -55,6 +60,11 @@ event_bus::~event_bus()
 void event_bus::subscribe( event_subscriber *s )
 {
     subscribers.push_back( s );
+    for( size_t i = 0; i < subscribers_by_type.size(); ++i ) {
+        if( s->wants( static_cast<event_type>( i ) ) ) {
+            subscribers_by_type[i].push_back( s );
+        }
+    }
     s->on_subscribe( this );
 }
 
@@ -66,18 +76,30 @@ void event_bus::unsubscribe( event_subscriber *s )
     } else {
         ( *it )->on_unsubscribe( this );
         subscribers.erase( it );
+        for( std::vector<event_subscriber *> &of_type : subscribers_by_type ) {
+            of_type.erase( std::remove( of_type.begin(), of_type.end(), s ), of_type.end() );
+        }
     }
 }
 
-void event_bus::send( const cata::event &e ) const
+const std::vector<event_subscriber *> *event_bus::subscribers_for( const cata::event &e ) const
 {
     // don't accept malformed events (ex: wrong number of arguments)
     // from event::make_dyn()
     if( e.type() == event_type::num_event_types ) {
         debugmsg( "Null event sent to bus.  REJECTED!" );
+        return nullptr;
+    }
+    return &subscribers_by_type[static_cast<size_t>( e.type() )];
+}
+
+void event_bus::send( const cata::event &e ) const
+{
+    const std::vector<event_subscriber *> *to_notify = subscribers_for( e );
+    if( to_notify == nullptr ) {
         return;
     }
-    for( event_subscriber *s : subscribers ) {
+    for( event_subscriber *s : *to_notify ) {
         s->notify( e );
     }
 }
@@ -85,7 +107,11 @@ void event_bus::send( const cata::event &e ) const
 void event_bus::send_with_talker( Creature *alpha, Creature *beta,
                                   const cata::event &e ) const
 {
-    for( event_subscriber *s : subscribers ) {
+    const std::vector<event_subscriber *> *to_notify = subscribers_for( e );
+    if( to_notify == nullptr ) {
+        return;
+    }
+    for( event_subscriber *s : *to_notify ) {
         s->notify( e, get_talker_for( alpha ), get_talker_for( beta ) );
     }
 }
@@ -93,7 +119,11 @@ void event_bus::send_with_talker( Creature *alpha, Creature *beta,
 void event_bus::send_with_talker( Creature *alpha, item_location *beta,
                                   const cata::event &e ) const
 {
-    for( event_subscriber *s : subscribers ) {
+    const std::vector<event_subscriber *> *to_notify = subscribers_for( e );
+    if( to_notify == nullptr ) {
+        return;
+    }
+    for( event_subscriber *s : *to_notify ) {
         s->notify( e, get_talker_for( alpha ), get_talker_for( beta ) );
     }
 }
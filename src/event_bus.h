@@ -2,6 +2,8 @@
 #ifndef CATA_SRC_EVENT_BUS_H
 #define CATA_SRC_EVENT_BUS_H
 
+#include <array>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -29,7 +31,15 @@ class event_bus
             send( cata::event::make<Type>( std::forward<Args>( args )... ) );
         }
     private:
+        /** The subscribers that want events of the type of @p e, nullptr for a malformed event. */
+        const std::vector<event_subscriber *> *subscribers_for( const cata::event &e ) const;
+
+        static constexpr size_t num_event_types =
+            static_cast<size_t>( event_type::num_event_types );
+
         std::vector<event_subscriber *> subscribers;
+        // The subscribers wanting each event type, in the order they subscribed.
+        std::array<std::vector<event_subscriber *>, num_event_types> subscribers_by_type;
 };
 
 event_bus &get_event_bus();
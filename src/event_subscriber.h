@@ -10,6 +10,7 @@ class event;
 }  // namespace cata
 class event_bus;
 class talker;
+enum class event_type : int;
 
 class event_subscriber
 {
@@ -20,6 +21,12 @@ class event_subscriber
         virtual ~event_subscriber();
         virtual void notify( const cata::event & ) = 0;
         virtual void notify( const cata::event &, std::unique_ptr<talker>, std::unique_ptr<talker> );
+        /**
+         * Whether notify needs to see events of this type.  The bus asks once per type on
+         * subscribing and only sends the types that are wanted, so the answer must not change
+         * while subscribed.
+         */
+        virtual bool wants( event_type ) const;
     private:
         friend class event_bus;
         void on_subscribe( event_bus * );
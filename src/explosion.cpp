@@ -6,13 +6,13 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <list>
 #include <map>
 #include <memory>
 #include <optional>
 #include <queue>
 #include <random>
-#include <set>
 #include <string>
 #include <utility>
 #include <vector>
@@ -113,6 +113,8 @@ static float fragment_area = 0.00001f;
 static constexpr float MIN_EFFECTIVE_VELOCITY = 70.0f;
 // Pretty arbitrary minimum density.  1/100 chance of a fragment passing through the given square.
 static constexpr float MIN_FRAGMENT_DENSITY = 0.001f;
+// castLight() doesn't cast farther than this from its origin
+static constexpr int shadowcasting_radius = 60;
 
 explosion_data load_explosion_data( const JsonObject &jo )
 {
@@ -175,6 +177,33 @@ float gurney_spherical( const double charge, const double mass )
 }
 
 // (C1001) Compiler Internal Error on Visual Studio 2015 with Update 2
+namespace
+{
+struct blast_tile {
+    // Distance from the center the blast reached this tile with, infinite until reached
+    float dist = std::numeric_limits<float>::infinity();
+    bool closed = false;
+    bool bashed = false;
+};
+
+// Per tile state of one blast, allocated for each z-level the blast reaches.  Dense like the
+// local caches of shrapnel(), a blast visits hundreds of tiles several times each.
+class blast_grid
+{
+    public:
+        blast_tile &operator[]( const tripoint_bub_ms &p ) {
+            std::unique_ptr<cata::mdarray<blast_tile, point_bub_ms>> &level =
+                        levels[p.z() + OVERMAP_DEPTH];
+            if( !level ) {
+                level = std::make_unique<cata::mdarray<blast_tile, point_bub_ms>>();
+            }
+            return ( *level )[p.xy()];
+        }
+    private:
+        std::array<std::unique_ptr<cata::mdarray<blast_tile, point_bub_ms>>, OVERMAP_LAYERS> levels;
+};
+} // namespace
+
 static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p, const float power,
                       const float distance_factor, const bool fire )
 {
@@ -191,14 +220,17 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
     const size_t max_index = 10;
 
     m->bash( p, fire ? power : ( 2 * power ), true, false, false );
+    if( !m->inbounds( p ) ) {
+        return;
+    }
 
     std::priority_queue< std::pair<float, tripoint_bub_ms>, std::vector< std::pair<float, tripoint_bub_ms> >, pair_greater_cmp_first >
     open;
-    std::set<tripoint_bub_ms> closed;
-    std::set<tripoint_bub_ms> bashed{ p };
-    std::map<tripoint_bub_ms, float> dist_map;
+    blast_grid grid;
+    std::vector<tripoint_bub_ms> closed;
+    grid[p].bashed = true;
+    grid[p].dist = 0.0f;
     open.emplace( 0.0f, p );
-    dist_map[p] = 0.0f;
     // Find all points to blast
     while( !open.empty() ) {
         // Add some random factor to effective distance to make it look cooler
@@ -206,11 +238,13 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
         const tripoint_bub_ms pt = open.top().second;
         open.pop();
 
-        if( closed.count( pt ) != 0 ) {
+        blast_tile &current = grid[pt];
+        if( current.closed ) {
             continue;
         }
 
-        closed.insert( pt );
+        current.closed = true;
+        closed.push_back( pt );
 
         const float force = power * std::pow( distance_factor, distance );
         if( force <= 1.0f ) {
@@ -227,7 +261,8 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
         int empty_neighbors = 0;
         for( size_t i = 0; i < 8; i++ ) {
             tripoint_bub_ms dest( pt + tripoint_rel_ms( x_offset[i], y_offset[i], z_offset[i] ) );
-            if( closed.count( dest ) == 0 && m->valid_move( pt, dest, false, true ) ) {
+            if( m->inbounds( dest ) && !grid[dest].closed &&
+                m->valid_move( pt, dest, false, true ) ) {
                 empty_neighbors++;
             }
         }
@@ -236,12 +271,16 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
         // Iterate over all neighbors. Bash all of them, propagate to some
         for( size_t i = 0; i < max_index; i++ ) {
             tripoint_bub_ms dest( pt + tripoint_rel_ms( x_offset[i], y_offset[i], z_offset[i] ) );
-            if( closed.count( dest ) != 0 || !m->inbounds( dest ) ) {
+            if( !m->inbounds( dest ) ) {
+                continue;
+            }
+            blast_tile &next = grid[dest];
+            if( next.closed ) {
                 continue;
             }
 
-            if( bashed.count( dest ) == 0 ) {
-                bashed.insert( dest );
+            if( !next.bashed ) {
+                next.bashed = true;
                 // Up to 200% bonus for shaped charge
                 // But not if the explosion is fiery, then only half the force and no bonus
                 const float bash_force = !fire ?
@@ -270,12 +309,14 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
                 next_dist += zlev_dist;
             }
 
-            if( dist_map.count( dest ) == 0 || dist_map[dest] > next_dist ) {
+            if( next.dist > next_dist ) {
                 open.emplace( next_dist, dest );
-                dist_map[dest] = next_dist;
+                next.dist = next_dist;
             }
         }
     }
+    // In a fixed order, the effects below draw random numbers per tile.
+    std::sort( closed.begin(), closed.end() );
 
     // Draw the explosion, but only if the explosion center is within the reality bubble
     map &bubble_map = get_map();
@@ -291,7 +332,7 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
                 continue;
             }
 
-            const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+            const float force = power * std::pow( distance_factor, grid[pt].dist );
             nc_color col = c_red;
             if( force < 10 ) {
                 col = c_white;
@@ -309,7 +350,7 @@ static void do_blast( map *m, const Creature *source, const tripoint_bub_ms &p,
     // Must use the reality bubble pos, because that's what the creature tracker works with.
     Creature *mutable_source = source == nullptr ? nullptr : creatures.creature_at( source->pos_bub() );
     for( const tripoint_bub_ms &pt : closed ) {
-        const float force = power * std::pow( distance_factor, dist_map.at( pt ) );
+        const float force = power * std::pow( distance_factor, grid[pt].dist );
         if( force < 1.0f ) {
             // Too weak to matter
             continue;
@@ -426,7 +467,9 @@ static std::vector<tripoint_bub_ms> shrapnel( map *m, const Creature *source,
     // TODO: Calculate range based on max effective range for projectiles.
     // Basically bisect between 0 and map diameter using shrapnel_calc().
     // Need to update shadowcasting to support limiting range without adjusting initial distance.
-    const tripoint_range<tripoint_bub_ms> area = m->points_on_zlevel( src.z() );
+    // Until then the range is that of the shadowcasting, so only the obstacles within it are
+    // cached and only the tiles within it are checked for fragments.
+    const tripoint_range<tripoint_bub_ms> area = m->points_in_radius( src, shadowcasting_radius );
 
     m->build_obstacle_cache( area.min(), area.max() + tripoint_south_east, obstacle_cache );
 
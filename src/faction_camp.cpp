@@ -3624,6 +3624,41 @@ static bool farm_valid_seed( const item &itm )
 
 std::pair<size_t, std::string> basecamp::farm_action( const point &dir, farm_ops op,
         const npc_ptr &comp )
+{
+    const tripoint_abs_omt omt_tgt = expansions.find( dir )->second.pos;
+    std::unique_ptr<small_fake_map> farm_json;
+    if( comp ) {
+        // The companion changes the farm, what was counted before no longer holds.
+        farm_surveys.erase( dir );
+        smallmap farm_map;
+        farm_map.load( omt_tgt, false );
+        return farm_action( farm_map, farm_json, dir, op, comp );
+    }
+
+    farm_survey &survey = farm_surveys[dir];
+    if( survey.taken != calendar::turn ) {
+        survey.taken = calendar::turn;
+        survey.results.clear();
+    }
+    const auto known = survey.results.find( op );
+    if( known != survey.results.end() ) {
+        return known->second;
+    }
+    smallmap farm_map;
+    farm_map.load( omt_tgt, false );
+    // Counting plants needs nothing but the loaded map, plowing runs mapgen and is only
+    // counted when asked for.
+    for( const farm_ops other : { op, farm_ops::plant, farm_ops::harvest } ) {
+        if( survey.results.count( other ) == 0 ) {
+            survey.results[other] = farm_action( farm_map, farm_json, dir, other, nullptr );
+        }
+    }
+    return survey.results[op];
+}
+
+std::pair<size_t, std::string> basecamp::farm_action( smallmap &farm_map,
+        std::unique_ptr<small_fake_map> &farm_json, const point &dir, farm_ops op,
+        const npc_ptr &comp )
 {
     size_t plots_cnt = 0;
     std::string crops;
@@ -3646,10 +3681,7 @@ std::pair<size_t, std::string> basecamp::farm_action( const point &dir, farm_ops
     }
 
     // farm_map is what the area actually looks like
-    smallmap farm_map;
-    farm_map.load( omt_tgt, false );
     // farm_json is what the area should look like according to jsons (loaded on demand)
-    std::unique_ptr<small_fake_map> farm_json;
     tripoint_omt_ms mapmin{ 0, 0, omt_tgt.z() };
     tripoint_omt_ms mapmax{ 2 * SEEX - 1, 2 * SEEY - 1, omt_tgt.z() };
     bool done_planting = false;
@@ -1,5 +1,8 @@
 #include "flag.h"
 
+#include <algorithm>
+
+#include "cata_bitset.h"
 #include "debug.h"
 #include "flexbuffer_json-inl.h"
 #include "flexbuffer_json.h"
@@ -468,3 +471,34 @@ const std::vector<json_flag> &json_flag::get_all()
 {
     return json_flags_all.get_all();
 }
+
+int json_flag::index_of( const flag_id &f )
+{
+    return json_flags_all.convert( f, int_id<json_flag>( -1 ), false ).to_i();
+}
+
+tiny_bitset json_flag::to_bits( const std::set<flag_id> &flags )
+{
+    std::vector<int> indices;
+    indices.reserve( flags.size() );
+    for( const flag_id &f : flags ) {
+        const int index = index_of( f );
+        if( index >= 0 ) {
+            indices.push_back( index );
+        }
+    }
+    tiny_bitset result( 0 );
+    if( !indices.empty() ) {
+        result.resize( *std::max_element( indices.begin(), indices.end() ) + 1 );
+    }
+    for( const int index : indices ) {
+        result.set( index );
+    }
+    return result;
+}
+
+bool json_flag::test_bit( const tiny_bitset &bits, const flag_id &f )
+{
+    const int index = index_of( f );
+    return index >= 0 && static_cast<size_t>( index ) < bits.size() && bits.test( index );
+}
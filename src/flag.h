@@ -12,6 +12,7 @@
 #include "type_id.h"
 
 class JsonObject;
+class tiny_bitset;
 template <typename T> class generic_factory;
 
 extern const flag_id flag_NULL;
@@ -470,6 +471,16 @@ class json_flag
 
         static const std::vector<json_flag> &get_all();
 
+        /**
+         * Dense index of @p f among the loaded flags (its position in @ref get_all), or -1 if
+         * it isn't loaded.  Used to keep sets of flags as bitsets.
+         */
+        static int index_of( const flag_id &f );
+        /** Bitset of @p flags by @ref index_of, only as large as the largest index needs. */
+        static tiny_bitset to_bits( const std::set<flag_id> &flags );
+        /** Whether the bit of @p f is set in a bitset made by @ref to_bits. */
+        static bool test_bit( const tiny_bitset &bits, const flag_id &f );
+
     private:
         translation info_;
         translation restriction_;
@@ -7,9 +7,12 @@
 #include <fstream>
 #include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <sstream>
 #include <stdexcept>
+#include <string>
+#include <string_view>
 #include <system_error>
 #include <type_traits>
 #include <unordered_map>
@@ -23,6 +26,7 @@
 #include "filesystem.h"
 #include "json.h"
 #include "mmap_file.h"
+#include "ofstream_wrapper.h"
 
 namespace
 {
@@ -126,6 +130,31 @@ std::vector<uint8_t> parse_json_to_flexbuffer_(
     return std::move( fbb ).GetBuffer();
 }
 
+// Plain json is parsed straight from a memory map of the file, rather than from a copy of it,
+// so loading a big save file doesn't hold its text twice.
+std::vector<uint8_t> parse_json_file_to_flexbuffer_( const fs::path &json_source_path,
+        size_t offset, const std::string &json_source_path_string ) noexcept( false )
+{
+    std::shared_ptr<mmap_file> json_source = mmap_file::map_file( json_source_path );
+    // The parser needs a terminating null.  A mapping reads as zeros from the end of the file
+    // to the end of its last page, pages being a multiple of 4 KiB, so only a file ending on a
+    // page boundary lacks one.
+    if( json_source && offset < json_source->len && json_source->len % 4096 != 0 &&
+        !is_gzip_data( std::string_view( reinterpret_cast<const char *>( json_source->base ),
+                                         json_source->len ) ) ) {
+        const char *json_text = reinterpret_cast<const char *>( json_source->base ) + offset;
+        return parse_json_to_flexbuffer_( json_text, json_source_path_string.c_str() );
+    }
+    json_source.reset();
+
+    std::optional<std::string> json_file_contents = read_whole_file( json_source_path );
+    if( !json_file_contents.has_value() || json_file_contents->size() <= offset ) {
+        throw std::runtime_error( "Failed to read " + json_source_path_string );
+    }
+    const char *json_text = json_file_contents->c_str() + offset;
+    return parse_json_to_flexbuffer_( json_text, json_source_path_string.c_str() );
+}
+
 } // namespace
 
 struct flexbuffer_vector_storage : flexbuffer_storage {
@@ -286,10 +315,12 @@ class flexbuffer_disk_cache
         }
 
         bool has_cached_flexbuffer_for_json( const fs::path &json_source_path ) {
+            std::lock_guard<std::mutex> lock( mutex_ );
             return cached_flexbuffers_.count( json_source_path.u8string() ) > 0;
         }
 
         fs::file_time_type cached_mtime_for_json( const fs::path &json_source_path ) {
+            std::lock_guard<std::mutex> lock( mutex_ );
             auto it = cached_flexbuffers_.find( json_source_path.u8string() );
             if( it != cached_flexbuffers_.end() ) {
                 return it->second.mtime;
@@ -304,29 +335,34 @@ class flexbuffer_disk_cache
             fs::path root_relative_source_path = lexically_normal_json_source_path.lexically_relative(
                     root_path_ ).lexically_normal();
 
-            // Is there even a potential cached flexbuffer for this file.
-            auto disk_entry = cached_flexbuffers_.find( root_relative_source_path.u8string() );
-            if( disk_entry == cached_flexbuffers_.end() ) {
-                return storage;
-            }
-
+            std::string source_path_string = root_relative_source_path.u8string();
             std::error_code ec;
             fs::file_time_type source_mtime = get_file_mtime_millis( lexically_normal_json_source_path, ec );
             if( ec ) {
                 return storage;
             }
 
-            // Does the source file's mtime match what we cached previously
-            if( source_mtime != disk_entry->second.mtime ) {
-                // Cached flexbuffer on disk is out of date, remove it.
-                remove_file( disk_entry->second.flexbuffer_path.u8string() );
-                cached_flexbuffers_.erase( disk_entry );
-                return storage;
+            fs::path flexbuffer_path;
+            {
+                std::lock_guard<std::mutex> lock( mutex_ );
+                // Is there even a potential cached flexbuffer for this file.
+                auto disk_entry = cached_flexbuffers_.find( source_path_string );
+                if( disk_entry == cached_flexbuffers_.end() ) {
+                    return storage;
+                }
+
+                // Does the source file's mtime match what we cached previously
+                if( source_mtime != disk_entry->second.mtime ) {
+                    // Cached flexbuffer on disk is out of date, remove it.
+                    remove_file( disk_entry->second.flexbuffer_path.u8string() );
+                    cached_flexbuffers_.erase( disk_entry );
+                    return storage;
+                }
+                flexbuffer_path = disk_entry->second.flexbuffer_path;
             }
 
             // Try to mmap the cached flexbuffer
-            std::shared_ptr<mmap_file> mmap_handle = mmap_file::map_file(
-                        disk_entry->second.flexbuffer_path.u8string() );
+            std::shared_ptr<mmap_file> mmap_handle = mmap_file::map_file( flexbuffer_path.u8string() );
             if( !mmap_handle ) {
                 return storage;
             }
@@ -336,13 +372,14 @@ class flexbuffer_disk_cache
             return storage;
         }
 
-        bool save_to_disk( const fs::path &lexically_normal_json_source_path,
-                           const std::vector<uint8_t> &flexbuffer_binary ) {
+        // Returns the path of the cached flexbuffer, or an empty path on failure.
+        fs::path save_to_disk( const fs::path &lexically_normal_json_source_path,
+                               const std::vector<uint8_t> &flexbuffer_binary ) {
             std::error_code ec;
             std::string json_source_path_string = lexically_normal_json_source_path.u8string();
             fs::file_time_type mtime = get_file_mtime_millis( lexically_normal_json_source_path, ec );
             if( ec ) {
-                return false;
+                return {};
             }
 
             int64_t mtime_ms = std::chrono::duration_cast<std::chrono::milliseconds>
@@ -357,20 +394,20 @@ class flexbuffer_disk_cache
             fs::path flexbuffer_filename = lexically_normal_json_source_path.filename();
             flexbuffer_filename += fs::u8path( "." + std::to_string( mtime_ms ) + ".fb" );
             flexbuffer_path /= flexbuffer_filename;
-            std::ofstream fb( flexbuffer_path, std::ofstream::binary );
-            if( !fb.good() ) {
-                return false;
-            }
-
-            fb.write( reinterpret_cast<const char *>( flexbuffer_binary.data() ), flexbuffer_binary.size() );
-            if( !fb.good() ) {
-                return false;
+            // Written aside and renamed over the old file, so other processes mapping it never
+            // see it truncated.
+            try {
+                ofstream_wrapper fb( flexbuffer_path, std::ofstream::binary );
+                fb.stream().write( reinterpret_cast<const char *>( flexbuffer_binary.data() ),
+                                   flexbuffer_binary.size() );
+                fb.close();
+            } catch( const std::exception & ) {
+                return {};
             }
-
-            fb.close();
+            std::lock_guard<std::mutex> lock( mutex_ );
             cached_flexbuffers_[json_source_path_string] = disk_cache_entry{ flexbuffer_path, mtime };
 
-            return true;
+            return flexbuffer_path;
         }
 
     private:
@@ -386,6 +423,8 @@ class flexbuffer_disk_cache
         };
         // Maps game root relative json source path to the most recent cached flexbuffer we have on disk for it.
         std::unordered_map<std::string, disk_cache_entry> cached_flexbuffers_;
+        // Files are parsed on several threads while the data is loaded, guards cached_flexbuffers_.
+        std::mutex mutex_;
 };
 
 flexbuffer_cache::flexbuffer_cache( const fs::path &cache_directory,
@@ -402,14 +441,8 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse( fs::path json_source
         size_t offset )
 {
     std::string json_source_path_string = json_source_path.generic_u8string();
-    std::shared_ptr<mmap_file> json_source = mmap_file::map_file( json_source_path );
-    if( !json_source ) {
-        throw std::runtime_error( "Failed to mmap " + json_source_path_string );
-    }
-
-    const char *json_text = reinterpret_cast<const char *>( json_source->base ) + offset;
-
-    std::vector<uint8_t> fb = parse_json_to_flexbuffer_( json_text, json_source_path_string.c_str() );
+    std::vector<uint8_t> fb = parse_json_file_to_flexbuffer_( json_source_path, offset,
+                              json_source_path_string );
 
     auto storage = std::make_shared<flexbuffer_vector_storage>( std::move( fb ) );
 
@@ -444,21 +477,22 @@ std::shared_ptr<parsed_flexbuffer> flexbuffer_cache::parse_and_cache(
     }
 
     std::string json_source_path_string = lexically_normal_json_source_path.generic_u8string();
-    std::optional<std::string> json_file_contents = read_whole_file(
-                lexically_normal_json_source_path );
-    if( !json_file_contents.has_value() || json_file_contents->empty() ) {
-        throw std::runtime_error( "Failed to read " + json_source_path_string );
-    }
-    std::string &json_source = *json_file_contents;
-
-    const char *json_text = reinterpret_cast<const char *>( json_source.c_str() ) + offset;
-    std::vector<uint8_t> fb = parse_json_to_flexbuffer_( json_text, json_source_path_string.c_str() );
+    std::vector<uint8_t> fb = parse_json_file_to_flexbuffer_( lexically_normal_json_source_path,
+                              offset, json_source_path_string );
 
+    std::shared_ptr<flexbuffer_storage> storage;
     if( disk_cache_ ) {
-        disk_cache_->save_to_disk( lexically_normal_json_source_path, fb );
+        // Read it back from the page cache like a cached file, rather than keeping a private copy.
+        const fs::path cached_path = disk_cache_->save_to_disk( lexically_normal_json_source_path, fb );
+        std::shared_ptr<mmap_file> mmap_handle = cached_path.empty() ? nullptr :
+                mmap_file::map_file( cached_path );
+        if( mmap_handle && mmap_handle->len == fb.size() ) {
+            storage = std::make_shared<flexbuffer_mmap_storage>( std::move( mmap_handle ) );
+        }
+    }
+    if( !storage ) {
+        storage = std::make_shared<flexbuffer_vector_storage>( std::move( fb ) );
     }
-
-    auto storage = std::make_shared<flexbuffer_vector_storage>( std::move( fb ) );
 
     std::error_code ec;
     fs::file_time_type mtime = fs::last_write_time( lexically_normal_json_source_path, ec );
@@ -21,6 +21,7 @@
 #include <map>
 #include <memory>
 #include <numeric>
+#include <optional>
 #include <queue>
 #include <set>
 #include <sstream>
@@ -41,6 +42,7 @@
 #include "activity_actor_definitions.h"
 #include "activity_handlers.h"
 #include "activity_type.h"
+#include "alloc_profiler.h"
 #include "ascii_art.h"
 #include "auto_note.h"
 #include "auto_pickup.h"
@@ -211,6 +213,7 @@
 #include "weakpoint.h"
 #include "weather.h"
 #include "weather_type.h"
+#include "widget.h"
 #include "worldfactory.h"
 
 #if defined(TILES)
@@ -391,6 +394,14 @@ static const zone_type_id zone_type_NO_AUTO_PICKUP( "NO_AUTO_PICKUP" );
 
 static constexpr int DANGEROUS_PROXIMITY = 5;
 
+// Read every turn or every redraw.
+static const option_ref<int> option_safemode_proximity( "SAFEMODEPROXIMITY" );
+static const option_ref<int> option_safemode_ignore_turns( "SAFEMODEIGNORETURNS" );
+static const option_ref<bool> option_autosafemode( "AUTOSAFEMODE" );
+static const option_ref<int> option_autosafemode_turns( "AUTOSAFEMODETURNS" );
+static const option_ref<std::string> option_sidebar_position( "SIDEBAR_POSITION" );
+static const option_ref<bool> option_sidebar_spacers( "SIDEBAR_SPACERS" );
+
 #if defined(__ANDROID__)
 extern bool add_key_to_quick_shortcuts( int key, const std::string &category, bool back ); // NOLINT
 #endif
@@ -463,6 +474,7 @@ game::game() :
     next_npc_id( 1 ),
     next_mission_id( 1 ),
     remoteveh_cache_time( calendar::before_time_starts ),
+    visible_items_cache_time( calendar::before_time_starts ),
     tileset_zoom( DEFAULT_TILESET_ZOOM ),
     last_mouse_edge_scroll( std::chrono::steady_clock::now() )
 {
@@ -847,6 +859,9 @@ void game::setup()
     u.character_mood_face( true );
     remoteveh_cache_time = calendar::before_time_starts;
     remoteveh_cache = nullptr;
+    visible_items_cache_time = calendar::before_time_starts;
+    visible_items_cache.clear();
+    widget::invalidate_panel_cache();
     global_variables &globvars = get_globals();
     globvars.clear_global_values();
     unique_npcs.clear();
@@ -1149,6 +1164,7 @@ bool game::start_game()
             u.getID(), u.name, u.male, u.prof->ident(), u.custom_profession );
     time_played_at_last_load = std::chrono::seconds( 0 );
     time_of_last_load = std::chrono::steady_clock::now();
+    saved_file_digests.clear();
     tripoint_abs_omt abs_omt = u.global_omt_location();
     const oter_id &cur_ter = overmap_buffer.ter( abs_omt );
     get_event_bus().send<event_type::avatar_enters_omt>( abs_omt.raw(), cur_ter );
@@ -1642,9 +1658,9 @@ static int maptile_field_intensity( maptile &mt, field_type_id fld )
     return field_ptr == nullptr ? 0 : field_ptr->get_field_intensity();
 }
 
-units::temperature_delta get_heat_radiation( const tripoint &location )
+heat_sources get_heat_sources( const tripoint &location )
 {
-    units::temperature_delta temp_mod = units::from_kelvin_delta( 0 );
+    heat_sources sources;
     Character &player_character = get_player_character();
     map &here = get_map();
     // Convert it to an int id once, instead of 139 times per turn
@@ -1671,48 +1687,27 @@ units::temperature_delta get_heat_radiation( const tripoint &location )
         } else if( !here.sees( location, dest.raw(), -1 ) ) {
             continue;
         }
+        const int dist = square_dist( dest.raw(), location );
         // Ensure fire_dist >= 1 to avoid divide-by-zero errors.
-        const int fire_dist = std::max( 1, square_dist( dest.raw(), location ) );
-        temp_mod += units::from_fahrenheit_delta( 6.f * heat_intensity * heat_intensity / fire_dist );
+        const int fire_dist = std::max( 1, dist );
+        sources.radiation += units::from_fahrenheit_delta( 6.f * heat_intensity * heat_intensity /
+                             fire_dist );
+        if( dist <= 1 ) {
+            // Extend limbs/lean over a single adjacent fire to warm up
+            sources.best_fire = std::max( sources.best_fire, heat_intensity );
+        }
     }
-    return temp_mod;
+    return sources;
 }
 
-int get_best_fire( const tripoint &location )
+units::temperature_delta get_heat_radiation( const tripoint &location )
 {
-    int best_fire = 0;
-    Character &player_character = get_player_character();
-    map &here = get_map();
-    // Convert it to an int id once, instead of 139 times per turn
-    const field_type_id fd_fire_int = fd_fire.id();
-    for( const tripoint_bub_ms &dest : here.points_in_radius( tripoint_bub_ms( location ), 6 ) ) {
-        int heat_intensity = 0;
-
-        maptile mt = here.maptile_at( dest );
+    return get_heat_sources( location ).radiation;
+}
 
-        int ffire = maptile_field_intensity( mt, fd_fire_int );
-        if( ffire > 0 ) {
-            heat_intensity = ffire;
-        } else  {
-            heat_intensity = mt.get_ter()->heat_radiation;
-        }
-        if( heat_intensity == 0 ) {
-            // No heat source here
-            continue;
-        }
-        if( player_character.pos_bub().raw() == location ) {
-            if( !here.clear_path( dest.raw(), location, -1, 1, 100 ) ) {
-                continue;
-            }
-        } else if( !here.sees( location, dest.raw(), -1 ) ) {
-            continue;
-        }
-        if( square_dist( dest.raw(), location ) <= 1 ) {
-            // Extend limbs/lean over a single adjacent fire to warm up
-            best_fire = std::max( best_fire, heat_intensity );
-        }
-    }
-    return best_fire;
+int get_best_fire( const tripoint &location )
+{
+    return get_heat_sources( location ).best_fire;
 }
 
 units::temperature_delta get_convection_temperature( const tripoint &location )
@@ -3211,6 +3206,7 @@ bool game::load( const save_t &name )
                     events().send<event_type::game_load>( getVersionString() );
                     time_of_last_load = std::chrono::steady_clock::now();
                     time_played_at_last_load = std::chrono::seconds( 0 );
+                    saved_file_digests.clear();
                     std::optional<event_multiset::summaries_type::value_type> last_save =
                         stats().get_events( event_type::game_save ).last();
                     if( last_save ) {
@@ -3359,11 +3355,39 @@ void game::reset_npc_dispositions()
 bool game::save_factions_missions_npcs()
 {
     std::string masterfile = PATH_INFO::world_base_save_path() + "/" + SAVE_MASTER;
-    return write_to_file( masterfile, [&]( std::ostream & fout ) {
+    return write_to_file_if_changed( masterfile, [&]( std::ostream & fout ) {
         serialize_master( fout );
     }, _( "factions data" ) );
 }
 
+bool game::write_to_file_if_changed( const std::string &path,
+                                     const std::function<void( std::ostream & )> &writer,
+                                     const char *const fail_message )
+{
+    std::ostringstream buffer;
+    try {
+        writer( buffer );
+    } catch( const std::exception &err ) {
+        popup( _( "Failed to write %1$s to \"%2$s\": %3$s" ), fail_message, path, err.what() );
+        return false;
+    }
+    const std::string contents = buffer.str();
+    const std::pair<size_t, size_t> digest( contents.size(), std::hash<std::string>()( contents ) );
+    const auto it = saved_file_digests.find( path );
+    if( it != saved_file_digests.end() && it->second == digest && file_exist( path ) ) {
+        return true;
+    }
+    const bool written = write_to_file( path, [&]( std::ostream & fout ) {
+        fout << contents;
+    }, fail_message );
+    if( written ) {
+        saved_file_digests[path] = digest;
+    } else {
+        saved_file_digests.erase( path );
+    }
+    return written;
+}
+
 bool game::save_maps()
 {
     try {
@@ -3385,7 +3409,7 @@ bool game::save_player_data()
         serialize( fout );
     }, _( "player data" ) );
     const bool saved_map_memory = u.save_map_memory();
-    const bool saved_log = write_to_file( playerfile + SAVE_EXTENSION_LOG, [&](
+    const bool saved_log = write_to_file_if_changed( playerfile + SAVE_EXTENSION_LOG, [&](
     std::ostream & fout ) {
         memorial().save( fout );
     }, _( "player memorial" ) );
@@ -3453,7 +3477,7 @@ bool game::save_achievements()
     const std::string json_path_string = achievement_file_path.str() + std::to_string(
             character_id ) + ".json";
 
-    return write_to_file( json_path_string, [&]( std::ostream & fout ) {
+    return write_to_file_if_changed( json_path_string, [&]( std::ostream & fout ) {
         get_achievements().write_json_achievements( fout, u.name );
     }, _( "player achievements" ) );
 
@@ -3525,7 +3549,8 @@ bool game::save()
             !get_auto_notes_settings().save( true ) ||
             !get_safemode().save_character() ||
             !zone_manager::get_manager().save_zones() ||
-        !write_to_file( PATH_INFO::world_base_save_path() + "/uistate.json", [&]( std::ostream & fout ) {
+        !write_to_file_if_changed( PATH_INFO::world_base_save_path() + "/uistate.json", [&](
+        std::ostream & fout ) {
         JsonOut jsout( fout );
             uistate.serialize( jsout );
         }, _( "uistate data" ) ) ) {
@@ -4055,8 +4080,8 @@ void game::draw_panels( bool force_draw )
     const bool draw_this_turn = current_turn > previous_turn || force_draw;
     panel_manager &mgr = panel_manager::get_manager();
     int y = 0;
-    const bool sidebar_right = get_option<std::string>( "SIDEBAR_POSITION" ) == "right";
-    int spacer = get_option<bool>( "SIDEBAR_SPACERS" ) ? 1 : 0;
+    const bool sidebar_right = option_sidebar_position.get() == "right";
+    int spacer = option_sidebar_spacers.get() ? 1 : 0;
     // Total up height used by all panels, and see what is left over for log
     int log_height = 0;
     for( const window_panel &panel : mgr.get_current_layout().panels() ) {
@@ -4311,8 +4336,8 @@ character_id game::assign_npc_id()
 
 Creature *game::is_hostile_nearby()
 {
-    int distance = ( get_option<int>( "SAFEMODEPROXIMITY" ) <= 0 ) ? MAX_VIEW_DISTANCE :
-                   get_option<int>( "SAFEMODEPROXIMITY" );
+    int distance = ( option_safemode_proximity.get() <= 0 ) ? MAX_VIEW_DISTANCE :
+                   option_safemode_proximity.get();
     return is_hostile_within( distance );
 }
 
@@ -4431,41 +4456,72 @@ std::vector<monster *> game::get_fishable_monsters( std::unordered_set<tripoint>
     return unique_fish;
 }
 
-void game::mon_info_update( )
+namespace
 {
-    int newseen = 0;
-    const int safe_proxy_dist = get_option<int>( "SAFEMODEPROXIMITY" );
-    const int iProxyDist = ( safe_proxy_dist <= 0 ) ? MAX_VIEW_DISTANCE :
-                           safe_proxy_dist;
-
-    monster_visible_info &mon_visible = u.get_mon_visible();
-    auto &new_seen_mon = mon_visible.new_seen_mon;
-    auto &unique_types = mon_visible.unique_types;
-    auto &unique_mons = mon_visible.unique_mons;
-    auto &dangerous = mon_visible.dangerous;
-    mon_visible.has_dangerous_creature_in_proximity = false;
 
-    // 7 0 1    unique_types uses these indices;
-    // 6 8 2    0-7 are provide by direction_from()
-    // 5 4 3    8 is used for local monsters (for when we explain them below)
-    for( auto &t : unique_types ) {
-        t.clear();
-    }
-    for( auto &m : unique_mons ) {
-        m.clear();
-    }
-    std::fill( dangerous.begin(), dangerous.end(), false );
+// What mon_info_update works out about a creature the avatar sees.
+struct seen_creature {
+    weak_ptr_fast<monster> mon;
+    weak_ptr_fast<npc> guy;
+    int index = 8;
+    int dist = 0;
+    // Monsters only, NPCs can change their mind without taking a step.
+    std::string name;
+    Creature::Attitude attitude = Creature::Attitude::NEUTRAL;
+    monster_attitude matt = MATT_NULL;
+    // Whether the monster sees the avatar, asked the first time it matters.
+    std::optional<bool> sees_you;
+};
 
-    const tripoint view = u.pos() + u.view_offset.raw();
-    new_seen_mon.clear();
+// The creatures the avatar saw last time and what decided it.  The avatar can look around,
+// open menus and so on many times between two of its moves, and each of those asks again.
+struct seen_creatures {
+    std::vector<seen_creature> creatures;
+    time_point turn = calendar::before_time_starts;
+    int moves = 0;
+    tripoint_abs_ms pos;
+    tripoint_rel_ms view_offset;
+    tripoint_abs_sm origin;
+    int vision_generation = -1;
+    int location_revision = -1;
+    // NPCs move without the creature tracker knowing.
+    std::vector<std::pair<const npc *, tripoint_abs_ms>> npcs;
+};
 
-    static time_point previous_turn = calendar::turn_zero;
-    const time_duration sm_ignored_turns =
-        time_duration::from_turns( get_option<int>( "SAFEMODEIGNORETURNS" ) );
+// The creatures @p u sees, looked for again when anything of the above changed.
+std::vector<seen_creature> &current_seen_creatures( avatar &u )
+{
+    static seen_creatures seen;
+    const map &here = get_map();
+    std::vector<std::pair<const npc *, tripoint_abs_ms>> npcs;
+    for( const npc &guy : g->all_npcs() ) {
+        npcs.emplace_back( &guy, guy.get_location() );
+    }
+    if( seen.turn == calendar::turn && seen.moves == u.get_moves() &&
+        seen.pos == u.get_location() && seen.view_offset == u.view_offset &&
+        seen.origin == here.get_abs_sub() &&
+        seen.vision_generation == here.get_vision_generation() &&
+        seen.location_revision == get_creature_tracker().get_location_revision() &&
+        seen.npcs == npcs ) {
+        return seen.creatures;
+    }
+    seen.turn = calendar::turn;
+    seen.moves = u.get_moves();
+    seen.pos = u.get_location();
+    seen.view_offset = u.view_offset;
+    seen.origin = here.get_abs_sub();
+    seen.vision_generation = here.get_vision_generation();
+    seen.location_revision = get_creature_tracker().get_location_revision();
+    seen.npcs = std::move( npcs );
+    seen.creatures.clear();
 
+    const tripoint view = u.pos() + u.view_offset.raw();
     for( Creature *c : u.get_visible_creatures( MAPSIZE_X ) ) {
         monster *m = dynamic_cast<monster *>( c );
         npc *p = dynamic_cast<npc *>( c );
+        if( m == nullptr && p == nullptr ) {
+            continue;
+        }
         const direction dir_to_mon = direction_from( view.xy(), point( c->posx(), c->posy() ) );
         const point m2( -view.xy() + point( POSX + c->posx(), POSY + c->posy() ) );
         int index = 8;
@@ -4523,27 +4579,85 @@ void game::mon_info_update( )
             }
         }
 
+        seen_creature critter;
+        critter.index = index;
+        critter.dist = rl_dist( u.pos(), c->pos() );
+        if( m != nullptr ) {
+            critter.mon = g->shared_from( *m );
+            critter.name = m->name();
+            critter.attitude = m->attitude_to( u );
+            critter.matt = m->attitude( &u );
+        } else {
+            critter.guy = g->shared_from( *p );
+        }
+        seen.creatures.push_back( std::move( critter ) );
+    }
+    return seen.creatures;
+}
+
+} // namespace
+
+void game::mon_info_update( )
+{
+    int newseen = 0;
+    const int safe_proxy_dist = option_safemode_proximity.get();
+    const int iProxyDist = ( safe_proxy_dist <= 0 ) ? MAX_VIEW_DISTANCE :
+                           safe_proxy_dist;
+
+    monster_visible_info &mon_visible = u.get_mon_visible();
+    auto &new_seen_mon = mon_visible.new_seen_mon;
+    auto &unique_types = mon_visible.unique_types;
+    auto &unique_mons = mon_visible.unique_mons;
+    auto &dangerous = mon_visible.dangerous;
+    mon_visible.has_dangerous_creature_in_proximity = false;
+
+    // 7 0 1    unique_types uses these indices;
+    // 6 8 2    0-7 are provide by direction_from()
+    // 5 4 3    8 is used for local monsters (for when we explain them below)
+    for( auto &t : unique_types ) {
+        t.clear();
+    }
+    for( auto &m : unique_mons ) {
+        m.clear();
+    }
+    std::fill( dangerous.begin(), dangerous.end(), false );
+
+    new_seen_mon.clear();
+
+    static time_point previous_turn = calendar::turn_zero;
+    const time_duration sm_ignored_turns =
+        time_duration::from_turns( option_safemode_ignore_turns.get() );
+    const bool safemode_empty = get_safemode().empty();
+
+    for( seen_creature &seen : current_seen_creatures( u ) ) {
+        const int index = seen.index;
         bool need_processing = false;
-        const bool safemode_empty = get_safemode().empty();
 
-        if( m != nullptr ) {
+        if( const shared_ptr_fast<monster> m = seen.mon.lock() ) {
             //Safemode monster check
             monster &critter = *m;
+            if( critter.is_dead() ) {
+                continue;
+            }
 
-            const monster_attitude matt = critter.attitude( &u );
-            const int mon_dist = rl_dist( u.pos(), critter.pos() );
+            const int mon_dist = seen.dist;
             if( !safemode_empty ) {
                 need_processing = get_safemode().check_monster(
-                                      critter.name(),
-                                      critter.attitude_to( u ),
+                                      seen.name,
+                                      seen.attitude,
                                       mon_dist,
                                       u.controlling_vehicle ) == rule_state::BLACKLISTED;
             } else {
-                need_processing =  MATT_ATTACK == matt || MATT_FOLLOW == matt;
+                need_processing =  MATT_ATTACK == seen.matt || MATT_FOLLOW == seen.matt;
             }
             if( need_processing ) {
-                if( index < 8 && critter.sees( get_player_character() ) ) {
-                    dangerous[index] = true;
+                if( index < 8 ) {
+                    if( !seen.sees_you ) {
+                        seen.sees_you = critter.sees( get_player_character() );
+                    }
+                    if( *seen.sees_you ) {
+                        dangerous[index] = true;
+                    }
                 }
 
                 if( !safemode_empty || mon_dist <= iProxyDist ) {
@@ -4563,7 +4677,7 @@ void game::mon_info_update( )
 
                     if( !passmon ) {
                         newseen++;
-                        new_seen_mon.push_back( shared_from( critter ) );
+                        new_seen_mon.push_back( m );
                     }
                 }
             }
@@ -4578,10 +4692,13 @@ void game::mon_info_update( )
             } else {
                 mon_it->second++;
             }
-        } else if( p != nullptr ) {
+        } else if( const shared_ptr_fast<npc> p = seen.guy.lock() ) {
             //Safe mode NPC check
+            if( p->is_dead() ) {
+                continue;
+            }
 
-            const int npc_dist = rl_dist( u.pos(), p->pos() );
+            const int npc_dist = seen.dist;
             if( !safemode_empty ) {
                 need_processing = get_safemode().check_monster(
                                       get_safemode().npc_type_name(),
@@ -4597,7 +4714,7 @@ void game::mon_info_update( )
                 mon_visible.has_dangerous_creature_in_proximity = true;
                 newseen++;
             }
-            unique_types[index].push_back( p );
+            unique_types[index].push_back( p.get() );
         }
     }
 
@@ -4630,11 +4747,11 @@ void game::mon_info_update( )
         if( safe_mode == SAFE_MODE_ON ) {
             set_safe_mode( SAFE_MODE_STOP );
         }
-    } else if( calendar::turn > previous_turn && get_option<bool>( "AUTOSAFEMODE" ) &&
+    } else if( calendar::turn > previous_turn && option_autosafemode.get() &&
                newseen == 0 ) { // Auto safe mode, but only if it's a new turn
         turnssincelastmon += calendar::turn - previous_turn;
         time_duration auto_safe_mode =
-            time_duration::from_turns( get_option<int>( "AUTOSAFEMODETURNS" ) );
+            time_duration::from_turns( option_autosafemode_turns.get() );
         if( turnssincelastmon >= auto_safe_mode && safe_mode == SAFE_MODE_OFF ) {
             set_safe_mode( SAFE_MODE_ON );
             add_msg( m_info, _( "Safe mode ON!" ) );
@@ -5072,6 +5189,7 @@ monster *game::place_critter_around( const mtype_id &id, const tripoint &center,
     if( id.is_null() ) {
         return nullptr;
     }
+    const alloc_profiler::scoped_tag alloc_tag( alloc_profiler::tag::creatures );
     shared_ptr_fast<monster> mon = make_shared_fast<monster>( id );
     mon->ammo = mon->type->starting_ammo;
     return place_critter_around( mon, center, radius );
@@ -5106,6 +5224,7 @@ monster *game::place_critter_within( const mtype_id &id, const tripoint_range<tr
     if( id.is_null() ) {
         return nullptr;
     }
+    const alloc_profiler::scoped_tag alloc_tag( alloc_profiler::tag::creatures );
     return place_critter_within( make_shared_fast<monster>( id ), range );
 }
 
@@ -7884,26 +8003,44 @@ static void add_item_recursive( std::vector<std::string> &item_order,
     }
 }
 
+const std::vector<tripoint_abs_ms> &game::visible_item_tiles()
+{
+    const tripoint_abs_ms origin = u.get_location();
+    if( visible_items_cache_time == calendar::turn && visible_items_cache_origin == origin.raw() &&
+        visible_items_cache_revision == m.get_items_revision() ) {
+        return visible_items_cache;
+    }
+    visible_items_cache_time = calendar::turn;
+    visible_items_cache_origin = origin.raw();
+    visible_items_cache_revision = m.get_items_revision();
+    visible_items_cache.clear();
+    if( u.is_blind() ) {
+        return visible_items_cache;
+    }
+    // The whole reality bubble, tiles without items are skipped before the costlier sight check.
+    for( const tripoint_bub_ms &p : closest_points_first( u.pos_bub(), 60 ) ) {
+        if( m.sees_some_items( p, u ) && u.sees( p ) ) {
+            visible_items_cache.push_back( m.getglobal( p ) );
+        }
+    }
+    return visible_items_cache;
+}
+
 std::vector<map_item_stack> game::find_nearby_items( int iRadius )
 {
     std::map<std::string, map_item_stack> temp_items;
     std::vector<map_item_stack> ret;
     std::vector<std::string> item_order;
 
-    if( u.is_blind() ) {
-        return ret;
-    }
-
-    for( tripoint_bub_ms &points_p_it : closest_points_first( u.pos_bub(), iRadius ) ) {
-        if( points_p_it.y() >= u.posy() - iRadius && points_p_it.y() <= u.posy() + iRadius &&
-            u.sees( points_p_it ) &&
-            m.sees_some_items( points_p_it, u ) ) {
-
-            for( item &elem : m.i_at( points_p_it ) ) {
-                const tripoint_rel_ms relative_pos = points_p_it - u.pos_bub();
-
-                add_item_recursive( item_order, temp_items, &elem, relative_pos.raw() );
-            }
+    for( const tripoint_abs_ms &abs_p : visible_item_tiles() ) {
+        const tripoint_bub_ms p = m.bub_from_abs( abs_p );
+        // Nearest first, everything after this is farther away as well.
+        if( square_dist( p, u.pos_bub() ) > iRadius ) {
+            break;
+        }
+        const tripoint_rel_ms relative_pos = p - u.pos_bub();
+        for( item &elem : m.i_at( p ) ) {
+            add_item_recursive( item_order, temp_items, &elem, relative_pos.raw() );
         }
     }
 
@@ -12811,9 +12948,105 @@ point game::update_map( int &x, int &y, bool z_level_changed )
     // Update what parts of the world map we can see
     update_overmap_seen();
 
+    prefetch_submaps_ahead( shift );
+
     return shift;
 }
 
+void game::prefetch_submaps_ahead( const point &shift )
+{
+    // One quad beyond the edge covers walking, faster vehicles need more warning.
+    int lookahead = 1;
+    if( const optional_vpart_position vp = m.veh_at( u.pos_bub() ) ) {
+        lookahead = clamp( 1 + std::abs( vp->vehicle().velocity ) / 2500, 1, 4 );
+    }
+    const tripoint_abs_sm origin = m.get_abs_sub();
+    const point dir( sgn( shift.x ), sgn( shift.y ) );
+    const auto strip = [&]( int begin, int end, bool along_x ) {
+        return along_x ? half_open_rectangle<point>( point( begin, origin.y() ),
+                point( end, origin.y() + MAPSIZE ) ) :
+               half_open_rectangle<point>( point( origin.x(), begin ), point( origin.x() + MAPSIZE, end ) );
+    };
+    std::vector<half_open_rectangle<point>> areas;
+    if( dir.x > 0 ) {
+        areas.push_back( strip( origin.x() + MAPSIZE, origin.x() + MAPSIZE + 2 * lookahead, true ) );
+    } else if( dir.x < 0 ) {
+        areas.push_back( strip( origin.x() - 2 * lookahead, origin.x(), true ) );
+    }
+    if( dir.y > 0 ) {
+        areas.push_back( strip( origin.y() + MAPSIZE, origin.y() + MAPSIZE + 2 * lookahead, false ) );
+    } else if( dir.y < 0 ) {
+        areas.push_back( strip( origin.y() - 2 * lookahead, origin.y(), false ) );
+    }
+
+    // Nearby z-levels first, in case the mapbuffer stops accepting requests.
+    std::vector<int> zlevels;
+    for( int dz = 0; dz <= OVERMAP_HEIGHT + OVERMAP_DEPTH; ++dz ) {
+        for( int z : { origin.z() - dz, origin.z() + dz } ) {
+            if( z >= -OVERMAP_DEPTH && z <= OVERMAP_HEIGHT &&
+                std::find( zlevels.begin(), zlevels.end(), z ) == zlevels.end() ) {
+                zlevels.push_back( z );
+            }
+        }
+    }
+
+    std::vector<tripoint_abs_omt> quads;
+    std::set<tripoint_abs_omt> seen;
+    for( int z : zlevels ) {
+        for( const half_open_rectangle<point> &area : areas ) {
+            for( int x = area.p_min.x; x < area.p_max.x; ++x ) {
+                for( int y = area.p_min.y; y < area.p_max.y; ++y ) {
+                    const tripoint_abs_omt quad = project_to<coords::omt>( tripoint_abs_sm( x, y, z ) );
+                    if( seen.insert( quad ).second ) {
+                        quads.push_back( quad );
+                    }
+                }
+            }
+        }
+    }
+    MAPBUFFER.prefetch( quads );
+
+    // Quads without a savefile would be generated by map::loadn as the bubble reaches them.
+    // A whole z-column is generated at once, so queue one quad per column, nearest first.
+    const point_abs_omt center = project_to<coords::omt>( origin.xy() + point( MAPSIZE / 2,
+                                 MAPSIZE / 2 ) );
+    std::vector<tripoint_abs_omt> columns;
+    for( const tripoint_abs_omt &quad : quads ) {
+        if( quad.z() == origin.z() ) {
+            columns.push_back( quad );
+        }
+    }
+    std::stable_sort( columns.begin(), columns.end(),
+    [&center]( const tripoint_abs_omt & l, const tripoint_abs_omt & r ) {
+        return square_dist( l.xy(), center ) < square_dist( r.xy(), center );
+    } );
+    mapgen_ahead.assign( columns.begin(), columns.end() );
+}
+
+void game::generate_submaps_ahead( const std::chrono::milliseconds budget )
+{
+    const auto start = std::chrono::steady_clock::now();
+    while( !mapgen_ahead.empty() && std::chrono::steady_clock::now() - start < budget ) {
+        const tripoint_abs_omt quad = mapgen_ahead.front();
+        mapgen_ahead.pop_front();
+        // Don't generate the overmap as well, that is overmapbuffer::generate_ahead's job.
+        if( !overmap_buffer.get_existing( project_to<coords::om>( quad.xy() ) ) ) {
+            continue;
+        }
+        bool generated = false;
+        for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT && !generated; ++z ) {
+            generated = MAPBUFFER.has_quad( tripoint_abs_omt( quad.xy(), z ) );
+        }
+        if( generated ) {
+            continue;
+        }
+        // Same as map::loadn, a quad outside the bubble needs no cleanup of the main map.
+        smallmap tmp_map;
+        tmp_map.main_cleanup_override( false );
+        tmp_map.generate( quad, calendar::turn, true );
+    }
+}
+
 void game::update_overmap_seen()
 {
     const tripoint_abs_omt ompos = u.global_omt_location();
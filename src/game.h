@@ -5,6 +5,7 @@
 #include <array>
 #include <chrono>
 #include <ctime>
+#include <deque>
 #include <functional>
 #include <iosfwd>
 #include <map>
@@ -614,6 +615,14 @@ class game
         point update_map( Character &p, bool z_level_changed = false );
         point update_map( int &x, int &y, bool z_level_changed = false );
         void update_overmap_seen(); // Update which overmap tiles we can see
+        // Start reading the quads the bubble is about to move onto, see mapbuffer::prefetch
+        void prefetch_submaps_ahead( const point &shift );
+        /**
+         * Generate the quads queued by prefetch_submaps_ahead that have never been generated,
+         * nearest first, until @p budget is spent.  A quad the bubble then moves onto only has
+         * to be loaded instead of generated in map::loadn.
+         */
+        void generate_submaps_ahead( std::chrono::milliseconds budget );
 
         void peek();
         void peek( const tripoint_bub_ms &p );
@@ -657,6 +666,12 @@ class game
                                         bool change_lv = true );
         look_around_result look_around( look_around_params );
 
+        /**
+         * Tiles around the avatar that the avatar sees and that hold items, nearest first.
+         * Rebuilt only when the turn, the avatar position or the items on the map change.
+         */
+        const std::vector<tripoint_abs_ms> &visible_item_tiles();
+
         // Shared method to print "look around" info
         void pre_print_all_tile_info( const tripoint &lp, const catacurses::window &w_info,
                                       int &line, int last_line, const visibility_variables &cache );
@@ -1102,6 +1117,13 @@ class game
         void move_save_to_graveyard();
         bool save_player_data();
         bool save_achievements();
+        /**
+         * Like @ref write_to_file, but serializes to memory first and leaves the file alone
+         * if it still holds exactly that data from an earlier save since the last load.
+         */
+        bool write_to_file_if_changed( const std::string &path,
+                                       const std::function<void( std::ostream & )> &writer,
+                                       const char *fail_message );
         // ########################## DATA ################################
         // May be a bit hacky, but it's probably better than the header spaghetti
         pimpl<map> map_ptr; // NOLINT(cata-serialize)
@@ -1222,12 +1244,20 @@ class game
         // NOLINTNEXTLINE(cata-serialize)
         std::chrono::time_point<std::chrono::steady_clock> time_of_last_load;
         int moves_since_last_save = 0; // NOLINT(cata-serialize)
+        // Size and hash of the data last written by write_to_file_if_changed, per path.
+        // NOLINTNEXTLINE(cata-serialize)
+        std::unordered_map<std::string, std::pair<size_t, size_t>> saved_file_digests;
         std::time_t last_save_timestamp = 0; // NOLINT(cata-serialize)
 
         mutable std::array<float, OVERMAP_LAYERS> latest_lightlevels; // NOLINT(cata-serialize)
         // remoteveh() cache
         time_point remoteveh_cache_time; // NOLINT(cata-serialize)
         vehicle *remoteveh_cache; // NOLINT(cata-serialize)
+        // visible_item_tiles() cache, valid for this turn, avatar position and map item revision
+        time_point visible_items_cache_time; // NOLINT(cata-serialize)
+        tripoint visible_items_cache_origin; // NOLINT(cata-serialize)
+        int visible_items_cache_revision = 0; // NOLINT(cata-serialize)
+        std::vector<tripoint_abs_ms> visible_items_cache; // NOLINT(cata-serialize)
         /** Has a NPC been spawned since last load? */
         bool npcs_dirty = false; // NOLINT(cata-serialize)
         /** Has anything died in this turn and needs to be cleaned up? */
@@ -1252,6 +1282,9 @@ class game
         // Preview for auto move route
         std::vector<tripoint_bub_ms> destination_preview; // NOLINT(cata-serialize)
 
+        // Quads ahead of the bubble for generate_submaps_ahead, nearest first
+        std::deque<tripoint_abs_omt> mapgen_ahead; // NOLINT(cata-serialize)
+
         // NOLINTNEXTLINE(cata-serialize)
         std::chrono::time_point<std::chrono::steady_clock> last_mouse_edge_scroll;
         tripoint last_mouse_edge_scroll_vector_terrain; // NOLINT(cata-serialize)
@@ -1329,6 +1362,15 @@ class game
             bool deploy_affordance = false );
 };
 
+// Heat reaching a location from nearby fires and hot terrain, gathered in one scan
+struct heat_sources {
+    // Temperature modifier from direct heat radiation
+    units::temperature_delta radiation = units::from_kelvin_delta( 0 );
+    // Heat intensity of the strongest adjacent fire
+    int best_fire = 0;
+};
+heat_sources get_heat_sources( const tripoint &location );
+
 // Returns temperature modifier from direct heat radiation of nearby sources
 // @param location Location affected by heat sources
 units::temperature_delta get_heat_radiation( const tripoint &location );
@@ -140,17 +140,98 @@ class generic_factory
         std::vector<T> list;
         std::unordered_map<string_id<T>, int_id<T>> map;
         std::unordered_map<std::string, T> abstracts;
+        // Objects recorded by load_lazily, by int id, that weren't loaded yet.  Their slot in
+        // `list` holds a placeholder with just the id until they are first accessed.
+        mutable std::unordered_map<int, std::pair<JsonObject, std::string>> lazy;
+        // Set by load_lazily, so types without `T::load` can still use the factory.
+        void ( *load_recorded )( T &, const JsonObject &, const std::string & ) = nullptr;
+
+        // Loads the recorded JSON of the object at `cid` into its slot, if it wasn't yet.
+        void materialize( int cid ) const {
+            const auto iter = lazy.find( cid );
+            if( iter == lazy.end() ) {
+                return;
+            }
+            const std::pair<JsonObject, std::string> recorded = std::move( iter->second );
+            lazy.erase( iter );
+            // The factories are never const themselves, only their accessors are.
+            T &slot = const_cast<T &>( list[cid] );
+            T def;
+            def.id = slot.id;
+            mod_tracker::assign_src( def, recorded.second );
+            load_recorded( def, recorded.first, recorded.second );
+            slot = std::move( def );
+            slot.id.set_cid_version( cid, version );
+        }
+        // Forgets the recorded JSON of the object at `cid`, it is replaced.
+        void drop_lazy( int cid ) {
+            const auto iter = lazy.find( cid );
+            if( iter != lazy.end() ) {
+                iter->second.first.allow_omitted_members();
+                lazy.erase( iter );
+            }
+        }
+        void materialize_all() const {
+            while( !lazy.empty() ) {
+                materialize( lazy.begin()->first );
+            }
+        }
 
         std::string type_name;
         std::string id_member_name;
         // TEMPORARY until 0.G: Remove "ident" support
         const std::string legacy_id_member_name = "ident";
 
+        // Open addressing table from the interned string of an id to its int id, built by
+        // finalize for types with static string ids.  Valid while `version` doesn't change.
+        struct interned_slot {
+            int interned = INVALID_CID;
+            int cid = INVALID_CID;
+        };
+        std::vector<interned_slot> interned_lookup;
+        int64_t interned_lookup_version = INVALID_VERSION;
+
+        void build_interned_lookup() {
+            if constexpr( !string_id_params<T>::dynamic ) {
+                // At most half full, so probe sequences stay short.
+                size_t capacity = 16;
+                while( capacity < map.size() * 2 ) {
+                    capacity *= 2;
+                }
+                interned_lookup.assign( capacity, interned_slot() );
+                const size_t mask = capacity - 1;
+                for( const std::pair<const string_id<T>, int_id<T>> &entry : map ) {
+                    const int interned = entry.first._id._id;
+                    // The interned strings of one type are mostly consecutive, no need to mix them.
+                    size_t slot = static_cast<size_t>( interned ) & mask;
+                    while( interned_lookup[slot].interned != INVALID_CID ) {
+                        slot = ( slot + 1 ) & mask;
+                    }
+                    interned_lookup[slot] = interned_slot{ interned, entry.second.to_i() };
+                }
+                interned_lookup_version = version;
+            }
+        }
+
         bool find_id( const string_id<T> &id, int_id<T> &result ) const {
             if( id._version == version ) {
                 result = int_id<T>( id._cid );
                 return is_valid( result );
             }
+            if constexpr( !string_id_params<T>::dynamic ) {
+                if( interned_lookup_version == version ) {
+                    const int interned = id._id._id;
+                    const size_t mask = interned_lookup.size() - 1;
+                    for( size_t slot = static_cast<size_t>( interned ) & mask; ; slot = ( slot + 1 ) & mask ) {
+                        const interned_slot &entry = interned_lookup[slot];
+                        if( entry.interned == interned || entry.interned == INVALID_CID ) {
+                            id.set_cid_version( entry.cid, version );
+                            result = int_id<T>( entry.cid );
+                            return entry.cid != INVALID_CID;
+                        }
+                    }
+                }
+            }
             const auto iter = map.find( id );
             // map lookup happens at most once per string_id instance per generic_factory::version
             // id was not found, explicitly marking it as "invalid"
@@ -224,6 +305,7 @@ class generic_factory
                 auto base = map.find( string_id<T>( source ) );
 
                 if( base != map.end() ) {
+                    materialize( base->second.to_i() );
                     const T &base_obj = obj( base->second );
                     handle_inheritance_on_T( def, base_obj );
                 } else {
@@ -315,6 +397,32 @@ class generic_factory
                                                abstract_member_name, id_member_name, legacy_id_member_name ) );
             }
         }
+        /**
+         * Like @ref load, but when @ref DynamicDataLoader::load_lazily allows it, only records `jo`
+         * and loads the object the first time it is accessed.  That's limited to objects with a
+         * single id and without inheritance, the others are loaded right away.
+         *
+         * Only for types whose `T::load` has no side effects besides filling the object, errors
+         * in the JSON are only found once the object is used.
+         */
+        void load_lazily( const JsonObject &jo, const std::string &src ) {
+            if( !DynamicDataLoader::get_instance().load_lazily() || !jo.has_string( id_member_name ) ||
+                jo.has_member( "copy-from" ) || jo.has_member( "abstract" ) ) {
+                load( jo, src );
+                return;
+            }
+            T def;
+            def.id = string_id<T>( jo.get_string( id_member_name ) );
+            mod_tracker::assign_src( def, src );
+            insert( def );
+            load_recorded = []( T & into, const JsonObject & from, const std::string & from_src ) {
+                into.load( from, from_src );
+            };
+            // The copy checks for unvisited members once it is loaded, this one is done.
+            lazy.emplace( map[def.id].to_i(), std::make_pair( jo, src ) );
+            jo.allow_omitted_members();
+        }
+
         /**
          * Add an object to the factory, without loading from JSON.
          * The new object replaces any existing object of the same id.
@@ -330,6 +438,7 @@ class generic_factory
             const auto iter = map.find( obj.id );
             if( iter != map.end() ) {
                 mod_tracker::check_duplicate_entries( obj, list[iter->second.to_i()] );
+                drop_lazy( iter->second.to_i() );
                 T &result = list[iter->second.to_i()];
                 result = obj;
                 result.id.set_cid_version( iter->second.to_i(), version );
@@ -354,12 +463,14 @@ class generic_factory
             for( size_t i = 0; i < list.size(); i++ ) {
                 list[i].id.set_cid_version( static_cast<int>( i ), version );
             }
+            build_interned_lookup();
         }
 
         /**
          * Checks loaded/inserted objects for consistency
          */
         void check() const {
+            materialize_all();
             for( const T &obj : list ) {
                 obj.check();
             }
@@ -386,6 +497,10 @@ class generic_factory
                 deferred_json.first.allow_omitted_members();
             }
             deferred.clear();
+            for( std::pair<const int, std::pair<JsonObject, std::string>> &recorded : lazy ) {
+                recorded.second.first.allow_omitted_members();
+            }
+            lazy.clear();
             list.clear();
             map.clear();
             inc_version();
@@ -394,6 +509,7 @@ class generic_factory
          * Returns all the loaded objects. It can be used to iterate over them.
          */
         const std::vector<T> &get_all() const {
+            materialize_all();
             return list;
         }
         /**
@@ -416,6 +532,9 @@ class generic_factory
                 debugmsg( "invalid %s id \"%d\"", type_name, id.to_i() );
                 return dummy_obj;
             }
+            if( !lazy.empty() ) {
+                materialize( id.to_i() );
+            }
             return list[id.to_i()];
         }
         /**
@@ -431,6 +550,9 @@ class generic_factory
                 debugmsg( "invalid %s id \"%s\"", type_name, id.c_str() );
                 return dummy_obj;
             }
+            if( !lazy.empty() ) {
+                materialize( i_id.to_i() );
+            }
             return list[i_id.to_i()];
         }
         /**
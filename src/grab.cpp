@@ -288,7 +288,7 @@ bool game::grabbed_veh_move( const tripoint_rel_ms &dp )
     }
 
     m.displace_vehicle( *grabbed_vehicle, final_dp_veh );
-    m.rebuild_vehicle_level_caches();
+    m.add_vehicle_to_cache( grabbed_vehicle );
 
     if( grabbed_vehicle ) {
         m.level_vehicle( *grabbed_vehicle );
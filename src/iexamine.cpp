@@ -1372,8 +1372,8 @@ void iexamine::elevator( Character &you, const tripoint_bub_ms &examp )
         v->turn( erot * 90_degrees );
         v->face = tileray( v->turn_dir );
         v->precalc_mounts( 0, v->turn_dir, v->pivot_anchor[0] );
+        here.add_vehicle_to_cache( v );
     }
-    here.rebuild_vehicle_level_caches();
     if( you.is_avatar() ) {
         g->vertical_shift( movez );
         g->update_map( you, true );
@@ -1,10 +1,17 @@
 #include "init.h"
 
+#include <algorithm>
 #include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <istream>
 #include <memory>
+#include <ostream>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "achievement.h"
@@ -46,7 +53,9 @@
 #include "flag.h"
 #include "game.h"
 #include "gates.h"
+#include "get_version.h"
 #include "harvest.h"
+#include "hash_utils.h"
 #include "input.h"
 #include "item_action.h"
 #include "item_category.h"
@@ -100,6 +109,7 @@
 #include "start_location.h"
 #include "test_data.h"
 #include "text_snippets.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "trap.h"
 #include "type_id.h"
@@ -514,6 +524,53 @@ void DynamicDataLoader::initialize()
 #endif
 }
 
+// Parses the files on a worker pool, a few files ahead of @p load, which gets them one at a
+// time and in order on the calling thread.  Errors of parsing are thrown by the file they are in.
+static void for_each_parsed_file( const std::vector<cata_path> &files,
+                                  const std::function<void( size_t, const JsonValue & )> &load )
+{
+    thread_pool *pool = shared_thread_pool();
+    if( pool == nullptr || files.size() < 2 ) {
+        for( size_t i = 0; i < files.size(); ++i ) {
+            load( i, json_loader::from_path( files[i] ) );
+        }
+        return;
+    }
+    // Enough to keep the workers busy while the loading catches up, without holding every
+    // parsed file in memory at once.
+    const size_t max_ahead = pool->size() * 4;
+    std::vector<std::future<JsonValue>> parsed( files.size() );
+    size_t next_to_parse = 0;
+    for( size_t i = 0; i < files.size(); ++i ) {
+        for( ; next_to_parse < std::min( files.size(), i + max_ahead ); ++next_to_parse ) {
+            auto task = std::make_shared<std::packaged_task<JsonValue()>>( [file = files[next_to_parse]]() {
+                return json_loader::from_path( file );
+            } );
+            parsed[next_to_parse] = task->get_future();
+            pool->push( [task]() {
+                ( *task )();
+            } );
+        }
+        // Drop each file once it is loaded, the objects keep what they need of it.
+        load( i, std::exchange( parsed[i], {} ).get() );
+    }
+}
+
+void DynamicDataLoader::hash_loaded_files( const std::vector<cata_path> &files,
+        const std::string &src )
+{
+    cata::hash_combine( loaded_files_hash, src );
+    for( const cata_path &file : files ) {
+        const fs::path path = file.get_unrelative_path();
+        std::error_code ec;
+        const uintmax_t size = fs::file_size( path, ec );
+        const fs::file_time_type mtime = fs::last_write_time( path, ec );
+        cata::hash_combine( loaded_files_hash, path.generic_u8string() );
+        cata::hash_combine( loaded_files_hash, size );
+        cata::hash_combine( loaded_files_hash, static_cast<int64_t>( mtime.time_since_epoch().count() ) );
+    }
+}
+
 void DynamicDataLoader::load_data_from_path( const cata_path &path, const std::string &src )
 {
     cata_assert( !finalized &&
@@ -532,15 +589,13 @@ void DynamicDataLoader::load_data_from_path( const cata_path &path, const std::s
         files.emplace_back( path );
     }
 
-    // iterate over each file
-    for( const cata_path &file : files ) {
-        try {
-            // parse it
-            JsonValue jsin = json_loader::from_path( file );
-            load_all_from_json( jsin, src, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( err.what() );
-        }
+    hash_loaded_files( files, src );
+    try {
+        for_each_parsed_file( files, [&]( size_t i, const JsonValue & jsin ) {
+            load_all_from_json( jsin, src, path, files[i] );
+        } );
+    } catch( const JsonError &err ) {
+        throw std::runtime_error( err.what() );
     }
 }
 
@@ -565,15 +620,13 @@ void DynamicDataLoader::load_mod_data_from_path( const cata_path &path, const st
         files.emplace_back( path );
     }
 
-    // iterate over each file
-    for( const cata_path &file : files ) {
-        try {
-            // parse it
-            JsonValue jsin = json_loader::from_path( file );
-            load_all_from_json( jsin, src, path, file );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( err.what() );
-        }
+    hash_loaded_files( files, src );
+    try {
+        for_each_parsed_file( files, [&]( size_t i, const JsonValue & jsin ) {
+            load_all_from_json( jsin, src, path, files[i] );
+        } );
+    } catch( const JsonError &err ) {
+        throw std::runtime_error( err.what() );
     }
 }
 
@@ -604,18 +657,28 @@ void DynamicDataLoader::load_mod_interaction_files_from_path( const cata_path &p
             }
         }
     }
-    // iterate over each file
+    std::vector<const std::pair<const mod_id, cata_path> *> ordered_files;
+    std::vector<cata_path> file_paths;
     for( const std::pair<const mod_id, cata_path> &file : files ) {
-        try {
-            // parse it
-            JsonValue jsin = json_loader::from_path( file.second );
+        ordered_files.push_back( &file );
+        file_paths.push_back( file.second );
+    }
+    hash_loaded_files( file_paths, src );
+    try {
+        for_each_parsed_file( file_paths, [&]( size_t i, const JsonValue & jsin ) {
+            const std::pair<const mod_id, cata_path> &file = *ordered_files[i];
             load_all_from_json( jsin, string_format( "%s#%s", src, file.first.str() ), path, file.second );
-        } catch( const JsonError &err ) {
-            throw std::runtime_error( err.what() );
-        }
+        } );
+    } catch( const JsonError &err ) {
+        throw std::runtime_error( err.what() );
     }
 }
 
+bool DynamicDataLoader::load_lazily() const
+{
+    return get_option<bool>( "LAZY_DATA_LOADING" ) && get_option<bool>( "SKIP_VERIFICATION" );
+}
+
 void DynamicDataLoader::load_all_from_json( const JsonValue &jsin, const std::string &src,
         const cata_path &base_path, const cata_path &full_path )
 {
@@ -640,6 +703,7 @@ void DynamicDataLoader::load_all_from_json( const JsonValue &jsin, const std::st
 void DynamicDataLoader::unload_data()
 {
     finalized = false;
+    loaded_files_hash = 0;
 
     achievement::reset();
     activity_type::reset();
@@ -862,22 +926,121 @@ void DynamicDataLoader::finalize_loaded_data()
     }
 
     if( !get_option<bool>( "SKIP_VERIFICATION" ) ) {
-        check_consistency();
+        check_consistency_unless_verified();
     }
     finalized = true;
 }
 
+static std::string verified_data_path()
+{
+    return PATH_INFO::user_dir() + "cache/verified_data.txt";
+}
+
+void DynamicDataLoader::check_consistency_unless_verified()
+{
+    if( !get_option<bool>( "SKIP_VERIFIED_DATA" ) ) {
+        check_consistency();
+        return;
+    }
+    size_t data_hash = loaded_files_hash;
+    cata::hash_combine( data_hash, std::string( getVersionString() ) );
+    size_t verified_hash = 0;
+    read_from_file_optional( verified_data_path(), [&verified_hash]( std::istream & fin ) {
+        fin >> verified_hash;
+    } );
+    if( verified_hash == data_hash && data_hash != 0 ) {
+        return;
+    }
+    check_consistency();
+    if( debug_has_error_been_observed() ) {
+        // The errors must be shown again next time.
+        return;
+    }
+    assure_dir_exist( PATH_INFO::user_dir() + "cache" );
+    write_to_file( verified_data_path(), [data_hash]( std::ostream & fout ) {
+        fout << data_hash;
+    }, nullptr );
+}
+
+namespace
+{
+struct check_entry {
+    std::string name;
+    std::function<void()> check;
+    // Run on its own once the others are done, see PARALLEL_VERIFICATION.
+    bool exclusive = false;
+};
+
+struct check_result {
+    std::vector<deferred_debugmsg> messages;
+    std::exception_ptr failure;
+};
+} // namespace
+
+// The checks only read the finalized data, so most of them can run at the same time.  Their
+// messages are shown in the order of @p entries, once the check they come from is done.
+static void run_checks_concurrently( const std::vector<check_entry> &entries )
+{
+    static thread_pool pool;
+    // The checks refer to the entries, none may be left running when this returns or throws.
+    on_out_of_scope wait_for_checks( []() {
+        pool.wait();
+    } );
+    std::vector<std::future<check_result>> results( entries.size() );
+    for( size_t i = 0; i < entries.size(); ++i ) {
+        if( entries[i].exclusive ) {
+            continue;
+        }
+        auto task = std::make_shared<std::packaged_task<check_result()>>( [&check =
+        entries[i].check]() {
+            check_result result;
+            result.messages = defer_debugmsgs_during( [&]() {
+                try {
+                    check();
+                } catch( ... ) {
+                    result.failure = std::current_exception();
+                }
+            } );
+            return result;
+        } );
+        results[i] = task->get_future();
+        pool.push( [task]() {
+            ( *task )();
+        } );
+    }
+    for( size_t i = 0; i < entries.size(); ++i ) {
+        if( entries[i].exclusive ) {
+            continue;
+        }
+        loading_ui::show( _( "Verifying" ), entries[i].name );
+        const check_result result = results[i].get();
+        show_deferred_debugmsgs( result.messages );
+        if( result.failure ) {
+            std::rethrow_exception( result.failure );
+        }
+        check_sigint();
+    }
+    for( const check_entry &e : entries ) {
+        if( e.exclusive ) {
+            loading_ui::show( _( "Verifying" ), e.name );
+            e.check();
+            check_sigint();
+        }
+    }
+}
+
 void DynamicDataLoader::check_consistency()
 {
-    using named_entry = std::pair<std::string, std::function<void()>>;
-    const std::vector<named_entry> entries = {{
+    // Creates items or fills caches while checking, so it can't run alongside the others.
+    constexpr bool exclusive = true;
+    const std::vector<check_entry> entries = {{
             { _( "Flags" ), &json_flag::check_consistency },
             { _( "Option sliders" ), &option_slider::check_consistency },
             {
                 _( "Crafting requirements" ), []()
                 {
                     requirement_data::check_consistency();
-                }
+                }, exclusive
             },
             { _( "Vitamins" ), &vitamin::check_consistency },
             { _( "Weather types" ), &weather_types::check_consistency },
@@ -894,30 +1057,30 @@ void DynamicDataLoader::check_consistency()
                 _( "Items" ), []()
                 {
                     item_controller->check_definitions();
-                }
+                }, exclusive
             },
             { _( "Materials" ), &materials::check },
             { _( "Faults" ), &faults::check_consistency },
-            { _( "Vehicle parts" ), &vehicles::parts::check },
+            { _( "Vehicle parts" ), &vehicles::parts::check, exclusive },
             { _( "Vehicle part migrations" ), &vpart_migration::check },
-            { _( "Mapgen definitions" ), &check_mapgen_definitions },
+            { _( "Mapgen definitions" ), &check_mapgen_definitions, exclusive },
             { _( "Mapgen palettes" ), &mapgen_palette::check_definitions },
             {
                 _( "Monster types" ), []()
                 {
                     MonsterGenerator::generator().check_monster_definitions();
-                }
+                }, exclusive
             },
             { _( "Monster groups" ), &MonsterGroupManager::check_group_definitions },
             { _( "Furniture and terrain" ), &check_furniture_and_terrain },
             { _( "Furniture and terrain migrations" ), &ter_furn_migrations::check },
-            { _( "Constructions" ), &check_constructions },
-            { _( "Crafting recipes" ), &recipe_dictionary::check_consistency },
-            { _( "Professions" ), &profession::check_definitions },
+            { _( "Constructions" ), &check_constructions, exclusive },
+            { _( "Crafting recipes" ), &recipe_dictionary::check_consistency, exclusive },
+            { _( "Professions" ), &profession::check_definitions, exclusive },
             { _( "Profession groups" ), &profession_group::check_profession_group_consistency },
-            { _( "Martial arts" ), &check_martialarts },
+            { _( "Martial arts" ), &check_martialarts, exclusive },
             { _( "Climbing aid" ), &climbing_aid::check_consistency },
-            { _( "Mutations" ), &mutation_branch::check_consistency },
+            { _( "Mutations" ), &mutation_branch::check_consistency, exclusive },
             { _( "Mutation categories" ), &mutation_category_trait::check_consistency },
             { _( "Region settings" ), check_region_settings },
             { _( "Overmap land use codes" ), &overmap_land_use_codes::check_consistency },
@@ -929,26 +1092,26 @@ void DynamicDataLoader::check_consistency()
             { _( "Overmap specials" ), &overmap_specials::check_consistency },
             { _( "Map extras" ), &MapExtras::check_consistency },
             { _( "Shop rates" ), &shopkeeper_cons_rates::check_all },
-            { _( "Start locations" ), &start_locations::check_consistency },
-            { _( "Ammunition types" ), &ammunition_type::check_consistency },
-            { _( "Traps" ), &trap::check_consistency },
-            { _( "Bionics" ), &bionic_data::check_bionic_consistency },
+            { _( "Start locations" ), &start_locations::check_consistency, exclusive },
+            { _( "Ammunition types" ), &ammunition_type::check_consistency, exclusive },
+            { _( "Traps" ), &trap::check_consistency, exclusive },
+            { _( "Bionics" ), &bionic_data::check_bionic_consistency, exclusive },
             { _( "Gates" ), &gates::check },
-            { _( "NPC classes" ), &npc_class::check_consistency },
+            { _( "NPC classes" ), &npc_class::check_consistency, exclusive },
             { _( "Behaviors" ), &behavior::check_consistency },
             { _( "Mission types" ), &mission_type::check_consistency },
             {
                 _( "Item actions" ), []()
                 {
                     item_action_generator::generator().check_consistency();
-                }
+                }, exclusive
             },
-            { _( "Harvest lists" ), &harvest_list::check_consistency },
-            { _( "NPC templates" ), &npc_template::check_consistency },
+            { _( "Harvest lists" ), &harvest_list::check_consistency, exclusive },
+            { _( "NPC templates" ), &npc_template::check_consistency, exclusive },
             { _( "Body parts" ), &body_part_type::check_consistency },
             { _( "Body graphs" ), &bodygraph::check_all },
             { _( "Anatomies" ), &anatomy::check_consistency },
-            { _( "Spells" ), &spell_type::check_consistency },
+            { _( "Spells" ), &spell_type::check_consistency, exclusive },
             { _( "Transformations" ), &event_transformation::check_consistency },
             { _( "Statistics" ), &event_statistic::check_consistency },
             { _( "Scent types" ), &scent_type::check_scent_consistency },
@@ -960,9 +1123,13 @@ void DynamicDataLoader::check_consistency()
         }
     };
 
-    for( const named_entry &e : entries ) {
-        loading_ui::show( _( "Verifying" ), e.first );
-        e.second();
+    if( get_option<bool>( "PARALLEL_VERIFICATION" ) ) {
+        run_checks_concurrently( entries );
+        return;
+    }
+    for( const check_entry &e : entries ) {
+        loading_ui::show( _( "Verifying" ), e.name );
+        e.check();
         check_sigint();
     }
 }
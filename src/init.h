@@ -70,6 +70,11 @@ class DynamicDataLoader
 
         std::unique_ptr<cached_streams> stream_cache;
 
+        // Hash of the paths, sizes and modification times of the files loaded since the last
+        // unload, identifies the data that @ref check_consistency passed before.
+        size_t loaded_files_hash = 0;
+        void hash_loaded_files( const std::vector<cata_path> &files, const std::string &src );
+
     protected:
         /**
          * Maps the type string (coming from json) to the
@@ -122,6 +127,11 @@ class DynamicDataLoader
          * @param ui Finalization status display.
          */
         void check_consistency();
+        /**
+         * Calls @ref check_consistency, unless the SKIP_VERIFIED_DATA option is set and the same
+         * files already passed it with this version of the game.
+         */
+        void check_consistency_unless_verified();
 
     public:
         /**
@@ -184,6 +194,13 @@ class DynamicDataLoader
          */
         void load_deferred( deferred_json &data );
 
+        /**
+         * Whether rarely used types may record their JSON and load each object on first access,
+         * see @ref generic_factory::load_lazily.  Only with the LAZY_DATA_LOADING option, and
+         * without verification, which reads every object anyway.
+         */
+        bool load_lazily() const;
+
         /**
          * Returns whether the data is finalized and ready to be utilized.
          */
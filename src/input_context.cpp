@@ -21,6 +21,7 @@
 #include "game.h"
 #include "help.h"
 #include "input.h"
+#include "input_journal.h"
 #include "map.h"
 #include "options.h"
 #include "output.h"
@@ -438,10 +439,17 @@ const std::string &input_context::handle_input( const int timeout )
     }
     next_action.type = input_event_t::error;
     const std::string *result = &CATA_ERROR;
+    // Don't wait for the player with a frame held back by the pacing.
+    ui_manager::flush_redraw();
     while( true ) {
 
-        next_action = inp_mngr.get_input_event( preferred_keyboard_mode );
+        if( std::optional<input_event> replayed = input_journal::next_replayed_event() ) {
+            next_action = std::move( *replayed );
+        } else {
+            next_action = inp_mngr.get_input_event( preferred_keyboard_mode );
+        }
         if( next_action.type == input_event_t::timeout ) {
+            input_journal::record( next_action, category, TIMEOUT );
             result = &TIMEOUT;
             break;
         }
@@ -452,6 +460,7 @@ const std::string &input_context::handle_input( const int timeout )
             break;
         }
         const std::string &action = input_to_action( next_action );
+        input_journal::record( next_action, category, action );
 
         //Special global key to toggle language to english and back
         if( action == "toggle_language_to_en" ) {
@@ -0,0 +1,217 @@
+#include "input_journal.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <ostream>
+#include <set>
+#include <utility>
+
+#include "calendar.h"
+#include "cata_path.h"
+#include "cata_utility.h"
+#include "json.h"
+#include "rng.h"
+#include "turn_profiler.h"
+
+namespace input_journal
+{
+
+namespace
+{
+
+// Indexed by input_event_t and keymod_t.
+constexpr std::array<const char *, 6> event_type_names = {
+    "error", "timeout", "keyboard_char", "keyboard_code", "gamepad", "mouse"
+};
+constexpr std::array<const char *, 3> modifier_names = { "ctrl", "alt", "shift" };
+
+template<size_t N>
+int index_of( const std::array<const char *, N> &names, const std::string &name )
+{
+    for( size_t i = 0; i < N; ++i ) {
+        if( name == names[i] ) {
+            return static_cast<int>( i );
+        }
+    }
+    return -1;
+}
+
+struct journal_state {
+    bool recording = false;
+    journal recorded;
+    bool replaying = false;
+    journal replayed;
+    size_t next_entry = 0;
+};
+
+journal_state &state()
+{
+    static journal_state s;
+    return s;
+}
+
+} // namespace
+
+void journal::serialize( JsonOut &jsout ) const
+{
+    jsout.start_object();
+    jsout.member( "seed", seed );
+    jsout.member( "entries" );
+    jsout.start_array();
+    for( const entry &e : entries ) {
+        jsout.start_object();
+        jsout.member( "turn", e.turn );
+        jsout.member( "context", e.context );
+        jsout.member( "action", e.action );
+        jsout.member( "type", event_type_names[static_cast<size_t>( e.event.type )] );
+        jsout.member( "sequence", e.event.sequence );
+        if( !e.event.modifiers.empty() ) {
+            jsout.member( "modifiers" );
+            jsout.start_array();
+            for( const keymod_t mod : e.event.modifiers ) {
+                jsout.write( modifier_names[static_cast<size_t>( mod )] );
+            }
+            jsout.end_array();
+        }
+        if( e.event.type == input_event_t::mouse ) {
+            jsout.member( "mouse_pos", e.event.mouse_pos );
+        }
+        if( !e.event.text.empty() ) {
+            jsout.member( "text", e.event.text );
+        }
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+}
+
+void journal::deserialize( const JsonObject &jo )
+{
+    jo.read( "seed", seed );
+    entries.clear();
+    for( const JsonObject eo : jo.get_array( "entries" ) ) {
+        entry e;
+        eo.read( "turn", e.turn );
+        eo.read( "context", e.context );
+        eo.read( "action", e.action );
+        const int type = index_of( event_type_names, eo.get_string( "type" ) );
+        if( type < 0 ) {
+            eo.throw_error_at( "type", "unknown input event type" );
+        }
+        e.event.type = static_cast<input_event_t>( type );
+        eo.read( "sequence", e.event.sequence );
+        for( const std::string mod : eo.get_array( "modifiers" ) ) {
+            const int index = index_of( modifier_names, mod );
+            if( index < 0 ) {
+                eo.throw_error_at( "modifiers", "unknown key modifier" );
+            }
+            e.event.modifiers.insert( static_cast<keymod_t>( index ) );
+        }
+        eo.read( "mouse_pos", e.event.mouse_pos );
+        eo.read( "text", e.event.text );
+        entries.push_back( std::move( e ) );
+    }
+}
+
+bool write_journal( const journal &j, const cata_path &path )
+{
+    return write_to_file( path, [&j]( std::ostream & fout ) {
+        JsonOut jsout( fout, true );
+        j.serialize( jsout );
+    }, "input journal" );
+}
+
+std::optional<journal> read_journal( const cata_path &path )
+{
+    journal j;
+    const auto reader = [&j]( const JsonValue & jv ) {
+        j.deserialize( jv.get_object() );
+    };
+    if( !read_from_file_json( path, reader ) ) {
+        return std::nullopt;
+    }
+    return j;
+}
+
+bool is_recording()
+{
+    return state().recording;
+}
+
+bool is_replaying()
+{
+    return state().replaying;
+}
+
+void start_recording()
+{
+    stop_replay();
+    journal_state &s = state();
+    s.recorded = journal();
+    // Zero would leave the engine as it is.
+    s.recorded.seed = std::max( 1U, rng_bits() );
+    rng_set_engine_seed( s.recorded.seed );
+    s.recording = true;
+}
+
+journal stop_recording()
+{
+    journal_state &s = state();
+    s.recording = false;
+    return std::move( s.recorded );
+}
+
+void record( const input_event &event, const std::string &context, const std::string &action )
+{
+    journal_state &s = state();
+    if( !s.recording ) {
+        return;
+    }
+    entry e;
+    e.turn = to_turns<int64_t>( calendar::turn - calendar::turn_zero );
+    e.context = context;
+    e.action = action;
+    e.event = event;
+    s.recorded.entries.push_back( std::move( e ) );
+}
+
+void start_replay( const journal &j )
+{
+    journal_state &s = state();
+    s.recording = false;
+    s.replayed = j;
+    s.next_entry = 0;
+    s.replaying = !j.entries.empty();
+    if( s.replaying ) {
+        rng_set_engine_seed( j.seed );
+        turn_profiler::set_enabled( true );
+    }
+}
+
+void stop_replay()
+{
+    journal_state &s = state();
+    if( !s.replaying ) {
+        return;
+    }
+    s.replaying = false;
+    s.replayed = journal();
+    turn_profiler::set_enabled( false );
+}
+
+std::optional<input_event> next_replayed_event()
+{
+    journal_state &s = state();
+    if( !s.replaying ) {
+        return std::nullopt;
+    }
+    if( s.next_entry >= s.replayed.entries.size() ) {
+        // The turn of the last event has been played out.
+        stop_replay();
+        return std::nullopt;
+    }
+    return s.replayed.entries[s.next_entry++].event;
+}
+
+} // namespace input_journal
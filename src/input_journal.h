@@ -0,0 +1,78 @@
+#pragma once
+#ifndef CATA_SRC_INPUT_JOURNAL_H
+#define CATA_SRC_INPUT_JOURNAL_H
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "input_enums.h"
+
+class JsonObject;
+class JsonOut;
+class cata_path;
+
+/**
+ * Recording of the input the game acts on, so that a report of slow turns can be turned
+ * into something that can be run again.
+ *
+ * While recording, every event @ref input_context::handle_input reads is kept along with
+ * the turn it was read on, the input context and the action it was mapped to.  Recording
+ * starts by reseeding the rng with a fresh seed, which is stored in the journal.
+ *
+ * Replaying, started from the save the recording was started from, reseeds the rng the
+ * same way and hands the events back to @ref input_context::handle_input instead of
+ * reading the keyboard, so it also works without a frontend.  The turn profiler records
+ * while the replay runs and is stopped, keeping its turns, after the last event.
+ *
+ * Input read directly from @ref input_manager, outside of an input context, is neither
+ * recorded nor replayed.
+ */
+namespace input_journal
+{
+
+struct entry {
+    /** Value of calendar::turn when the event was read, in turns since the Cataclysm. */
+    int64_t turn = 0;
+    /** Category of the input context that read the event. */
+    std::string context;
+    /** The action the event was mapped to, "ERROR" if none. */
+    std::string action;
+    input_event event;
+};
+
+struct journal {
+    unsigned int seed = 0;
+    std::vector<entry> entries;
+
+    void serialize( JsonOut &jsout ) const;
+    void deserialize( const JsonObject &jo );
+};
+
+bool write_journal( const journal &j, const cata_path &path );
+/** None if the file can't be read. */
+std::optional<journal> read_journal( const cata_path &path );
+
+bool is_recording();
+bool is_replaying();
+
+/** Reseeds the rng and starts an empty journal.  Stops a replay. */
+void start_recording();
+/** The journal recorded since @ref start_recording. */
+journal stop_recording();
+/** Adds an event to the journal, if recording. */
+void record( const input_event &event, const std::string &context, const std::string &action );
+
+/** Reseeds the rng with the seed of @p j, starts the turn profiler and queues the events. */
+void start_replay( const journal &j );
+void stop_replay();
+/**
+ * The next queued event, none if not replaying.  Asking for more events than the journal
+ * has stops the replay, after the turn of the last one has been played.
+ */
+std::optional<input_event> next_replayed_event();
+
+} // namespace input_journal
+
+#endif // CATA_SRC_INPUT_JOURNAL_H
@@ -4,9 +4,11 @@
 
 #include <bitset>
 #include <functional>
+#include <optional>
 #include <string>
 #include <type_traits>
 #include <unordered_set>
+#include <vector>
 
 template<typename T>
 class string_id;
@@ -168,6 +170,58 @@ class int_id_set
         std::unordered_set<int_id<T>> slow_set_;
 };
 
+// Map from sequential int IDs to values, stored in a vector indexed by the ID instead of a tree or
+// a hash table. Same restrictions on the IDs as int_id_set. It grows as needed, but tables that are
+// filled once should be sized up front with reserve( T::count() ) after the IDs are final.
+template <typename T, typename V>
+class int_id_map
+{
+    public:
+        void reserve( std::size_t count ) {
+            if( values_.size() < count ) {
+                values_.resize( count );
+            }
+        }
+
+        // Default constructs the value if there is none for the ID yet, like std::map.
+        V &operator[]( int_id<T> id ) {
+            const std::size_t i = static_cast<std::size_t>( id.to_i() );
+            reserve( i + 1 );
+            if( !values_[i] ) {
+                values_[i].emplace();
+            }
+            return *values_[i];
+        }
+
+        // Returns nullptr if there is no value for the ID.
+        const V *find( int_id<T> id ) const {
+            const std::size_t i = static_cast<std::size_t>( id.to_i() );
+            return i < values_.size() && values_[i] ? &*values_[i] : nullptr;
+        }
+        V *find( int_id<T> id ) {
+            const std::size_t i = static_cast<std::size_t>( id.to_i() );
+            return i < values_.size() && values_[i] ? &*values_[i] : nullptr;
+        }
+
+        bool contains( int_id<T> id ) const {
+            return find( id ) != nullptr;
+        }
+
+        void erase( int_id<T> id ) {
+            const std::size_t i = static_cast<std::size_t>( id.to_i() );
+            if( i < values_.size() ) {
+                values_[i].reset();
+            }
+        }
+
+        void clear() {
+            values_.clear();
+        }
+
+    private:
+        std::vector<std::optional<V>> values_;
+};
+
 // Support hashing of int based ids by forwarding the hash of the int.
 template<typename T>
 // NOLINTNEXTLINE(cert-dcl58-cpp)
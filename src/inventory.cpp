@@ -254,6 +254,7 @@ void inventory::clear()
     max_empty_liq_cont.clear();
     binned = false;
     qualities_cache.clear();
+    stack_index.invalidate();
 }
 
 void inventory::push_back( const std::list<item> &newits )
@@ -303,28 +304,48 @@ item &inventory::add_item( item newit, bool keep_invlet, bool assign_invlet, boo
     binned = false;
 
     Character &player_character = get_player_character();
+    // Tries to add newit to the stack, returns nullptr if it does not stack with it.
+    const auto try_stack = [&]( std::list<item> &elem ) -> item * {
+        std::list<item>::iterator it_ref = elem.begin();
+        if( it_ref->stacks_with( newit ) ) {
+            if( it_ref->merge_charges( newit ) ) {
+                return &*it_ref;
+            }
+            if( it_ref->invlet == '\0' ) {
+                if( !keep_invlet ) {
+                    update_invlet( newit, assign_invlet );
+                }
+                update_cache_with_item( newit );
+                it_ref->invlet = newit.invlet;
+            } else {
+                newit.invlet = it_ref->invlet;
+            }
+            elem.emplace_back( std::move( newit ) );
+            return &elem.back();
+        } else if( keep_invlet && assign_invlet && it_ref->invlet == newit.invlet ) {
+            // If keep_invlet is true, we'll be forcing other items out of their current invlet.
+            assign_empty_invlet( *it_ref, player_character );
+        }
+        return nullptr;
+    };
     if( should_stack ) {
         // See if we can't stack this item.
-        for( auto &elem : items ) {
-            std::list<item>::iterator it_ref = elem.begin();
-            if( it_ref->stacks_with( newit ) ) {
-                if( it_ref->merge_charges( newit ) ) {
-                    return *it_ref;
-                }
-                if( it_ref->invlet == '\0' ) {
-                    if( !keep_invlet ) {
-                        update_invlet( newit, assign_invlet );
+        // Forcing an invlet has to look at every stack, otherwise only those of the same type
+        // can take the item.
+        if( stack_index.valid && !( keep_invlet && assign_invlet ) ) {
+            const auto same_type = stack_index.stacks.find( newit.typeId() );
+            if( same_type != stack_index.stacks.end() ) {
+                for( std::list<item> *elem : same_type->second ) {
+                    if( item *stacked = try_stack( *elem ) ) {
+                        return *stacked;
                     }
-                    update_cache_with_item( newit );
-                    it_ref->invlet = newit.invlet;
-                } else {
-                    newit.invlet = it_ref->invlet;
                 }
-                elem.emplace_back( std::move( newit ) );
-                return elem.back();
-            } else if( keep_invlet && assign_invlet && it_ref->invlet == newit.invlet ) {
-                // If keep_invlet is true, we'll be forcing other items out of their current invlet.
-                assign_empty_invlet( *it_ref, player_character );
+            }
+        } else {
+            for( auto &elem : items ) {
+                if( item *stacked = try_stack( elem ) ) {
+                    return *stacked;
+                }
             }
         }
     }
@@ -336,6 +357,9 @@ item &inventory::add_item( item newit, bool keep_invlet, bool assign_invlet, boo
     update_cache_with_item( newit );
 
     items.emplace_back( std::list<item> { std::move( newit ) } );
+    if( stack_index.valid ) {
+        stack_index.stacks[items.back().front().typeId()].push_back( &items.back() );
+    }
     return items.back().back();
 }
 
@@ -394,6 +418,7 @@ void inventory::restack( Character &p )
     // 3. combine matching stacks
 
     binned = false;
+    stack_index.invalidate();
     std::list<item> to_restack;
     int idx = 0;
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter, ++idx ) {
@@ -522,6 +547,8 @@ void inventory::form_from_map( map &m, std::vector<tripoint> pts, const Characte
 {
     items.clear();
     provisioned_pseudo_tools.clear();
+    stack_index.invalidate();
+    stack_index.valid = true;
 
     for( const tripoint &p : pts ) {
         const ter_id &t = m.ter( p );
@@ -610,6 +637,7 @@ std::list<item> inventory::reduce_stack( const int position, const int quantity
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            stack_index.invalidate();
             if( quantity >= static_cast<int>( iter->size() ) || quantity < 0 ) {
                 ret = *iter;
                 items.erase( iter );
@@ -644,6 +672,7 @@ item inventory::remove_item( const int position )
     for( invstack::iterator iter = items.begin(); iter != items.end(); ++iter ) {
         if( position == pos ) {
             binned = false;
+            stack_index.invalidate();
             if( iter->size() > 1 ) {
                 std::list<item>::iterator stack_member = iter->begin();
                 char invlet = stack_member->invlet;
@@ -689,6 +718,7 @@ std::list<item> inventory::remove_randomly_by_volume( const units::volume &volum
         }
         if( chosen_stack->empty() ) {
             binned = false;
+            stack_index.invalidate();
             items.erase( chosen_stack );
         }
     }
@@ -785,6 +815,7 @@ std::list<item> inventory::use_amount( const itype_id &it, int quantity,
         }
         if( iter->empty() ) {
             binned = false;
+            stack_index.invalidate();
             iter = items.erase( iter );
         } else if( iter != items.end() ) {
             ++iter;
@@ -992,12 +1023,12 @@ enchant_cache inventory::get_active_enchantment_cache( const Character &owner )
 int inventory::count_item( const itype_id &item_type ) const
 {
     int num = 0;
-    const itype_bin bin = get_binned_items();
-    if( bin.find( item_type ) == bin.end() ) {
+    const itype_bin &bin = get_binned_items();
+    const auto iter = bin.find( item_type );
+    if( iter == bin.end() ) {
         return num;
     }
-    const std::list<const item *> items = get_binned_items().find( item_type )->second;
-    for( const item *it : items ) {
+    for( const item *it : iter->second ) {
         num += it->count();
     }
     return num;
@@ -300,6 +300,38 @@ class inventory : public visitable
         mutable itype_bin binned_items;
 
         mutable std::map<quality_query, bool> qualities_cache;
+
+        /**
+         * Stacks grouped by the type of their items, so that adding an item only has to try
+         * the stacks it can possibly join instead of every stack in the inventory.
+         * Only kept while the inventory is being formed from the map (and for items added
+         * right after), as those inventories reach thousands of items. Anything that may erase
+         * a stack drops it; copies start without it because the pointers belong to the source.
+         */
+        struct stack_index_t {
+            std::unordered_map<itype_id, std::vector<std::list<item> *>> stacks;
+            bool valid = false;
+
+            stack_index_t() = default;
+            stack_index_t( const stack_index_t & ) {}
+            stack_index_t( stack_index_t &&other ) noexcept {
+                other.invalidate();
+            }
+            stack_index_t &operator=( const stack_index_t & ) {
+                invalidate();
+                return *this;
+            }
+            stack_index_t &operator=( stack_index_t &&other ) noexcept {
+                invalidate();
+                other.invalidate();
+                return *this;
+            }
+            void invalidate() {
+                stacks.clear();
+                valid = false;
+            }
+        };
+        stack_index_t stack_index;
 };
 
 #endif // CATA_SRC_INVENTORY_H
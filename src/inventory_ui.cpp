@@ -15,6 +15,7 @@
 #include "enums.h"
 #include "flag.h"
 #include "game_inventory.h"
+#include "hash_utils.h"
 #include "inventory.h"
 #include "input.h"
 #include "item.h"
@@ -1288,19 +1289,58 @@ void inventory_column::on_change( const inventory_entry &/* entry */ )
     // stub
 }
 
+size_t inventory_column::stacking_key( const inventory_entry &entry )
+{
+    size_t key = std::hash<const item_category *>()( entry.get_category_ptr() );
+    if( !entry.is_item() ) {
+        return key;
+    }
+    const item_location &loc = entry.locations.front();
+    const item_location parent = loc.parent_item();
+    cata::hash_combine( key, static_cast<int>( loc.where() ) );
+    cata::hash_combine( key, loc.position() );
+    cata::hash_combine( key, parent.get_item() );
+    cata::hash_combine( key, loc->typeId() );
+    cata::hash_combine( key, loc->is_collapsed() );
+    cata::hash_combine( key, loc->link_length() );
+    cata::hash_combine( key, loc->max_link_length() );
+    return key;
+}
+
+void inventory_column::update_index( stacking_index &index, const entries_t &dest )
+{
+    if( index.data == dest.data() && index.size == dest.size() ) {
+        return;
+    }
+    index.buckets.clear();
+    for( size_t i = 0; i < dest.size(); ++i ) {
+        index.buckets[stacking_key( dest[i] )].push_back( i );
+    }
+    index.data = dest.data();
+    index.size = dest.size();
+}
+
 inventory_entry *inventory_column::add_entry( const inventory_entry &entry )
 {
-    entries_t &dest = entry.is_hidden( hide_entries_override ) ? entries_hidden : entries;
-    if( auto it = std::find( dest.begin(), dest.end(), entry ); it != dest.end() ) {
-        debugmsg( "Tried to add a duplicate entry." );
-        return &*it;
+    const bool hidden = entry.is_hidden( hide_entries_override );
+    entries_t &dest = hidden ? entries_hidden : entries;
+    stacking_index &index = hidden ? entries_hidden_index : entries_index;
+    update_index( index, dest );
+    std::vector<size_t> &candidates = index.buckets[stacking_key( entry )];
+
+    for( const size_t i : candidates ) {
+        if( dest[i] == entry ) {
+            debugmsg( "Tried to add a duplicate entry." );
+            return &dest[i];
+        }
     }
     paging_is_valid = false;
     if( entry.is_item() ) {
         item_location entry_item = entry.locations.front();
 
-        auto entry_with_loc = std::find_if( dest.begin(),
-        dest.end(), [&entry, &entry_item, this]( const inventory_entry & e ) {
+        auto entry_with_loc = std::find_if( candidates.begin(),
+        candidates.end(), [&entry, &entry_item, &dest, this]( const size_t i ) {
+            const inventory_entry &e = dest[i];
             if( !e.is_item() ) {
                 return false;
             }
@@ -1315,16 +1355,19 @@ inventory_entry *inventory_column::add_entry( const inventory_entry &entry )
                    entry_item->max_link_length() == found_entry_item->max_link_length() &&
                    entry_item->display_stacked_with( *found_entry_item, preset.get_checking_components() );
         } );
-        if( entry_with_loc != dest.end() ) {
-            std::vector<item_location> &locations = entry_with_loc->locations;
+        if( entry_with_loc != candidates.end() ) {
+            std::vector<item_location> &locations = dest[*entry_with_loc].locations;
             std::move( entry.locations.begin(), entry.locations.end(), std::back_inserter( locations ) );
-            return &*entry_with_loc;
+            return &dest[*entry_with_loc];
         }
     }
 
+    candidates.push_back( dest.size() );
     dest.emplace_back( entry );
     inventory_entry &newent = dest.back();
     newent.update_cache();
+    index.data = dest.data();
+    index.size = dest.size();
 
     return &newent;
 }
@@ -1506,7 +1549,8 @@ void inventory_column::prepare_paging( const std::string &filter )
     // remove entries hidden by SHOW_HIDE_CONTENTS
     move_if( entries, entries_hidden, is_not_visible );
 
-    // Then sort them with respect to categories
+    // Then sort them with respect to categories, which the stacking index doesn't follow
+    entries_index = {};
     std::stable_sort( entries.begin(), entries.end(),
     [this]( const inventory_entry & lhs, const inventory_entry & rhs ) {
         if( *lhs.get_category_ptr() == *rhs.get_category_ptr() ) {
@@ -1563,6 +1607,8 @@ void inventory_column::clear()
 {
     entries.clear();
     entries_hidden.clear();
+    entries_index = {};
+    entries_hidden_index = {};
     paging_is_valid = false;
 }
 
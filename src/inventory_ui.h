@@ -11,6 +11,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -558,6 +559,22 @@ class inventory_column
 
         std::vector<cell_t> cells;
 
+        /**
+         * Positions in @ref entries or @ref entries_hidden by stacking_key(), so add_entry()
+         * compares a new entry only with those it may stack with.  It is rebuilt whenever the
+         * vector was changed by anything other than add_entry().
+         */
+        struct stacking_index {
+            std::unordered_map<size_t, std::vector<size_t>> buckets;
+            const inventory_entry *data = nullptr;
+            size_t size = 0;
+        };
+        stacking_index entries_index;
+        stacking_index entries_hidden_index;
+        /** Equal for entries that are duplicates or may be shown stacked by add_entry(). */
+        static size_t stacking_key( const inventory_entry &entry );
+        static void update_index( stacking_index &index, const entries_t &dest );
+
         std::optional<bool> indent_entries_override = std::nullopt;
         /** @return Number of visible cells */
         size_t visible_cells() const;
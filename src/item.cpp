@@ -262,8 +262,9 @@ item &null_item_reference()
 
 namespace item_internal
 {
-static bool goes_bad_temp_cache = false;
-static const item *goes_bad_temp_cache_for = nullptr;
+// Per thread, items may be processed on several.
+static thread_local bool goes_bad_temp_cache = false;
+static thread_local const item *goes_bad_temp_cache_for = nullptr;
 static bool goes_bad_cache_fetch()
 {
     return goes_bad_temp_cache;
@@ -309,7 +310,7 @@ item::item( const itype *type, time_point turn, int qty ) : type( type ), bday(
     if( type->countdown_interval > 0_seconds ) {
         countdown_point = calendar::turn + type->countdown_interval;
     }
-    item_vars = type->item_variables;
+    item_vars = item_var_map( type->item_variables );
 
     update_prefix_suffix_flags();
     if( has_flag( flag_CORPSE ) ) {
@@ -678,6 +679,7 @@ item &item::convert( const itype_id &new_type, Character *carrier )
     item_counter = 0;
     update_link_traits();
     update_prefix_suffix_flags();
+    invalidate_name_cache();
     return *this;
 }
 
@@ -924,6 +926,7 @@ float item::damage_adjusted_armor_resist( float value ) const
 void item::set_damage( int qty )
 {
     damage_ = std::clamp( qty, degradation_, max_damage() );
+    invalidate_name_cache();
 }
 
 void item::set_degradation( int qty )
@@ -1831,41 +1834,40 @@ void item::force_insert_item( const item &it, pocket_type pk_type )
 
 void item::set_var( const std::string &name, const int value )
 {
-    std::ostringstream tmpstream;
-    tmpstream.imbue( std::locale::classic() );
-    tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    item_vars.set( name, item_var_value( static_cast<long long>( value ) ) );
+    invalidate_name_cache();
 }
 
 void item::set_var( const std::string &name, const long long value )
 {
-    std::ostringstream tmpstream;
-    tmpstream.imbue( std::locale::classic() );
-    tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    item_vars.set( name, item_var_value( value ) );
+    invalidate_name_cache();
 }
 
 // NOLINTNEXTLINE(cata-no-long)
 void item::set_var( const std::string &name, const long value )
 {
-    std::ostringstream tmpstream;
-    tmpstream.imbue( std::locale::classic() );
-    tmpstream << value;
-    item_vars[name] = tmpstream.str();
+    item_vars.set( name, item_var_value( static_cast<long long>( value ) ) );
+    invalidate_name_cache();
 }
 
 void item::set_var( const std::string &name, const double value )
 {
-    item_vars[name] = string_format( "%f", value );
+    item_vars.set( name, item_var_value::from_double( value ) );
+    invalidate_name_cache();
 }
 
 double item::get_var( const std::string &name, const double default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
+    const item_var_value *var = item_vars.get( name );
+    if( var == nullptr ) {
         return default_value;
     }
-    const std::string &val = it->second;
+    if( const std::optional<double> number = var->as_number() ) {
+        return *number;
+    }
+    // Anything not written by set_var, e.g. legacy values with a localized fraction separator.
+    const std::string val = var->str();
     char *end;
     errno = 0;
     double result = strtod( val.data(), &end );
@@ -1898,16 +1900,20 @@ double item::get_var( const std::string &name, const double default_value ) cons
 
 void item::set_var( const std::string &name, const tripoint &value )
 {
-    item_vars[name] = string_format( "%d,%d,%d", value.x, value.y, value.z );
+    item_vars.set( name, item_var_value( value ) );
+    invalidate_name_cache();
 }
 
 tripoint item::get_var( const std::string &name, const tripoint &default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
+    const item_var_value *var = item_vars.get( name );
+    if( var == nullptr ) {
         return default_value;
     }
-    std::vector<std::string> values = string_split( it->second, ',' );
+    if( const std::optional<tripoint> p = var->as_tripoint() ) {
+        return *p;
+    }
+    std::vector<std::string> values = string_split( var->str(), ',' );
     cata_assert( values.size() == 3 );
     auto convert_or_error = []( const std::string_view s ) {
         ret_val<int> result = try_parse_integer<int>( s, false );
@@ -1925,16 +1931,14 @@ tripoint item::get_var( const std::string &name, const tripoint &default_value )
 
 void item::set_var( const std::string &name, const std::string &value )
 {
-    item_vars[name] = value;
+    item_vars.set( name, item_var_value::from_text( value ) );
+    invalidate_name_cache();
 }
 
 std::string item::get_var( const std::string &name, const std::string &default_value ) const
 {
-    const auto it = item_vars.find( name );
-    if( it == item_vars.end() ) {
-        return default_value;
-    }
-    return it->second;
+    const item_var_value *var = item_vars.get( name );
+    return var == nullptr ? default_value : var->str();
 }
 
 std::string item::get_var( const std::string &name ) const
@@ -1944,8 +1948,8 @@ std::string item::get_var( const std::string &name ) const
 
 std::optional<std::string> item::maybe_get_var( const std::string &name ) const
 {
-    const auto it = item_vars.find( name );
-    return it == item_vars.end() ? std::nullopt : std::optional<std::string> { it->second };
+    const item_var_value *var = item_vars.get( name );
+    return var == nullptr ? std::nullopt : std::optional<std::string> { var->str() };
 }
 
 bool item::has_var( const std::string &name ) const
@@ -1956,11 +1960,13 @@ bool item::has_var( const std::string &name ) const
 void item::erase_var( const std::string &name )
 {
     item_vars.erase( name );
+    invalidate_name_cache();
 }
 
 void item::clear_vars()
 {
     item_vars.clear();
+    invalidate_name_cache();
 }
 
 // TODO: Get rid of, handle multiple types gracefully
@@ -2195,6 +2201,7 @@ std::string item::get_owner_name() const
 void item::set_owner( const faction_id &new_owner )
 {
     owner = new_owner;
+    invalidate_name_cache();
     for( item *e : contents.all_items_top() ) {
         e->set_owner( new_owner );
     }
@@ -2447,8 +2454,7 @@ void item::basic_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
 
     if( parts->test( iteminfo_parts::DESCRIPTION ) ) {
         insert_separation_line( info );
-        const std::map<std::string, std::string>::const_iterator idescription =
-            item_vars.find( "description" );
+        const item_var_value *idescription = item_vars.get( "description" );
         const std::optional<translation> snippet = SNIPPET.get_snippet_by_id( snip_id );
         if( snippet.has_value() ) {
             // Just use the dynamic description
@@ -2467,8 +2473,8 @@ void item::basic_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
                 //note that you have seen the snippet
                 get_avatar().add_snippet( snip_id );
             }
-        } else if( idescription != item_vars.end() ) {
-            info.emplace_back( "DESCRIPTION", idescription->second );
+        } else if( idescription != nullptr ) {
+            info.emplace_back( "DESCRIPTION", idescription->str() );
         } else if( has_itype_variant() ) {
             info.emplace_back( "DESCRIPTION", variant_description() );
         } else {
@@ -2575,8 +2581,8 @@ void item::debug_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
             info.emplace_back( "BASE", string_format( _( "flags: %s" ), flags_listed ) );
             for( auto const &imap : item_vars ) {
                 info.emplace_back( "BASE",
-                                   string_format( _( "item var: %s, %s" ), imap.first,
-                                                  imap.second ) );
+                                   string_format( _( "item var: %s, %s" ), imap.first.str(),
+                                                  imap.second.str() ) );
             }
 
             info.emplace_back( "BASE", _( "wetness: " ),
@@ -5992,27 +5998,26 @@ void item::final_info( std::vector<iteminfo> &info, const iteminfo_query *parts,
         }
     }
 
-    std::map<std::string, std::string>::const_iterator item_note = item_vars.find( "item_note" );
+    const item_var_value *item_note = item_vars.get( "item_note" );
 
-    if( item_note != item_vars.end() && parts->test( iteminfo_parts::DESCRIPTION_NOTES ) ) {
+    if( item_note != nullptr && parts->test( iteminfo_parts::DESCRIPTION_NOTES ) ) {
         insert_separation_line( info );
         std::string ntext;
-        std::map<std::string, std::string>::const_iterator item_note_tool =
-            item_vars.find( "item_note_tool" );
+        const item_var_value *item_note_tool = item_vars.get( "item_note_tool" );
         const use_function *use_func =
-            item_note_tool != item_vars.end() ?
+            item_note_tool != nullptr ?
             item_controller->find_template(
-                itype_id( item_note_tool->second ) )->get_use( "inscribe" ) :
+                itype_id( item_note_tool->str() ) )->get_use( "inscribe" ) :
             nullptr;
         const inscribe_actor *use_actor =
             use_func ? dynamic_cast<const inscribe_actor *>( use_func->get_actor_ptr() ) : nullptr;
         if( use_actor ) {
             //~ %1$s: gerund (e.g. carved), %2$s: item name, %3$s: inscription text
             ntext = string_format( pgettext( "carving", "%1$s on the %2$s is: %3$s" ),
-                                   use_actor->gerund, tname(), item_note->second );
+                                   use_actor->gerund, tname(), item_note->str() );
         } else {
             //~ %1$s: inscription text
-            ntext = string_format( pgettext( "carving", "Note: %1$s" ), item_note->second );
+            ntext = string_format( pgettext( "carving", "Note: %1$s" ), item_note->str() );
         }
         info.emplace_back( "DESCRIPTION", ntext );
     }
@@ -6736,9 +6741,16 @@ void item::update_inherited_flags()
             }
         }
     }
+    update_flag_bits();
     update_prefix_suffix_flags();
 }
 
+void item::update_flag_bits()
+{
+    flag_bits = json_flag::to_bits( item_tags );
+    flag_bits.set_union( json_flag::to_bits( inherited_tags_cache ) );
+}
+
 void item::update_prefix_suffix_flags()
 {
     prefix_tags_cache.clear();
@@ -6770,6 +6782,7 @@ void item::on_contents_changed()
     encumbrance_update_ = true;
     update_inherited_flags();
     cached_category.timestamp = calendar::turn_max;
+    invalidate_name_cache();
     if( empty_container() ) {
         clear_automatic_whitelist();
     }
@@ -6855,8 +6868,26 @@ std::string item::tname( unsigned int quantity, bool with_prefix ) const
     return tname( quantity, with_prefix ? tname::default_tname : tname::unprefixed_tname );
 }
 
+void item::invalidate_name_cache()
+{
+    cached_name.timestamp = calendar::turn_max;
+}
+
 std::string item::tname( unsigned int quantity, tname::segment_bitset const &segments ) const
 {
+    const int language_version = detail::get_current_language_version();
+    const name_cache &cache = cached_name;
+    // The distance to the spawn location depends on where the avatar is.
+    const bool cacheable = !segments[tname::segments::LOCATION_HINT] ||
+                           !has_var( "spawn_location_omt" );
+    if( cacheable && cache.timestamp == calendar::turn && cache.segments == segments &&
+        cache.quantity == quantity && cache.language_version == language_version &&
+        cache.type == type && cache.faults == ( *faults ).size() && cache.charges == charges &&
+        cache.burnt == burnt && cache.wetness == wetness && cache.active == active &&
+        cache.is_favorite == is_favorite && cache.ethereal == ethereal ) {
+        return cache.name;
+    }
+
     std::string ret;
 
     for( size_t i = 0; i < static_cast<size_t>( tname::segments::last_segment ); i++ ) {
@@ -6869,9 +6900,14 @@ std::string item::tname( unsigned int quantity, tname::segment_bitset const &seg
 
     if( item_vars.find( "item_note" ) != item_vars.end() ) {
         //~ %s is an item name. This style is used to denote items with notes.
-        return string_format( _( "*%s*" ), ret );
+        ret = string_format( _( "*%s*" ), ret );
     }
 
+    if( cacheable ) {
+        cached_name = { ret, segments, quantity, language_version, type, ( *faults ).size(),
+                        charges, burnt, wetness, active, is_favorite, ethereal, calendar::turn
+                      };
+    }
     return ret;
 }
 
@@ -7598,7 +7634,9 @@ int item::current_reach_range( const Character &guy ) const
 void item::unset_flags()
 {
     item_tags.clear();
+    update_flag_bits();
     requires_tags_processing = true;
+    invalidate_name_cache();
 }
 
 bool item::has_fault( const fault_id &fault ) const
@@ -7629,19 +7667,14 @@ bool item::has_flag( const flag_id &f ) const
         return false;
     }
 
-    ret = inherited_tags_cache.find( f ) != inherited_tags_cache.end();
+    // item specific and inherited flags
+    ret = json_flag::test_bit( flag_bits, f );
     if( ret ) {
         return ret;
     }
 
     // other item type flags
     ret = type->has_flag( f );
-    if( ret ) {
-        return ret;
-    }
-
-    // now check for item specific flags
-    ret = has_own_flag( f );
     return ret;
 }
 
@@ -7649,8 +7682,14 @@ item &item::set_flag( const flag_id &flag )
 {
     if( flag.is_valid() ) {
         item_tags.insert( flag );
+        const size_t index = static_cast<size_t>( json_flag::index_of( flag ) );
+        if( index >= flag_bits.size() ) {
+            flag_bits.resize( index + 1 );
+        }
+        flag_bits.set( index );
         update_prefix_suffix_flags( flag );
         requires_tags_processing = true;
+        invalidate_name_cache();
     } else {
         debugmsg( "Attempted to set invalid flag_id %s", flag.str() );
     }
@@ -7678,14 +7717,17 @@ bool item::has_vitamin( const vitamin_id &v ) const
 item &item::set_fault( const fault_id &fault_id )
 {
     faults.insert( fault_id );
+    invalidate_name_cache();
     return *this;
 }
 
 item &item::unset_flag( const flag_id &flag )
 {
     item_tags.erase( flag );
+    update_flag_bits();
     update_prefix_suffix_flags();
     requires_tags_processing = true;
+    invalidate_name_cache();
     return *this;
 }
 
@@ -7803,6 +7845,7 @@ bool item::has_technique( const matec_id &tech ) const
 void item::add_technique( const matec_id &tech )
 {
     techniques.insert( tech );
+    invalidate_name_cache();
 }
 
 std::vector<item *> item::toolmods()
@@ -7907,12 +7950,14 @@ void item::set_relative_rot( double val )
         if( !has_flag( flag_PROCESSING_RESULT ) ) {
             last_temp_check = calendar::turn;
         }
+        invalidate_name_cache();
     }
 }
 
 void item::set_rot( time_duration val )
 {
     rot = val;
+    invalidate_name_cache();
 }
 
 void item::randomize_rot()
@@ -8017,7 +8062,16 @@ void item::calc_rot( units::temperature temp, const float spoil_modifier,
         return;
     }
 
-    // rot modifier
+    if( has_own_flag( flag_COLD ) ) {
+        temp = std::min( temperatures::fridge, temp );
+    }
+
+    rot += rot_factor( spoil_modifier ) * time_delta / 1_seconds * calc_hourly_rotpoints_at_temp(
+               temp ) * 1_turns / ( 1_hours / 1_seconds );
+}
+
+float item::rot_factor( const float spoil_modifier ) const
+{
     float factor = spoil_modifier;
     if( is_corpse() && has_flag( flag_FIELD_DRESS ) ) {
         factor *= 0.75;
@@ -8034,13 +8088,7 @@ void item::calc_rot( units::temperature temp, const float spoil_modifier,
     if( has_own_flag( flag_IRRADIATED ) ) {
         factor *= 0.25;
     }
-
-    if( has_own_flag( flag_COLD ) ) {
-        temp = std::min( temperatures::fridge, temp );
-    }
-
-    rot += factor * time_delta / 1_seconds * calc_hourly_rotpoints_at_temp( temp ) * 1_turns /
-           ( 1_hours / 1_seconds );
+    return factor;
 }
 
 void item::calc_rot_while_processing( time_duration processing_duration )
@@ -9480,6 +9528,7 @@ void item::set_itype_variant( const std::string &variant )
     for( const itype_variant_data &option : type->variants ) {
         if( option.id == variant ) {
             _itype_variant = &option;
+            invalidate_name_cache();
             if( option.expand_snippets ) {
                 set_var( "description", SNIPPET.expand( variant_description() ) );
             }
@@ -9508,6 +9557,7 @@ std::string item::variant_description() const
 void item::clear_itype_variant()
 {
     _itype_variant = nullptr;
+    invalidate_name_cache();
 }
 
 bool item::is_firearm() const
@@ -9681,6 +9731,7 @@ void item::set_mtype( const mtype *const m )
         return;
     }
     corpse = m;
+    invalidate_name_cache();
 }
 
 bool item::is_ammo_container() const
@@ -12627,6 +12678,7 @@ void item::set_snippet( const snippet_id &id )
         return;
     }
     snip_id = id;
+    invalidate_name_cache();
 }
 
 const item_category &item::get_category_shallow() const
@@ -12796,26 +12848,27 @@ bool item_compare_by_charges( const item &left, const item &right )
 static const std::string USED_BY_IDS( "USED_BY_IDS" );
 bool item::already_used_by_player( const Character &p ) const
 {
-    const auto it = item_vars.find( USED_BY_IDS );
-    if( it == item_vars.end() ) {
+    const item_var_value *used_by_ids = item_vars.get( USED_BY_IDS );
+    if( used_by_ids == nullptr ) {
         return false;
     }
     // USED_BY_IDS always starts *and* ends with a ';', the search string
     // ';<id>;' matches at most one part of USED_BY_IDS, and only when exactly that
     // id has been added.
     const std::string needle = string_format( ";%d;", p.getID().get_value() );
-    return it->second.find( needle ) != std::string::npos;
+    return used_by_ids->str().find( needle ) != std::string::npos;
 }
 
 void item::mark_as_used_by_player( const Character &p )
 {
-    std::string &used_by_ids = item_vars[ USED_BY_IDS ];
+    std::string used_by_ids = get_var( USED_BY_IDS );
     if( used_by_ids.empty() ) {
         // *always* start with a ';'
         used_by_ids = ";";
     }
     // and always end with a ';'
     used_by_ids += string_format( "%d;", p.getID().get_value() );
+    item_vars.set( USED_BY_IDS, item_var_value::from_text( std::move( used_by_ids ) ) );
 }
 
 bool item::can_holster( const item &obj, bool ) const
@@ -12885,7 +12938,8 @@ int item::processing_speed() const
 
     if( active || ethereal || wetness || has_link_data() ||
         has_flag( flag_RADIO_ACTIVATION ) || has_relic_recharge() ||
-        has_fault_flag( flag_BLACKPOWDER_FOULING_DAMAGE ) || get_var( "gun_heat", 0 ) > 0 ) {
+        has_fault_flag( flag_BLACKPOWDER_FOULING_DAMAGE ) ||
+        ( is_gun() && get_var( "gun_heat", 0 ) > 0 ) ) {
         // Unless otherwise indicated, update every turn.
         return 1;
     }
@@ -12893,6 +12947,18 @@ int item::processing_speed() const
     return item::NO_PROCESSING;
 }
 
+std::optional<time_point> item::idle_until() const
+{
+    // Everything process_internal could do for an active item before its countdown is up.
+    if( !active || countdown_point == calendar::turn_max || countdown_point <= calendar::turn ||
+        ethereal || wetness || has_link_data() || is_relic() || requires_tags_processing ||
+        ( !is_food() && item_counter > 0 ) || !type->emits.empty() || is_tool() ||
+        has_temperature() ) {
+        return std::nullopt;
+    }
+    return countdown_point;
+}
+
 void item::apply_freezerburn()
 {
     if( !has_flag( flag_FREEZERBURN ) ) {
@@ -12901,8 +12967,77 @@ void item::apply_freezerburn()
     set_flag( flag_MUSHY );
 }
 
+// The temperature an item lying where it is @p temp sees, in storage of type @p flag.
+static units::temperature flagged_temperature( const units::temperature &temp,
+        const temperature_flag flag )
+{
+    switch( flag ) {
+        case temperature_flag::NORMAL:
+            // Just use the temperature normally
+            return temp;
+        case temperature_flag::FRIDGE:
+            return std::min( temp, temperatures::fridge );
+        case temperature_flag::FREEZER:
+            return std::min( temp, temperatures::freezer );
+        case temperature_flag::HEATER:
+            return std::max( temp, temperatures::normal );
+        case temperature_flag::ROOT_CELLAR:
+            return AVERAGE_ANNUAL_TEMPERATURE;
+        default:
+            debugmsg( "Temperature flag enum not valid.  Using current temperature." );
+    }
+    return temp;
+}
+
+// Process temperature and rot at most once every 100_turns (10 min),
+// note we're also gated by item::processing_speed
+static constexpr time_duration temperature_rot_interval = 10_minutes;
+
 bool item::process_temperature_rot( float insulation, const tripoint &pos, map &here,
                                     Character *carrier, const temperature_flag flag, float spoil_modifier, bool watertight_container )
+{
+    const time_duration since_check = calendar::turn - last_temp_check;
+    // Don't look up the temperature when there is nothing to do.
+    if( since_check >= 0_turns && since_check < temperature_rot_interval &&
+        units::to_joule_per_gram( specific_energy ) > 0 ) {
+        return false;
+    }
+    return process_temperature_rot( temperature_environment( pos, here ), insulation, pos, here,
+                                    carrier, flag, spoil_modifier, watertight_container );
+}
+
+item_temperature_environment item::temperature_environment( const tripoint &pos, map &here ) const
+{
+    item_temperature_environment env;
+    env.temperature = get_weather().get_temperature( pos );
+    if( calendar::turn - last_temp_check > 1_hours ) {
+        env.weather_gen = &get_weather().get_cur_weather_gen();
+        env.seed = g->get_seed();
+        // Toilets and vending machines will try to get the heat radiation and convection during mapgen and segfault.
+        if( !g->new_game ) {
+            env.temperature_mod = get_heat_radiation( pos );
+            env.temperature_mod += get_convection_temperature( pos );
+            env.temperature_mod += here.get_temperature_mod( pos );
+        } else {
+            env.temperature_mod = units::from_kelvin_delta( 0 );
+        }
+    }
+    return env;
+}
+
+bool item::only_changes_temperature_and_rot() const
+{
+    // What else process_internal and process_temperature_rot could do.
+    return active && has_temperature() && !is_corpse() && countdown_point == calendar::turn_max &&
+           !ethereal && !wetness && !has_link_data() && !is_relic() && !requires_tags_processing &&
+           ( is_food() || item_counter == 0 ) &&
+           type->emits.empty() && !is_tool() && !has_own_flag( flag_PROCESSING ) &&
+           !has_flag( flag_DECAYS_IN_AIR );
+}
+
+bool item::process_temperature_rot( const item_temperature_environment &env, float insulation,
+                                    const tripoint &pos, map &here, Character *carrier, const temperature_flag flag,
+                                    float spoil_modifier, bool watertight_container )
 {
     const time_point now = calendar::turn;
 
@@ -12913,34 +13048,12 @@ bool item::process_temperature_rot( float insulation, const tripoint &pos, map &
         return false;
     }
 
-    // process temperature and rot at most once every 100_turns (10 min)
-    // note we're also gated by item::processing_speed
-    time_duration smallest_interval = 10_minutes;
+    time_duration smallest_interval = temperature_rot_interval;
     if( now - last_temp_check < smallest_interval && units::to_joule_per_gram( specific_energy ) > 0 ) {
         return false;
     }
 
-    units::temperature temp = get_weather().get_temperature( pos );
-
-    switch( flag ) {
-        case temperature_flag::NORMAL:
-            // Just use the temperature normally
-            break;
-        case temperature_flag::FRIDGE:
-            temp = std::min( temp, temperatures::fridge );
-            break;
-        case temperature_flag::FREEZER:
-            temp = std::min( temp, temperatures::freezer );
-            break;
-        case temperature_flag::HEATER:
-            temp = std::max( temp, temperatures::normal );
-            break;
-        case temperature_flag::ROOT_CELLAR:
-            temp = AVERAGE_ANNUAL_TEMPERATURE;
-            break;
-        default:
-            debugmsg( "Temperature flag enum not valid.  Using current temperature." );
-    }
+    units::temperature temp = flagged_temperature( env.temperature, flag );
 
     bool carried = carrier != nullptr;
     // body heat increases inventory temperature by 5 F (2.77 K) and insulation by 50%
@@ -12957,22 +13070,13 @@ bool item::process_temperature_rot( float insulation, const tripoint &pos, map &
     int64_t max_air_exposure_hours = decays_in_air ? get_property_int64_t( "max_air_exposure_hours" ) :
                                      0;
 
-    if( now - time > 1_hours ) {
+    if( now - time > 1_hours && env.weather_gen != nullptr ) {
         // This code is for items that were left out of reality bubble for long time
 
-        const weather_generator &wgen = get_weather().get_cur_weather_gen();
-        const unsigned int seed = g->get_seed();
-
-        units::temperature_delta temp_mod;
-        // Toilets and vending machines will try to get the heat radiation and convection during mapgen and segfault.
-        if( !g->new_game ) {
-            temp_mod = get_heat_radiation( pos );
-            temp_mod += get_convection_temperature( pos );
-            temp_mod += here.get_temperature_mod( pos );
-        } else {
-            temp_mod = units::from_kelvin_delta( 0 );
-        }
+        const weather_generator &wgen = *env.weather_gen;
+        const unsigned int seed = env.seed;
 
+        units::temperature_delta temp_mod = env.temperature_mod;
         if( carried ) {
             temp_mod += units::from_fahrenheit_delta( 5 ); // body heat increases inventory temperature
         }
@@ -12991,27 +13095,7 @@ bool item::process_temperature_rot( float insulation, const tripoint &pos, map &
             } else {
                 env_temperature = AVERAGE_ANNUAL_TEMPERATURE;
             }
-            env_temperature += temp_mod;
-
-            switch( flag ) {
-                case temperature_flag::NORMAL:
-                    // Just use the temperature normally
-                    break;
-                case temperature_flag::FRIDGE:
-                    env_temperature = std::min( env_temperature, temperatures::fridge );
-                    break;
-                case temperature_flag::FREEZER:
-                    env_temperature = std::min( env_temperature, temperatures::freezer );
-                    break;
-                case temperature_flag::HEATER:
-                    env_temperature = std::max( env_temperature, temperatures::normal );
-                    break;
-                case temperature_flag::ROOT_CELLAR:
-                    env_temperature = AVERAGE_ANNUAL_TEMPERATURE;
-                    break;
-                default:
-                    debugmsg( "Temperature flag enum not valid.  Using normal temperature." );
-            }
+            env_temperature = flagged_temperature( env_temperature + temp_mod, flag );
 
             // Calculate item temperature from environment temperature
             // If the time was more than 2 d ago we do not care about item temperature.
@@ -13061,6 +13145,44 @@ bool item::process_temperature_rot( float insulation, const tripoint &pos, map &
     return false;
 }
 
+std::optional<time_point> item::temperature_rot_settled_until( const tripoint_bub_ms &pos,
+        const temperature_flag flag, const float spoil_multiplier ) const
+{
+    // Only food that does nothing but warm, cool and rot, and is up to date.
+    if( !only_changes_temperature_and_rot() || last_temp_check != calendar::turn ) {
+        return std::nullopt;
+    }
+    units::temperature temp = flagged_temperature( get_weather().get_temperature( pos.raw() ), flag );
+    // calc_temp leaves alone items this close to their environment.
+    if( abs( temp - temperature ) >= units::from_kelvin_delta( 0.4f ) ) {
+        return std::nullopt;
+    }
+
+    if( !goes_bad() || spoil_multiplier == 0 || has_own_flag( flag_FROZEN ) ||
+        get_relative_rot() > 2.0 ) {
+        return calendar::turn_max;
+    }
+    if( has_own_flag( flag_COLD ) ) {
+        temp = std::min( temperatures::fridge, temp );
+    }
+    const float rot_per_hour = rot_factor( spoil_multiplier ) * calc_hourly_rotpoints_at_temp( temp );
+    if( rot_per_hour <= 0 ) {
+        return calendar::turn_max;
+    }
+    // The next point at which the item would look or behave differently.
+    const double relative_rot = get_relative_rot();
+    double threshold = 2.0;
+    for( const double t : { 0.9, 1.0 } ) {
+        if( relative_rot <= t ) {
+            threshold = t;
+            break;
+        }
+    }
+    const time_duration rot_left = get_shelf_life() * threshold - rot;
+    return calendar::turn + time_duration::from_seconds( to_turns<double>( rot_left ) *
+            to_seconds<double>( 1_hours ) / rot_per_hour );
+}
+
 void item::calc_temp( const units::temperature &temp, const float insulation,
                       const time_duration &time_delta )
 {
@@ -14506,7 +14628,8 @@ bool item::process_internal( map &here, Character *carrier, const tripoint &pos,
         if( has_fault_flag( flag_BLACKPOWDER_FOULING_DAMAGE ) ) {
             return process_blackpowder_fouling( carrier );
         }
-        if( get_var( "gun_heat", 0 ) > 0 ) {
+        // Only guns heat up. Checking first spares every other carried item a var lookup each turn.
+        if( is_gun() && get_var( "gun_heat", 0 ) > 0 ) {
             return process_gun_cooling( carrier );
         }
     }
@@ -14785,7 +14908,7 @@ bool item::is_reloadable() const
 std::string item::type_name( unsigned int quantity, bool use_variant, bool use_cond_name,
                              bool use_corpse ) const
 {
-    const auto iter = item_vars.find( "name" );
+    const item_var_value *iter = item_vars.get( "name" );
     std::string ret_name;
     if( typeId() == itype_blood ) {
         if( corpse == nullptr || corpse->id.is_null() ) {
@@ -14795,8 +14918,8 @@ std::string item::type_name( unsigned int quantity, bool use_variant, bool use_c
                                              "%s blood",  quantity ),
                                   corpse->nname() );
         }
-    } else if( iter != item_vars.end() ) {
-        return iter->second;
+    } else if( iter != nullptr ) {
+        return iter->str();
     } else if( use_variant && has_itype_variant() ) {
         ret_name = itype_variant().alt_name.translated( quantity );
     } else {
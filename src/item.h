@@ -17,6 +17,7 @@
 #include <vector>
 
 #include "calendar.h"
+#include "cata_bitset.h"
 #include "cata_lazy.h"
 #include "cata_utility.h"
 #include "compatibility.h"
@@ -27,6 +28,7 @@
 #include "item_contents.h"
 #include "item_location.h"
 #include "item_tname.h"
+#include "item_var_map.h"
 #include "material.h"
 #include "requirements.h"
 #include "safe_reference.h"
@@ -69,6 +71,7 @@ template<typename T>
 class ret_val;
 template <typename T> struct enum_traits;
 class vehicle;
+class weather_generator;
 
 namespace enchant_vals
 {
@@ -92,6 +95,20 @@ enum class link_state : int;
 
 enum clothing_mod_type : int;
 
+/**
+ * What the temperature and rot of an item depend on where it lies, as
+ * @ref item::process_temperature_rot looks it up from the map and the weather.
+ * Items whose environment was looked up beforehand can be processed away from the main thread.
+ */
+struct item_temperature_environment {
+    // The temperature at the spot now, before storage or carrying is taken into account.
+    units::temperature temperature;
+    // What heat sources nearby add to the weather, for working out past temperatures.
+    units::temperature_delta temperature_mod;
+    const weather_generator *weather_gen = nullptr;
+    unsigned int seed = 0;
+};
+
 struct light_emission {
     unsigned short luminance;
     short width;
@@ -1049,6 +1066,8 @@ class item : public visitable
          * @param temp Temperature at which the rot is calculated
          */
         void calc_rot( units::temperature temp, float spoil_modifier, const time_duration &time_delta );
+        /** How much faster than its environment alone makes it rot this item rots. */
+        float rot_factor( float spoil_modifier ) const;
 
         /**
          * This is part of a workaround so that items don't rot away to nothing if the smoking rack
@@ -1070,6 +1089,18 @@ class item : public visitable
         bool process_temperature_rot( float insulation, const tripoint &pos, map &here, Character *carrier,
                                       temperature_flag flag = temperature_flag::NORMAL, float spoil_modifier = 1.0f,
                                       bool watertight_container = false );
+        /** As above, in an environment that was looked up beforehand. */
+        bool process_temperature_rot( const item_temperature_environment &env, float insulation,
+                                      const tripoint &pos, map &here, Character *carrier,
+                                      temperature_flag flag = temperature_flag::NORMAL, float spoil_modifier = 1.0f,
+                                      bool watertight_container = false );
+        /** Looks up the environment process_temperature_rot needs for this item at @p pos. */
+        item_temperature_environment temperature_environment( const tripoint &pos, map &here ) const;
+        /**
+         * True for active items whose processing does nothing but change their temperature and
+         * let them rot, and which don't need the map or random numbers for that.
+         */
+        bool only_changes_temperature_and_rot() const;
 
         /** Set the item to HOT and resets last_temp_check */
         void heat_up();
@@ -1616,6 +1647,20 @@ class item : public visitable
          */
         int processing_speed() const;
         static constexpr int NO_PROCESSING = 10000;
+        /**
+         * The turn before which processing the item (as done for items on the map) does nothing
+         * but wait for its countdown, or nullopt if it may have work to do any turn.
+         */
+        std::optional<time_point> idle_until() const;
+        /**
+         * The turn up to which the temperature and rot of this food, just processed while lying
+         * at @p pos, can be left alone: its temperature has settled at that of its surroundings,
+         * and it won't become old, rotten or rot away before then.  Processing it later catches
+         * up on the time in between in one go.  Returns nullopt if it has to be processed at its
+         * usual pace.
+         */
+        std::optional<time_point> temperature_rot_settled_until( const tripoint_bub_ms &pos,
+                temperature_flag flag, float spoil_multiplier ) const;
         /**
          * Process and apply artifact effects. This should be called exactly once each turn, it may
          * modify character stats (like speed, strength, ...), so call it after those have been reset.
@@ -3096,6 +3141,8 @@ class item : public visitable
         */
         void update_prefix_suffix_flags();
         void update_prefix_suffix_flags( const flag_id &flag );
+        /** Rebuild flag_bits from item_tags and inherited_tags_cache */
+        void update_flag_bits();
 
     public:
         enum class sizing : int {
@@ -3151,10 +3198,12 @@ class item : public visitable
         bool requires_tags_processing = true;
         cata::heap<FlagsSetType> item_tags; // generic item specific flags
         cata::heap<FlagsSetType> inherited_tags_cache;
+        // item_tags and inherited_tags_cache by json_flag::index_of, checked by has_flag
+        tiny_bitset flag_bits;
         cata::heap<FlagsSetType> prefix_tags_cache; // flags that will add prefixes to this item
         cata::heap<FlagsSetType> suffix_tags_cache; // flags that will add suffixes to this item
         lazy<safe_reference_anchor> anchor;
-        cata::heap<std::map<std::string, std::string>> item_vars;
+        item_var_map item_vars;
         const mtype *corpse = nullptr;
         std::string corpse_name;       // Name of the late lamented
         cata::heap<std::set<matec_id>> techniques; // item specific techniques
@@ -3271,6 +3320,26 @@ class item : public visitable
         };
         mutable cat_cache cached_category;
 
+        // tname() of the current turn.  Besides the arguments it is keyed by the public
+        // members tname() shows, the mutators of everything else reset the timestamp.
+        struct name_cache {
+            std::string name;
+            tname::segment_bitset segments;
+            unsigned int quantity = 0;
+            int language_version = 0;
+            const itype *type = nullptr;
+            size_t faults = 0;
+            int charges = 0;
+            int burnt = 0;
+            int wetness = 0;
+            bool active = false;
+            bool is_favorite = false;
+            bool ethereal = false;
+            time_point timestamp = calendar::turn_max;
+        };
+        mutable name_cache cached_name;
+        void invalidate_name_cache();
+
         // additional encumbrance this specific item has
         units::volume additional_encumbrance = 0_ml;
 
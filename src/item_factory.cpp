@@ -751,6 +751,9 @@ void Item_factory::finalize_post( itype &obj )
         }
         return false;
     } );
+    // The flags don't change from here on, has_flag can go by the bits.
+    obj.flag_bits = json_flag::to_bits( obj.item_tags );
+    obj.flag_bits_ready = true;
 
     if( obj.gun && !obj.gunmod && !obj.has_flag( flag_PRIMITIVE_RANGED_WEAPON ) ) {
         const quality_id qual_gun_skill( to_upper_case( obj.gun->skill_used.str() ) );
@@ -1407,6 +1410,10 @@ void Item_factory::finalize()
 
     finalize_item_blacklist();
 
+    for( std::pair<const item_group_id, std::unique_ptr<Item_spawn_data>> &g : m_template_groups ) {
+        g.second->finalize();
+    }
+
     // we can no longer add or adjust static item templates
     frozen = true;
 
@@ -5094,6 +5101,10 @@ void Item_factory::load_item_group( const JsonArray &entries, const item_group_i
     for( const JsonObject subobj : entries ) {
         add_entry( *ig, subobj, "entry within " + ig->context() );
     }
+    // Inline groups of mapgen and the like are loaded after finalize().
+    if( frozen ) {
+        ig->finalize();
+    }
 }
 
 void Item_factory::load_item_group( const JsonObject &jsobj, const item_group_id &group_id,
@@ -5146,6 +5157,9 @@ void Item_factory::load_item_group( const JsonObject &jsobj, const item_group_id
     if( jsobj.has_member( "sealed" ) ) {
         ig->sealed = jsobj.get_bool( "sealed" );
     }
+    if( frozen ) {
+        ig->finalize();
+    }
 }
 
 void Item_factory::load_item_group_data( const JsonObject &jsobj, Item_group *ig,
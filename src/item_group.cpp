@@ -8,6 +8,7 @@
 #include <type_traits>
 #include <unordered_map>
 
+#include "alloc_profiler.h"
 #include "calendar.h"
 #include "cata_assert.h"
 #include "cata_utility.h"
@@ -389,6 +390,14 @@ void Single_item_creator::replace_items( const std::unordered_map<itype_id, ityp
     // and finalize_item_blacklist() will deal with it, so no need to find it and call its replace_items().
 }
 
+void Single_item_creator::finalize()
+{
+    // Groups referenced by id are finalized through m_template_groups.
+    if( modifier ) {
+        modifier->finalize();
+    }
+}
+
 bool Single_item_creator::has_item( const itype_id &itemid ) const
 {
     switch( type ) {
@@ -750,6 +759,19 @@ const
     }
 }
 
+void Item_modifier::finalize()
+{
+    if( ammo ) {
+        ammo->finalize();
+    }
+    if( container ) {
+        container->finalize();
+    }
+    if( contents ) {
+        contents->finalize();
+    }
+}
+
 Item_group::Item_group( Type t, int probability, int ammo_chance, int magazine_chance,
                         const std::string &context, holiday event )
     : Item_spawn_data( probability, context, event )
@@ -799,6 +821,7 @@ void Item_group::add_entry( std::unique_ptr<Item_spawn_data> ptr )
         ptr->set_probablility( std::min( 100, ptr->get_probability( true ) ) );
     }
     sum_prob += ptr->get_probability( true );
+    distribution.clear();
 
     // Make the ammo and magazine probabilities from the outer entity apply to the nested entity:
     // If ptr is an Item_group, it already inherited its parent's ammo/magazine chances in its constructor.
@@ -821,17 +844,8 @@ std::size_t Item_group::create( Item_spawn_data::ItemList &list,
             elem->create( list, birthday, rec, flags );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            bool ev_based = elem->is_event_based();
-            int prob = elem->get_probability( false );
-            int real_prob = elem->get_probability( true );
-            p -= real_prob;
-            if( ( ev_based && prob == 0 ) || p >= 0 ) {
-                continue;
-            }
+        if( const Item_spawn_data *elem = pick_distribution_entry() ) {
             elem->create( list, birthday, rec, flags );
-            break;
         }
     }
     const std::size_t items_created = list.size() - prev_list_size;
@@ -851,21 +865,57 @@ item Item_group::create_single( const time_point &birthday, RecursionList &rec )
             return elem->create_single( birthday, rec );
         }
     } else if( type == G_DISTRIBUTION ) {
-        int p = rng( 0, sum_prob - 1 );
-        for( const auto &elem : items ) {
-            bool ev_based = elem->is_event_based();
-            int prob = elem->get_probability( false );
-            int real_prob = elem->get_probability( true );
-            p -= real_prob;
-            if( ( ev_based && prob == 0 ) || p >= 0 ) {
-                continue;
-            }
+        if( const Item_spawn_data *elem = pick_distribution_entry() ) {
             return elem->create_single( birthday, rec );
         }
     }
     return item( null_item_id, birthday );
 }
 
+const Item_spawn_data *Item_group::pick_distribution_entry() const
+{
+    if( items.empty() ) {
+        return nullptr;
+    }
+    size_t picked = 0;
+    if( !distribution.empty() ) {
+        picked = distribution.pick( rng_bits() );
+    } else {
+        int p = rng( 0, sum_prob - 1 );
+        for( ; picked < items.size(); picked++ ) {
+            p -= items[picked]->get_probability( true );
+            if( p < 0 ) {
+                break;
+            }
+        }
+    }
+    // An event-based entry outside of its event passes its share on to the next entry
+    // that can spawn.
+    for( ; picked < items.size(); picked++ ) {
+        const Item_spawn_data &elem = *items[picked];
+        if( !elem.is_event_based() || elem.get_probability( false ) != 0 ) {
+            return &elem;
+        }
+    }
+    return nullptr;
+}
+
+void Item_group::finalize()
+{
+    for( const std::unique_ptr<Item_spawn_data> &elem : items ) {
+        elem->finalize();
+    }
+    distribution.clear();
+    if( type == G_DISTRIBUTION && items.size() > 1 ) {
+        std::vector<int> weights;
+        weights.reserve( items.size() );
+        for( const std::unique_ptr<Item_spawn_data> &elem : items ) {
+            weights.push_back( elem->get_probability( true ) );
+        }
+        distribution.build( weights );
+    }
+}
+
 void Item_group::check_consistency( bool actually_spawn ) const
 {
     // if type is collection, then spawning itself automatically spawnes all entries,
@@ -906,6 +956,7 @@ bool Item_group::remove_item( const itype_id &itemid )
         if( ( *a )->remove_item( itemid ) ) {
             sum_prob -= ( *a )->get_probability( true );
             a = items.erase( a );
+            distribution.clear();
         } else {
             ++a;
         }
@@ -965,6 +1016,7 @@ item_group::ItemList item_group::items_from( const item_group_id &group_id,
     if( group == nullptr ) {
         return ItemList();
     }
+    const alloc_profiler::scoped_tag alloc_tag( alloc_profiler::tag::items );
     ItemList result;
     result.reserve( 20 );
     group->create( result, birthday, flags );
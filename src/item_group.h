@@ -15,6 +15,7 @@
 #include "relic.h"
 #include "type_id.h"
 #include "value_ptr.h"
+#include "weighted_list.h"
 
 class JsonObject;
 class JsonValue;
@@ -173,6 +174,11 @@ class Item_spawn_data
         virtual bool remove_item( const itype_id &itemid ) = 0;
         virtual void replace_items( const std::unordered_map<itype_id, itype_id> &replacements ) = 0;
         virtual bool has_item( const itype_id &itemid ) const = 0;
+        /**
+         * Called once the entries can no longer change (after the blacklist has been
+         * applied), to precompute whatever makes spawning from this cheaper.
+         */
+        virtual void finalize() {}
 
         virtual std::set<const itype *> every_item() const = 0;
         virtual std::map<const itype *, std::pair<int, int>> every_item_min_max() const = 0;
@@ -289,6 +295,7 @@ class Item_modifier
         void check_consistency( const std::string &context ) const;
         bool remove_item( const itype_id &itemid );
         void replace_items( const std::unordered_map<itype_id, itype_id> &replacements ) const;
+        void finalize();
 
         // Currently these always have the same chance as the item group it's part of, but
         // theoretically it could be defined per-item / per-group.
@@ -340,6 +347,7 @@ class Single_item_creator : public Item_spawn_data
         void check_consistency( bool actually_spawn ) const override;
         bool remove_item( const itype_id &itemid ) override;
         void replace_items( const std::unordered_map<itype_id, itype_id> &replacements ) override;
+        void finalize() override;
 
         bool has_item( const itype_id &itemid ) const override;
         std::set<const itype *> every_item() const override;
@@ -389,6 +397,7 @@ class Item_group : public Item_spawn_data
         void check_consistency( bool actually_spawn ) const override;
         bool remove_item( const itype_id &itemid ) override;
         void replace_items( const std::unordered_map<itype_id, itype_id> &replacements ) override;
+        void finalize() override;
         bool has_item( const itype_id &itemid ) const override;
         std::set<const itype *> every_item() const override;
         std::map<const itype *, std::pair<int, int>> every_item_min_max() const override;
@@ -413,6 +422,15 @@ class Item_group : public Item_spawn_data
          * Links to the entries in this group.
          */
         prop_list items;
+        /**
+         * For G_DISTRIBUTION, an alias table over the entries' probabilities, built by
+         * @ref finalize. While empty (before finalization or after the entries changed)
+         * entries are picked by walking @ref items.
+         */
+        weighted_alias_table distribution;
+
+        /** Picks the entry a G_DISTRIBUTION group spawns from, nullptr if none. */
+        const Item_spawn_data *pick_distribution_entry() const;
 };
 
 #endif // CATA_SRC_ITEM_GROUP_H
@@ -6,8 +6,12 @@
 #include <iosfwd>
 #include <iterator>
 #include <list>
+#include <map>
 #include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "character.h"
@@ -35,9 +39,67 @@
 #include "visitable.h"
 #include "vpart_position.h"
 
+namespace
+{
+
+struct item_index_table {
+    std::unordered_map<const item *, int> index;
+    int size = 0;
+};
+
+// By container and where in it: the square of the map or the vehicle part.
+using item_index_key = std::pair<const void *, tripoint>;
+// Set by item_location::index_cache_scope.
+std::optional<std::map<item_index_key, item_index_table>> index_tables;
+
+// The table of the container, filled by @p fill on first use.  Null without a cache scope.
+template<typename Fill>
+const item_index_table *index_table( const void *container, const tripoint &where, Fill fill )
+{
+    if( !index_tables ) {
+        return nullptr;
+    }
+    const auto inserted = index_tables->try_emplace( item_index_key( container, where ) );
+    item_index_table &table = inserted.first->second;
+    if( inserted.second ) {
+        fill( [&table]( const item * e ) {
+            table.index.emplace( e, table.size++ );
+        } );
+    }
+    return &table;
+}
+
+} // namespace
+
+item_location::index_cache_scope::index_cache_scope() : owns_cache( !index_tables )
+{
+    if( owns_cache ) {
+        index_tables.emplace();
+    }
+}
+
+item_location::index_cache_scope::~index_cache_scope()
+{
+    if( owns_cache ) {
+        index_tables.reset();
+    }
+}
+
 template <typename T>
-static int find_index( const T &sel, const item *obj )
+static int find_index( const T &sel, const item *obj, const void *container,
+                       const tripoint &where = tripoint_zero )
 {
+    const auto fill = [&sel]( const auto & add ) {
+        sel.visit_items( [&add]( const item * e, item * ) {
+            add( e );
+            return VisitResponse::NEXT;
+        } );
+    };
+    if( const item_index_table *table = index_table( container, where, fill ) ) {
+        const auto found = table->index.find( obj );
+        // The walk below ends on the last item if the item isn't there.
+        return found != table->index.end() ? found->second : table->size - 1;
+    }
     int idx = -1;
     sel.visit_items( [&idx, &obj]( const item * e, item * ) {
         idx++;
@@ -63,6 +125,17 @@ static item *retrieve_index( const T &sel, int idx )
     return obj;
 }
 
+template <typename T>
+static std::vector<item *> items_by_visit_order( const T &sel )
+{
+    std::vector<item *> items;
+    sel.visit_items( [&items]( const item * e, item * ) {
+        items.push_back( const_cast<item *>( e ) );
+        return VisitResponse::NEXT;
+    } );
+    return items;
+}
+
 class item_location::impl
 {
     public:
@@ -74,9 +147,15 @@ class item_location::impl
 
         impl() = default;
         explicit impl( item *i ) : what( i->get_safe_reference() ) {}
-        explicit impl( int idx ) : idx( idx ), needs_unpacking( true ) {}
+        explicit impl( int idx ) : idx( idx ), needs_unpacking( true ) {
+            pending_unpacks().insert( this );
+        }
 
-        virtual ~impl() = default;
+        virtual ~impl() {
+            if( needs_unpacking ) {
+                pending_unpacks().erase( this );
+            }
+        }
 
         virtual type where() const = 0;
         virtual type where_recursive() const {
@@ -101,8 +180,19 @@ class item_location::impl
         virtual int obtain_cost( const Character &, int ) const = 0;
         virtual void remove_item() = 0;
         virtual void on_contents_changed() = 0;
+        // Called whenever the target is handed out for modification.
+        virtual void mark_modified() const {}
         virtual void serialize( JsonOut &js ) const = 0;
         virtual item *unpack( int ) const = 0;
+        // Locations read from a save find their items together with the others of the same
+        // container, with one walk over the container for all of them.
+        virtual bool same_container( const impl & ) const {
+            return false;
+        }
+        // The items @ref unpack counts, in its order.  None if it doesn't count that way.
+        virtual std::optional<std::vector<item *>> items_by_index() const {
+            return std::nullopt;
+        }
 
         item *target() const {
             ensure_unpacked();
@@ -115,16 +205,44 @@ class item_location::impl
         }
 
     private:
+        static std::unordered_set<const impl *> &pending_unpacks() {
+            static std::unordered_set<const impl *> pending;
+            return pending;
+        }
+
         void ensure_unpacked() const {
-            if( needs_unpacking ) {
-                if( item *i = unpack( idx ) ) {
-                    what = i->get_safe_reference();
-                } else {
-                    debugmsg( "item_location lost its target item during a save/load cycle" );
+            if( !needs_unpacking ) {
+                return;
+            }
+            std::vector<const impl *> same;
+            for( const impl *other : pending_unpacks() ) {
+                if( other != this && other->same_container( *this ) ) {
+                    same.push_back( other );
                 }
-                needs_unpacking = false;
+            }
+            const std::optional<std::vector<item *>> items = same.empty() ? std::nullopt :
+                    items_by_index();
+            unpack_from( items );
+            for( const impl *other : same ) {
+                other->unpack_from( items );
             }
         }
+
+        void unpack_from( const std::optional<std::vector<item *>> &items ) const {
+            item *i = nullptr;
+            if( items && idx >= 0 ) {
+                i = static_cast<size_t>( idx ) < items->size() ? ( *items )[idx] : nullptr;
+            } else {
+                i = unpack( idx );
+            }
+            if( i ) {
+                what = i->get_safe_reference();
+            } else {
+                debugmsg( "item_location lost its target item during a save/load cycle" );
+            }
+            needs_unpacking = false;
+            pending_unpacks().erase( this );
+        }
         mutable safe_reference<item> what;
         mutable int idx = -1;
         mutable bool needs_unpacking = false;
@@ -210,7 +328,7 @@ class item_location::impl::item_on_map : public item_location::impl
             js.start_object();
             js.member( "type", "map" );
             js.member( "pos", position() );
-            js.member( "idx", find_index( cur, target() ) );
+            js.member( "idx", find_index( cur, target(), &get_map(), cur.pos().raw() ) );
             js.end_object();
         }
 
@@ -218,6 +336,21 @@ class item_location::impl::item_on_map : public item_location::impl
             return retrieve_index( cur, idx );
         }
 
+        bool same_container( const impl &other ) const override {
+            const item_on_map *on_map = dynamic_cast<const item_on_map *>( &other );
+            return on_map && on_map->cur.pos() == cur.pos();
+        }
+
+        std::optional<std::vector<item *>> items_by_index() const override {
+            return items_by_visit_order( cur );
+        }
+
+        void mark_modified() const override {
+            // Items on the map can be changed without going through the submap,
+            // make sure the change is picked up by the next save.
+            get_map().mark_submap_modified( cur.pos() );
+        }
+
         type where() const override {
             return type::map;
         }
@@ -333,7 +466,7 @@ class item_location::impl::item_on_person : public item_location::impl
             js.start_object();
             js.member( "type", "character" );
             js.member( "character", who_id );
-            js.member( "idx", find_index( *who, target() ) );
+            js.member( "idx", find_index( *who, target(), who ) );
             js.end_object();
         }
 
@@ -344,6 +477,18 @@ class item_location::impl::item_on_person : public item_location::impl
             return retrieve_index( *who, idx );
         }
 
+        bool same_container( const impl &other ) const override {
+            const item_on_person *on_person = dynamic_cast<const item_on_person *>( &other );
+            return on_person && on_person->who_id == who_id;
+        }
+
+        std::optional<std::vector<item *>> items_by_index() const override {
+            if( !ensure_who_unpacked() ) {
+                return std::nullopt;
+            }
+            return items_by_visit_order( *who );
+        }
+
         type where() const override {
             return type::character;
         }
@@ -471,7 +616,8 @@ class item_location::impl::item_on_vehicle : public item_location::impl
             js.member( "pos", position() );
             js.member( "part", cur.part );
             if( target() != &cur.veh.part( cur.part ).base ) {
-                js.member( "idx", find_index( cur, target() ) );
+                js.member( "idx", find_index( cur, target(), &cur.veh,
+                                              tripoint( cur.part, 0, 0 ) ) );
             }
             js.end_object();
         }
@@ -480,6 +626,16 @@ class item_location::impl::item_on_vehicle : public item_location::impl
             return idx >= 0 ? retrieve_index( cur, idx ) : &cur.veh.part( cur.part ).base;
         }
 
+        bool same_container( const impl &other ) const override {
+            const item_on_vehicle *on_vehicle = dynamic_cast<const item_on_vehicle *>( &other );
+            return on_vehicle && &on_vehicle->cur.veh == &cur.veh &&
+                   on_vehicle->cur.part == cur.part;
+        }
+
+        std::optional<std::vector<item *>> items_by_index() const override {
+            return items_by_visit_order( cur );
+        }
+
         type where() const override {
             return type::vehicle;
         }
@@ -586,6 +742,19 @@ class item_location::impl::item_in_container : public item_location::impl
             if( !container ) {
                 return -1;
             }
+            const auto fill = [this]( const auto & add ) {
+                for( const item *it : container->all_items_top() ) {
+                    add( it );
+                }
+            };
+            if( const item_index_table *table = index_table( container.get_item(), tripoint_zero,
+                                                fill ) ) {
+                const auto found = table->index.find( target() );
+                if( found != table->index.end() ) {
+                    return found->second;
+                }
+                return container->empty() ? -1 : table->size;
+            }
             int idx = 0;
             for( const item *it : container->all_items_top() ) {
                 if( target() == it ) {
@@ -603,6 +772,10 @@ class item_location::impl::item_in_container : public item_location::impl
             return container;
         }
 
+        void mark_modified() const override {
+            container.ptr->mark_modified();
+        }
+
         item_pocket *parent_pocket() const override {
             if( container_pkt == nullptr ) {
                 std::vector<item_pocket *> const pkts = parent_item()->get_all_standard_pockets();
@@ -791,6 +964,7 @@ item_location::operator bool() const
 
 item &item_location::operator*()
 {
+    ptr->mark_modified();
     return *ptr->target();
 }
 
@@ -801,6 +975,7 @@ const item &item_location::operator*() const
 
 item *item_location::operator->()
 {
+    ptr->mark_modified();
     return ptr->target();
 }
 
@@ -1098,6 +1273,7 @@ void item_location::make_active()
 
 item *item_location::get_item()
 {
+    ptr->mark_modified();
     return ptr->target();
 }
 
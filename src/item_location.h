@@ -165,6 +165,23 @@ class item_location
          */
         bool can_reload_with( const item_location &ammo, bool now ) const;
 
+        /**
+         * While one exists, the index an item_location saves is looked up in a table built by
+         * walking the container of the item once, instead of walking the container for every
+         * location.  Items must not be added, removed or moved in the meantime.  Scopes nest,
+         * the outermost one keeps the tables.
+         */
+        class index_cache_scope
+        {
+            public:
+                index_cache_scope();
+                ~index_cache_scope();
+                index_cache_scope( const index_cache_scope & ) = delete;
+                index_cache_scope &operator=( const index_cache_scope & ) = delete;
+            private:
+                bool owns_cache;
+        };
+
     private:
         class impl;
 
@@ -1,6 +1,7 @@
 #include "item_search.h"
 
 #include <map>
+#include <unordered_set>
 #include <utility>
 
 #include "avatar.h"
@@ -24,38 +25,54 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             filter = filter.substr( colon + 1 );
         }
     }
+    const lcmatcher match( filter );
     switch( flag ) {
         // category
-        case 'c':
-            return [filter]( const item & i ) {
-                return lcmatch( i.get_category_of_contents().name_header(), filter );
+        case 'c': {
+            std::unordered_set<item_category_id> categories;
+            for( const item_category &cat : item_category::get_all() ) {
+                if( match( cat.name_header() ) ) {
+                    categories.insert( cat.get_id() );
+                }
+            }
+            return [categories]( const item & i ) {
+                return categories.count( i.get_category_of_contents().get_id() ) > 0;
             };
+        }
         // material
-        case 'm':
-            return [filter]( const item & i ) {
+        case 'm': {
+            std::unordered_set<material_id> materials;
+            for( const material_type &mat : materials::get_all() ) {
+                if( match( mat.name() ) ) {
+                    materials.insert( mat.ident() );
+                }
+            }
+            return [materials]( const item & i ) {
                 return std::any_of( i.made_of().begin(), i.made_of().end(),
-                [&filter]( const std::pair<material_id, int> &mat ) {
-                    return lcmatch( mat.first->name(), filter );
+                [&materials]( const std::pair<material_id, int> &mat ) {
+                    return materials.count( mat.first ) > 0;
                 } );
             };
+        }
         // qualities
         case 'q':
             return [filter]( const item & i ) {
                 return i.type->has_any_quality( filter );
             };
         // both
-        case 'b':
-            return [filter]( const item & i ) {
-                auto pair = get_both( filter );
-                return item_filter_from_string( pair.first )( i )
-                       && item_filter_from_string( pair.second )( i );
+        case 'b': {
+            const std::pair<std::string, std::string> pair = get_both( filter );
+            return [first = item_filter_from_string( pair.first ),
+                           second = item_filter_from_string( pair.second )]( const item & i ) {
+                return first( i ) && second( i );
             };
+        }
         // disassembled components
         case 'd':
-            return [filter]( const item & i ) {
+            return [match]( const item & i ) {
                 const auto &components = i.get_uncraft_components();
                 for( const item_comp &component : components ) {
-                    if( lcmatch( component.to_string(), filter ) ) {
+                    if( match( component.to_string() ) ) {
                         return true;
                     }
                 }
@@ -63,27 +80,29 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             };
         // item notes
         case 'n':
-            return [filter]( const item & i ) {
+            return [match]( const item & i ) {
                 const std::string note = i.get_var( "item_note" );
-                return !note.empty() && lcmatch( note, filter );
+                return !note.empty() && match( note );
             };
         // item flags, must type in whole flag string name(case insensitive) so as to avoid revealing hidden flags.
-        case 'f':
-            return [filter]( const item & i ) {
-                std::string flag_filter = filter;
-                transform( flag_filter.begin(), flag_filter.end(), flag_filter.begin(), ::toupper );
-                const flag_id fsearch( flag_filter );
-                if( fsearch.is_valid() ) {
-                    return i.has_flag( fsearch );
-                } else {
+        case 'f': {
+            std::string flag_filter = filter;
+            transform( flag_filter.begin(), flag_filter.end(), flag_filter.begin(), ::toupper );
+            const flag_id fsearch( flag_filter );
+            if( !fsearch.is_valid() ) {
+                return []( const item & ) {
                     return false;
-                }
+                };
+            }
+            return [fsearch]( const item & i ) {
+                return i.has_flag( fsearch );
             };
+        }
         // by book skill
         case 's':
-            return [filter]( const item & i ) {
+            return [match]( const item & i ) {
                 if( get_avatar().has_identified( i.typeId() ) ) {
-                    return lcmatch( i.get_book_skill(), filter );
+                    return match( i.get_book_skill() );
                 }
                 return false;
             };
@@ -93,18 +112,17 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
             std::unordered_set<sub_bodypart_id> filtered_sub_bodyparts;
             for( const body_part &bp : all_body_parts ) {
                 const bodypart_str_id &bp_str_id = convert_bp( bp );
-                if( lcmatch( body_part_name( bp_str_id, 1 ), filter )
-                    || lcmatch( body_part_name( bp_str_id, 2 ), filter ) ) {
+                if( match( body_part_name( bp_str_id, 1 ) )
+                    || match( body_part_name( bp_str_id, 2 ) ) ) {
                     filtered_bodyparts.insert( bp_str_id->id );
                 }
                 for( const sub_bodypart_str_id &sbp : bp_str_id->sub_parts ) {
-                    if( lcmatch( sbp->name.translated(), filter )
-                        || lcmatch( sbp->name_multiple.translated(), filter ) ) {
+                    if( match( sbp->name ) || match( sbp->name_multiple ) ) {
                         filtered_sub_bodyparts.insert( sbp->id );
                     }
                 }
             }
-            return [filter, filtered_bodyparts, filtered_sub_bodyparts]( const item & i ) {
+            return [filtered_bodyparts, filtered_sub_bodyparts]( const item & i ) {
                 return std::any_of( filtered_bodyparts.begin(), filtered_bodyparts.end(),
                 [&i]( const bodypart_id & bp ) {
                     return i.covers( bp );
@@ -117,8 +135,8 @@ std::function<bool( const item & )> basic_item_filter( std::string filter )
         }
         // by name
         default:
-            return [filter]( const item & a ) {
-                return lcmatch( remove_color_tags( a.tname() ), filter );
+            return [match]( const item & a ) {
+                return match( remove_color_tags( a.tname() ) );
             };
     }
 }
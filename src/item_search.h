@@ -76,8 +76,8 @@ std::function<bool( const T & )> filter_from_string( std::string filter,
     }
     const bool exclude = filter[0] == '-';
     if( exclude ) {
-        return [filter, basic_filter]( const T & i ) {
-            return !filter_from_string( filter.substr( 1 ), basic_filter )( i );
+        return [excluded = filter_from_string( filter.substr( 1 ), basic_filter )]( const T & i ) {
+            return !excluded( i );
         };
     }
 
@@ -93,6 +93,8 @@ std::function<bool( const item & )> item_filter_from_string( const std::string &
 
 /**
  * Get a function that returns true if the value matches the basic query (no commas or minuses).
+ * The query is parsed and everything that doesn't depend on the item is resolved here, so the
+ * returned function is cheap to apply to many items.
  */
 std::function<bool( const item & )> basic_item_filter( std::string filter );
 
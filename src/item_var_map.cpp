@@ -0,0 +1,200 @@
+#include "item_var_map.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <mutex>
+#include <system_error>
+#include <unordered_set>
+
+#include "json.h"
+#include "string_formatter.h"
+
+static const std::string *intern_item_var_name( const std::string_view name )
+{
+    static std::mutex names_mutex;
+    static std::unordered_set<std::string> names;
+    std::lock_guard<std::mutex> lock( names_mutex );
+    return &*names.emplace( name ).first;
+}
+
+item_var_key::item_var_key( const std::string_view name ) : name_( intern_item_var_name( name ) )
+{
+}
+
+// The integer @p text is the text form of, as std::to_string writes it.
+static std::optional<long long> integer_from_text( const std::string_view text )
+{
+    long long value = 0;
+    const char *const end = text.data() + text.size();
+    const std::from_chars_result result = std::from_chars( text.data(), end, value );
+    if( result.ec != std::errc() || result.ptr != end || text != std::to_string( value ) ) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// The number @p text is the text form of, as "%f" writes it.
+static std::optional<double> double_from_text( const std::string &text )
+{
+    if( text.empty() || text.find_first_not_of( "-0123456789.," ) != std::string::npos ) {
+        return std::nullopt;
+    }
+    char *end = nullptr;
+    const double value = std::strtod( text.c_str(), &end );
+    // Negative zero would compare equal to zero, but its text does not.
+    if( end != text.c_str() + text.size() || !std::isfinite( value ) ||
+        ( value == 0 && std::signbit( value ) ) || string_format( "%f", value ) != text ) {
+        return std::nullopt;
+    }
+    return value;
+}
+
+// The point @p text is the text form of, as "%d,%d,%d" writes it.
+static std::optional<tripoint> tripoint_from_text( const std::string_view text )
+{
+    const size_t first = text.find( ',' );
+    const size_t second = first == std::string_view::npos ? first : text.find( ',', first + 1 );
+    if( second == std::string_view::npos ) {
+        return std::nullopt;
+    }
+    const std::optional<long long> x = integer_from_text( text.substr( 0, first ) );
+    const std::optional<long long> y = integer_from_text( text.substr( first + 1,
+                                       second - first - 1 ) );
+    const std::optional<long long> z = integer_from_text( text.substr( second + 1 ) );
+    const auto fits_int = []( const std::optional<long long> &v ) {
+        return v && *v >= std::numeric_limits<int>::min() && *v <= std::numeric_limits<int>::max();
+    };
+    if( !fits_int( x ) || !fits_int( y ) || !fits_int( z ) ) {
+        return std::nullopt;
+    }
+    return tripoint( static_cast<int>( *x ), static_cast<int>( *y ), static_cast<int>( *z ) );
+}
+
+item_var_value item_var_value::from_text( std::string text )
+{
+    item_var_value result;
+    if( const std::optional<long long> integer = integer_from_text( text ) ) {
+        result.value_ = *integer;
+    } else if( const std::optional<double> number = double_from_text( text ) ) {
+        result.value_ = *number;
+    } else if( const std::optional<tripoint> p = tripoint_from_text( text ) ) {
+        result.value_ = *p;
+    } else {
+        result.value_ = std::move( text );
+    }
+    return result;
+}
+
+item_var_value item_var_value::from_double( const double value )
+{
+    return from_text( string_format( "%f", value ) );
+}
+
+std::string item_var_value::str() const
+{
+    if( const std::string *text = std::get_if<std::string>( &value_ ) ) {
+        return *text;
+    } else if( const long long *integer = std::get_if<long long>( &value_ ) ) {
+        return std::to_string( *integer );
+    } else if( const double *number = std::get_if<double>( &value_ ) ) {
+        return string_format( "%f", *number );
+    }
+    const tripoint &p = std::get<tripoint>( value_ );
+    return string_format( "%d,%d,%d", p.x, p.y, p.z );
+}
+
+std::optional<double> item_var_value::as_number() const
+{
+    if( const long long *integer = std::get_if<long long>( &value_ ) ) {
+        return static_cast<double>( *integer );
+    } else if( const double *number = std::get_if<double>( &value_ ) ) {
+        return *number;
+    }
+    return std::nullopt;
+}
+
+std::optional<tripoint> item_var_value::as_tripoint() const
+{
+    if( const tripoint *p = std::get_if<tripoint>( &value_ ) ) {
+        return *p;
+    }
+    return std::nullopt;
+}
+
+item_var_map::item_var_map( const std::map<std::string, std::string> &vars )
+{
+    vars_.reserve( vars.size() );
+    // Already sorted by name.
+    for( const std::pair<const std::string, std::string> &var : vars ) {
+        vars_.emplace_back( item_var_key( var.first ), item_var_value::from_text( var.second ) );
+    }
+}
+
+std::vector<item_var_map::value_type>::const_iterator item_var_map::lower_bound(
+    const std::string_view name ) const
+{
+    return std::lower_bound( vars_.begin(), vars_.end(), name,
+    []( const value_type & var, const std::string_view name ) {
+        return std::string_view( var.first.str() ) < name;
+    } );
+}
+
+item_var_map::const_iterator item_var_map::find( const std::string_view name ) const
+{
+    const const_iterator it = lower_bound( name );
+    return it != vars_.end() && it->first.str() == name ? it : vars_.end();
+}
+
+const item_var_value *item_var_map::get( const std::string_view name ) const
+{
+    const const_iterator it = find( name );
+    return it == vars_.end() ? nullptr : &it->second;
+}
+
+size_t item_var_map::count( const std::string_view name ) const
+{
+    return find( name ) == vars_.end() ? 0 : 1;
+}
+
+void item_var_map::set( const std::string_view name, item_var_value value )
+{
+    const auto it = vars_.begin() + ( lower_bound( name ) - vars_.cbegin() );
+    if( it != vars_.end() && it->first.str() == name ) {
+        it->second = std::move( value );
+    } else {
+        vars_.emplace( it, item_var_key( name ), std::move( value ) );
+    }
+}
+
+void item_var_map::erase( const std::string_view name )
+{
+    const const_iterator it = find( name );
+    if( it != vars_.end() ) {
+        vars_.erase( it );
+    }
+}
+
+void item_var_map::clear()
+{
+    vars_.clear();
+}
+
+void item_var_map::serialize( JsonOut &jsout ) const
+{
+    jsout.start_object();
+    for( const value_type &var : vars_ ) {
+        jsout.member( var.first.str(), var.second.str() );
+    }
+    jsout.end_object();
+}
+
+void item_var_map::deserialize( const JsonObject &jo )
+{
+    vars_.clear();
+    for( const JsonMember member : jo ) {
+        set( member.name(), item_var_value::from_text( member.get_string() ) );
+    }
+}
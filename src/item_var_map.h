@@ -0,0 +1,141 @@
+#pragma once
+#ifndef CATA_SRC_ITEM_VAR_MAP_H
+#define CATA_SRC_ITEM_VAR_MAP_H
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "point.h"
+
+class JsonObject;
+class JsonOut;
+
+/**
+ * The name of an item variable. Names are interned, all items with a variable of the same name
+ * share one copy of it, and two keys are equal when they point to the same string.
+ */
+class item_var_key
+{
+    public:
+        explicit item_var_key( std::string_view name );
+
+        const std::string &str() const {
+            return *name_;
+        }
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        operator const std::string &() const {
+            return *name_;
+        }
+
+        bool operator==( const item_var_key &rhs ) const {
+            return name_ == rhs.name_;
+        }
+        bool operator!=( const item_var_key &rhs ) const {
+            return name_ != rhs.name_;
+        }
+
+    private:
+        const std::string *name_;
+};
+
+/**
+ * The value of an item variable. Numbers and points are stored as such, so reading them back
+ * does not parse text. Each value has exactly one text form, which is what gets saved and what
+ * @ref item::get_var returns as string. Text is only stored as number or point if it is the
+ * text form of that number or point, so two values are equal exactly when their texts are.
+ */
+class item_var_value
+{
+    public:
+        item_var_value() = default;
+        explicit item_var_value( long long value ) : value_( value ) {}
+        explicit item_var_value( const tripoint &value ) : value_( value ) {}
+
+        /** Keeps @p text as number or point if it is the text form of one. */
+        static item_var_value from_text( std::string text );
+        /** The value with the text form "%f" gives for @p value. */
+        static item_var_value from_double( double value );
+
+        /** The text form of the value. */
+        std::string str() const;
+        /** The value if it is stored as a number. */
+        std::optional<double> as_number() const;
+        /** The value if it is stored as a point. */
+        std::optional<tripoint> as_tripoint() const;
+
+        bool operator==( const item_var_value &rhs ) const {
+            return value_ == rhs.value_;
+        }
+        bool operator!=( const item_var_value &rhs ) const {
+            return value_ != rhs.value_;
+        }
+
+    private:
+        std::variant<std::string, long long, double, tripoint> value_;
+};
+
+/**
+ * The variables of an item, see @ref item::set_var. A vector sorted by name: items have few
+ * variables, most have none, and an empty one does not allocate. Iterates in the same order
+ * and saves to the same json object as the std::map of strings it replaces.
+ */
+class item_var_map
+{
+    public:
+        using value_type = std::pair<item_var_key, item_var_value>;
+        using const_iterator = std::vector<value_type>::const_iterator;
+
+        item_var_map() = default;
+        explicit item_var_map( const std::map<std::string, std::string> &vars );
+
+        const_iterator begin() const {
+            return vars_.begin();
+        }
+        const_iterator end() const {
+            return vars_.end();
+        }
+        bool empty() const {
+            return vars_.empty();
+        }
+        size_t size() const {
+            return vars_.size();
+        }
+
+        const_iterator find( std::string_view name ) const;
+        /** The value of the variable, nullptr if there is none. */
+        const item_var_value *get( std::string_view name ) const;
+        size_t count( std::string_view name ) const;
+
+        void set( std::string_view name, item_var_value value );
+        void erase( std::string_view name );
+        /** Erases the variables @p pred returns true for. */
+        template<typename Pred>
+        void erase_if( Pred pred ) {
+            vars_.erase( std::remove_if( vars_.begin(), vars_.end(), pred ), vars_.end() );
+        }
+        void clear();
+
+        void serialize( JsonOut &jsout ) const;
+        void deserialize( const JsonObject &jo );
+
+        bool operator==( const item_var_map &rhs ) const {
+            return vars_ == rhs.vars_;
+        }
+        bool operator!=( const item_var_map &rhs ) const {
+            return vars_ != rhs.vars_;
+        }
+
+    private:
+        std::vector<value_type>::const_iterator lower_bound( std::string_view name ) const;
+
+        std::vector<value_type> vars_;
+};
+
+#endif // CATA_SRC_ITEM_VAR_MAP_H
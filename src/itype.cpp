@@ -7,6 +7,7 @@
 #include "cata_utility.h"
 #include "character.h"
 #include "debug.h"
+#include "flag.h"
 #include "item.h"
 #include "make_static.h"
 #include "recipe.h"
@@ -163,6 +164,9 @@ bool itype::has_use() const
 
 bool itype::has_flag( const flag_id &flag ) const
 {
+    if( flag_bits_ready ) {
+        return json_flag::test_bit( flag_bits, flag );
+    }
     return item_tags.count( flag );
 }
 
@@ -15,6 +15,7 @@
 
 #include "bodypart.h"
 #include "calendar.h"
+#include "cata_bitset.h"
 #include "color.h" // nc_color
 #include "damage.h"
 #include "enums.h" // point
@@ -1380,6 +1381,9 @@ struct itype {
         mtype_id source_monster = mtype_id::NULL_ID();
     private:
         FlagsSetType item_tags;
+        // item_tags by json_flag::index_of, for has_flag once the type is finalized.
+        tiny_bitset flag_bits;
+        bool flag_bits_ready = false;
 
     public:
         // memory card related per-type static data
@@ -853,10 +853,29 @@ void TextJsonIn::seek( int pos )
     ate_separator = false;
 }
 
+// Plain characters can be copied out of a string as they are, everything else goes through
+// get_escaped_or_unicode.
+static bool is_plain_string_char( const int ch )
+{
+    return ch >= 0x20 && ch < 0x80 && ch != '"' && ch != '\\';
+}
+
 void TextJsonIn::eat_whitespace()
 {
-    while( is_whitespace( peek() ) ) {
-        stream->get();
+    // Straight from the buffer, std::istream::peek and get check the stream on every call.
+    std::streambuf *const buf = stream->rdbuf();
+    if( buf == nullptr || !stream->good() ) {
+        while( is_whitespace( peek() ) ) {
+            stream->get();
+        }
+        return;
+    }
+    int ch = buf->sgetc();
+    while( ch != std::char_traits<char>::eof() && is_whitespace( static_cast<char>( ch ) ) ) {
+        ch = buf->snextc();
+    }
+    if( ch == std::char_traits<char>::eof() ) {
+        stream->setstate( std::ios::eofbit );
     }
 }
 
@@ -941,6 +960,12 @@ void TextJsonIn::skip_string()
         err << "expecting string but found '" << ch << "'";
         error( -1, err.str() );
     }
+    if( std::streambuf *const buf = stream->good() ? stream->rdbuf() : nullptr ) {
+        int next = buf->sgetc();
+        while( is_plain_string_char( next ) ) {
+            next = buf->snextc();
+        }
+    }
     while( stream->good() ) {
         stream->get( ch );
         if( ch == '\\' ) {
@@ -1217,8 +1242,16 @@ std::string TextJsonIn::get_string()
             err = "expected string but got '" + std::string( 1, ch ) + "'";
             break;
         }
-        // add chars to the string, one at a time
+        std::streambuf *const buf = stream->rdbuf();
+        // add chars to the string, runs of plain ones straight from the buffer
         do {
+            if( buf != nullptr ) {
+                int next = buf->sgetc();
+                while( is_plain_string_char( next ) ) {
+                    s += static_cast<char>( next );
+                    next = buf->snextc();
+                }
+            }
             ch = stream->peek();
             if( !stream->good() ) {
                 err = "read operation failed";
@@ -2366,15 +2399,20 @@ void JsonOut::write( const std::string_view val )
         write_separator();
     }
     stream->put( '"' );
-    for( const char &i : val ) {
-        unsigned char ch = i;
+    // Characters that need no escaping are copied in runs rather than one put() at a time
+    const char *run = val.data();
+    const char *const end = val.data() + val.size();
+    for( const char *it = run; it != end; ++it ) {
+        unsigned char ch = *it;
+        if( ch >= 0x20 && ch != '"' && ch != '\\' ) {
+            continue;
+        }
+        stream->write( run, it - run );
+        run = it + 1;
         if( ch == '"' ) {
             stream->write( "\\\"", 2 );
         } else if( ch == '\\' ) {
             stream->write( "\\\\", 2 );
-        } else if( ch == '/' ) {
-            // don't technically need to escape this
-            stream->put( '/' );
         } else if( ch == '\b' ) {
             stream->write( "\\b", 2 );
         } else if( ch == '\f' ) {
@@ -2395,10 +2433,9 @@ void JsonOut::write( const std::string_view val )
             } else {
                 stream->put( 'A' + ( remainder - 0x0A ) );
             }
-        } else {
-            stream->put( ch );
         }
     }
+    stream->write( run, end - run );
     stream->put( '"' );
     need_separator = true;
 }
@@ -4,6 +4,7 @@
 
 #include <array>
 #include <bitset>
+#include <charconv>
 #include <cstddef>
 #include <cstdint>
 #include <iostream>
@@ -777,7 +778,20 @@ class JsonOut
             if( need_separator ) {
                 write_separator();
             }
-            *stream << val;
+            if constexpr( std::is_same_v<T, bool> ) {
+                if( val ) {
+                    stream->write( "true", 4 );
+                } else {
+                    stream->write( "false", 5 );
+                }
+            } else if constexpr( std::is_integral_v<T> ) {
+                // to_chars is locale-independent and skips the stream's num_put machinery
+                char buf[24];
+                const std::to_chars_result res = std::to_chars( std::begin( buf ), std::end( buf ), val );
+                stream->write( buf, res.ptr - buf );
+            } else {
+                *stream << val;
+            }
             need_separator = true;
         }
 
@@ -808,7 +822,7 @@ class JsonOut
         // strings need escaping and quoting
         void write( std::string_view val );
         void write( const char *val ) {
-            write( std::string( val ) );
+            write( std::string_view( val ) );
         }
 
         // char should always be written as an unquoted numeral
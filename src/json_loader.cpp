@@ -1,6 +1,7 @@
 #include "json_loader.h"
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 
 #include <ghc/fs_std_fwd.hpp>
@@ -43,6 +44,8 @@ flexbuffer_cache &user_cache()
 }
 
 std::unordered_map<std::string, std::unique_ptr<flexbuffer_cache>> save_caches;
+// json_loader may be used from several threads at once.
+std::mutex save_caches_mutex;
 
 // There's no measurable need to persist flatbuffers for save data, so just create a per-world 'cache' which parses
 // but doesn't disk-cache the parsed flatbuffer.
@@ -58,6 +61,7 @@ flexbuffer_cache &cache_for_save( const cata_path &path )
     std::string folder_or_file = path_it->u8string();
     ++path_it;
 
+    std::lock_guard<std::mutex> lock( save_caches_mutex );
     auto it = save_caches.find( worldname_str );
     if( it == save_caches.end() ) {
         it = save_caches.emplace( worldname_str,
@@ -153,7 +157,12 @@ JsonValue json_loader::from_path( const cata_path &source_file ) noexcept( false
 
 JsonValue json_loader::from_string( std::string const &data ) noexcept( false )
 {
-    std::shared_ptr<parsed_flexbuffer> buffer = flexbuffer_cache::parse_buffer( data );
+    return from_flexbuffer( flexbuffer_cache::parse_buffer( data ) );
+}
+
+JsonValue json_loader::from_flexbuffer( std::shared_ptr<parsed_flexbuffer> buffer ) noexcept(
+    false )
+{
     if( !buffer ) {
         throw JsonError( "Failed to parse string into json" );
     }
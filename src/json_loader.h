@@ -2,6 +2,8 @@
 #ifndef CATA_SRC_JSON_LOADER_H
 #define CATA_SRC_JSON_LOADER_H
 
+#include <memory>
+
 #include <ghc/fs_std_fwd.hpp>
 
 #include "path_info.h"
@@ -26,6 +28,9 @@ class json_loader
         static JsonValue from_string( std::string const &data ) noexcept( false );
         static std::optional<JsonValue> from_string_opt( std::string const &data ) noexcept( false );
 
+        // Create a JsonValue from data that was already parsed, eg. by flexbuffer_cache::parse_buffer on another thread.
+        static JsonValue from_flexbuffer( std::shared_ptr<parsed_flexbuffer> buffer ) noexcept( false );
+
 };
 
 #endif // CATA_SRC_JSON_LOADER_H
@@ -158,6 +158,12 @@ static Character *get_avatar_or_follower( const character_id &id )
 
 static constexpr int npc_kill_xp = 10;
 
+bool kill_tracker::wants( const event_type type ) const
+{
+    return type == event_type::character_kills_monster ||
+           type == event_type::character_kills_character;
+}
+
 void kill_tracker::notify( const cata::event &e )
 {
     switch( e.type() ) {
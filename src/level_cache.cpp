@@ -7,7 +7,7 @@ level_cache::level_cache()
     const int map_dimensions = MAPSIZE_X * MAPSIZE_Y;
     transparency_cache_dirty.set();
     outside_cache_dirty = true;
-    floor_cache_dirty = false;
+    floor_cache_dirty.reset();
     constexpr four_quadrants four_zeros( 0.0f );
     std::fill_n( &lm[0][0], map_dimensions, four_zeros );
     std::fill_n( &sm[0][0], map_dimensions, 0.0f );
@@ -64,10 +64,12 @@ void level_cache::clear_vehicle_cache()
     veh_cache_cleared = true;
 }
 
-void level_cache::clear_veh_from_veh_cached_parts( const tripoint &pt, vehicle *veh )
+bool level_cache::clear_veh_from_veh_cached_parts( const tripoint &pt, vehicle *veh )
 {
     auto it = veh_cached_parts.find( pt );
     if( it != veh_cached_parts.end() && it->second.first == veh ) {
         veh_cached_parts.erase( it );
+        return true;
     }
+    return false;
 }
@@ -16,6 +16,17 @@
 
 class vehicle;
 
+// Light cast by the sources collected in level_cache::light_source_buffer.  It is kept
+// between calls to map::generate_lightmap, together with the inputs it was cast from, so
+// only the sources near a change have to be cast again.
+struct buffered_light_cache {
+    cata::mdarray<four_quadrants, point_bub_ms> lm;
+    cata::mdarray<float, point_bub_ms> sm;
+    cata::mdarray<float, point_bub_ms> sources;
+    cata::mdarray<float, point_bub_ms> transparency;
+    bool valid = false;
+};
+
 struct level_cache {
     public:
         // Zeros all relevant values
@@ -24,7 +35,8 @@ struct level_cache {
 
         std::bitset<MAPSIZE *MAPSIZE> transparency_cache_dirty;
         bool outside_cache_dirty = false;
-        bool floor_cache_dirty = false;
+        // Indexed like transparency_cache_dirty, one bit per submap.
+        std::bitset<MAPSIZE *MAPSIZE> floor_cache_dirty;
         bool seen_cache_dirty = false;
         // This is a single value indicating that the entire level is floored.
         bool no_floor_gaps = false;
@@ -34,10 +46,24 @@ struct level_cache {
         // To prevent redundant ray casting into neighbors: precalculate bulk light source positions.
         // This is only valid for the duration of generate_lightmap
         cata::mdarray<float, point_bub_ms> light_source_buffer;
+        // Allocated by the first generate_lightmap on this level.
+        cata::value_ptr<buffered_light_cache> buffered_light;
 
         // Cache of natural light level is useful if it needs to be in sync with the light cache.
         float natural_light_level_cache;
 
+        // Changes whenever outside_cache, floor_cache or transparency_cache do, which is all
+        // the sunlight on this and the lower levels is cast from.
+        int sunlight_inputs_generation = 0;
+        // sunlight_inputs_generation when map::build_sunlight_cache last cast sunlight here.
+        int sunlight_built_generation = -1;
+        // False once anything but sunlight has been added to lm.
+        bool sunlight_only = false;
+        // Whether the levels below are fully outside or fully inside, as found by
+        // map::build_sunlight_cache when it last cast sunlight here.
+        bool sunlight_fully_outside_below = false;
+        bool sunlight_fully_inside_below = false;
+
         // if false, means tile is under the roof ("inside"), true means tile is "outside"
         // "inside" tiles are protected from sun, rain, etc. (see ter_furn_flag::TFLAG_INDOORS flag)
         cata::mdarray<bool, point_bub_ms> outside_cache;
@@ -88,7 +114,8 @@ struct level_cache {
         void set_veh_cached_parts( const tripoint &pt, vehicle &veh, int part_num );
 
         void clear_vehicle_cache();
-        void clear_veh_from_veh_cached_parts( const tripoint &pt, vehicle *veh );
+        // Clears the point if it's cached as part of veh, returns whether it was.
+        bool clear_veh_from_veh_cached_parts( const tripoint &pt, vehicle *veh );
 
     private:
         // Whether the cache is empty or not; if true, nothing has been added to the cache
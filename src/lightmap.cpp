@@ -95,6 +95,7 @@ bool map::build_transparency_cache( const int zlev )
     if( map_cache.transparency_cache_dirty.none() ) {
         return false;
     }
+    ++map_cache.sunlight_inputs_generation;
 
     // if true, all submaps are invalid (can use batch init)
     bool rebuild_all = map_cache.transparency_cache_dirty.all();
@@ -143,6 +144,9 @@ bool map::build_transparency_cache( const int zlev )
                     value *= sight_penalty;
                 }
                 float value_wo_fields = value;
+                if( !cur_submap->may_have_field( sp ) ) {
+                    return std::make_pair( value, value_wo_fields );
+                }
                 for( const auto &fld : cur_submap->get_field( sp ) ) {
                     const field_intensity_level &i_level = fld.second.get_intensity_level();
                     if( i_level.transparent ) {
@@ -166,10 +170,11 @@ bool map::build_transparency_cache( const int zlev )
                     for( int sx = 0; sx < SEEX; ++sx ) {
                         // init all sy indices in one go
                         std::uninitialized_fill_n( &transparency_cache[sm_offset.x + sx][sm_offset.y], SEEY, value );
-                        if( opaque ) {
+                        // on a partial rebuild the bits may hold the previous contents
+                        if( opaque || !rebuild_all ) {
                             auto &bs = transparent_cache_wo_fields[sm_offset.x + sx];
                             for( int i = 0; i < SEEY; i++ ) {
-                                bs[sm_offset.y + i] = false;
+                                bs[sm_offset.y + i] = !opaque;
                             }
                         }
                     }
@@ -292,14 +297,36 @@ void map::build_sunlight_cache( int pzlev )
     //    ↓
     // when fully below ground: fully_outside=false, fully_inside=true  (fast fill)
 
+    // Grab illumination at ground level.
+    const float outside_light_level = g->natural_light_level( 0 );
+    const float sight_penalty = get_weather().weather_id->sight_penalty;
+    // Sunlight on a level only depends on the sky and on the levels above it, so a level
+    // that, like all above it, is still cast from the same caches can be kept.
+    bool above_changed = outside_light_level != sunlight_outside_level ||
+                         sight_penalty != sunlight_sight_penalty || zlev_max != sunlight_zlev_max;
+    sunlight_outside_level = outside_light_level;
+    sunlight_sight_penalty = sight_penalty;
+    sunlight_zlev_max = zlev_max;
+    const auto finish_level = [&]( level_cache & map_cache ) {
+        map_cache.sunlight_built_generation = map_cache.sunlight_inputs_generation;
+        map_cache.sunlight_only = true;
+        map_cache.sunlight_fully_outside_below = fully_outside;
+        map_cache.sunlight_fully_inside_below = fully_inside;
+    };
+
     // Iterate top to bottom because sunlight cache needs to construct in that order.
     for( int zlev = zlev_max; zlev >= zlev_min; zlev-- ) {
 
         level_cache &map_cache = get_cache( zlev );
         map_cache.natural_light_level_cache = g->natural_light_level( zlev );
+        above_changed = above_changed ||
+                        map_cache.sunlight_built_generation != map_cache.sunlight_inputs_generation;
+        if( !above_changed && map_cache.sunlight_only ) {
+            fully_outside = map_cache.sunlight_fully_outside_below;
+            fully_inside = map_cache.sunlight_fully_inside_below;
+            continue;
+        }
         auto &lm = map_cache.lm;
-        // Grab illumination at ground level.
-        const float outside_light_level = g->natural_light_level( 0 );
         // TODO: if zlev < 0 is open to sunlight, this won't calculate correct light, but neither does g->natural_light_level()
         const float inside_light_level = ( zlev >= 0 && outside_light_level > LIGHT_SOURCE_BRIGHT ) ?
                                          LIGHT_AMBIENT_DIM * 0.8 : LIGHT_AMBIENT_LOW;
@@ -307,6 +334,7 @@ void map::build_sunlight_cache( int pzlev )
         // all light was blocked before
         if( fully_inside ) {
             std::fill_n( &lm[0][0], MAPSIZE_X * MAPSIZE_Y, four_quadrants( inside_light_level ) );
+            finish_level( map_cache );
             continue;
         }
 
@@ -332,6 +360,7 @@ void map::build_sunlight_cache( int pzlev )
                                                      this_floor_cache[x][y] );
                 }
             }
+            finish_level( map_cache );
             continue;
         }
 
@@ -344,7 +373,6 @@ void map::build_sunlight_cache( int pzlev )
         const auto &prev_transparency_cache = prev_map_cache.transparency_cache;
         const auto &prev_floor_cache = prev_map_cache.floor_cache;
         const auto &outside_cache = map_cache.outside_cache;
-        const float sight_penalty = get_weather().weather_id->sight_penalty;
         // TODO: Replace these with a lookup inside the four_quadrants class.
         constexpr std::array<point, 5> cardinals = {
             {point_zero, point_north, point_west, point_east, point_south}
@@ -402,11 +430,13 @@ void map::build_sunlight_cache( int pzlev )
                 }
             }
         }
+        finish_level( map_cache );
     }
 }
 
 void map::generate_lightmap( const int zlev )
 {
+    ++light_generation;
     level_cache &map_cache = get_cache( zlev );
     auto &lm = map_cache.lm;
     auto &sm = map_cache.sm;
@@ -442,6 +472,8 @@ void map::generate_lightmap( const int zlev )
     const float natural_light = g->natural_light_level( zlev );
 
     build_sunlight_cache( zlev );
+    // Everything below adds to the sunlight of this level.
+    map_cache.sunlight_only = false;
 
     apply_character_light( get_player_character() );
     for( npc &guy : g->all_npcs() ) {
@@ -457,6 +489,8 @@ void map::generate_lightmap( const int zlev )
                 debugmsg( "Tried to generate lightmap at (%d,%d,%d) but the submap is not loaded", smx, smy, zlev );
                 continue;
             }
+            const bool has_lit_items = cur_submap->lum_count() > 0;
+            const bool has_furn = cur_submap->furn_count() > 0;
 
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
@@ -484,7 +518,7 @@ void map::generate_lightmap( const int zlev )
                         }
                     }
 
-                    if( cur_submap->get_lum( { sx, sy } ) ) {
+                    if( has_lit_items && cur_submap->get_lum( { sx, sy } ) ) {
                         add_light_from_items( p, i_at( p ) );
                     }
 
@@ -492,11 +526,16 @@ void map::generate_lightmap( const int zlev )
                     if( terrain->light_emitted > 0 ) {
                         add_light_source( p, terrain->light_emitted );
                     }
-                    const furn_id &furniture = cur_submap->get_furn( {sx, sy } );
-                    if( furniture->light_emitted > 0 ) {
-                        add_light_source( p, furniture->light_emitted );
+                    if( has_furn ) {
+                        const furn_id &furniture = cur_submap->get_furn( {sx, sy } );
+                        if( furniture->light_emitted > 0 ) {
+                            add_light_source( p, furniture->light_emitted );
+                        }
                     }
 
+                    if( !cur_submap->may_have_field( { sx, sy } ) ) {
+                        continue;
+                    }
                     for( const auto &fld : cur_submap->get_field( { sx, sy } ) ) {
                         const field_entry *cur = &fld.second;
                         const int light_emitted = cur->get_intensity_level().light_emitted;
@@ -616,18 +655,131 @@ void map::generate_lightmap( const int zlev )
         unbuffered: (12^2)*(160*4) = apply_light_ray x 92160
         buffered:   (12*4)*(160)   = apply_light_ray x 7680
     */
-    const tripoint_bub_ms cache_start( 0, 0, zlev );
-    const tripoint_bub_ms cache_end( LIGHTMAP_CACHE_X, LIGHTMAP_CACHE_Y, zlev );
-    for( const tripoint_bub_ms &p : points_in_rectangle( cache_start, cache_end ) ) {
-        if( light_source_buffer[p.x()][p.y()] > 0.0 ) {
-            apply_light_source( p, light_source_buffer[p.x()][p.y()] );
-        }
-    }
+    apply_buffered_light_sources( zlev );
     for( const std::pair<tripoint_bub_ms, float> &elem : lm_override ) {
         lm[elem.first.x()][elem.first.y()].fill( elem.second );
     }
 }
 
+// Upper bound on how far apply_light_source can change the light map.  light_calc drops at
+// least as fast as 1 / distance, and casting stops at LIGHT_AMBIENT_LOW.
+static int light_source_reach( float luminance )
+{
+    if( luminance <= lit_level::LOW ) {
+        return 0;
+    }
+    return std::min( 60, static_cast<int>( std::max( luminance, 1.49f ) / LIGHT_AMBIENT_LOW ) + 2 );
+}
+
+static inclusive_rectangle<point> light_source_area( const point &p, float luminance )
+{
+    const int reach = light_source_reach( luminance );
+    return inclusive_rectangle<point>( p - point( reach, reach ), p + point( reach, reach ) );
+}
+
+static void extend( std::optional<inclusive_rectangle<point>> &area,
+                    const inclusive_rectangle<point> &r )
+{
+    if( !area ) {
+        area = r;
+        return;
+    }
+    area->p_min.x = std::min( area->p_min.x, r.p_min.x );
+    area->p_min.y = std::min( area->p_min.y, r.p_min.y );
+    area->p_max.x = std::max( area->p_max.x, r.p_max.x );
+    area->p_max.y = std::max( area->p_max.y, r.p_max.y );
+}
+
+void map::apply_buffered_light_sources( const int zlev )
+{
+    level_cache &map_cache = get_cache( zlev );
+    if( !map_cache.buffered_light ) {
+        map_cache.buffered_light = cata::make_value<buffered_light_cache>();
+    }
+    buffered_light_cache &layer = *map_cache.buffered_light;
+    const cata::mdarray<float, point_bub_ms> &sources = map_cache.light_source_buffer;
+    const cata::mdarray<float, point_bub_ms> &transparency = map_cache.transparency_cache;
+
+    // The light of a source only depends on its luminance, the luminance of its neighbours
+    // and the transparency within its reach.  Find the tiles where any of that changed.
+    std::optional<inclusive_rectangle<point>> changed;
+    if( layer.valid ) {
+        for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+                if( sources[x][y] != layer.sources[x][y] ||
+                    transparency[x][y] != layer.transparency[x][y] ) {
+                    extend( changed, inclusive_rectangle<point>( point( x, y ), point( x, y ) ) );
+                }
+            }
+        }
+    }
+
+    bool rebuild_all = !layer.valid;
+    std::optional<inclusive_rectangle<point>> recast;
+    if( changed ) {
+        // Light of sources reaching the change, as they were or as they are now, is stale.
+        for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+                for( const float luminance : { layer.sources[x][y], sources[x][y] } ) {
+                    if( luminance <= 0.0f ) {
+                        continue;
+                    }
+                    const inclusive_rectangle<point> area = light_source_area( point( x, y ), luminance );
+                    if( area.overlaps( *changed ) ) {
+                        extend( recast, area );
+                    }
+                }
+            }
+        }
+        if( recast ) {
+            const point size = recast->p_max - recast->p_min + point( 1, 1 );
+            // Past this the bookkeeping costs more than casting everything again.
+            rebuild_all = size.x * size.y * 2 > LIGHTMAP_CACHE_X * LIGHTMAP_CACHE_Y;
+        }
+    }
+
+    if( rebuild_all ) {
+        layer.lm.fill( four_quadrants{} );
+        layer.sm.fill( 0 );
+        recast = inclusive_rectangle<point>( point_zero, point( LIGHTMAP_CACHE_X - 1,
+                                             LIGHTMAP_CACHE_Y - 1 ) );
+    } else if( recast ) {
+        for( int x = std::max( recast->p_min.x, 0 ); x <= std::min( recast->p_max.x,
+                LIGHTMAP_CACHE_X - 1 ); ++x ) {
+            for( int y = std::max( recast->p_min.y, 0 ); y <= std::min( recast->p_max.y,
+                    LIGHTMAP_CACHE_Y - 1 ); ++y ) {
+                layer.lm[x][y] = four_quadrants{};
+                layer.sm[x][y] = 0;
+            }
+        }
+    }
+
+    if( recast ) {
+        // Casting is idempotent under max, so sources that only partially overlap the
+        // cleared area can simply be cast again in full.
+        for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+            for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+                const float luminance = sources[x][y];
+                if( luminance > 0.0f && light_source_area( point( x, y ), luminance ).overlaps( *recast ) ) {
+                    apply_light_source( tripoint_bub_ms( x, y, zlev ), luminance, layer.lm, layer.sm );
+                }
+            }
+        }
+        layer.sources = sources;
+        layer.transparency = transparency;
+        layer.valid = true;
+    }
+
+    cata::mdarray<four_quadrants, point_bub_ms> &lm = map_cache.lm;
+    cata::mdarray<float, point_bub_ms> &sm = map_cache.sm;
+    for( int x = 0; x < LIGHTMAP_CACHE_X; ++x ) {
+        for( int y = 0; y < LIGHTMAP_CACHE_Y; ++y ) {
+            lm[x][y] = elementwise_max( lm[x][y], layer.lm[x][y] );
+            sm[x][y] = std::max( sm[x][y], layer.sm[x][y] );
+        }
+    }
+}
+
 void map::add_light_source( const tripoint_bub_ms &p, float luminance )
 {
     auto &light_source_buffer = get_cache( p.z() ).light_source_buffer;
@@ -848,6 +1000,23 @@ static constexpr quadrant quadrant_from_x_y( int x, int y )
            ( ( y > 0 ) ? quadrant::NE : quadrant::SE );
 }
 
+// Narrows [first, last] to the values of d for which base + d * step is within [0, size).
+template<int step>
+static void clip_row( int base, int size, int &first, int &last )
+{
+    if constexpr( step == 0 ) {
+        if( base < 0 || base >= size ) {
+            last = first - 1;
+        }
+    } else if constexpr( step > 0 ) {
+        first = std::max( first, -base );
+        last = std::min( last, size - 1 - base );
+    } else {
+        first = std::max( first, base - size + 1 );
+        last = std::min( last, base );
+    }
+}
+
 template<int xx, int xy, int yx, int yy, typename T, typename Out,
          T( *calc )( const T &, const T &, const int & ),
          bool( *check )( const T &, const T & ),
@@ -877,6 +1046,7 @@ void castLight( cata::mdarray<Out, point_bub_ms> &output_cache,
         return;
     }
     T last_intensity( 0.0 );
+    cached_calc<T, calc> intensity_at( numerator );
     tripoint delta;
     for( int distance = row; distance <= radius; distance++ ) {
         delta.y = -distance;
@@ -887,16 +1057,17 @@ void castLight( cata::mdarray<Out, point_bub_ms> &output_cache,
 
         //We initialize delta.x to -distance adjusted so that the commented start < leadingEdge condition below is never false
         delta.x = -distance + std::max( static_cast<int>( std::ceil( away * ( -distance - 0.5f ) ) ), 0 );
+        // Clip the row to the map up front instead of testing every tile.
+        int last_x = 0;
+        clip_row<xx>( offset.x() + delta.y * xy, MAPSIZE_X, delta.x, last_x );
+        clip_row<yx>( offset.y() + delta.y * yy, MAPSIZE_Y, delta.x, last_x );
 
-        for( ; delta.x <= 0; delta.x++ ) {
+        for( ; delta.x <= last_x; delta.x++ ) {
             point current( offset.x() + delta.x * xx + delta.y * xy, offset.y() + delta.x * yx + delta.y * yy );
             float trailingEdge = ( delta.x - 0.5f ) / ( delta.y + 0.5f );
             float leadingEdge = ( delta.x + 0.5f ) / ( delta.y - 0.5f );
 
-            if( !( current.x >= 0 && current.y >= 0 && current.x < MAPSIZE_X &&
-                   current.y < MAPSIZE_Y ) /* || start < leadingEdge */ ) {
-                continue;
-            } else if( end > trailingEdge ) {
+            if( end > trailingEdge ) {
                 break;
             }
             if( !started_row ) {
@@ -905,7 +1076,7 @@ void castLight( cata::mdarray<Out, point_bub_ms> &output_cache,
             }
 
             const int dist = rl_dist( tripoint_zero, delta ) + offsetDistance;
-            last_intensity = calc( numerator, cumulative_transparency, dist );
+            last_intensity = intensity_at( cumulative_transparency, dist );
 
             T new_transparency = input_array[ current.x ][ current.y ];
 
@@ -1187,8 +1358,15 @@ static bool light_check( const float &transparency, const float &intensity )
 void map::apply_light_source( const tripoint_bub_ms &p, float luminance )
 {
     level_cache &cache = get_cache( p.z() );
-    cata::mdarray<four_quadrants, point_bub_ms> &lm = cache.lm;
-    cata::mdarray<float, point_bub_ms> &sm = cache.sm;
+    cache.sunlight_only = false;
+    apply_light_source( p, luminance, cache.lm, cache.sm );
+}
+
+void map::apply_light_source( const tripoint_bub_ms &p, float luminance,
+                              cata::mdarray<four_quadrants, point_bub_ms> &lm,
+                              cata::mdarray<float, point_bub_ms> &sm )
+{
+    level_cache &cache = get_cache( p.z() );
     cata::mdarray<float, point_bub_ms> &transparency_cache =
         cache.transparency_cache;
     cata::mdarray<float, point_bub_ms> &light_source_buffer =
@@ -1271,6 +1449,7 @@ void map::apply_directional_light( const tripoint_bub_ms &p, int direction, floa
     const point_bub_ms p2( p.xy() );
 
     level_cache &cache = get_cache( p.z() );
+    cache.sunlight_only = false;
     cata::mdarray<four_quadrants, point_bub_ms> &lm = cache.lm;
     cata::mdarray<float, point_bub_ms> &transparency_cache =
         cache.transparency_cache;
@@ -1318,6 +1497,7 @@ void map::apply_light_arc( const tripoint_bub_ms &p, const units::angle &angle,
     const point_bub_ms p2( p.xy() );
 
     level_cache &cache = get_cache( p.z() );
+    cache.sunlight_only = false;
     cata::mdarray<four_quadrants, point_bub_ms> &lm = cache.lm;
     cata::mdarray<float, point_bub_ms> &transparency_cache =
         cache.transparency_cache;
@@ -1409,6 +1589,7 @@ void map::apply_light_ray(
         return;
     }
 
+    get_cache( s.z ).sunlight_only = false;
     auto &lm = get_cache( s.z ).lm;
     auto &transparency_cache = get_cache( s.z ).transparency_cache;
 
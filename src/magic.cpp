@@ -3274,6 +3274,11 @@ spell fake_spell::get_spell() const
     return sp;
 }
 
+bool spell_events::wants( const event_type type ) const
+{
+    return type == event_type::player_levels_spell;
+}
+
 void spell_events::notify( const cata::event &e )
 {
     switch( e.type() ) {
@@ -202,6 +202,7 @@ class spell_events : public event_subscriber
     public:
         using event_subscriber::notify;
         void notify( const cata::event & ) override;
+        bool wants( event_type ) const override;
 };
 
 class spell_type
@@ -505,10 +505,10 @@ void enchant_cache::load( const JsonObject &jo, const std::string_view,
                 const double mult = value_obj.has_float( "multiply" ) ? value_obj.get_float( "multiply",
                                     0.0 ) : 0.0;
                 if( add != 0 ) {
-                    values_add.emplace( value, add );
+                    values_add[value] = add;
                 }
                 if( mult != 0.0 ) {
-                    values_multiply.emplace( value, mult );
+                    values_multiply[value] = mult;
                 }
             } catch( ... ) {
                 if( legacy_values.find( value_obj.get_string( "value", "" ) ) == legacy_values.end() ) {
@@ -675,14 +675,11 @@ bool enchant_cache::add( const enchant_cache &rhs )
 
 void enchant_cache::force_add( const enchant_cache &rhs )
 {
-    for( const std::pair<const enchant_vals::mod, double> &pair_values :
-         rhs.values_add ) {
-        values_add[pair_values.first] += pair_values.second;
-    }
-    for( const std::pair<const enchant_vals::mod, double> &pair_values : rhs.values_multiply ) {
+    for( size_t i = 0; i < values_add.values.size(); ++i ) {
+        values_add.values[i] += rhs.values_add.values[i];
         // values do not multiply against each other, they add.
         // so +10% and -10% will add to 0%
-        values_multiply[pair_values.first] += pair_values.second;
+        values_multiply.values[i] += rhs.values_multiply.values[i];
     }
 
     for( const std::pair<const skill_id, int> &pair_values :
@@ -964,11 +961,7 @@ double enchantment::get_value_multiply( const enchant_vals::mod value, const Cha
 
 double enchant_cache::get_value_add( const enchant_vals::mod value ) const
 {
-    const auto found = values_add.find( value );
-    if( found == values_add.cend() ) {
-        return 0;
-    }
-    return found->second;
+    return values_add[value];
 }
 
 int enchant_cache::get_skill_value_add( const skill_id &value ) const
@@ -991,11 +984,7 @@ int enchant_cache::get_damage_add( const damage_type_id &value ) const
 
 double enchant_cache::get_value_multiply( const enchant_vals::mod value ) const
 {
-    const auto found = values_multiply.find( value );
-    if( found == values_multiply.cend() ) {
-        return 0;
-    }
-    return found->second;
+    return values_multiply[value];
 }
 
 double enchant_cache::get_skill_value_multiply( const skill_id &value ) const
@@ -1206,28 +1195,8 @@ void enchant_cache::clear()
 
 bool enchant_cache::operator==( const enchant_cache &rhs ) const
 {
-    if( this->values_add.size() != rhs.values_add.size() ||
-        this->values_multiply.size() != rhs.values_multiply.size() ) {
-        return false;
-    }
-    auto iter_add = this->values_add.cbegin();
-    auto iter_add2 = rhs.values_add.cbegin();
-    while( iter_add != this->values_add.cend() && iter_add2 != rhs.values_add.cend() ) {
-        if( iter_add->second != iter_add2->second || iter_add->first != iter_add2->first ) {
-            return false;
-        }
-        iter_add++;
-        iter_add2++;
-    }
-    auto iter_mult = this->values_multiply.cbegin();
-    auto iter_mult2 = rhs.values_multiply.cbegin();
-    while( iter_mult != this->values_multiply.cend() && iter_mult2 != rhs.values_multiply.cend() ) {
-        if( iter_mult->second != iter_mult2->second || iter_mult->first != iter_mult2->first ) {
-            return false;
-        }
-        iter_mult++;
-        iter_mult2++;
-    }
-    return this->id == rhs.id &&
+    return this->values_add == rhs.values_add &&
+           this->values_multiply == rhs.values_multiply &&
+           this->id == rhs.id &&
            this->get_mutations() == rhs.get_mutations();
 }
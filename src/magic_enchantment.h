@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_MAGIC_ENCHANTMENT_H
 #define CATA_SRC_MAGIC_ENCHANTMENT_H
 
+#include <array>
 #include <iosfwd>
 #include <map>
 #include <new>
@@ -340,10 +341,29 @@ class enchant_cache : public enchantment
         std::vector<std::pair<std::string, std::string>> details; // NOLINT(cata-serialize)
 
     private:
-        std::map<enchant_vals::mod, double> values_add; // NOLINT(cata-serialize)
+        // Dense per-mod totals, so that the many per-turn lookups are a plain index
+        // instead of a map search. Mods that are not affected stay at 0.
+        struct mod_table {
+            std::array<double, static_cast<size_t>( enchant_vals::mod::NUM_MOD )> values{};
+
+            double &operator[]( enchant_vals::mod value ) {
+                return values[static_cast<size_t>( value )];
+            }
+            double operator[]( enchant_vals::mod value ) const {
+                return values[static_cast<size_t>( value )];
+            }
+            bool operator==( const mod_table &rhs ) const {
+                return values == rhs.values;
+            }
+            void clear() {
+                values.fill( 0.0 );
+            }
+        };
+
+        mod_table values_add; // NOLINT(cata-serialize)
         // values that get multiplied to the base value
         // multipliers add to each other instead of multiply against themselves
-        std::map<enchant_vals::mod, double> values_multiply; // NOLINT(cata-serialize)
+        mod_table values_multiply; // NOLINT(cata-serialize)
 
         // the exact same as above, though specifically for skills
         std::map<skill_id, int> skill_values_add; // NOLINT(cata-serialize)
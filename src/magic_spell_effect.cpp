@@ -3,6 +3,7 @@
 #include <climits>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <iosfwd>
 #include <iterator>
@@ -146,6 +147,69 @@ static void build_line( spell_detail::line_iterable line, const tripoint_bub_ms
         line.next();
     }
 }
+
+// The tiles within a square radius of an AoE origin on its z-level.  Remembers which of them
+// are passable and which belong to the area, so shapes tracing many overlapping lines check
+// each tile once and don't insert every hit into a set.
+class aoe_grid
+{
+    public:
+        aoe_grid( const tripoint_bub_ms &center, int radius )
+            : center( center ), radius( radius ), side( 2 * radius + 1 ),
+              cells( static_cast<size_t>( side ) * side, 0 ) {}
+
+        bool passable( const tripoint_bub_ms &p ) {
+            uint8_t *c = cell( p );
+            if( c == nullptr ) {
+                return get_map().passable( p );
+            }
+            if( !( *c & known ) ) {
+                *c |= get_map().passable( p ) ? known | open : known;
+            }
+            return *c & open;
+        }
+
+        void add( const tripoint_bub_ms &p ) {
+            if( uint8_t *c = cell( p ) ) {
+                *c |= in_area;
+            } else {
+                outside.push_back( p );
+            }
+        }
+
+        std::set<tripoint_bub_ms> area() const {
+            std::vector<tripoint_bub_ms> points = outside;
+            for( size_t i = 0; i < cells.size(); ++i ) {
+                if( cells[i] & in_area ) {
+                    const int x = static_cast<int>( i ) / side - radius;
+                    const int y = static_cast<int>( i ) % side - radius;
+                    points.emplace_back( center + tripoint( x, y, 0 ) );
+                }
+            }
+            // Sorted input lets the set append each point instead of searching for its place.
+            std::sort( points.begin(), points.end() );
+            return std::set<tripoint_bub_ms>( points.begin(), points.end() );
+        }
+
+    private:
+        static constexpr uint8_t known = 1;
+        static constexpr uint8_t open = 2;
+        static constexpr uint8_t in_area = 4;
+
+        uint8_t *cell( const tripoint_bub_ms &p ) {
+            const point d = ( p - center ).xy().raw() + point( radius, radius );
+            if( p.z() != center.z() || d.x < 0 || d.y < 0 || d.x >= side || d.y >= side ) {
+                return nullptr;
+            }
+            return &cells[static_cast<size_t>( d.x ) * side + d.y];
+        }
+
+        tripoint_bub_ms center;
+        int radius;
+        int side;
+        std::vector<uint8_t> cells;
+        std::vector<tripoint_bub_ms> outside;
+};
 } // namespace spell_detail
 
 void spell_effect::short_range_teleport( const spell &sp, Creature &caster,
@@ -208,7 +272,7 @@ void spell_effect::pain_split( const spell &sp, Creature &caster, const tripoint
 }
 
 static bool in_spell_aoe( const tripoint_bub_ms &start, const tripoint_bub_ms &end,
-                          const int &radius, const bool ignore_walls )
+                          const int &radius, const bool ignore_walls, spell_detail::aoe_grid &grid )
 {
     if( rl_dist( start, end ) > radius ) {
         return false;
@@ -216,10 +280,9 @@ static bool in_spell_aoe( const tripoint_bub_ms &start, const tripoint_bub_ms &e
     if( ignore_walls ) {
         return true;
     }
-    map &here = get_map();
     const std::vector<tripoint_bub_ms> trajectory = line_to( start, end );
     for( const tripoint_bub_ms &pt : trajectory ) {
-        if( here.impassable( pt ) ) {
+        if( !grid.passable( pt ) ) {
             return false;
         }
     }
@@ -229,51 +292,55 @@ static bool in_spell_aoe( const tripoint_bub_ms &start, const tripoint_bub_ms &e
 std::set<tripoint_bub_ms> spell_effect::spell_effect_blast( const override_parameters &params,
         const tripoint_bub_ms &, const tripoint_bub_ms &target )
 {
-    std::set<tripoint_bub_ms> targets;
+    spell_detail::aoe_grid grid( target, std::max( params.aoe_radius, 0 ) );
     // TODO: Make this breadth-first
     for( const tripoint_bub_ms &potential_target : get_map().points_in_radius( target,
             params.aoe_radius ) ) {
-        if( in_spell_aoe( target, potential_target, params.aoe_radius, params.ignore_walls ) ) {
-            targets.emplace( potential_target );
+        if( in_spell_aoe( target, potential_target, params.aoe_radius, params.ignore_walls,
+                          grid ) ) {
+            grid.add( potential_target );
         }
     }
-    return targets;
+    return grid.area();
 }
 
 static std::set<tripoint_bub_ms> spell_effect_cone_range_override(
     const spell_effect::override_parameters &params, const tripoint_bub_ms &source,
     const tripoint_bub_ms &target )
 {
-    std::set<tripoint_bub_ms> targets;
+    // Ray ends round to at most one tile past the range.
+    spell_detail::aoe_grid grid( source, std::max( params.range, 0 ) + 1 );
     const units::angle initial_angle = coord_to_angle( source.raw(), target.raw() );
     const units::angle half_width = units::from_degrees( params.aoe_radius / 2.0 );
     const units::angle start_angle = initial_angle - half_width;
     const units::angle end_angle = initial_angle + half_width;
-    std::set<tripoint_bub_ms> end_points;
+    std::vector<tripoint_bub_ms> end_points;
     for( units::angle angle = start_angle; angle <= end_angle; angle += 1_degrees ) {
         for( int range = 1; range <= params.range; range++ ) {
             tripoint potential;
             calc_ray_end( angle, range, source.raw(), potential );
             if( params.ignore_walls ) {
-                targets.emplace( potential );
+                grid.add( tripoint_bub_ms( potential ) );
             } else {
-                end_points.emplace( potential );
+                end_points.emplace_back( potential );
             }
         }
     }
     if( !params.ignore_walls ) {
-        map &here = get_map();
+        std::sort( end_points.begin(), end_points.end() );
+        end_points.erase( std::unique( end_points.begin(), end_points.end() ), end_points.end() );
         for( const tripoint_bub_ms &ep : end_points ) {
             std::vector<tripoint_bub_ms> trajectory = line_to( source, ep );
             for( const tripoint_bub_ms &tp : trajectory ) {
-                if( here.passable( tp ) ) {
-                    targets.emplace( tp );
+                if( grid.passable( tp ) ) {
+                    grid.add( tp );
                 } else {
                     break;
                 }
             }
         }
     }
+    std::set<tripoint_bub_ms> targets = grid.area();
     // we don't want to hit ourselves in the blast!
     targets.erase( source );
     return targets;
@@ -1761,11 +1828,7 @@ void spell_effect::dash( const spell &sp, Creature &caster, const tripoint_bub_m
     const std::vector<tripoint_bub_ms> trajectory_local = line_to( source, target );
     ::map &here = get_map();
     // uses abs() coordinates
-    std::vector<tripoint_abs_ms> trajectory;
-    trajectory.reserve( trajectory_local.size() );
-    for( const tripoint_bub_ms &local_point : trajectory_local ) {
-        trajectory.push_back( here.getglobal( local_point ) );
-    }
+    std::vector<tripoint_abs_ms> trajectory = here.getglobal( trajectory_local );
     avatar *caster_you = caster.as_avatar();
     auto walk_point = trajectory.begin();
     if( here.bub_from_abs( *walk_point ) == source ) {
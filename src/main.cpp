@@ -19,6 +19,7 @@
 #include <iostream>
 #include <map>
 #include <memory>
+#include <optional>
 #include <string>
 #include <utility>
 #include <vector>
@@ -47,6 +48,7 @@
 #include "get_version.h"
 #include "help.h"
 #include "input.h"
+#include "input_journal.h"
 #include "main_menu.h"
 #include "mapsharing.h"
 #include "memory_fast.h"
@@ -279,6 +281,7 @@ struct cli_opts {
     bool check_mods = false;
     std::vector<std::string> opts;
     std::string world; /** if set try to load first save in this world on startup */
+    std::string replay; /** if set replay this input journal in the first game loaded */
     bool disable_ascii_art = false;
 };
 
@@ -347,6 +350,16 @@ cli_opts parse_commandline( int argc, const char **argv )
                     return 1;
                 }
             },
+            {
+                "--replay", "<file>",
+                "Replay an input journal in the first game loaded, see the debug menu",
+                section_default,
+                1,
+                [&result]( int, const char **params ) -> int {
+                    result.replay = params[0];
+                    return 1;
+                }
+            },
             {
                 "--basepath", "<path>",
                 "Base path for all game data subdirectories",
@@ -859,6 +872,13 @@ int main( int argc, const char *argv[] )
 
             shared_ptr_fast<ui_adaptor> ui = g->create_or_get_main_ui_adaptor();
             get_event_bus().send<event_type::game_begin>( getVersionString() );
+            if( !cli.replay.empty() ) {
+                if( std::optional<input_journal::journal> journal = input_journal::read_journal(
+                            cata_path( cata_path::root_path::unknown, cli.replay ) ) ) {
+                    input_journal::start_replay( *journal );
+                }
+                cli.replay.clear();
+            }
             while( !do_turn() ) { }
         } catch( game::exit_exception const &/* ex */ ) {
             break;
@@ -14,6 +14,7 @@
 #include <utility>
 
 #include "active_item_cache.h"
+#include "alloc_profiler.h"
 #include "ammo.h"
 #include "ammo_effect.h"
 #include "avatar.h"
@@ -91,6 +92,7 @@
 #include "sounds.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "tileray.h"
 #include "translations.h"
 #include "trap.h"
@@ -234,12 +236,12 @@ void map_stack::insert( const item &newitem )
 
 units::volume map_stack::max_volume() const
 {
-    if( !myorigin->inbounds( location ) ) {
-        return 0_ml;
-    } else if( myorigin->has_furn( location ) ) {
-        return myorigin->furn( location ).obj().max_volume;
-    }
-    return myorigin->ter( location ).obj().max_volume;
+    return myorigin->max_volume( location );
+}
+
+units::volume map_stack::stored_volume() const
+{
+    return myorigin->stored_volume( location );
 }
 
 // Map class methods.
@@ -257,6 +259,7 @@ map::map( int mapsize, bool zlev ) : my_MAPSIZE( mapsize ), my_HALF_MAPSIZE( map
     for( auto &ptr : pathfinding_caches ) {
         ptr = std::make_unique<pathfinding_cache>();
     }
+    clear_visibility_fields();
 
     dbg( D_INFO ) << "map::map(): my_MAPSIZE: " << my_MAPSIZE << " z-levels enabled:" << zlevels;
     traplocs.resize( trap::count() );
@@ -326,7 +329,7 @@ void map::set_outside_cache_dirty( const int zlev )
 void map::set_floor_cache_dirty( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
-        get_cache( zlev ).floor_cache_dirty = true;
+        get_cache( zlev ).floor_cache_dirty.set();
     }
 }
 
@@ -402,9 +405,12 @@ void map::invalidate_map_cache( const int zlev )
 {
     if( inbounds_z( zlev ) ) {
         level_cache &ch = get_cache( zlev );
-        ch.floor_cache_dirty = true;
+        ch.floor_cache_dirty.set();
         ch.seen_cache_dirty = true;
         ch.outside_cache_dirty = true;
+        if( ch.buffered_light ) {
+            ch.buffered_light->valid = false;
+        }
         set_transparency_cache_dirty( zlev );
     }
 }
@@ -488,6 +494,11 @@ void map::add_vehicle_to_cache( vehicle *veh )
         debugmsg( "Tried to add null vehicle to cache" );
         return;
     }
+    // veh_at() can now resolve cables to this vehicle
+    vehicle::invalidate_power_grids();
+
+    // Only this vehicle's own points change, whatever else is cached stays as it is.
+    clear_vehicle_parts_from_cache( veh );
 
     // Get parts
     for( const vpart_reference &vpr : veh->get_all_parts_with_fakes() ) {
@@ -500,7 +511,16 @@ void map::add_vehicle_to_cache( vehicle *veh )
         if( inbounds( p ) ) {
             ch.set_veh_exists_at( p.raw(), true );
         }
+        veh->cached_part_points.push_back( p );
+    }
+}
+
+void map::clear_vehicle_parts_from_cache( vehicle *veh )
+{
+    for( const tripoint_bub_ms &p : veh->cached_part_points ) {
+        clear_vehicle_point_from_cache( veh, p );
     }
+    veh->cached_part_points.clear();
 }
 
 void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint_bub_ms &pt )
@@ -511,11 +531,9 @@ void map::clear_vehicle_point_from_cache( vehicle *veh, const tripoint_bub_ms &p
     }
 
     level_cache *ch = get_cache_lazy( pt.z() );
-    if( ch ) {
-        if( inbounds( pt ) ) {
-            ch->set_veh_exists_at( pt.raw(), false );
-        }
-        ch->clear_veh_from_veh_cached_parts( pt.raw(), veh );
+    // The point may have been taken over by another vehicle since, that one stays.
+    if( ch && ch->clear_veh_from_veh_cached_parts( pt.raw(), veh ) && inbounds( pt ) ) {
+        ch->set_veh_exists_at( pt.raw(), false );
     }
 }
 
@@ -635,11 +653,12 @@ std::unique_ptr<vehicle> map::detach_vehicle( vehicle *veh )
             ch.zone_vehicles.erase( veh );
             std::unique_ptr<vehicle> result = std::move( current_submap->vehicles[i] );
             current_submap->vehicles.erase( current_submap->vehicles.begin() + i );
+            current_submap->mark_modified();
             if( veh->tracking_on ) {
                 overmap_buffer.remove_vehicle( veh );
             }
             dirty_vehicle_list.erase( veh );
-            rebuild_vehicle_level_caches();
+            clear_vehicle_parts_from_cache( veh );
             set_pathfinding_cache_dirty( z );
             return result;
         }
@@ -1461,6 +1480,7 @@ void map::unboard_vehicle( const tripoint_bub_ms &p, bool dead_passenger )
 bool map::displace_vehicle( vehicle &veh, const tripoint_rel_ms &dp, const bool adjust_pos,
                             const std::set<int> &parts_to_move )
 {
+    vehicle::invalidate_power_grids();
     const tripoint_bub_ms src = veh.pos_bub();
     // handle vehicle ramps
     int ramp_offset = 0;
@@ -1612,6 +1632,7 @@ bool map::displace_vehicle( vehicle &veh, const tripoint_rel_ms &dp, const bool
         auto src_submap_veh_it = src_submap->vehicles.begin() + our_i;
         dst_submap->vehicles.push_back( std::move( *src_submap_veh_it ) );
         src_submap->vehicles.erase( src_submap_veh_it );
+        src_submap->mark_modified();
         invalidate_max_populated_zlev( dst.z() );
     }
     if( need_update ) {
@@ -3850,7 +3871,7 @@ bool map::terrain_moppable( const tripoint_bub_ms &p )
     // Moppable vehicles ( blood splatter )
     if( const optional_vpart_position ovp = veh_at( p ) ) {
         vehicle *const veh = &ovp->vehicle();
-        for( const int elem : veh->parts_at_relative( ovp->mount(), true ) ) {
+        for( const int elem : veh->cached_parts_at_relative( ovp->mount_pos() ) ) {
             const vehicle_part &vp = veh->part( elem );
             if( vp.blood > 0 ) {
                 return true;
@@ -3895,7 +3916,7 @@ bool map::mop_spills( const tripoint_bub_ms &p )
 
     if( const optional_vpart_position ovp = veh_at( p ) ) {
         vehicle *const veh = &ovp->vehicle();
-        for( const int elem : veh->parts_at_relative( ovp->mount(), true ) ) {
+        for( const int elem : veh->cached_parts_at_relative( ovp->mount_pos() ) ) {
             vehicle_part &vp = veh->part( elem );
             if( vp.blood > 0 ) {
                 vp.blood = 0;
@@ -5222,8 +5243,9 @@ map_stack::iterator map::i_rem( const tripoint_bub_ms &p, const map_stack::const
     }
 
     current_submap->update_lum_rem( l, *it );
+    items_revision++;
 
-    return current_submap->get_items( l ).erase( it );
+    return current_submap->erase_item( l, it );
 }
 
 void map::i_rem( const tripoint &p, item *it )
@@ -5256,6 +5278,7 @@ void map::i_clear( const tripoint_bub_ms &p )
 
     current_submap->set_lum( l, 0 );
     current_submap->get_items( l ).clear();
+    items_revision++;
 }
 
 std::vector<item *> map::spawn_items( const tripoint_bub_ms &p, const std::vector<item> &new_items )
@@ -5346,13 +5369,30 @@ void map::spawn_item( const tripoint_bub_ms &p, const itype_id &type_id, const u
 
 units::volume map::max_volume( const tripoint_bub_ms &p )
 {
-    return i_at( p ).max_volume();
+    if( !inbounds( p ) ) {
+        return 0_ml;
+    } else if( has_furn( p ) ) {
+        return furn( p ).obj().max_volume;
+    }
+    return ter( p ).obj().max_volume;
 }
 
 // total volume of all the things
 units::volume map::stored_volume( const tripoint_bub_ms &p )
 {
-    return i_at( p ).stored_volume();
+    if( !inbounds( p ) ) {
+        return 0_ml;
+    }
+
+    point_sm_ms l;
+    const submap *const current_submap = unsafe_get_submap_at( p, l );
+    if( current_submap == nullptr ) {
+        debugmsg( "Tried to get item volume at (%d,%d) but the submap is not loaded",
+                  l.x(), l.y() );
+        return 0_ml;
+    }
+
+    return current_submap->get_stored_volume( l );
 }
 
 // free space
@@ -5363,7 +5403,7 @@ units::volume map::free_volume( const tripoint &p )
 
 units::volume map::free_volume( const tripoint_bub_ms &p )
 {
-    return i_at( p ).free_volume();
+    return max_volume( p ) - stored_volume( p );
 }
 
 item_location map::add_item_ret_loc( const tripoint_bub_ms &pos, item obj, bool overflow )
@@ -5417,18 +5457,25 @@ std::pair<item *, tripoint_bub_ms> map::_add_item_or_charges( const tripoint_bub
 
     // Get how many copies of the item can fit in a tile
     auto how_many_copies_fit = [&]( const tripoint_bub_ms & e ) {
+        // Not through i_at, which would make the tile forget its stored volume.
+        point_sm_ms l;
+        const submap *const current_submap = unsafe_get_submap_at( e, l );
+        const int items_here = current_submap == nullptr ? 0 :
+                               static_cast<int>( current_submap->get_items( l ).size() );
         return std::min( { copies_remaining,
                            obj.volume() == 0_ml ? INT_MAX : free_volume( e ) / obj.volume(),
-                           static_cast<int>( MAX_ITEM_IN_SQUARE - i_at( e ).size() ) } );
+                           MAX_ITEM_IN_SQUARE - items_here } );
     };
 
     // Performs the actual insertion of the object onto the map
     auto place_item = [&]( const tripoint_bub_ms & tile, int &copies ) -> item& {
         if( obj.count_by_charges() )
         {
-            for( item &e : i_at( tile ) ) {
-                if( e.merge_charges( obj ) ) {
-                    return e;
+            point_sm_ms l;
+            submap *const current_submap = unsafe_get_submap_at( tile, l );
+            if( current_submap != nullptr ) {
+                if( item *merged = current_submap->merge_charges( l, obj ) ) {
+                    return *merged;
                 }
             }
         }
@@ -5603,11 +5650,9 @@ item &map::add_item( const tripoint_bub_ms &p, item new_item, int copies )
     invalidate_max_populated_zlev( p.z() );
 
     current_submap->update_lum_add( l, new_item );
+    items_revision++;
 
-    const map_stack::iterator new_pos = current_submap->get_items( l ).insert( new_item );
-    while( --copies > 0 ) {
-        current_submap->get_items( l ).insert( new_item );
-    }
+    const map_stack::iterator new_pos = current_submap->insert_items( l, new_item, copies );
 
     if( current_submap->active_items.add( *new_pos, l ) ) {
         // TODO: fix point types
@@ -5694,6 +5739,23 @@ void map::update_lum( item_location &loc, bool add )
     }
 }
 
+// Erases an item that processing destroyed from the map stack, unless processing already did.
+static void remove_processed_item( item_stack &items, safe_reference<item> &item_ref,
+                                   item *parent, const tripoint_bub_ms &location )
+{
+    if( item_ref ) {
+        item_ref->spill_contents( location );
+        if( parent != nullptr ) {
+            parent->remove_item( *item_ref );
+        } else {
+            items.erase( items.get_iterator_from_pointer( item_ref.get() ) );
+        }
+    }
+    if( parent != nullptr ) {
+        parent->on_contents_changed();
+    }
+}
+
 static bool process_map_items( map &here, item_stack &items, safe_reference<item> &item_ref,
                                item *parent, const tripoint_bub_ms &location, float insulation,
                                temperature_flag flag, float spoil_multiplier, bool watertight_container )
@@ -5701,24 +5763,92 @@ static bool process_map_items( map &here, item_stack &items, safe_reference<item
     if( item_ref->process( here, nullptr, location, insulation, flag, spoil_multiplier,
                            watertight_container, false ) ) {
         // Item is to be destroyed so erase it from the map stack
-        // unless it was already destroyed by processing.
-        if( item_ref ) {
-            item_ref->spill_contents( location );
-            if( parent != nullptr ) {
-                parent->remove_item( *item_ref );
-            } else {
-                items.erase( items.get_iterator_from_pointer( item_ref.get() ) );
-            }
-        }
-        if( parent != nullptr ) {
-            parent->on_contents_changed();
-        }
+        remove_processed_item( items, item_ref, parent, location );
         return true;
     }
     // Item not destroyed
     return false;
 }
 
+/** An item handed out for processing, and how it is stored on its tile. */
+struct map_item_to_process {
+    item_reference ref;
+    tripoint_bub_ms location;
+    temperature_flag flag = temperature_flag::NORMAL;
+    float spoil_multiplier = 1.0f;
+    bool sealed = false;
+    // Its temperature and rot were processed ahead, and whether it rotted away doing so.
+    bool processed = false;
+    bool rotted_away = false;
+    item_temperature_environment env;
+};
+
+/**
+ * Processes the food among @p batches, which does nothing but change temperature and rot, in
+ * parallel per submap.  The environment of each item is looked up first, so the workers only
+ * touch the items of their own submap.  What follows from an item rotting away is left to the
+ * serial pass, so the outcome doesn't depend on the order the workers finish in.
+ */
+static void process_temperature_rot_ahead( map &here,
+        std::vector<std::vector<map_item_to_process> *> &batches )
+{
+    size_t num_items = 0;
+    std::vector<std::vector<map_item_to_process *>> jobs;
+    for( std::vector<map_item_to_process> *batch : batches ) {
+        std::vector<map_item_to_process *> job;
+        for( map_item_to_process &entry : *batch ) {
+            if( entry.ref.item_ref && entry.ref.item_ref->only_changes_temperature_and_rot() ) {
+                entry.env = entry.ref.item_ref->temperature_environment( entry.location.raw(), here );
+                job.push_back( &entry );
+            }
+        }
+        num_items += job.size();
+        if( !job.empty() ) {
+            jobs.push_back( std::move( job ) );
+        }
+    }
+
+    const auto process_job = [&here]( const std::vector<map_item_to_process *> &job ) {
+        for( map_item_to_process *entry : job ) {
+            entry->rotted_away = entry->ref.item_ref->process_temperature_rot( entry->env, 1,
+                                 entry->location.raw(), here, nullptr, entry->flag, entry->spoil_multiplier,
+                                 entry->sealed );
+            entry->processed = true;
+        }
+    };
+    // Below this many items handing them to the workers costs more than it saves.
+    constexpr size_t min_parallel_items = 256;
+    static const unsigned int num_threads = thread_pool::default_size();
+    if( num_threads < 2 || jobs.size() < 2 || num_items < min_parallel_items ) {
+        for( const std::vector<map_item_to_process *> &job : jobs ) {
+            process_job( job );
+        }
+        return;
+    }
+    static thread_pool pool( num_threads );
+    for( const std::vector<map_item_to_process *> &job : jobs ) {
+        pool.push( [&process_job, &job]() {
+            process_job( job );
+        } );
+    }
+    pool.wait();
+}
+
+// Lets stored food that has nothing to do for a while sleep, it catches up when processed again.
+static void sleep_while_settled( active_item_cache &cache, const item_reference &ref,
+                                 const tripoint_bub_ms &location, temperature_flag flag,
+                                 float spoil_multiplier )
+{
+    if( !ref.item_ref ) {
+        return;
+    }
+    const std::optional<time_point> settled = ref.item_ref->temperature_rot_settled_until( location,
+            flag, spoil_multiplier );
+    if( settled ) {
+        cache.sleep_until( *ref.item_ref, *settled );
+    }
+}
+
 static void process_vehicle_items( vehicle &cur_veh, int part )
 {
     vehicle_part &vp = cur_veh.part( part );
@@ -5863,6 +5993,7 @@ void map::process_items()
         }
     }
     update_submaps_with_active_items();
+    std::vector<std::pair<tripoint_abs_sm, std::vector<map_item_to_process>>> due_items;
     for( auto iter = submaps_with_active_items.begin(); iter != submaps_with_active_items.end(); ) {
         tripoint_abs_sm const abs_pos = *iter;
         if( !inbounds( project_to<coords::ms>( abs_pos ) ) ) {
@@ -5874,24 +6005,50 @@ void map::process_items()
         if( current_submap == nullptr ) {
             debugmsg( "Tried to process items at %s but the submap is not loaded",
                       local_pos.to_string() );
+            ++iter;
             continue;
         }
-        // TODO: fix point types
+        due_items.emplace_back( abs_pos, items_to_process_in_submap( *current_submap, local_pos ) );
+        ++iter;
+    }
+
+    std::vector<std::vector<map_item_to_process> *> batches;
+    batches.reserve( due_items.size() );
+    for( std::pair<tripoint_abs_sm, std::vector<map_item_to_process>> &due : due_items ) {
+        batches.push_back( &due.second );
+    }
+    process_temperature_rot_ahead( *this, batches );
+
+    for( std::pair<tripoint_abs_sm, std::vector<map_item_to_process>> &due : due_items ) {
+        const tripoint_rel_sm local_pos = due.first - abs_sub.xy();
+        submap *const current_submap = get_submap_at_grid( local_pos );
+        if( current_submap == nullptr ) {
+            continue;
+        }
+        process_items_in_submap( *current_submap, due.second );
+        // Items that came due since, like the ones dropped by items processed before.
         process_items_in_submap( *current_submap, local_pos );
         if( current_submap->active_items.empty() ) {
-            iter = submaps_with_active_items.erase( iter );
-        } else {
-            ++iter;
+            submaps_with_active_items.erase( due.first );
         }
     }
 }
 
 void map::process_items_in_submap( submap &current_submap, const tripoint_rel_sm &gridp )
+{
+    std::vector<map_item_to_process> items = items_to_process_in_submap( current_submap, gridp );
+    process_items_in_submap( current_submap, items );
+}
+
+std::vector<map_item_to_process> map::items_to_process_in_submap( submap &current_submap,
+        const tripoint_rel_sm &gridp )
 {
     // Get a COPY of the active item list for this submap.
     // If more are added as a side effect of processing, they are ignored this turn.
     // If they are destroyed before processing, they don't get processed.
     std::vector<item_reference> active_items = current_submap.active_items.get_for_processing();
+    std::vector<map_item_to_process> result;
+    result.reserve( active_items.size() );
     const point_bub_ms grid_offset( gridp.x() * SEEX, gridp.y() * SEEY );
     for( item_reference &active_item_ref : active_items ) {
         if( !active_item_ref.item_ref ) {
@@ -5899,9 +6056,9 @@ void map::process_items_in_submap( submap &current_submap, const tripoint_rel_sm
             continue;
         }
 
-        const tripoint_bub_ms map_location = tripoint_bub_ms( grid_offset + active_item_ref.location,
-                                             gridp.z() );
-        const furn_t &furn = this->furn( map_location ).obj();
+        map_item_to_process entry;
+        entry.location = tripoint_bub_ms( grid_offset + active_item_ref.location, gridp.z() );
+        const furn_t &furn = this->furn( entry.location ).obj();
 
         if( furn.has_flag( ter_furn_flag::TFLAG_DONT_REMOVE_ROTTEN ) ) {
             // plants contain a seed item which must not be removed under any circumstances.
@@ -5909,25 +6066,53 @@ void map::process_items_in_submap( submap &current_submap, const tripoint_rel_sm
             continue;
         }
         // root cellars are special
-        temperature_flag flag = temperature_flag::NORMAL;
-        if( ter( map_location ) == ter_t_rootcellar ) {
-            flag = temperature_flag::ROOT_CELLAR;
+        if( ter( entry.location ) == ter_t_rootcellar ) {
+            entry.flag = temperature_flag::ROOT_CELLAR;
         }
 
-        float spoil_multiplier = 1.0f;
-
-        if( has_flag( ter_furn_flag::TFLAG_NO_SPOIL, map_location ) ) {
-            spoil_multiplier = 0.0f;
+        if( has_flag( ter_furn_flag::TFLAG_NO_SPOIL, entry.location ) ) {
+            entry.spoil_multiplier = 0.0f;
         }
+        entry.spoil_multiplier *= active_item_ref.spoil_multiplier();
 
-        bool furniture_is_sealed = has_flag( ter_furn_flag::TFLAG_SEALED, map_location );
+        bool furniture_is_sealed = has_flag( ter_furn_flag::TFLAG_SEALED, entry.location );
+        entry.sealed = furniture_is_sealed || active_item_ref.has_watertight_container();
+        entry.ref = std::move( active_item_ref );
+        result.push_back( std::move( entry ) );
+    }
+    return result;
+}
 
-        map_stack items = i_at( map_location );
+void map::process_items_in_submap( submap &current_submap,
+                                   std::vector<map_item_to_process> &items )
+{
+    for( map_item_to_process &entry : items ) {
+        item_reference &active_item_ref = entry.ref;
+        if( !active_item_ref.item_ref ) {
+            // The item was destroyed, so skip it.
+            continue;
+        }
 
-        process_map_items( *this, items, active_item_ref.item_ref, active_item_ref.parent,
-                           map_location, 1, flag,
-                           spoil_multiplier * active_item_ref.spoil_multiplier(),
-                           furniture_is_sealed || active_item_ref.has_watertight_container() );
+        map_stack stack = i_at( entry.location );
+        bool destroyed = false;
+        if( entry.processed ) {
+            if( entry.rotted_away ) {
+                // What processing the item here would have done after it rotted away.
+                if( active_item_ref.item_ref->is_comestible() ) {
+                    rotten_item_spawn( *active_item_ref.item_ref, entry.location );
+                }
+                remove_processed_item( stack, active_item_ref.item_ref, active_item_ref.parent,
+                                       entry.location );
+                destroyed = true;
+            }
+        } else {
+            destroyed = process_map_items( *this, stack, active_item_ref.item_ref, active_item_ref.parent,
+                                           entry.location, 1, entry.flag, entry.spoil_multiplier, entry.sealed );
+        }
+        if( !destroyed ) {
+            sleep_while_settled( current_submap.active_items, active_item_ref, entry.location,
+                                 entry.flag, entry.spoil_multiplier );
+        }
     }
 }
 
@@ -5938,7 +6123,8 @@ std::vector<item_reference> map::item_network_connections( vehicle *power_grid )
         tripoint_abs_sm const abs_pos = iter;
         const tripoint_rel_sm local_pos = abs_pos - abs_sub.xy();
         submap *const current_submap = get_submap_at_grid( local_pos );
-        std::vector<item_reference> active_items = current_submap->active_items.get_for_processing();
+        // All of them, handing out the ones due for processing would make them skip their turn.
+        std::vector<item_reference> active_items = current_submap->active_items.get();
         for( item_reference &active_item_ref : active_items ) {
             if( !active_item_ref.item_ref ) {
                 continue;
@@ -6034,6 +6220,8 @@ void map::process_items_in_vehicle( vehicle &cur_veh, submap &current_submap )
         if( !process_map_items( *this, items, active_item_ref.item_ref, active_item_ref.parent,
                                 item_loc, it_insulation, flag,
                                 active_item_ref.spoil_multiplier(), in_tank || active_item_ref.has_watertight_container() ) ) {
+            sleep_while_settled( cur_veh.active_items, active_item_ref, item_loc, flag,
+                                 active_item_ref.spoil_multiplier() );
             // If the item was NOT destroyed, we can skip the remainder,
             // which handles fallout from the vehicle being damaged.
             continue;
@@ -6546,6 +6734,7 @@ void map::partial_con_remove( const tripoint_bub_ms &p )
         return;
     }
     current_submap->partial_constructions.erase( tripoint_sm_ms( l, p.z() ) );
+    current_submap->mark_modified();
     memory_cache_dec_set_dirty( p, true );
     avatar &player_character = get_avatar();
     if( player_character.sees( p ) ) {
@@ -6770,8 +6959,13 @@ int map::get_field_intensity( const tripoint_bub_ms &p, const field_type_id &typ
 bool map::has_field_at( const tripoint_bub_ms &p, bool check_bounds ) const
 {
     const tripoint_bub_sm sm = coords::project_to<coords::sm>( p );
-    return ( !check_bounds || inbounds( p ) ) &&
-           get_cache( p.z() ).field_cache[sm.x() + sm.y() * MAPSIZE];
+    if( ( check_bounds && !inbounds( p ) ) ||
+        !get_cache( p.z() ).field_cache[sm.x() + sm.y() * MAPSIZE] ) {
+        return false;
+    }
+    point_sm_ms l;
+    const submap *const current_submap = unsafe_get_submap_at( p, l );
+    return current_submap != nullptr && current_submap->may_have_field( l );
 }
 
 bool map::has_field_at( const tripoint &p, const field_type_id &type ) const
@@ -6880,6 +7074,7 @@ bool map::add_field( const tripoint_bub_ms &p, const field_type_id &type_id, int
     current_submap->ensure_nonuniform();
     invalidate_max_populated_zlev( p.z() );
 
+    current_submap->mark_field_tile( l );
     if( current_submap->get_field( l ).add_field( converted_type_id, intensity, age ) ) {
         //Only adding it to the count if it doesn't exist.
         if( !current_submap->field_count++ ) {
@@ -7048,6 +7243,17 @@ void map::remove_submap_camp( const tripoint_bub_ms &p )
         return;
     }
     current_submap->camp.reset();
+    current_submap->mark_modified();
+}
+
+void map::mark_submap_modified( const tripoint_bub_ms &p )
+{
+    if( !inbounds( p ) ) {
+        return;
+    }
+    if( submap *const current_submap = unsafe_get_submap_at( p ) ) {
+        current_submap->mark_modified();
+    }
 }
 
 basecamp map::hoist_submap_camp( const tripoint_bub_ms &p )
@@ -7680,6 +7886,84 @@ point map::sees_cache_key( const tripoint_bub_ms &from, const tripoint_bub_ms &t
            );
 }
 
+void map::visibility_field::reset( const tripoint_bub_ms &new_origin, int new_radius,
+                                   bool new_with_fields )
+{
+    origin = new_origin;
+    radius = new_radius;
+    with_fields = new_with_fields;
+    const size_t side = 2 * radius + 1;
+    cells.assign( side * side, -1 );
+}
+
+int8_t *map::visibility_field::cell( const tripoint_bub_ms &p )
+{
+    const point d = ( p - origin ).xy().raw() + point( radius, radius );
+    const int side = 2 * radius + 1;
+    if( radius < 0 || p.z() != origin.z() || d.x < 0 || d.y < 0 || d.x >= side || d.y >= side ) {
+        return nullptr;
+    }
+    return &cells[d.x * side + d.y];
+}
+
+map::visibility_field *map::find_visibility_field( const tripoint_bub_ms &origin,
+        bool with_fields ) const
+{
+    for( visibility_field &field : visibility_fields ) {
+        if( field.radius >= 0 && field.origin == origin && field.with_fields == with_fields ) {
+            field.last_used = ++visibility_field_clock;
+            return &field;
+        }
+    }
+    return nullptr;
+}
+
+map::visibility_field *map::get_visibility_field( const tripoint_bub_ms &origin, int range,
+        bool with_fields ) const
+{
+    // Unlimited queries get a field as wide as anything can be seen.
+    const int radius = range < 0 ? MAX_VIEW_DISTANCE : std::min( range, MAX_VIEW_DISTANCE );
+    ++visibility_field_clock;
+    visibility_field *oldest = &visibility_fields[0];
+    for( visibility_field &field : visibility_fields ) {
+        if( field.radius >= 0 && field.origin == origin && field.with_fields == with_fields ) {
+            if( field.radius < radius ) {
+                // Queried further than before, grow the field to the new range.
+                field.reset( origin, radius, with_fields );
+            }
+            field.last_used = visibility_field_clock;
+            return &field;
+        }
+        if( field.last_used < oldest->last_used ) {
+            oldest = &field;
+        }
+    }
+    // Only origins that keep coming back are worth a field; one-off queries stay on the
+    // skew caches.
+    const auto candidate = std::find( visibility_field_candidates.begin(),
+                                      visibility_field_candidates.end(), origin );
+    if( candidate == visibility_field_candidates.end() ) {
+        visibility_field_candidates[next_visibility_field_candidate] = origin;
+        next_visibility_field_candidate = ( next_visibility_field_candidate + 1 ) %
+                                          visibility_field_candidates.size();
+        return nullptr;
+    }
+    *candidate = tripoint_bub_ms( tripoint_min );
+    oldest->reset( origin, radius, with_fields );
+    oldest->last_used = visibility_field_clock;
+    return oldest;
+}
+
+void map::clear_visibility_fields()
+{
+    for( visibility_field &field : visibility_fields ) {
+        field.radius = -1;
+        field.last_used = 0;
+    }
+    visibility_field_candidates.fill( tripoint_bub_ms( tripoint_min ) );
+    visibility_field_clock = 0;
+}
+
 /**
  * This one is internal-only, we don't want to expose the slope tweaking ickiness outside the map class.
  **/
@@ -7696,9 +7980,32 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
         return false; // Out of range!
     }
     const point key = sees_cache_key( F, T );
+    int8_t *field_cell = nullptr;
     if( allow_cached ) {
+        if( F.z() == T.z() ) {
+            // Sight is cached for both directions at once (see sees_cache_key), so the field
+            // of the target answers just as well.  A horde watching the same few creatures
+            // shares their fields instead of each monster needing one of its own.
+            if( visibility_field *field = find_visibility_field( T, with_fields ) ) {
+                field_cell = field->cell( F );
+            }
+            if( field_cell == nullptr ) {
+                if( visibility_field *field = get_visibility_field( F, range, with_fields ) ) {
+                    field_cell = field->cell( T );
+                } else if( visibility_field *target_field = get_visibility_field( T, range,
+                           with_fields ) ) {
+                    field_cell = target_field->cell( F );
+                }
+            }
+            if( field_cell != nullptr && *field_cell != -1 ) {
+                return *field_cell > 0;
+            }
+        }
         char cached = skew_cache.get( key, -1 );
         if( cached != -1 ) {
+            if( field_cell != nullptr ) {
+                *field_cell = cached > 0 ? 1 : 0;
+            }
             return cached > 0;
         }
     }
@@ -7719,6 +8026,9 @@ bool map::sees( const tripoint_bub_ms &F, const tripoint_bub_ms &T, const int ra
             return true;
         } );
         skew_cache.insert( 100000, key, visible ? 1 : 0 );
+        if( field_cell != nullptr ) {
+            *field_cell = visible ? 1 : 0;
+        }
         return visible;
     }
 
@@ -7912,6 +8222,30 @@ int map::coverage( const tripoint_bub_ms &p ) const
 // Basically it does, "Find a line from any point in the source that ends up in the target square".
 std::vector<tripoint_bub_ms> map::find_clear_path( const tripoint_bub_ms &source,
         const tripoint_bub_ms &destination ) const
+{
+    // The search only reads the transparency cache, so its result holds until that changes.
+    if( clear_path_traces_turn != calendar::turn || clear_path_traces_origin != abs_sub ||
+        clear_path_traces_generation != vision_generation ) {
+        clear_path_traces.fill( {} );
+        clear_path_traces_turn = calendar::turn;
+        clear_path_traces_origin = abs_sub;
+        clear_path_traces_generation = vision_generation;
+    }
+    for( const clear_path_trace &trace : clear_path_traces ) {
+        if( !trace.path.empty() && trace.source == source && trace.destination == destination ) {
+            return trace.path;
+        }
+    }
+    clear_path_trace &trace = clear_path_traces[next_clear_path_trace];
+    next_clear_path_trace = ( next_clear_path_trace + 1 ) % max_clear_path_traces;
+    trace.source = source;
+    trace.destination = destination;
+    trace.path = find_clear_path_uncached( source, destination );
+    return trace.path;
+}
+
+std::vector<tripoint_bub_ms> map::find_clear_path_uncached( const tripoint_bub_ms &source,
+        const tripoint_bub_ms &destination ) const
 {
     // TODO: Push this junk down into the Bresenham method, it's already doing it.
     const point d( destination.xy().raw() - source.xy().raw() );
@@ -8318,8 +8652,49 @@ shift_bitset_cache<MAPSIZE_X, SEEX>( std::bitset<MAPSIZE_X *MAPSIZE_X> &cache,
 template void
 shift_bitset_cache<MAPSIZE, 1>( std::bitset<MAPSIZE *MAPSIZE> &cache, const point_rel_sm &s );
 
+// Moves the contents of a per-tile cache by whole submaps, so that the tile at
+// (x, y) ends up at (x, y) - s * SEE.  Tiles uncovered at the far edge keep stale
+// values; the submaps loaded there mark them dirty.
+template<typename T>
+static void shift_tile_cache( cata::mdarray<T, point_bub_ms> &cache, const point_rel_sm &s )
+{
+    const int dx = s.x() * SEEX;
+    const int dy = s.y() * SEEY;
+    const int x_start = dx >= 0 ? 0 : MAPSIZE_X - 1;
+    const int x_stop = dx >= 0 ? MAPSIZE_X - dx : -dx - 1;
+    const int x_step = dx >= 0 ? 1 : -1;
+    for( int x = x_start; x != x_stop; x += x_step ) {
+        const T *const from = &cache[x + dx][0];
+        T *const to = &cache[x][0];
+        if( dy >= 0 ) {
+            std::copy( from + dy, from + MAPSIZE_Y, to );
+        } else {
+            std::copy_backward( from, from + MAPSIZE_Y + dy, to + MAPSIZE_Y );
+        }
+    }
+}
+
+// Same as shift_tile_cache, for the x-major array of y bitsets.
+static void shift_tile_cache( std::array<std::bitset<MAPSIZE_Y>, MAPSIZE_X> &cache,
+                              const point_rel_sm &s )
+{
+    const int dx = s.x() * SEEX;
+    const int dy = s.y() * SEEY;
+    const int x_start = dx >= 0 ? 0 : MAPSIZE_X - 1;
+    const int x_stop = dx >= 0 ? MAPSIZE_X - dx : -dx - 1;
+    const int x_step = dx >= 0 ? 1 : -1;
+    for( int x = x_start; x != x_stop; x += x_step ) {
+        if( dy >= 0 ) {
+            cache[x] = cache[x + dx] >> static_cast<size_t>( dy );
+        } else {
+            cache[x] = cache[x + dx] << static_cast<size_t>( -dy );
+        }
+    }
+}
+
 void map::shift( const point_rel_sm &sp )
 {
+    vehicle::invalidate_power_grids();
     if( !zlevels ) {
         debugmsg( "map::shift called from map that doesn't support Z levels" );
         return;
@@ -8382,6 +8757,16 @@ void map::shift( const point_rel_sm &sp )
             shift_bitset_cache<MAPSIZE_X, SEEX>( cache->map_memory_cache_dec, sp );
             shift_bitset_cache<MAPSIZE_X, SEEX>( cache->map_memory_cache_ter, sp );
             shift_bitset_cache<MAPSIZE, 1>( cache->field_cache, sp );
+            // The per-submap caches move along with the grid, so only the submaps
+            // loaded at the new edge have to be built again.
+            shift_tile_cache( cache->transparency_cache, sp );
+            shift_tile_cache( cache->transparent_cache_wo_fields, sp );
+            shift_tile_cache( cache->floor_cache, sp );
+            ++cache->sunlight_inputs_generation;
+            // These two are indexed x-major, unlike field_cache.
+            const point_rel_sm sp_transposed( sp.y(), sp.x() );
+            shift_bitset_cache<MAPSIZE, 1>( cache->transparency_cache_dirty, sp_transposed );
+            shift_bitset_cache<MAPSIZE, 1>( cache->floor_cache_dirty, sp_transposed );
         }
     }
 
@@ -8578,11 +8963,22 @@ void map::loadn( const point_bub_sm &grid, bool update_vehicles )
 
     for( int z = start_z; z <= stop_z; z++ ) {
         const tripoint_abs_sm pos = { grid_abs_sub.xy(), z };
-        // New submap changes the content of the map and all caches must be recalculated
-        set_transparency_cache_dirty( z );
+        // New submap changes the content of the map and all caches must be recalculated.
+        // Transparency and floor are rebuilt per submap, so only this one is marked, plus
+        // its neighbours for transparency: it reads the outside cache, which an indoor tile
+        // here changes one tile into the neighbouring submaps.
+        level_cache &ch = get_cache( z );
+        for( int dx = -1; dx <= 1; dx++ ) {
+            for( int dy = -1; dy <= 1; dy++ ) {
+                const point_bub_sm n = grid + point( dx, dy );
+                if( n.x() >= 0 && n.x() < my_MAPSIZE && n.y() >= 0 && n.y() < my_MAPSIZE ) {
+                    ch.transparency_cache_dirty.set( n.x() * MAPSIZE + n.y() );
+                }
+            }
+        }
+        ch.floor_cache_dirty.set( grid.x() * MAPSIZE + grid.y() );
         set_seen_cache_dirty( z );
         set_outside_cache_dirty( z );
-        set_floor_cache_dirty( z );
         set_pathfinding_cache_dirty( z );
         tmpsub = MAPBUFFER.lookup_submap( pos );
         setsubmap( get_nonant( tripoint_rel_sm{ grid.x(), grid.y(), z} ), tmpsub );
@@ -8718,10 +9114,25 @@ void map::rotten_item_spawn( const item &item, const tripoint_bub_ms &pnt )
     }
 }
 
-void map::fill_funnels( const tripoint_bub_ms &p, const time_point &since )
+/**
+ * What catching a submap up with the time it spent outside of the reality bubble needs to know.
+ * Worked out once per submap by map::actualize, instead of once per tile.
+ */
+struct submap_catch_up {
+    time_point last_touched;
+    time_duration since;
+    // Whether harvested terrain has grown back
+    bool restock = false;
+    // How long of that tapped maple trees have been producing sap
+    time_duration sap_time = 0_turns;
+    // The weather since last_touched, summed for the first funnel that needs it
+    std::optional<weather_sum> weather;
+};
+
+void map::fill_funnels( const tripoint_bub_ms &p, submap_catch_up &catch_up )
 {
     const trap &tr = tr_at( p );
-    if( !tr.is_funnel() ) {
+    if( !tr.is_funnel() || catch_up.since < 0_turns ) {
         return;
     }
     // Note: the inside/outside cache might not be correct at this time
@@ -8737,7 +9148,12 @@ void map::fill_funnels( const tripoint_bub_ms &p, const time_point &since )
         }
     }
     if( biggest_container != items.end() ) {
-        retroactively_fill_from_funnel( *biggest_container, tr, since, calendar::turn, getglobal( p ) );
+        // The weather only changes from one overmap tile to the next
+        if( !catch_up.weather ) {
+            catch_up.weather = sum_conditions( catch_up.last_touched, calendar::turn,
+                                               getglobal( p ) );
+        }
+        retroactively_fill_from_funnel( *biggest_container, tr, calendar::turn, *catch_up.weather );
     }
 }
 
@@ -8809,39 +9225,42 @@ void map::grow_plant( const tripoint_bub_ms &p )
     }
 }
 
-void map::restock_fruits( const tripoint_bub_ms &p, const time_duration &time_since_last_actualize )
+// Make harvested terrain harvestable again if the last actualization was during a different
+// season or year.
+static bool fruits_restocked( const time_duration &time_since_last_actualize )
 {
-    const ter_t &ter = this->ter( p ).obj();
-    if( !ter.has_flag( ter_furn_flag::TFLAG_HARVESTED ) ) {
-        return; // Already harvestable. Do nothing.
-    }
-    // Make it harvestable again if the last actualization was during a different season or year.
     const time_point last_touched = calendar::turn - time_since_last_actualize;
-    if( season_of_year( calendar::turn ) != season_of_year( last_touched ) ||
-        time_since_last_actualize >= calendar::season_length() ) {
-        ter_set( p, ter.transforms_into );
-    }
+    return season_of_year( calendar::turn ) != season_of_year( last_touched ) ||
+           time_since_last_actualize >= calendar::season_length();
 }
 
-void map::produce_sap( const tripoint_bub_ms &p, const time_duration &time_since_last_actualize )
+void map::restock_fruits( const tripoint_bub_ms &p, const submap_catch_up &catch_up )
 {
-    if( time_since_last_actualize <= 0_turns ) {
+    if( !catch_up.restock ) {
         return;
     }
-
-    if( !( ter( p ) == ter_t_tree_maple_tapped ) ) {
-        return;
+    const ter_t &ter = this->ter( p ).obj();
+    if( !ter.has_flag( ter_furn_flag::TFLAG_HARVESTED ) ) {
+        return; // Already harvestable. Do nothing.
     }
+    ter_set( p, ter.transforms_into );
+}
 
-    // Amount of maple sap liters produced per season per tap
-    static const int maple_sap_per_season = 56;
-
-    // How many turns to produce 1 charge (250 ml) of sap?
-    const time_duration producing_length = 0.75 * calendar::season_length();
+// Time it takes maple trees to produce sap for the whole season
+static time_duration sap_producing_length()
+{
+    return 0.75 * calendar::season_length();
+}
 
-    const time_duration turns_to_produce = producing_length / ( maple_sap_per_season * 4 );
+// How long of @p time_since_last_actualize maple trees have been in the producing period
+// (late winter, early spring).
+static time_duration sap_producing_time( const time_duration &time_since_last_actualize )
+{
+    if( time_since_last_actualize <= 0_turns ) {
+        return 0_turns;
+    }
 
-    // How long of this time_since_last_actualize have we been in the producing period (late winter, early spring)?
+    const time_duration producing_length = sap_producing_length();
     time_duration time_producing = 0_turns;
 
     if( time_since_last_actualize >= calendar::year_length() ) {
@@ -8887,8 +9306,26 @@ void map::produce_sap( const tripoint_bub_ms &p, const time_duration &time_since
             }
         }
     }
+    return time_producing;
+}
+
+void map::produce_sap( const tripoint_bub_ms &p, const submap_catch_up &catch_up )
+{
+    if( catch_up.sap_time <= 0_turns ) {
+        return;
+    }
+
+    if( !( ter( p ) == ter_t_tree_maple_tapped ) ) {
+        return;
+    }
+
+    // Amount of maple sap liters produced per season per tap
+    static const int maple_sap_per_season = 56;
+
+    // How many turns to produce 1 charge (250 ml) of sap?
+    const time_duration turns_to_produce = sap_producing_length() / ( maple_sap_per_season * 4 );
 
-    int new_charges = roll_remainder( time_producing / turns_to_produce );
+    int new_charges = roll_remainder( catch_up.sap_time / turns_to_produce );
     // Not enough time to produce 1 charge of sap
     if( new_charges <= 0 ) {
         return;
@@ -9024,13 +9461,31 @@ void map::actualize( const tripoint_rel_sm &grid )
         veh->refresh();
     }
 
-    const time_duration time_since_last_actualize = calendar::turn - tmpsub->last_touched;
+    submap_catch_up catch_up;
+    catch_up.last_touched = tmpsub->last_touched;
+    catch_up.since = calendar::turn - tmpsub->last_touched;
+    catch_up.restock = fruits_restocked( catch_up.since );
+    catch_up.sap_time = sap_producing_time( catch_up.since );
+    const time_duration &time_since_last_actualize = catch_up.since;
     const bool do_funnels = grid.z() >= 0;
 
     // check spoiled stuff, and fill up funnels while we're at it
     process_items_in_vehicles( *tmpsub );
     process_items_in_submap( *tmpsub, grid );
     explosion_handler::process_explosions();
+
+    // A uniform submap is all one terrain, with no furniture, traps, items, fields or
+    // radiation, so its tiles have nothing to catch up with unless the terrain does.
+    if( tmpsub->is_uniform() ) {
+        const ter_t &ter = tmpsub->get_ter( point_sm_ms() ).obj();
+        if( ter.emissions.empty() && ( ter.trap == tr_null || ter.trap == tr_ledge ) &&
+            ( !catch_up.restock || !ter.has_flag( ter_furn_flag::TFLAG_HARVESTED ) ) ) {
+            tmpsub->last_touched = calendar::turn;
+            return;
+        }
+    }
+
+    const bool has_traps = tmpsub->trap_count() > 0;
     for( int x = 0; x < SEEX; x++ ) {
         for( int y = 0; y < SEEY; y++ ) {
             const tripoint_bub_ms pnt =  rebase_bub( coords::project_to<coords::ms>( grid ) + point( x, y ) );
@@ -9044,7 +9499,7 @@ void map::actualize( const tripoint_rel_sm &grid )
                 field_ter_locs.push_back( pnt );
             }
 
-            const trap_id trap_here = tmpsub->get_trap( p );
+            const trap_id trap_here = has_traps ? tmpsub->get_trap( p ) : tr_null;
             if( trap_here != tr_null ) {
                 traplocs[trap_here.to_i()].push_back( pnt );
             }
@@ -9053,19 +9508,25 @@ void map::actualize( const tripoint_rel_sm &grid )
                 traplocs[ter.trap.to_i()].push_back( pnt );
             }
 
-            if( do_funnels ) {
-                fill_funnels( pnt, tmpsub->last_touched );
+            if( do_funnels && ( trap_here != tr_null || ter.trap != tr_null ) ) {
+                fill_funnels( pnt, catch_up );
             }
 
-            grow_plant( pnt );
+            if( furn.has_flag( ter_furn_flag::TFLAG_PLANT ) ) {
+                grow_plant( pnt );
+            }
 
-            restock_fruits( pnt, time_since_last_actualize );
+            restock_fruits( pnt, catch_up );
 
-            produce_sap( pnt, time_since_last_actualize );
+            produce_sap( pnt, catch_up );
 
-            rad_scorch( pnt, time_since_last_actualize );
+            if( tmpsub->get_radiation( p ) != 0 ) {
+                rad_scorch( pnt, time_since_last_actualize );
+            }
 
-            decay_cosmetic_fields( pnt, time_since_last_actualize );
+            if( tmpsub->may_have_field( p ) ) {
+                decay_cosmetic_fields( pnt, time_since_last_actualize );
+            }
         }
     }
 
@@ -9266,7 +9727,9 @@ void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &grou
                                tmp.wander_pos.to_string_writable() );
             }
 
-            monster *const placed = g->place_critter_at( make_shared_fast<monster>( tmp ), local_pos );
+            // The group is cleared below, so the monster can be moved out of it.
+            const shared_ptr_fast<monster> spawned = make_shared_fast<monster>( std::move( tmp ) );
+            monster *const placed = g->place_critter_at( spawned, local_pos );
             if( placed ) {
                 placed->on_load();
             }
@@ -9279,6 +9742,7 @@ void map::spawn_monsters_submap_group( const tripoint_rel_sm &gp, mongroup &grou
 
 void map::spawn_monsters_submap( const tripoint_rel_sm &gp, bool ignore_sight, bool spawn_nonlocal )
 {
+    const alloc_profiler::scoped_tag alloc_tag( alloc_profiler::tag::creatures );
     const tripoint_abs_sm submap_pos( gp + abs_sub.xy() );
     // Load unloaded monsters
     overmap_buffer.spawn_monster( submap_pos, spawn_nonlocal );
@@ -9351,8 +9815,10 @@ void map::spawn_monsters_submap( const tripoint_rel_sm &gp, bool ignore_sight, b
                 return ( !g || &get_map() != this || !creatures.creature_at( p ) ) && tmp.can_move_to( p );
             };
 
+            // Places at most one monster, after which `tmp` is not used any more.
             const auto place_it = [&]( const tripoint_bub_ms & p ) {
-                monster *const placed = g->place_critter_at( make_shared_fast<monster>( tmp ), p );
+                shared_ptr_fast<monster> spawned = make_shared_fast<monster>( std::move( tmp ) );
+                monster *const placed = g->place_critter_at( spawned, p );
                 if( !i.data.patrol_points_rel_ms.empty() ) {
                     placed->set_patrol_route( i.data.patrol_points_rel_ms );
                 }
@@ -9370,7 +9836,10 @@ void map::spawn_monsters_submap( const tripoint_rel_sm &gp, bool ignore_sight, b
             }
         }
     }
-    current_submap->spawns.clear();
+    if( !current_submap->spawns.empty() ) {
+        current_submap->spawns.clear();
+        current_submap->mark_modified();
+    }
 }
 
 void map::spawn_monsters( bool ignore_sight, bool spawn_nonlocal )
@@ -9393,7 +9862,10 @@ void map::spawn_monsters( bool ignore_sight, bool spawn_nonlocal )
 void map::clear_spawns()
 {
     for( submap *&smap : grid ) {
-        smap->spawns.clear();
+        if( !smap->spawns.empty() ) {
+            smap->spawns.clear();
+            smap->mark_modified();
+        }
     }
 }
 
@@ -9683,6 +10155,7 @@ void map::build_outside_cache( const int zlev )
         return;
     }
     level_cache &ch = *ch_lazy;
+    ++ch.sunlight_inputs_generation;
 
     // Make a bigger cache to avoid bounds checking
     // We will later copy it to our regular cache
@@ -9694,6 +10167,7 @@ void map::build_outside_cache( const int zlev )
     if( zlev < 0 ) {
         std::uninitialized_fill_n(
             &outside_cache[0][0], MAPSIZE_X * MAPSIZE_Y, false );
+        ch.outside_cache_dirty = false;
         return;
     }
 
@@ -9707,6 +10181,18 @@ void map::build_outside_cache( const int zlev )
                           zlev );
                 continue;
             }
+            if( cur_submap->is_uniform() ) {
+                // Skies and solid rock: one terrain, no furniture, so the whole submap is alike.
+                const point_sm_ms sp;
+                if( cur_submap->get_ter( sp ).obj().has_flag( ter_furn_flag::TFLAG_INDOORS ) ||
+                    cur_submap->get_furn( sp ).obj().has_flag( ter_furn_flag::TFLAG_INDOORS ) ) {
+                    // The submap and the tiles around it, offset by the padding.
+                    for( int dx = 0; dx < SEEX + 2; dx++ ) {
+                        std::fill_n( &padded_cache[smx * SEEX + dx][smy * SEEY], SEEY + 2, false );
+                    }
+                }
+                continue;
+            }
 
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
@@ -9836,14 +10322,18 @@ std::bitset<OVERMAP_LAYERS> map::get_inter_level_visibility( const int origin_zl
 bool map::build_floor_cache( const int zlev )
 {
     auto *ch_lazy = get_cache_lazy( zlev );
-    if( !ch_lazy || !ch_lazy->floor_cache_dirty ) {
+    if( !ch_lazy || ch_lazy->floor_cache_dirty.none() ) {
         return false;
     }
     level_cache &ch = *ch_lazy;
+    ++ch.sunlight_inputs_generation;
 
     auto &floor_cache = ch.floor_cache;
-    std::uninitialized_fill_n(
-        &floor_cache[0][0], MAPSIZE_X * MAPSIZE_Y, true );
+    const bool rebuild_all = ch.floor_cache_dirty.all();
+    if( rebuild_all ) {
+        std::uninitialized_fill_n(
+            &floor_cache[0][0], MAPSIZE_X * MAPSIZE_Y, true );
+    }
     bool &no_floor_gaps = ch.no_floor_gaps;
     no_floor_gaps = true;
 
@@ -9851,6 +10341,14 @@ bool map::build_floor_cache( const int zlev )
 
     for( int smx = 0; smx < my_MAPSIZE; ++smx ) {
         for( int smy = 0; smy < my_MAPSIZE; ++smy ) {
+            if( !rebuild_all ) {
+                if( !ch.floor_cache_dirty[smx * MAPSIZE + smy] ) {
+                    continue;
+                }
+                for( int sx = 0; sx < SEEX; ++sx ) {
+                    std::fill_n( &floor_cache[smx * SEEX + sx][smy * SEEY], SEEY, true );
+                }
+            }
             const submap *cur_submap = get_submap_at_grid( tripoint_rel_sm{ smx, smy, zlev } );
             const submap *below_submap = !lowest_z_lev ? get_submap_at_grid( tripoint_rel_sm{ smx, smy, zlev - 1 } ) :
                                          nullptr;
@@ -9864,6 +10362,28 @@ bool map::build_floor_cache( const int zlev )
                           zlev - 1 );
                 continue;
             }
+            if( cur_submap->is_uniform() ) {
+                const ter_t &terrain = cur_submap->get_ter( point_sm_ms() ).obj();
+                if( !terrain.has_flag( ter_furn_flag::TFLAG_NO_FLOOR ) &&
+                    !terrain.has_flag( ter_furn_flag::TFLAG_NO_FLOOR_WATER ) &&
+                    !terrain.has_flag( ter_furn_flag::TFLAG_GOES_DOWN ) &&
+                    !terrain.has_flag( ter_furn_flag::TFLAG_TRANSPARENT_FLOOR ) ) {
+                    // Solid floor all over, which the cache already says.
+                    continue;
+                }
+                if( !below_submap || below_submap->is_uniform() ) {
+                    const bool roofed = below_submap &&
+                                        below_submap->get_furn( point_sm_ms() ).obj().has_flag(
+                                            ter_furn_flag::TFLAG_SUN_ROOF_ABOVE );
+                    if( !roofed ) {
+                        for( int sx = 0; sx < SEEX; ++sx ) {
+                            std::fill_n( &floor_cache[smx * SEEX + sx][smy * SEEY], SEEY, false );
+                        }
+                        no_floor_gaps = false;
+                    }
+                    continue;
+                }
+            }
 
             for( int sx = 0; sx < SEEX; ++sx ) {
                 for( int sy = 0; sy < SEEY; ++sy ) {
@@ -9886,7 +10406,16 @@ bool map::build_floor_cache( const int zlev )
         }
     }
 
-    ch.floor_cache_dirty = false;
+    if( !rebuild_all && no_floor_gaps ) {
+        // The submaps that were not rebuilt may still have gaps.
+        for( int x = 0; x < SEEX * my_MAPSIZE && no_floor_gaps; x++ ) {
+            const auto row_begin = floor_cache[x].begin();
+            no_floor_gaps = std::find( row_begin, row_begin + SEEY * my_MAPSIZE, false ) ==
+                            row_begin + SEEY * my_MAPSIZE;
+        }
+    }
+
+    ch.floor_cache_dirty.reset();
     return zlevels;
 }
 
@@ -9963,9 +10492,10 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     const int maxz = zlevels ? OVERMAP_HEIGHT : zlev;
     bool seen_cache_dirty = false;
     bool camera_cache_dirty = false;
+    bool transparency_changed = false;
     for( int z = minz; z <= maxz; z++ ) {
         build_outside_cache( z );
-        build_transparency_cache( z );
+        transparency_changed |= build_transparency_cache( z );
         bool floor_cache_was_dirty = build_floor_cache( z );
         seen_cache_dirty |= floor_cache_was_dirty;
         seen_cache_dirty |= get_cache( z ).seen_cache_dirty;
@@ -9982,6 +10512,10 @@ void map::build_map_cache( const int zlev, bool skip_lightmap )
     if( seen_cache_dirty ) {
         skew_vision_cache.clear();
         skew_vision_wo_fields_cache.clear();
+        clear_visibility_fields();
+    }
+    if( seen_cache_dirty || transparency_changed ) {
+        ++vision_generation;
     }
     avatar &u = get_avatar();
     Character::moncam_cache_t mcache = u.get_active_moncams();
@@ -10034,14 +10568,24 @@ tripoint_abs_ms map::getglobal( const tripoint &p ) const
     return map::getglobal( tripoint_bub_ms( p ) );
 }
 
-tripoint_abs_ms map::getglobal( const tripoint_bub_ms &p ) const
+std::vector<tripoint_abs_ms> map::getglobal( const std::vector<tripoint_bub_ms> &points ) const
 {
-    return tripoint_abs_ms{ p.x() + abs_ms.x(), p.y() + abs_ms.y(), p.z() };
+    std::vector<tripoint_abs_ms> ret;
+    ret.reserve( points.size() );
+    for( const tripoint_bub_ms &p : points ) {
+        ret.push_back( getglobal( p ) );
+    }
+    return ret;
 }
 
-tripoint_bub_ms map::bub_from_abs( const tripoint_abs_ms &p ) const
+std::vector<tripoint_bub_ms> map::bub_from_abs( const std::vector<tripoint_abs_ms> &points ) const
 {
-    return tripoint_bub_ms { p.x() - abs_ms.x(), p.y() - abs_ms.y(), p.z()};
+    std::vector<tripoint_bub_ms> ret;
+    ret.reserve( points.size() );
+    for( const tripoint_abs_ms &p : points ) {
+        ret.push_back( bub_from_abs( p ) );
+    }
+    return ret;
 }
 
 void map::set_abs_sub( const tripoint_abs_sm &p )
@@ -10460,26 +11004,13 @@ void map::function_over( const tripoint_bub_ms &start, const tripoint_bub_ms &en
     }
 }
 
-void map::scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &blocks_scent,
-                          std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &reduces_scent,
-                          const point_bub_ms &min, const point_bub_ms &max )
+void map::scent_blockers( std::array<std::array<std::uint8_t, MAPSIZE_Y>, MAPSIZE_X>
+                          &scent_weights, const point_bub_ms &min, const point_bub_ms &max )
 {
-    ter_furn_flag reduce = ter_furn_flag::TFLAG_REDUCE_SCENT;
-    ter_furn_flag block = ter_furn_flag::TFLAG_NO_SCENT;
     auto fill_values = [&]( const tripoint_rel_sm & gp, const submap * sm, const point_sm_ms & lp ) {
         // We need to generate the x/y coordinates, because we can't get them "for free"
         const point_sm_ms p = lp + coords::project_to<coords::ms>( gp.xy() );
-        if( sm->get_ter( lp ).obj().has_flag( block ) ) {
-            blocks_scent[p.x()][p.y()] = true;
-            reduces_scent[p.x()][p.y()] = false;
-        } else if( sm->get_ter( lp ).obj().has_flag( reduce ) ||
-                   sm->get_furn( lp ).obj().has_flag( reduce ) ) {
-            blocks_scent[p.x()][p.y()] = false;
-            reduces_scent[p.x()][p.y()] = true;
-        } else {
-            blocks_scent[p.x()][p.y()] = false;
-            reduces_scent[p.x()][p.y()] = false;
-        }
+        scent_weights[p.x()][p.y()] = sm->get_scent_weights()[lp];
 
         return ITER_CONTINUE;
     };
@@ -10500,58 +11031,56 @@ void map::scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &bl
                 continue;
             }
             const tripoint_bub_ms part_pos = vp.pos_bub();
-            if( local_bounds.contains( part_pos.xy() ) ) {
-                reduces_scent[part_pos.x()][part_pos.y()] = true;
+            if( !local_bounds.contains( part_pos.xy() ) ) {
+                continue;
+            }
+            std::uint8_t &weight = scent_weights[part_pos.x()][part_pos.y()];
+            // Tiles that block scent keep blocking it.
+            if( weight != 0 ) {
+                weight = 2;
             }
         }
     }
 }
 
+tripoint_range<tripoint_bub_ms> map::clip_to_bounds(
+    const tripoint_range<tripoint_bub_ms> &range ) const
+{
+    return range.clipped( { 0, 0, -OVERMAP_DEPTH },
+    { SEEX * my_MAPSIZE - 1, SEEY * my_MAPSIZE - 1, OVERMAP_HEIGHT } );
+}
+
 tripoint_range<tripoint_bub_ms> map::points_in_rectangle( const tripoint_bub_ms &from,
         const tripoint_bub_ms &to ) const
 {
-    const tripoint_bub_ms min( std::max( 0, std::min( from.x(), to.x() ) ), std::max( 0,
-                               std::min( from.y(),
-                                         to.y() ) ), std::max( -OVERMAP_DEPTH, std::min( from.z(), to.z() ) ) );
-    const tripoint_bub_ms max( std::min( SEEX * my_MAPSIZE - 1, std::max( from.x(), to.x() ) ),
-                               std::min( SEEX * my_MAPSIZE - 1, std::max( from.y(), to.y() ) ), std::min( OVERMAP_HEIGHT,
-                                       std::max( from.z(), to.z() ) ) );
-    return tripoint_range<tripoint_bub_ms>( min, max );
+    const tripoint_bub_ms min( std::min( from.x(), to.x() ), std::min( from.y(), to.y() ),
+                               std::min( from.z(), to.z() ) );
+    const tripoint_bub_ms max( std::max( from.x(), to.x() ), std::max( from.y(), to.y() ),
+                               std::max( from.z(), to.z() ) );
+    return clip_to_bounds( tripoint_range<tripoint_bub_ms>( min, max ) );
 }
 
 tripoint_range<tripoint> map::points_in_radius( const tripoint &center, size_t radius,
         size_t radiusz ) const
 {
-    const tripoint min( std::max<int>( 0, center.x - radius ), std::max<int>( 0, center.y - radius ),
-                        clamp<int>( center.z - radiusz, -OVERMAP_DEPTH, OVERMAP_HEIGHT ) );
-    const tripoint max( std::min<int>( SEEX * my_MAPSIZE - 1, center.x + radius ),
-                        std::min<int>( SEEX * my_MAPSIZE - 1, center.y + radius ), clamp<int>( center.z + radiusz,
-                                -OVERMAP_DEPTH, OVERMAP_HEIGHT ) );
-    return tripoint_range<tripoint>( min, max );
+    const tripoint offset( static_cast<int>( radius ), static_cast<int>( radius ),
+                           static_cast<int>( radiusz ) );
+    return tripoint_range<tripoint>( center - offset, center + offset ).clipped(
+    { 0, 0, -OVERMAP_DEPTH }, { SEEX * my_MAPSIZE - 1, SEEY * my_MAPSIZE - 1, OVERMAP_HEIGHT } );
 }
 
 tripoint_range<tripoint_bub_ms> map::points_in_radius(
     const tripoint_bub_ms &center, size_t radius, size_t radiusz ) const
 {
-    const tripoint_bub_ms min(
-        std::max<int>( 0, center.x() - radius ), std::max<int>( 0, center.y() - radius ),
-        clamp<int>( center.z() - radiusz, -OVERMAP_DEPTH, OVERMAP_HEIGHT ) );
-    const tripoint_bub_ms max(
-        std::min<int>( SEEX * my_MAPSIZE - 1, center.x() + radius ),
-        std::min<int>( SEEX * my_MAPSIZE - 1, center.y() + radius ),
-        clamp<int>( center.z() + radiusz, -OVERMAP_DEPTH, OVERMAP_HEIGHT ) );
-    return tripoint_range<tripoint_bub_ms>( min, max );
+    const tripoint_rel_ms offset( static_cast<int>( radius ), static_cast<int>( radius ),
+                                  static_cast<int>( radiusz ) );
+    return clip_to_bounds( tripoint_range<tripoint_bub_ms>( center - offset, center + offset ) );
 }
 
 tripoint_range<tripoint_bub_ms> map::points_on_zlevel( const int z ) const
 {
-    if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
-        // TODO: need a default constructor that creates an empty range.
-        return tripoint_range<tripoint_bub_ms>( tripoint_bub_ms_zero,
-                                                tripoint_bub_ms_zero - tripoint_rel_ms_above );
-    }
-    return tripoint_range<tripoint_bub_ms>(
-    { 0, 0, z }, { SEEX * my_MAPSIZE - 1, SEEY * my_MAPSIZE - 1, z } );
+    return clip_to_bounds( tripoint_range<tripoint_bub_ms>(
+    { 0, 0, z }, { SEEX * my_MAPSIZE - 1, SEEY * my_MAPSIZE - 1, z } ) );
 }
 
 tripoint_range<tripoint_bub_ms> map::points_on_zlevel() const
@@ -10827,6 +11356,7 @@ void map::update_pathfinding_cache( int zlev ) const
         }
     }
     cache.dirty_points.clear();
+    ++cache.generation;
 }
 
 void map::clip_to_bounds( tripoint &p ) const
@@ -74,6 +74,7 @@ class zone_data;
 struct fragment_cloud;
 struct partial_con;
 struct spawn_data;
+struct submap_catch_up;
 struct trap;
 template<typename Tripoint>
 class tripoint_range;
@@ -96,11 +97,16 @@ using VehicleList = std::vector<wrapped_vehicle>;
 class map;
 
 enum class ter_furn_flag : int;
+struct flow_field;
 struct pathfinding_cache;
+struct portal_graph;
+struct route_request;
 struct pathfinding_settings;
 template<typename T>
 struct weighted_int_list;
 struct field_proc_data;
+struct gas_spread_plan;
+struct map_item_to_process;
 
 class PathfindingFlags;
 
@@ -120,6 +126,7 @@ class map_stack : public item_stack
             return MAX_ITEM_IN_SQUARE;
         }
         units::volume max_volume() const override;
+        units::volume stored_volume() const override;
 };
 
 struct visibility_variables {
@@ -367,6 +374,8 @@ struct tile_render_info {
 class map
 {
         friend class editmap;
+        // reads submap revisions to skip unchanged submaps
+        friend class pixel_minimap;
         friend std::list<item> map_cursor::remove_items_with( const std::function<bool( const item & )> &,
                 int );
 
@@ -446,6 +455,17 @@ class map
          * false, if such path definitely not possible.
          */
         bool has_potential_los( const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const;
+        /**
+         * Incremented whenever build_map_cache finds that what can be seen from where may
+         * have changed, so sight checks done earlier can be reused while it stays the same.
+         */
+        int get_vision_generation() const {
+            return vision_generation;
+        }
+        /** Incremented whenever a lightmap is generated. */
+        int get_light_generation() const {
+            return light_generation;
+        }
 
         /**
          * Callback invoked when a vehicle has moved.
@@ -572,13 +592,26 @@ class map
         void spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
                          const time_duration &outdoor_age_speedup, scent_block &sblk,
                          const oter_id &om_ter );
+        /**
+         * Ages and spreads the gas @p cur at @p p.  With a @p plan the gas goes where the plan
+         * says, or nowhere if the plan has no entry for it, instead of deciding now.
+         */
         void spread_gas( field_entry &cur, const tripoint_bub_ms &p, int percent_spread,
                          const time_duration &outdoor_age_speedup, scent_block &sblk,
-                         const oter_id &om_ter );
+                         const oter_id &om_ter, const gas_spread_plan *plan = nullptr );
+        /**
+         * Where the gas @p cur at @p p spreads to this turn, if anywhere.  Only reads the map,
+         * the random draws come from @p engine.
+         */
+        std::optional<tripoint_bub_ms> gas_spread_target( const field_entry &cur,
+                const tripoint_bub_ms &p, int percent_spread, const oter_id &om_ter,
+                cata_default_random_engine &engine ) const;
+        /** Decides the spread of every gas in the submaps that hold fields, on several threads. */
+        std::map<tripoint_bub_sm, gas_spread_plan> plan_gas_spread();
         // TODO: get rid of untyped overload.
         void create_hot_air( const tripoint &p, int intensity );
         void create_hot_air( const tripoint_bub_ms &p, int intensity );
-        bool gas_can_spread_to( field_entry &cur, const maptile &dst );
+        bool gas_can_spread_to( const field_entry &cur, const const_maptile &dst ) const;
         void gas_spread_to( field_entry &cur, maptile &dst, const tripoint_bub_ms &p );
         int burn_body_part( Character &you, field_entry &cur, const bodypart_id &bp, int scale );
     public:
@@ -768,16 +801,32 @@ class map
          * @param pre_closed Never path through those points. They can still be the source or the destination.
          */
         // TODO: fix point types (remove the first overload)
+        // An empty @p avoid avoids nothing, and is faster than a function that returns false.
         std::vector<tripoint> route( const tripoint &f, const tripoint &t,
                                      const pathfinding_settings &settings,
-        const std::function<bool( const tripoint & )> &avoid = []( const tripoint & ) {
-            return false;
-        } ) const;
+                                     const std::function<bool( const tripoint & )> &avoid = {} ) const;
         std::vector<tripoint_bub_ms> route( const tripoint_bub_ms &f, const tripoint_bub_ms &t,
                                             const pathfinding_settings &settings,
-        const std::function<bool( const tripoint & )> &avoid = []( const tripoint & ) {
-            return false;
-        } ) const;
+                                            const std::function<bool( const tripoint & )> &avoid = {} ) const;
+
+        /**
+         * Like @ref route, for callers that are likely to share a destination, e.g. a horde
+         * chasing the same creature.  Once the same target has been requested twice in a turn
+         * with equal settings, a distance field towards it is computed and shared by all
+         * further callers, which then only follow its gradient.  Falls back to @ref route
+         * when the field can't be used (other z-level, trap avoidance, blocked gradient).
+         */
+        std::vector<tripoint> shared_route( const tripoint &f, const tripoint &t,
+                                            const pathfinding_settings &settings,
+                                            const std::function<bool( const tripoint & )> &avoid ) const;
+        /**
+         * Solves the given requests concurrently, ahead of the route calls asking for them.
+         * The next @ref route call with the same endpoints and settings takes the result,
+         * provided the map didn't change since and the path avoids what the caller avoids.
+         * Results that aren't taken are dropped by the next call.  Requests across z-levels
+         * are skipped, and nothing is done when there are too few to be worth it.
+         */
+        void prepare_routes( const std::vector<route_request> &requests ) const;
 
         // Get a straight route from f to t, only along non-rough terrain. Returns an empty vector
         // if that is not possible.
@@ -801,11 +850,32 @@ class map
         int extra_cost( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
                         const pathfinding_settings &settings,
                         PathfindingFlags p_special ) const;
+        // Fills the distances of |field| towards its target, see shared_route.
+        void build_flow_field( flow_field &field ) const;
+        // The search behind route, templated on the avoid predicate so the innermost loop can
+        // inline it.  Only instantiated in pathfinding.cpp.
+        template<typename Avoid>
+        std::vector<tripoint> route_impl( const tripoint &f, const tripoint &t,
+                                          const pathfinding_settings &settings, const Avoid &avoid ) const;
+        // A* limited to the box around |f| and |t|, the main part of route.
+        template<typename Avoid>
+        std::vector<tripoint> local_route( const tripoint &f, const tripoint &t,
+                                           const pathfinding_settings &settings, const Avoid &avoid ) const;
+        // Plans a path on the same z-level over the portal graph, then refines it with
+        // local_route between the portals.  Returns an empty vector on failure.
+        template<typename Avoid>
+        std::vector<tripoint> hierarchical_route( const tripoint &f, const tripoint &t,
+                const pathfinding_settings &settings, const Avoid &avoid ) const;
+        // Rebuilds the portal graph of |zlev| if the pathfinding cache changed since.
+        const portal_graph &get_portal_graph( int zlev ) const;
     public:
 
         // Vehicles: Common to 2D and 3D
         VehicleList get_vehicles();
+        // (re)caches the parts of one vehicle, dropping the points it no longer covers
         void add_vehicle_to_cache( vehicle * );
+        // drops all points cached for the vehicle, leaving other vehicles' entries alone
+        void clear_vehicle_parts_from_cache( vehicle *veh );
         void clear_vehicle_point_from_cache( vehicle *veh, const tripoint_bub_ms &pt );
         // clears all vehicle level caches
         void clear_vehicle_level_caches();
@@ -1439,6 +1509,10 @@ class map
         // TODO: fix point types (remove the first overload)
         void i_rem( const tripoint &p, item *it );
         void i_rem( const tripoint_bub_ms &p, item *it );
+        // Changes whenever an item is put on or taken from a tile, for caches of the items around.
+        int get_items_revision() const {
+            return items_revision;
+        }
         void spawn_artifact( const tripoint_bub_ms &p, const relic_procgen_id &id, int max_attributes = 5,
                              int power_level = 1000, int max_negative_power = -2000, bool is_resonant = false );
         // TODO: Get rid of untyped overload
@@ -1719,7 +1793,8 @@ class map
                                   const units::mass &burned_mass );
         // See fields.cpp
         void process_fields();
-        void process_fields_in_submap( submap *current_submap, const tripoint_bub_sm &submap_pos );
+        void process_fields_in_submap( submap *current_submap, const tripoint_bub_sm &submap_pos,
+                                       const gas_spread_plan *gas_plan = nullptr );
         /**
          * Apply field effects to the creature when it's on a square with fields.
          */
@@ -1883,12 +1958,12 @@ class map
 
         // Scent propagation helpers
         /**
-         * Build the map of scent-resistant tiles.
+         * Build the map of scent-resistant tiles, as weights of how much scent passes through
+         * each tile, see @ref submap::get_scent_weights.  Vehicle obstacles reduce scent too.
          * Should be way faster than if done in `game.cpp` using public map functions.
          */
         // TODO: make it typed.
-        void scent_blockers( std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &blocks_scent,
-                             std::array<std::array<bool, MAPSIZE_X>, MAPSIZE_Y> &reduces_scent,
+        void scent_blockers( std::array<std::array<std::uint8_t, MAPSIZE_Y>, MAPSIZE_X> &scent_weights,
                              const point_bub_ms &min, const point_bub_ms &max );
 
         // Computers
@@ -2062,11 +2137,19 @@ class map
          */
         // TODO: fix point types (remove the first overload)
         tripoint_abs_ms getglobal( const tripoint &p ) const;
-        tripoint_abs_ms getglobal( const tripoint_bub_ms &p ) const;
+        tripoint_abs_ms getglobal( const tripoint_bub_ms &p ) const {
+            return tripoint_abs_ms{ p.x() + abs_ms.x(), p.y() + abs_ms.y(), p.z() };
+        }
+        /** Translates many points at once, see above. */
+        std::vector<tripoint_abs_ms> getglobal( const std::vector<tripoint_bub_ms> &points ) const;
         /**
          * Inverse of @ref getglobal
          */
-        tripoint_bub_ms bub_from_abs( const tripoint_abs_ms &p ) const;
+        tripoint_bub_ms bub_from_abs( const tripoint_abs_ms &p ) const {
+            return tripoint_bub_ms{ p.x() - abs_ms.x(), p.y() - abs_ms.y(), p.z() };
+        }
+        std::vector<tripoint_bub_ms> bub_from_abs(
+            const std::vector<tripoint_abs_ms> &points ) const;
         point_bub_ms bub_from_abs( const point_abs_ms &p ) const {
             return bub_from_abs( tripoint_abs_ms( p, abs_sub.z() ) ).xy();
         }
@@ -2162,10 +2245,11 @@ class map
          */
         void add_tree_tops( const tripoint_rel_sm &grid );
         /**
-         * Try to fill funnel based items here. Simulates rain from @p since till now.
+         * Try to fill funnel based items here. Simulates rain since the submap was last
+         * actualized till now, summing the weather up for the first funnel of the submap.
          * @param p The location in this map where to fill funnels.
          */
-        void fill_funnels( const tripoint_bub_ms &p, const time_point &since );
+        void fill_funnels( const tripoint_bub_ms &p, submap_catch_up &catch_up );
         /**
          * Try to grow a harvestable plant to the next stage(s).
          */
@@ -2173,23 +2257,26 @@ class map
         /**
          * Try to grow fruits on static plants (not planted by the player)
          * @param p Place to restock
-         * @param time_since_last_actualize Time since this function has been
-         * called the last time.
+         * @param catch_up The time since the submap was last actualized.
          */
-        void restock_fruits( const tripoint_bub_ms &p, const time_duration &time_since_last_actualize );
+        void restock_fruits( const tripoint_bub_ms &p, const submap_catch_up &catch_up );
         /**
          * Produce sap on tapped maple trees
          * @param p Location of tapped tree
-         * @param time_since_last_actualize Time since this function has been
-         * called the last time.
+         * @param catch_up The time since the submap was last actualized.
          */
-        void produce_sap( const tripoint_bub_ms &p, const time_duration &time_since_last_actualize );
+        void produce_sap( const tripoint_bub_ms &p, const submap_catch_up &catch_up );
     public:
         /**
         * Removes the tree at 'p' and produces a trunk_yield length line of trunks in the 'dir'
         * direction from 'p', leaving a stump behind at 'p'.
         */
         void cut_down_tree( tripoint_bub_ms p, point dir );
+        /**
+         * Flag the submap containing 'p' as changed so it is written on the next save.
+         * Only needed when the change bypasses the map and submap accessors.
+         */
+        void mark_submap_modified( const tripoint_bub_ms &p );
     protected:
         /**
          * Radiation-related plant (and fungus?) death.
@@ -2217,6 +2304,7 @@ class map
         bool build_transparency_cache( int zlev );
         bool build_vision_transparency_cache( int zlev );
         // fills lm with sunlight. pzlev is current player's zlevel
+        // Levels are only cast again if they or a level above changed, or got other light.
         void build_sunlight_cache( int pzlev );
     public:
         void build_outside_cache( int zlev );
@@ -2373,6 +2461,11 @@ class map
         int determine_wall_corner( const tripoint_bub_ms &p ) const;
         // apply a circular light pattern immediately, however it's best to use...
         void apply_light_source( const tripoint_bub_ms &p, float luminance );
+        void apply_light_source( const tripoint_bub_ms &p, float luminance,
+                                 cata::mdarray<four_quadrants, point_bub_ms> &lm,
+                                 cata::mdarray<float, point_bub_ms> &sm );
+        // Casts the sources of light_source_buffer, reusing the light of unchanged ones.
+        void apply_buffered_light_sources( int zlev );
         // ...this, which will apply the light after at the end of generate_lightmap, and prevent redundant
         // light rays from causing massive slowdowns, if there's a huge amount of light.
         void add_light_source( const tripoint_bub_ms &p, float luminance );
@@ -2404,6 +2497,11 @@ class map
     private:
         // Iterates over every item on the map, passing each item to the provided function.
         void process_items_in_submap( submap &current_submap, const tripoint_rel_sm &gridp );
+        /** Hands out the items of the submap due for processing, with what they need to know of their tile. */
+        std::vector<map_item_to_process> items_to_process_in_submap( submap &current_submap,
+                const tripoint_rel_sm &gridp );
+        /** Processes @p items, except for what was done ahead by process_temperature_rot_ahead. */
+        void process_items_in_submap( submap &current_submap, std::vector<map_item_to_process> &items );
         void process_items_in_vehicles( submap &current_submap );
         void process_items_in_vehicle( vehicle &cur_veh, submap &current_submap );
 
@@ -2468,6 +2566,72 @@ class map
         mutable lru_cache_t skew_vision_cache;
         mutable lru_cache_t skew_vision_wo_fields_cache;
 
+        /**
+         * Visibility results for one origin, covering the square of the queried range
+         * around it on the origin's z-level. Cells hold -1 (not traced yet), 0 or 1.
+         */
+        struct visibility_field {
+            tripoint_bub_ms origin;
+            // Negative when the slot is unused.
+            int radius = -1;
+            bool with_fields = true;
+            unsigned int last_used = 0;
+            std::vector<int8_t> cells;
+
+            void reset( const tripoint_bub_ms &new_origin, int new_radius, bool new_with_fields );
+            /** Returns nullptr when `p` is outside the field. */
+            int8_t *cell( const tripoint_bub_ms &p );
+        };
+        static constexpr int max_visibility_fields = 16;
+        /**
+         * Fields for the origins that are queried repeatedly (monsters and NPCs tracking
+         * targets, turrets), so their sees() checks become a single lookup instead of a
+         * trace plus a hash probe. Cleared together with the skew vision caches.
+         */
+        mutable std::array<visibility_field, max_visibility_fields> visibility_fields;
+        /** Origins that missed recently; an origin gets a field on its second miss. */
+        mutable std::array<tripoint_bub_ms, max_visibility_fields> visibility_field_candidates;
+        mutable size_t next_visibility_field_candidate = 0;
+        mutable unsigned int visibility_field_clock = 0;
+        /**
+         * Returns the field of `origin` able to answer queries within `range`, creating it if
+         * the origin has been queried before. Returns nullptr if the origin has no field yet.
+         */
+        visibility_field *get_visibility_field( const tripoint_bub_ms &origin, int range,
+                                                bool with_fields ) const;
+        /** Returns the existing field of `origin`, if any, without creating one. */
+        visibility_field *find_visibility_field( const tripoint_bub_ms &origin,
+                bool with_fields ) const;
+        void clear_visibility_fields();
+
+        std::vector<tripoint_bub_ms> find_clear_path_uncached( const tripoint_bub_ms &source,
+                const tripoint_bub_ms &destination ) const;
+
+        /** A line of fire found by find_clear_path. */
+        struct clear_path_trace {
+            tripoint_bub_ms source;
+            tripoint_bub_ms destination;
+            std::vector<tripoint_bub_ms> path;
+        };
+        static constexpr size_t max_clear_path_traces = 8;
+        /**
+         * The most recent lines of fire, so burst fire and creatures attacking the same
+         * target again skip the search. Only valid for the turn, bubble position and vision
+         * generation stamped below.
+         */
+        mutable std::array<clear_path_trace, max_clear_path_traces> clear_path_traces;
+        mutable size_t next_clear_path_trace = 0;
+        mutable time_point clear_path_traces_turn = calendar::before_time_starts;
+        mutable tripoint_abs_sm clear_path_traces_origin;
+        mutable int clear_path_traces_generation = -1;
+
+        int vision_generation = 0;
+        int light_generation = 0;
+        // The sky the sunlight in the level caches was cast from, see build_sunlight_cache.
+        float sunlight_outside_level = -1.0f;
+        float sunlight_sight_penalty = -1.0f;
+        int sunlight_zlev_max = 0;
+
         // Note: no bounds check
         level_cache &get_cache( int zlev ) const {
             std::unique_ptr<level_cache> &cache = caches[zlev + OVERMAP_DEPTH];
@@ -2485,6 +2649,9 @@ class map
 
         visibility_variables visibility_variables_cache;
 
+        // see get_items_revision
+        int items_revision = 0;
+
         // caches the highest zlevel above which all zlevels are uniform
         // !value || value->first != map::abs_sub means cache is invalid
         std::optional<std::pair<tripoint_abs_sm, int>> max_populated_zlev = std::nullopt;
@@ -2519,6 +2686,12 @@ class map
         const std::set<tripoint_abs_sm> &get_submaps_with_active_items() const {
             return submaps_with_active_items;
         }
+        /**
+         * The points of @p range that are inside the map. Loops over the result need no
+         * @ref inbounds check, and a range entirely outside of the map is empty.
+         */
+        tripoint_range<tripoint_bub_ms> clip_to_bounds(
+            const tripoint_range<tripoint_bub_ms> &range ) const;
         // Clips the area to map bounds
         tripoint_range<tripoint_bub_ms> points_in_rectangle(
             const tripoint_bub_ms &from, const tripoint_bub_ms &to ) const;
@@ -38,6 +38,7 @@
 #include "fungal_effects.h"
 #include "game.h"
 #include "game_constants.h"
+#include "hash_utils.h"
 #include "item.h"
 #include "itype.h"
 #include "level_cache.h"
@@ -53,6 +54,7 @@
 #include "monster.h"
 #include "mtype.h"
 #include "npc.h"
+#include "options.h"
 #include "overmapbuffer.h"
 #include "point.h"
 #include "rng.h"
@@ -60,6 +62,7 @@
 #include "scent_map.h"
 #include "submap.h"
 #include "teleport.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "type_id.h"
 #include "units.h"
@@ -165,8 +168,56 @@ int map::burn_body_part( Character &you, field_entry &cur, const bodypart_id &bp
     return total_damage;
 }
 
+/** Where the gases of one submap spread to this turn, see map::plan_gas_spread. */
+struct gas_spread_plan {
+    // Gases without an entry don't spread.
+    std::map<std::pair<tripoint_bub_ms, field_type_id>, tripoint_bub_ms> targets;
+};
+
+// The three tiles next to @p pos that face the wind.
+static std::array<tripoint_bub_ms, 3> wind_blocker_points( int winddirection,
+        const tripoint_bub_ms &pos )
+{
+    static const std::array<std::pair<int, std::tuple< point_rel_ms, point_rel_ms, point_rel_ms >>, 9>
+    outputs = { {
+            { 330, std::make_tuple( point_rel_ms_east, point_rel_ms_north_east, point_rel_ms_south_east ) },
+            { 301, std::make_tuple( point_rel_ms_south_east, point_rel_ms_east, point_rel_ms_south ) },
+            { 240, std::make_tuple( point_rel_ms_south, point_rel_ms_south_west, point_rel_ms_south_east ) },
+            { 211, std::make_tuple( point_rel_ms_south_west, point_rel_ms_west, point_rel_ms_south ) },
+            { 150, std::make_tuple( point_rel_ms_west, point_rel_ms_north_west, point_rel_ms_south_west ) },
+            { 121, std::make_tuple( point_rel_ms_north_west, point_rel_ms_north, point_rel_ms_west ) },
+            { 60, std::make_tuple( point_rel_ms_north, point_rel_ms_north_west, point_rel_ms_north_east ) },
+            { 31, std::make_tuple( point_rel_ms_north_east, point_rel_ms_east, point_rel_ms_north ) },
+            { 0, std::make_tuple( point_rel_ms_east, point_rel_ms_north_east, point_rel_ms_south_east ) }
+        }
+    };
+
+    tripoint_bub_ms removepoint;
+    tripoint_bub_ms removepoint2;
+    tripoint_bub_ms removepoint3;
+    for( const std::pair<int, std::tuple< point_rel_ms, point_rel_ms, point_rel_ms >> &val : outputs ) {
+        if( winddirection >= val.first ) {
+            removepoint = pos + std::get<0>( val.second );
+            removepoint2 = pos + std::get<1>( val.second );
+            removepoint3 = pos + std::get<2>( val.second );
+            break;
+        }
+    }
+
+    return { { removepoint, removepoint2, removepoint3 } };
+}
+
 void map::process_fields()
 {
+    // Deferred spreading decides where all gases go from the fields as they are at the start
+    // of the turn, the default decides for each gas when it is processed.
+    const bool deferred_gas_spread = get_option<bool>( "DEFERRED_GAS_SPREAD" );
+    std::map<tripoint_bub_sm, gas_spread_plan> gas_plans;
+    if( deferred_gas_spread ) {
+        gas_plans = plan_gas_spread();
+    }
+    const gas_spread_plan no_spread;
+
     for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
         auto &field_cache = get_cache( z ).field_cache;
         for( int x = 0; x < my_MAPSIZE; x++ ) {
@@ -177,7 +228,12 @@ void map::process_fields()
                         debugmsg( "Tried to process field at (%d,%d,%d) but the submap is not loaded", x, y, z );
                         continue;
                     }
-                    process_fields_in_submap( current_submap, { x, y, z } );
+                    const gas_spread_plan *gas_plan = nullptr;
+                    if( deferred_gas_spread ) {
+                        const auto plan = gas_plans.find( tripoint_bub_sm( x, y, z ) );
+                        gas_plan = plan == gas_plans.end() ? &no_spread : &plan->second;
+                    }
+                    process_fields_in_submap( current_submap, { x, y, z }, gas_plan );
                     if( current_submap->field_count == 0 ) {
                         field_cache[ x + y * MAPSIZE ] = false;
                     }
@@ -187,6 +243,77 @@ void map::process_fields()
     }
 }
 
+std::map<tripoint_bub_sm, gas_spread_plan> map::plan_gas_spread()
+{
+    struct submap_job {
+        tripoint_bub_sm pos;
+        const submap *sm;
+        oter_id om_ter;
+        gas_spread_plan *plan;
+    };
+    std::map<tripoint_bub_sm, gas_spread_plan> plans;
+    std::vector<submap_job> jobs;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        const auto &field_cache = get_cache( z ).field_cache;
+        for( int x = 0; x < my_MAPSIZE; x++ ) {
+            for( int y = 0; y < my_MAPSIZE; y++ ) {
+                if( !field_cache[ x + y * MAPSIZE ] ) {
+                    continue;
+                }
+                const tripoint_bub_sm pos( x, y, z );
+                const submap *const sm = get_submap_at_grid( rebase_rel( pos ) );
+                if( sm == nullptr ) {
+                    // Reported when the fields get processed.
+                    continue;
+                }
+                // Looking up the overmap terrain may generate overmaps, do it before splitting up.
+                const oter_id om_ter = overmap_buffer.ter( coords::project_to<coords::omt>(
+                                           abs_sub + rebase_rel( pos ) ) );
+                jobs.push_back( { pos, sm, om_ter, &plans[pos] } );
+            }
+        }
+    }
+    if( jobs.empty() ) {
+        return plans;
+    }
+    // Checking for shelter asks vehicles whether a tile is inside, which refreshes them first.
+    for( wrapped_vehicle &v : get_vehicles() ) {
+        v.v->refresh_insides();
+    }
+
+    // Every submap draws from its own engine, so the result doesn't depend on the threads.
+    const int turn = to_turn<int>( calendar::turn );
+    const auto plan_submap = [this, turn]( const submap_job & job ) {
+        size_t seed = rng_get_first_seed();
+        cata::hash_combine( seed, turn );
+        cata::hash_combine( seed, ( abs_sub + rebase_rel( job.pos ) ).raw() );
+        cata_default_random_engine engine( static_cast<cata_default_random_engine::result_type>
+                                           ( seed ) );
+        const point_bub_ms sm_offset = coords::project_to<coords::ms>( job.pos.xy() );
+        job.sm->for_each_field( [&]( const point_sm_ms & local, const field & fld ) {
+            const tripoint_bub_ms p( sm_offset + rebase_rel( local ), job.pos.z() );
+            for( const std::pair<const field_type_id, field_entry> &fd : fld ) {
+                const field_entry &cur = fd.second;
+                // Same as the gases process_fields_in_submap lets spread.
+                if( !cur.is_field_alive() || cur.get_field_age() == 0_turns ||
+                    !fd.first->gas_can_spread() ) {
+                    continue;
+                }
+                const std::optional<tripoint_bub_ms> target = gas_spread_target( cur, p,
+                        fd.first->percent_spread, job.om_ter, engine );
+                if( target ) {
+                    job.plan->targets.emplace( std::make_pair( p, fd.first ), *target );
+                }
+            }
+        } );
+    };
+
+    parallel_for( jobs.size(), [&plan_submap, &jobs]( size_t i ) {
+        plan_submap( jobs[i] );
+    } );
+    return plans;
+}
+
 bool ter_furn_has_flag( const ter_t &ter, const furn_t &furn, const ter_furn_flag flag )
 {
     return ter.has_flag( flag ) || furn.has_flag( flag );
@@ -269,7 +396,7 @@ std::array<std::pair<tripoint_bub_ms, maptile>, 8> map::get_neighbors( const tri
     };
 }
 
-bool map::gas_can_spread_to( field_entry &cur, const maptile &dst )
+bool map::gas_can_spread_to( const field_entry &cur, const const_maptile &dst ) const
 {
     const field_entry *tmpfld = dst.get_field().find_field( cur.get_field_type() );
     // Candidates are existing weaker fields or navigable/flagged tiles with no field.
@@ -315,16 +442,9 @@ void map::spread_gas( field_entry &cur, const tripoint &p, int percent_spread,
 }
 
 void map::spread_gas( field_entry &cur, const tripoint_bub_ms &p, int percent_spread,
-                      const time_duration &outdoor_age_speedup, scent_block &sblk, const oter_id &om_ter )
+                      const time_duration &outdoor_age_speedup, scent_block &sblk, const oter_id &om_ter,
+                      const gas_spread_plan *plan )
 {
-    // TODO: fix point types
-    const bool sheltered = g->is_sheltered( p );
-    weather_manager &weather = get_weather();
-    const int winddirection = weather.winddirection;
-    const int windpower = get_local_windpower( weather.windspeed, om_ter, getglobal( p ),
-                          winddirection,
-                          sheltered );
-
     const int current_intensity = cur.get_field_intensity();
     const field_type_id ft_id = cur.get_field_type();
 
@@ -344,24 +464,66 @@ void map::spread_gas( field_entry &cur, const tripoint_bub_ms &p, int percent_sp
         cur.set_field_age( current_age + outdoor_age_speedup );
     }
 
+    std::optional<tripoint_bub_ms> target;
+    if( plan == nullptr ) {
+        target = gas_spread_target( cur, p, percent_spread, om_ter, rng_get_engine() );
+    } else {
+        // Gas that spread here after the plan was made waits for the next turn, and gas that
+        // spread to the target since may have left no room for more.
+        const auto planned = plan->targets.find( std::make_pair( p, ft_id ) );
+        if( planned != plan->targets.end() && current_intensity > 1 &&
+            gas_can_spread_to( cur, maptile_at( planned->second ) ) ) {
+            target = planned->second;
+        }
+    }
+    if( target ) {
+        maptile dst = maptile_at_internal( *target );
+        gas_spread_to( cur, dst, *target );
+    }
+}
+
+std::optional<tripoint_bub_ms> map::gas_spread_target( const field_entry &cur,
+        const tripoint_bub_ms &p, int percent_spread, const oter_id &om_ter,
+        cata_default_random_engine &engine ) const
+{
+    // The draws rng(), one_in(), x_in_y() and random_entry() would make from the same engine.
+    const auto roll = [&engine]( int lo, int hi ) {
+        if( lo > hi ) {
+            std::swap( lo, hi );
+        }
+        return std::uniform_int_distribution<int>( lo, hi )( engine );
+    };
+    const auto roll_one_in = [&roll]( int chance ) {
+        return chance <= 1 || roll( 0, chance - 1 ) == 0;
+    };
+
+    // TODO: fix point types
+    const bool sheltered = g->is_sheltered( p );
+    const weather_manager &weather = get_weather();
+    const int winddirection = weather.winddirection;
+    const int windpower = get_local_windpower( weather.windspeed, om_ter, getglobal( p ),
+                          winddirection,
+                          sheltered );
+
     // Bail out if we don't meet the spread chance or required intensity.
-    if( current_intensity <= 1 || rng( 1, 100 - windpower ) > percent_spread ) {
-        return;
+    if( cur.get_field_intensity() <= 1 || roll( 1, 100 - windpower ) > percent_spread ) {
+        return std::nullopt;
     }
 
     // First check if we can fall
     // TODO: Make fall and rise chances parameters to enable heavy/light gas
     if( p.z() > -OVERMAP_DEPTH ) {
         const tripoint_bub_ms down = p + tripoint_rel_ms_below;
-        maptile down_tile = maptile_at_internal( down );
-        if( gas_can_spread_to( cur, down_tile ) && valid_move( p, down, true, true ) ) {
-            gas_spread_to( cur, down_tile, down );
-            return;
+        if( gas_can_spread_to( cur, maptile_at_internal( down ) ) && valid_move( p, down, true, true ) ) {
+            return down;
         }
     }
 
-    auto neighs = get_neighbors( p );
-    size_t end_it = static_cast<size_t>( rng( 0, neighs.size() - 1 ) );
+    std::array<tripoint_bub_ms, 8> neighs;
+    for( size_t i = 0; i < neighs.size(); i++ ) {
+        neighs[i] = p + eight_horizontal_neighbors[i];
+    }
+    size_t end_it = static_cast<size_t>( roll( 0, neighs.size() - 1 ) );
     std::vector<size_t> spread;
     // Then, spread to a nearby point.
     // If not possible (or randomly), try to spread up
@@ -370,45 +532,37 @@ void map::spread_gas( field_entry &cur, const tripoint_bub_ms &p, int percent_sp
     for( size_t i = ( end_it + 1 ) % neighs.size(), count = 0;
          count != neighs.size();
          i = ( i + 1 ) % neighs.size(), count++ ) {
-        const auto &neigh = neighs[i];
-        if( gas_can_spread_to( cur, neigh.second ) ) {
+        // Out of bounds neighbors are null tiles, which gas can't spread to.
+        if( gas_can_spread_to( cur, maptile_at( neighs[i] ) ) ) {
             spread.push_back( i );
         }
     }
 
-    if( !spread.empty() && one_in( spread.size() ) ) {
+    if( !spread.empty() && roll_one_in( spread.size() ) ) {
         // Construct the destination from offset and p
         if( sheltered || windpower < 5 ) {
-            std::pair<tripoint_bub_ms, maptile> &n = neighs[ random_entry( spread ) ];
-            gas_spread_to( cur, n.second, n.first );
-        } else {
-            std::vector<size_t> neighbour_vec;
-            auto maptiles = get_wind_blockers( winddirection, p );
-            // Three map tiles that are facing the wind direction.
-            const maptile &remove_tile = std::get<0>( maptiles );
-            const maptile &remove_tile2 = std::get<1>( maptiles );
-            const maptile &remove_tile3 = std::get<2>( maptiles );
-            for( const size_t &i : spread ) {
-                const maptile &neigh = neighs[i].second;
-                if( ( neigh.pos_ != remove_tile.pos_ &&
-                      neigh.pos_ != remove_tile2.pos_ &&
-                      neigh.pos_ != remove_tile3.pos_ ) ||
-                    x_in_y( 1, std::max( 2, windpower ) ) ) {
-                    neighbour_vec.push_back( i );
-                }
-            }
-            if( !neighbour_vec.empty() ) {
-                std::pair<tripoint_bub_ms, maptile> &n = neighs[ random_entry( neighbour_vec ) ];
-                gas_spread_to( cur, n.second, n.first );
+            return neighs[ spread[roll( 0, spread.size() - 1 )] ];
+        }
+        std::vector<size_t> neighbour_vec;
+        // Three map tiles that are facing the wind direction.
+        const std::array<tripoint_bub_ms, 3> blockers = wind_blocker_points( winddirection, p );
+        for( const size_t &i : spread ) {
+            if( std::find( blockers.begin(), blockers.end(), neighs[i] ) == blockers.end() ||
+                std::uniform_real_distribution<double>( 0.0, 1.0 )( engine ) <= 1.0 / std::max( 2,
+                        windpower ) ) {
+                neighbour_vec.push_back( i );
             }
         }
+        if( !neighbour_vec.empty() ) {
+            return neighs[ neighbour_vec[roll( 0, neighbour_vec.size() - 1 )] ];
+        }
     } else if( p.z() < OVERMAP_HEIGHT ) {
         const tripoint_bub_ms up = p + tripoint_rel_ms_above;
-        maptile up_tile = maptile_at_internal( up );
-        if( gas_can_spread_to( cur, up_tile ) && valid_move( p, up, true, true ) ) {
-            gas_spread_to( cur, up_tile, up );
+        if( gas_can_spread_to( cur, maptile_at_internal( up ) ) && valid_move( p, up, true, true ) ) {
+            return up;
         }
     }
+    return std::nullopt;
 }
 
 /*
@@ -458,6 +612,8 @@ struct field_proc_data {
     maptile &map_tile;
     field_type_id cur_fd_type_id;
     field_type const *cur_fd_type;
+    // Where the gases go, when they spread from last turn's fields.
+    const gas_spread_plan *gas_plan;
 };
 
 /*
@@ -467,7 +623,7 @@ This is the general update function for field effects. This should only be calle
 If you need to insert a new field behavior per unit time add a case statement in the switch below.
 */
 void map::process_fields_in_submap( submap *const current_submap,
-                                    const tripoint_bub_sm &submap )
+                                    const tripoint_bub_sm &submap, const gas_spread_plan *gas_plan )
 {
     const oter_id &om_ter = overmap_buffer.ter( coords::project_to<coords::omt>(
                                 abs_sub + rebase_rel( submap ) ) );
@@ -487,61 +643,68 @@ void map::process_fields_in_submap( submap *const current_submap,
         *this,
         map_tile,
         fd_null,
-        &( *fd_null )
+        &( *fd_null ),
+        gas_plan
     };
 
-    // Loop through all tiles in this submap indicated by current_submap
-    for( locx = 0; locx < SEEX; locx++ ) {
-        for( locy = 0; locy < SEEY; locy++ ) {
-            // Get a reference to the field variable from the submap;
-            // contains all the pointers to the real field effects.
-            field &curfield = current_submap->get_field( { static_cast<int>( locx ), static_cast<int>( locy ) } );
+    // Loop through the tiles of this submap that may hold fields, in the same column by column
+    // order as all of them. Fields spreading into tiles further along get processed this turn.
+    std::bitset<SEEX * SEEY> &field_tiles = current_submap->field_tiles;
+    for( size_t tile = 0; tile < field_tiles.size(); tile++ ) {
+        if( !field_tiles.test( tile ) ) {
+            continue;
+        }
+        locx = static_cast<int>( tile / SEEY );
+        locy = static_cast<int>( tile % SEEY );
+        // Get a reference to the field variable from the submap;
+        // contains all the pointers to the real field effects.
+        field &curfield = current_submap->get_field( { static_cast<int>( locx ), static_cast<int>( locy ) } );
 
-            // when displayed_field_type == fd_null it means that `curfield` has no fields inside
-            // avoids instantiating (relatively) expensive map iterator
-            if( !curfield.displayed_field_type() ) {
-                continue;
-            }
+        // when displayed_field_type == fd_null it means that `curfield` has no fields inside
+        // avoids instantiating (relatively) expensive map iterator
+        if( !curfield.displayed_field_type() ) {
+            field_tiles.reset( tile );
+            continue;
+        }
 
-            // This is a translation from local coordinates to submap coordinates.
-            const tripoint_bub_ms p{sm_offset + rebase_rel( map_tile.pos() ), submap.z()};
+        // This is a translation from local coordinates to submap coordinates.
+        const tripoint_bub_ms p{sm_offset + rebase_rel( map_tile.pos() ), submap.z()};
 
-            for( auto it = curfield.begin(); it != curfield.end(); ) {
-                // Iterating through all field effects in the submap's field.
-                field_entry &cur = it->second;
-                const int prev_intensity = cur.is_field_alive() ? cur.get_field_intensity() : 0;
+        for( auto it = curfield.begin(); it != curfield.end(); ) {
+            // Iterating through all field effects in the submap's field.
+            field_entry &cur = it->second;
+            const int prev_intensity = cur.is_field_alive() ? cur.get_field_intensity() : 0;
 
-                pd.cur_fd_type_id = cur.get_field_type();
-                pd.cur_fd_type = &( *pd.cur_fd_type_id );
+            pd.cur_fd_type_id = cur.get_field_type();
+            pd.cur_fd_type = &( *pd.cur_fd_type_id );
 
-                // The field might have been killed by processing a neighbor field
-                if( prev_intensity == 0 ) {
-                    on_field_modified( p, *pd.cur_fd_type );
-                    --current_submap->field_count;
-                    curfield.remove_field( it++ );
-                    continue;
-                }
-
-                // Don't process "newborn" fields. This gives the player time to run if they need to.
-                if( cur.get_field_age() == 0_turns ) {
-                    cur.do_decay();
-                    if( !cur.is_field_alive() || cur.get_field_intensity() != prev_intensity ) {
-                        on_field_modified( p, *pd.cur_fd_type );
-                    }
-                    it++;
-                    continue;
-                }
-
-                for( const FieldProcessorPtr &proc : pd.cur_fd_type->get_processors() ) {
-                    proc( p.raw(), cur, pd );
-                }
+            // The field might have been killed by processing a neighbor field
+            if( prev_intensity == 0 ) {
+                on_field_modified( p, *pd.cur_fd_type );
+                --current_submap->field_count;
+                curfield.remove_field( it++ );
+                continue;
+            }
 
+            // Don't process "newborn" fields. This gives the player time to run if they need to.
+            if( cur.get_field_age() == 0_turns ) {
                 cur.do_decay();
                 if( !cur.is_field_alive() || cur.get_field_intensity() != prev_intensity ) {
                     on_field_modified( p, *pd.cur_fd_type );
                 }
                 it++;
+                continue;
             }
+
+            for( const FieldProcessorPtr &proc : pd.cur_fd_type->get_processors() ) {
+                proc( p.raw(), cur, pd );
+            }
+
+            cur.do_decay();
+            if( !cur.is_field_alive() || cur.get_field_intensity() != prev_intensity ) {
+                on_field_modified( p, *pd.cur_fd_type );
+            }
+            it++;
         }
     }
     sblk.commit_modifications();
@@ -624,8 +787,8 @@ static void field_processor_apply_slime( const tripoint &p, field_entry &cur, fi
 void field_processor_spread_gas( const tripoint &p, field_entry &cur, field_proc_data &pd )
 {
     // if( cur.gas_can_spread() )
-    pd.here.spread_gas( cur, p, pd.cur_fd_type->percent_spread, pd.cur_fd_type->outdoor_age_speedup,
-                        pd.sblk, pd.om_ter );
+    pd.here.spread_gas( cur, tripoint_bub_ms( p ), pd.cur_fd_type->percent_spread,
+                        pd.cur_fd_type->outdoor_age_speedup, pd.sblk, pd.om_ter, pd.gas_plan );
 }
 
 static void field_processor_fd_fungal_haze( const tripoint &p, field_entry &cur,
@@ -708,10 +871,7 @@ static void field_processor_fd_electricity( const tripoint &p, field_entry &cur,
     std::vector<tripoint> other_tiles;
 
     bool valid_candidates = false;
-    for( const tripoint_bub_ms &dst : points_in_radius( tripoint_bub_ms( p ), 1 ) ) {
-        if( !pd.here.inbounds( dst ) ) {
-            continue;
-        }
+    for( const tripoint_bub_ms &dst : pd.here.points_in_radius( tripoint_bub_ms( p ), 1 ) ) {
         // Skip tiles with intense fields
         const field_type_str_id &field_type = pd.here.get_applicable_electricity_field( dst );
         if( field_entry *field = pd.here.get_field( dst, field_type ) ) {
@@ -840,7 +1000,8 @@ static void field_processor_fd_push_items( const tripoint &p, field_entry &, fie
             pushee++;
         } else {
             std::vector<tripoint_bub_ms> valid;
-            for( const tripoint_bub_ms &dst : points_in_radius( tripoint_bub_ms( p ), 1 ) ) {
+            for( const tripoint_bub_ms &dst :
+                 pd.here.points_in_radius( tripoint_bub_ms( p ), 1 ) ) {
                 if( dst.raw() != p && pd.here.get_field( dst, fd_push_items ) ) {
                     valid.push_back( dst );
                 }
@@ -925,7 +1086,7 @@ static void field_processor_fd_acid_vent( const tripoint &p, field_entry &cur, f
         }
     } else {
         cur.set_field_intensity( 3 );
-        for( const tripoint_bub_ms &t : points_in_radius( tripoint_bub_ms( p ), 5 ) ) {
+        for( const tripoint_bub_ms &t : pd.here.points_in_radius( tripoint_bub_ms( p ), 5 ) ) {
             const field_entry *acid = pd.here.get_field( t, fd_acid );
             if( acid && acid->get_field_intensity() == 0 ) {
                 int new_intensity = 3 - rl_dist( p, t.raw() ) / 2 + ( one_in( 3 ) ? 1 : 0 );
@@ -2125,35 +2286,10 @@ std::tuple<maptile, maptile, maptile> map::get_wind_blockers( const int &winddir
 std::tuple<maptile, maptile, maptile> map::get_wind_blockers( const int &winddirection,
         const tripoint_bub_ms &pos )
 {
-    static const std::array<std::pair<int, std::tuple< point_rel_ms, point_rel_ms, point_rel_ms >>, 9>
-    outputs = { {
-            { 330, std::make_tuple( point_rel_ms_east, point_rel_ms_north_east, point_rel_ms_south_east ) },
-            { 301, std::make_tuple( point_rel_ms_south_east, point_rel_ms_east, point_rel_ms_south ) },
-            { 240, std::make_tuple( point_rel_ms_south, point_rel_ms_south_west, point_rel_ms_south_east ) },
-            { 211, std::make_tuple( point_rel_ms_south_west, point_rel_ms_west, point_rel_ms_south ) },
-            { 150, std::make_tuple( point_rel_ms_west, point_rel_ms_north_west, point_rel_ms_south_west ) },
-            { 121, std::make_tuple( point_rel_ms_north_west, point_rel_ms_north, point_rel_ms_west ) },
-            { 60, std::make_tuple( point_rel_ms_north, point_rel_ms_north_west, point_rel_ms_north_east ) },
-            { 31, std::make_tuple( point_rel_ms_north_east, point_rel_ms_east, point_rel_ms_north ) },
-            { 0, std::make_tuple( point_rel_ms_east, point_rel_ms_north_east, point_rel_ms_south_east ) }
-        }
-    };
-
-    tripoint_bub_ms removepoint;
-    tripoint_bub_ms removepoint2;
-    tripoint_bub_ms removepoint3;
-    for( const std::pair<int, std::tuple< point_rel_ms, point_rel_ms, point_rel_ms >> &val : outputs ) {
-        if( winddirection >= val.first ) {
-            removepoint = pos + std::get<0>( val.second );
-            removepoint2 = pos + std::get<1>( val.second );
-            removepoint3 = pos + std::get<2>( val.second );
-            break;
-        }
-    }
-
-    const maptile remove_tile = maptile_at( removepoint );
-    const maptile remove_tile2 = maptile_at( removepoint2 );
-    const maptile remove_tile3 = maptile_at( removepoint3 );
+    const std::array<tripoint_bub_ms, 3> removepoints = wind_blocker_points( winddirection, pos );
+    const maptile remove_tile = maptile_at( removepoints[0] );
+    const maptile remove_tile2 = maptile_at( removepoints[1] );
+    const maptile remove_tile3 = maptile_at( removepoints[2] );
     return std::make_tuple( remove_tile, remove_tile2, remove_tile3 );
 }
 
@@ -2,7 +2,9 @@
 #ifndef CATA_SRC_MAP_ITERATOR_H
 #define CATA_SRC_MAP_ITERATOR_H
 
+#include <algorithm>
 #include <cstddef>
+#include <functional>
 
 #include "enums.h"
 #include "point.h"
@@ -105,6 +107,29 @@ class tripoint_range
             endp = Tripoint( minp.xy(), traits::z( maxp ) + 1 );
         }
 
+        /**
+         * The points of this range inside the box from @p lo to @p hi (inclusive), with the
+         * same predicate. The bounds are checked once here instead of for every point, and a
+         * range that does not overlap the box yields no points at all.
+         */
+        tripoint_range clipped( const Tripoint &lo, const Tripoint &hi ) const {
+            tripoint_range ret( *this );
+            traits::x( ret.minp ) = std::max( traits::x( minp ), traits::x( lo ) );
+            traits::y( ret.minp ) = std::max( traits::y( minp ), traits::y( lo ) );
+            traits::z( ret.minp ) = std::max( traits::z( minp ), traits::z( lo ) );
+            traits::x( ret.maxp ) = std::min( traits::x( maxp ), traits::x( hi ) );
+            traits::y( ret.maxp ) = std::min( traits::y( maxp ), traits::y( hi ) );
+            traits::z( ret.maxp ) = std::min( traits::z( maxp ), traits::z( hi ) );
+            if( traits::x( ret.minp ) > traits::x( ret.maxp ) ||
+                traits::y( ret.minp ) > traits::y( ret.maxp ) ) {
+                // Iteration only stops at the end of a z-level, so an empty x or y span has to
+                // become an empty z span: begin() is then the end point.
+                traits::z( ret.maxp ) = traits::z( ret.minp ) - 1;
+            }
+            ret.endp = Tripoint( ret.minp.xy(), traits::z( ret.maxp ) + 1 );
+            return ret;
+        }
+
         point_generator begin() const {
             return point_generator( minp, *this );
         }
@@ -1,3 +1,11 @@
+#include <deque>
+#include <exception>
+#include <string>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include "alloc_profiler.h"
 #include "cata_assert.h"
 #include "cached_options.h"
 #include "cata_utility.h"
@@ -5,10 +13,14 @@
 #include "cuboid_rectangle.h"
 #include "debug.h"
 #include "filesystem.h"
+#include "flexbuffer_cache.h"
+#include "json_loader.h"
 #include "line.h"
 #include "map_memory.h"
+#include "options.h"
 #include "path_info.h"
 #include "string_formatter.h"
+#include "thread_pool.h"
 #include "translations.h"
 
 const memorized_tile mm_submap::default_tile = {};
@@ -46,6 +58,46 @@ struct reg_coord_pair {
     }
 };
 
+namespace
+{
+/** Every tile id memorized so far, @ref memorized_tile refers to them by their index. */
+struct tile_id_list {
+    std::deque<std::string> ids{ std::string() };
+    std::unordered_map<std::string_view, uint32_t> index{ { ids.front(), 0 } };
+};
+
+tile_id_list &tile_ids()
+{
+    static tile_id_list list;
+    return list;
+}
+
+thread_pool &region_readers()
+{
+    // Reading is bound by the disk, so one thread is enough.
+    static thread_pool pool( 1 );
+    return pool;
+}
+} // namespace
+
+uint32_t memorized_tile::intern_id( const std::string_view id )
+{
+    tile_id_list &list = tile_ids();
+    const auto it = list.index.find( id );
+    if( it != list.index.end() ) {
+        return it->second;
+    }
+    const uint32_t result = static_cast<uint32_t>( list.ids.size() );
+    list.ids.emplace_back( id );
+    list.index.emplace( list.ids.back(), result );
+    return result;
+}
+
+const std::string &memorized_tile::id_str( uint32_t id )
+{
+    return tile_ids().ids[id];
+}
+
 mm_submap::mm_submap( bool make_valid ) : valid( make_valid ) {}
 
 bool mm_submap::is_empty() const
@@ -58,6 +110,16 @@ bool mm_submap::is_valid() const
     return valid;
 }
 
+bool mm_submap::is_dirty() const
+{
+    return dirty;
+}
+
+void mm_submap::set_dirty( bool value )
+{
+    dirty = value;
+}
+
 const memorized_tile &mm_submap::get_tile( const point_sm_ms &p ) const
 {
     if( tiles.empty() ) {
@@ -73,7 +135,11 @@ void mm_submap::set_tile( const point_sm_ms &p, const memorized_tile &value )
         tiles.reserve( SEEX * SEEY );
         tiles.resize( SEEX * SEEY, default_tile );
     }
-    tiles[p.y() * SEEX + p.x()] = value;
+    memorized_tile &tile = tiles[p.y() * SEEX + p.x()];
+    if( tile != value ) {
+        tile = value;
+        dirty = true;
+    }
 }
 
 mm_region::mm_region() : submaps( nullptr ) {}
@@ -91,24 +157,47 @@ bool mm_region::is_empty() const
     return true;
 }
 
+bool mm_region::is_dirty() const
+{
+    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+        // NOLINTNEXTLINE(modernize-loop-convert)
+        for( size_t x  = 0; x < MM_REG_SIZE; x++ ) {
+            if( submaps[x][y]->is_dirty() ) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+void mm_region::set_dirty( bool value )
+{
+    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+        // NOLINTNEXTLINE(modernize-loop-convert)
+        for( size_t x  = 0; x < MM_REG_SIZE; x++ ) {
+            submaps[x][y]->set_dirty( value );
+        }
+    }
+}
+
 const std::string &memorized_tile::get_ter_id() const
 {
-    return ter_id.str();
+    return id_str( ter_id );
 }
 
 const std::string &memorized_tile::get_dec_id() const
 {
-    return dec_id;
+    return id_str( dec_id );
 }
 
 void memorized_tile::set_ter_id( const std::string_view id )
 {
-    ter_id = ter_str_id( id );
+    ter_id = intern_id( id );
 }
 
 void memorized_tile::set_dec_id( const std::string_view id )
 {
-    dec_id = id;
+    dec_id = intern_id( id );
 }
 
 int memorized_tile::get_ter_rotation() const
@@ -260,6 +349,7 @@ void map_memory::clear_tile_decoration( const tripoint_abs_ms &pos, std::string_
 
 bool map_memory::prepare_region( const tripoint_abs_ms &p1, const tripoint_abs_ms &p2 )
 {
+    const alloc_profiler::scoped_tag alloc_tag( alloc_profiler::tag::map_memory );
     cata_assert( p1.z() == p2.z() );
     cata_assert( p1.x() <= p2.x() && p1.y() <= p2.y() );
 
@@ -295,6 +385,7 @@ bool map_memory::prepare_region( const tripoint_abs_ms &p1, const tripoint_abs_m
             }
         }
     }
+    prefetch_regions();
     return true;
 }
 
@@ -336,6 +427,10 @@ shared_ptr_fast<mm_submap> map_memory::allocate_submap( const tripoint_abs_sm &s
 
 shared_ptr_fast<mm_submap> map_memory::find_submap( const tripoint_abs_sm &sm_pos )
 {
+#if !CATA_SHARED_PTR_FAST_IS_ATOMIC
+    // Copies the shared pointer, worker threads use get_submap.
+    cata_assert( !thread_pool::on_worker_thread() );
+#endif
     auto sm = submaps.find( sm_pos );
     if( sm == submaps.end() ) {
         return nullptr;
@@ -351,18 +446,25 @@ shared_ptr_fast<mm_submap> map_memory::load_submap( const tripoint_abs_sm &sm_po
     }
 
     const reg_coord_pair p( sm_pos );
-    const cata_path path = find_region_path( find_mm_dir(), p.reg );
+    region_read read;
+    const auto pending = pending_reads.find( p.reg );
+    if( pending != pending_reads.end() ) {
+        read = pending->second.get();
+        pending_reads.erase( pending );
+    } else {
+        read = read_region( find_region_path( find_mm_dir(), p.reg ) );
+    }
 
     mm_region mmr;
-    const auto loader = [&mmr]( const JsonValue & jsin ) {
-        mmr.deserialize( jsin );
-    };
-
     try {
-        if( !read_from_file_optional_json( path, loader ) ) {
+        if( !read.error.empty() ) {
+            throw std::runtime_error( read.error );
+        }
+        if( !read.data ) {
             // Region not found
             return nullptr;
         }
+        mmr.deserialize( json_loader::from_flexbuffer( std::move( read.data ) ) );
     } catch( const std::exception &err ) {
         debugmsg( "Failed to load memory map region (%d,%d,%d): %s",
                   p.reg.x, p.reg.y, p.reg.z, err.what() );
@@ -387,6 +489,51 @@ shared_ptr_fast<mm_submap> map_memory::load_submap( const tripoint_abs_sm &sm_po
     return ret;
 }
 
+map_memory::region_read map_memory::read_region( const cata_path &path )
+{
+    region_read result;
+    try {
+        const fs::path file = path.get_unrelative_path();
+        if( file_exist( file ) ) {
+            // Parsed from the file itself, so the text isn't kept around next to the result.
+            result.data = flexbuffer_cache::parse( file );
+        }
+    } catch( const std::exception &err ) {
+        result.error = err.what();
+    }
+    return result;
+}
+
+void map_memory::prefetch_regions()
+{
+    if( test_mode ) {
+        return;
+    }
+    // The regions overlapping the cached area and a margin of one region around it.
+    const tripoint_rel_sm margin( MM_REG_SIZE, MM_REG_SIZE, 0 );
+    const tripoint reg_min = reg_coord_pair( cache_pos - margin ).reg;
+    const tripoint reg_max = reg_coord_pair( cache_pos + tripoint_rel_sm( cache_size.x, cache_size.y,
+                             0 ) + margin ).reg;
+    const cata_path dirname = find_mm_dir();
+    for( const auto &it : cached ) {
+        for( int y = reg_min.y; y <= reg_max.y; y++ ) {
+            for( int x = reg_min.x; x <= reg_max.x; x++ ) {
+                const tripoint reg( x, y, it.first );
+                if( pending_reads.count( reg ) ||
+                    submaps.count( tripoint_abs_sm( mmr_to_sm_copy( reg ) ) ) ) {
+                    continue;
+                }
+                auto promise = std::make_shared<std::promise<region_read>>();
+                pending_reads.emplace( reg, promise->get_future() );
+                const cata_path path = find_region_path( dirname, reg );
+                region_readers().push( [promise, path]() {
+                    promise->set_value( read_region( path ) );
+                } );
+            }
+        }
+    }
+}
+
 static mm_submap null_mz_submap;
 static mm_submap invalid_mz_submap{ false };
 static const tripoint_abs_sm invalid_cache_pos( tripoint_min );
@@ -417,11 +564,14 @@ bool map_memory::is_valid() const
 
 void map_memory::load( const tripoint_abs_ms &pos )
 {
+    const alloc_profiler::scoped_tag alloc_tag( alloc_profiler::tag::map_memory );
     const coord_pair p( pos );
     const tripoint_abs_sm start = p.sm - tripoint_rel_sm( MM_SIZE / 2, MM_SIZE / 2, 0 );
     dbg( D_INFO ) << "[LOAD] Loading memory map around " << p.sm << ". Loading submaps within " << start
                   << "->" << start + tripoint( MM_SIZE, MM_SIZE, 0 );
     clear_cache();
+    // Reads that were started for another save are of no use.
+    pending_reads.clear();
     for( int dy = 0; dy < MM_SIZE; dy++ ) {
         for( int dx = 0; dx < MM_SIZE; dx++ ) {
             fetch_submap( start + tripoint_rel_sm( dx, dy, 0 ) );
@@ -456,12 +606,14 @@ bool map_memory::save( const tripoint_abs_ms &pos )
                   rect_keep.p_min << "->" << rect_keep.p_max;
 
     bool result = true;
+    const int compression_level = get_option<int>( "SAVE_COMPRESSION" );
 
     for( auto &it : regions ) {
         const tripoint &regp = it.first;
         mm_region &reg = it.second;
-        if( !reg.is_empty() ) {
-            const cata_path path = find_region_path( dirname, regp );
+        const cata_path path = find_region_path( dirname, regp );
+        // Regions that didn't change since they were loaded are already on disk.
+        if( !reg.is_empty() && ( reg.is_dirty() || !file_exist( path ) ) ) {
             const std::string descr = string_format(
                                           _( "memory map region for (%d,%d,%d)" ),
                                           regp.x, regp.y, regp.z
@@ -474,7 +626,11 @@ bool map_memory::save( const tripoint_abs_ms &pos )
                 } );
             };
 
-            const bool res = write_to_file( path, writer, descr.c_str() );
+            const bool res = write_to_file_compressed( path, compression_level, writer,
+                             descr.c_str() );
+            if( res ) {
+                reg.set_dirty( false );
+            }
             result = result & res;
         }
         const tripoint_abs_sm regp_sm( mmr_to_sm_copy( regp ) );
@@ -497,6 +653,18 @@ bool map_memory::save( const tripoint_abs_ms &pos )
         }
     }
 
+    for( auto it = pending_reads.begin(); it != pending_reads.end(); ) {
+        const tripoint_abs_sm regp_sm( mmr_to_sm_copy( it->first ) );
+        const half_open_rectangle<point_abs_sm> rect_reg(
+            regp_sm.xy(),
+            regp_sm.xy() + point( MM_REG_SIZE, MM_REG_SIZE ) );
+        if( rect_reg.overlaps( rect_keep ) ) {
+            ++it;
+        } else {
+            it = pending_reads.erase( it );
+        }
+    }
+
     dbg( D_INFO ) << "[SAVE] Done.";
     dbg( D_INFO ) << "N submaps after save: " << submaps.size();
 
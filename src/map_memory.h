@@ -2,7 +2,14 @@
 #ifndef CATA_SRC_MAP_MEMORY_H
 #define CATA_SRC_MAP_MEMORY_H
 
+#include <cstdint>
+#include <future>
 #include <iosfwd>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "game_constants.h"
 #include "mdarray.h"
@@ -12,9 +19,9 @@
 class JsonObject;
 class JsonOut;
 class JsonValue;
-
-struct ter_t;
-using ter_str_id = string_id<ter_t>;
+class cata_path;
+struct mm_region_palette;
+struct parsed_flexbuffer;
 
 class memorized_tile
 {
@@ -42,8 +49,18 @@ class memorized_tile
         }
     private:
         friend struct mm_submap; // serialization needs access to private members
-        ter_str_id ter_id;       // terrain tile id
-        std::string dec_id;      // decoration tile id (furniture, vparts ...)
+        friend struct mm_region;
+
+        /**
+         * Tile ids are stored as indices into a list of every id memorized so far,
+         * which keeps a tile small and makes comparing two tiles cheap.
+         * The empty id is always 0.
+         */
+        static uint32_t intern_id( std::string_view id );
+        static const std::string &id_str( uint32_t id );
+
+        uint32_t ter_id = 0;     // terrain tile id
+        uint32_t dec_id = 0;     // decoration tile id (furniture, vparts ...)
         int8_t ter_rotation = 0;
         int8_t dec_rotation = 0;
         int8_t ter_subtile = 0;
@@ -62,18 +79,23 @@ struct mm_submap {
         bool is_empty() const;
         // @returns true if mm_submap is valid, i.e. not returned from an uninitialized region.
         bool is_valid() const;
+        // @returns true if a tile changed since the submap was loaded or saved.
+        bool is_dirty() const;
+        void set_dirty( bool value );
 
         const memorized_tile &get_tile( const point_sm_ms &p ) const;
         void set_tile( const point_sm_ms &p, const memorized_tile &value );
 
-        void serialize( JsonOut &jsout ) const;
-        void deserialize( int version, const JsonArray &ja );
+        void serialize( JsonOut &jsout, mm_region_palette &palette ) const;
+        void deserialize( int version, const JsonArray &ja, const mm_region_palette &palette );
 
     private:
         // NOLINTNEXTLINE(cata-serialize)
         std::vector<memorized_tile> tiles; // holds either 0 or SEEX*SEEY elements
         // NOLINTNEXTLINE(cata-serialize)
         bool valid = true;
+        // NOLINTNEXTLINE(cata-serialize)
+        bool dirty = false;
 };
 
 /**
@@ -87,6 +109,8 @@ struct mm_region {
     mm_region();
 
     bool is_empty() const;
+    bool is_dirty() const;
+    void set_dirty( bool value );
 
     void serialize( JsonOut &jsout ) const;
     void deserialize( const JsonValue &ja );
@@ -164,7 +188,17 @@ class map_memory
         void clear_tile_decoration( const tripoint_abs_ms &pos, std::string_view prefix = "" );
 
     private:
+        /** A region file as read and parsed on a background thread. */
+        struct region_read {
+            // nullptr if the file doesn't exist or couldn't be read
+            std::shared_ptr<parsed_flexbuffer> data;
+            // what went wrong, if anything
+            std::string error;
+        };
+
         std::map<tripoint_abs_sm, shared_ptr_fast<mm_submap>> submaps;
+        /** Region files being read in the background, by region coords. */
+        std::map<tripoint, std::future<region_read>> pending_reads;
 
         mutable std::map<int, std::vector<shared_ptr_fast<mm_submap>>> cached;
         tripoint_abs_sm cache_pos;
@@ -178,6 +212,12 @@ class map_memory
         shared_ptr_fast<mm_submap> load_submap( const tripoint_abs_sm &sm_pos );
         /** Allocate empty submap. @returns the submap. */
         shared_ptr_fast<mm_submap> allocate_submap( const tripoint_abs_sm &sm_pos );
+        /**
+         * Starts reading the regions next to the cached area that aren't loaded yet,
+         * so panning the view or traveling doesn't have to wait for the disk.
+         */
+        void prefetch_regions();
+        static region_read read_region( const cata_path &path );
 
         /** Get submap from within the cache */
         //@{
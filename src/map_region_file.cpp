@@ -0,0 +1,205 @@
+#include "map_region_file.h"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+#include "cata_assert.h"
+#include "mmap_file.h"
+
+static constexpr std::array<char, 8> region_magic = { 'C', 'D', 'D', 'A', 'M', 'R', 'G', '1' };
+static constexpr size_t entry_size = 8;
+
+static uint32_t read_le32( const char *p )
+{
+    uint32_t value = 0;
+    for( int i = 3; i >= 0; --i ) {
+        value = ( value << 8 ) | static_cast<unsigned char>( p[i] );
+    }
+    return value;
+}
+
+static void write_le32( char *p, uint32_t value )
+{
+    for( int i = 0; i < 4; ++i ) {
+        p[i] = static_cast<char>( value & 0xff );
+        value >>= 8;
+    }
+}
+
+map_region_file::map_region_file( const cata_path &path, const size_t num_slots )
+    : path( path ), table( num_slots )
+{
+}
+
+map_region_file::~map_region_file() = default;
+
+size_t map_region_file::header_sectors() const
+{
+    return sectors_for( region_magic.size() + table.size() * entry_size );
+}
+
+size_t map_region_file::sectors_for( const size_t length )
+{
+    return ( length + sector_size - 1 ) / sector_size;
+}
+
+void map_region_file::load_table()
+{
+    if( table_loaded ) {
+        return;
+    }
+    std::ifstream fin( path.get_unrelative_path(), std::ios::binary );
+    if( !fin ) {
+        table_loaded = true;
+        return;
+    }
+    std::array<char, region_magic.size()> magic;
+    fin.read( magic.data(), magic.size() );
+    if( !fin || magic != region_magic ) {
+        throw std::runtime_error( "not a map region file" );
+    }
+    std::string raw( table.size() * entry_size, '\0' );
+    fin.read( raw.data(), raw.size() );
+    if( !fin ) {
+        throw std::runtime_error( "map region table is truncated" );
+    }
+    for( size_t i = 0; i < table.size(); ++i ) {
+        table[i].sector = read_le32( raw.data() + i * entry_size );
+        table[i].length = read_le32( raw.data() + i * entry_size + 4 );
+    }
+    file_exists = true;
+    table_loaded = true;
+}
+
+uint32_t map_region_file::find_free_run( const size_t count ) const
+{
+    const size_t first = header_sectors();
+    size_t end = first;
+    for( const slot_entry &entry : table ) {
+        if( entry.length != 0 ) {
+            end = std::max( end, entry.sector + sectors_for( entry.length ) );
+        }
+    }
+    std::vector<bool> used( end, false );
+    for( const slot_entry &entry : table ) {
+        if( entry.length != 0 ) {
+            std::fill_n( used.begin() + entry.sector, sectors_for( entry.length ), true );
+        }
+    }
+    size_t run = 0;
+    for( size_t sector = first; sector < end; ++sector ) {
+        if( used[sector] ) {
+            run = 0;
+        } else if( ++run == count ) {
+            return static_cast<uint32_t>( sector + 1 - count );
+        }
+    }
+    // A free run at the end is simply extended past it.
+    return static_cast<uint32_t>( end - run );
+}
+
+std::fstream map_region_file::open_for_update() const
+{
+    std::fstream file( path.get_unrelative_path(),
+                       std::ios::binary | std::ios::in | std::ios::out );
+    if( !file ) {
+        throw std::runtime_error( "opening map region file failed" );
+    }
+    return file;
+}
+
+void map_region_file::write_entry( std::ostream &out, const size_t slot, const slot_entry &entry )
+{
+    std::array<char, entry_size> raw;
+    write_le32( raw.data(), entry.sector );
+    write_le32( raw.data() + 4, entry.length );
+    out.seekp( static_cast<std::streamoff>( region_magic.size() + slot * entry_size ) );
+    out.write( raw.data(), raw.size() );
+    out.flush();
+    if( !out ) {
+        throw std::runtime_error( "writing map region table failed" );
+    }
+    table[slot] = entry;
+}
+
+bool map_region_file::contains( const size_t slot )
+{
+    cata_assert( slot < table.size() );
+    std::lock_guard<std::mutex> lock( mutex );
+    load_table();
+    return table[slot].length != 0;
+}
+
+std::optional<std::string> map_region_file::read( const size_t slot )
+{
+    cata_assert( slot < table.size() );
+    std::lock_guard<std::mutex> lock( mutex );
+    load_table();
+    const slot_entry &entry = table[slot];
+    if( entry.length == 0 ) {
+        return std::nullopt;
+    }
+    if( !mapped ) {
+        mapped = mmap_file::map_file( path.get_unrelative_path() );
+        if( !mapped ) {
+            throw std::runtime_error( "mapping map region file failed" );
+        }
+    }
+    const size_t offset = static_cast<size_t>( entry.sector ) * sector_size;
+    if( offset + entry.length > mapped->len ) {
+        throw std::runtime_error( "map region entry extends past the end of the file" );
+    }
+    return std::string( reinterpret_cast<const char *>( mapped->base ) + offset, entry.length );
+}
+
+void map_region_file::write( const size_t slot, const std::string_view data )
+{
+    cata_assert( slot < table.size() );
+    cata_assert( !data.empty() );
+    std::lock_guard<std::mutex> lock( mutex );
+    load_table();
+    // Some platforms refuse to write to a file while it is mapped.
+    mapped.reset();
+
+    if( !file_exists ) {
+        std::ofstream fout( path.get_unrelative_path(), std::ios::binary );
+        const std::string header( header_sectors() * sector_size, '\0' );
+        fout.write( header.data(), header.size() );
+        fout.seekp( 0 );
+        fout.write( region_magic.data(), region_magic.size() );
+        fout.close();
+        if( !fout ) {
+            throw std::runtime_error( "creating map region file failed" );
+        }
+        file_exists = true;
+    }
+
+    const size_t count = sectors_for( data.size() );
+    const uint32_t sector = find_free_run( count );
+    std::fstream file = open_for_update();
+    file.seekp( static_cast<std::streamoff>( sector ) * sector_size );
+    file.write( data.data(), data.size() );
+    // Pad to whole sectors so the file always ends on a sector boundary.
+    const std::string padding( count * sector_size - data.size(), '\0' );
+    file.write( padding.data(), padding.size() );
+    file.flush();
+    if( !file ) {
+        throw std::runtime_error( "writing map region data failed" );
+    }
+    // Only now the new data becomes visible, the old sectors are free from here on.
+    write_entry( file, slot, { sector, static_cast<uint32_t>( data.size() ) } );
+}
+
+void map_region_file::erase( const size_t slot )
+{
+    cata_assert( slot < table.size() );
+    std::lock_guard<std::mutex> lock( mutex );
+    load_table();
+    if( table[slot].length == 0 ) {
+        return;
+    }
+    mapped.reset();
+    std::fstream file = open_for_update();
+    write_entry( file, slot, {} );
+}
@@ -0,0 +1,78 @@
+#pragma once
+#ifndef CATA_SRC_MAP_REGION_FILE_H
+#define CATA_SRC_MAP_REGION_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <iosfwd>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "cata_path.h"
+
+class mmap_file;
+
+/**
+ * The saved quads of one map segment packed into a single file, so an explored world
+ * doesn't consist of hundreds of thousands of tiny files.
+ *
+ * Layout: an 8 byte magic, a table with one {first sector, byte length} entry per quad and
+ * then the quad data, each quad in a run of whole @ref sector_size sectors.  A rewritten quad
+ * goes to the first free run that doesn't overlap its current data, and its table entry is
+ * updated only after the data is on disk, so an interrupted write leaves the previous
+ * version readable.  Sectors no longer referenced by the table are reused by later writes.
+ *
+ * Reading goes through a memory map of the whole file that is dropped on every write.
+ * All functions lock the instance, so save workers and the prefetch thread may share it.
+ * Functions throw std::runtime_error on io errors or a malformed file.
+ */
+class map_region_file
+{
+    public:
+        static constexpr size_t sector_size = 4096;
+
+        /** @param num_slots Number of quads in the region, fixed for the life of the file. */
+        map_region_file( const cata_path &path, size_t num_slots );
+        map_region_file( const map_region_file & ) = delete;
+        map_region_file &operator=( const map_region_file & ) = delete;
+        ~map_region_file();
+
+        /** Whether the file holds data for @p slot. */
+        bool contains( size_t slot );
+        /** The data stored for @p slot, nullopt if there is none. */
+        std::optional<std::string> read( size_t slot );
+        /** Store @p data for @p slot, creating the file if needed.  @p data must not be empty. */
+        void write( size_t slot, std::string_view data );
+        /** Forget the data of @p slot, its sectors are reused by later writes. */
+        void erase( size_t slot );
+
+    private:
+        struct slot_entry {
+            uint32_t sector = 0;
+            uint32_t length = 0;
+        };
+
+        size_t header_sectors() const;
+        static size_t sectors_for( size_t length );
+        /** Read the table from disk on first use. An absent file is an empty region. */
+        void load_table();
+        /** First sector of a run of @p count sectors that no table entry uses. */
+        uint32_t find_free_run( size_t count ) const;
+        /** Open the existing file for in-place writes. */
+        std::fstream open_for_update() const;
+        void write_entry( std::ostream &out, size_t slot, const slot_entry &entry );
+
+        cata_path path;
+        std::mutex mutex;
+        bool table_loaded = false;
+        bool file_exists = false;
+        std::vector<slot_entry> table;
+        std::shared_ptr<mmap_file> mapped;
+};
+
+#endif // CATA_SRC_MAP_REGION_FILE_H
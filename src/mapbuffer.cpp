@@ -1,29 +1,43 @@
 #include "mapbuffer.h"
 
+#include <algorithm>
+#include <array>
 #include <chrono>
 #include <exception>
 #include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <optional>
 #include <set>
 #include <sstream>
 #include <string>
+#include <string_view>
 #include <utility>
 #include <vector>
 
+#include "alloc_profiler.h"
 #include "cata_utility.h"
 #include "debug.h"
 #include "filesystem.h"
 #include "input.h"
 #include "json.h"
+#include "json_loader.h"
+#include "game_constants.h"
 #include "map.h"
+#include "map_region_file.h"
+#include "options.h"
 #include "output.h"
 #include "overmapbuffer.h"
 #include "path_info.h"
 #include "popup.h"
 #include "string_formatter.h"
 #include "submap.h"
+#include "submap_binary.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "ui_manager.h"
-#include <future>
 
 #define dbg(x) DebugLog((x),D_MAP) << __FILE__ << ":" << __LINE__ << ": "
 
@@ -33,11 +47,58 @@ extern std::unique_ptr<game> g;
 // NOLINTNEXTLINE(cata-static-declarations)
 extern const int savegame_version;
 
+// Quads are packed into one file per segment, see map_region_file.  Quads saved as single
+// files by older versions are still read and move into the region when they are saved again.
+static cata_path find_region_path( const cata_path &dirname )
+{
+    return dirname / "quads.region";
+}
+
+static size_t region_slot( const tripoint_abs_omt &om_addr )
+{
+    const point_abs_omt origin = project_to<coords::omt>( project_to<coords::seg>( om_addr.xy() ) );
+    const point rel = om_addr.xy().raw() - origin.raw();
+    return rel.y * SEG_SIZE + rel.x;
+}
+
 static cata_path find_quad_path( const cata_path &dirname, const tripoint_abs_omt &om_addr )
 {
     return dirname / string_format( "%d.%d.%d.map", om_addr.x(), om_addr.y(), om_addr.z() );
 }
 
+// The savefile of the quad, which may not exist yet.
+static cata_path find_saved_quad_path( const cata_path &dirname, const tripoint_abs_omt &om_addr )
+{
+    cata_path quad_path = find_quad_path( dirname, om_addr );
+    if( !file_exist( quad_path ) ) {
+        // Fix for old saves where the path was generated using std::stringstream, which
+        // did format the number using the current locale. That formatting may insert
+        // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
+        // of "map/1234.7.8.map".
+        std::ostringstream buffer;
+        buffer << om_addr.x() << "." << om_addr.y() << "." << om_addr.z()
+               << ".map";
+        cata_path legacy_quad_path = dirname / buffer.str();
+        if( file_exist( legacy_quad_path ) ) {
+            quad_path = std::move( legacy_quad_path );
+        }
+    }
+    return quad_path;
+}
+
+// Compressed quads are inflated in memory whatever their format, so they go the same way.
+static bool is_binary_or_compressed_quad_file( const cata_path &path )
+{
+    std::ifstream fin( path.get_unrelative_path(), std::ios::binary );
+    std::array<char, 8> header;
+    fin.read( header.data(), header.size() );
+    if( !fin ) {
+        return false;
+    }
+    const std::string_view header_view( header.data(), header.size() );
+    return is_gzip_data( header_view ) || submap_binary::is_binary_quad( header_view );
+}
+
 static cata_path find_dirname( const tripoint_abs_omt &om_addr )
 {
     const tripoint_abs_seg segment_addr = project_to<coords::seg>( om_addr );
@@ -46,6 +107,15 @@ static cata_path find_dirname( const tripoint_abs_omt &om_addr )
             segment_addr.y(), segment_addr.z() );
 }
 
+struct mapbuffer::prefetched_quad {
+    // Exactly one of these is set, depending on the file format.
+    std::string binary;
+    std::optional<JsonValue> json;
+};
+
+// Don't let prefetching outrun the consumer by too much.
+static constexpr size_t max_prefetched_quads = 512;
+
 mapbuffer MAPBUFFER;
 
 mapbuffer::mapbuffer() = default;
@@ -53,7 +123,135 @@ mapbuffer::~mapbuffer() = default;
 
 void mapbuffer::clear()
 {
+    discard_prefetched();
     submaps.clear();
+    // The next world may have other files at the same paths.
+    std::lock_guard<std::mutex> lock( regions_mutex );
+    regions.clear();
+}
+
+map_region_file &mapbuffer::region_file( const cata_path &dirname,
+        const tripoint_abs_omt &om_addr ) const
+{
+    std::lock_guard<std::mutex> lock( regions_mutex );
+    std::unique_ptr<map_region_file> &region = regions[project_to<coords::seg>( om_addr )];
+    if( !region ) {
+        region = std::make_unique<map_region_file>( find_region_path( dirname ),
+                 SEG_SIZE * SEG_SIZE );
+    }
+    return *region;
+}
+
+void mapbuffer::prefetch( const std::vector<tripoint_abs_omt> &quads )
+{
+    if( !prefetch_pool ) {
+        prefetch_pool = std::make_unique<thread_pool>( 1 );
+    }
+    for( const tripoint_abs_omt &om_addr : quads ) {
+        if( submaps.count( project_to<coords::sm>( om_addr ) ) ) {
+            continue;
+        }
+        {
+            std::lock_guard<std::mutex> lock( prefetch_mutex );
+            if( prefetched.size() >= max_prefetched_quads ) {
+                return;
+            }
+            if( !prefetched.emplace( om_addr, nullptr ).second ) {
+                continue;
+            }
+        }
+        const cata_path dirname = find_dirname( om_addr );
+        const cata_path quad_path = find_quad_path( dirname, om_addr );
+        map_region_file *region = &region_file( dirname, om_addr );
+        prefetch_pool->push( [this, om_addr, quad_path, region]() {
+            // Runs on the prefetch thread: only file access and parsing, no game state and
+            // no debugmsg.  Anything unusual falls back to the normal load path.
+            std::shared_ptr<prefetched_quad> result;
+            try {
+                std::optional<std::string> packed = region->read( region_slot( om_addr ) );
+                std::ifstream fin;
+                if( !packed ) {
+                    fin.open( quad_path.get_unrelative_path(), std::ios::binary );
+                }
+                if( packed || fin ) {
+                    std::string data;
+                    if( packed ) {
+                        data = std::move( *packed );
+                    } else {
+                        data.assign( std::istreambuf_iterator<char>( fin ),
+                                     std::istreambuf_iterator<char>() );
+                        if( fin.bad() ) {
+                            data.clear();
+                        }
+                    }
+                    if( is_gzip_data( data ) ) {
+                        data = gzip_decompress( data );
+                    }
+                    result = std::make_shared<prefetched_quad>();
+                    if( submap_binary::is_binary_quad( data ) ) {
+                        result->binary = std::move( data );
+                    } else if( !data.empty() && data[0] == '[' ) {
+                        result->json = json_loader::from_string( data );
+                    } else {
+                        // Unexpected, let the normal load path report it.
+                        result = nullptr;
+                    }
+                }
+            } catch( const std::exception & ) {
+                result = nullptr;
+            }
+            std::lock_guard<std::mutex> lock( prefetch_mutex );
+            const auto it = prefetched.find( om_addr );
+            if( it == prefetched.end() ) {
+                // Loaded by other means in the meantime.
+                return;
+            }
+            if( result ) {
+                it->second = std::move( result );
+            } else {
+                prefetched.erase( it );
+            }
+        } );
+    }
+}
+
+bool mapbuffer::has_quad( const tripoint_abs_omt &om_addr ) const
+{
+    if( submaps.count( project_to<coords::sm>( om_addr ) ) ) {
+        return true;
+    }
+    const cata_path dirname = find_dirname( om_addr );
+    try {
+        if( region_file( dirname, om_addr ).contains( region_slot( om_addr ) ) ) {
+            return true;
+        }
+    } catch( const std::exception & ) {
+        // Reported when the quad is actually loaded.
+    }
+    return file_exist( find_saved_quad_path( dirname, om_addr ) );
+}
+
+std::shared_ptr<mapbuffer::prefetched_quad> mapbuffer::take_prefetched(
+    const tripoint_abs_omt &om_addr )
+{
+    std::lock_guard<std::mutex> lock( prefetch_mutex );
+    const auto it = prefetched.find( om_addr );
+    if( it == prefetched.end() ) {
+        return nullptr;
+    }
+    // If it's still pending this drops the entry, the result is thrown away once read.
+    std::shared_ptr<prefetched_quad> result = std::move( it->second );
+    prefetched.erase( it );
+    return result;
+}
+
+void mapbuffer::discard_prefetched()
+{
+    if( prefetch_pool ) {
+        prefetch_pool->wait();
+    }
+    std::lock_guard<std::mutex> lock( prefetch_mutex );
+    prefetched.clear();
 }
 
 void mapbuffer::clear_outside_reality_bubble()
@@ -135,150 +333,188 @@ bool mapbuffer::submap_exists( const tripoint_abs_sm &p )
     return true;
 }
 
-void mapbuffer::save(bool delete_after_save)
+void mapbuffer::save( bool delete_after_save )
 {
-    assure_dir_exist(PATH_INFO::world_base_save_path() + "/maps");
-
-    int num_total_submaps = submaps.size();
+    assure_dir_exist( PATH_INFO::world_base_save_path() + "/maps" );
+    // Files are about to change under the staged data.
+    discard_prefetched();
 
-    map& here = get_map();
+    map &here = get_map();
 
     static_popup popup;
 
-    std::set<tripoint_abs_omt> saved_submaps;
+    std::set<tripoint_abs_omt> quads_to_save;
+    for( auto &elem : submaps ) {
+        quads_to_save.insert( project_to<coords::omt>( elem.first ) );
+    }
+    const int num_total_quads = quads_to_save.size();
+
     std::list<tripoint_abs_sm> submaps_to_delete;
-    static constexpr std::chrono::milliseconds update_interval(500);
+    std::mutex submaps_to_delete_mutex;
+    static constexpr std::chrono::milliseconds update_interval( 500 );
 
-    std::vector<std::future<void>> futures;
-    std::mutex submaps_mutex;
+    int num_threads = get_option<int>( "SAVE_THREADS" );
+    if( num_threads <= 0 ) {
+        num_threads = thread_pool::default_size();
+    }
+    // Keep a few quads queued per worker so nobody idles, but don't buffer the whole world.
+    thread_pool pool( num_threads, num_threads * 4 );
+    const bool binary = get_option<std::string>( "MAP_SAVE_FORMAT" ) == "binary";
+    const int compression_level = get_option<int>( "SAVE_COMPRESSION" );
 
-    for (auto& elem : submaps) {
-        const tripoint_abs_omt om_addr = project_to<coords::omt>(elem.first);
-        if (saved_submaps.count(om_addr) != 0) {
-            continue;
+    auto last_update = std::chrono::steady_clock::now();
+    const auto update_progress = [&]() {
+        if( std::chrono::steady_clock::now() - last_update > update_interval ) {
+            popup.message( _( "Please wait as the map saves [%d/%d]" ),
+                           pool.num_completed(), num_total_quads );
+            if( ui_manager::request_redraw() ) {
+                refresh_display();
+            }
+            inp_mngr.pump_events();
+            last_update = std::chrono::steady_clock::now();
         }
-        saved_submaps.insert(om_addr);
+    };
 
-        const cata_path dirname = find_dirname(om_addr);
-        const cata_path quad_path = find_quad_path(dirname, om_addr);
+    // The workers only read from `submaps`, removal happens once they are all done.
+    for( const tripoint_abs_omt &om_addr : quads_to_save ) {
+        const cata_path dirname = find_dirname( om_addr );
+        const cata_path quad_path = find_quad_path( dirname, om_addr );
 
-        bool inside_reality_bubble = here.inbounds(om_addr);
+        const bool delete_quad = delete_after_save || !here.inbounds( om_addr );
 
-        futures.push_back(std::async(std::launch::async, [this, dirname, quad_path, om_addr, &submaps_to_delete, delete_after_save, inside_reality_bubble, &submaps_mutex]() {
+        std::function<void()> task = [this, dirname, quad_path, om_addr, delete_quad, binary,
+                   compression_level, &submaps_to_delete, &submaps_to_delete_mutex]() {
             std::list<tripoint_abs_sm> local_submaps_to_delete;
-            save_quad(dirname, quad_path, om_addr, local_submaps_to_delete, delete_after_save || !inside_reality_bubble, submaps_mutex);
-
-            {
-                std::lock_guard<std::mutex> lock(submaps_mutex);
-                submaps_to_delete.splice(submaps_to_delete.end(), local_submaps_to_delete);
+            save_quad( dirname, quad_path, om_addr, local_submaps_to_delete, delete_quad, binary,
+                       compression_level );
+            if( !local_submaps_to_delete.empty() ) {
+                std::lock_guard<std::mutex> lock( submaps_to_delete_mutex );
+                submaps_to_delete.splice( submaps_to_delete.end(), local_submaps_to_delete );
             }
-            }));
+        };
+        while( !pool.push_for( task, update_interval ) ) {
+            update_progress();
+        }
+        update_progress();
     }
-    
-    int num_saved_submaps = 0;
-    auto last_update = std::chrono::steady_clock::now();
 
-    for (auto& fut : futures) {
-        if (std::chrono::steady_clock::now() - last_update > update_interval) {
-            popup.message(_("Please wait as the map saves [%d/%d]"),
-                num_saved_submaps, num_total_submaps);
-            ui_manager::redraw();
-            refresh_display();
-            inp_mngr.pump_events();
-            last_update = std::chrono::steady_clock::now();
-        }
-        num_saved_submaps++;
-        fut.get();
+    while( !pool.wait_for( update_interval ) ) {
+        update_progress();
     }
 
-    for (auto& elem : submaps_to_delete) {
-        remove_submap(elem);
+    for( auto &elem : submaps_to_delete ) {
+        remove_submap( elem );
     }
 }
 
-
 void mapbuffer::save_quad(
-    const cata_path dirname, const cata_path filename, const tripoint_abs_omt om_addr,
-    std::list<tripoint_abs_sm>& submaps_to_delete, bool delete_after_save, std::mutex& submaps_mutex)
+    const cata_path &dirname, const cata_path &filename, const tripoint_abs_omt &om_addr,
+    std::list<tripoint_abs_sm> &submaps_to_delete, bool delete_after_save, bool binary,
+    int compression_level ) const
 {
     static const std::vector<point> offsets = { point_zero, point_south, point_east, point_south_east };
-    
-    std::vector<tripoint_abs_sm> submap_addrs;
-    for (const auto& offset : offsets) {
-        submap_addrs.emplace_back(project_to<coords::sm>(om_addr) + offset);
+
+    std::vector<std::pair<tripoint_abs_sm, submap *>> quad_submaps;
+    for( const point &offset : offsets ) {
+        const tripoint_abs_sm submap_addr = project_to<coords::sm>( om_addr ) + offset;
+        const auto it = submaps.find( submap_addr );
+        if( it != submaps.end() && it->second != nullptr ) {
+            quad_submaps.emplace_back( submap_addr, it->second.get() );
+        }
     }
 
+    map_region_file &region = region_file( dirname, om_addr );
+    const size_t slot = region_slot( om_addr );
     bool all_uniform = true;
     bool reverted_to_uniform = false;
-    bool const file_exists = fs::exists(filename.get_unrelative_path());
-    for (const auto& submap_addr : submap_addrs) {
-        submap* sm = submaps[submap_addr].get();
-        if (sm != nullptr) {
-            if (!sm->is_uniform()) {
-                all_uniform = false;
-            }
-            else if (sm->reverted) {
-                reverted_to_uniform = file_exists;
-            }
+    bool const loose_file_exists = fs::exists( filename.get_unrelative_path() );
+    bool const file_exists = loose_file_exists || region.contains( slot );
+    for( const auto &elem : quad_submaps ) {
+        if( !elem.second->is_uniform() ) {
+            all_uniform = false;
+        } else if( elem.second->reverted ) {
+            reverted_to_uniform = file_exists;
         }
     }
 
-    if (all_uniform) {
-        if (delete_after_save) {
-            std::lock_guard<std::mutex> lock(submaps_mutex);
-            for (const auto& submap_addr : submap_addrs) {
-                if (submaps.count(submap_addr) > 0 && submaps[submap_addr] != nullptr) {
-                    submaps_to_delete.push_back(submap_addr);
-                }
+    if( all_uniform ) {
+        if( delete_after_save ) {
+            for( const auto &elem : quad_submaps ) {
+                submaps_to_delete.push_back( elem.first );
             }
         }
 
-        if (!reverted_to_uniform) {
-            return;
+        if( reverted_to_uniform ) {
+            // Uniform quads are generated from the overmap, saved data would get in the way.
+            region.erase( slot );
+            if( loose_file_exists ) {
+                fs::remove( filename.get_unrelative_path() );
+            }
         }
-    }
-
-    assure_dir_exist(dirname);
-    write_to_file(filename, [&](std::ostream& fout) {
-        JsonOut jsout(fout);
-        jsout.start_array();
-        for (auto& submap_addr : submap_addrs) {
-            if (submaps.count(submap_addr) == 0) {
-                continue;
+        return;
+    } else if( file_exists && std::none_of( quad_submaps.begin(), quad_submaps.end(),
+    []( const std::pair<tripoint_abs_sm, submap *> &elem ) {
+    return elem.second->needs_saving();
+    } ) ) {
+        // Nothing changed since this quad was last written or read, the file is up to date.
+        if( delete_after_save ) {
+            for( const auto &elem : quad_submaps ) {
+                submaps_to_delete.push_back( elem.first );
             }
+        }
+        return;
+    }
 
-            submap* sm = submaps[submap_addr].get();
-
-            if (sm == nullptr) {
-                continue;
+    assure_dir_exist( dirname );
+    std::string data;
+    if( binary ) {
+        data = submap_binary::write_quad( quad_submaps, savegame_version );
+        for( const auto &elem : quad_submaps ) {
+            elem.second->mark_saved();
+            if( delete_after_save ) {
+                submaps_to_delete.push_back( elem.first );
             }
+        }
+    } else {
+        std::ostringstream buffer;
+        JsonOut jsout( buffer );
+        jsout.start_array();
+        for( const auto &elem : quad_submaps ) {
+            const tripoint_abs_sm &submap_addr = elem.first;
 
             jsout.start_object();
 
-            jsout.member("version", savegame_version);
-            jsout.member("coordinates");
+            jsout.member( "version", savegame_version );
+            jsout.member( "coordinates" );
 
             jsout.start_array();
-            jsout.write(submap_addr.x());
-            jsout.write(submap_addr.y());
-            jsout.write(submap_addr.z());
+            jsout.write( submap_addr.x() );
+            jsout.write( submap_addr.y() );
+            jsout.write( submap_addr.z() );
             jsout.end_array();
 
-            sm->store(jsout);
+            elem.second->store( jsout );
 
             jsout.end_object();
 
-            if (delete_after_save) {
-                std::lock_guard<std::mutex> lock(submaps_mutex);
-                submaps_to_delete.push_back(submap_addr);
+            elem.second->mark_saved();
+
+            if( delete_after_save ) {
+                submaps_to_delete.push_back( submap_addr );
             }
         }
 
         jsout.end_array();
-        });
+        data = buffer.str();
+    }
 
-    if (all_uniform && reverted_to_uniform) {
-        fs::remove(filename.get_unrelative_path());
+    if( compression_level > 0 ) {
+        data = gzip_compress( data, compression_level );
+    }
+    region.write( slot, data );
+    if( loose_file_exists ) {
+        // Superseded by the region, which is read first anyway.
+        fs::remove( filename.get_unrelative_path() );
     }
 }
 
@@ -286,29 +522,61 @@ void mapbuffer::save_quad(
 // seeking around in them, so we're using the json streaming API.
 submap *mapbuffer::unserialize_submaps( const tripoint_abs_sm &p )
 {
+    const alloc_profiler::scoped_tag alloc_tag( alloc_profiler::tag::mapbuffer );
     // Map the tripoint to the submap quad that stores it.
     const tripoint_abs_omt om_addr = project_to<coords::omt>( p );
     const cata_path dirname = find_dirname( om_addr );
-    cata_path quad_path = find_quad_path( dirname, om_addr );
+    const cata_path quad_path = find_saved_quad_path( dirname, om_addr );
 
-    if( !file_exist( quad_path ) ) {
-        // Fix for old saves where the path was generated using std::stringstream, which
-        // did format the number using the current locale. That formatting may insert
-        // thousands separators, so the resulting path is "map/1,234.7.8.map" instead
-        // of "map/1234.7.8.map".
-        std::ostringstream buffer;
-        buffer << om_addr.x() << "." << om_addr.y() << "." << om_addr.z()
-               << ".map";
-        cata_path legacy_quad_path = dirname / buffer.str();
-        if( file_exist( legacy_quad_path ) ) {
-            quad_path = std::move( legacy_quad_path );
+    const std::shared_ptr<prefetched_quad> staged = take_prefetched( om_addr );
+    std::optional<std::string> packed;
+    if( !staged ) {
+        try {
+            packed = region_file( dirname, om_addr ).read( region_slot( om_addr ) );
+        } catch( const std::exception &err ) {
+            debugmsg( _( "Failed to read from \"%1$s\": %2$s" ),
+                      find_region_path( dirname ).generic_u8string(), err.what() );
         }
     }
-
-    if( !read_from_file_optional_json( quad_path, [this]( const JsonValue & jsin ) {
+    if( staged ) {
+        try {
+            if( staged->json ) {
+                deserialize( *staged->json );
+            } else {
+                submap_binary::read_quad( staged->binary, [this]( const tripoint_abs_sm & pos,
+                std::unique_ptr<submap> &sm, int version ) {
+                    add_loaded_submap( pos, sm, version );
+                } );
+            }
+        } catch( const std::exception &err ) {
+            debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), quad_path.generic_u8string(), err.what() );
+            return nullptr;
+        }
+    } else if( packed ) {
+        try {
+            load_quad_data( std::move( *packed ) );
+        } catch( const std::exception &err ) {
+            debugmsg( _( "Failed to read from \"%1$s\": %2$s" ),
+                      find_region_path( dirname ).generic_u8string(), err.what() );
+            return nullptr;
+        }
+    } else if( !file_exist( quad_path ) ) {
+        // If it doesn't exist, trigger generating it.
+        return nullptr;
+    } else if( is_binary_or_compressed_quad_file( quad_path ) ) {
+        std::optional<std::string> data = read_whole_file( quad_path );
+        if( !data ) {
+            return nullptr;
+        }
+        try {
+            load_quad_data( std::move( *data ) );
+        } catch( const std::exception &err ) {
+            debugmsg( _( "Failed to read from \"%1$s\": %2$s" ), quad_path.generic_u8string(), err.what() );
+            return nullptr;
+        }
+    } else if( !read_from_file_json( quad_path, [this]( const JsonValue & jsin ) {
     deserialize( jsin );
     } ) ) {
-        // If it doesn't exist, trigger generating it.
         return nullptr;
     }
     // fill in uniform submaps that were not serialized
@@ -322,6 +590,21 @@ submap *mapbuffer::unserialize_submaps( const tripoint_abs_sm &p )
     return submaps[ p ].get();
 }
 
+void mapbuffer::load_quad_data( std::string data )
+{
+    if( is_gzip_data( data ) ) {
+        data = gzip_decompress( data );
+    }
+    if( submap_binary::is_binary_quad( data ) ) {
+        submap_binary::read_quad( data, [this]( const tripoint_abs_sm & pos,
+        std::unique_ptr<submap> &sm, int version ) {
+            add_loaded_submap( pos, sm, version );
+        } );
+    } else {
+        deserialize( json_loader::from_string( data ) );
+    }
+}
+
 void mapbuffer::deserialize( const JsonArray &ja )
 {
     for( JsonObject submap_json : ja ) {
@@ -342,9 +625,21 @@ void mapbuffer::deserialize( const JsonArray &ja )
                 sm->load( submap_member, submap_member_name, version );
             }
         }
+        add_loaded_submap( submap_coordinates, sm, version );
+    }
+}
 
-        if( !add_submap( submap_coordinates, sm ) ) {
-            debugmsg( "submap %s was already loaded", submap_coordinates.to_string() );
-        }
+void mapbuffer::add_loaded_submap( const tripoint_abs_sm &p, std::unique_ptr<submap> &sm,
+                                   int version )
+{
+    // Files from older versions get rewritten in the current format on the next save.
+    if( version == savegame_version ) {
+        sm->mark_saved();
+    }
+    // Loading writes the tiles directly.
+    sm->count_contents();
+
+    if( !add_submap( p, sm ) ) {
+        debugmsg( "submap %s was already loaded", p.to_string() );
     }
 }
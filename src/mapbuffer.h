@@ -6,13 +6,18 @@
 #include <list>
 #include <map>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
 
 #include "coords_fwd.h"
 #include "point.h"
 
 class cata_path;
 class JsonArray;
+class map_region_file;
 class submap;
+class thread_pool;
 
 /**
  * Store, buffer, save and load the entire world map.
@@ -66,6 +71,20 @@ class mapbuffer
         // submap exists or not.
         bool submap_exists( const tripoint_abs_sm &p );
 
+        /**
+         * Read the savefiles of quads that will probably be needed soon on a background
+         * thread.  A later @ref lookup_submap of such a quad only has to turn the parsed
+         * data into submaps instead of hitting the disk.  Quads that are already loaded,
+         * staged or queued are skipped.
+         */
+        void prefetch( const std::vector<tripoint_abs_omt> &quads );
+
+        /**
+         * Whether the quad is loaded or has a savefile.  If not, the next @ref lookup_submap
+         * of it fails and the map generates it instead.
+         */
+        bool has_quad( const tripoint_abs_omt &om_addr ) const;
+
     private:
         using submap_map_t = std::map<tripoint_abs_sm, std::unique_ptr<submap>>;
 
@@ -82,9 +101,38 @@ class mapbuffer
         // if not handled carefully, this can erase in-use submaps and crash the game.
         void remove_submap( const tripoint_abs_sm &addr );
         submap *unserialize_submaps( const tripoint_abs_sm &p );
+        struct prefetched_quad;
+        /** Remove and return the staged data for a quad, nullptr if it isn't ready. */
+        std::shared_ptr<prefetched_quad> take_prefetched( const tripoint_abs_omt &om_addr );
+        /** Wait for pending reads and drop all staged data, it may be stale after a save. */
+        void discard_prefetched();
         void deserialize( const JsonArray &ja );
-        void save_quad(const cata_path dirname, const cata_path filename, const tripoint_abs_omt om_addr, std::list<tripoint_abs_sm>& submaps_to_delete, bool delete_after_save, std::mutex& submaps_mutex);
+        /** Load the submaps of a quad from its saved data in any of the supported formats. */
+        void load_quad_data( std::string data );
+        /**
+         * The region file of the segment holding @p om_addr, @p dirname is that segment's
+         * directory.  Safe to call from the save workers and the prefetch thread.
+         */
+        map_region_file &region_file( const cata_path &dirname,
+                                      const tripoint_abs_omt &om_addr ) const;
+        /** Write one overmap-terrain quad. Called concurrently from the save workers, so this
+         * must not modify @ref submaps; submaps to remove are collected in @p submaps_to_delete. */
+        void save_quad( const cata_path &dirname, const cata_path &filename,
+                        const tripoint_abs_omt &om_addr, std::list<tripoint_abs_sm> &submaps_to_delete,
+                        bool delete_after_save, bool binary, int compression_level ) const;
+        void add_loaded_submap( const tripoint_abs_sm &p, std::unique_ptr<submap> &sm, int version );
         submap_map_t submaps; // NOLINT(cata-serialize)
+
+        std::mutex prefetch_mutex; // NOLINT(cata-serialize)
+        // Guarded by prefetch_mutex.  A null entry is queued but not read yet.
+        std::map<tripoint_abs_omt, std::shared_ptr<prefetched_quad>>
+                prefetched; // NOLINT(cata-serialize)
+        mutable std::mutex regions_mutex; // NOLINT(cata-serialize)
+        // Guarded by regions_mutex, the files themselves lock on their own.
+        mutable std::map<tripoint_abs_seg, std::unique_ptr<map_region_file>>
+                regions; // NOLINT(cata-serialize)
+        // Declared last so the worker is joined before the members it uses go away.
+        std::unique_ptr<thread_pool> prefetch_pool; // NOLINT(cata-serialize)
 };
 
 extern mapbuffer MAPBUFFER;
@@ -737,6 +737,18 @@ class ter_furn_migrations
 
         /** Checks migrations */
         static void check();
+
+        /**
+         * Resolve a terrain id read from a save, applying migrations.
+         * @return The terrain to place, and the furniture the migration adds (null if none).
+         */
+        static std::pair<ter_id, furn_id> migrate( const ter_str_id &ter );
+        /**
+         * Resolve a furniture id read from a save, applying migrations.
+         * @return The terrain the migration replaces the existing one with (null if none),
+         * and the furniture to place.
+         */
+        static std::pair<ter_id, furn_id> migrate( const furn_str_id &furn );
 };
 
 class field_type_migrations
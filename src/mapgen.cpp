@@ -227,6 +227,11 @@ void map::generate( const tripoint_abs_omt &p, const time_point &when, bool save
     dbg( D_INFO ) << "map::generate( g[" << g.get() << "], p[" << p << "], "
                   "when[" << to_string( when ) << "] )";
 
+    // The same world and location always give the same map, whenever it is generated.
+    std::optional<cata_default_random_engine> rng_engine =
+        rng_stream_engine( g->get_seed(), rng_stream::mapgen, p.raw() );
+    const rng_stream_scope rng_scope( rng_engine );
+
     const tripoint_abs_sm p_sm_base = project_to<coords::sm>( p );
     std::vector<bool> generated;
     generated.resize( my_MAPSIZE * my_MAPSIZE * OVERMAP_LAYERS );
@@ -1341,6 +1346,10 @@ class mapgen_value
             virtual const std::string *get_name_if_parameter() const {
                 return nullptr;
             }
+            // Whether get can return different values for the same mapgendata
+            virtual bool is_random() const {
+                return false;
+            }
         };
 
         struct null_source : value_source {
@@ -1486,6 +1495,10 @@ class mapgen_value
                 return *list.pick();
             }
 
+            bool is_random() const override {
+                return true;
+            }
+
             void check( const std::string &context, const mapgen_parameters & ) const override {
                 for( const weighted_object<int, StringId> &wo : list ) {
                     if( !is_valid_helper( wo.obj ) ) {
@@ -1542,6 +1555,10 @@ class mapgen_value
                 return Id( it->second );
             }
 
+            bool is_random() const override {
+                return on->is_random();
+            }
+
             void check( const std::string &context, const mapgen_parameters &params
                       ) const override {
                 on->check( context, params );
@@ -1667,6 +1684,10 @@ class mapgen_value
             return source_->get_name_if_parameter();
         }
 
+        bool is_random() const {
+            return source_->is_random();
+        }
+
         void deserialize( const JsonValue &jsin ) {
             if( jsin.test_object() ) {
                 *this = mapgen_value( jsin.get_object() );
@@ -1853,6 +1874,15 @@ void mapgen_parameters::check_and_merge( const mapgen_parameters &other,
     }
 }
 
+void jmapgen_piece::apply_batch( const mapgendata &dat, const std::vector<tripoint_rel_ms> &points,
+                                 const tripoint_rel_ms &offset, const std::string &context ) const
+{
+    for( const tripoint_rel_ms &p : points ) {
+        const tripoint_rel_ms q = p + offset;
+        apply( dat, jmapgen_int( q.x() ), jmapgen_int( q.y() ), jmapgen_int( q.z() ), context );
+    }
+}
+
 ret_val<void> jmapgen_piece_with_has_vehicle_collision::has_vehicle_collision(
     const mapgendata &dat,
     const tripoint_rel_ms &p ) const
@@ -3011,6 +3041,24 @@ class jmapgen_furniture : public jmapgen_piece_with_has_vehicle_collision
             }
         }
 
+        void apply_batch( const mapgendata &dat, const std::vector<tripoint_rel_ms> &points,
+                          const tripoint_rel_ms &offset, const std::string &context ) const override {
+            if( id.is_random() ) {
+                jmapgen_piece::apply_batch( dat, points, offset, context );
+                return;
+            }
+            const furn_id chosen_id = id.get( dat );
+            if( chosen_id.id().is_null() ) {
+                return;
+            }
+            for( const tripoint_rel_ms &p : points ) {
+                const tripoint_rel_ms q = p + offset;
+                if( !dat.m.furn_set( tripoint_bub_ms( q.x(), q.y(), dat.zlevel() + q.z() ), chosen_id ) ) {
+                    debugmsg( "Problem setting furniture in %s", context );
+                }
+            }
+        }
+
         void check( const std::string &oter_name, const mapgen_parameters &parameters,
                     const jmapgen_int &/*x*/, const jmapgen_int &/*y*/, const jmapgen_int &/*z*/
                   ) const override {
@@ -3046,14 +3094,44 @@ class jmapgen_terrain : public jmapgen_piece_with_has_vehicle_collision
             if( chosen_id.id().is_null() ) {
                 return;
             }
-            tripoint_bub_ms p( x.get(), y.get(), dat.zlevel() + z.get() );
+            const apply_actions acts = get_actions( dat, context );
+            place( dat, tripoint_bub_ms( x.get(), y.get(), dat.zlevel() + z.get() ), chosen_id, acts,
+                   context );
+        }
 
-            const ter_id &terrain_here = dat.m.ter( p );
-            const ter_t &chosen_ter = *chosen_id;
-            const bool is_wall = chosen_ter.has_flag( ter_furn_flag::TFLAG_WALL );
-            const bool place_item = chosen_ter.has_flag( ter_furn_flag::TFLAG_PLACE_ITEM );
-            const bool is_boring_wall = is_wall && !place_item;
+        void apply_batch( const mapgendata &dat, const std::vector<tripoint_rel_ms> &points,
+                          const tripoint_rel_ms &offset, const std::string &context ) const override {
+            if( id.is_random() ) {
+                jmapgen_piece::apply_batch( dat, points, offset, context );
+                return;
+            }
+            const ter_id chosen_id = id.get( dat );
+            if( chosen_id.id().is_null() ) {
+                return;
+            }
+            const apply_actions acts = get_actions( dat, context );
+            for( const tripoint_rel_ms &p : points ) {
+                const tripoint_rel_ms q = p + offset;
+                place( dat, tripoint_bub_ms( q.x(), q.y(), dat.zlevel() + q.z() ), chosen_id, acts,
+                       context );
+            }
+        }
+
+        void check( const std::string &oter_name, const mapgen_parameters &parameters,
+                    const jmapgen_int &/*x*/, const jmapgen_int &/*y*/, const jmapgen_int &/*z*/
+                  ) const override {
+            id.check( oter_name, parameters );
+        }
+
+    private:
+        struct apply_actions {
+            apply_action furn = apply_action::act_unknown;
+            apply_action trap = apply_action::act_unknown;
+            apply_action item = apply_action::act_unknown;
+        };
 
+        // What to do with what is already on the tile; depends only on the mapgen flags
+        static apply_actions get_actions( const mapgendata &dat, const std::string &context ) {
             apply_action act_furn = apply_action::act_unknown;
             apply_action act_trap = apply_action::act_unknown;
             apply_action act_item = apply_action::act_unknown;
@@ -3101,6 +3179,20 @@ class jmapgen_terrain : public jmapgen_piece_with_has_vehicle_collision
                           "mistake, as any dismantle outputs will not be preserved.",
                           context, dat.terrain_type().id().str() );
             }
+            return { act_furn, act_trap, act_item };
+        }
+
+        static void place( const mapgendata &dat, const tripoint_bub_ms &p, const ter_id &chosen_id,
+                           const apply_actions &acts, const std::string &context ) {
+            const apply_action act_furn = acts.furn;
+            const apply_action act_trap = acts.trap;
+            const apply_action act_item = acts.item;
+
+            const ter_id &terrain_here = dat.m.ter( p );
+            const ter_t &chosen_ter = *chosen_id;
+            const bool is_wall = chosen_ter.has_flag( ter_furn_flag::TFLAG_WALL );
+            const bool place_item = chosen_ter.has_flag( ter_furn_flag::TFLAG_PLACE_ITEM );
+            const bool is_boring_wall = is_wall && !place_item;
 
             if( is_boring_wall || act_furn == apply_action::act_erase ) {
                 dat.m.furn_clear( p );
@@ -3178,12 +3270,6 @@ class jmapgen_terrain : public jmapgen_piece_with_has_vehicle_collision
             }
             dat.m.ter_set( p, chosen_id );
         }
-
-        void check( const std::string &oter_name, const mapgen_parameters &parameters,
-                    const jmapgen_int &/*x*/, const jmapgen_int &/*y*/, const jmapgen_int &/*z*/
-                  ) const override {
-            id.check( oter_name, parameters );
-        }
 };
 /**
  * Run a transformation.
@@ -4889,10 +4975,38 @@ std::unordered_set<point> nested_mapgen::all_placement_coords() const
     return result;
 }
 
+static bool is_fixed_tile( const jmapgen_int &i )
+{
+    return i.val == i.valmax;
+}
+
 void jmapgen_objects::finalize()
 {
     std::stable_sort( objects.begin(), objects.end(), compare_phases );
     objects.shrink_to_fit();
+
+    // Merge runs of the same piece on single fixed tiles.  Keeping them in order leaves
+    // the result of every placement exactly as it was.
+    runs.clear();
+    for( size_t i = 0; i < objects.size(); ++i ) {
+        const jmapgen_place &where = objects[i].first;
+        const jmapgen_piece &what = *objects[i].second;
+        const bool fixed = is_fixed_tile( where.x ) && is_fixed_tile( where.y ) &&
+                           is_fixed_tile( where.z ) && where.repeat.val == 1 &&
+                           where.repeat.valmax == 1 && what.repeat.val == 1 && what.repeat.valmax == 1;
+        if( !fixed ) {
+            runs.push_back( { i, {} } );
+            continue;
+        }
+        const tripoint_rel_ms p( where.x.val, where.y.val, where.z.val );
+        if( !runs.empty() && !runs.back().points.empty() &&
+            objects[runs.back().first].second == objects[i].second ) {
+            runs.back().points.push_back( p );
+        } else {
+            runs.push_back( { i, { p } } );
+        }
+    }
+    runs.shrink_to_fit();
 }
 
 void jmapgen_objects::check( const std::string &context, const mapgen_parameters &parameters ) const
@@ -5446,11 +5560,15 @@ void jmapgen_objects::apply( const mapgendata &dat, mapgen_phase phase,
     bool terrain_resolved = false;
 
     auto range_at_phase = std::equal_range( objects.begin(), objects.end(), phase, compare_phases );
-
-    for( auto it = range_at_phase.first; it != range_at_phase.second; ++it ) {
-        const jmapgen_obj &obj = *it;
-        jmapgen_place where = obj.first;
-        where.offset( tripoint_rel_ms( -offset.raw() ) );
+    const size_t phase_begin = range_at_phase.first - objects.begin();
+    const size_t phase_end = range_at_phase.second - objects.begin();
+    auto run_it = std::lower_bound( runs.begin(), runs.end(), phase_begin,
+    []( const placement_run & run, size_t index ) {
+        return run.first < index;
+    } );
+
+    for( ; run_it != runs.end() && run_it->first < phase_end; ++run_it ) {
+        const jmapgen_obj &obj = objects[run_it->first];
         const jmapgen_piece &what = *obj.second;
 
         cata_assert( what.phase() == phase );
@@ -5464,6 +5582,14 @@ void jmapgen_objects::apply( const mapgendata &dat, mapgen_phase phase,
             terrain_resolved = true;
         }
 
+        if( run_it->points.size() > 1 ) {
+            what.apply_batch( dat, run_it->points, offset, context );
+            continue;
+        }
+
+        jmapgen_place where = obj.first;
+        where.offset( tripoint_rel_ms( -offset.raw() ) );
+
         // The user will only specify repeat once in JSON, but it may get loaded both
         // into the what and where in some cases--we just need the greater value of the two.
         const int repeat = std::max( where.repeat.get(), what.repeat.get() );
@@ -6877,6 +7003,7 @@ void map::add_spawn(
     if( MonsterGroupManager::monster_is_blacklisted( type ) ) {
         return;
     }
+    place_on_submap->mark_modified();
     place_on_submap->spawns.emplace_back( type, count, offset, faction_id, mission_id, friendly, name,
                                           data );
 }
@@ -6934,7 +7061,6 @@ vehicle *map::add_vehicle( const vproto_id &type, const tripoint_bub_ms &p, cons
         ch.vehicle_list.insert( placed_vehicle );
         add_vehicle_to_cache( placed_vehicle );
 
-        rebuild_vehicle_level_caches();
         set_pathfinding_cache_dirty( p.z() );
         placed_vehicle->place_zones( *this );
     }
@@ -7071,6 +7197,8 @@ std::unique_ptr<vehicle> map::add_vehicle_to_map(
             if( did_merge ) {
                 // TODO: more targeted damage around the impact site
                 first_veh->smash( *this );
+                // It took over parts of the new vehicle.
+                add_vehicle_to_cache( first_veh );
                 // TODO: entangle the old vehicle and the new vehicle somehow, perhaps with tow cables
                 // or something like them, to make them harder to separate
                 std::unique_ptr<vehicle> new_veh = add_vehicle_to_map( std::move( veh_to_add ), true );
@@ -242,6 +242,12 @@ class jmapgen_piece
         virtual void apply( const mapgendata &dat, const jmapgen_int &x, const jmapgen_int &y,
                             const jmapgen_int &z,
                             const std::string &context ) const = 0;
+        /**
+         * Place something at each of the fixed points (moved by offset), in order.  Pieces that
+         * would pick the same thing for every point override this to pick it only once.
+         */
+        virtual void apply_batch( const mapgendata &dat, const std::vector<tripoint_rel_ms> &points,
+                                  const tripoint_rel_ms &offset, const std::string &context ) const;
         virtual ~jmapgen_piece() = default;
         jmapgen_int repeat;
         virtual ret_val<void> has_vehicle_collision( const mapgendata &,
@@ -443,6 +449,17 @@ struct jmapgen_objects {
          */
         using jmapgen_obj = std::pair<jmapgen_place, shared_ptr_fast<const jmapgen_piece> >;
         std::vector<jmapgen_obj> objects;
+        /**
+         * Consecutive placements of one piece on single fixed tiles, as the "rows" produce
+         * them.  Built by @ref finalize, so that @ref apply hands each run to the piece at once.
+         */
+        struct placement_run {
+            // Index in objects of the first placement of the run
+            size_t first;
+            // The tiles of the run; empty if it is a lone placement that may not be fixed
+            std::vector<tripoint_rel_ms> points;
+        };
+        std::vector<placement_run> runs;
         tripoint_rel_ms m_offset;
         point mapgensize;
         point total_size;
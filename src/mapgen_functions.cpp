@@ -1123,14 +1123,14 @@ void mapgen_forest( mapgendata &dat )
     */
     const auto set_terrain_dependent_furniture =
     [&self_biome, &m]( const ter_id & tid, const point & p ) {
-        const auto terrain_dependent_furniture_it = self_biome.terrain_dependent_furniture.find(
-                    tid );
-        if( terrain_dependent_furniture_it == self_biome.terrain_dependent_furniture.end() ) {
+        const forest_biome_terrain_dependent_furniture *tdf_ptr =
+            self_biome.terrain_dependent_furniture.find( tid );
+        if( tdf_ptr == nullptr ) {
             // No terrain dependent furnitures for this terrain.
             return;
         }
 
-        const forest_biome_terrain_dependent_furniture tdf = terrain_dependent_furniture_it->second;
+        const forest_biome_terrain_dependent_furniture &tdf = *tdf_ptr;
         if( tdf.furniture.get_weight() <= 0 ) {
             // We've got furnitures, but their weight is 0 or less.
             return;
@@ -6,6 +6,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
 
 #include "bodypart.h"
@@ -60,6 +61,9 @@ generic_factory<ma_technique> ma_techniques( "martial art technique" );
 generic_factory<martialart> martialarts( "martial art style" );
 generic_factory<ma_buff> ma_buffs( "martial art buff" );
 generic_factory<attack_vector> attack_vector_factory( "attack vector" );
+// The buff behind each effect type registered by finalize_martial_arts, so looking through the
+// effects of a character doesn't rebuild a buff id from the name of every buff effect.
+std::unordered_map<efftype_id, const ma_buff *> buffs_by_effect;
 } // namespace
 
 /** @relates string_id */
@@ -609,11 +613,13 @@ void finalize_martial_arts()
 {
     // This adds an effect type for each ma_buff, so we can later refer to it and don't need a
     // redundant definition of those effects in json.
+    buffs_by_effect.clear();
     for( const ma_buff &buff : ma_buffs.get_all() ) {
         const ma_buff_effect_type new_eff( buff );
         // Note the slicing here: new_eff is converted to a plain effect_type, but this doesn't
         // bother us because ma_buff_effect_type does not have any members that can be sliced.
         effect_type::register_ma_buff_effect( new_eff );
+        buffs_by_effect.emplace( buff.get_effect_id(), &buff );
     }
     attack_vector_factory.finalize();
     for( const attack_vector &vector : attack_vector_factory.get_all() ) {
@@ -665,6 +671,7 @@ void clear_techniques_and_martial_arts()
 {
     martialarts.reset();
     ma_buffs.reset();
+    buffs_by_effect.clear();
     ma_techniques.reset();
 }
 
@@ -953,6 +960,10 @@ const ma_buff *ma_buff::from_effect( const effect &eff )
     if( id.compare( 0, 7, "mabuff:" ) != 0 ) {
         return nullptr;
     }
+    const auto found = buffs_by_effect.find( eff.get_id() );
+    if( found != buffs_by_effect.end() ) {
+        return found->second;
+    }
     return &mabuff_id( id.substr( 7 ) ).obj();
 }
 
@@ -1,6 +1,7 @@
 #include "math_parser.h"
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <locale>
 #include <map>
@@ -266,11 +267,206 @@ double ternary::eval( const_dialogue const &d ) const
     return cond->eval( d ) > 0 ? mhs->eval( d ) : rhs->eval( d );
 }
 
+namespace
+{
+
+// Value of @p t if it doesn't depend on the dialogue.  Functions aren't folded, some are random.
+std::optional<double> constant_of( thingie const &t )
+{
+    if( std::holds_alternative<double>( t.data ) ) {
+        return std::get<double>( t.data );
+    }
+    if( std::holds_alternative<oper>( t.data ) ) {
+        oper const &o = std::get<oper>( t.data );
+        std::optional<double> const l = constant_of( *o.l );
+        std::optional<double> const r = l ? constant_of( *o.r ) : std::nullopt;
+        if( r ) {
+            return ( *o.op )( *l, *r );
+        }
+        return std::nullopt;
+    }
+    if( std::holds_alternative<ternary>( t.data ) ) {
+        ternary const &tern = std::get<ternary>( t.data );
+        if( std::optional<double> const cond = constant_of( *tern.cond ); cond ) {
+            return constant_of( *cond > 0 ? *tern.mhs : *tern.rhs );
+        }
+    }
+    return std::nullopt;
+}
+
+struct program_builder {
+    math_program &prog;
+
+    math_instr &push( math_instr::opcode code, size_t depth ) {
+        prog.max_depth = std::max( prog.max_depth, depth + 1 );
+        math_instr &instr = prog.code.emplace_back();
+        instr.code = code;
+        return instr;
+    }
+
+    // Emits the instructions that leave the value of @p t on top of a stack @p depth deep.
+    bool emit( thingie const &t, size_t depth ) {
+        if( std::optional<double> const val = constant_of( t ); val ) {
+            push( math_instr::opcode::constant, depth ).value = *val;
+            return true;
+        }
+        return std::visit( overloaded{
+            [&]( oper const & v )
+            {
+                if( !emit( *v.l, depth ) || !emit( *v.r, depth + 1 ) ) {
+                    return false;
+                }
+                push( math_instr::opcode::binary, depth ).op = v.op;
+                return true;
+            },
+            [&]( func const & v )
+            {
+                if( !emit_params( v.params, depth ) ) {
+                    return false;
+                }
+                math_instr &instr = push( math_instr::opcode::func, depth );
+                instr.f = v.f;
+                instr.nparams = static_cast<int>( v.params.size() );
+                return true;
+            },
+            [&]( func_jmath const & v )
+            {
+                if( !emit_params( v.params, depth ) ) {
+                    return false;
+                }
+                math_instr &instr = push( math_instr::opcode::func_jmath, depth );
+                instr.arg = static_cast<int>( prog.jmaths.size() );
+                instr.nparams = static_cast<int>( v.params.size() );
+                prog.jmaths.push_back( v.id );
+                return true;
+            },
+            [&]( func_diag_eval const & v )
+            {
+                math_instr &instr = push( math_instr::opcode::diag_eval, depth );
+                instr.arg = static_cast<int>( prog.diag_evals.size() );
+                prog.diag_evals.push_back( v );
+                return true;
+            },
+            [&]( var const & v )
+            {
+                math_instr &instr = push( math_instr::opcode::var, depth );
+                instr.arg = static_cast<int>( prog.vars.size() );
+                prog.vars.push_back( v );
+                return true;
+            },
+            [&]( ternary const & v )
+            {
+                if( !emit( *v.cond, depth ) ) {
+                    return false;
+                }
+                size_t const to_rhs = prog.code.size();
+                push( math_instr::opcode::jump_unless, depth );
+                if( !emit( *v.mhs, depth ) ) {
+                    return false;
+                }
+                size_t const to_end = prog.code.size();
+                push( math_instr::opcode::jump, depth );
+                prog.code[to_rhs].arg = static_cast<int>( prog.code.size() );
+                if( !emit( *v.rhs, depth ) ) {
+                    return false;
+                }
+                prog.code[to_end].arg = static_cast<int>( prog.code.size() );
+                return true;
+            },
+            // Strings, kwargs, arrays and assignments are left to the tree and its errors.
+            []( auto const &/* v */ )
+            {
+                return false;
+            },
+        },
+        t.data );
+    }
+
+    bool emit_params( std::vector<thingie> const &params, size_t depth ) {
+        for( size_t i = 0; i < params.size(); i++ ) {
+            if( !emit( params[i], depth + i ) ) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+} // namespace
+
+bool math_program::compile( thingie const &tree )
+{
+    *this = math_program();
+    if( !program_builder{ *this }.emit( tree, 0 ) ) {
+        *this = math_program();
+        return false;
+    }
+    return true;
+}
+
+double math_program::eval( const_dialogue const &d ) const
+{
+    constexpr size_t small_stack = 16;
+    std::array<double, small_stack> small{};
+    std::vector<double> large;
+    double *stack = small.data();
+    if( max_depth > small_stack ) {
+        large.resize( max_depth );
+        stack = large.data();
+    }
+    size_t top = 0;
+    const auto pop_params = [&]( math_instr const & instr ) {
+        top -= instr.nparams;
+        return std::vector<double>( stack + top, stack + top + instr.nparams );
+    };
+    for( size_t pc = 0; pc < code.size(); ) {
+        math_instr const &instr = code[pc++];
+        switch( instr.code ) {
+            case math_instr::opcode::constant:
+                stack[top++] = instr.value;
+                break;
+            case math_instr::opcode::binary:
+                top--;
+                stack[top - 1] = ( *instr.op )( stack[top - 1], stack[top] );
+                break;
+            case math_instr::opcode::func: {
+                std::vector<double> const params = pop_params( instr );
+                stack[top++] = instr.f( params );
+                break;
+            }
+            case math_instr::opcode::func_jmath: {
+                std::vector<double> const params = pop_params( instr );
+                stack[top++] = jmaths[instr.arg]->eval( d, params );
+                break;
+            }
+            case math_instr::opcode::diag_eval:
+                stack[top++] = diag_evals[instr.arg].eval( d );
+                break;
+            case math_instr::opcode::var:
+                stack[top++] = vars[instr.arg].eval( d );
+                break;
+            case math_instr::opcode::jump_unless:
+                top--;
+                if( !( stack[top] > 0 ) ) {
+                    pc = instr.arg;
+                }
+                break;
+            case math_instr::opcode::jump:
+                pc = instr.arg;
+                break;
+        }
+    }
+    cata_assert( top == 1 );
+    return stack[0];
+}
+
 class math_exp::math_exp_impl
 {
     public:
         math_exp_impl() = default;
-        explicit math_exp_impl( thingie &&t ): tree( t ) {}
+        explicit math_exp_impl( thingie &&t ): tree( t ) {
+            program.compile( tree );
+        }
 
         bool parse( std::string_view str, bool assignment, bool handle_errors ) {
             if( str.empty() ) {
@@ -289,15 +485,20 @@ class math_exp::math_exp_impl
                     output = {};
                     arity = {};
                     tree = thingie { 0.0 };
+                    program.compile( tree );
                     return false;
                 }
 
                 throw std::invalid_argument( error( str, ex.what() ) );
             }
+            program.compile( tree );
             return true;
         }
         double eval( const_dialogue const &d ) const {
-            return tree.eval( d );
+            if( program.code.empty() ) {
+                return tree.eval( d );
+            }
+            return program.eval( d );
         }
 
         void assign( dialogue &d, double val ) const {
@@ -341,6 +542,7 @@ class math_exp::math_exp_impl
         };
         std::stack<arity_t> arity;
         thingie tree{ 0.0 };
+        math_program program;
         std::string_view last_token;
         parse_state state;
 
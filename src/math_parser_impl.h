@@ -4,6 +4,7 @@
 
 #include <array>
 #include <cmath>
+#include <cstddef>
 #include <string>
 #include <string_view>
 #include <variant>
@@ -180,6 +181,43 @@ constexpr double thingie::eval( const_dialogue const &d ) const
     data );
 }
 
+struct math_instr {
+    enum class opcode : int {
+        constant = 0,
+        binary,
+        func,
+        func_jmath,
+        diag_eval,
+        var,
+        jump_unless,
+        jump,
+    };
+    opcode code = opcode::constant;
+    // Index into the tables of math_program, or the target of a jump.
+    int arg = 0;
+    int nparams = 0;
+    double value = 0;
+    binary_op::f_t op = nullptr;
+    math_func::f_t f = nullptr;
+};
+
+/**
+ * A @ref thingie tree lowered to the instructions of a stack machine.  Constant subexpressions
+ * are folded and the variables and dialogue functions are bound to slots of the program, so
+ * evaluating it doesn't visit variants or follow pointers through the tree.
+ */
+struct math_program {
+    std::vector<math_instr> code;
+    std::vector<var> vars;
+    std::vector<func_diag_eval> diag_evals;
+    std::vector<jmath_func_id> jmaths;
+    size_t max_depth = 0;
+
+    /** Lowers @p tree, returns false (and stays empty) if only the tree can evaluate it. */
+    bool compile( thingie const &tree );
+    double eval( const_dialogue const &d ) const;
+};
+
 using op_t =
     std::variant<pbin_op, punary_op, pmath_func, jmath_func_id, scoped_diag_eval, scoped_diag_ass, paren>;
 
@@ -1248,8 +1248,9 @@ static void roll_melee_damage_internal( const Character &u, const damage_type_id
                                         damage_instance &di, bool average, const item &weap,
                                         const attack_vector_id &attack_vector, const sub_bodypart_str_id &contact, float crit_mod )
 {
+    const float buff_damage = u.mabuff_damage_bonus( dt );
     // FIXME: Hardcoded damage type
-    float dmg = dt == damage_bash ? 0.f : u.mabuff_damage_bonus( dt ) + weap.damage_melee( dt );
+    float dmg = dt == damage_bash ? 0.f : buff_damage + weap.damage_melee( dt );
     bool unarmed = !attack_vector->weapon;
     int arpen = 0;
 
@@ -1271,7 +1272,7 @@ static void roll_melee_damage_internal( const Character &u, const damage_type_id
     }
     /** @ARM_STR increases bashing damage */
     float stat_bonus = u.bonus_damage( !average );
-    stat_bonus += u.mabuff_damage_bonus( dt );
+    stat_bonus += buff_damage;
     /** @EFFECT_STR increases bashing damage */
     float weap_dam = weap.damage_melee( dt ) + stat_bonus;
     /** @EFFECT_BASHING caps bash damage with bashing weapons */
@@ -422,6 +422,53 @@ void memorial_logger::write_json_memorial( std::ostream &memorial_file ) const
     clear_past_games();
 }
 
+bool memorial_logger::wants( const event_type type ) const
+{
+    switch( type ) {
+        case event_type::avatar_enters_omt:
+        case event_type::avatar_moves:
+        case event_type::camp_taken_over:
+        case event_type::character_consumes_item:
+        case event_type::character_dies:
+        case event_type::character_eats_item:
+        case event_type::character_finished_activity:
+        case event_type::character_gets_headshot:
+        case event_type::character_heals_damage:
+        case event_type::character_melee_attacks_character:
+        case event_type::character_melee_attacks_monster:
+        case event_type::character_ranged_attacks_character:
+        case event_type::character_ranged_attacks_monster:
+        case event_type::character_smashes_tile:
+        case event_type::character_starts_activity:
+        case event_type::character_takes_damage:
+        case event_type::monster_takes_damage:
+        case event_type::character_wakes_up:
+        case event_type::character_attempt_to_fall_asleep:
+        case event_type::character_falls_asleep:
+        case event_type::character_radioactively_mutates:
+        case event_type::character_wears_item:
+        case event_type::character_wields_item:
+        case event_type::character_armor_destroyed:
+        case event_type::character_casts_spell:
+        case event_type::cuts_tree:
+        case event_type::opens_spellbook:
+        case event_type::reads_book:
+        case event_type::spellcasting_finish:
+        case event_type::game_load:
+        case event_type::game_over:
+        case event_type::game_save:
+        case event_type::game_start:
+        case event_type::game_begin:
+        case event_type::u_var_changed:
+        case event_type::vehicle_moves:
+        case event_type::character_butchered_corpse:
+        case event_type::num_event_types:
+            return false;
+        default:
+            return true;
+    }
+}
+
 void memorial_logger::notify( const cata::event &e )
 {
     Character &player_character = get_player_character();
@@ -1111,7 +1158,7 @@ void memorial_logger::notify( const cata::event &e )
                  io::enum_to_string( e.get<debug_menu::debug_menu_index>( "debug_menu_option" ) ) );
             break;
         }
-        // All the events for which we have no memorial log are here
+        // All the events for which we have no memorial log are here, keep in sync with wants
         case event_type::avatar_enters_omt:
         case event_type::avatar_moves:
         case event_type::camp_taken_over:
@@ -4,7 +4,19 @@
 
 #include <memory>
 
-#if __GLIBCXX__
+/**
+ * Shared pointers for objects that are shared on the main thread only.  With libstdc++ their
+ * reference counts are not atomic, which saves a locked instruction on every copy, but copying
+ * or dropping one on a worker thread races with the main thread.
+ *
+ * Code that runs on worker threads (see parallel_for) borrows such objects through plain
+ * pointers and references, as creature_tracker::creature_at and map_memory::get_submap hand
+ * them out, and leaves copying the shared pointers to the main thread.  In debug builds the
+ * functions that return copies assert that they are not called from a thread_pool worker.
+ * Building with CATA_ATOMIC_SHARED_PTR_FAST defined makes the counts atomic instead.
+ */
+#if __GLIBCXX__ && !defined(CATA_ATOMIC_SHARED_PTR_FAST)
+#define CATA_SHARED_PTR_FAST_IS_ATOMIC 0
 template<typename T> using shared_ptr_fast = std::__shared_ptr<T, __gnu_cxx::_S_single>;
 template<typename T> using weak_ptr_fast = std::__weak_ptr<T, __gnu_cxx::_S_single>;
 template<typename T, typename... Args> shared_ptr_fast<T> make_shared_fast(
@@ -13,6 +25,7 @@ template<typename T, typename... Args> shared_ptr_fast<T> make_shared_fast(
     return std::__make_shared<T, __gnu_cxx::_S_single>( args... );
 }
 #else
+#define CATA_SHARED_PTR_FAST_IS_ATOMIC 1
 template<typename T> using shared_ptr_fast = std::shared_ptr<T>;
 template<typename T> using weak_ptr_fast = std::weak_ptr<T>;
 template<typename T, typename... Args> shared_ptr_fast<T> make_shared_fast(
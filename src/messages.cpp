@@ -27,11 +27,14 @@
 #include <iterator>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "options.h"
 
 static const efftype_id effect_weed_high( "weed_high" );
 
+static const option_ref<int> option_message_limit( "MESSAGE_LIMIT" );
+
 namespace
 {
 
@@ -46,6 +49,13 @@ struct game_message {
     bool cooldown_hidden = false; // NOLINT(cata-serialize)
     game_message_type type = m_neutral;
 
+    // Lines of the last folding of the message, see folded_lines
+    mutable std::vector<std::string> folded; // NOLINT(cata-serialize)
+    mutable int folded_width = -1; // NOLINT(cata-serialize)
+    mutable int folded_count = 0; // NOLINT(cata-serialize)
+    mutable bool folded_colored = false; // NOLINT(cata-serialize)
+    mutable int folded_language = INVALID_LANGUAGE_VERSION; // NOLINT(cata-serialize)
+
     game_message() = default;
     game_message( std::string &&msg, game_message_type const t ) :
         message( std::move( msg ) ),
@@ -66,6 +76,25 @@ struct game_message {
         return string_format( _( "%s x %d" ), message, count );
     }
 
+    /**
+     * The message with its count folded to @p width, without color tags unless @p colored.
+     * The panel redraws the same messages over and over, so the last folding is kept until
+     * the width, count, coloring or language changes.
+     */
+    const std::vector<std::string> &folded_lines( const int width, const bool colored ) const {
+        const int language = detail::get_current_language_version();
+        if( width != folded_width || count != folded_count || colored != folded_colored ||
+            language != folded_language ) {
+            folded = foldstring( colored ? get_with_count() : remove_color_tags( get_with_count() ),
+                                 width );
+            folded_width = width;
+            folded_count = count;
+            folded_colored = colored;
+            folded_language = language;
+        }
+        return folded;
+    }
+
     /** Get whether or not a message should not be displayed (hidden) in the side bar because it's in a cooldown period.
      * @returns `true` if the message should **not** be displayed, `false` otherwise.
      */
@@ -190,7 +219,7 @@ class messages_impl
                 return;
             }
 
-            unsigned int message_limit = get_option<int>( "MESSAGE_LIMIT" );
+            const size_t message_limit = option_message_limit.get();
             while( messages.size() > message_limit ) {
                 messages.pop_front();
             }
@@ -648,8 +677,7 @@ void Messages::dialog::init( ui_adaptor &ui )
     for( size_t ind = 0; ind < msg_count; ++ind ) {
         const size_t msg_ind = log_from_top ? ind : msg_count - 1 - ind;
         const game_message &msg = player_messages.history( msg_ind );
-        const auto &folded = foldstring( msg.get_with_count(), msg_width );
-        for( const auto &it : folded ) {
+        for( const std::string &it : msg.folded_lines( msg_width, true ) ) {
             folded_filtered.emplace_back( folded_all.size() );
             folded_all.emplace_back( msg_ind, it );
         }
@@ -940,12 +968,8 @@ void Messages::display_messages( const catacurses::window &ipk_target, const int
             }
 
             const nc_color col = m.get_color( player_messages.curmes );
-            std::string message_text = m.get_with_count();
-            if( !m.is_recent( player_messages.curmes ) ) {
-                message_text = remove_color_tags( message_text );
-            }
-
-            for( const std::string &folded : foldstring( message_text, maxlength ) ) {
+            const bool colored = m.is_recent( player_messages.curmes );
+            for( const std::string &folded : m.folded_lines( maxlength, colored ) ) {
                 if( line > bottom ) {
                     break;
                 }
@@ -973,12 +997,8 @@ void Messages::display_messages( const catacurses::window &ipk_target, const int
             }
 
             const nc_color col = m.get_color( player_messages.curmes );
-            std::string message_text = m.get_with_count();
-            if( !m.is_recent( player_messages.curmes ) ) {
-                message_text = remove_color_tags( message_text );
-            }
-
-            const auto folded_strings = foldstring( message_text, maxlength );
+            const bool colored = m.is_recent( player_messages.curmes );
+            const std::vector<std::string> &folded_strings = m.folded_lines( maxlength, colored );
             const auto folded_rend = folded_strings.rend();
             for( auto string_iter = folded_strings.rbegin();
                  string_iter != folded_rend && line >= top; ++string_iter, line-- ) {
@@ -132,8 +132,9 @@ std::shared_ptr<mmap_file> mmap_file::map_file( const fs::path &file_path )
         return mapped_file;
     }
     on_out_of_scope close_file_guard( [&] { close( fd ); } );
+    // Read only, so the pages are shared with every other process mapping the same file.
     void *map_base = mmap( nullptr, file_size, PROT_READ, MAP_PRIVATE, fd, 0 );
-    if( !map_base ) {
+    if( map_base == MAP_FAILED ) {
         return mapped_file;
     }
 
@@ -92,6 +92,9 @@ static const ter_str_id ter_t_pit( "t_pit" );
 static const ter_str_id ter_t_pit_glass( "t_pit_glass" );
 static const ter_str_id ter_t_pit_spiked( "t_pit_spiked" );
 
+// How long a monster trusts its last scan for hostile monsters, see monster::hostile_memo.
+static constexpr time_duration hostile_target_memo_duration = 3_turns;
+
 bool monster::is_immune_field( const field_type_id &fid ) const
 {
     if( fid == fd_fungal_haze ) {
@@ -281,6 +284,24 @@ bool monster::can_reach_to( const tripoint &p ) const
     return true;
 }
 
+bool monster::expected_route( route_request &request ) const
+{
+    if( !has_dest() || !can_pathfind() ) {
+        return false;
+    }
+    const tripoint local_dest = get_map().bub_from_abs( get_dest() ).raw();
+    const pathfinding_settings &settings = get_pathfinding_settings();
+    if( local_dest.z != posz() || settings.max_dist < rl_dist( get_location(), get_dest() ) ) {
+        return false;
+    }
+    // move() keeps following a path that still leads there.
+    if( !path.empty() && path.back() == local_dest && rl_dist( pos(), path.front() ) < 2 ) {
+        return false;
+    }
+    request = { pos(), local_dest, settings };
+    return true;
+}
+
 bool monster::can_move_to( const tripoint &p ) const
 {
     return can_reach_to( p ) && will_move_to( p );
@@ -567,11 +588,7 @@ void monster::plan()
     int turns_to_skip = max_turns_to_skip * rate_limiting_factor;
     creature_tracker &tracker = get_creature_tracker();
     if( friendly == 0 && ( turns_to_skip == 0 || turns_since_target % turns_to_skip == 0 ) ) {
-        tracker.for_each_reachable( *this, [this]( const mfaction_id & other ) {
-            const mf_attitude faction_att = faction->attitude( other );
-            return !( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY );
-        },
-        [this, &seen_levels, &mon_plan, &valid_targets]( Creature * other ) {
+        const auto consider_hostile = [this, &seen_levels, &mon_plan, &valid_targets]( Creature * other ) {
             if( !seen_levels.test( other->posz() + OVERMAP_DEPTH ) ) {
                 return;
             }
@@ -604,7 +621,28 @@ void monster::plan()
             if( !mon_plan.fleeing && valid_targets != 0 ) {
                 morale -= mon_plan.fears_hostile_seen;
             }
-        } );
+        };
+        const tripoint bucket = project_to<coords::sm>( get_location() ).raw();
+        if( hostile_memo.faction_revision == tracker.get_faction_revision() &&
+            hostile_memo.bucket == bucket && calendar::turn < hostile_memo.expires ) {
+            if( const shared_ptr_fast<monster> remembered = hostile_memo.target.lock() ) {
+                if( !remembered->is_dead() ) {
+                    consider_hostile( remembered.get() );
+                }
+            }
+        } else {
+            tracker.for_each_reachable( *this, [this]( const mfaction_id & other ) {
+                const mf_attitude faction_att = faction->attitude( other );
+                return !( faction_att == MFA_NEUTRAL || faction_att == MFA_FRIENDLY );
+            }, consider_hostile );
+            hostile_memo.faction_revision = tracker.get_faction_revision();
+            hostile_memo.bucket = bucket;
+            hostile_memo.expires = calendar::turn + hostile_target_memo_duration;
+            hostile_memo.target.reset();
+            if( mon_plan.target != nullptr && mon_plan.target->is_monster() ) {
+                hostile_memo.target = g->shared_from( *mon_plan.target->as_monster() );
+            }
+        }
     }
     if( mon_plan.target == nullptr ) {
         // Just avoiding overflow.
@@ -845,7 +883,14 @@ void monster::move()
     // this into another monster type). Therefore we can not iterate over it
     // directly and instead iterate over the map from the monster type
     // (properties of monster types should never change).
+    const bool can_use_specials = !pacified && !is_hallucination();
+    // The attacks tried below share one lookup of the attack target.
+    target_memo = attack_target_memo();
+    target_memo.active = can_use_specials;
     for( const auto &sp_type : type->special_attacks ) {
+        if( !can_use_specials ) {
+            break;
+        }
         const std::string &special_name = sp_type.first;
         const auto local_iter = special_attacks.find( special_name );
         if( local_iter == special_attacks.end() ) {
@@ -861,7 +906,7 @@ void monster::move()
 
         // Cooldowns are decremented in monster::process_turn
 
-        if( local_attack_data.cooldown == 0 && !pacified && !is_hallucination() ) {
+        if( local_attack_data.cooldown == 0 ) {
             if( !sp_type.second->call( *this ) ) {
                 add_msg_debug( debugmode::DF_MATTACK, "Attack failed" );
                 continue;
@@ -875,6 +920,7 @@ void monster::move()
             reset_special( special_name );
         }
     }
+    target_memo.active = false;
 
     // Check if they're dragging a foe and find their hapless victim
     Character *dragged_foe = find_dragged_foe();
@@ -1022,7 +1068,7 @@ void monster::move()
                 ( path.empty() || rl_dist( pos(), path.front() ) >= 2 || path.back() != local_dest.raw() ) ) {
                 // We need a new path
                 if( can_pathfind() ) {
-                    path = here.route( pos(), local_dest.raw(), pf_settings, get_path_avoid() );
+                    path = here.shared_route( pos(), local_dest.raw(), pf_settings, get_path_avoid() );
                     if( path.empty() ) {
                         increment_pathfinding_cd();
                     }
@@ -296,10 +296,12 @@ monster::monster( const mtype_id &id ) : monster()
     moves = type->speed;
     Creature::set_speed_base( type->speed );
     hp = type->hp;
-    dialogue d( get_talker_for( this ), get_talker_for( get_avatar() ) );
-    for( const auto &sa : type->special_attacks ) {
-        mon_special_attack &entry = special_attacks[sa.first];
-        entry.cooldown = rng( 0, sa.second->cooldown.evaluate( d ) );
+    if( !type->special_attacks.empty() ) {
+        dialogue d( get_talker_for( this ), get_talker_for( get_avatar() ) );
+        for( const auto &sa : type->special_attacks ) {
+            mon_special_attack &entry = special_attacks[sa.first];
+            entry.cooldown = rng( 0, sa.second->cooldown.evaluate( d ) );
+        }
     }
     anger = type->agro;
     morale = type->morale;
@@ -383,6 +385,7 @@ void monster::on_move( const tripoint_abs_ms &old_pos )
 
 void monster::poly( const mtype_id &id )
 {
+    renew_sight_stamp();
     double hp_percentage = static_cast<double>( hp ) / static_cast<double>( type->hp );
     if( !no_extra_death_drops ) {
         generate_inventory();
@@ -1551,13 +1554,25 @@ Creature *monster::attack_target()
         return nullptr;
     }
 
-    Creature *target = get_creature_tracker().creature_at( get_dest() );
-    if( target == nullptr || target == this ||
-        attitude_to( *target ) == Attitude::FRIENDLY || !sees( *target ) || target->is_hallucination() ) {
+    const tripoint_abs_ms dest = get_dest();
+    Creature *target = get_creature_tracker().creature_at( dest );
+    if( target == nullptr || target == this ) {
         return nullptr;
     }
-
-    return target;
+    if( target_memo.active && target_memo.occupant == target && target_memo.dest == dest &&
+        target_memo.pos == get_location() && target_memo.occupant_pos == target->get_location() ) {
+        return target_memo.hostile ? target : nullptr;
+    }
+    const bool hostile = attitude_to( *target ) != Attitude::FRIENDLY && sees( *target ) &&
+                         !target->is_hallucination();
+    if( target_memo.active ) {
+        target_memo.occupant = target;
+        target_memo.pos = get_location();
+        target_memo.dest = dest;
+        target_memo.occupant_pos = target->get_location();
+        target_memo.hostile = hostile;
+    }
+    return hostile ? target : nullptr;
 }
 
 void monster::witness_thievery( item *it )
@@ -3339,6 +3354,14 @@ void monster::process_one_effect( effect &it, bool is_new )
         }
     }
 
+    // When processing every effect, process_effects() refreshes these once afterwards
+    if( is_new ) {
+        refresh_effect_enchantments();
+    }
+}
+
+void monster::refresh_effect_enchantments()
+{
     //Process enchantments that apply to monsters.
     enchantment_cache->clear();
 
@@ -3363,6 +3386,9 @@ void monster::process_effects()
             process_one_effect( _effect_it.second, false );
         }
     }
+    if( !effects->empty() ) {
+        refresh_effect_enchantments();
+    }
 
     // Like with player/NPCs - keep the speed above 0
     const int min_speed_bonus = -0.75 * get_speed_base();
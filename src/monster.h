@@ -21,6 +21,7 @@
 #include "creature.h"
 #include "damage.h"
 #include "enums.h"
+#include "memory_fast.h"
 #include "point.h"
 #include "type_id.h"
 #include "units_fwd.h"
@@ -40,6 +41,7 @@ class window;
 }  // namespace catacurses
 struct dealt_projectile_attack;
 struct pathfinding_settings;
+struct route_request;
 struct trap;
 
 enum class mon_trigger : int;
@@ -620,6 +622,11 @@ class monster : public Creature
 
         const pathfinding_settings &get_pathfinding_settings() const override;
         std::function<bool( const tripoint & )> get_path_avoid() const override;
+        /**
+         * The route the next move() is going to search for, if any.  Used to solve the routes
+         * of all monsters together, see map::prepare_routes.
+         */
+        bool expected_route( route_request &request ) const;
         double calculate_by_enchantment( double modify, enchant_vals::mod value,
                                          bool round_output = false ) const;
     private:
@@ -667,6 +674,35 @@ class monster : public Creature
         std::bitset<NUM_MEFF> effect_cache;
         int turns_since_target = 0;
 
+        /**
+         * Result of the last full scan for hostile monsters in @ref plan.  While the creature
+         * tracker's faction revision and the submap this monster is in stay the same, only the
+         * remembered target is rated again instead of every reachable monster.
+         */
+        struct hostile_target_memo {
+            int faction_revision = -1;
+            // Absolute submap coordinates.
+            tripoint bucket;
+            weak_ptr_fast<monster> target;
+            time_point expires = calendar::before_time_starts;
+        };
+        hostile_target_memo hostile_memo;
+
+        /**
+         * The special attacks tried by one move() keep asking for @ref attack_target.  While
+         * they run, the verdict on the creature at the destination is kept and reused for as
+         * long as neither this monster nor that creature moved.
+         */
+        struct attack_target_memo {
+            bool active = false;
+            Creature *occupant = nullptr;
+            tripoint_abs_ms pos;
+            tripoint_abs_ms dest;
+            tripoint_abs_ms occupant_pos;
+            bool hostile = false;
+        };
+        attack_target_memo target_memo;
+
         Character *find_dragged_foe();
         void nursebot_operate( Character *dragged_foe );
 
@@ -678,6 +714,8 @@ class monster : public Creature
         void on_move( const tripoint_abs_ms &old_pos ) override;
         /** Processes monster-specific effects of an effect. */
         void process_one_effect( effect &it, bool is_new ) override;
+        /** Rebuilds the enchantment cache from the current effects and reapplies their speed. */
+        void refresh_effect_enchantments();
 };
 
 #endif // CATA_SRC_MONSTER_H
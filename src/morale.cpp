@@ -514,14 +514,20 @@ int player_morale::get_level() const
 
 void player_morale::decay( const time_duration &ticks )
 {
-    const auto do_decay = [ &ticks ]( morale_point & m ) {
+    // Permanent points and points that haven't started decaying keep their bonus,
+    // so the cached level only needs recomputing if some point actually faded.
+    bool faded = false;
+    for( morale_point &m : points ) {
+        const int prev_bonus = m.get_net_bonus();
         m.decay( ticks );
-    };
-
-    std::for_each( points.begin(), points.end(), do_decay );
+        faded |= m.get_net_bonus() != prev_bonus;
+    }
+    // Removing points and adding temperature penalties invalidate on their own
     remove_expired();
     update_bodytemp_penalty( ticks );
-    invalidate();
+    if( faded ) {
+        invalidate();
+    }
 }
 
 void player_morale::display( int focus_eq, int pain_penalty, int sleepiness_penalty )
@@ -79,10 +79,11 @@ void catacurses::wnoutrefresh( const window &win )
 
 void catacurses::wrefresh( const window &win )
 {
-    if( !win ) {
-        return;
-    }
-    return curses_check_result( ::wrefresh( win.get<::WINDOW>() ), OK, "wrefresh" );
+    // Like the SDL port, the terminal is only updated once the frame is done, by
+    // refresh_display or before waiting for input.  Updating it after every window would
+    // send all the intermediate states of the screen, e.g. a window that is erased by the
+    // background and drawn again by its own UI a moment later.
+    return wnoutrefresh( win );
 }
 
 void catacurses::werase( const window &win )
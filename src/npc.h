@@ -557,6 +557,18 @@ struct npc_short_term_cache {
     std::vector<weak_ptr_fast<Creature>> friends;
     std::vector<sphere> dangerous_explosives;
     std::map<direction, float> threat_map;
+    // Line of sight to the creatures assess_danger looked at.  An entry holds while neither
+    // side moves, the whole memo is dropped when the map's vision changes and on a timer.
+    struct sight_memo {
+        weak_ptr_fast<Creature> who;
+        tripoint_abs_ms pos;
+        bool potential_los = false;
+        std::optional<bool> sees;
+    };
+    std::unordered_map<const Creature *, sight_memo> sight;
+    tripoint_abs_ms sight_origin;
+    int sight_vision_generation = -1;
+    time_point sight_expires;
     // Cache of locations the NPC has searched recently in npc::find_item()
     lru_cache<tripoint, int> searched_tiles;
     // returns the value of the distance between a friendly creature and the closest enemy to that
@@ -1108,6 +1120,8 @@ class npc : public Character
         float evaluate_self( bool my_gun );
 
         void assess_danger();
+        /** Memoized line of sight checks for assess_danger, see npc_short_term_cache::sight. */
+        npc_short_term_cache::sight_memo &sight_memo_of( const Creature &c );
         void act_on_danger_assessment();
         bool is_safe() const;
         // Functions which choose an action for a particular goal
@@ -156,6 +156,9 @@ static const zone_type_id zone_type_NPC_RETREAT( "NPC_RETREAT" );
 
 static constexpr float MAX_FLOAT = 5000000000.0f;
 
+// How long assess_danger may reuse line of sight checks against creatures that stayed put.
+static constexpr time_duration npc_sight_memo_duration = 5_turns;
+
 // TODO: These would be much better using common code or constants from character.cpp,
 // which handles the player formatting of thirst/hunger levels. Right now we
 // have magic numbers all over the place. ;(
@@ -697,6 +700,18 @@ std::optional<int> npc_short_term_cache::closest_enemy_to_friendly_distance() co
     return distance;
 }
 
+npc_short_term_cache::sight_memo &npc::sight_memo_of( const Creature &c )
+{
+    npc_short_term_cache::sight_memo &memo = ai_cache.sight[&c];
+    if( memo.pos != c.get_location() || memo.who.lock().get() != &c ) {
+        memo.who = g->shared_from( c );
+        memo.pos = c.get_location();
+        memo.potential_los = get_map().has_potential_los( pos_bub(), c.pos_bub() );
+        memo.sees.reset();
+    }
+    return memo;
+}
+
 void npc::assess_danger()
 {
     float highest_priority = 1.0f;
@@ -769,6 +784,14 @@ void npc::assess_danger()
         cur_threat_map[ threat_dir ] = 0.25f * ai_cache.threat_map[ threat_dir ];
     }
     map &here = get_map();
+    if( ai_cache.sight_origin != get_location() ||
+        ai_cache.sight_vision_generation != here.get_vision_generation() ||
+        calendar::turn >= ai_cache.sight_expires ) {
+        ai_cache.sight.clear();
+        ai_cache.sight_origin = get_location();
+        ai_cache.sight_vision_generation = here.get_vision_generation();
+        ai_cache.sight_expires = calendar::turn + npc_sight_memo_duration;
+    }
     // cache string_id -> int_id conversion before hot loop
     const field_type_id fd_fire = ::fd_fire;
     // first, check if we're about to be consumed by fire
@@ -793,14 +816,20 @@ void npc::assess_danger()
         if( &guy == this ) {
             continue;
         }
-        if( !clairvoyant && !here.has_potential_los( pos_bub(), guy.pos_bub() ) ) {
+        npc_short_term_cache::sight_memo &sight = sight_memo_of( guy );
+        if( !clairvoyant && !sight.potential_los ) {
             continue;
         }
 
         if( has_faction_relationship( guy, npc_factions::relationship::watch_your_back ) ) {
             ai_cache.friends.emplace_back( g->shared_from( guy ) );
-        } else if( attitude_to( guy ) != Attitude::NEUTRAL && sees( guy.pos_bub() ) ) {
-            ai_cache.hostile_guys.emplace_back( g->shared_from( guy ) );
+        } else if( attitude_to( guy ) != Attitude::NEUTRAL ) {
+            if( !sight.sees ) {
+                sight.sees = sees( guy.pos_bub() );
+            }
+            if( *sight.sees ) {
+                ai_cache.hostile_guys.emplace_back( g->shared_from( guy ) );
+            }
         }
     }
     if( is_friendly( player_character ) && sees_player ) {
@@ -811,7 +840,8 @@ void npc::assess_danger()
     }
 
     for( const monster &critter : g->all_monsters() ) {
-        if( !clairvoyant && !here.has_potential_los( pos_bub(), critter.pos_bub() ) ) {
+        npc_short_term_cache::sight_memo &sight = sight_memo_of( critter );
+        if( !clairvoyant && !sight.potential_los ) {
             continue;
         }
         Creature::Attitude att = critter.attitude_to( *this );
@@ -824,7 +854,10 @@ void npc::assess_danger()
             ai_cache.neutral_guys.emplace_back( g->shared_from( critter ) );
             continue;
         }
-        if( !sees( critter ) ) {
+        if( !sight.sees ) {
+            sight.sees = sees( critter );
+        }
+        if( !*sight.sees ) {
             continue;
         }
 
@@ -160,10 +160,12 @@ int npc_trading::bionic_install_price( Character &installer, Character &patient,
 }
 
 int npc_trading::adjusted_price( item const *it, int amount, Character const &buyer,
-                                 Character const &seller )
+                                 Character const &seller, trade_price_cache *cache )
 {
     npc const *faction_party = buyer.is_npc() ? buyer.as_npc() : seller.as_npc();
-    faction_price_rule const *const fpr = faction_party->get_price_rules( *it );
+    faction_price_rule const *const fpr = cache != nullptr ?
+                                          cache->price_rules( *faction_party, *it ) :
+                                          faction_party->get_price_rules( *it );
 
     double price = it->price_no_contents( true, fpr != nullptr ? fpr->price : std::nullopt );
     if( fpr != nullptr ) {
@@ -195,7 +197,7 @@ int npc_trading::adjusted_price( item const *it, int amount, Character const &bu
 namespace
 {
 int _trading_price( Character const &buyer, Character const &seller, item_location const &it,
-                    int amount )
+                    int amount, trade_price_cache *cache )
 {
     if( seller.is_npc() ) {
         if( !seller.as_npc()->wants_to_sell( it, 1 ).success() ) {
@@ -206,11 +208,11 @@ int _trading_price( Character const &buyer, Character const &seller, item_locati
             return 0;
         }
     }
-    int ret = npc_trading::adjusted_price( it.get_item(), amount, buyer, seller );
+    int ret = npc_trading::adjusted_price( it.get_item(), amount, buyer, seller, cache );
     for( item_pocket const *pk : it->get_all_standard_pockets() ) {
         for( item const *pkit : pk->all_items_top() ) {
             ret += _trading_price( buyer, seller, item_location{ it, const_cast<item *>( pkit ) },
-                                   -1 );
+                                   -1, cache );
         }
     }
     return ret;
@@ -218,9 +220,9 @@ int _trading_price( Character const &buyer, Character const &seller, item_locati
 } // namespace
 
 int npc_trading::trading_price( Character const &buyer, Character const &seller,
-                                trade_selector::entry_t const &it )
+                                trade_selector::entry_t const &it, trade_price_cache *cache )
 {
-    return _trading_price( buyer, seller, it.first, it.second );
+    return _trading_price( buyer, seller, it.first, it.second, cache );
 }
 
 void item_pricing::set_values( int ip_count )
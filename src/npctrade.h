@@ -48,9 +48,11 @@ namespace npc_trading
 bool pay_npc( npc &np, int cost );
 
 int bionic_install_price( Character &installer, Character &patient, item_location const &bionic );
-int adjusted_price( item const *it, int amount, Character const &buyer, Character const &seller );
+/** @p cache, if given, is used to look up the faction price rules. */
+int adjusted_price( item const *it, int amount, Character const &buyer, Character const &seller,
+                    trade_price_cache *cache = nullptr );
 int trading_price( Character const &buyer, Character const &seller,
-                   trade_selector::entry_t const &it );
+                   trade_selector::entry_t const &it, trade_price_cache *cache = nullptr );
 int calc_npc_owes_you( const npc &np, int your_balance );
 bool npc_will_accept_trade( npc const &np, int your_balance );
 bool npc_can_fit_items( npc const &np, trade_selector::select_t const &to_trade );
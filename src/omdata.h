@@ -3,11 +3,13 @@
 #define CATA_SRC_OMDATA_H
 
 #include <array>
+#include <chrono>
 #include <climits>
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
 #include <list>
+#include <map>
 #include <new>
 #include <optional>
 #include <set>
@@ -669,7 +671,7 @@ class overmap_special
         }
         int longest_side() const;
         std::vector<overmap_special_terrain> preview_terrains() const;
-        std::vector<overmap_special_locations> required_locations() const;
+        const std::vector<overmap_special_locations> &required_locations() const;
         int score_rotation_at( const overmap &om, const tripoint_om_omt &p,
                                om_direction::type r ) const;
         special_placement_result place(
@@ -760,6 +762,18 @@ const std::vector<overmap_land_use_code> &get_all();
 
 } // namespace overmap_land_use_codes
 
+/** How placing one overmap special went, summed over the overmaps generated since loading. */
+struct overmap_special_placement_stats {
+    // Positions the special was tried at.
+    int attempts = 0;
+    // Attempts ruled out by the city constraints, and by the terrain or the other placement
+    // rules at every rotation.
+    int rejected_city = 0;
+    int rejected_terrain = 0;
+    int placed = 0;
+    std::chrono::nanoseconds time = std::chrono::nanoseconds::zero();
+};
+
 namespace overmap_specials
 {
 
@@ -777,6 +791,9 @@ overmap_special_batch get_default_batch( const point_abs_om &origin );
  */
 overmap_special_id create_building_from( const string_id<oter_type_t> &base );
 
+/** Placement attempts of each special, for the debug menu. */
+std::map<overmap_special_id, overmap_special_placement_stats> &placement_stats();
+
 } // namespace overmap_specials
 
 namespace city_buildings
@@ -996,6 +996,7 @@ void options_manager::cOpt::setNext()
             fSet = fMin;
         }
     }
+    invalidate_refs();
 }
 
 //set to previous item
@@ -1034,6 +1035,7 @@ void options_manager::cOpt::setPrev()
             fSet = fMax;
         }
     }
+    invalidate_refs();
 }
 
 //set value
@@ -1047,6 +1049,7 @@ void options_manager::cOpt::setValue( float fSetIn )
     if( fSet < fMin || fSet > fMax ) {
         fSet = fDefault;
     }
+    invalidate_refs();
 }
 
 //set value
@@ -1060,6 +1063,7 @@ void options_manager::cOpt::setValue( int iSetIn )
     if( iSet < iMin || iSet > iMax ) {
         iSet = iDefault;
     }
+    invalidate_refs();
 }
 
 //set value
@@ -1121,6 +1125,7 @@ void options_manager::cOpt::setValue( const std::string &sSetIn )
             debugmsg( "invalid floating point option: %s", sSetIn );
         }
     }
+    invalidate_refs();
 }
 
 /** Fill a mapping with values.
@@ -1651,6 +1656,32 @@ void options_manager::add_options_general()
            );
 
         get_option( "AUTOSAVE_MINUTES" ).setPrerequisite( "AUTOSAVE" );
+
+        add( "SAVE_THREADS", page_id, to_translation( "Map saving threads" ),
+             to_translation( "Number of threads used to write the map and overmaps when saving.  0 uses one thread per logical processor." ),
+             0, 64, 0
+           );
+
+        add( "WORKER_THREADS", page_id, to_translation( "Worker threads" ),
+             to_translation( "Number of threads shared by the parts of the game that work in parallel, such as loading data, drawing the map, fields and pathfinding.  0 uses one thread per logical processor.  Requires restart." ),
+             0, 64, 0
+           );
+
+        add( "SAVE_COMPRESSION", page_id, to_translation( "Save compression level" ),
+             to_translation( "gzip level used for map, overmap and map memory files.  1 is fastest, 9 is smallest, 0 writes them uncompressed.  Compressed and uncompressed files can always be read, so this can be changed at any time." ),
+             0, 9, 0
+           );
+
+        add( "MAP_SAVE_FORMAT", page_id, to_translation( "Map save format" ),
+             to_translation( "Format used when writing map files.  Binary files are smaller and faster to load.  Files in either format can always be read, so this can be changed at any time." ),
+        { { "json", to_translation( "JSON" ) }, { "binary", to_translation( "Binary" ) } },
+        "json"
+           );
+
+        add( "OVERMAP_RESIDENT_LIMIT", page_id, to_translation( "Loaded overmaps limit" ),
+             to_translation( "Number of overmaps kept in memory.  Above it, the overmaps the player hasn't been near for the longest time are saved and unloaded.  0 keeps every visited overmap loaded." ),
+             0, 1000, 0
+           );
     } );
 
     add_empty_line();
@@ -2290,6 +2321,11 @@ void options_manager::add_options_graphics()
              to_translation( "If true, forces the game to redraw at least once per turn." ),
              true
            );
+
+        add( "UI_REDRAW_FPS", page_id, to_translation( "Redraw rate limit" ),
+             to_translation( "The maximum number of times per second the screen is redrawn while waiting, saving or doing a long activity.  Screens waiting for your input are always redrawn right away." ),
+             1, 120, 30
+           );
     } );
 
     add_empty_line();
@@ -2924,6 +2960,16 @@ void options_manager::add_options_debug()
          0, OVERMAP_LAYERS, 4
        );
 
+    add( "MONSTER_AI_DETAIL_DISTANCE", "debug", to_translation( "Full monster AI distance" ),
+         to_translation( "Wandering monsters farther than this from you and any NPC, and out of your sight, only make plans every few turns and then use the moves they saved up at once.  Setting this to 0 runs the full AI for every monster every turn." ),
+         0, 132, 30
+       );
+
+    add( "DEFERRED_GAS_SPREAD", "debug", to_translation( "Spread gas from last turn's fields" ),
+         to_translation( "If true, where every gas cloud spreads is decided from the fields at the start of the turn, on several threads, instead of one tile after another.  Gas then moves at most one tile per turn, whatever order the map is processed in.  Faster with many fields, but gas spreads a bit differently." ),
+         false
+       );
+
     add_empty_line();
 
     add_option_group( "debug", Group( "occlusion_opts", to_translation( "Occlusion options" ),
@@ -2969,6 +3015,21 @@ void options_manager::add_options_debug()
          false
 #endif
        );
+
+    add( "LAZY_DATA_LOADING", "debug", to_translation( "Load rarely used data on demand" ),
+         to_translation( "If enabled together with skipping the verification step, rarely used data such as ASCII art is only loaded the first time it is needed.  Errors in that data are only reported when it is used." ),
+         false
+       );
+
+    add( "PARALLEL_VERIFICATION", "debug", to_translation( "Verify data on several threads" ),
+         to_translation( "If enabled, the parts of the JSON verification step that only read the data run at the same time on several threads.  This may give a faster loading time." ),
+         false
+       );
+
+    add( "SKIP_VERIFIED_DATA", "debug", to_translation( "Skip verification of unchanged data" ),
+         to_translation( "If enabled, the JSON verification step is skipped when the game data and the mods are unchanged since they last passed it without errors." ),
+         false
+       );
 }
 
 void options_manager::add_options_android()
@@ -3995,6 +4056,7 @@ std::string options_manager::show( bool ingame, const bool world_options_only, b
             if( ingame && world_options_changed ) {
                 ACTIVE_WORLD_OPTIONS = WOPTIONS_OLD;
             }
+            invalidate_refs();
         }
     }
 
@@ -4093,6 +4155,8 @@ std::string options_manager::migrateOptionValue( const std::string &name,
 
 void options_manager::update_options_cache()
 {
+    invalidate_refs();
+
     // cache to global due to heavy usage.
     trigdist = ::get_option<bool>( "CIRCLEDIST" );
     use_tiles = ::get_option<bool>( "USE_TILES" );
@@ -4110,6 +4174,7 @@ void options_manager::update_options_cache()
     log_from_top = ::get_option<std::string>( "LOG_FLOW" ) == "new_top";
     message_ttl = ::get_option<int>( "MESSAGE_TTL" );
     message_cooldown = ::get_option<int>( "MESSAGE_COOLDOWN" );
+    ui_redraw_fps = ::get_option<int>( "UI_REDRAW_FPS" );
     fov_3d_z_range = ::get_option<int>( "FOV_3D_Z_RANGE" );
     keycode_mode = ::get_option<std::string>( "SDL_KEYBOARD_MODE" ) == "keycode";
     use_pinyin_search = ::get_option<bool>( "USE_PINYIN_SEARCH" );
@@ -4202,6 +4267,7 @@ void options_manager::set_world_options( options_container *options )
     } else {
         world_options = options;
     }
+    invalidate_refs();
 }
 
 void options_manager::update_global_locale()
@@ -236,6 +236,18 @@ class options_manager
 
         cOpt &get_option( const std::string &name );
 
+        /**
+         * Counter that changes whenever the value of any option may have changed, used by
+         * @ref option_ref to notice stale values.
+         */
+        static unsigned int revision() {
+            return revision_;
+        }
+        /** Invalidate the values held by every @ref option_ref. */
+        static void invalidate_refs() {
+            ++revision_;
+        }
+
         //add hidden external option with value
         void add_external( const std::string &sNameIn, const std::string &sPageIn, const std::string &sType,
                            const translation &sMenuTextIn, const translation &sTooltipIn );
@@ -283,6 +295,8 @@ class options_manager
     private:
         options_container options;
         std::optional<options_container *> world_options; // NOLINT(cata-serialize)
+        // Starts above the revision of a fresh option_ref, so its first read does the lookup.
+        static inline unsigned int revision_ = 1; // NOLINT(cata-serialize)
 
         /** Option group. */
         class Group
@@ -505,4 +519,29 @@ inline T get_option( const std::string &name, bool convert = false )
     return get_options().get_option( name ).value_as<T>( convert );
 }
 
+/**
+ * Typed handle to the option @p name for code that reads it often, e.g. once per drawn tile.
+ * The string lookup of @ref get_option is done on the first read and again only after
+ * options changed, otherwise the value from the last lookup is returned.
+ */
+template<typename T>
+class option_ref
+{
+    public:
+        explicit option_ref( std::string name ) : name( std::move( name ) ) {}
+
+        const T &get() const {
+            if( revision != options_manager::revision() ) {
+                value = ::get_option<T>( name );
+                revision = options_manager::revision();
+            }
+            return value;
+        }
+
+    private:
+        std::string name;
+        mutable T value = T();
+        mutable unsigned int revision = 0;
+};
+
 #endif // CATA_SRC_OPTIONS_H
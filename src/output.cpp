@@ -3262,48 +3262,7 @@ nc_color msgtype_to_color( const game_message_type type, const bool bOldMsg )
  **/
 bool wildcard_match( const std::string &text_in, const std::string &pattern_in )
 {
-    std::string text = text_in;
-
-    if( text.empty() ) {
-        return false;
-    } else if( text == "*" ) {
-        return true;
-    }
-
-    std::vector<std::string> pattern = string_split( wildcard_trim_rule( pattern_in ), '*' );
-
-    if( pattern.size() == 1 ) { // no * found
-        return ( text.length() == pattern[0].length() && ci_find_substr( text, pattern[0] ) != -1 );
-    }
-
-    for( auto it = pattern.begin(); it != pattern.end(); ++it ) {
-        if( it == pattern.begin() && !it->empty() ) {
-            if( text.length() < it->length() ||
-                ci_find_substr( text.substr( 0, it->length() ), *it ) == -1 ) {
-                return false;
-            }
-
-            text = text.substr( it->length(), text.length() - it->length() );
-        } else if( it == pattern.end() - 1 && !it->empty() ) {
-            if( text.length() < it->length() ||
-                ci_find_substr( text.substr( text.length() - it->length(),
-                                             it->length() ), *it ) == -1 ) {
-                return false;
-            }
-        } else {
-            if( !( *it ).empty() ) {
-                int pos = ci_find_substr( text, *it );
-                if( pos == -1 ) {
-                    return false;
-                }
-
-                text = text.substr( pos + static_cast<int>( it->length() ),
-                                    static_cast<int>( text.length() ) - pos );
-            }
-        }
-    }
-
-    return true;
+    return wildcard_matcher( pattern_in )( text_in );
 }
 
 std::string wildcard_trim_rule( const std::string &pattern_in )
@@ -3,14 +3,19 @@
 #include "overmap.h" // IWYU pragma: associated
 
 #include <algorithm>
+#include <chrono>
+#include <climits>
 #include <cmath>
 #include <cstring>
 #include <exception>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <numeric>
 #include <optional>
 #include <ostream>
 #include <set>
+#include <sstream>
 #include <unordered_set>
 #include <vector>
 
@@ -29,6 +34,7 @@
 #include "debug.h"
 #include "distribution.h"
 #include "effect_on_condition.h"
+#include "filesystem.h"
 #include "flood_fill.h"
 #include "game.h"
 #include "generic_factory.h"
@@ -589,6 +595,13 @@ void overmap_specials::check_consistency()
 void overmap_specials::reset()
 {
     specials.reset();
+    placement_stats().clear();
+}
+
+std::map<overmap_special_id, overmap_special_placement_stats> &overmap_specials::placement_stats()
+{
+    static std::map<overmap_special_id, overmap_special_placement_stats> stats;
+    return stats;
 }
 
 const std::vector<overmap_special> &overmap_specials::get_all()
@@ -1378,7 +1391,7 @@ struct overmap_special_data {
         mapgen_parameters &, const std::string &context ) const = 0;
     virtual void check( const std::string &context ) const = 0;
     virtual std::vector<overmap_special_terrain> preview_terrains() const = 0;
-    virtual std::vector<overmap_special_locations> required_locations() const = 0;
+    virtual const std::vector<overmap_special_locations> &required_locations() const = 0;
     virtual int score_rotation_at( const overmap &om, const tripoint_om_omt &p,
                                    om_direction::type r ) const = 0;
     virtual special_placement_result place(
@@ -1389,8 +1402,9 @@ struct overmap_special_data {
 struct fixed_overmap_special_data : overmap_special_data {
     fixed_overmap_special_data() = default;
     explicit fixed_overmap_special_data( const overmap_special_terrain &ter )
-        : terrains{ ter }
-    {}
+        : terrains{ ter } {
+        update_required_locations();
+    }
 
     void finalize(
         const std::string &/*context*/,
@@ -1402,6 +1416,7 @@ struct fixed_overmap_special_data : overmap_special_data {
                 t.locations = default_locations;
             }
         }
+        update_required_locations();
 
         for( overmap_special_connection &elem : connections ) {
             const overmap_special_terrain &oter = get_terrain_at( elem.p );
@@ -1578,11 +1593,13 @@ struct fixed_overmap_special_data : overmap_special_data {
         return result;
     }
 
-    std::vector<overmap_special_locations> required_locations() const override {
-        std::vector<overmap_special_locations> result;
-        result.reserve( terrains.size() );
-        std::copy( terrains.begin(), terrains.end(), std::back_inserter( result ) );
-        return result;
+    const std::vector<overmap_special_locations> &required_locations() const override {
+        return required;
+    }
+
+    // Every placement attempt checks the locations, so they are copied out of the terrains once.
+    void update_required_locations() {
+        required.assign( terrains.begin(), terrains.end() );
     }
 
     int score_rotation_at( const overmap &om, const tripoint_om_omt &p,
@@ -1670,6 +1687,7 @@ struct fixed_overmap_special_data : overmap_special_data {
     }
 
     std::vector<overmap_special_terrain> terrains;
+    std::vector<overmap_special_locations> required;
     std::vector<overmap_special_connection> connections;
 };
 
@@ -2710,7 +2728,7 @@ struct mutable_overmap_special_data : overmap_special_data {
         return std::vector<overmap_special_terrain> { root_as_overmap_special_terrain() };
     }
 
-    std::vector<overmap_special_locations> required_locations() const override {
+    const std::vector<overmap_special_locations> &required_locations() const override {
         return check_for_locations;
     }
 
@@ -2915,7 +2933,7 @@ int overmap_special::longest_side() const
 {
     // Figure out the longest side of the special for purposes of determining our sector size
     // when attempting placements.
-    std::vector<overmap_special_locations> req_locations = required_locations();
+    const std::vector<overmap_special_locations> &req_locations = required_locations();
     auto min_max_x = std::minmax_element( req_locations.begin(), req_locations.end(),
     []( const overmap_special_locations & lhs, const overmap_special_locations & rhs ) {
         return lhs.p.x < rhs.p.x;
@@ -2936,7 +2954,7 @@ std::vector<overmap_special_terrain> overmap_special::preview_terrains() const
     return data_->preview_terrains();
 }
 
-std::vector<overmap_special_locations> overmap_special::required_locations() const
+const std::vector<overmap_special_locations> &overmap_special::required_locations() const
 {
     return data_->required_locations();
 }
@@ -3090,10 +3108,36 @@ overmap::overmap( const point_abs_om &p ) : loc( p )
     settings = &rsit->second;
 
     init_layers();
+    renew_terrain_stamp();
 }
 
 overmap::~overmap() = default;
 
+static int next_overmap_stamp()
+{
+    static int last_stamp = 0;
+    return ++last_stamp;
+}
+
+void overmap::renew_terrain_stamp()
+{
+    terrain_stamp = next_overmap_stamp();
+    layer_stamps.fill( terrain_stamp );
+    renew_display_stamp();
+}
+
+void overmap::renew_layer_stamp( const int z )
+{
+    terrain_stamp = next_overmap_stamp();
+    layer_stamps[z + OVERMAP_DEPTH] = terrain_stamp;
+    renew_display_stamp();
+}
+
+void overmap::renew_display_stamp()
+{
+    display_stamp = next_overmap_stamp();
+}
+
 void overmap::populate( overmap_special_batch &enabled_specials )
 {
     try {
@@ -3101,9 +3145,17 @@ void overmap::populate( overmap_special_batch &enabled_specials )
     } catch( const std::exception &err ) {
         debugmsg( "overmap (%d,%d) failed to load: %s", loc.x(), loc.y(), err.what() );
     }
+    // Loading and generating write the terrain directly.
+    renew_terrain_stamp();
 }
 
 void overmap::populate()
+{
+    overmap_special_batch enabled_specials = get_enabled_specials();
+    populate( enabled_specials );
+}
+
+overmap_special_batch overmap::get_enabled_specials() const
 {
     overmap_special_batch enabled_specials = overmap_specials::get_default_batch( loc );
     const overmap_feature_flag_settings &overmap_feature_flag = settings->overmap_feature_flag;
@@ -3138,7 +3190,7 @@ void overmap::populate()
         }
     }
 
-    populate( enabled_specials );
+    return enabled_specials;
 }
 
 oter_id overmap::get_default_terrain( int z ) const
@@ -3196,6 +3248,50 @@ void overmap::ter_set( const tripoint_om_omt &p, const oter_id &id )
         // Don't push another copy.
     }
     current_oter = id;
+    renew_layer_stamp( p.z() );
+}
+
+void overmap::find_terrain_positions( const int z,
+                                      const std::function<bool( const oter_id & )> &match,
+                                      std::vector<tripoint_om_omt> &out ) const
+{
+    terrain_index_layer &index = terrain_index[z + OVERMAP_DEPTH];
+    const cata::mdarray<oter_id, point_om_omt> &terrain = layer[z + OVERMAP_DEPTH].terrain;
+    if( index.stamp != layer_stamps[z + OVERMAP_DEPTH] ) {
+        // Counting sort of the cells by terrain.
+        std::unordered_map<oter_id, uint16_t> counts;
+        for( int y = 0; y < OMAPY; ++y ) {
+            for( int x = 0; x < OMAPX; ++x ) {
+                ++counts[terrain[x][y]];
+            }
+        }
+        index.terrains.clear();
+        std::unordered_map<oter_id, uint16_t> next_cell;
+        uint16_t end = 0;
+        for( const std::pair<const oter_id, uint16_t> &count : counts ) {
+            next_cell[count.first] = end;
+            end += count.second;
+            index.terrains.emplace_back( count.first, end );
+        }
+        index.cells.resize( OMAPX * OMAPY );
+        for( int y = 0; y < OMAPY; ++y ) {
+            for( int x = 0; x < OMAPX; ++x ) {
+                index.cells[next_cell[terrain[x][y]]++] = static_cast<uint16_t>( x + y * OMAPX );
+            }
+        }
+        index.stamp = layer_stamps[z + OVERMAP_DEPTH];
+    }
+
+    uint16_t begin = 0;
+    for( const std::pair<oter_id, uint16_t> &run : index.terrains ) {
+        if( match( run.first ) ) {
+            for( uint16_t i = begin; i < run.second; ++i ) {
+                const uint16_t cell = index.cells[i];
+                out.emplace_back( cell % OMAPX, cell / OMAPX, z );
+            }
+        }
+        begin = run.second;
+    }
 }
 
 const oter_id &overmap::ter( const tripoint_om_omt &p ) const
@@ -3250,13 +3346,39 @@ void overmap::set_seen( const tripoint_om_omt &p, om_vision_level val, bool forc
         return;
     }
 
-    layer[p.z() + OVERMAP_DEPTH].visible[p.xy()] = val;
+    om_vision_level &visible = layer[p.z() + OVERMAP_DEPTH].visible[p.xy()];
+    if( visible != val ) {
+        visible = val;
+        renew_display_stamp();
+    }
 
     if( val > om_vision_level::details ) {
         add_extra_note( p );
     }
 }
 
+bool overmap::reveal_span( const tripoint_om_omt &start, int length,
+                           const std::function<bool( const oter_id & )> &filter )
+{
+    cata_assert( inbounds( start ) && inbounds( start + point( length - 1, 0 ) ) );
+    map_layer &l = layer[start.z() + OVERMAP_DEPTH];
+    bool result = false;
+    for( int i = 0; i < length; ++i ) {
+        const tripoint_om_omt p = start + point( i, 0 );
+        om_vision_level &visible = l.visible[p.xy()];
+        if( visible == om_vision_level::full || !filter( l.terrain[p.xy()] ) ) {
+            continue;
+        }
+        visible = om_vision_level::full;
+        add_extra_note( p );
+        result = true;
+    }
+    if( result ) {
+        renew_display_stamp();
+    }
+    return result;
+}
+
 om_vision_level overmap::seen( const tripoint_om_omt &p ) const
 {
     if( !inbounds( p ) ) {
@@ -3271,6 +3393,8 @@ bool &overmap::explored( const tripoint_om_omt &p )
         nullbool = false;
         return nullbool;
     }
+    // The caller may change it through the reference.
+    renew_display_stamp();
     return layer[p.z() + OVERMAP_DEPTH].explored[p.xy()];
 }
 
@@ -3310,12 +3434,14 @@ bool overmap::monster_check( const std::pair<tripoint_om_sm, monster> &candidate
 
 void overmap::insert_npc( const shared_ptr_fast<npc> &who )
 {
+    load_npcs();
     npcs.push_back( who );
     g->set_npcs_dirty();
 }
 
 shared_ptr_fast<npc> overmap::erase_npc( const character_id &id )
 {
+    load_npcs();
     const auto iter = std::find_if( npcs.begin(),
     npcs.end(), [id]( const shared_ptr_fast<npc> &n ) {
         return n->getID() == id;
@@ -3333,6 +3459,7 @@ std::vector<shared_ptr_fast<npc>> overmap::get_npcs( const
                                std::function<bool( const npc & )>
                                &predicate ) const
 {
+    load_npcs();
     std::vector<shared_ptr_fast<npc>> result;
     for( const auto &g : npcs ) {
         if( predicate( *g ) ) {
@@ -3609,112 +3736,162 @@ void overmap::set_scent( const tripoint_abs_omt &loc, const scent_trace &new_sce
     scents[loc] = new_scent;
 }
 
-void overmap::generate( const overmap *north, const overmap *east,
-                        const overmap *south, const overmap *west,
-                        overmap_special_batch &enabled_specials )
-{
-    dbg( D_INFO ) << "overmap::generate start…";
-    const oter_id omt_outside_defined_omap = static_cast<oter_id>
-            ( get_option<std::string>( "OUTSIDE_DEFINED_OMAP_OMT" ) );
-    const std::string overmap_pregenerated_path =
-        get_option<std::string>( "OVERMAP_PREGENERATED_PATH" );
-    if( !overmap_pregenerated_path.empty() ) {
-        // HACK: For some reason gz files are automatically unpacked and renamed during Android build process
+overmap_generation_state overmap::begin_generation(
+    const overmap_special_batch &enabled_specials ) const
+{
+    overmap_generation_state state( enabled_specials );
+    state.rng_engine = rng_stream_engine( g->get_seed(), rng_stream::overmap_generation,
+                                          tripoint( loc.x(), loc.y(), 0 ) );
+    state.north = overmap_buffer.get_existing( loc + point_north );
+    state.south = overmap_buffer.get_existing( loc + point_south );
+    state.west = overmap_buffer.get_existing( loc + point_west );
+    state.east = overmap_buffer.get_existing( loc + point_east );
+    return state;
+}
+
+bool overmap::generate_stage( overmap_generation_state &state )
+{
+    const rng_stream_scope rng_scope( state.rng_engine );
+    const overmap *north = state.north;
+    const overmap *east = state.east;
+    const overmap *south = state.south;
+    const overmap *west = state.west;
+    // Each stage is a few of the steps below, so a stage takes a fraction of the whole.
+    switch( state.stage++ ) {
+        case 0: {
+            dbg( D_INFO ) << "overmap::generate start…";
+            const oter_id omt_outside_defined_omap = static_cast<oter_id>
+                    ( get_option<std::string>( "OUTSIDE_DEFINED_OMAP_OMT" ) );
+            const std::string overmap_pregenerated_path =
+                get_option<std::string>( "OVERMAP_PREGENERATED_PATH" );
+            if( !overmap_pregenerated_path.empty() ) {
+                // HACK: For some reason gz files are automatically unpacked and renamed during Android build process
 #if defined(__ANDROID__)
-        static const std::string fname = "%s/overmap_%d_%d.omap";
+                static const std::string fname = "%s/overmap_%d_%d.omap";
 #else
-        static const std::string fname = "%s/overmap_%d_%d.omap.gz";
+                static const std::string fname = "%s/overmap_%d_%d.omap.gz";
 #endif
-        const cata_path fpath = PATH_INFO::moddir() / string_format( fname,
-                                overmap_pregenerated_path, pos().x(), pos().y() );
-        dbg( D_INFO ) << "trying" << fpath;
-        if( !read_from_file_optional_json( fpath, [this, &fpath]( const JsonValue & jv ) {
-        unserialize_omap( jv, fpath );
-        } ) ) {
-            dbg( D_INFO ) << "failed" << fpath;
-            int z = 0;
-            for( int j = 0; j < OMAPY; j++ ) {
-                // NOLINTNEXTLINE(modernize-loop-convert)
-                for( int i = 0; i < OMAPX; i++ ) {
-                    layer[z + OVERMAP_DEPTH].terrain[i][j] = omt_outside_defined_omap;
+                const cata_path fpath = PATH_INFO::moddir() / string_format( fname,
+                                        overmap_pregenerated_path, pos().x(), pos().y() );
+                dbg( D_INFO ) << "trying" << fpath;
+                if( !read_from_file_optional_json( fpath, [this, &fpath]( const JsonValue & jv ) {
+                unserialize_omap( jv, fpath );
+                } ) ) {
+                    dbg( D_INFO ) << "failed" << fpath;
+                    int z = 0;
+                    for( int j = 0; j < OMAPY; j++ ) {
+                        // NOLINTNEXTLINE(modernize-loop-convert)
+                        for( int i = 0; i < OMAPX; i++ ) {
+                            layer[z + OVERMAP_DEPTH].terrain[i][j] = omt_outside_defined_omap;
+                        }
+                    }
                 }
             }
+            // The pregenerated terrain is written directly.
+            renew_terrain_stamp();
+            calculate_urbanity();
+            calculate_forestosity();
+            if( get_option<bool>( "OVERMAP_POPULATE_OUTSIDE_CONNECTIONS_FROM_NEIGHBORS" ) ) {
+                populate_connections_out_from_neighbors( north, east, south, west );
+            }
+            break;
         }
-    }
-    calculate_urbanity();
-    calculate_forestosity();
-    if( get_option<bool>( "OVERMAP_POPULATE_OUTSIDE_CONNECTIONS_FROM_NEIGHBORS" ) ) {
-        populate_connections_out_from_neighbors( north, east, south, west );
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_RIVERS" ) ) {
-        place_rivers( north, east, south, west );
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_LAKES" ) ) {
-        place_lakes();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_OCEANS" ) ) {
-        place_oceans();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_FORESTS" ) ) {
-        place_forests();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_SWAMPS" ) ) {
-        place_swamps();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_RAVINES" ) ) {
-        place_ravines();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_CITIES" ) ) {
-        place_cities();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_FOREST_TRAILS" ) ) {
-        place_forest_trails();
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_RAILROADS_BEFORE_ROADS" ) ) {
-        if( get_option<bool>( "OVERMAP_PLACE_RAILROADS" ) ) {
-            place_railroads( north, east, south, west );
-        }
-        if( get_option<bool>( "OVERMAP_PLACE_ROADS" ) ) {
-            place_roads( north, east, south, west );
-        }
-    } else {
-        if( get_option<bool>( "OVERMAP_PLACE_ROADS" ) ) {
-            place_roads( north, east, south, west );
+        case 1:
+            if( get_option<bool>( "OVERMAP_PLACE_RIVERS" ) ) {
+                place_rivers( north, east, south, west );
+            }
+            break;
+        case 2:
+            if( get_option<bool>( "OVERMAP_PLACE_LAKES" ) ) {
+                place_lakes();
+            }
+            break;
+        case 3:
+            if( get_option<bool>( "OVERMAP_PLACE_OCEANS" ) ) {
+                place_oceans();
+            }
+            break;
+        case 4:
+            if( get_option<bool>( "OVERMAP_PLACE_FORESTS" ) ) {
+                place_forests();
+            }
+            break;
+        case 5:
+            if( get_option<bool>( "OVERMAP_PLACE_SWAMPS" ) ) {
+                place_swamps();
+            }
+            if( get_option<bool>( "OVERMAP_PLACE_RAVINES" ) ) {
+                place_ravines();
+            }
+            break;
+        case 6:
+            if( get_option<bool>( "OVERMAP_PLACE_CITIES" ) ) {
+                place_cities();
+            }
+            break;
+        case 7:
+            if( get_option<bool>( "OVERMAP_PLACE_FOREST_TRAILS" ) ) {
+                place_forest_trails();
+            }
+            if( get_option<bool>( "OVERMAP_PLACE_RAILROADS_BEFORE_ROADS" ) ) {
+                if( get_option<bool>( "OVERMAP_PLACE_RAILROADS" ) ) {
+                    place_railroads( north, east, south, west );
+                }
+                if( get_option<bool>( "OVERMAP_PLACE_ROADS" ) ) {
+                    place_roads( north, east, south, west );
+                }
+            } else {
+                if( get_option<bool>( "OVERMAP_PLACE_ROADS" ) ) {
+                    place_roads( north, east, south, west );
+                }
+                if( get_option<bool>( "OVERMAP_PLACE_RAILROADS" ) ) {
+                    place_railroads( north, east, south, west );
+                }
+            }
+            break;
+        case 8:
+            if( get_option<bool>( "OVERMAP_PLACE_SPECIALS" ) ) {
+                place_specials( state.specials );
+            }
+            break;
+        case 9:
+            if( get_option<bool>( "OVERMAP_PLACE_FOREST_TRAILHEADS" ) ) {
+                place_forest_trailheads();
+            }
+
+            polish_river();
+            break;
+        case 10: {
+            // TODO: there is no reason we can't generate the sublevels in one pass
+            //       for that matter there is no reason we can't as we add the entrance ways either
+
+            // Always need at least one sublevel, but how many more
+            int z = -1;
+            bool requires_sub = false;
+            do {
+                requires_sub = generate_sub( z );
+            } while( requires_sub && ( --z >= -OVERMAP_DEPTH ) );
+            break;
         }
-        if( get_option<bool>( "OVERMAP_PLACE_RAILROADS" ) ) {
-            place_railroads( north, east, south, west );
+        case 11: {
+            // Always need at least one overlevel, but how many more
+            int z = 1;
+            bool requires_over = false;
+            do {
+                requires_over = generate_over( z );
+            } while( requires_over && ( ++z <= OVERMAP_HEIGHT ) );
+            break;
         }
+        default:
+            // Place the monsters, now that the terrain is laid out
+            place_mongroups();
+            place_radios();
+            water_noise.reset();
+            renew_terrain_stamp();
+            dbg( D_INFO ) << "overmap::generate done";
+            return true;
     }
-    if( get_option<bool>( "OVERMAP_PLACE_SPECIALS" ) ) {
-        place_specials( enabled_specials );
-    }
-    if( get_option<bool>( "OVERMAP_PLACE_FOREST_TRAILHEADS" ) ) {
-        place_forest_trailheads();
-    }
-
-    polish_river();
-
-    // TODO: there is no reason we can't generate the sublevels in one pass
-    //       for that matter there is no reason we can't as we add the entrance ways either
-
-    // Always need at least one sublevel, but how many more
-    int z = -1;
-    bool requires_sub = false;
-    do {
-        requires_sub = generate_sub( z );
-    } while( requires_sub && ( --z >= -OVERMAP_DEPTH ) );
-
-    // Always need at least one overlevel, but how many more
-    z = 1;
-    bool requires_over = false;
-    do {
-        requires_over = generate_over( z );
-    } while( requires_over && ( ++z <= OVERMAP_HEIGHT ) );
-
-    // Place the monsters, now that the terrain is laid out
-    place_mongroups();
-    place_radios();
-    dbg( D_INFO ) << "overmap::generate done";
+    return false;
 }
 
 bool overmap::generate_sub( const int z )
@@ -4468,15 +4645,16 @@ void overmap::move_hordes()
                 mg.abs_pos.y()++;
             }
 
-            // Erase the group at it's old location, add the group with the new location
-            tmpzg.emplace( mg.rel_pos(), mg );
-            zg.erase( it++ );
+            // Move the group to its new location, without copying its monsters.
+            auto node = zg.extract( it++ );
+            node.key() = node.mapped().rel_pos();
+            tmpzg.insert( std::move( node ) );
         } else {
             ++it;
         }
     }
     // and now back into the monster group map.
-    zg.insert( tmpzg.begin(), tmpzg.end() );
+    zg.merge( tmpzg );
 
     if( get_option<bool>( "WANDER_SPAWNS" ) ) {
 
@@ -4655,18 +4833,17 @@ void overmap::signal_hordes( const tripoint_rel_sm &p_rel, const int sig_power )
 {
     tripoint_om_sm p( p_rel.raw() );
     tripoint_abs_sm absp = project_combine( pos(), p );
-    for( auto &elem : zg ) {
-        mongroup &mg = elem.second;
+    const auto signal_group = [&]( mongroup & mg ) {
         if( !mg.horde ) {
-            continue;
+            return;
         }
         const int dist = rl_dist( absp, mg.abs_pos );
         if( sig_power < dist ) {
-            continue;
+            return;
         }
         if( mg.behaviour == mongroup::horde_behaviour::nemesis ) {
             // nemesis hordes are signaled to the player by their own function and dont react to noise
-            continue;
+            return;
         }
         // TODO: base this in monster attributes, foremost GOODHEARING.
         const int inter_per_sig_power = 15; //Interest per signal value
@@ -4691,6 +4868,32 @@ void overmap::signal_hordes( const tripoint_rel_sm &p_rel, const int sig_power )
                 add_msg_debug( debugmode::DF_OVERMAP, "horde set interest %d dist %d", min_capped_inter, dist );
             }
         }
+    };
+
+    // The groups are keyed by their position in the overmap, x first, so only the keys in the
+    // columns within sig_power of the signal can hear it.  Groups that walked off the overmap
+    // are keyed by their position wrapped into it, so the columns wrap around as well.  The
+    // ranges are visited in key order, the rolls come out the same as when visiting every group.
+    constexpr int om_width = OMAPX * 2;
+    const auto signal_columns = [&]( int first, int last ) {
+        const auto end = zg.lower_bound( tripoint_om_sm( last + 1, INT_MIN, INT_MIN ) );
+        for( auto it = zg.lower_bound( tripoint_om_sm( first, INT_MIN, INT_MIN ) ); it != end; ++it ) {
+            signal_group( it->second );
+        }
+    };
+    if( 2 * sig_power + 1 >= om_width ) {
+        for( auto &elem : zg ) {
+            signal_group( elem.second );
+        }
+        return;
+    }
+    const int first = modulo( absp.x() - sig_power, om_width );
+    const int last = modulo( absp.x() + sig_power, om_width );
+    if( first <= last ) {
+        signal_columns( first, last );
+    } else {
+        signal_columns( 0, last );
+        signal_columns( first, om_width - 1 );
     }
 }
 
@@ -4932,7 +5135,8 @@ void overmap::place_forest_trailheads()
 void overmap::place_forests()
 {
     const oter_id default_oter_id( settings->default_oter[OVERMAP_DEPTH] );
-    const om_noise::om_noise_layer_forest f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid f( std::make_unique<om_noise::om_noise_layer_forest>
+                                     ( global_base_point(), g->get_seed() ), 0 );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -4958,9 +5162,20 @@ void overmap::place_forests()
 }
 
 
+const om_noise::om_noise_grid &overmap::get_water_noise()
+{
+    if( !water_noise ) {
+        // Lake and ocean noise are the same, so they can share the grid.  The flood fills of both
+        // look up to 4 OMTs past the edges of the overmap.
+        water_noise = std::make_shared<const om_noise::om_noise_grid>(
+                          std::make_unique<om_noise::om_noise_layer_lake>( global_base_point(), g->get_seed() ), 5 );
+    }
+    return *water_noise;
+}
+
 void overmap::place_lakes()
 {
-    const om_noise::om_noise_layer_lake f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid &f = get_water_noise();
 
     const auto is_lake = [&]( const point_om_omt & p ) {
         // credit to ehughsbaird for thinking up this inbounds solution to infinite flood fill lag.
@@ -5137,7 +5352,7 @@ void overmap::place_oceans()
     int western_ocean = settings->overmap_ocean.ocean_start_west;
     int southern_ocean = settings->overmap_ocean.ocean_start_south;
 
-    const om_noise::om_noise_layer_ocean f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid &f = get_water_noise();
     const point_abs_om this_om = pos();
 
     const auto is_ocean = [&]( const point_om_omt & p ) {
@@ -5455,7 +5670,8 @@ void overmap::place_swamps()
     }
 
     // Get a layer of noise to use in conjunction with our river buffered floodplain.
-    const om_noise::om_noise_layer_floodplain f( global_base_point(), g->get_seed() );
+    const om_noise::om_noise_grid f( std::make_unique<om_noise::om_noise_layer_floodplain>
+                                     ( global_base_point(), g->get_seed() ), 0 );
 
     for( int x = 0; x < OMAPX; x++ ) {
         for( int y = 0; y < OMAPY; y++ ) {
@@ -6991,6 +7207,35 @@ bool overmap::can_place_special( const overmap_special &special, const tripoint_
         return false;
     }
 
+    // The terrain is the cheapest to check and rules out the most positions, so it goes first.
+    const std::vector<overmap_special_locations> &fixed_terrains = special.required_locations();
+    const bool terrain_fits = std::all_of( fixed_terrains.begin(), fixed_terrains.end(),
+    [&]( const overmap_special_locations & elem ) {
+        const tripoint_om_omt rp = p + om_direction::rotate( elem.p, dir );
+
+        if( !inbounds( rp, 1 ) ) {
+            return false;
+        }
+
+        if( must_be_unexplored ) {
+            // If this must be unexplored, check if we've already got a submap generated.
+            const bool existing_submap = is_omt_generated( rp );
+
+            // If there is an existing submap, this area has already been explored and this
+            // isn't a valid placement.
+            if( existing_submap ) {
+                return false;
+            }
+        }
+
+        const oter_id &tid = ter( rp );
+
+        return elem.can_be_placed_on( tid ) || ( rp.z() != 0 && tid == get_default_terrain( rp.z() ) );
+    } );
+    if( !terrain_fits ) {
+        return false;
+    }
+
     if( special.has_eoc() ) {
         dialogue d( get_talker_for( get_avatar() ), nullptr );
         if( !special.get_eoc()->test_condition( d ) ) {
@@ -7018,31 +7263,7 @@ bool overmap::can_place_special( const overmap_special &special, const tripoint_
         }
     }
 
-    const std::vector<overmap_special_locations> fixed_terrains = special.required_locations();
-
-    return std::all_of( fixed_terrains.begin(), fixed_terrains.end(),
-    [&]( const overmap_special_locations & elem ) {
-        const tripoint_om_omt rp = p + om_direction::rotate( elem.p, dir );
-
-        if( !inbounds( rp, 1 ) ) {
-            return false;
-        }
-
-        if( must_be_unexplored ) {
-            // If this must be unexplored, check if we've already got a submap generated.
-            const bool existing_submap = is_omt_generated( rp );
-
-            // If there is an existing submap, this area has already been explored and this
-            // isn't a valid placement.
-            if( existing_submap ) {
-                return false;
-            }
-        }
-
-        const oter_id &tid = ter( rp );
-
-        return elem.can_be_placed_on( tid ) || ( rp.z() != 0 && tid == get_default_terrain( rp.z() ) );
-    } );
+    return true;
 }
 
 // checks around the selected point to see if the special can be placed there
@@ -7145,17 +7366,26 @@ bool overmap::place_special_attempt(
             if( !place_optional && iter->instances_placed >= constraints.occurrences.min ) {
                 continue;
             }
+            overmap_special_placement_stats &stats = overmap_specials::placement_stats()[special.id];
+            const auto start = std::chrono::steady_clock::now();
+            ++stats.attempts;
             // City check is the fastest => it goes first.
             if( !special.can_belong_to_city( p, nearest_city, *this ) ) {
+                ++stats.rejected_city;
+                stats.time += std::chrono::steady_clock::now() - start;
                 continue;
             }
             // See if we can actually place the special there.
             const om_direction::type rotation = random_special_rotation( special, p, must_be_unexplored );
             if( rotation == om_direction::type::invalid ) {
+                ++stats.rejected_terrain;
+                stats.time += std::chrono::steady_clock::now() - start;
                 continue;
             }
 
             place_special( special, p, rotation, nearest_city, false, must_be_unexplored );
+            ++stats.placed;
+            stats.time += std::chrono::steady_clock::now() - start;
 
             if( ++iter->instances_placed >= constraints.occurrences.max ) {
                 enabled_specials.erase( iter );
@@ -7517,7 +7747,7 @@ void overmap::place_mongroups()
     }
     if( get_option<bool>( "OVERMAP_PLACE_OCEANS" ) ) {
         // Now place ocean mongroup. Weights may need to be altered.
-        const om_noise::om_noise_layer_ocean f( global_base_point(), g->get_seed() );
+        const om_noise::om_noise_grid &f = get_water_noise();
         const point_abs_om this_om = pos();
         const int northern_ocean = settings->overmap_ocean.ocean_start_north;
         const int eastern_ocean = settings->overmap_ocean.ocean_start_east;
@@ -7629,43 +7859,83 @@ void overmap::place_radios()
     }
 }
 
+overmap_file_digest::overmap_file_digest( const cata_path &file, const std::string &contents ) :
+    path( file.generic_u8string() ), size( contents.size() ),
+    hash( std::hash<std::string>()( contents ) )
+{
+}
+
+// Serializes to memory first, a file that already holds the same data is left alone.
+static void collect_if_changed( const cata_path &path, overmap_file_digest &digest,
+                                const std::function<void( std::ostream & )> &writer,
+                                std::vector<overmap_file_write> &files )
+{
+    std::ostringstream buffer;
+    writer( buffer );
+    std::string contents = buffer.str();
+    if( overmap_file_digest( path, contents ) == digest && file_exist( path ) ) {
+        return;
+    }
+    files.push_back( { path, std::move( contents ), &digest } );
+}
+
 void overmap::open( overmap_special_batch &enabled_specials )
 {
     const cata_path terfilename = overmapbuffer::terrain_filename( loc );
 
     if( read_from_file_optional( terfilename, [this, &terfilename]( std::istream & is ) {
-    unserialize( terfilename, is );
+    const std::string contents( std::istreambuf_iterator<char>( is ), {} );
+    std::istringstream header( contents );
+    unserialize( terfilename, header );
+    terrain_digest = overmap_file_digest( terfilename, contents );
     } ) ) {
         const cata_path plrfilename = overmapbuffer::player_filename( loc );
         read_from_file_optional( plrfilename, [this, &plrfilename]( std::istream & is ) {
-            unserialize_view( plrfilename, is );
+            const std::string contents( std::istreambuf_iterator<char>( is ), {} );
+            std::istringstream header( contents );
+            unserialize_view( plrfilename, header );
+            view_digest = overmap_file_digest( plrfilename, contents );
         } );
     } else { // No map exists!  Prepare neighbors, and generate one.
-        std::vector<const overmap *> pointers;
-        // Fetch south and north
-        for( int i = -1; i <= 1; i += 2 ) {
-            pointers.push_back( overmap_buffer.get_existing( loc + point( 0, i ) ) );
-        }
-        // Fetch east and west
-        for( int i = -1; i <= 1; i += 2 ) {
-            pointers.push_back( overmap_buffer.get_existing( loc + point( i, 0 ) ) );
+        overmap_generation_state state = begin_generation( enabled_specials );
+        while( !generate_stage( state ) ) {
         }
-
-        // pointers looks like (north, south, west, east)
-        generate( pointers[0], pointers[3], pointers[1], pointers[2], enabled_specials );
+        // The specials placed here count for the overmaps the batch is handed on to.
+        enabled_specials = state.specials;
     }
 }
 
 // Note: this may throw io errors from std::ofstream
 void overmap::save() const
 {
-    write_to_file( overmapbuffer::player_filename( loc ), [&]( std::ostream & stream ) {
+    std::vector<overmap_file_write> files;
+    collect_changed_files( files );
+    const int compression_level = get_option<int>( "SAVE_COMPRESSION" );
+    for( const overmap_file_write &file : files ) {
+        write_file( file, compression_level );
+    }
+}
+
+void overmap::collect_changed_files( std::vector<overmap_file_write> &files ) const
+{
+    collect_if_changed( overmapbuffer::player_filename( loc ), view_digest,
+    [&]( std::ostream & stream ) {
         serialize_view( stream );
-    } );
+    }, files );
 
-    write_to_file( overmapbuffer::terrain_filename( loc ), [&]( std::ostream & stream ) {
+    collect_if_changed( overmapbuffer::terrain_filename( loc ), terrain_digest,
+    [&]( std::ostream & stream ) {
         serialize( stream );
+    }, files );
+}
+
+void overmap::write_file( const overmap_file_write &file, const int compression_level )
+{
+    write_to_file_compressed( file.path, compression_level, [&]( std::ostream & stream ) {
+        stream << file.contents;
     } );
+    // Only a completed write may skip the next save of the same data.
+    *file.digest = overmap_file_digest( file.path, file.contents );
 }
 
 void overmap::spawn_mon_group( const mongroup &group, int radius )
@@ -7764,6 +8034,7 @@ void overmap::add_mon_group( const mongroup &group, int radius )
 
 shared_ptr_fast<npc> overmap::find_npc( const character_id &id ) const
 {
+    load_npcs();
     for( const auto &guy : npcs ) {
         if( guy->getID() == id ) {
             return guy;
@@ -7774,6 +8045,7 @@ shared_ptr_fast<npc> overmap::find_npc( const character_id &id ) const
 
 shared_ptr_fast<npc> overmap::find_npc_by_unique_id( const std::string &id ) const
 {
+    load_npcs();
     for( const auto &guy : npcs ) {
         if( guy->get_unique_id() == id ) {
             return guy;
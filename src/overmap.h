@@ -5,19 +5,23 @@
 #include <algorithm>
 #include <array>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <iosfwd>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
 #include "basecamp.h"
+#include "cata_path.h"
 #include "city.h"
 #include "coords_fwd.h"
 #include "cube_direction.h"
@@ -35,12 +39,16 @@
 class JsonArray;
 class JsonObject;
 class JsonOut;
-class cata_path;
 class character_id;
 class npc;
 class overmap_connection;
 struct regional_settings;
 
+namespace om_noise
+{
+class om_noise_grid;
+} // namespace om_noise
+
 namespace pf
 {
 template<typename Point>
@@ -117,6 +125,16 @@ struct map_layer {
     std::vector<om_map_extra> extras;
 };
 
+/** The OMTs of one layer grouped by terrain, see @ref overmap::find_terrain_positions. */
+struct terrain_index_layer {
+    // Layer stamp of the terrain the index was made from.
+    int stamp = -1;
+    // Every OMT of the layer, as x + y * OMAPX, those of the same terrain next to each other.
+    std::vector<uint16_t> cells;
+    // Each terrain with the end of its run of cells, which starts where the previous one ends.
+    std::vector<std::pair<oter_id, uint16_t>> terrains;
+};
+
 struct om_special_sectors {
     std::vector<point_om_omt> sectors;
     int sector_width;
@@ -173,6 +191,45 @@ class overmap_special_batch
         point_abs_om origin_overmap;
 };
 
+/**
+ * Progress of generating a new overmap, see @ref overmap::generate_stage.
+ * The neighbours are the ones that existed when the generation started.
+ */
+/** What an overmap file held when it was last read or written. */
+struct overmap_file_digest {
+    std::string path;
+    size_t size = 0;
+    size_t hash = 0;
+
+    overmap_file_digest() = default;
+    overmap_file_digest( const cata_path &file, const std::string &contents );
+
+    bool operator==( const overmap_file_digest &rhs ) const {
+        return size == rhs.size && hash == rhs.hash && path == rhs.path;
+    }
+};
+
+/** A serialized overmap file that differs from the copy on disk. */
+struct overmap_file_write {
+    cata_path path;
+    std::string contents;
+    overmap_file_digest *digest = nullptr;
+};
+
+struct overmap_generation_state {
+    explicit overmap_generation_state( const overmap_special_batch &specials ) :
+        specials( specials ) {}
+
+    const overmap *north = nullptr;
+    const overmap *east = nullptr;
+    const overmap *south = nullptr;
+    const overmap *west = nullptr;
+    overmap_special_batch specials;
+    int stage = 0;
+    // Each stage draws from this, so spreading the stages over turns doesn't change the result.
+    std::optional<cata_default_random_engine> rng_engine;
+};
+
 template<typename Tripoint>
 struct pos_dir {
     Tripoint p;
@@ -217,6 +274,16 @@ class overmap
          **/
         void populate( overmap_special_batch &enabled_specials );
         void populate();
+        /** The default specials of this overmap, filtered by the feature flags of its region. */
+        overmap_special_batch get_enabled_specials() const;
+
+        /**
+         * Starts generating this overmap from scratch, against the neighbours that exist now.
+         * Run @ref generate_stage until it returns true to complete it.
+         */
+        overmap_generation_state begin_generation( const overmap_special_batch &enabled_specials ) const;
+        /** Runs the next stage of the generation, returns true once the overmap is complete. */
+        bool generate_stage( overmap_generation_state &state );
 
         const point_abs_om &pos() const {
             return loc;
@@ -226,6 +293,14 @@ class overmap
         }
 
         void save() const;
+        /** Serializes both files of this overmap, adding those that changed to @p files. */
+        void collect_changed_files( std::vector<overmap_file_write> &files ) const;
+        /**
+         * Writes @p file, gzip compressed at @p compression_level (0 for none), and records
+         * its digest.  Touches nothing but the file and the digest, so it may run on a
+         * worker thread.  May throw on io errors.
+         */
+        static void write_file( const overmap_file_write &file, int compression_level );
 
         /**
          * @return The (local) overmap terrain coordinates of a randomly
@@ -248,6 +323,27 @@ class overmap
         std::vector<point_abs_omt> find_terrain( std::string_view term, int zlevel ) const;
 
         void ter_set( const tripoint_om_omt &p, const oter_id &id );
+        /**
+         * Changes whenever the terrain may have changed and is never shared by two overmaps with
+         * different terrain, so data derived from the terrain can tell when it is out of date.
+         */
+        int get_terrain_stamp() const {
+            return terrain_stamp;
+        }
+        /**
+         * Like @ref get_terrain_stamp, but also changes whenever the vision level or explored
+         * state of a tile changes, for data derived from what the player knows of the terrain.
+         */
+        int get_display_stamp() const {
+            return display_stamp;
+        }
+        /**
+         * Adds every OMT on layer @p z whose terrain passes @p match to @p out.  The OMTs are
+         * grouped by terrain the first time after the layer changed, so @p match is only called
+         * once per terrain.
+         */
+        void find_terrain_positions( int z, const std::function<bool( const oter_id & )> &match,
+                                     std::vector<tripoint_om_omt> &out ) const;
         // ter has bounds checking, and returns ot_null when out of bounds.
         const oter_id &ter( const tripoint_om_omt &p ) const;
         // ter_unsafe is UB when out of bounds.
@@ -257,6 +353,13 @@ class overmap
         std::vector<oter_id> predecessors( const tripoint_om_omt & );
         void set_seen( const tripoint_om_omt &p, om_vision_level val, bool force = false );
         om_vision_level seen( const tripoint_om_omt &p ) const;
+        /**
+         * Fully reveals the @p length OMTs from @p start east, skipping those whose terrain
+         * @p filter rejects.  The span must lie within the overmap.
+         * @return true if any OMT was revealed.
+         */
+        bool reveal_span( const tripoint_om_omt &start, int length,
+                          const std::function<bool( const oter_id & )> &filter );
         bool seen_more_than( const tripoint_om_omt &p, om_vision_level test ) const;
         bool &explored( const tripoint_om_omt &p );
         bool is_explored( const tripoint_om_omt &p ) const;
@@ -371,16 +474,33 @@ class overmap
         shared_ptr_fast<npc> find_npc( const character_id &id ) const;
         shared_ptr_fast<npc> find_npc_by_unique_id( const std::string &id ) const;
         const std::vector<shared_ptr_fast<npc>> &get_npcs() const {
+            load_npcs();
             return npcs;
         }
         std::vector<shared_ptr_fast<npc>> get_npcs( const std::function<bool( const npc & )>
                                        &predicate )
                                        const;
         point_om_omt get_fallback_road_connection_point() const;
+        /// Whether the npcs of this overmap are still waiting in @ref unloaded_npcs.
+        bool has_unloaded_npcs() const {
+            return !unloaded_npcs.empty();
+        }
     private:
         friend class overmapbuffer;
 
-        std::vector<shared_ptr_fast<npc>> npcs;
+        /// Deserializes the npcs deferred by @ref unserialize, if any.
+        void load_npcs() const;
+        void load_npc( const JsonObject &npc_json ) const;
+        /// Registers the faction memberships of the npcs in @p summaries_json, unless one of
+        /// them isn't on this overmap.  Returns whether the npcs can be deferred.
+        bool load_npc_summaries( const JsonArray &summaries_json, size_t npc_count ) const;
+
+        mutable std::vector<shared_ptr_fast<npc>> npcs;
+        // The serialized "npcs" and "npc_summaries" of a loaded overmap whose npcs weren't
+        // needed yet.  Most overmaps never come near the player, so their npcs are only
+        // deserialized on first access and otherwise saved back as they were.
+        mutable std::string unloaded_npcs; // NOLINT(cata-serialize)
+        mutable std::string unloaded_npc_summaries; // NOLINT(cata-serialize)
 
         // A fake boolean that's returned for out-of-bounds calls to
         // overmap::seen and overmap::explored
@@ -388,6 +508,21 @@ class overmap
         point_abs_om loc; // NOLINT(cata-serialize)
         // Random point used for special connections if there's no cities on the overmap, joins to all roads_out
         std::optional<point_om_omt> fallback_road_connection_point; // NOLINT(cata-serialize)
+        int terrain_stamp = 0; // NOLINT(cata-serialize)
+        int display_stamp = 0; // NOLINT(cata-serialize)
+        // Like terrain_stamp, but only renewed by changes to that layer.
+        std::array<int, OVERMAP_LAYERS> layer_stamps = {}; // NOLINT(cata-serialize)
+        mutable std::array<terrain_index_layer, OVERMAP_LAYERS> terrain_index; // NOLINT(cata-serialize)
+        // Set by overmapbuffer when it hands out this overmap.
+        int64_t last_used = 0; // NOLINT(cata-serialize)
+        // Lets save() leave the files alone when their contents wouldn't change.
+        mutable overmap_file_digest terrain_digest; // NOLINT(cata-serialize)
+        mutable overmap_file_digest view_digest; // NOLINT(cata-serialize)
+        // Lake and ocean noise, shared by the generation steps and dropped when generation is done.
+        std::shared_ptr<const om_noise::om_noise_grid> water_noise; // NOLINT(cata-serialize)
+        void renew_terrain_stamp();
+        void renew_layer_stamp( int z );
+        void renew_display_stamp();
 
         std::array<map_layer, OVERMAP_LAYERS> layer;
         std::unordered_map<tripoint_abs_omt, scent_trace> scents;
@@ -445,9 +580,6 @@ class overmap
         // Save per-player overmap view data.
         void serialize_view( std::ostream &fout ) const;
     private:
-        void generate( const overmap *north, const overmap *east,
-                       const overmap *south, const overmap *west,
-                       overmap_special_batch &enabled_specials );
         bool generate_sub( int z );
         bool generate_over( int z );
         // Check and put bridgeheads
@@ -458,7 +590,6 @@ class overmap
 
         const city &get_nearest_city( const tripoint_om_omt &p ) const;
 
-        void signal_hordes( const tripoint_rel_sm &p, int sig_power );
         void process_mongroups();
         void move_hordes();
 
@@ -470,6 +601,7 @@ class overmap
 
         // code deduplication - calc ocean gradient
         float calculate_ocean_gradient( const point_om_omt &p, point_abs_om this_omt );
+        const om_noise::om_noise_grid &get_water_noise();
         // Overall terrain
         void place_river( const point_om_omt &pa, const point_om_omt &pb );
         void place_forests();
@@ -555,6 +687,9 @@ class overmap
             const overmap_special &special, const tripoint_om_omt &p, om_direction::type dir,
             const city &cit, bool must_be_unexplored, bool force );
 
+        /** Hordes within @p sig_power of @p p, relative to this overmap, may head for it. */
+        void signal_hordes( const tripoint_rel_sm &p, int sig_power );
+
         // DEBUG ONLY!
         void debug_force_add_group( const mongroup &group );
         std::vector<std::reference_wrapper<mongroup>> debug_unsafe_get_groups_at( tripoint_abs_omt &loc );
@@ -618,6 +753,8 @@ struct oter_display_lru {
     std::pair<std::string, nc_color> get_symbol_and_color( const oter_id &cur_ter, om_vision_level );
 };
 
+struct oter_display_cache_layer;
+
 // "arguments" to oter_symbol_and_color that do not change between calls in a batch
 struct oter_display_options {
     struct npc_coloring {
@@ -667,6 +804,11 @@ struct oter_display_options {
 
     // Internal bookkeeping value - only draw edge mission indicator once
     mutable bool drawn_mission = false;
+    // Internal bookkeeping values - layers of the terrain display cache that were checked to be
+    // up to date during this batch, and the one used last
+    mutable std::unordered_set<tripoint> checked_display_layers;
+    mutable tripoint last_display_layer_pos = tripoint_min;
+    mutable oter_display_cache_layer *last_display_layer = nullptr;
 };
 
 // arguments for oter_symbol_and_color pertaining to a single point
@@ -0,0 +1,351 @@
+#include "overmap_connectivity.h"
+
+#include <array>
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <queue>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "coordinates.h"
+#include "game_constants.h"
+#include "hash_utils.h"
+#include "omdata.h"
+#include "overmap.h"
+#include "overmapbuffer.h"
+#include "point.h"
+
+static const oter_type_str_id oter_type_bridgehead_ground( "bridgehead_ground" );
+static const oter_type_str_id oter_type_bridgehead_ramp( "bridgehead_ramp" );
+
+namespace overmap_connectivity
+{
+
+namespace
+{
+
+constexpr size_t num_travel_types = static_cast<size_t>( oter_travel_cost_type::last );
+// Labels fit in 16 bits, a layer has at most OMAPX * OMAPY / 2 regions.
+constexpr uint16_t impassable = 0;
+constexpr uint16_t unlabelled = UINT16_MAX;
+// Above these a query gives up and lets the A* search decide.
+constexpr int max_layers_per_query = 96;
+constexpr size_t max_cached_layers = 256;
+// Orthogonal directions first, travel without diagonals only uses those.
+constexpr std::array<point, 8> travel_dirs = { {
+        point_north, point_east, point_south, point_west,
+        point_north_east, point_south_east, point_south_west, point_north_west
+    }
+};
+
+/** Which travel cost types can be entered, the part of @ref overmap_path_params the regions depend on. */
+struct travel_class {
+    std::bitset<num_travel_types> passable;
+    bool diagonal = false;
+
+    bool operator==( const travel_class &rhs ) const {
+        return passable == rhs.passable && diagonal == rhs.diagonal;
+    }
+};
+
+travel_class classify( const overmap_path_params &params )
+{
+    travel_class result;
+    for( size_t i = 0; i < num_travel_types; ++i ) {
+        result.passable[i] = params.get_cost( static_cast<oter_travel_cost_type>( i ) ) >= 0;
+    }
+    result.diagonal = params.allow_diagonal;
+    return result;
+}
+
+bool is_ramp( const oter_id &oter )
+{
+    return oter->get_type_id() == oter_type_bridgehead_ground ||
+           oter->get_type_id() == oter_type_bridgehead_ramp;
+}
+
+int index_of( const point &local )
+{
+    return local.x + local.y * OMAPX;
+}
+
+/** Region labels of one layer of one overmap. */
+struct layer_regions {
+    // Terrain stamp of the overmap the labels were made from, 0 for an overmap that doesn't exist.
+    int stamp = -1;
+    std::array<uint16_t, OMAPX * OMAPY> label;
+    // Passable ramps, where travel may go up or down a layer.
+    std::vector<point> ramps;
+};
+
+struct layer_key {
+    point om;
+    int z = 0;
+    travel_class cls;
+
+    bool operator==( const layer_key &rhs ) const {
+        return om == rhs.om && z == rhs.z && cls == rhs.cls;
+    }
+};
+
+struct layer_key_hash {
+    size_t operator()( const layer_key &k ) const {
+        size_t seed = 0;
+        cata::hash_combine( seed, k.om );
+        cata::hash_combine( seed, k.z );
+        cata::hash_combine( seed, k.cls.passable );
+        cata::hash_combine( seed, k.cls.diagonal );
+        return seed;
+    }
+};
+
+std::unordered_map<layer_key, layer_regions, layer_key_hash> &cached_layers()
+{
+    static std::unordered_map<layer_key, layer_regions, layer_key_hash> layers;
+    return layers;
+}
+
+void label_layer( layer_regions &out, const overmap *om, int z, const travel_class &cls )
+{
+    const auto passable = [&]( const oter_id & oter ) {
+        return cls.passable[static_cast<size_t>( oter->get_travel_cost_type() )];
+    };
+    out.ramps.clear();
+    if( om == nullptr ) {
+        // Travel through overmaps that were never generated sees ot_null everywhere.
+        out.label.fill( passable( oter_id() ) ? 1 : impassable );
+        return;
+    }
+    for( int y = 0; y < OMAPY; ++y ) {
+        for( int x = 0; x < OMAPX; ++x ) {
+            const oter_id &oter = om->ter_unsafe( tripoint_om_omt( x, y, z ) );
+            const bool can_enter = passable( oter );
+            out.label[index_of( point( x, y ) )] = can_enter ? unlabelled : impassable;
+            if( can_enter && is_ramp( oter ) ) {
+                out.ramps.emplace_back( x, y );
+            }
+        }
+    }
+
+    const int num_dirs = cls.diagonal ? 8 : 4;
+    uint16_t next_label = 0;
+    std::vector<point> stack;
+    for( int start = 0; start < OMAPX * OMAPY; ++start ) {
+        if( out.label[start] != unlabelled ) {
+            continue;
+        }
+        ++next_label;
+        out.label[start] = next_label;
+        stack.emplace_back( start % OMAPX, start / OMAPX );
+        while( !stack.empty() ) {
+            const point cur = stack.back();
+            stack.pop_back();
+            for( int i = 0; i < num_dirs; ++i ) {
+                const point next = cur + travel_dirs[i];
+                if( next.x < 0 || next.y < 0 || next.x >= OMAPX || next.y >= OMAPY ) {
+                    continue;
+                }
+                uint16_t &next_label_ref = out.label[index_of( next )];
+                if( next_label_ref == unlabelled ) {
+                    next_label_ref = next_label;
+                    stack.push_back( next );
+                }
+            }
+        }
+    }
+}
+
+struct region {
+    point om;
+    int z = 0;
+    uint16_t label = impassable;
+
+    bool operator==( const region &rhs ) const {
+        return om == rhs.om && z == rhs.z && label == rhs.label;
+    }
+};
+
+struct region_hash {
+    size_t operator()( const region &r ) const {
+        size_t seed = 0;
+        cata::hash_combine( seed, r.om );
+        cata::hash_combine( seed, r.z );
+        cata::hash_combine( seed, r.label );
+        return seed;
+    }
+};
+
+/** The regions of the overmaps within the search area of one query. */
+class region_graph
+{
+    public:
+        region_graph( const overmap_path_params &params, const tripoint_abs_omt &src, int radius ) :
+            cls( classify( params ) ) {
+            const point_abs_omt lo = src.xy() - point( radius, radius );
+            const point_abs_omt hi = src.xy() + point( radius, radius );
+            min_om = project_to<coords::om>( lo ).raw();
+            max_om = project_to<coords::om>( hi ).raw();
+        }
+
+        bool in_area( const point &om ) const {
+            return om.x >= min_om.x && om.y >= min_om.y && om.x <= max_om.x && om.y <= max_om.y;
+        }
+        bool over_budget() const {
+            return layers_labelled > max_layers_per_query;
+        }
+
+        const layer_regions &layer( const point &om, int z ) {
+            layer_regions &result = cached_layers()[layer_key{ om, z, cls }];
+            const overmap *existing = overmap_buffer.get_existing( point_abs_om( om ) );
+            const int stamp = existing == nullptr ? 0 : existing->get_terrain_stamp();
+            if( result.stamp != stamp ) {
+                label_layer( result, existing, z, cls );
+                result.stamp = stamp;
+                ++layers_labelled;
+            }
+            return result;
+        }
+
+        /** Region of @p p, or nullopt if it can't be entered. */
+        std::optional<region> region_at( const tripoint_abs_omt &p ) {
+            point_abs_om om;
+            tripoint_om_omt local;
+            std::tie( om, local ) = project_remain<coords::om>( p );
+            if( !in_area( om.raw() ) ) {
+                return std::nullopt;
+            }
+            const uint16_t label = layer( om.raw(), p.z() ).label[index_of( local.raw().xy() )];
+            if( label == impassable ) {
+                return std::nullopt;
+            }
+            return region{ om.raw(), p.z(), label };
+        }
+
+        void neighbours( const region &r, std::vector<region> &out ) {
+            const layer_regions &here = layer( r.om, r.z );
+
+            // Across the borders of the overmap.
+            std::array<std::array<const layer_regions *, 3>, 3> adjacent{};
+            const int num_dirs = cls.diagonal ? 8 : 4;
+            const auto visit_border = [&]( const point & local ) {
+                if( here.label[index_of( local )] != r.label ) {
+                    return;
+                }
+                for( int i = 0; i < num_dirs; ++i ) {
+                    const point next = local + travel_dirs[i];
+                    const point offset( next.x < 0 ? -1 : next.x >= OMAPX ? 1 : 0,
+                                        next.y < 0 ? -1 : next.y >= OMAPY ? 1 : 0 );
+                    if( offset == point_zero || !in_area( r.om + offset ) ) {
+                        continue;
+                    }
+                    const layer_regions *&other = adjacent[offset.x + 1][offset.y + 1];
+                    if( other == nullptr ) {
+                        other = &layer( r.om + offset, r.z );
+                    }
+                    const point other_local = next - point( offset.x * OMAPX, offset.y * OMAPY );
+                    const uint16_t label = other->label[index_of( other_local )];
+                    if( label != impassable ) {
+                        out.push_back( region{ r.om + offset, r.z, label } );
+                    }
+                }
+            };
+            for( int i = 0; i < OMAPX; ++i ) {
+                visit_border( point( i, 0 ) );
+                visit_border( point( i, OMAPY - 1 ) );
+            }
+            for( int i = 1; i < OMAPY - 1; ++i ) {
+                visit_border( point( 0, i ) );
+                visit_border( point( OMAPX - 1, i ) );
+            }
+
+            // Up and down the ramps, from this layer or to it from the one above or below.
+            for( int dz = -1; dz <= 1; dz += 2 ) {
+                const int z = r.z + dz;
+                if( z < -OVERMAP_DEPTH || z > OVERMAP_HEIGHT ) {
+                    continue;
+                }
+                const layer_regions &other = layer( r.om, z );
+                for( const point &ramp : here.ramps ) {
+                    const uint16_t label = other.label[index_of( ramp )];
+                    if( here.label[index_of( ramp )] == r.label && label != impassable ) {
+                        out.push_back( region{ r.om, z, label } );
+                    }
+                }
+                for( const point &ramp : other.ramps ) {
+                    if( here.label[index_of( ramp )] == r.label ) {
+                        out.push_back( region{ r.om, z, other.label[index_of( ramp )] } );
+                    }
+                }
+            }
+        }
+
+    private:
+        travel_class cls;
+        point min_om;
+        point max_om;
+        int layers_labelled = 0;
+};
+
+} // namespace
+
+bool may_connect( const tripoint_abs_omt &src, const tripoint_abs_omt &dest, int radius,
+                  const overmap_path_params &params )
+{
+    if( cached_layers().size() + max_layers_per_query > max_cached_layers ) {
+        // The layers handed out by region_graph must stay valid until the query is done.
+        cached_layers().clear();
+    }
+    region_graph graph( params, src, radius );
+    const std::optional<region> from = graph.region_at( src );
+    const std::optional<region> to = graph.region_at( dest );
+    if( !from || !to ) {
+        // The search always accepts its starting point, and the destination may be out of the area.
+        return true;
+    }
+    if( *from == *to ) {
+        return true;
+    }
+
+    // Breadth first from both ends, whichever side runs out first is cut off from the other.
+    std::array<std::unordered_set<region, region_hash>, 2> visited;
+    std::array<std::queue<region>, 2> open;
+    visited[0].insert( *from );
+    open[0].push( *from );
+    visited[1].insert( *to );
+    open[1].push( *to );
+    std::vector<region> next;
+    while( true ) {
+        for( size_t side = 0; side < 2; ++side ) {
+            if( open[side].empty() ) {
+                return false;
+            }
+            const region cur = open[side].front();
+            open[side].pop();
+            next.clear();
+            graph.neighbours( cur, next );
+            if( graph.over_budget() ) {
+                return true;
+            }
+            for( const region &r : next ) {
+                if( visited[1 - side].count( r ) > 0 ) {
+                    return true;
+                }
+                if( visited[side].insert( r ).second ) {
+                    open[side].push( r );
+                }
+            }
+        }
+    }
+}
+
+void clear()
+{
+    cached_layers().clear();
+}
+
+} // namespace overmap_connectivity
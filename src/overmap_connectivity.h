@@ -0,0 +1,36 @@
+#pragma once
+#ifndef CATA_SRC_OVERMAP_CONNECTIVITY_H
+#define CATA_SRC_OVERMAP_CONNECTIVITY_H
+
+#include "coords_fwd.h"
+
+struct overmap_path_params;
+
+/**
+ * Connected regions of overmap terrain, used to answer "is there any way from here to there"
+ * before running the full A* search of @ref overmapbuffer::get_travel_path.
+ *
+ * Each layer of each overmap is split into regions of OMTs that can be entered with the given
+ * @ref overmap_path_params.  The regions are cached per overmap until its terrain changes, and
+ * a query walks the graph of regions from both ends, across overmap borders and up and down the
+ * ramps of bridges, until the ends meet or one side runs out of regions.  An unreachable
+ * destination is usually found out after visiting a handful of regions, where the A* search
+ * would expand every OMT it can reach.
+ */
+namespace overmap_connectivity
+{
+
+/**
+ * Returns false if no path from @p src to @p dest that stays within @p radius OMTs of @p src
+ * can exist for @p params.  Knowledge of the player and dangerous OMTs are not taken into
+ * account, so true only means that a path may exist.
+ */
+bool may_connect( const tripoint_abs_omt &src, const tripoint_abs_omt &dest, int radius,
+                  const overmap_path_params &params );
+
+/** Drops all cached regions. */
+void clear();
+
+} // namespace overmap_connectivity
+
+#endif // CATA_SRC_OVERMAP_CONNECTIVITY_H
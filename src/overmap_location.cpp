@@ -32,6 +32,10 @@ const overmap_location &string_id<overmap_location>::obj() const
 
 bool overmap_location::test( const int_id<oter_t> &oter ) const
 {
+    const size_t index = oter.to_i();
+    if( index < oter_mask.size() ) {
+        return oter_mask[index];
+    }
     return terrains.count( oter->get_type_id() );
 }
 
@@ -79,6 +83,13 @@ void overmap_location::finalize()
             }
         }
     }
+
+    // The terrains are in the order of their int ids.
+    const std::vector<oter_t> &all_oters = overmap_terrains::get_all();
+    oter_mask.resize( all_oters.size() );
+    for( size_t i = 0; i < all_oters.size(); ++i ) {
+        oter_mask[i] = terrains.count( all_oters[i].get_type_id() ) > 0;
+    }
 }
 
 void overmap_locations::load( const JsonObject &jo, const std::string &src )
@@ -32,6 +32,8 @@ struct overmap_location {
     private:
         TerrColType terrains;
         std::vector<std::string> flags;
+        // Whether each overmap terrain, by its int id, is one of the terrains, built by finalize.
+        std::vector<bool> oter_mask;
 };
 
 namespace overmap_locations
@@ -1,12 +1,50 @@
 #include <cmath>
 #include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
 
 #include "overmap_noise.h"
 #include "simplexnoise.h"
+#include "thread_pool.h"
 
 namespace om_noise
 {
 
+namespace
+{
+
+/** Octave noise of every point of a rectangle, scaled to [0, 1]. */
+void octave_rect( float octaves, float scale, const point_abs_omt &origin, int width, int height,
+                  float seed, float *out )
+{
+    for( int y = 0; y < height; y++ ) {
+        for( int x = 0; x < width; x++ ) {
+            out[x + y * width] = scaled_octave_noise_3d( octaves, 0.5, scale, 0, 1, origin.x() + x,
+                                 origin.y() + y, seed );
+        }
+    }
+}
+
+void pow_rect( float *values, int count, float exponent )
+{
+    for( int i = 0; i < count; i++ ) {
+        values[i] = std::pow( values[i], exponent );
+    }
+}
+
+} // namespace
+
+void om_noise_layer::noise_rect( const point_om_omt &origin, int width, int height,
+                                 float *out ) const
+{
+    for( int y = 0; y < height; y++ ) {
+        for( int x = 0; x < width; x++ ) {
+            out[x + y * width] = noise_at( origin + point( x, y ) );
+        }
+    }
+}
+
 float om_noise_layer_forest::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -19,6 +57,20 @@ float om_noise_layer_forest::noise_at( const point_om_omt &local_omt_pos ) const
     return std::max( 0.0f, r - d * 0.5f );
 }
 
+void om_noise_layer_forest::noise_rect( const point_om_omt &origin, int width, int height,
+                                        float *out ) const
+{
+    const int count = width * height;
+    std::vector<float> d( count );
+    octave_rect( 4, 0.03, global_omt_pos( origin ), width, height, get_seed(), out );
+    octave_rect( 6, 0.07, global_omt_pos( origin ), width, height, get_seed(), d.data() );
+    pow_rect( out, count, 2.0f );
+    pow_rect( d.data(), count, 3.0f );
+    for( int i = 0; i < count; i++ ) {
+        out[i] = std::max( 0.0f, out[i] - d[i] * 0.5f );
+    }
+}
+
 float om_noise_layer_floodplain::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -27,6 +79,13 @@ float om_noise_layer_floodplain::noise_at( const point_om_omt &local_omt_pos ) c
     return r;
 }
 
+void om_noise_layer_floodplain::noise_rect( const point_om_omt &origin, int width, int height,
+        float *out ) const
+{
+    octave_rect( 4, 0.05, global_omt_pos( origin ), width, height, get_seed(), out );
+    pow_rect( out, width * height, 2.0f );
+}
+
 float om_noise_layer_lake::noise_at( const point_om_omt &local_omt_pos ) const
 {
     const point_abs_omt p = global_omt_pos( local_omt_pos );
@@ -35,6 +94,13 @@ float om_noise_layer_lake::noise_at( const point_om_omt &local_omt_pos ) const
     return r;
 }
 
+void om_noise_layer_lake::noise_rect( const point_om_omt &origin, int width, int height,
+                                      float *out ) const
+{
+    octave_rect( 8, 0.002, global_omt_pos( origin ), width, height, get_seed(), out );
+    pow_rect( out, width * height, 4.0f );
+}
+
 float om_noise_layer_ocean::noise_at( const point_om_omt &local_omt_pos ) const
 {
     // this is a duplicate of lake noise.  Changing it might cause artifacts if oceans
@@ -45,4 +111,28 @@ float om_noise_layer_ocean::noise_at( const point_om_omt &local_omt_pos ) const
     return r;
 }
 
+void om_noise_layer_ocean::noise_rect( const point_om_omt &origin, int width, int height,
+                                       float *out ) const
+{
+    octave_rect( 8, 0.002, global_omt_pos( origin ), width, height, get_seed(), out );
+    pow_rect( out, width * height, 4.0f );
+}
+
+om_noise_grid::om_noise_grid( std::unique_ptr<om_noise_layer> noise_layer, int grid_border ) :
+    layer( std::move( noise_layer ) ), border( grid_border ), width( OMAPX + 2 * grid_border ),
+    height( OMAPY + 2 * grid_border ), values( width * height )
+{
+    // The noise is a pure function of the position, so bands of rows can be evaluated on as many
+    // threads as there are and the values come out the same.
+    const int bands = static_cast<int>( num_parallel_threads() );
+    const int band_height = ( height + bands - 1 ) / bands;
+    const int num_bands = ( height + band_height - 1 ) / band_height;
+    parallel_for( num_bands, [this, band_height]( size_t band ) {
+        const int y = static_cast<int>( band ) * band_height;
+        const int rows = std::min( band_height, height - y );
+        layer->noise_rect( point_om_omt( -border, y - border ), width, rows,
+                           values.data() + static_cast<size_t>( y ) * width );
+    } );
+}
+
 } // namespace om_noise
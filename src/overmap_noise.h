@@ -2,6 +2,9 @@
 #ifndef CATA_SRC_OVERMAP_NOISE_H
 #define CATA_SRC_OVERMAP_NOISE_H
 
+#include <memory>
+#include <vector>
+
 #include "coordinates.h"
 #include "game_constants.h"
 
@@ -20,6 +23,11 @@ class om_noise_layer
          * @param omt_local point location in overmap terrain local coordinates.
          */
         virtual float noise_at( const point_om_omt &omt_local ) const = 0;
+        /**
+         * Noise values of the @p width by @p height rectangle starting at @p origin, written
+         * row by row to @p out.
+         */
+        virtual void noise_rect( const point_om_omt &origin, int width, int height, float *out ) const;
         virtual ~om_noise_layer() = default;
     protected:
         /**
@@ -55,6 +63,7 @@ class om_noise_layer_forest : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void noise_rect( const point_om_omt &origin, int width, int height, float *out ) const override;
 };
 
 class om_noise_layer_floodplain : public om_noise_layer
@@ -65,6 +74,7 @@ class om_noise_layer_floodplain : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void noise_rect( const point_om_omt &origin, int width, int height, float *out ) const override;
 };
 
 class om_noise_layer_lake : public om_noise_layer
@@ -75,6 +85,7 @@ class om_noise_layer_lake : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void noise_rect( const point_om_omt &origin, int width, int height, float *out ) const override;
 };
 
 
@@ -86,6 +97,34 @@ class om_noise_layer_ocean : public om_noise_layer
         }
 
         float noise_at( const point_om_omt &local_omt_pos ) const override;
+        void noise_rect( const point_om_omt &origin, int width, int height, float *out ) const override;
+};
+
+/**
+ * The values of a noise layer over a whole overmap and @p border OMTs around it, computed once
+ * so steps that look at the same points over and over, like the flood fills of water bodies,
+ * don't evaluate the noise again.  Points outside of the grid fall back to the layer.
+ */
+class om_noise_grid
+{
+    public:
+        om_noise_grid( std::unique_ptr<om_noise_layer> noise_layer, int grid_border );
+
+        float noise_at( const point_om_omt &omt_local ) const {
+            const int x = omt_local.x() + border;
+            const int y = omt_local.y() + border;
+            if( x < 0 || y < 0 || x >= width || y >= height ) {
+                return layer->noise_at( omt_local );
+            }
+            return values[x + y * width];
+        }
+
+    private:
+        std::unique_ptr<om_noise_layer> layer;
+        int border;
+        int width;
+        int height;
+        std::vector<float> values;
 };
 
 } // namespace om_noise
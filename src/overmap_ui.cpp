@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <array>
+#include <bitset>
 #include <chrono>
 #include <cstddef>
 #include <functional>
@@ -154,12 +155,13 @@ static std::array<std::pair<nc_color, std::string>, npm_width *npm_height> get_o
     std::array<std::pair<nc_color, std::string>, npm_width *npm_height> map_around;
     int index = 0;
     const point shift( npm_width / 2, npm_height / 2 );
+    std::vector<om_vision_level> around_vision;
+    overmap_buffer.seen_rect( current - shift, point( npm_width, npm_height ), around_vision );
     for( const tripoint_abs_omt &dest :
          tripoint_range<tripoint_abs_omt>( current - shift, current + shift ) ) {
         nc_color ter_color = c_black;
         std::string ter_sym = " ";
-        om_vision_level vision = has_debug_vision ? om_vision_level::full :
-                                 overmap_buffer.seen( dest );
+        om_vision_level vision = has_debug_vision ? om_vision_level::full : around_vision[index];
         if( vision != om_vision_level::unseen ) {
             // Only load terrain if we can actually see it
             oter_id cur_ter = overmap_buffer.ter( dest );
@@ -718,19 +720,24 @@ static void draw_ascii(
         }
     }
 
+    // Read the whole view at once rather than looking up its overmaps for every tile.
+    const point view_size( om_map_width, om_map_height );
+    std::vector<oter_id> view_ter;
+    overmap_buffer.ter_rect( corner, view_size, view_ter );
+    std::vector<om_vision_level> view_vision;
+    if( !has_debug_vision ) {
+        overmap_buffer.seen_rect( corner, view_size, view_vision );
+    }
+
     for( int i = 0; i < om_map_width; ++i ) {
         for( int j = 0; j < om_map_height; ++j ) {
             const tripoint_abs_omt omp = corner + point( i, j );
-            oter_id cur_ter = oter_str_id::NULL_ID();
+            const oter_id &cur_ter = view_ter[i + j * om_map_width];
             nc_color ter_color = c_black;
             std::string ter_sym = " ";
 
             const om_vision_level vision = has_debug_vision ? om_vision_level::full :
-                                           overmap_buffer.seen( omp );
-            if( vision == om_vision_level::unseen ) {
-                // Only load terrain if we can actually see it
-                cur_ter = overmap_buffer.ter( omp );
-            }
+                                           view_vision[i + j * om_map_width];
 
             oter_display_args oter_args( vision );
             std::tie( ter_sym, ter_color ) = oter_symbol_and_color( omp, oter_args, oter_opts, &lru_cache );
@@ -2289,12 +2296,128 @@ std::pair<std::string, nc_color> oter_display_lru::get_symbol_and_color( const o
     return ret;
 }
 
+// The terrain of a tile the player has seen, as it is drawn when nothing is on top of it.
+static std::pair<std::string, nc_color> terrain_symbol_and_color( const tripoint_abs_omt &omp,
+        om_vision_level vision, const oter_display_options &opts, oter_display_lru *lru )
+{
+    std::pair<std::string, nc_color> ret;
+    const oter_id &cur_ter = overmap_buffer.ter( omp );
+    if( cur_ter->blends_adjacent( vision ) ) {
+        oter_vision::blended_omt here = oter_vision::get_blended_omt_info( omp, vision );
+        ret.first = here.sym;
+        ret.second = here.color;
+    } else if( !uistate.overmap_show_forest_trails && cur_ter &&
+               ( cur_ter->get_type_id() == oter_type_forest_trail ) ) {
+        // If forest trails shouldn't be displayed, and this is a forest trail, then
+        // instead render it like a forest.
+        ret = lru ? lru->get_symbol_and_color( oter_forest.id(),
+        vision ) : std::pair<std::string, nc_color> {
+            oter_forest->get_symbol( vision, uistate.overmap_show_land_use_codes ),
+            oter_forest->get_color( vision, uistate.overmap_show_land_use_codes )
+        };
+        if( opts.show_explored && overmap_buffer.is_explored( omp ) ) {
+            ret.second = c_dark_gray;
+        }
+    } else {
+        // Nothing special, but is visible to the player.
+        ret = lru ? lru->get_symbol_and_color( cur_ter, vision ) : std::pair<std::string, nc_color> {
+            cur_ter->get_symbol( vision, uistate.overmap_show_land_use_codes ),
+            cur_ter->get_color( vision, uistate.overmap_show_land_use_codes )
+        };
+        if( opts.show_explored && overmap_buffer.is_explored( omp ) ) {
+            ret.second = c_dark_gray;
+        }
+    }
+    return ret;
+}
+
+/**
+ * The results of @ref terrain_symbol_and_color for one layer of one overmap.  Blended tiles
+ * look up to two tiles into the neighbouring overmaps, so the layer is reset when the display
+ * stamp of any of them or the display settings change.
+ */
+struct oter_display_cache_layer {
+    std::array<int, 9> stamps = {};
+    bool land_use_codes = false;
+    bool forest_trails = false;
+    bool show_explored = false;
+    std::bitset<OMAPX * OMAPY> filled;
+    std::array<om_vision_level, OMAPX * OMAPY> vision = {};
+    std::array<std::pair<std::string, nc_color>, OMAPX * OMAPY> sym_color;
+};
+
+// Above this many layers, the cache is dropped before the next batch starts using it.
+static constexpr size_t max_display_cache_layers = 16;
+
+static std::unordered_map<tripoint, std::unique_ptr<oter_display_cache_layer>> &
+display_cache_layers()
+{
+    static std::unordered_map<tripoint, std::unique_ptr<oter_display_cache_layer>> layers;
+    return layers;
+}
+
+static oter_display_cache_layer &get_display_cache_layer( const tripoint &layer_pos,
+        const oter_display_options &opts )
+{
+    auto &layers = display_cache_layers();
+    if( opts.checked_display_layers.empty() && layers.size() > max_display_cache_layers ) {
+        // Nothing from this batch points into the layers yet.
+        layers.clear();
+    }
+    std::unique_ptr<oter_display_cache_layer> &layer = layers[layer_pos];
+    if( !layer ) {
+        layer = std::make_unique<oter_display_cache_layer>();
+    }
+    if( opts.checked_display_layers.insert( layer_pos ).second ) {
+        std::array<int, 9> stamps;
+        for( int dy = -1; dy <= 1; ++dy ) {
+            for( int dx = -1; dx <= 1; ++dx ) {
+                const overmap *om = overmap_buffer.get_existing(
+                                        point_abs_om( layer_pos.xy() + point( dx, dy ) ) );
+                stamps[( dy + 1 ) * 3 + dx + 1] = om == nullptr ? 0 : om->get_display_stamp();
+            }
+        }
+        if( stamps != layer->stamps ||
+            layer->land_use_codes != uistate.overmap_show_land_use_codes ||
+            layer->forest_trails != uistate.overmap_show_forest_trails ||
+            layer->show_explored != opts.show_explored ) {
+            layer->stamps = stamps;
+            layer->land_use_codes = uistate.overmap_show_land_use_codes;
+            layer->forest_trails = uistate.overmap_show_forest_trails;
+            layer->show_explored = opts.show_explored;
+            layer->filled.reset();
+        }
+    }
+    return *layer;
+}
+
+static std::pair<std::string, nc_color> cached_terrain_symbol_and_color(
+    const tripoint_abs_omt &omp, om_vision_level vision, const oter_display_options &opts,
+    oter_display_lru *lru )
+{
+    point_abs_om om;
+    tripoint_om_omt local;
+    std::tie( om, local ) = project_remain<coords::om>( omp );
+    const tripoint layer_pos( om.raw(), omp.z() );
+    if( opts.last_display_layer == nullptr || opts.last_display_layer_pos != layer_pos ) {
+        opts.last_display_layer = &get_display_cache_layer( layer_pos, opts );
+        opts.last_display_layer_pos = layer_pos;
+    }
+    oter_display_cache_layer &layer = *opts.last_display_layer;
+    const size_t idx = local.y() * OMAPX + local.x();
+    if( !layer.filled[idx] || layer.vision[idx] != vision ) {
+        layer.sym_color[idx] = terrain_symbol_and_color( omp, vision, opts, lru );
+        layer.vision[idx] = vision;
+        layer.filled[idx] = true;
+    }
+    return layer.sym_color[idx];
+}
+
 std::pair<std::string, nc_color> oter_symbol_and_color( const tripoint_abs_omt &omp,
         oter_display_args &args, const oter_display_options &opts, oter_display_lru *lru )
 {
     std::pair<std::string, nc_color> ret;
 
-    oter_id cur_ter = oter_str_id::NULL_ID();
     avatar &player_character = get_avatar();
     std::vector<point_abs_omt> plist;
     const bool blink = opts.blink || g->overmap_data.fast_traveling;
@@ -2303,11 +2426,6 @@ std::pair<std::string, nc_color> oter_symbol_and_color( const tripoint_abs_omt &
         plist = line_to( opts.center.xy(), opts.mission_target->xy() );
     }
 
-    // Only load terrain if we can see it
-    if( args.vision != om_vision_level::unseen ) {
-        cur_ter = overmap_buffer.ter( omp );
-    }
-
     if( blink && opts.show_pc && !opts.hilite_pc && omp == opts.center ) {
         // Display player pos, should always be visible
         ret.second = player_character.symbol_color();
@@ -2384,31 +2502,8 @@ std::pair<std::string, nc_color> oter_symbol_and_color( const tripoint_abs_omt &
     } else if( !opts.sZoneName.empty() && opts.tripointZone.xy() == omp.xy() ) {
         ret.second = c_yellow;
         ret.first = "Z";
-    } else if( cur_ter->blends_adjacent( args.vision ) ) {
-        oter_vision::blended_omt here = oter_vision::get_blended_omt_info( omp, args.vision );
-        ret.first = here.sym;
-        ret.second = here.color;
-    } else if( !uistate.overmap_show_forest_trails && cur_ter &&
-               ( cur_ter->get_type_id() == oter_type_forest_trail ) ) {
-        // If forest trails shouldn't be displayed, and this is a forest trail, then
-        // instead render it like a forest.
-        ret = lru ? lru->get_symbol_and_color( oter_forest.id(),
-        args.vision ) : std::pair<std::string, nc_color> {
-            oter_forest->get_symbol( args.vision, uistate.overmap_show_land_use_codes ),
-            oter_forest->get_color( args.vision, uistate.overmap_show_land_use_codes )
-        };
-        if( opts.show_explored && overmap_buffer.is_explored( omp ) ) {
-            ret.second = c_dark_gray;
-        }
     } else {
-        // Nothing special, but is visible to the player.
-        ret = lru ? lru->get_symbol_and_color( cur_ter, args.vision ) : std::pair<std::string, nc_color> {
-            cur_ter->get_symbol( args.vision, uistate.overmap_show_land_use_codes ),
-            cur_ter->get_color( args.vision, uistate.overmap_show_land_use_codes )
-        };
-        if( opts.show_explored && overmap_buffer.is_explored( omp ) ) {
-            ret.second = c_dark_gray;
-        }
+        ret = cached_terrain_symbol_and_color( omp, args.vision, opts, lru );
     }
 
     if( opts.hilite_mission && opts.mission_target && opts.mission_target->xy() == omp.xy() ) {
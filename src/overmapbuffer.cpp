@@ -1,14 +1,24 @@
 #include "overmapbuffer.h"
 
 #include <algorithm>
+#include <chrono>
 #include <climits>
+#include <cstdlib>
+#include <exception>
+#include <functional>
 #include <iterator>
 #include <list>
 #include <map>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <tuple>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
+#include "alloc_profiler.h"
+#include "avatar.h"
 #include "basecamp.h"
 #include "calendar.h"
 #include "cata_assert.h"
@@ -27,18 +37,22 @@
 #include "line.h"
 #include "map.h"
 #include "memory_fast.h"
+#include "mission.h"
 #include "mod_manager.h"
 #include "mongroup.h"
 #include "monster.h"
 #include "npc.h"
+#include "options.h"
 #include "overmap.h"
 #include "overmap_connection.h"
+#include "overmap_connectivity.h"
 #include "overmap_types.h"
 #include "path_info.h"
 #include "point.h"
 #include "rng.h"
 #include "simple_pathfinding.h"
 #include "string_formatter.h"
+#include "thread_pool.h"
 #include "translations.h"
 #include "vehicle.h"
 
@@ -87,17 +101,29 @@ cata_path overmapbuffer::player_filename( const point_abs_om &p )
 overmap &overmapbuffer::get( const point_abs_om &p )
 {
     if( last_requested_overmap != nullptr && last_requested_overmap->pos() == p ) {
-        return *last_requested_overmap;
+        return touch( *last_requested_overmap );
     }
 
     const auto it = overmaps.find( p );
     if( it != overmaps.end() ) {
-        return *( last_requested_overmap = it->second.get() );
+        return touch( *( last_requested_overmap = it->second.get() ) );
+    }
+    if( overmap *generating = pending_overmap_at( p ) ) {
+        return *generating;
+    }
+    if( pending_overmap != nullptr && !generating_pending &&
+        ( pending_overmap->pos() == p || !file_exist( terrain_filename( p ) ) ) ) {
+        // Either it's the one asked for, or the new one is generated and has to see it as a neighbour.
+        finish_pending_generation();
+        return get( p );
     }
 
+    const alloc_profiler::scoped_tag alloc_tag( alloc_profiler::tag::overmapbuffer );
     // That constructor loads an existing overmap or creates a new one.
-    overmap &new_om = *( overmaps[ p ] = std::make_unique<overmap>( p ) );
-    overmap_count++;
+    overmap &new_om = touch( *( overmaps[ p ] = std::make_unique<overmap>( p ) ) );
+    if( unloaded.erase( p ) == 0 ) {
+        overmap_count++;
+    }
     new_om.populate();
     // Note: fix_mongroups might load other overmaps, so overmaps.back() is not
     // necessarily the overmap at (x,y)
@@ -110,6 +136,7 @@ overmap &overmapbuffer::get( const point_abs_om &p )
 
 void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_special_batch &specials )
 {
+    finish_pending_generation();
     if( last_requested_overmap != nullptr ) {
         auto om_iter = overmaps.find( p );
         if( om_iter != overmaps.end() && om_iter->second.get() == last_requested_overmap ) {
@@ -121,6 +148,92 @@ void overmapbuffer::create_custom_overmap( const point_abs_om &p, overmap_specia
     new_om.populate( specials );
 }
 
+void overmapbuffer::generate_ahead( const tripoint_abs_omt &center,
+                                    const std::chrono::milliseconds budget )
+{
+    if( pending_overmap == nullptr ) {
+        point_abs_om om;
+        point_om_omt local;
+        std::tie( om, local ) = project_remain<coords::om>( center.xy() );
+        const auto side = []( const int v, const int size ) {
+            return v < generate_ahead_distance ? -1 : v >= size - generate_ahead_distance ? 1 : 0;
+        };
+        const point dir( side( local.x(), OMAPX ), side( local.y(), OMAPY ) );
+        // Straight ahead first, the corner last.
+        for( const point &offset : {
+                 point( dir.x, 0 ), point( 0, dir.y ), dir
+             } ) {
+            if( offset != point_zero && pending_overmap == nullptr ) {
+                begin_pending_generation( om + offset );
+            }
+        }
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+    while( pending_overmap != nullptr ) {
+        if( run_pending_stage() ) {
+            finish_pending_generation();
+        } else if( std::chrono::steady_clock::now() - start >= budget ) {
+            break;
+        }
+    }
+}
+
+void overmapbuffer::begin_pending_generation( const point_abs_om &p )
+{
+    if( overmaps.count( p ) > 0 ) {
+        return;
+    }
+    if( known_non_existing.count( p ) == 0 ) {
+        if( file_exist( terrain_filename( p ) ) ) {
+            // Loading is quick enough to leave for when it's needed.
+            return;
+        }
+        known_non_existing.insert( p );
+    }
+    // Looking up the neighbours may load them, so it's not pending until that's done.
+    std::unique_ptr<overmap> new_om = std::make_unique<overmap>( p );
+    pending_state = std::make_unique<overmap_generation_state>(
+                        new_om->begin_generation( new_om->get_enabled_specials() ) );
+    pending_overmap = std::move( new_om );
+    overmap_count++;
+}
+
+bool overmapbuffer::run_pending_stage()
+{
+    bool done = true;
+    generating_pending = true;
+    try {
+        done = pending_overmap->generate_stage( *pending_state );
+    } catch( const std::exception &err ) {
+        debugmsg( "overmap %s failed to generate: %s", pending_overmap->pos().to_string(), err.what() );
+    }
+    generating_pending = false;
+    return done;
+}
+
+void overmapbuffer::finish_pending_generation()
+{
+    if( pending_overmap == nullptr || generating_pending ) {
+        return;
+    }
+    while( !run_pending_stage() ) {
+    }
+    const point_abs_om p = pending_overmap->pos();
+    overmap &new_om = *( overmaps[p] = std::move( pending_overmap ) );
+    pending_state.reset();
+    fix_mongroups( new_om );
+    fix_npcs( new_om );
+}
+
+overmap *overmapbuffer::pending_overmap_at( const point_abs_om &p ) const
+{
+    if( generating_pending && pending_overmap->pos() == p ) {
+        return pending_overmap.get();
+    }
+    return nullptr;
+}
+
 void overmapbuffer::fix_mongroups( overmap &new_overmap )
 {
     for( auto it = new_overmap.zg.begin(); it != new_overmap.zg.end(); ) {
@@ -186,6 +299,10 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
     // First step: move all npcs that are located outside of the given overmap
     // into a separate container. After that loop, new_overmap.npcs is no
     // accessed anymore!
+    // Deferred npcs were checked to be on the overmap when it was loaded.
+    if( new_overmap.has_unloaded_npcs() ) {
+        return;
+    }
     decltype( overmap::npcs ) to_relocate;
     for( auto it = new_overmap.npcs.begin(); it != new_overmap.npcs.end(); ) {
         npc &np = **it;
@@ -232,26 +349,132 @@ void overmapbuffer::fix_npcs( overmap &new_overmap )
 
 void overmapbuffer::save()
 {
+    // Its specials are already counted in the global state that gets saved.
+    finish_pending_generation();
+    // Serializing reads shared game data, so it stays on this thread. Only the
+    // already serialized files are handed to the workers.
+    std::vector<overmap_file_write> files;
     for( auto &omp : overmaps ) {
-        // Note: this may throw io errors from std::ofstream
-        omp.second->save();
+        omp.second->collect_changed_files( files );
+    }
+    if( files.empty() ) {
+        return;
+    }
+
+    int num_threads = get_option<int>( "SAVE_THREADS" );
+    if( num_threads <= 0 ) {
+        num_threads = thread_pool::default_size();
+    }
+    const int compression_level = get_option<int>( "SAVE_COMPRESSION" );
+    std::exception_ptr error;
+    std::mutex error_mutex;
+    {
+        thread_pool pool( std::min<size_t>( num_threads, files.size() ) );
+        for( const overmap_file_write &file : files ) {
+            pool.push( [&file, compression_level, &error, &error_mutex]() {
+                try {
+                    overmap::write_file( file, compression_level );
+                } catch( ... ) {
+                    std::lock_guard<std::mutex> lock( error_mutex );
+                    if( !error ) {
+                        error = std::current_exception();
+                    }
+                }
+            } );
+        }
+        pool.wait();
+    }
+    // Note: this rethrows io errors from std::ofstream
+    if( error ) {
+        std::rethrow_exception( error );
+    }
+}
+
+overmap &overmapbuffer::touch( overmap &om )
+{
+    om.last_used = ++access_tick;
+    return om;
+}
+
+std::unordered_set<point_abs_om> overmapbuffer::pinned_overmaps()
+{
+    std::unordered_set<point_abs_om> pinned;
+    // The same area as the hordes and monster groups are processed in.
+    const int radius = MAPSIZE * 2;
+    const point_abs_sm center = get_player_character().global_sm_location().xy();
+    const point_abs_om start = project_to<coords::om>( center + point( -radius, -radius ) );
+    const point_abs_om end = project_to<coords::om>( center + point( radius, radius ) );
+    for( int y = start.y(); y <= end.y(); ++y ) {
+        for( int x = start.x(); x <= end.x(); ++x ) {
+            pinned.insert( point_abs_om( x, y ) );
+        }
+    }
+    for( const character_id &id : g->get_follower_list() ) {
+        if( const shared_ptr_fast<npc> guy = find_npc( id ) ) {
+            pinned.insert( project_to<coords::om>( guy->global_omt_location().xy() ) );
+        }
+    }
+    for( const mission *m : get_avatar().get_active_missions() ) {
+        if( m->get_target() != overmap::invalid_tripoint ) {
+            pinned.insert( project_to<coords::om>( m->get_target().xy() ) );
+        }
+    }
+    return pinned;
+}
+
+void overmapbuffer::unload_over_limit()
+{
+    const int limit = get_option<int>( "OVERMAP_RESIDENT_LIMIT" );
+    if( limit <= 0 || overmaps.size() <= static_cast<size_t>( limit ) ) {
+        return;
+    }
+    const std::unordered_set<point_abs_om> pinned = pinned_overmaps();
+    std::vector<std::pair<int64_t, point_abs_om>> candidates;
+    for( const auto &omp : overmaps ) {
+        if( pinned.count( omp.first ) == 0 ) {
+            candidates.emplace_back( omp.second->last_used, omp.first );
+        }
+    }
+    std::sort( candidates.begin(), candidates.end() );
+    const size_t excess = overmaps.size() - limit;
+    for( size_t i = 0; i < std::min( excess, candidates.size() ); ++i ) {
+        const auto it = overmaps.find( candidates[i].second );
+        try {
+            // Unchanged files are left alone, so unloading a clean overmap writes nothing.
+            it->second->save();
+        } catch( const std::exception &err ) {
+            debugmsg( "overmap %s could not be saved, it stays loaded: %s",
+                      it->first.to_string(), err.what() );
+            continue;
+        }
+        if( last_requested_overmap == it->second.get() ) {
+            last_requested_overmap = nullptr;
+        }
+        unloaded.insert( it->first );
+        overmaps.erase( it );
     }
 }
 
 void overmapbuffer::reset()
 {
+    pending_overmap.reset();
+    pending_state.reset();
     overmaps.clear();
     last_requested_overmap = nullptr;
 }
 
 void overmapbuffer::clear()
 {
+    pending_overmap.reset();
+    pending_state.reset();
     overmaps.clear();
+    unloaded.clear();
     known_non_existing.clear();
     placed_unique_specials.clear();
     unique_special_count.clear();
     overmap_count = 0;
     last_requested_overmap = nullptr;
+    overmap_connectivity::clear();
 }
 
 const regional_settings &overmapbuffer::get_settings( const tripoint_abs_omt &p )
@@ -299,11 +522,14 @@ void overmapbuffer::delete_extra( const tripoint_abs_omt &p )
 overmap *overmapbuffer::get_existing( const point_abs_om &p )
 {
     if( last_requested_overmap && last_requested_overmap->pos() == p ) {
-        return last_requested_overmap;
+        return &touch( *last_requested_overmap );
     }
     const auto it = overmaps.find( p );
     if( it != overmaps.end() ) {
-        return last_requested_overmap = it->second.get();
+        return &touch( *( last_requested_overmap = it->second.get() ) );
+    }
+    if( overmap *generating = pending_overmap_at( p ) ) {
+        return generating;
     }
     if( known_non_existing.count( p ) > 0 ) {
         // This overmap does not exist on disk (this has already been
@@ -327,7 +553,8 @@ overmap *overmapbuffer::get_existing( const point_abs_om &p )
 
 bool overmapbuffer::has( const point_abs_om &p )
 {
-    return get_existing( p ) != nullptr;
+    return get_existing( p ) != nullptr ||
+           ( pending_overmap != nullptr && pending_overmap->pos() == p );
 }
 
 overmap_with_local_coords
@@ -782,6 +1009,62 @@ void overmapbuffer::set_seen( const tripoint_abs_omt &p, om_vision_level seen )
     om_loc.om->set_seen( om_loc.local, seen );
 }
 
+void overmapbuffer::for_each_overmap_in_rect( const tripoint_abs_omt &corner, const point &size,
+        bool create, const overmap_rect_fn &fn )
+{
+    if( size.x <= 0 || size.y <= 0 ) {
+        return;
+    }
+    const point_abs_om first = project_to<coords::om>( corner.xy() );
+    const point_abs_om last = project_to<coords::om>( corner.xy() + size - point_south_east );
+    for( int om_y = first.y(); om_y <= last.y(); ++om_y ) {
+        for( int om_x = first.x(); om_x <= last.x(); ++om_x ) {
+            const point_abs_om om_pos( om_x, om_y );
+            const point_abs_omt om_corner = project_to<coords::omt>( om_pos );
+            const point start( std::max( corner.x(), om_corner.x() ),
+                               std::max( corner.y(), om_corner.y() ) );
+            const point end( std::min( corner.x() + size.x, om_corner.x() + OMAPX ),
+                             std::min( corner.y() + size.y, om_corner.y() + OMAPY ) );
+            overmap *om = create ? &get( om_pos ) : get_existing( om_pos );
+            const tripoint_om_omt local( point_om_omt( start - om_corner.raw() ), corner.z() );
+            fn( om, local, start - corner.xy().raw(), end - start );
+        }
+    }
+}
+
+void overmapbuffer::ter_rect( const tripoint_abs_omt &corner, const point &size,
+                              std::vector<oter_id> &out )
+{
+    out.assign( std::max( 0, size.x * size.y ), oter_id() );
+    for_each_overmap_in_rect( corner, size, true, [&]( overmap * om, const tripoint_om_omt & local,
+    const point & offset, const point & span ) {
+        for( int y = 0; y < span.y; ++y ) {
+            oter_id *row = &out[offset.x + ( offset.y + y ) * size.x];
+            for( int x = 0; x < span.x; ++x ) {
+                row[x] = om->ter( local + point( x, y ) );
+            }
+        }
+    } );
+}
+
+void overmapbuffer::seen_rect( const tripoint_abs_omt &corner, const point &size,
+                               std::vector<om_vision_level> &out )
+{
+    out.assign( std::max( 0, size.x * size.y ), om_vision_level::unseen );
+    for_each_overmap_in_rect( corner, size, false, [&]( overmap * om, const tripoint_om_omt & local,
+    const point & offset, const point & span ) {
+        if( om == nullptr ) {
+            return;
+        }
+        for( int y = 0; y < span.y; ++y ) {
+            om_vision_level *row = &out[offset.x + ( offset.y + y ) * size.x];
+            for( int x = 0; x < span.x; ++x ) {
+                row[x] = om->seen( local + point( x, y ) );
+            }
+        }
+    } );
+}
+
 bool overmapbuffer::seen_more_than( const tripoint_abs_omt &p, om_vision_level test )
 {
     if( const overmap_with_local_coords om_loc = get_existing_om_global( p ) ) {
@@ -845,22 +1128,56 @@ bool overmapbuffer::reveal( const tripoint_abs_omt &center, int radius )
 bool overmapbuffer::reveal( const tripoint_abs_omt &center, int radius,
                             const std::function<bool( const oter_id & )> &filter )
 {
-    int radius_squared = radius * radius;
-    bool result = false;
-    for( int i = -radius; i <= radius; i++ ) {
-        for( int j = -radius; j <= radius; j++ ) {
-            const tripoint_abs_omt p = center + point( i, j );
-            if( seen( p ) == om_vision_level::full ) {
-                continue;
+    omt_spans spans;
+    add_reveal_spans( spans, center.xy(), radius );
+    return reveal_spans( spans, center.z(), filter );
+}
+
+void overmapbuffer::add_reveal_spans( omt_spans &spans, const point_abs_omt &center, int radius )
+{
+    const int radius_squared = radius * radius;
+    int half_width = 0;
+    for( int dy = -radius; dy <= radius; ++dy ) {
+        if( !trigdist ) {
+            half_width = radius;
+        } else if( dy <= 0 ) {
+            // The rows widen towards the middle of the circle, and narrow again past it.
+            while( half_width < radius &&
+                   ( half_width + 1 ) * ( half_width + 1 ) + dy * dy <= radius_squared ) {
+                ++half_width;
             }
-            if( trigdist && i * i + j * j > radius_squared ) {
-                continue;
+        } else {
+            while( half_width * half_width + dy * dy > radius_squared ) {
+                --half_width;
             }
-            if( !filter( ter( p ) ) ) {
-                continue;
+        }
+        spans[center.y() + dy].emplace_back( center.x() - half_width, center.x() + half_width );
+    }
+}
+
+bool overmapbuffer::reveal_spans( omt_spans &spans, int z,
+                                  const std::function<bool( const oter_id & )> &filter )
+{
+    bool result = false;
+    for( auto &row : spans ) {
+        std::vector<std::pair<int, int>> &ranges = row.second;
+        std::sort( ranges.begin(), ranges.end() );
+        const int y = row.first;
+        for( size_t i = 0; i < ranges.size(); ) {
+            // Merge the overlapping or touching ranges, so each OMT is visited once.
+            int first = ranges[i].first;
+            int last = ranges[i].second;
+            for( ++i; i < ranges.size() && ranges[i].first <= last + 1; ++i ) {
+                last = std::max( last, ranges[i].second );
+            }
+            while( first <= last ) {
+                point_abs_om om_pos;
+                point_om_omt local;
+                std::tie( om_pos, local ) = project_remain<coords::om>( point_abs_omt( first, y ) );
+                const int length = std::min( last - first + 1, OMAPX - local.x() );
+                result |= get( om_pos ).reveal_span( tripoint_om_omt( local, z ), length, filter );
+                first += length;
             }
-            result = true;
-            set_seen( p, om_vision_level::full );
         }
     }
     return result;
@@ -959,6 +1276,10 @@ std::vector<tripoint_abs_omt> overmapbuffer::get_travel_path(
     };
 
     constexpr int radius = 4 * OMAPX; // radius of search in OMTs = 4 overmaps
+    // Cheap to rule out, where the search would have to expand everything it can reach first.
+    if( !overmap_connectivity::may_connect( src, dest, radius, params ) ) {
+        return {};
+    }
     const pf::simple_path<tripoint_abs_omt> &path = pf::find_overmap_path( src, dest, radius, estimate,
             g->display_om_pathfinding_progress, std::nullopt, params.allow_diagonal );
     return path.points;
@@ -1015,9 +1336,14 @@ bool overmapbuffer::reveal_route( const tripoint_abs_omt &source, const tripoint
     // TODO: use overmapbuffer::get_travel_path() with appropriate params instead
     const auto path = pf::greedy_path( start, finish, 2 * O, estimate );
 
+    // Neighbouring nodes reveal mostly the same OMTs, so reveal the union of them once.
+    omt_spans spans;
     for( const auto &node : path.nodes ) {
-        reveal( base + node.pos, radius );
+        add_reveal_spans( spans, ( base + node.pos ).xy(), radius );
     }
+    reveal_spans( spans, source.z(), []( const oter_id & ) {
+        return true;
+    } );
     return !path.nodes.empty();
 }
 
@@ -1149,6 +1475,104 @@ tripoint_abs_omt overmapbuffer::find_closest(
     return find_closest( origin, params );
 }
 
+namespace
+{
+
+/** Answers whether a terrain matches the types of a search, each terrain is only compared once. */
+class terrain_matcher
+{
+    public:
+        explicit terrain_matcher( const omt_find_params &params ) : params( params ) {}
+
+        bool operator()( const oter_id &oter ) {
+            const auto it = matches.find( oter );
+            if( it != matches.end() ) {
+                return it->second;
+            }
+            const bool match = std::any_of( params.types.begin(), params.types.end(),
+            [&]( const std::pair<std::string, ot_match_type> &type ) {
+                return is_ot_match( type.first, oter, type.second );
+            } );
+            matches.emplace( oter, match );
+            return match;
+        }
+
+    private:
+        const omt_find_params &params;
+        std::unordered_map<oter_id, bool> matches;
+};
+
+/** An overmap within range of a search, with the nearest and farthest square distance of its OMTs. */
+struct overmap_in_range {
+    point_abs_om pos;
+    int min_dist = 0;
+    int max_dist = 0;
+};
+
+/** The overmaps with OMTs between @p min_dist and @p max_dist of @p origin, nearest first. */
+std::vector<overmap_in_range> overmaps_in_range( const point_abs_omt &origin, const int min_dist,
+        const int max_dist )
+{
+    const point_abs_om lo = project_to<coords::om>( origin - point( max_dist, max_dist ) );
+    const point_abs_om hi = project_to<coords::om>( origin + point( max_dist, max_dist ) );
+    std::vector<overmap_in_range> result;
+    for( int y = lo.y(); y <= hi.y(); ++y ) {
+        for( int x = lo.x(); x <= hi.x(); ++x ) {
+            const point_abs_om om( x, y );
+            const point_abs_omt first = project_to<coords::omt>( om );
+            const point_abs_omt last = first + point( OMAPX - 1, OMAPY - 1 );
+            const auto axis_dist = []( const int v, const int lo, const int hi ) {
+                return std::max( { 0, lo - v, v - hi } );
+            };
+            overmap_in_range entry;
+            entry.pos = om;
+            entry.min_dist = std::max( axis_dist( origin.x(), first.x(), last.x() ),
+                                       axis_dist( origin.y(), first.y(), last.y() ) );
+            entry.max_dist = std::max( { std::abs( origin.x() - first.x() ), std::abs( origin.x() - last.x() ),
+                                         std::abs( origin.y() - first.y() ), std::abs( origin.y() - last.y() )
+                                       } );
+            if( entry.min_dist <= max_dist && entry.max_dist >= min_dist ) {
+                result.push_back( entry );
+            }
+        }
+    }
+    std::stable_sort( result.begin(), result.end(),
+    []( const overmap_in_range & lhs, const overmap_in_range & rhs ) {
+        return lhs.min_dist < rhs.min_dist;
+    } );
+    return result;
+}
+
+/** Adds the OMTs of matching terrain in @p in_range to @p out, that are in the range of @p params. */
+void find_candidates( overmapbuffer &buffer, const tripoint_abs_omt &origin,
+                      const omt_find_params &params, const overmap_in_range &in_range,
+                      const int min_z, const int max_z,
+                      const std::function<bool( const oter_id & )> &match,
+                      std::vector<tripoint_abs_omt> &out )
+{
+    overmap *om = params.existing_only ? buffer.get_existing( in_range.pos ) :
+                  &buffer.get( in_range.pos );
+    if( om == nullptr ) {
+        return;
+    }
+    const int min_dist = params.min_distance;
+    const int max_dist = params.search_range ? params.search_range : OMAPX * 5;
+    std::vector<tripoint_om_omt> local;
+    for( int z = std::max( min_z, -OVERMAP_DEPTH ); z <= std::min( max_z, OVERMAP_HEIGHT ); ++z ) {
+        local.clear();
+        om->find_terrain_positions( z, match, local );
+        for( const tripoint_om_omt &p : local ) {
+            const tripoint_abs_omt loc( project_combine( in_range.pos, p.xy() ), z );
+            const int dist = square_dist( origin.xy(), loc.xy() );
+            if( dist >= min_dist && dist <= max_dist ) {
+                out.push_back( loc );
+            }
+        }
+    }
+}
+
+} // namespace
+
 tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
         const omt_find_params &params )
 {
@@ -1175,28 +1599,31 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX * 5;
 
+    // Instead of testing every OMT in range, each overmap hands out the OMTs of matching
+    // terrain.  Overmaps are visited nearest first, and only while they may hold something
+    // nearer than what was found, so the same overmaps get generated as by walking outwards.
+    terrain_matcher matcher( params );
+    const std::function<bool( const oter_id & )> match = std::ref( matcher );
     std::vector<tripoint_abs_omt> result;
     int found_dist = std::numeric_limits<int>::max();
-
-    for( const point_abs_omt &loc_xy : closest_points_first( origin.xy(), min_dist, max_dist ) ) {
-        const int dist_xy = square_dist( origin.xy(), loc_xy );
-
-        if( found_dist < dist_xy ) {
+    std::vector<tripoint_abs_omt> candidates;
+    for( const overmap_in_range &in_range : overmaps_in_range( origin.xy(), min_dist, max_dist ) ) {
+        if( found_dist < in_range.min_dist ) {
             break;
         }
-
-        for( int z = params.min_z; z <= params.max_z; z++ ) {
-            const tripoint_abs_omt loc( loc_xy, z );
+        candidates.clear();
+        find_candidates( *this, origin, params, in_range, params.min_z, params.max_z, match,
+                         candidates );
+        for( const tripoint_abs_omt &loc : candidates ) {
             const int dist = square_dist( origin, loc );
-
-            if( found_dist < dist ) {
+            if( dist > found_dist || !is_findable_location( loc, params ) ) {
                 continue;
             }
-
-            if( is_findable_location( loc, params ) ) {
+            if( dist < found_dist ) {
                 found_dist = dist;
-                result.push_back( loc );
+                result.clear();
             }
+            result.push_back( loc );
         }
     }
 
@@ -1206,17 +1633,41 @@ tripoint_abs_omt overmapbuffer::find_closest( const tripoint_abs_omt &origin,
 std::vector<tripoint_abs_omt> overmapbuffer::find_all( const tripoint_abs_omt &origin,
         const omt_find_params &params )
 {
-    std::vector<tripoint_abs_omt> result;
     // dist == 0 means search a whole overmap diameter.
     const int min_dist = params.min_distance;
     const int max_dist = params.search_range ? params.search_range : OMAPX;
-
-    for( const tripoint_abs_omt &loc : closest_points_first( origin, min_dist, max_dist ) ) {
-        if( is_findable_location( loc, params ) ) {
-            result.push_back( loc );
+    // The distance is checked in three dimensions below.
+    omt_find_params ranged = params;
+    ranged.min_distance = 0;
+    ranged.search_range = max_dist;
+
+    terrain_matcher matcher( params );
+    const std::function<bool( const oter_id & )> match = std::ref( matcher );
+    std::vector<std::pair<int, tripoint_abs_omt>> found;
+    std::vector<tripoint_abs_omt> candidates;
+    // The search is a cube around the origin, z levels included.
+    for( const overmap_in_range &in_range : overmaps_in_range( origin.xy(), 0, max_dist ) ) {
+        candidates.clear();
+        find_candidates( *this, origin, ranged, in_range, origin.z() - max_dist,
+                         origin.z() + max_dist, match, candidates );
+        for( const tripoint_abs_omt &loc : candidates ) {
+            const int dist = square_dist( origin, loc );
+            if( dist >= min_dist && dist <= max_dist && is_findable_location( loc, params ) ) {
+                found.emplace_back( dist, loc );
+            }
         }
     }
 
+    // Closest first, like the search used to return them.
+    std::stable_sort( found.begin(), found.end(),
+    []( const std::pair<int, tripoint_abs_omt> &lhs, const std::pair<int, tripoint_abs_omt> &rhs ) {
+        return lhs.first < rhs.first;
+    } );
+    std::vector<tripoint_abs_omt> result;
+    result.reserve( found.size() );
+    for( const std::pair<int, tripoint_abs_omt> &entry : found ) {
+        result.push_back( entry.second );
+    }
     return result;
 }
 
@@ -1259,6 +1710,7 @@ shared_ptr_fast<npc> overmapbuffer::find_npc( character_id id )
 void overmapbuffer::foreach_npc( const std::function<void( npc & )> &callback )
 {
     for( auto &it : overmaps ) {
+        it.second->load_npcs();
         for( auto &guy : it.second->npcs ) {
             callback( *guy );
         }
@@ -1455,7 +1907,7 @@ std::vector<shared_ptr_fast<npc>> overmapbuffer::get_overmap_npcs()
     std::vector<shared_ptr_fast<npc>> result;
     for( auto &om : overmaps ) {
         const overmap &overmap = *om.second;
-        for( const auto &guy : overmap.npcs ) {
+        for( const auto &guy : overmap.get_npcs() ) {
             result.push_back( guy );
         }
     }
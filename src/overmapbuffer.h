@@ -3,8 +3,10 @@
 #define CATA_SRC_OVERMAPBUFFER_H
 
 #include <array>
+#include <chrono>
 #include <functional>
 #include <iosfwd>
+#include <map>
 #include <memory>
 #include <new>
 #include <optional>
@@ -31,6 +33,7 @@ class monster;
 class npc;
 class overmap;
 class overmap_special_batch;
+struct overmap_generation_state;
 class vehicle;
 struct mapgen_arguments;
 struct mongroup;
@@ -157,6 +160,12 @@ class overmapbuffer
          */
         overmap &get( const point_abs_om & );
         void save();
+        /**
+         * Saves and unloads the least recently used overmaps above the limit set by the
+         * OVERMAP_RESIDENT_LIMIT option.  The overmaps around the avatar, and those holding a
+         * follower or the target of an active mission, are never unloaded.
+         */
+        void unload_over_limit();
         /**
          * Just drop the generated overmaps without resetting
          * the members tracking which specials we've placed.
@@ -165,6 +174,17 @@ class overmapbuffer
         void reset();
         void clear();
         void create_custom_overmap( const point_abs_om &, overmap_special_batch &specials );
+        /**
+         * Generates the overmaps next to the one @p center is in ahead of time, a stage per
+         * call, once @p center comes within @ref generate_ahead_distance OMTs of their border.
+         * Crossing into them then only has to wait for the stages that are left, if any.
+         * Runs stages until @p budget is spent, at least one.
+         *
+         * The overmap being generated isn't visible to anyone but its own generation, and it is
+         * completed before any other overmap is generated, so that one sees it as a neighbour.
+         */
+        void generate_ahead( const tripoint_abs_omt &center, std::chrono::milliseconds budget );
+        static constexpr int generate_ahead_distance = 30;
 
         /**
          * Returns the overmap terrain at the given OMT coordinates.
@@ -199,6 +219,15 @@ class overmapbuffer
         om_vision_level seen( const tripoint_abs_omt &p );
         bool seen_more_than( const tripoint_abs_omt &p, om_vision_level test );
         void set_seen( const tripoint_abs_omt &p, om_vision_level seen );
+        /**
+         * Terrain and vision of the @p size OMTs from @p corner on, row by row, into @p out.
+         * Each overmap is looked up only once, so these are the way to read a whole area.
+         * ter_rect creates overmaps as needed like @ref ter, seen_rect doesn't.
+         */
+        void ter_rect( const tripoint_abs_omt &corner, const point &size,
+                       std::vector<oter_id> &out );
+        void seen_rect( const tripoint_abs_omt &corner, const point &size,
+                        std::vector<om_vision_level> &out );
         bool has_camp( const tripoint_abs_omt &p );
         bool has_vehicle( const tripoint_abs_omt &p );
         bool has_horde( const tripoint_abs_omt &p );
@@ -389,6 +418,22 @@ class overmapbuffer
         overmap_with_local_coords get_existing_om_global( const tripoint_abs_omt &p );
         overmap_with_local_coords get_om_global( const point_abs_omt &p );
         overmap_with_local_coords get_om_global( const tripoint_abs_omt &p );
+        /**
+         * Calls @p fn for each overmap the @p size OMTs from @p corner on overlap with the
+         * local point of the overlap nearest @p corner, its offset from @p corner and its size.
+         * Overmaps that don't exist are created if @p create, otherwise passed as nullptr.
+         */
+        /** Rows of OMTs by their y, each with the inclusive ranges of x covered in that row. */
+        using omt_spans = std::map<int, std::vector<std::pair<int, int>>>;
+        /** Adds the OMTs @ref reveal covers for @p center and @p radius to @p spans. */
+        static void add_reveal_spans( omt_spans &spans, const point_abs_omt &center, int radius );
+        /** Reveals @p spans on layer @p z, see @ref reveal. */
+        bool reveal_spans( omt_spans &spans, int z,
+                           const std::function<bool( const oter_id & )> &filter );
+        using overmap_rect_fn =
+            std::function<void( overmap *, const tripoint_om_omt &, const point &, const point & )>;
+        void for_each_overmap_in_rect( const tripoint_abs_omt &corner, const point &size, bool create,
+                                       const overmap_rect_fn &fn );
 
         /**
          * Pass global overmap coordinates (same as @ref get).
@@ -554,6 +599,26 @@ class overmapbuffer
         bool is_findable_location( const tripoint_abs_omt &location, const omt_find_params &params );
 
         std::unordered_map< point_abs_om, std::unique_ptr< overmap > > overmaps;
+        // Stamped on an overmap whenever it is handed out, so the least recently used is known.
+        int64_t access_tick = 0;
+        // Unloaded by unload_over_limit, they don't count as new overmaps when loaded again.
+        std::unordered_set<point_abs_om> unloaded;
+        overmap &touch( overmap &om );
+        /** Overmaps unload_over_limit has to keep. */
+        std::unordered_set<point_abs_om> pinned_overmaps();
+        // The overmap generate_ahead is working on, if any.
+        std::unique_ptr<overmap> pending_overmap;
+        std::unique_ptr<overmap_generation_state> pending_state;
+        // Set while a stage of the pending overmap runs, it can see itself in the meantime.
+        bool generating_pending = false;
+        /** Starts generating the overmap at @p p ahead of time, unless it exists already. */
+        void begin_pending_generation( const point_abs_om &p );
+        /** Runs the next stage of the pending overmap, returns true once it is complete. */
+        bool run_pending_stage();
+        /** Runs the rest of the pending overmap, if any, and adds it to @ref overmaps. */
+        void finish_pending_generation();
+        /** The pending overmap if it is at @p p and its own generation is asking for it. */
+        overmap *pending_overmap_at( const point_abs_om &p ) const;
         /**
          * Set of overmap coordinates of overmaps that are known
          * to not exist on disk. See @ref get_existing for usage.
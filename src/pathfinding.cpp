@@ -4,23 +4,30 @@
 #include <array>
 #include <cstdlib>
 #include <iterator>
+#include <limits>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <queue>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
+#include "calendar.h"
 #include "cata_utility.h"
 #include "coordinates.h"
 #include "debug.h"
 #include "game.h"
 #include "gates.h"
+#include "hash_utils.h"
 #include "line.h"
+#include "lru_cache.h"
 #include "map.h"
 #include "mapdata.h"
 #include "point.h"
 #include "submap.h"
+#include "thread_pool.h"
 #include "trap.h"
 #include "type_id.h"
 #include "veh_type.h"
@@ -113,7 +120,96 @@ struct pathfinder {
     }
 };
 
-static pathfinder pf;
+// Each thread solving routes for prepare_routes gets its own search state.
+static thread_local pathfinder pf;
+
+static bool same_settings( const pathfinding_settings &l, const pathfinding_settings &r )
+{
+    return l.bash_strength == r.bash_strength && l.max_dist == r.max_dist &&
+           l.max_length == r.max_length && l.climb_cost == r.climb_cost &&
+           l.allow_open_doors == r.allow_open_doors && l.allow_unlock_doors == r.allow_unlock_doors &&
+           l.avoid_traps == r.avoid_traps && l.allow_climb_stairs == r.allow_climb_stairs &&
+           l.avoid_rough_terrain == r.avoid_rough_terrain && l.avoid_sharp == r.avoid_sharp &&
+           l.avoid_dangerous_fields == r.avoid_dangerous_fields && l.size == r.size;
+}
+
+static size_t hash_settings( const pathfinding_settings &settings )
+{
+    size_t seed = 0;
+    cata::hash_combine( seed, settings.bash_strength );
+    cata::hash_combine( seed, settings.max_dist );
+    cata::hash_combine( seed, settings.max_length );
+    cata::hash_combine( seed, settings.climb_cost );
+    const int bits = settings.allow_open_doors | settings.allow_unlock_doors << 1 |
+                     settings.avoid_traps << 2 | settings.allow_climb_stairs << 3 |
+                     settings.avoid_rough_terrain << 4 | settings.avoid_sharp << 5 |
+                     settings.avoid_dangerous_fields << 6;
+    cata::hash_combine( seed, bits );
+    cata::hash_combine( seed, settings.size ? static_cast<int>( *settings.size ) : -1 );
+    return seed;
+}
+
+// A path found by map::route, valid while the pathfinding caches of the z-levels it may
+// have searched keep their generation.
+struct cached_route {
+    const map *owner = nullptr;
+    tripoint_abs_sm map_origin;
+    tripoint from;
+    tripoint to;
+    pathfinding_settings settings;
+    int minz = 0;
+    std::vector<int> generations;
+    std::vector<tripoint> path;
+};
+
+// Keyed on the destination and settings, so agents that keep walking towards the same
+// point find their remaining path even though their start moved along it.
+static lru_cache<size_t, std::shared_ptr<const cached_route>> route_cache;
+static constexpr int route_cache_size = 64;
+// route_cache is also used by the workers of prepare_routes.
+static std::mutex route_cache_mutex;
+
+// Results of prepare_routes, keyed on route_key and the start.  Only touched by the main
+// thread, the workers run while it is empty.
+static std::unordered_map<size_t, cached_route> prepared_routes;
+
+static size_t route_key( const map &m, const tripoint &t, const pathfinding_settings &settings )
+{
+    size_t seed = hash_settings( settings );
+    cata::hash_combine( seed, &m );
+    cata::hash_combine( seed, m.get_abs_sub() );
+    cata::hash_combine( seed, t );
+    return seed;
+}
+
+static size_t prepared_key( size_t route_key, const tripoint &f )
+{
+    cata::hash_combine( route_key, f );
+    return route_key;
+}
+
+static bool still_valid( const cached_route &cached, const map &m, const tripoint &t,
+                         const pathfinding_settings &settings, int minz,
+                         const std::vector<int> &generations )
+{
+    return cached.owner == &m && cached.map_origin == m.get_abs_sub() && cached.to == t &&
+           cached.minz == minz && cached.generations == generations &&
+           same_settings( cached.settings, settings );
+}
+
+// Search generations of the z-levels a route between |f| and |t| may use.  The search may use
+// stairs, so any z-level in between, and one beyond, could have affected it.
+static std::vector<int> route_generations( const map &m, const tripoint &f, const tripoint &t,
+        int &minz )
+{
+    minz = std::max( std::min( f.z, t.z ) - 1, -OVERMAP_DEPTH );
+    const int maxz = std::min( std::max( f.z, t.z ) + 1, OVERMAP_HEIGHT );
+    std::vector<int> generations;
+    for( int z = minz; z <= maxz; ++z ) {
+        generations.push_back( m.get_pathfinding_cache_ref( z ).generation );
+    }
+    return generations;
+}
 
 // Modifies `t` to point to a tile with `flag` in a 1-submap radius of `t`'s original value,
 // searching nearest points first (starting with `t` itself).
@@ -206,6 +302,9 @@ std::vector<tripoint_bub_ms> map::straight_route( const tripoint_bub_ms &f,
     return ret;
 }
 
+// Paths longer than this go over the portal graph first.
+static constexpr int hierarchical_min_dist = 2 * SEEX;
+
 static constexpr int PF_IMPASSABLE = -1;
 static constexpr int PF_IMPASSABLE_FROM_HERE = -2;
 int map::cost_to_pass( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
@@ -390,9 +489,9 @@ int map::extra_cost( const tripoint_bub_ms &cur, const tripoint_bub_ms &p,
     return pass_cost + avoid_cost;
 }
 
-std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
-                                  const pathfinding_settings &settings,
-                                  const std::function<bool( const tripoint & )> &avoid ) const
+template<typename Avoid>
+std::vector<tripoint> map::route_impl( const tripoint &f, const tripoint &t,
+                                       const pathfinding_settings &settings, const Avoid &avoid ) const
 {
     /* TODO: If the origin or destination is out of bound, figure out the closest
      * in-bounds point and go to that, then to the real origin/destination.
@@ -406,7 +505,7 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     if( !inbounds( t ) ) {
         tripoint clipped = t;
         clip_to_bounds( clipped );
-        return route( f, clipped, settings, avoid );
+        return route_impl( f, clipped, settings, avoid );
     }
     // First, check for a simple straight line on flat ground
     // Except when the line contains a pre-closed tile - we need to do regular pathing then
@@ -424,6 +523,104 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
         return ret;
     }
 
+    int minz = 0;
+    const std::vector<int> generations = route_generations( *this, f, t, minz );
+    const size_t key = route_key( *this, t, settings );
+    // What the caller avoids isn't part of the keys, so check it on the way.
+    const auto avoids_any = [&]( auto begin, auto end ) {
+        return std::any_of( begin, end, [&]( const tripoint & p ) {
+            return p != t && avoid( p );
+        } );
+    };
+
+    if( !prepared_routes.empty() ) {
+        const auto prepared = prepared_routes.find( prepared_key( key, f ) );
+        if( prepared != prepared_routes.end() ) {
+            cached_route found = std::move( prepared->second );
+            prepared_routes.erase( prepared );
+            if( found.from == f && still_valid( found, *this, t, settings, minz, generations ) &&
+                !avoids_any( found.path.begin(), found.path.end() ) ) {
+                return found.path;
+            }
+        }
+    }
+
+    std::shared_ptr<const cached_route> cached;
+    {
+        std::lock_guard<std::mutex> lock( route_cache_mutex );
+        cached = route_cache.get( key, nullptr );
+    }
+    if( cached ) {
+        if( still_valid( *cached, *this, t, settings, minz, generations ) ) {
+            auto start = cached->path.begin();
+            if( cached->from != f ) {
+                // Still on the old path?
+                start = std::find( cached->path.begin(), cached->path.end(), f );
+                if( start != cached->path.end() ) {
+                    ++start;
+                }
+            }
+            if( ( cached->from == f || start != cached->path.end() ) &&
+                !avoids_any( start, cached->path.end() ) ) {
+                return std::vector<tripoint>( start, cached->path.end() );
+            }
+        }
+    }
+    const auto remember = [&]( const std::vector<tripoint> &path ) {
+        if( !path.empty() ) {
+            std::lock_guard<std::mutex> lock( route_cache_mutex );
+            route_cache.insert( route_cache_size, key, std::make_shared<const cached_route>( cached_route{
+                this, get_abs_sub(), f, t, settings, minz, generations, path } ) );
+        }
+        return path;
+    };
+
+    // Long paths are planned over submaps first.  Short ones too when the local search fails,
+    // as the detour may leave its box.
+    const bool same_level = f.z == t.z;
+    if( same_level && rl_dist( f, t ) > hierarchical_min_dist ) {
+        ret = hierarchical_route( f, t, settings, avoid );
+        if( !ret.empty() ) {
+            return remember( ret );
+        }
+    }
+    ret = local_route( f, t, settings, avoid );
+    if( ret.empty() && same_level && rl_dist( f, t ) <= hierarchical_min_dist ) {
+        ret = hierarchical_route( f, t, settings, avoid );
+    }
+    return remember( ret );
+}
+
+// Tiles without these flags always cost 2 to move onto, see cost_to_pass and cost_to_avoid.
+static constexpr PathfindingFlags jump_unsafe = PathfindingFlag::Slow | PathfindingFlag::Obstacle |
+        PathfindingFlag::Vehicle | PathfindingFlag::DangerousTrap | PathfindingFlag::Sharp |
+        PathfindingFlag::DangerousField | PathfindingFlag::GoesUp | PathfindingFlag::GoesDown;
+
+// Whether cost_to_pass is known to reject the tile from its flags alone.
+static bool surely_impassable( PathfindingFlags special, const pathfinding_settings &settings )
+{
+    if( settings.avoid_rough_terrain ) {
+        return true;
+    }
+    if( settings.avoid_sharp && ( special & PathfindingFlag::Sharp ) ) {
+        return true;
+    }
+    return ( special & PathfindingFlag::Obstacle ) && !( special & PathfindingFlag::Vehicle ) &&
+           settings.bash_strength <= 0 && !settings.allow_open_doors &&
+           !( settings.climb_cost > 0 && ( special & PathfindingFlag::Climbable ) );
+}
+
+enum class jump_tile : int {
+    open,
+    blocked,
+    special
+};
+
+template<typename Avoid>
+std::vector<tripoint> map::local_route( const tripoint &f, const tripoint &t,
+                                        const pathfinding_settings &settings, const Avoid &avoid ) const
+{
+    std::vector<tripoint> ret;
     const int max_length = settings.max_length;
 
     const int pad = 16;  // Should be much bigger - low value makes pathfinders dumb!
@@ -434,6 +631,85 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
     pf.reset( min.z(), max.z() );
 
+    // Looked up once, not per expanded node.
+    std::array<const pathfinding_cache *, OVERMAP_LAYERS> pf_caches{};
+    for( int z = min.z(); z <= max.z(); ++z ) {
+        pf_caches[z + OVERMAP_DEPTH] = &get_pathfinding_cache_ref( z );
+    }
+
+    // Open ground, where every move costs the same, is searched by jumping along straight
+    // lines instead of expanding each tile (jump point search).  Tiles that aren't open or
+    // blocked stop the jumps next to them, so they are searched tile by tile as usual.
+    const auto classify = [&]( const pathfinding_cache & pf_cache, const point & p, int z ) {
+        if( p.x < min.x() || p.x >= max.x() || p.y < min.y() || p.y >= max.y() ) {
+            return jump_tile::blocked;
+        }
+        const PathfindingFlags special = pf_cache.special[p.x][p.y];
+        if( special & jump_unsafe ) {
+            return surely_impassable( special, settings ) ? jump_tile::blocked : jump_tile::special;
+        }
+        const tripoint tp( p, z );
+        if( tp == t ) {
+            return jump_tile::special;
+        }
+        return avoid( tp ) ? jump_tile::blocked : jump_tile::open;
+    };
+    // The first tile along an orthogonal line from p that has to be expanded, nothing if the
+    // line runs into a blocked tile first.
+    const auto jump_straight = [&]( const pathfinding_cache & pf_cache, point p, const point & d,
+    int z ) -> std::optional<point> {
+        const point side( d.y, d.x );
+        while( true ) {
+            const jump_tile ahead = classify( pf_cache, p + d, z );
+            if( ahead != jump_tile::open ) {
+                return ahead == jump_tile::blocked ? std::nullopt : std::optional<point>( p );
+            }
+            p += d;
+            const jump_tile left = classify( pf_cache, p + side, z );
+            const jump_tile right = classify( pf_cache, p - side, z );
+            const jump_tile ahead_left = classify( pf_cache, p + d + side, z );
+            const jump_tile ahead_right = classify( pf_cache, p + d - side, z );
+            if( left == jump_tile::special || right == jump_tile::special ||
+                ahead_left == jump_tile::special || ahead_right == jump_tile::special ) {
+                return p;
+            }
+            // The way around a blocked tile beside the line starts here.
+            if( ( left == jump_tile::blocked && ahead_left == jump_tile::open ) ||
+                ( right == jump_tile::blocked && ahead_right == jump_tile::open ) ) {
+                return p;
+            }
+        }
+    };
+    // Same for a diagonal line, which also stops where one of its orthogonal lines does.
+    const auto jump_diagonal = [&]( const pathfinding_cache & pf_cache, point p, const point & d,
+    int z ) -> std::optional<point> {
+        const point dx( d.x, 0 );
+        const point dy( 0, d.y );
+        while( true ) {
+            const jump_tile ahead = classify( pf_cache, p + d, z );
+            if( ahead != jump_tile::open ) {
+                return ahead == jump_tile::blocked ? std::nullopt : std::optional<point>( p );
+            }
+            p += d;
+            // The neighbours of p that weren't next to the previous tile, and those beside it.
+            const jump_tile ahead_x = classify( pf_cache, p + dx, z );
+            const jump_tile ahead_y = classify( pf_cache, p + dy, z );
+            const jump_tile side_x = classify( pf_cache, p - dx + dy, z );
+            const jump_tile side_y = classify( pf_cache, p + dx - dy, z );
+            if( ahead_x == jump_tile::special || ahead_y == jump_tile::special ||
+                side_x == jump_tile::special || side_y == jump_tile::special ) {
+                return p;
+            }
+            if( ( classify( pf_cache, p - dx, z ) == jump_tile::blocked && side_x == jump_tile::open ) ||
+                ( classify( pf_cache, p - dy, z ) == jump_tile::blocked && side_y == jump_tile::open ) ) {
+                return p;
+            }
+            if( jump_straight( pf_cache, p, dx, z ) || jump_straight( pf_cache, p, dy, z ) ) {
+                return p;
+            }
+        }
+    };
+
     pf.add_point( 0, 0, f, f );
 
     bool done = false;
@@ -459,9 +735,49 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
 
         layer.closed[parent_index] = true;
 
-        const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( cur.z() );
+        const pathfinding_cache &pf_cache = *pf_caches[cur.z() + OVERMAP_DEPTH];
         const PathfindingFlags cur_special = pf_cache.special[cur.x()][cur.y()];
 
+        if( std::all_of( eight_horizontal_neighbors.begin(), eight_horizontal_neighbors.end(),
+        [&]( const tripoint & offset ) {
+        return classify( pf_cache, cur.xy().raw() + offset.xy(), cur.z() ) == jump_tile::open;
+        } ) ) {
+            // Only the moves that no other path reaches as cheaply are followed, in the
+            // direction the search came from.  Everything is worth a look from the start.
+            const tripoint &par = layer.parent[parent_index];
+            const point dir( cur.x() > par.x ? 1 : cur.x() < par.x ? -1 : 0,
+                             cur.y() > par.y ? 1 : cur.y() < par.y ? -1 : 0 );
+            std::array<point, 8> dirs;
+            size_t num_dirs = 0;
+            if( par.z != cur.z() || dir == point_zero ) {
+                for( const tripoint &offset : eight_horizontal_neighbors ) {
+                    dirs[num_dirs++] = offset.xy();
+                }
+            } else {
+                dirs[num_dirs++] = dir;
+                if( dir.x != 0 && dir.y != 0 ) {
+                    dirs[num_dirs++] = point( dir.x, 0 );
+                    dirs[num_dirs++] = point( 0, dir.y );
+                }
+            }
+            for( size_t i = 0; i < num_dirs; ++i ) {
+                const point &d = dirs[i];
+                const bool diagonal = d.x != 0 && d.y != 0;
+                const std::optional<point> jump = diagonal ?
+                                                  jump_diagonal( pf_cache, cur.xy().raw(), d, cur.z() ) :
+                                                  jump_straight( pf_cache, cur.xy().raw(), d, cur.z() );
+                if( !jump || *jump == cur.xy().raw() ) {
+                    continue;
+                }
+                const tripoint p( *jump, cur.z() );
+                // Same cost per tile as the moves below: 2, plus 1 for diagonals.
+                const int newg = layer.gscore[parent_index] +
+                                 square_dist( cur.raw(), p ) * ( diagonal ? 3 : 2 );
+                pf.add_point( newg, newg + 2 * rl_dist( p, t ), cur.raw(), p );
+            }
+            continue;
+        }
+
         // 7 3 5
         // 1 . 2
         // 6 4 8
@@ -476,11 +792,6 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 continue;
             }
 
-            if( p.raw() != t && avoid( p.raw() ) ) {
-                layer.closed[index] = true;
-                continue;
-            }
-
             if( layer.closed[index] ) {
                 continue;
             }
@@ -496,6 +807,11 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
                 }
                 continue;
             }
+            // The caller's check is usually the most expensive one, so it goes last.
+            if( p.raw() != t && avoid( p.raw() ) ) {
+                layer.closed[index] = true;
+                continue;
+            }
             newg += cost;
 
             // Special case: pathfinders that avoid traps can avoid ledges by
@@ -630,9 +946,18 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
             }
 
             ret.push_back( cur );
-            // Jumps are acceptable on 1 z-level changes
-            // This is because stairs teleport the player too
-            if( rl_dist( cur, par ) > 1 && std::abs( cur.z - par.z ) != 1 ) {
+            const point delta = par.xy() - cur.xy();
+            if( par.z == cur.z && rl_dist( cur, par ) > 1 &&
+                ( delta.x == 0 || delta.y == 0 || std::abs( delta.x ) == std::abs( delta.y ) ) ) {
+                // Jump points are reached along straight lines, fill in the tiles skipped.
+                const tripoint step( delta.x > 0 ? 1 : delta.x < 0 ? -1 : 0,
+                                     delta.y > 0 ? 1 : delta.y < 0 ? -1 : 0, 0 );
+                for( tripoint p = cur + step; p != par; p += step ) {
+                    ret.push_back( p );
+                }
+            } else if( rl_dist( cur, par ) > 1 && std::abs( cur.z - par.z ) != 1 ) {
+                // Jumps are acceptable on 1 z-level changes
+                // This is because stairs teleport the player too
                 debugmsg( "Jump in our route!  %d:%d:%d->%d:%d:%d",
                           cur.x, cur.y, cur.z, par.x, par.y, par.z );
                 return ret;
@@ -647,6 +972,343 @@ std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
     return ret;
 }
 
+static int submap_index( const point &p )
+{
+    return ( p.x / SEEX ) * MAPSIZE + p.y / SEEY;
+}
+
+// Walking distances from |from| to every tile of the submap containing it, using only the
+// coarse tile costs of that submap.
+static void submap_distances( const std::vector<int> &tile_cost, const point &from,
+                              std::array<int, SEEX *SEEY> &dist )
+{
+    const point origin( from.x - from.x % SEEX, from.y - from.y % SEEY );
+    const auto local_index = [&origin]( const point & p ) {
+        return ( p.x - origin.x ) * SEEY + p.y - origin.y;
+    };
+    dist.fill( std::numeric_limits<int>::max() );
+    std::priority_queue<std::pair<int, point>, std::vector<std::pair<int, point>>, pair_greater_cmp_first>
+    open;
+    dist[local_index( from )] = 0;
+    open.emplace( 0, from );
+    while( !open.empty() ) {
+        const auto [d, cur] = open.top();
+        open.pop();
+        if( d > dist[local_index( cur )] ) {
+            continue;
+        }
+        for( const tripoint &offset : eight_horizontal_neighbors ) {
+            const point p = cur + offset.xy();
+            if( p.x < origin.x || p.x >= origin.x + SEEX || p.y < origin.y || p.y >= origin.y + SEEY ) {
+                continue;
+            }
+            const int cost = tile_cost[flat_index( p )];
+            if( cost < 0 ) {
+                continue;
+            }
+            const int nd = d + cost + ( offset.x != 0 && offset.y != 0 ? 1 : 0 );
+            if( nd < dist[local_index( p )] ) {
+                dist[local_index( p )] = nd;
+                open.emplace( nd, p );
+            }
+        }
+    }
+}
+
+static int submap_local_index( const point &p )
+{
+    return ( p.x % SEEX ) * SEEY + p.y % SEEY;
+}
+
+const portal_graph &map::get_portal_graph( const int zlev ) const
+{
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( zlev );
+    portal_graph &graph = get_pathfinding_cache( zlev ).portals;
+    if( graph.generation == pf_cache.generation ) {
+        return graph;
+    }
+    graph.nodes.clear();
+    graph.edges.clear();
+    for( std::vector<int> &ids : graph.by_submap ) {
+        ids.clear();
+    }
+    graph.generation = pf_cache.generation;
+
+    // Optimistic costs for walkers that open doors, the refinement checks the real ones.
+    std::vector<int> tile_cost( MAPSIZE_X * MAPSIZE_Y );
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            const PathfindingFlags special = pf_cache.special[x][y];
+            int cost = special & PathfindingFlag::Slow ? 4 : 2;
+            if( special & PathfindingFlag::Obstacle ) {
+                const const_maptile tile = maptile_at_internal( tripoint_bub_ms( x, y, zlev ) );
+                cost = tile.get_ter_t().open || tile.get_furn_t().open ? 4 : PF_IMPASSABLE;
+            }
+            tile_cost[flat_index( point( x, y ) )] = cost;
+        }
+    }
+
+    const auto add_node = [&graph]( const point & p ) {
+        const int id = graph.nodes.size();
+        graph.nodes.emplace_back( p );
+        graph.edges.emplace_back();
+        graph.by_submap[submap_index( p )].push_back( id );
+        return id;
+    };
+    const auto add_entrance = [&]( const point & a, const point & b ) {
+        const int id_a = add_node( a );
+        const int id_b = add_node( b );
+        graph.edges[id_a].push_back( { id_b, tile_cost[flat_index( b )] } );
+        graph.edges[id_b].push_back( { id_a, tile_cost[flat_index( a )] } );
+    };
+    // Each run of tiles passable on both sides of a border becomes an entrance in its middle,
+    // long runs get one at either end instead.
+    const auto scan_border = [&]( const point & start, const point & along, const point & across ) {
+        int run = 0;
+        for( int i = 0; i <= SEEX; ++i ) {
+            const point a = start + along * i;
+            const bool open = i < SEEX && tile_cost[flat_index( a )] >= 0 &&
+                              tile_cost[flat_index( a + across )] >= 0;
+            if( open ) {
+                ++run;
+                continue;
+            }
+            if( run > 0 ) {
+                const point first = start + along * ( i - run );
+                const point last = start + along * ( i - 1 );
+                if( run > SEEX / 2 ) {
+                    add_entrance( first, first + across );
+                    add_entrance( last, last + across );
+                } else {
+                    const point mid = start + along * ( i - run + run / 2 );
+                    add_entrance( mid, mid + across );
+                }
+            }
+            run = 0;
+        }
+    };
+    const int size = getmapsize();
+    for( int sx = 0; sx < size; ++sx ) {
+        for( int sy = 0; sy < size; ++sy ) {
+            if( sx + 1 < size ) {
+                scan_border( point( ( sx + 1 ) * SEEX - 1, sy * SEEY ), point_south, point_east );
+            }
+            if( sy + 1 < size ) {
+                scan_border( point( sx * SEEX, ( sy + 1 ) * SEEY - 1 ), point_east, point_south );
+            }
+        }
+    }
+
+    std::array<int, SEEX *SEEY> dist;
+    for( const std::vector<int> &ids : graph.by_submap ) {
+        for( const int from : ids ) {
+            submap_distances( tile_cost, graph.nodes[from].raw(), dist );
+            for( const int to : ids ) {
+                const int d = dist[submap_local_index( graph.nodes[to].raw() )];
+                if( to != from && d != std::numeric_limits<int>::max() ) {
+                    graph.edges[from].push_back( { to, d } );
+                }
+            }
+        }
+    }
+    return graph;
+}
+
+template<typename Avoid>
+std::vector<tripoint> map::hierarchical_route( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings, const Avoid &avoid ) const
+{
+    const int start_sm = submap_index( f.xy() );
+    const int goal_sm = submap_index( t.xy() );
+    if( start_sm == goal_sm ) {
+        return std::vector<tripoint>();
+    }
+    const portal_graph &graph = get_portal_graph( f.z );
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( f.z );
+
+    // Same optimistic costs as the graph, for connecting the endpoints to it.
+    std::vector<int> tile_cost( MAPSIZE_X * MAPSIZE_Y, PF_IMPASSABLE );
+    const auto fill_submap = [&]( const point & p ) {
+        const point origin( p.x - p.x % SEEX, p.y - p.y % SEEY );
+        for( int x = origin.x; x < origin.x + SEEX; ++x ) {
+            for( int y = origin.y; y < origin.y + SEEY; ++y ) {
+                const PathfindingFlags special = pf_cache.special[x][y];
+                int cost = special & PathfindingFlag::Slow ? 4 : 2;
+                if( special & PathfindingFlag::Obstacle ) {
+                    const const_maptile tile = maptile_at_internal( tripoint_bub_ms( x, y, f.z ) );
+                    cost = tile.get_ter_t().open || tile.get_furn_t().open ? 4 : PF_IMPASSABLE;
+                }
+                tile_cost[flat_index( point( x, y ) )] = cost;
+            }
+        }
+    };
+    fill_submap( f.xy() );
+    fill_submap( t.xy() );
+    // The endpoints themselves may be occupied, that doesn't matter here.
+    tile_cost[flat_index( f.xy() )] = 2;
+    tile_cost[flat_index( t.xy() )] = 2;
+    std::array<int, SEEX *SEEY> from_start;
+    std::array<int, SEEX *SEEY> to_goal;
+    submap_distances( tile_cost, f.xy(), from_start );
+    submap_distances( tile_cost, t.xy(), to_goal );
+
+    // A* over the portals, the virtual goal node has the id after the last portal.
+    const int goal = graph.nodes.size();
+    std::vector<int> gscore( graph.nodes.size() + 1, std::numeric_limits<int>::max() );
+    std::vector<int> parent( graph.nodes.size() + 1, -1 );
+    std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int>>, pair_greater_cmp_first>
+    open;
+    const auto push = [&]( int node, int g, int from ) {
+        if( g >= gscore[node] || g > settings.max_length ) {
+            return;
+        }
+        gscore[node] = g;
+        parent[node] = from;
+        const int h = node == goal ? 0 : 2 * rl_dist( graph.nodes[node].raw(), t.xy() );
+        open.emplace( g + h, node );
+    };
+    for( const int id : graph.by_submap[start_sm] ) {
+        const int d = from_start[submap_local_index( graph.nodes[id].raw() )];
+        if( d != std::numeric_limits<int>::max() ) {
+            push( id, d, -1 );
+        }
+    }
+    bool found = false;
+    while( !open.empty() ) {
+        const auto [score, node] = open.top();
+        open.pop();
+        if( node == goal ) {
+            found = true;
+            break;
+        }
+        const int g = gscore[node];
+        if( score > g + 2 * rl_dist( graph.nodes[node].raw(), t.xy() ) ) {
+            // Stale entry.
+            continue;
+        }
+        for( const portal_graph::edge &e : graph.edges[node] ) {
+            push( e.to, g + e.cost, node );
+        }
+        if( submap_index( graph.nodes[node].raw() ) == goal_sm ) {
+            const int d = to_goal[submap_local_index( graph.nodes[node].raw() )];
+            if( d != std::numeric_limits<int>::max() ) {
+                push( goal, g + d, node );
+            }
+        }
+    }
+    if( !found ) {
+        return std::vector<tripoint>();
+    }
+
+    std::vector<tripoint> waypoints;
+    for( int node = parent[goal]; node != -1; node = parent[node] ) {
+        waypoints.emplace_back( graph.nodes[node].raw(), f.z );
+    }
+    std::reverse( waypoints.begin(), waypoints.end() );
+    waypoints.push_back( t );
+
+    std::vector<tripoint> ret;
+    tripoint cur = f;
+    for( const tripoint &next : waypoints ) {
+        if( next == cur ) {
+            continue;
+        }
+        if( next != t && avoid( next ) ) {
+            return std::vector<tripoint>();
+        }
+        std::vector<tripoint> segment = straight_route( cur, next );
+        if( segment.empty() || std::any_of( segment.begin(), segment.end(), avoid ) ) {
+            segment = local_route( cur, next, settings, avoid );
+        }
+        if( segment.empty() ) {
+            return std::vector<tripoint>();
+        }
+        ret.insert( ret.end(), segment.begin(), segment.end() );
+        cur = next;
+    }
+    return ret;
+}
+
+namespace
+{
+// For the callers that don't pass anything to avoid, the check compiles away.
+struct avoid_nothing {
+    bool operator()( const tripoint & ) const {
+        return false;
+    }
+};
+} // namespace
+
+std::vector<tripoint> map::route( const tripoint &f, const tripoint &t,
+                                  const pathfinding_settings &settings,
+                                  const std::function<bool( const tripoint & )> &avoid ) const
+{
+    if( !avoid ) {
+        return route_impl( f, t, settings, avoid_nothing() );
+    }
+    return route_impl( f, t, settings, avoid );
+}
+
+void map::prepare_routes( const std::vector<route_request> &requests ) const
+{
+    prepared_routes.clear();
+    const unsigned int num_threads = num_parallel_threads();
+    // Not worth the hand-off for a few searches, and pointless without a second core.
+    if( num_threads < 2 || requests.size() < 2 * static_cast<size_t>( num_threads ) ) {
+        return;
+    }
+
+    // Targets shared by several requests are served by a flow field, see shared_route.
+    std::unordered_map<size_t, int> per_target;
+    for( const route_request &req : requests ) {
+        ++per_target[route_key( *this, req.to, req.settings )];
+    }
+    std::vector<const route_request *> todo;
+    std::set<int> levels;
+    for( const route_request &req : requests ) {
+        // Routes across z-levels look up stairs through the game, which isn't thread safe.
+        if( req.from == req.to || req.from.z != req.to.z || !inbounds( req.from ) ||
+            !inbounds( req.to ) ) {
+            continue;
+        }
+        if( per_target[route_key( *this, req.to, req.settings )] == 1 ) {
+            todo.push_back( &req );
+            levels.insert( req.from.z );
+        }
+    }
+    if( todo.size() < 2 ) {
+        return;
+    }
+
+    // Bring the caches the searches read up to date first, so the workers only read them.
+    for( const int z : levels ) {
+        // route reads the generation of the levels around the endpoints too.
+        for( int dz = -1; dz <= 1; ++dz ) {
+            if( inbounds_z( z + dz ) ) {
+                get_pathfinding_cache_ref( z + dz );
+            }
+        }
+        get_portal_graph( z );
+    }
+
+    std::vector<std::vector<tripoint>> results( todo.size() );
+    parallel_for( todo.size(), [this, &todo, &results]( size_t i ) {
+        const route_request &req = *todo[i];
+        results[i] = route_impl( req.from, req.to, req.settings, avoid_nothing() );
+    } );
+
+    for( size_t i = 0; i < todo.size(); ++i ) {
+        if( results[i].empty() ) {
+            continue;
+        }
+        const route_request &req = *todo[i];
+        cached_route prepared{ this, get_abs_sub(), req.from, req.to, req.settings, 0, {}, std::move( results[i] ) };
+        prepared.generations = route_generations( *this, req.from, req.to, prepared.minz );
+        prepared_routes.emplace( prepared_key( route_key( *this, req.to, req.settings ), req.from ),
+                                 std::move( prepared ) );
+    }
+}
+
 std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f, const tripoint_bub_ms &t,
         const pathfinding_settings &settings,
         const std::function<bool( const tripoint & )> &avoid ) const
@@ -659,3 +1321,175 @@ std::vector<tripoint_bub_ms> map::route( const tripoint_bub_ms &f, const tripoin
     } );
     return result;
 }
+
+// Cost of reaching the target of a flow field, for every tile of its z-level.
+struct flow_field {
+    static constexpr int unreached = std::numeric_limits<int>::max();
+
+    const map *owner = nullptr;
+    tripoint_abs_sm map_origin;
+    tripoint target;
+    pathfinding_settings settings;
+    time_point turn;
+    int requests = 0;
+    bool built = false;
+    // Tiles outside of this box are never reached.
+    point min;
+    point max;
+    std::array<int, MAPSIZE_X *MAPSIZE_Y> dist;
+};
+
+// Enough for the few targets hordes usually converge on, more would mostly waste memory.
+static constexpr size_t max_flow_fields = 8;
+static std::array<std::unique_ptr<flow_field>, max_flow_fields> flow_fields;
+
+// Returns the field for this request, reusing the least requested slot of an older turn or
+// target if there is none yet.
+static flow_field &find_flow_field( const map &m, const tripoint &t,
+                                    const pathfinding_settings &settings )
+{
+    const tripoint_abs_sm origin = m.get_abs_sub();
+    flow_field *fallback = nullptr;
+    for( std::unique_ptr<flow_field> &field : flow_fields ) {
+        if( !field ) {
+            field = std::make_unique<flow_field>();
+        }
+        const bool current = field->turn == calendar::turn && field->owner == &m &&
+                             field->map_origin == origin;
+        if( current && field->target == t && same_settings( field->settings, settings ) ) {
+            return *field;
+        }
+        if( !current ) {
+            // Expired, so free.
+            field->requests = 0;
+        }
+        if( fallback == nullptr || field->requests < fallback->requests ) {
+            fallback = field.get();
+        }
+    }
+    flow_field &field = *fallback;
+    field.owner = &m;
+    field.map_origin = origin;
+    field.target = t;
+    field.settings = settings;
+    field.turn = calendar::turn;
+    field.requests = 0;
+    field.built = false;
+    return field;
+}
+
+void map::build_flow_field( flow_field &field ) const
+{
+    const tripoint &t = field.target;
+    const pathfinding_settings &settings = field.settings;
+    // Same padding as route uses around its endpoints.
+    const int reach = settings.max_dist + 16;
+    field.min = point( std::max( t.x - reach, 0 ), std::max( t.y - reach, 0 ) );
+    field.max = point( std::min( t.x + reach, MAPSIZE_X - 1 ), std::min( t.y + reach,
+                       MAPSIZE_Y - 1 ) );
+    field.dist.fill( flow_field::unreached );
+    field.built = true;
+
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( t.z );
+    using queue_type = std::priority_queue<std::pair<int, point>, std::vector<std::pair<int, point>>,
+          pair_greater_cmp_first>;
+    queue_type open;
+    field.dist[flat_index( t.xy() )] = 0;
+    open.emplace( 0, t.xy() );
+    while( !open.empty() ) {
+        const auto [dist, cur] = open.top();
+        open.pop();
+        if( dist > field.dist[flat_index( cur )] ) {
+            continue;
+        }
+        if( dist > settings.max_length ) {
+            break;
+        }
+        const tripoint_bub_ms cur_bub( cur.x, cur.y, t.z );
+        const PathfindingFlags cur_special = pf_cache.special[cur.x][cur.y];
+        for( const tripoint &offset : eight_horizontal_neighbors ) {
+            const point p = cur + offset.xy();
+            if( p.x < field.min.x || p.x > field.max.x || p.y < field.min.y || p.y > field.max.y ) {
+                continue;
+            }
+            // Walking from p onto cur, the reverse of the search in route.
+            const int cost = extra_cost( tripoint_bub_ms( p.x, p.y, t.z ), cur_bub, settings, cur_special );
+            if( cost < 0 ) {
+                continue;
+            }
+            const int newdist = dist + cost + ( offset.x != 0 && offset.y != 0 ? 1 : 0 );
+            int &old = field.dist[flat_index( p )];
+            if( newdist < old ) {
+                old = newdist;
+                open.emplace( newdist, p );
+            }
+        }
+    }
+}
+
+std::vector<tripoint> map::shared_route( const tripoint &f, const tripoint &t,
+        const pathfinding_settings &settings,
+        const std::function<bool( const tripoint & )> &avoid ) const
+{
+    // Ledges (handled specially in route) and stairs make the cost depend on more than the
+    // tiles of one z-level.
+    if( f == t || f.z != t.z || settings.avoid_traps || !inbounds( f ) || !inbounds( t ) ) {
+        return route( f, t, settings, avoid );
+    }
+    const std::vector<tripoint> line_path = straight_route( f, t );
+    if( !line_path.empty() && std::none_of( line_path.begin(), line_path.end(), avoid ) ) {
+        return line_path;
+    }
+    if( rl_dist( f, t ) > settings.max_dist ) {
+        return std::vector<tripoint>();
+    }
+
+    flow_field &field = find_flow_field( *this, t, settings );
+    // A single search is cheaper than a field, so only build one for a second request.
+    if( ++field.requests < 2 ) {
+        return route( f, t, settings, avoid );
+    }
+    if( !field.built ) {
+        build_flow_field( field );
+    }
+    if( field.dist[flat_index( f.xy() )] == flow_field::unreached ) {
+        return std::vector<tripoint>();
+    }
+
+    // Follow the gradient, checking the caller specific avoidance on the way.
+    const pathfinding_cache &pf_cache = get_pathfinding_cache_ref( t.z );
+    std::vector<tripoint> ret;
+    tripoint cur = f;
+    while( cur != t ) {
+        const int cur_dist = field.dist[flat_index( cur.xy() )];
+        std::optional<tripoint> best;
+        int best_total = flow_field::unreached;
+        for( const tripoint &offset : eight_horizontal_neighbors ) {
+            const tripoint p = cur + offset;
+            if( p.x < field.min.x || p.x > field.max.x || p.y < field.min.y || p.y > field.max.y ) {
+                continue;
+            }
+            const int p_dist = field.dist[flat_index( p.xy() )];
+            if( p_dist >= cur_dist || ( p != t && avoid( p ) ) ) {
+                continue;
+            }
+            const int cost = extra_cost( tripoint_bub_ms( cur ), tripoint_bub_ms( p ), settings,
+                                         pf_cache.special[p.x][p.y] );
+            if( cost < 0 ) {
+                continue;
+            }
+            const int total = p_dist + cost + ( offset.x != 0 && offset.y != 0 ? 1 : 0 );
+            if( total < best_total ) {
+                best_total = total;
+                best = p;
+            }
+        }
+        if( !best || ret.size() > static_cast<size_t>( settings.max_length ) ) {
+            // The shared field doesn't account for what this caller avoids.
+            return route( f, t, settings, avoid );
+        }
+        ret.push_back( *best );
+        cur = *best;
+    }
+    return ret;
+}
@@ -2,7 +2,9 @@
 #ifndef CATA_SRC_PATHFINDING_H
 #define CATA_SRC_PATHFINDING_H
 
+#include <array>
 #include <optional>
+#include <vector>
 
 #include "coords_fwd.h"
 #include "game_constants.h"
@@ -122,13 +124,32 @@ constexpr PathfindingFlags operator |( const PathfindingFlag &a, const Pathfindi
     return PathfindingFlags( a ) | PathfindingFlags( b );
 }
 
+// Coarse graph over the submaps of one z-level, used by map::route to plan long paths.
+// Nodes are the tiles on either side of the entrances between neighbouring submaps, edges
+// connect the two sides of an entrance and the entrances of a submap among each other.
+struct portal_graph {
+    struct edge {
+        int to;
+        int cost;
+    };
+    std::vector<point_bub_ms> nodes;
+    std::vector<std::vector<edge>> edges;
+    // Nodes of each submap, indexed by submap x * MAPSIZE + y.
+    std::array<std::vector<int>, MAPSIZE *MAPSIZE> by_submap;
+    // Value of pathfinding_cache::generation this was built from, -1 if never built.
+    int generation = -1;
+};
+
 struct pathfinding_cache {
     pathfinding_cache();
 
     bool dirty = false;
     std::unordered_set<point_bub_ms> dirty_points;
+    // Incremented whenever special changes.
+    int generation = 0;
 
     cata::mdarray<PathfindingFlags, point_bub_ms> special;
+    portal_graph portals;
 };
 
 struct pathfinding_settings {
@@ -163,4 +184,11 @@ struct pathfinding_settings {
     pathfinding_settings &operator=( const pathfinding_settings & ) = default;
 };
 
+// A route that is going to be asked for this turn, see map::prepare_routes.
+struct route_request {
+    tripoint from;
+    tripoint to;
+    pathfinding_settings settings;
+};
+
 #endif // CATA_SRC_PATHFINDING_H
@@ -32,6 +32,7 @@
 #include "monster.h"
 #include "pixel_minimap_projectors.h"
 #include "sdl_utils.h"
+#include "submap.h"
 #include "vehicle.h"
 #include "vpart_position.h"
 
@@ -118,10 +119,8 @@ SDL_Color get_critter_color( Creature *critter, int flicker, int mixture )
 } // namespace
 
 // a texture pool to avoid recreating textures every time player changes their view
-// at most 142 out of 144 textures can be in use due to regular player movement
-//  (moving from submap corner to new corner) with MAPSIZE = 11
-// textures are dumped when the player moves more than one submap in one update
-//  (teleporting, z-level change) to prevent running out of the remaining pool
+// each of the MAPSIZE * MAPSIZE submap cache entries borrows one texture for as long as it
+//  lives, entries are recycled for the submaps that come into view
 class pixel_minimap::shared_texture_pool
 {
     public:
@@ -166,8 +165,16 @@ class pixel_minimap::shared_texture_pool
 struct pixel_minimap::submap_cache {
     //the color stored for each submap tile
     std::array<SDL_Color, SEEX *SEEY> minimap_colors = {};
-    //checks if the submap has been looked at by the minimap routine
-    bool touched = false;
+    //the lighting each color was picked for
+    std::array<lit_level, SEEX *SEEY> lighting = {};
+    //the absolute position of the submap this entry currently holds
+    tripoint abs_sm_pos = tripoint_min;
+    //the submap and its revision the colors were picked from, tiles without vehicles only need
+    //new colors when one of these or their lighting changes
+    const submap *source = nullptr;
+    uint64_t source_generation = 0;
+    bool nv_goggles = false;
+    bool colors_valid = false;
     //the texture updates are drawn to
     SDL_Texture_Ptr chunk_tex;
     //the submap being handled
@@ -199,6 +206,19 @@ struct pixel_minimap::submap_cache {
 
         return minimap_colors[p.y * SEEX + p.x];
     }
+
+    lit_level &lighting_at( const point &p ) {
+        return lighting[p.y * SEEX + p.x];
+    }
+
+    //starts over for another submap, the texture is kept and cleared before its next use
+    void reuse_for( const tripoint &pos ) {
+        abs_sm_pos = pos;
+        minimap_colors = {};
+        colors_valid = false;
+        update_list.clear();
+        ready = false;
+    }
 };
 
 pixel_minimap::pixel_minimap( const SDL_Renderer_Ptr &renderer,
@@ -226,48 +246,19 @@ void pixel_minimap::set_settings( const pixel_minimap_settings &settings )
     reset();
 }
 
-void pixel_minimap::prepare_cache_for_updates( const tripoint &center )
-{
-    const tripoint_abs_sm new_center_sm = get_map().get_abs_sub() + coords::project_to<coords::sm>
-                                          ( tripoint_bub_ms( center ) ).raw();
-    const tripoint_rel_sm center_sm_diff = tripoint_abs_sm( cached_center_sm ) - new_center_sm;
-
-    //invalidate the cache if the game shifted more than one submap in the last update, or if z-level changed.
-    if( std::abs( center_sm_diff.x() ) > 1 ||
-        std::abs( center_sm_diff.y() ) > 1 ||
-        std::abs( center_sm_diff.z() ) > 0 ) {
-        cache.clear();
-    } else {
-        for( auto &mcp : cache ) {
-            mcp.second.touched = false;
-        }
-    }
-
-    cached_center_sm = new_center_sm.raw();
-}
-
-//deletes the mapping of unused submap caches from the main map
-//the touched flag prevents deletion
-void pixel_minimap::clear_unused_cache()
-{
-    for( auto it = cache.begin(); it != cache.end(); ) {
-        it = it->second.touched ? std::next( it ) : cache.erase( it );
-    }
-}
-
 //draws individual updates to the submap cache texture
 //the render target will be set back to display_buffer after all submaps are updated
 void pixel_minimap::flush_cache_updates()
 {
-    for( auto &mcp : cache ) {
-        if( mcp.second.update_list.empty() ) {
+    for( submap_cache &entry : cache ) {
+        if( entry.update_list.empty() ) {
             continue;
         }
 
-        SetRenderTarget( renderer, mcp.second.chunk_tex );
+        SetRenderTarget( renderer, entry.chunk_tex );
 
-        if( !mcp.second.ready ) {
-            mcp.second.ready = true;
+        if( !entry.ready ) {
+            entry.ready = true;
 
             SetRenderDrawColor( renderer, 0x00, 0x00, 0x00, 0x00 );
             RenderClear( renderer );
@@ -284,9 +275,9 @@ void pixel_minimap::flush_cache_updates()
             }
         }
 
-        for( const point &p : mcp.second.update_list ) {
+        for( const point &p : entry.update_list ) {
             const point tile_pos = projector->get_tile_pos( p, { SEEX, SEEY } );
-            const SDL_Color tile_color = mcp.second.color_at( p );
+            const SDL_Color tile_color = entry.color_at( p );
 
             if( pixel_size.x == 1 && pixel_size.y == 1 ) {
                 SetRenderDrawColor( renderer, tile_color.r, tile_color.g, tile_color.b, tile_color.a );
@@ -296,7 +287,7 @@ void pixel_minimap::flush_cache_updates()
             }
         }
 
-        mcp.second.update_list.clear();
+        entry.update_list.clear();
     }
 }
 
@@ -310,13 +301,30 @@ void pixel_minimap::update_cache_at( const tripoint &sm_pos )
     submap_cache &cache_item = get_cache_at( here.get_abs_sub().raw() + sm_pos );
     const tripoint_bub_ms ms_pos = coords::project_to<coords::ms>( tripoint_bub_sm( sm_pos ) );
 
-    cache_item.touched = true;
+    const submap *source = here.get_submap_at_grid( tripoint_rel_sm( sm_pos ) );
+    const uint64_t generation = source == nullptr ? 0 : source->get_modified_generation();
+    const bool colors_valid = cache_item.colors_valid && cache_item.source == source &&
+                              cache_item.source_generation == generation &&
+                              cache_item.nv_goggles == nv_goggle;
+    cache_item.colors_valid = true;
+    cache_item.source = source;
+    cache_item.source_generation = generation;
+    cache_item.nv_goggles = nv_goggle;
+    //vehicles move without touching the submap revision
+    const bool vehicles_in_range = access_cache.get_veh_in_active_range();
 
     for( int y = 0; y < SEEY; ++y ) {
         for( int x = 0; x < SEEX; ++x ) {
             const tripoint p = ms_pos.raw() + tripoint{x, y, 0};
             const lit_level lighting = access_cache.visibility_cache[p.x][p.y];
 
+            lit_level &cached_lighting = cache_item.lighting_at( { x, y } );
+            if( colors_valid && cached_lighting == lighting &&
+                !( vehicles_in_range && access_cache.get_veh_exists_at( p ) ) ) {
+                continue;
+            }
+            cached_lighting = lighting;
+
             SDL_Color color;
 
             if( lighting == lit_level::BLANK || lighting == lit_level::DARK ) {
@@ -351,19 +359,23 @@ void pixel_minimap::update_cache_at( const tripoint &sm_pos )
 
 pixel_minimap::submap_cache &pixel_minimap::get_cache_at( const tripoint &abs_sm_pos )
 {
-    auto it = cache.find( abs_sm_pos );
-
-    if( it == cache.end() ) {
-        it = cache.emplace( abs_sm_pos, submap_cache( *tex_pool ) ).first;
+    if( cache.empty() ) {
+        cache.reserve( MAPSIZE * MAPSIZE );
+        for( int i = 0; i < MAPSIZE * MAPSIZE; ++i ) {
+            cache.emplace_back( *tex_pool );
+        }
     }
 
-    return it->second;
+    submap_cache &entry = cache[modulo( abs_sm_pos.y, MAPSIZE ) * MAPSIZE +
+                                        modulo( abs_sm_pos.x, MAPSIZE )];
+    if( entry.abs_sm_pos != abs_sm_pos ) {
+        entry.reuse_for( abs_sm_pos );
+    }
+    return entry;
 }
 
 void pixel_minimap::process_cache( const tripoint &center )
 {
-    prepare_cache_for_updates( center );
-
     for( int y = 0; y < MAPSIZE; ++y ) {
         for( int x = 0; x < MAPSIZE; ++x ) {
             update_cache_at( { x, y, center.z } );
@@ -371,7 +383,6 @@ void pixel_minimap::process_cache( const tripoint &center )
     }
 
     flush_cache_updates();
-    clear_unused_cache();
 }
 
 void pixel_minimap::set_screen_rect( const SDL_Rect &screen_rect )
@@ -470,12 +481,8 @@ void pixel_minimap::render_cache( const tripoint &center )
                                   ( total_tiles_count.y / 2 ) % SEEY );
     ms_offset = ms_base_offset - remainder.raw();
 
-    for( const auto &elem : cache ) {
-        if( !elem.second.touched ) {
-            continue;   // What you gonna do with all that junk?
-        }
-
-        const tripoint rel_pos = elem.first - sm_center.raw();
+    for( const submap_cache &elem : cache ) {
+        const tripoint rel_pos = elem.abs_sm_pos - sm_center.raw();
 
         if( std::abs( rel_pos.x ) > sm_offset.x() + 1 ||
             std::abs( rel_pos.y ) > sm_offset.y() + 1 ||
@@ -488,7 +495,7 @@ void pixel_minimap::render_cache( const tripoint &center )
 
         const SDL_Rect chunk_rect = projector->get_chunk_rect( ms_pos.xy(), { SEEX, SEEY } );
 
-        RenderCopy( renderer, elem.second.chunk_tex, nullptr, &chunk_rect );
+        RenderCopy( renderer, elem.chunk_tex, nullptr, &chunk_rect );
     }
 }
 
@@ -2,8 +2,8 @@
 #ifndef CATA_SRC_PIXEL_MINIMAP_H
 #define CATA_SRC_PIXEL_MINIMAP_H
 
-#include <map>
 #include <memory>
+#include <vector>
 
 #include "point.h"
 #include "sdl_wrappers.h"
@@ -56,8 +56,6 @@ class pixel_minimap
 
         void flush_cache_updates();
         void update_cache_at( const tripoint &pos );
-        void prepare_cache_for_updates( const tripoint &center );
-        void clear_unused_cache();
 
         void render( const tripoint &center );
         void render_cache( const tripoint &center );
@@ -73,9 +71,6 @@ class pixel_minimap
 
         point pixel_size;
 
-        //track the previous viewing area to determine if the minimap cache needs to be cleared
-        tripoint cached_center_sm;
-
         SDL_Rect screen_rect;
         SDL_Rect main_tex_clip_rect;
         SDL_Rect screen_clip_rect;
@@ -88,7 +83,9 @@ class pixel_minimap
         class shared_texture_pool;
         std::unique_ptr<shared_texture_pool> tex_pool;
 
-        std::map<tripoint, submap_cache> cache;
+        //one entry per submap of the reality bubble, indexed by its absolute submap coords modulo
+        //MAPSIZE, so the entries of the submaps that stay in view are kept when the bubble shifts
+        std::vector<submap_cache> cache;
 };
 
 #endif // CATA_SRC_PIXEL_MINIMAP_H
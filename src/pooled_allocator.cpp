@@ -0,0 +1,99 @@
+#include "pooled_allocator.h"
+
+#include <array>
+#include <new>
+#include <vector>
+
+namespace cata
+{
+
+namespace
+{
+
+// Sizes are rounded up to a multiple of this, so blocks of similar sizes can be reused.
+constexpr size_t size_step = 64;
+// Larger blocks are rare, and come straight from the system allocator.
+constexpr size_t max_pooled_size = 64 * 1024;
+constexpr size_t num_size_classes = max_pooled_size / size_step;
+// Most memory a thread keeps for reuse.
+constexpr size_t max_kept_bytes = 32 * 1024 * 1024;
+
+size_t size_class( size_t bytes )
+{
+    return ( bytes - 1 ) / size_step;
+}
+
+struct block_pool {
+    std::array<std::vector<void *>, num_size_classes> free_blocks;
+    size_t kept_bytes = 0;
+
+    ~block_pool();
+};
+
+// Set once the pool of this thread is gone, blocks freed after that go back to the system.
+thread_local bool pool_destroyed = false;
+
+block_pool::~block_pool()
+{
+    for( std::vector<void *> &blocks : free_blocks ) {
+        for( void *p : blocks ) {
+            ::operator delete( p );
+        }
+    }
+    pool_destroyed = true;
+}
+
+block_pool &pool()
+{
+    thread_local block_pool the_pool;
+    return the_pool;
+}
+
+} // namespace
+
+void *detail::pooled_allocate( size_t bytes )
+{
+    if( bytes == 0 || bytes > max_pooled_size ) {
+        return ::operator new( bytes );
+    }
+    const size_t cls = size_class( bytes );
+    if( !pool_destroyed ) {
+        block_pool &p = pool();
+        std::vector<void *> &blocks = p.free_blocks[cls];
+        if( !blocks.empty() ) {
+            void *result = blocks.back();
+            blocks.pop_back();
+            p.kept_bytes -= ( cls + 1 ) * size_step;
+            return result;
+        }
+    }
+    // Always the full size of the class, so the block can be reused for any size within it.
+    return ::operator new( ( cls + 1 ) * size_step );
+}
+
+void detail::pooled_deallocate( void *p, size_t bytes ) noexcept
+{
+    if( p == nullptr ) {
+        return;
+    }
+    if( bytes == 0 || bytes > max_pooled_size || pool_destroyed ) {
+        ::operator delete( p );
+        return;
+    }
+    const size_t cls = size_class( bytes );
+    const size_t block_size = ( cls + 1 ) * size_step;
+    block_pool &pl = pool();
+    if( pl.kept_bytes + block_size > max_kept_bytes ) {
+        ::operator delete( p );
+        return;
+    }
+    try {
+        pl.free_blocks[cls].push_back( p );
+    } catch( const std::bad_alloc & ) {
+        ::operator delete( p );
+        return;
+    }
+    pl.kept_bytes += block_size;
+}
+
+} // namespace cata
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef CATA_SRC_POOLED_ALLOCATOR_H
+#define CATA_SRC_POOLED_ALLOCATOR_H
+
+#include <cstddef>
+
+namespace cata
+{
+
+namespace detail
+{
+void *pooled_allocate( size_t bytes );
+void pooled_deallocate( void *p, size_t bytes ) noexcept;
+} // namespace detail
+
+/**
+ * Allocator that recycles freed blocks of the same size instead of handing them back to the
+ * system allocator.  Containers that make and drop many blocks of a few sizes, like the groups
+ * of the item colony on every map tile, reuse the memory of submaps that got unloaded when new
+ * ones are generated.
+ *
+ * Blocks are kept per thread, up to a limit, and may be freed on another thread than the one
+ * they were allocated on.  The allocator has no state, all instances are interchangeable.
+ */
+template<typename T>
+class pooled_allocator
+{
+    public:
+        using value_type = T;
+
+        pooled_allocator() noexcept = default;
+        template<typename U>
+        // NOLINTNEXTLINE(google-explicit-constructor)
+        pooled_allocator( const pooled_allocator<U> & ) noexcept {}
+
+        T *allocate( size_t n ) {
+            // Checked here, T may still be incomplete where the allocator is named.
+            static_assert( alignof( T ) <= alignof( std::max_align_t ),
+                           "Over-aligned types need an allocator that knows their alignment." );
+            return static_cast<T *>( detail::pooled_allocate( n * sizeof( T ) ) );
+        }
+        void deallocate( T *p, size_t n ) noexcept {
+            detail::pooled_deallocate( p, n * sizeof( T ) );
+        }
+
+        template<typename U>
+        bool operator==( const pooled_allocator<U> & ) const noexcept {
+            return true;
+        }
+        template<typename U>
+        bool operator!=( const pooled_allocator<U> & ) const noexcept {
+            return false;
+        }
+};
+
+} // namespace cata
+
+#endif // CATA_SRC_POOLED_ALLOCATOR_H
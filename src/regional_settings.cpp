@@ -922,6 +922,7 @@ void forest_biome::finalize()
         groundcover.add( tid.id(), pr.second );
     }
 
+    terrain_dependent_furniture.reserve( ter_t::count() );
     for( auto &pr : unfinalized_terrain_dependent_furniture ) {
         pr.second.finalize();
         const ter_id t( pr.first );
@@ -983,6 +984,8 @@ map_extras map_extras::filtered_by( const mapgendata &dat ) const
 
 void region_terrain_and_furniture_settings::finalize()
 {
+    terrain.reserve( ter_t::count() );
+    furniture.reserve( furn_t::count() );
     for( auto const &template_pr : unfinalized_terrain ) {
         const ter_str_id template_tid( template_pr.first );
         if( !template_tid.is_valid() ) {
@@ -1023,9 +1026,9 @@ void region_terrain_and_furniture_settings::finalize()
 ter_id region_terrain_and_furniture_settings::resolve( const ter_id &tid ) const
 {
     ter_id result = tid;
-    auto region_list = terrain.find( result );
-    while( region_list != terrain.end() ) {
-        result = *region_list->second.pick();
+    const weighted_int_list<ter_id> *region_list = terrain.find( result );
+    while( region_list != nullptr ) {
+        result = *region_list->pick();
         region_list = terrain.find( result );
     }
     return result;
@@ -1034,9 +1037,9 @@ ter_id region_terrain_and_furniture_settings::resolve( const ter_id &tid ) const
 furn_id region_terrain_and_furniture_settings::resolve( const furn_id &fid ) const
 {
     furn_id result = fid;
-    auto region_list = furniture.find( result );
-    while( region_list != furniture.end() ) {
-        result = *region_list->second.pick();
+    const weighted_int_list<furn_id> *region_list = furniture.find( result );
+    while( region_list != nullptr ) {
+        result = *region_list->pick();
         region_list = furniture.find( result );
     }
     return result;
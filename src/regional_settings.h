@@ -11,6 +11,7 @@
 #include <vector>
 
 #include "enums.h"
+#include "int_id.h"
 #include "mapdata.h"
 #include "memory_fast.h"
 #include "omdata.h"
@@ -136,7 +137,7 @@ struct forest_biome {
     weighted_int_list<ter_id> groundcover;
     std::map<std::string, forest_biome_terrain_dependent_furniture>
     unfinalized_terrain_dependent_furniture;
-    std::map<ter_id, forest_biome_terrain_dependent_furniture> terrain_dependent_furniture;
+    int_id_map<ter_t, forest_biome_terrain_dependent_furniture> terrain_dependent_furniture;
     int sparseness_adjacency_factor = 0;
     int item_group_chance = 0;
     int item_spawn_iterations = 0;
@@ -258,8 +259,8 @@ struct map_extras {
 struct region_terrain_and_furniture_settings {
     std::map<std::string, std::map<std::string, int>> unfinalized_terrain;
     std::map<std::string, std::map<std::string, int>> unfinalized_furniture;
-    std::map<ter_id, weighted_int_list<ter_id>> terrain;
-    std::map<furn_id, weighted_int_list<furn_id>> furniture;
+    int_id_map<ter_t, weighted_int_list<ter_id>> terrain;
+    int_id_map<furn_t, weighted_int_list<furn_id>> furniture;
 
     void finalize();
     ter_id resolve( const ter_id & ) const;
@@ -3,11 +3,38 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 
 #include "calendar.h"
 #include "cata_utility.h"
+#include "point.h"
 #include "units.h"
 
+// Set by rng_stream_scope.
+static thread_local cata_default_random_engine *stream_engine = nullptr;
+
+#if defined(CATA_FAST_RNG)
+
+unsigned int rng_bits()
+{
+    return static_cast<unsigned int>( rng_get_engine()() >> 32 );
+}
+
+int rng( int lo, int hi )
+{
+    if( lo > hi ) {
+        std::swap( lo, hi );
+    }
+    return rng_get_engine().uniform_int( lo, hi );
+}
+
+static double rng_real( double lo, double hi )
+{
+    return lo + rng_get_engine().uniform_double() * ( hi - lo );
+}
+
+#else
+
 unsigned int rng_bits()
 {
     // Whole uint range.
@@ -24,14 +51,22 @@ int rng( int lo, int hi )
     return rng_int_dist( rng_get_engine(), std::uniform_int_distribution<>::param_type( lo, hi ) );
 }
 
-double rng_float( double lo, double hi )
+static double rng_real( double lo, double hi )
 {
     static std::uniform_real_distribution<double> rng_real_dist;
+    return rng_real_dist( rng_get_engine(),
+                          std::uniform_real_distribution<>::param_type( lo, hi ) );
+}
+
+#endif // CATA_FAST_RNG
+
+double rng_float( double lo, double hi )
+{
     if( lo > hi ) {
         std::swap( lo, hi );
     }
     if( std::isfinite( lo ) && std::isfinite( hi ) ) {
-        return rng_real_dist( rng_get_engine(), std::uniform_real_distribution<>::param_type( lo, hi ) );
+        return rng_real( lo, hi );
     }
     debugmsg( "rng_float called with nan/inf" );
     return 0;
@@ -77,8 +112,14 @@ float normal_roll_chance( float center, float stddev, float difficulty )
 
 double normal_roll( double mean, double stddev )
 {
+    const std::normal_distribution<>::param_type param( mean, stddev );
+    if( stream_engine != nullptr ) {
+        // The shared distribution keeps a spare value, which would leak between streams.
+        std::normal_distribution<double> stream_dist;
+        return stream_dist( *stream_engine, param );
+    }
     static std::normal_distribution<double> rng_normal_dist;
-    return rng_normal_dist( rng_get_engine(), std::normal_distribution<>::param_type( mean, stddev ) );
+    return rng_normal_dist( rng_get_engine(), param );
 }
 
 double exponential_roll( double lambda )
@@ -198,11 +239,51 @@ cata_default_random_engine::result_type rng_get_first_seed()
 
 cata_default_random_engine &rng_get_engine()
 {
+    if( stream_engine != nullptr ) {
+        return *stream_engine;
+    }
     // NOLINTNEXTLINE(cata-determinism)
     static cata_default_random_engine eng( rng_get_first_seed() );
     return eng;
 }
 
+// SplitMix64 finalizer, so that neighbouring keys give unrelated seeds.
+static uint64_t mix_seed( uint64_t x )
+{
+    x += 0x9e3779b97f4a7c15ULL;
+    x = ( x ^ ( x >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+    x = ( x ^ ( x >> 27 ) ) * 0x94d049bb133111ebULL;
+    return x ^ ( x >> 31 );
+}
+
+std::optional<cata_default_random_engine> rng_stream_engine( unsigned int seed,
+        rng_stream stream, const tripoint &key )
+{
+    if( seed == 0 ) {
+        return std::nullopt;
+    }
+    uint64_t h = mix_seed( seed );
+    h = mix_seed( h ^ static_cast<uint64_t>( stream ) );
+    h = mix_seed( h ^ static_cast<uint32_t>( key.x ) );
+    h = mix_seed( h ^ static_cast<uint32_t>( key.y ) );
+    h = mix_seed( h ^ static_cast<uint32_t>( key.z ) );
+    return cata_default_random_engine(
+               static_cast<cata_default_random_engine::result_type>( h >> 32 ) );
+}
+
+rng_stream_scope::rng_stream_scope( std::optional<cata_default_random_engine> &engine )
+    : previous( stream_engine )
+{
+    if( engine ) {
+        stream_engine = &*engine;
+    }
+}
+
+rng_stream_scope::~rng_stream_scope()
+{
+    stream_engine = previous;
+}
+
 void rng_set_engine_seed( unsigned int seed )
 {
     if( seed != 0 ) {
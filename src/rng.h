@@ -4,6 +4,7 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <iterator>
 #include <optional>
@@ -25,11 +26,135 @@ class tripoint_range;
 // seeded (or re-seeded) with the given seed.
 void rng_set_engine_seed( unsigned int seed );
 
+namespace cata
+{
+
+/**
+ * The xoshiro256** generator of Blackman and Vigna: 64 random bits from a few shifts and
+ * adds, with a period of 2^256 - 1.  Seeded through SplitMix64 as its authors recommend, so
+ * that any seed, including zero, gives a good state.
+ */
+class xoshiro256ss
+{
+    public:
+        using result_type = uint64_t;
+
+        explicit xoshiro256ss( result_type seed_value = 1 ) {
+            seed( seed_value );
+        }
+
+        static constexpr result_type min() {
+            return 0;
+        }
+        static constexpr result_type max() {
+            return UINT64_MAX;
+        }
+
+        void seed( result_type seed_value ) {
+            for( result_type &word : state ) {
+                seed_value += 0x9e3779b97f4a7c15ULL;
+                result_type z = seed_value;
+                z = ( z ^ ( z >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+                z = ( z ^ ( z >> 27 ) ) * 0x94d049bb133111ebULL;
+                word = z ^ ( z >> 31 );
+            }
+        }
+
+        result_type operator()() {
+            const result_type result = rotl( state[1] * 5, 7 ) * 9;
+            const result_type t = state[1] << 17;
+            state[2] ^= state[0];
+            state[3] ^= state[1];
+            state[1] ^= state[2];
+            state[0] ^= state[3];
+            state[2] ^= t;
+            state[3] = rotl( state[3], 45 );
+            return result;
+        }
+
+        void discard( unsigned long long count ) {
+            for( ; count > 0; --count ) {
+                ( *this )();
+            }
+        }
+
+        /** Uniform in [lo, hi], without the modulo bias and mostly without a division. */
+        int uniform_int( int lo, int hi ) {
+            // Lemire's multiply and shift, on the top 32 bits.
+            const uint64_t range = static_cast<uint64_t>( static_cast<int64_t>( hi ) - lo ) + 1;
+            uint64_t m = ( ( *this )() >> 32 ) * range;
+            if( static_cast<uint32_t>( m ) < range ) {
+                const uint32_t threshold = static_cast<uint32_t>( ( UINT64_C( 1 ) << 32 ) % range );
+                while( static_cast<uint32_t>( m ) < threshold ) {
+                    m = ( ( *this )() >> 32 ) * range;
+                }
+            }
+            return static_cast<int>( static_cast<int64_t>( lo ) + static_cast<int64_t>( m >> 32 ) );
+        }
+
+        /** Uniform in [0, 1), with all 53 bits of the mantissa random. */
+        double uniform_double() {
+            return static_cast<double>( ( *this )() >> 11 ) * 0x1.0p-53;
+        }
+
+        bool operator==( const xoshiro256ss &rhs ) const {
+            return state == rhs.state;
+        }
+        bool operator!=( const xoshiro256ss &rhs ) const {
+            return state != rhs.state;
+        }
+
+    private:
+        static constexpr result_type rotl( result_type x, int k ) {
+            return ( x << k ) | ( x >> ( 64 - k ) );
+        }
+
+        std::array<result_type, 4> state;
+};
+
+} // namespace cata
+
+// Builds with CATA_FAST_RNG (make FAST_RNG=1, or the CMake option of the same name) use
+// xoshiro256** and draw from it without distribution objects.  Saves and seeded tests give
+// different numbers with the two engines, so the choice is made per build.
+#if defined(CATA_FAST_RNG)
+using cata_default_random_engine = cata::xoshiro256ss;
+#else
 using cata_default_random_engine = std::minstd_rand0;
+#endif
 cata_default_random_engine::result_type rng_get_first_seed();
+// The engine of the innermost rng_stream_scope of this thread, else the global engine.
 cata_default_random_engine &rng_get_engine();
 unsigned int rng_bits();
 
+// Separate streams of random numbers, so that generating something draws the same
+// numbers however much else drew from the global engine before it.
+enum class rng_stream : int {
+    mapgen,
+    overmap_generation,
+};
+
+// An engine that depends only on the arguments: @p seed (the world's), which stream it is
+// and @p key (the coordinates of what is generated).  None for a world without a seed, as in
+// the tests, which keeps drawing from the global engine so that each generation differs.
+std::optional<cata_default_random_engine> rng_stream_engine( unsigned int seed,
+        rng_stream stream, const tripoint &key );
+
+/**
+ * While it lives, all the rng functions on this thread draw from @p engine instead of the
+ * global engine, which is left as it was.  Does nothing if there is no engine.  Scopes nest.
+ */
+class rng_stream_scope
+{
+    public:
+        explicit rng_stream_scope( std::optional<cata_default_random_engine> &engine );
+        ~rng_stream_scope();
+        rng_stream_scope( const rng_stream_scope & ) = delete;
+        rng_stream_scope &operator=( const rng_stream_scope & ) = delete;
+    private:
+        cata_default_random_engine *previous;
+};
+
 int rng( int lo, int hi );
 double rng_float( double lo, double hi );
 
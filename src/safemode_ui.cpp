@@ -661,22 +661,24 @@ void safemode::add_rules( const std::vector<rules_class> &rules_in )
     //if a specific monster is being added, all the rules need to be checked now
     //may have some performance issues since exclusion needs to check all monsters also
     for( const rules_class &rule : rules_in ) {
+        const wildcard_matcher matches( rule.rule );
         switch( rule.category ) {
             case Categories::HOSTILE_SPOTTED:
                 if( !rule.whitelist ) {
                     //Check include patterns against all monster mtypes
                     for( const mtype &mtype : MonsterGenerator::generator().get_all_mtypes() ) {
-                        set_rule( rule, mtype.nname(), rule_state::BLACKLISTED );
+                        set_rule( rule, matches, mtype.nname(), rule_state::BLACKLISTED );
                     }
                 } else {
                     //exclude monsters from the existing mapping
                     for( const auto &safemode_rule : safemode_rules_hostile ) {
-                        set_rule( rule, safemode_rule.first, rule_state::WHITELISTED );
+                        set_rule( rule, matches, safemode_rule.first, rule_state::WHITELISTED );
                     }
                 }
                 break;
             case Categories::SOUND:
-                set_rule( rule, rule.rule, rule.whitelist ? rule_state::WHITELISTED : rule_state::BLACKLISTED );
+                set_rule( rule, matches, rule.rule,
+                          rule.whitelist ? rule_state::WHITELISTED : rule_state::BLACKLISTED );
                 break;
             default:
                 break;
@@ -684,8 +686,13 @@ void safemode::add_rules( const std::vector<rules_class> &rules_in )
     }
 }
 
-void safemode::set_rule( const rules_class &rule_in, const std::string &name_in, rule_state rs_in )
+void safemode::set_rule( const rules_class &rule_in, const wildcard_matcher &matches,
+                         const std::string &name_in, rule_state rs_in )
 {
+    if( rule_in.category == Categories::HOSTILE_SPOTTED &&
+        ( rule_in.rule.empty() || !rule_in.active || !matches( name_in ) ) ) {
+        return;
+    }
     static std::vector<Creature::Attitude> attitude_any = { {Creature::Attitude::HOSTILE, Creature::Attitude::NEUTRAL, Creature::Attitude::FRIENDLY} };
     std::vector<MovementModes> movement_modes;
     if( rule_in.movement_mode == MovementModes::BOTH ) {
@@ -695,25 +702,23 @@ void safemode::set_rule( const rules_class &rule_in, const std::string &name_in,
     }
     switch( rule_in.category ) {
         case Categories::HOSTILE_SPOTTED:
-            if( !rule_in.rule.empty() && rule_in.active && wildcard_match( name_in, rule_in.rule ) ) {
-                for( MovementModes mode : movement_modes ) {
-                    if( rule_in.attitude == Creature::Attitude::ANY ) {
-                        for( Creature::Attitude &att : attitude_any ) {
-                            safemode_rules_hostile[name_in][static_cast<int>( mode )][static_cast<int>
-                                    ( att )] = rule_state_class( rs_in,
-                                                                 rule_in.proximity, Categories::HOSTILE_SPOTTED );
-                        }
-                    } else {
+            for( MovementModes mode : movement_modes ) {
+                if( rule_in.attitude == Creature::Attitude::ANY ) {
+                    for( Creature::Attitude &att : attitude_any ) {
                         safemode_rules_hostile[name_in][static_cast<int>( mode )][static_cast<int>
-                                ( rule_in.attitude )] = rule_state_class( rs_in,
-                                                        rule_in.proximity, Categories::HOSTILE_SPOTTED );
+                                ( att )] = rule_state_class( rs_in, rule_in.proximity,
+                                                             Categories::HOSTILE_SPOTTED );
                     }
+                } else {
+                    safemode_rules_hostile[name_in][static_cast<int>( mode )][static_cast<int>
+                            ( rule_in.attitude )] = rule_state_class( rs_in, rule_in.proximity,
+                                                    Categories::HOSTILE_SPOTTED );
                 }
             }
             break;
         case Categories::SOUND:
             for( MovementModes mode : movement_modes ) {
-                safemode_rules_sound[static_cast<int>( mode )].push_back( rule_in );
+                safemode_rules_sound[static_cast<int>( mode )].emplace_back( rule_in, matches );
             }
             break;
         default:
@@ -751,8 +756,8 @@ bool safemode::is_sound_safe( const std::string &sound_name_in,
     bool sound_safe = false;
     const int movement_mode = static_cast<int>( driving ? MovementModes::DRIVING :
                               MovementModes::WALKING );
-    for( const rules_class &rule : safemode_rules_sound[movement_mode] ) {
-        if( wildcard_match( sound_name_in, rule.rule ) &&
+    for( const auto &[rule, matches] : safemode_rules_sound[movement_mode] ) {
+        if( matches( sound_name_in ) &&
             proximity_in >= rule.proximity ) {
             if( rule.whitelist ) {
                 sound_safe = true;
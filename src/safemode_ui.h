@@ -6,8 +6,10 @@
 #include <iosfwd>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "cata_utility.h"
 #include "creature.h"
 #include "enums.h"
 
@@ -76,8 +78,10 @@ class safemode
         // NOLINTNEXTLINE(cata-serialize)
         std::unordered_map < std::string, std::array < std::array < rule_state_class, 3 >, 2 >>
                 safemode_rules_hostile; // NOLINT(cata-serialize)
+        // The sound rules for each movement mode, with their patterns compiled
         // NOLINTNEXTLINE(cata-serialize)
-        std::array < std::vector < rules_class >, 2 > safemode_rules_sound;
+        std::array < std::vector < std::pair<rules_class, wildcard_matcher> >, 2 >
+        safemode_rules_sound;
 
         /**
          * current rules for global and character tab
@@ -94,7 +98,8 @@ class safemode
 
         void create_rules();
         void add_rules( const std::vector<rules_class> &rules_in );
-        void set_rule( const rules_class &rule_in, const std::string &name_in, rule_state rs_in );
+        void set_rule( const rules_class &rule_in, const wildcard_matcher &matches,
+                       const std::string &name_in, rule_state rs_in );
 
     public:
         std::string lastmon_whitelist; // NOLINT(cata-serialize)
@@ -23,6 +23,7 @@
 #include "faction.h"
 #include "hash_utils.h"
 #include "input.h"
+#include "item_location.h"
 #include "json.h"
 #include "json_loader.h"
 #include "kill_tracker.h"
@@ -90,6 +91,9 @@ void game::serialize( std::ostream &fout )
     // Header
     fout << "# version " << savegame_version << std::endl;
 
+    // Activities can hold many item_locations into the same inventory or square.
+    const item_location::index_cache_scope item_indices;
+
     JsonOut json( fout, true ); // pretty-print
 
     json.start_object();
@@ -400,6 +404,101 @@ void overmap::load_legacy_monstergroups( const JsonArray &jsin )
     }
 }
 
+static void write_json_copy( JsonOut &jsout, const JsonValue &jsin )
+{
+    if( jsin.test_object() ) {
+        jsout.start_object();
+        for( JsonMember member : jsin.get_object() ) {
+            jsout.member( member.name() );
+            write_json_copy( jsout, member );
+        }
+        jsout.end_object();
+    } else if( jsin.test_array() ) {
+        jsout.start_array();
+        for( JsonValue value : jsin.get_array() ) {
+            write_json_copy( jsout, value );
+        }
+        jsout.end_array();
+    } else if( jsin.test_string() ) {
+        jsout.write( jsin.get_string() );
+    } else if( jsin.test_bool() ) {
+        jsout.write( jsin.get_bool() );
+    } else if( jsin.test_int() ) {
+        jsout.write( jsin.get_int64() );
+    } else if( jsin.test_float() ) {
+        jsout.write( jsin.get_float() );
+    } else {
+        jsout.write_null();
+    }
+}
+
+// The loaded json is only valid while the overmap file is being read, a deferred part of it
+// is kept as text instead.
+static std::string json_copy_to_string( const JsonValue &jsin )
+{
+    std::ostringstream buffer;
+    JsonOut jsout( buffer );
+    write_json_copy( jsout, jsin );
+    return buffer.str();
+}
+
+void overmap::load_npc( const JsonObject &npc_json ) const
+{
+    shared_ptr_fast<npc> new_npc = make_shared_fast<npc>();
+    new_npc->deserialize( npc_json );
+    if( !new_npc->get_fac_id().str().empty() ) {
+        new_npc->set_fac( new_npc->get_fac_id() );
+    }
+    npcs.push_back( new_npc );
+}
+
+void overmap::load_npcs() const
+{
+    if( unloaded_npcs.empty() ) {
+        return;
+    }
+    // Cleared first, so a throwing npc doesn't leave the rest to be loaded twice.
+    const std::string npcs_json = std::move( unloaded_npcs );
+    unloaded_npcs.clear();
+    unloaded_npc_summaries.clear();
+    const JsonValue jsin = json_loader::from_string( npcs_json );
+    for( JsonObject npc_json : jsin.get_array() ) {
+        load_npc( npc_json );
+    }
+}
+
+bool overmap::load_npc_summaries( const JsonArray &summaries_json, const size_t npc_count ) const
+{
+    if( summaries_json.size() != npc_count ) {
+        return false;
+    }
+    bool all_here = true;
+    for( JsonObject summary : summaries_json ) {
+        summary.allow_omitted_members();
+        tripoint_abs_ms location;
+        if( !summary.read( "location", location ) ||
+            project_to<coords::om>( location.xy() ) != pos() ) {
+            // fix_npcs has to move it, which needs the whole npc.
+            all_here = false;
+        }
+    }
+    if( !all_here ) {
+        return false;
+    }
+    // Faction membership is rebuilt from the npcs on load, it must not wait for them.
+    for( JsonObject summary : summaries_json ) {
+        if( !summary.has_member( "faction" ) ) {
+            continue;
+        }
+        faction *fac = g->faction_manager_ptr->get( faction_id( summary.get_string( "faction" ) ) );
+        if( fac ) {
+            fac->add_to_membership( character_id( summary.get_int( "id" ) ),
+                                    summary.get_string( "name" ), summary.get_bool( "known" ) );
+        }
+    }
+    return true;
+}
+
 // throws std::exception
 void overmap::unserialize( const cata_path &file_name, std::istream &fin )
 {
@@ -614,13 +713,14 @@ void overmap::unserialize( const JsonObject &jsobj )
             }
         } else if( name == "npcs" ) {
             JsonArray npcs_json = om_member;
-            for( JsonObject npc_json : npcs_json ) {
-                shared_ptr_fast<npc> new_npc = make_shared_fast<npc>();
-                new_npc->deserialize( npc_json );
-                if( !new_npc->get_fac_id().str().empty() ) {
-                    new_npc->set_fac( new_npc->get_fac_id() );
+            if( npcs_json.size() != 0 && jsobj.has_array( "npc_summaries" ) &&
+                load_npc_summaries( jsobj.get_array( "npc_summaries" ), npcs_json.size() ) ) {
+                unloaded_npcs = json_copy_to_string( om_member );
+                unloaded_npc_summaries = json_copy_to_string( jsobj.get_member( "npc_summaries" ) );
+            } else {
+                for( JsonObject npc_json : npcs_json ) {
+                    load_npc( npc_json );
                 }
-                npcs.push_back( new_npc );
             }
         } else if( name == "camps" ) {
             JsonArray camps_json = om_member;
@@ -1309,11 +1409,39 @@ void overmap::serialize( std::ostream &fout ) const
     fout << std::endl;
 
     json.member( "npcs" );
-    json.start_array();
-    for( const auto &i : npcs ) {
-        json.write( *i );
+    if( !unloaded_npcs.empty() ) {
+        *json.get_stream() << unloaded_npcs;
+        json.set_need_separator();
+    } else {
+        const item_location::index_cache_scope item_indices;
+        json.start_array();
+        for( const auto &i : npcs ) {
+            json.write( *i );
+        }
+        json.end_array();
+    }
+    fout << std::endl;
+
+    // Lets the next load defer the npcs, see load_npc_summaries.
+    json.member( "npc_summaries" );
+    if( !unloaded_npc_summaries.empty() ) {
+        *json.get_stream() << unloaded_npc_summaries;
+        json.set_need_separator();
+    } else {
+        json.start_array();
+        for( const auto &guy : npcs ) {
+            json.start_object();
+            json.member( "id", guy->getID() );
+            json.member( "location", guy->get_location() );
+            if( !guy->get_fac_id().str().empty() && !guy->is_fake() && !guy->is_hallucination() ) {
+                json.member( "faction", guy->get_fac_id() );
+                json.member( "name", guy->disp_name() );
+                json.member( "known", guy->get_known_to_u() );
+            }
+            json.end_object();
+        }
+        json.end_array();
     }
-    json.end_array();
     fout << std::endl;
 
     json.member( "camps" );
@@ -1743,6 +1871,7 @@ void creature_tracker::deserialize( const JsonArray &ja )
 {
     monsters_list.clear();
     monsters_by_location.clear();
+    monsters_by_submap.clear();
     for( JsonValue jv : ja ) {
         // TODO: would be nice if monster had a constructor using JsonIn or similar, so this could be one statement.
         shared_ptr_fast<monster> mptr = make_shared_fast<monster>();
@@ -36,6 +36,7 @@
 #include "activity_actor_definitions.h"
 #include "activity_type.h"
 #include "addiction.h"
+#include "alloc_profiler.h"
 #include "assign.h"
 #include "auto_pickup.h"
 #include "avatar.h"
@@ -2903,6 +2904,7 @@ void item::io( Archive &archive )
     erase_if( item_tags, [&]( const flag_id & f ) {
         return !f.is_valid();
     } );
+    update_flag_bits();
 
     if( note_read ) {
         snip_id = SNIPPET.migrate_hash_to_id( note );
@@ -2964,13 +2966,9 @@ void item::io( Archive &archive )
     // Books without any chapters don't need to store a remaining-chapters
     // counter, it will always be 0 and it prevents proper stacking.
     if( get_chapters() == 0 ) {
-        for( auto it = item_vars.begin(); it != item_vars.end(); ) {
-            if( it->first.compare( 0, 19, "remaining-chapters-" ) == 0 ) {
-                item_vars.erase( it++ );
-            } else {
-                ++it;
-            }
-        }
+        item_vars.erase_if( []( const item_var_map::value_type & var ) {
+            return string_starts_with( var.first.str(), "remaining-chapters-" );
+        } );
     }
 
     static const std::set<std::string> removed_item_vars = {
@@ -3047,6 +3045,7 @@ void item::migrate_content_item( const item &contained )
 
 void item::deserialize( const JsonObject &data )
 {
+    const alloc_profiler::scoped_tag alloc_tag( alloc_profiler::tag::items );
     data.allow_omitted_members();
     // Since deserialization is handled by the archive, don't check it here.
     // CATA_DO_NOT_CHECK_SERIALIZE
@@ -3163,7 +3162,7 @@ void vehicle_part::deserialize( const JsonObject &data )
     data.read( "mount_dx", mount.x() );
     data.read( "mount_dy", mount.y() );
     data.read( "open", open );
-    int direction_int;
+    int direction_int = 0;
     data.read( "direction", direction_int );
     direction = units::from_degrees( direction_int );
     data.read( "blood", blood );
@@ -3219,13 +3218,19 @@ void vehicle_part::serialize( JsonOut &json ) const
     json.member( "base", base );
     json.member( "mount_dx", mount.x() );
     json.member( "mount_dy", mount.y() );
-    json.member( "open", open );
+    // Members still at their defaults are left out; deserialize() keeps the default when a
+    // member is missing, and parked vehicles are mostly made of parts in that state.
+    if( open ) {
+        json.member( "open", open );
+    }
     json.member( "direction", std::lround( to_degrees( direction ) ) );
-    json.member( "blood", blood );
+    if( blood != 0 ) {
+        json.member( "blood", blood );
+    }
     json.member( "enabled", enabled );
     json.member( "flags", flags );
     if( !carried_stack.empty() ) {
-        std::stack<vehicle_part::carried_part_data> carried_copy = carried_stack;
+        decltype( carried_stack ) carried_copy = carried_stack;
         json.member( "carried_stack" );
         json.start_array();
         while( !carried_copy.empty() ) {
@@ -3234,14 +3239,24 @@ void vehicle_part::serialize( JsonOut &json ) const
         }
         json.end_array();
     }
-    json.member( "passenger_id", passenger_id );
-    json.member( "crew_id", crew_id );
+    if( passenger_id.is_valid() ) {
+        json.member( "passenger_id", passenger_id );
+    }
+    if( crew_id.is_valid() ) {
+        json.member( "crew_id", crew_id );
+    }
     if( precalc[0].z() ) {
         json.member( "z_offset", precalc[0].z() );
     }
-    json.member( "items", items );
-    json.member( "tools", tools );
-    json.member( "salvageable", salvageable );
+    if( !items.empty() ) {
+        json.member( "items", items );
+    }
+    if( !tools.empty() ) {
+        json.member( "tools", tools );
+    }
+    if( !salvageable.empty() ) {
+        json.member( "salvageable", salvageable );
+    }
     if( target.first != tripoint_abs_ms_min ) {
         json.member( "target_first_x", target.first.x() );
         json.member( "target_first_y", target.first.y() );
@@ -3252,9 +3267,15 @@ void vehicle_part::serialize( JsonOut &json ) const
         json.member( "target_second_y", target.second.y() );
         json.member( "target_second_z", target.second.z() );
     }
-    json.member( "ammo_pref", ammo_pref );
-    json.member( "locked", locked );
-    json.member( "last_disconnected", last_disconnected );
+    if( !ammo_pref.is_null() ) {
+        json.member( "ammo_pref", ammo_pref );
+    }
+    if( locked ) {
+        json.member( "locked", locked );
+    }
+    if( last_disconnected != calendar::before_time_starts ) {
+        json.member( "last_disconnected", last_disconnected );
+    }
     json.member( "last_charged", last_charged );
     json.end_object();
 }
@@ -3863,9 +3884,36 @@ void player_morale::load( const JsonObject &jsin )
 {
     jsin.allow_omitted_members();
     jsin.read( "morale", points );
+    invalidate();
 }
 
-void mm_submap::serialize( JsonOut &jsout ) const
+/**
+ * The tile ids used in one saved region, the saved tiles refer to them by their index
+ * in @ref ids, so each id is only written once per region.
+ */
+struct mm_region_palette {
+    // memorized tile id of each entry
+    std::vector<uint32_t> ids;
+    // entry of each memorized tile id, only used while saving
+    std::unordered_map<uint32_t, int> entries;
+
+    int entry( uint32_t id ) {
+        const auto it = entries.emplace( id, static_cast<int>( ids.size() ) );
+        if( it.second ) {
+            ids.push_back( id );
+        }
+        return it.first->second;
+    }
+
+    uint32_t id( int entry, const JsonArray &ja, int index ) const {
+        if( entry < 0 || static_cast<size_t>( entry ) >= ids.size() ) {
+            ja.throw_error( index, "Tile id index out of range" );
+        }
+        return ids[entry];
+    }
+};
+
+void mm_submap::serialize( JsonOut &jsout, mm_region_palette &palette ) const
 {
     jsout.start_array();
 
@@ -3878,11 +3926,11 @@ void mm_submap::serialize( JsonOut &jsout ) const
         jsout.start_array();
         jsout.write( num_same );
         jsout.write( last.symbol );
-        jsout.write( last.ter_id );
+        jsout.write( palette.entry( last.ter_id ) );
         jsout.write( static_cast<int>( last.ter_subtile ) );
         jsout.write( static_cast<int>( last.ter_rotation ) );
-        if( !last.get_dec_id().empty() ) {
-            jsout.write( last.dec_id );
+        if( last.dec_id != 0 ) {
+            jsout.write( palette.entry( last.dec_id ) );
             jsout.write( static_cast<int>( last.dec_subtile ) );
             jsout.write( static_cast<int>( last.dec_rotation ) );
         }
@@ -3910,7 +3958,8 @@ void mm_submap::serialize( JsonOut &jsout ) const
     jsout.end_array();
 }
 
-void mm_submap::deserialize( int version, const JsonArray &ja )
+void mm_submap::deserialize( int version, const JsonArray &ja,
+                             const mm_region_palette &palette )
 {
     size_t submap_array_idx = 0;
 
@@ -3940,7 +3989,7 @@ void mm_submap::deserialize( int version, const JsonArray &ja )
                         tile.set_dec_id( std::move( id ) );
                         tile.set_dec_subtile( ja_tile.get_int( 1 ) );
                         const int legacy_rotation = ja_tile.get_int( 2 );
-                        if( string_starts_with( tile.dec_id, "vp_" ) ) {
+                        if( string_starts_with( tile.get_dec_id(), "vp_" ) ) {
                             // legacy vehicle rotation needs to be converted from 0-360 degrees
                             // to 0-3 tileset rotation
                             const units::angle legacy_angle = units::from_degrees( legacy_rotation );
@@ -3956,15 +4005,23 @@ void mm_submap::deserialize( int version, const JsonArray &ja )
                 } else {
                     remaining = ja_tile.get_int( 0 ) - 1;
                     tile.symbol = ja_tile.get_int( 1 );
-                    tile.set_ter_id( ja_tile.get_string( 2 ) );
+                    if( version < 2 ) {
+                        tile.set_ter_id( ja_tile.get_string( 2 ) );
+                    } else {
+                        tile.ter_id = palette.id( ja_tile.get_int( 2 ), ja_tile, 2 );
+                    }
                     tile.ter_subtile = ja_tile.get_int( 3 );
                     tile.ter_rotation = ja_tile.get_int( 4 );
                     if( ja_tile.size() > 5 ) {
-                        tile.set_dec_id( ja_tile.get_string( 5 ) );
+                        if( version < 2 ) {
+                            tile.set_dec_id( ja_tile.get_string( 5 ) );
+                        } else {
+                            tile.dec_id = palette.id( ja_tile.get_int( 5 ), ja_tile, 5 );
+                        }
                         tile.dec_subtile = ja_tile.get_int( 6 );
                         tile.dec_rotation = ja_tile.get_int( 7 );
                     } else {
-                        tile.set_dec_id( "" );
+                        tile.dec_id = 0;
                         tile.dec_subtile = 0;
                         tile.dec_rotation = 0;
                     }
@@ -3976,12 +4033,15 @@ void mm_submap::deserialize( int version, const JsonArray &ja )
             }
         }
     }
+    // Same as on disk.
+    dirty = false;
 }
 
 void mm_region::serialize( JsonOut &jsout ) const
 {
+    mm_region_palette palette;
     jsout.start_object();
-    jsout.member( "version", 1 );
+    jsout.member( "version", 2 );
     jsout.write( "data" );
     jsout.write_member_separator();
     jsout.start_array();
@@ -3992,11 +4052,18 @@ void mm_region::serialize( JsonOut &jsout ) const
             if( sm->is_empty() ) {
                 jsout.write_null();
             } else {
-                sm->serialize( jsout );
+                sm->serialize( jsout, palette );
             }
         }
     }
     jsout.end_array();
+    // Written last, it's only complete after all the tiles have been written.
+    jsout.member( "palette" );
+    jsout.start_array();
+    for( const uint32_t id : palette.ids ) {
+        jsout.write( memorized_tile::id_str( id ) );
+    }
+    jsout.end_array();
     jsout.end_object();
 }
 
@@ -4004,6 +4071,7 @@ void mm_region::deserialize( const JsonValue &ja )
 {
     int version;
     JsonArray region_json;
+    mm_region_palette palette;
 
     if( ja.test_array() ) { // legacy, remove after 0.H comes out
         version = 0;
@@ -4012,6 +4080,11 @@ void mm_region::deserialize( const JsonValue &ja )
         JsonObject region_obj = ja;
         version = region_obj.get_int( "version" );
         region_json = region_obj.get_array( "data" );
+        if( version >= 2 ) {
+            for( const std::string id : region_obj.get_array( "palette" ) ) {
+                palette.ids.push_back( memorized_tile::intern_id( id ) );
+            }
+        }
     }
 
     for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
@@ -4021,7 +4094,7 @@ void mm_region::deserialize( const JsonValue &ja )
             sm = make_shared_fast<mm_submap>();
             const JsonValue jsin = region_json.next_value();
             if( !jsin.test_null() ) {
-                sm->deserialize( version, jsin );
+                sm->deserialize( version, jsin, palette );
             }
         }
     }
@@ -4515,6 +4588,7 @@ void stats_tracker::deserialize( const JsonObject &jo )
         d.second.set_type( d.first );
     }
     jo.read( "initial_scores", initial_scores );
+    refresh_states();
 
     // TODO: remove after 0.H
     // migration for saves made before addition of event_type::game_avatar_new
@@ -4627,6 +4701,38 @@ void ter_furn_migrations::check()
     }
 }
 
+std::pair<ter_id, furn_id> ter_furn_migrations::migrate( const ter_str_id &ter )
+{
+    ter_str_id terstr = ter;
+    furn_id furn = furn_str_id::NULL_ID().id();
+    if( auto it = ter_migrations.find( terstr ); it != ter_migrations.end() ) {
+        terstr = it->second.first;
+        furn = it->second.second.id();
+    }
+    if( terstr.is_valid() ) {
+        return { terstr.id(), furn };
+    }
+    debugmsg( "invalid ter_str_id '%s'", terstr.c_str() );
+    return { ter_t_dirt, furn };
+}
+
+std::pair<ter_id, furn_id> ter_furn_migrations::migrate( const furn_str_id &furn )
+{
+    furn_str_id furnstr = furn;
+    ter_id ter = ter_str_id::NULL_ID().id();
+    if( auto it = furn_migrations.find( furnstr ); it != furn_migrations.end() ) {
+        furnstr = it->second.second;
+        if( it->second.first != ter_str_id::NULL_ID() ) {
+            ter = it->second.first.id();
+        }
+    }
+    if( furnstr.is_valid() ) {
+        return { ter, furnstr.id() };
+    }
+    debugmsg( "invalid furn_str_id '%s'", furnstr.c_str() );
+    return { ter, furn_str_id::NULL_ID().id() };
+}
+
 static std::unordered_map<field_type_str_id, field_type_str_id> field_migrations;
 
 void field_type_migrations::load( const JsonObject &jo )
@@ -4654,8 +4760,7 @@ void field_type_migrations::check()
 
 void submap::store( JsonOut &jsout ) const
 {
-    jsout.member( "turn_last_touched", last_touched );
-    jsout.member( "temperature", temperature_mod );
+    store_header( jsout );
 
     // Terrain is saved using a simple RLE scheme.  Legacy saves don't have
     // this feature but the algorithm is backward compatible.
@@ -4744,6 +4849,17 @@ void submap::store( JsonOut &jsout ) const
     }
     jsout.end_array();
 
+    store_contents( jsout );
+}
+
+void submap::store_header( JsonOut &jsout ) const
+{
+    jsout.member( "turn_last_touched", last_touched );
+    jsout.member( "temperature", temperature_mod );
+}
+
+void submap::store_contents( JsonOut &jsout ) const
+{
     jsout.member( "items" );
     jsout.start_array();
     for( int j = 0; j < SEEY; j++ ) {
@@ -4924,19 +5040,8 @@ void submap::load( const JsonValue &jv, const std::string &member_name, int vers
                 for( int i = 0; i < SEEX; i++ ) {
                     if( !remaining ) {
                         JsonValue terrain_entry = terrain_json.next_value();
-                        auto migrate_terstr = [&]( ter_str_id terstr ) {
-                            if( auto it = ter_migrations.find( terstr ); it != ter_migrations.end() ) {
-                                terstr = it->second.first;
-                                iid_furn = it->second.second.id();
-                            } else {
-                                iid_furn = furn_str_id::NULL_ID().id();
-                            }
-                            if( terstr.is_valid() ) {
-                                iid_ter = terstr.id();
-                            } else {
-                                debugmsg( "invalid ter_str_id '%s'", terstr.c_str() );
-                                iid_ter = ter_t_dirt;
-                            }
+                        auto migrate_terstr = [&]( const ter_str_id & terstr ) {
+                            std::tie( iid_ter, iid_furn ) = ter_furn_migrations::migrate( terstr );
                         };
                         if( terrain_entry.test_string() ) {
                             migrate_terstr( ter_str_id( terrain_entry.get_string() ) );
@@ -4977,26 +5082,16 @@ void submap::load( const JsonValue &jv, const std::string &member_name, int vers
             }
         }
     } else if( member_name == "furniture" ) {
-        int_id<ter_t> iid_ter;
-        int_id<furn_t> iid_furn;
         JsonArray furniture_json = jv;
         for( JsonArray furniture_entry : furniture_json ) {
             int i = furniture_entry.next_int();
             int j = furniture_entry.next_int();
-            furn_str_id furnstr( furniture_entry.next_string() );
-            if( auto it = furn_migrations.find( furnstr ); it != furn_migrations.end() ) {
-                furnstr = it->second.second;
-                if( it->second.first != ter_str_id::NULL_ID() ) {
-                    m->ter[i][j] = it->second.first.id();
-                }
-            }
-            if( furnstr.is_valid() ) {
-                iid_furn = furnstr.id();
-            } else {
-                debugmsg( "invalid furn_str_id '%s'", furnstr.c_str() );
-                iid_furn = furn_str_id::NULL_ID().id();
+            const std::pair<ter_id, furn_id> migrated =
+                ter_furn_migrations::migrate( furn_str_id( furniture_entry.next_string() ) );
+            if( migrated.first ) {
+                m->ter[i][j] = migrated.first;
             }
-            m->frn[i][j] = iid_furn;
+            m->frn[i][j] = migrated.second;
             if( furniture_entry.size() > 3 ) {
                 furniture_entry.throw_error( "Too many values for furniture entry." );
             }
@@ -5060,6 +5155,7 @@ void submap::load( const JsonValue &jv, const std::string &member_name, int vers
                     } else if( ft != field_type_str_id::NULL_ID() &&
                                m->fld[i][j].add_field( ft.id(), intensity, time_duration::from_turns( age ) ) ) {
                         field_count++;
+                        mark_field_tile( point_sm_ms( i, j ) );
                     }
                 } else { // Handle removed int enum method
                     field_json.next_value(); // Skip intensity
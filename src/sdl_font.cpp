@@ -20,6 +20,9 @@
 
 #define dbg(x) DebugLog((x),D_SDL) << __FILE__ << ":" << __LINE__ << ": "
 
+// Width and height of the glyph atlas textures, small enough for any renderer.
+static constexpr int atlas_page_size = 1024;
+
     // bitmap font size test
     // return face index that has this size or below
     static int test_face_size( const std::string &f, int size, int faceIndex )
@@ -301,13 +304,12 @@ CachedTTFFont::CachedTTFFont(
     TTF_SetFontStyle( font.get(), TTF_STYLE_NORMAL );
 }
 
-SDL_Texture_Ptr CachedTTFFont::create_glyph( const SDL_Renderer_Ptr &renderer,
-        const std::string &ch,
-        int &ch_width,
-        const int color )
+SDL_Surface_Ptr CachedTTFFont::create_glyph( const std::string &ch, int &ch_width )
 {
+    // Rendered in white so the color modulation gives the glyph its color when drawing.
+    constexpr SDL_Color white{ 255, 255, 255, 255 };
     const auto function = fontblending ? TTF_RenderUTF8_Blended : TTF_RenderUTF8_Solid;
-    SDL_Surface_Ptr sglyph( function( font.get(), ch.c_str(), windowsPalette[color] ) );
+    SDL_Surface_Ptr sglyph( function( font.get(), ch.c_str(), white ) );
     if( !sglyph ) {
         dbg( D_ERROR ) << "Failed to create glyph for " << ch << ": " << TTF_GetError();
         return nullptr;
@@ -336,13 +338,74 @@ SDL_Texture_Ptr CachedTTFFont::create_glyph( const SDL_Renderer_Ptr &renderer,
 
     // Copy without altering the source
     SDL_SetSurfaceBlendMode( sglyph.get(), SDL_BLENDMODE_NONE );
-    if( !printErrorIf( SDL_BlitSurface( sglyph.get(), &src_rect, surface.get(), &dst_rect ) != 0,
-                       "SDL_BlitSurface failed" ) ) {
-        sglyph = std::move( surface );
+    if( printErrorIf( SDL_BlitSurface( sglyph.get(), &src_rect, surface.get(), &dst_rect ) != 0,
+                      "SDL_BlitSurface failed" ) ) {
+        // The atlas can only take the 32 bit surface.
+        return nullptr;
     }
-    SDL_SetSurfaceBlendMode( sglyph.get(), SDL_BLENDMODE_BLEND );
+    return surface;
+}
 
-    return CreateTextureFromSurface( renderer, sglyph );
+const CachedTTFFont::cached_t &CachedTTFFont::get_glyph( const SDL_Renderer_Ptr &renderer,
+        const std::string &ch )
+{
+    auto it = glyph_cache_map.find( ch );
+    if( it != glyph_cache_map.end() ) {
+        return it->second;
+    }
+    cached_t &entry = glyph_cache_map[ch];
+    int ch_width = 0;
+    const SDL_Surface_Ptr glyph = create_glyph( ch, ch_width );
+    if( !glyph || ch_width + 1 > atlas_page_size || height + 1 > atlas_page_size ) {
+        return entry;
+    }
+
+    // One pixel between the glyphs keeps them from bleeding into each other when scaled.
+    if( atlas_cursor.x + ch_width > atlas_page_size ) {
+        atlas_cursor = point( 0, atlas_cursor.y + height + 1 );
+    }
+    if( atlas_pages.empty() || atlas_cursor.y + height > atlas_page_size ) {
+        SDL_Texture_Ptr page = CreateTexture( renderer, SDL_PIXELFORMAT_RGBA32,
+                                              SDL_TEXTUREACCESS_STATIC, atlas_page_size, atlas_page_size );
+        if( !page ) {
+            return entry;
+        }
+        const std::vector<Uint32> transparent( atlas_page_size * atlas_page_size, 0 );
+        SDL_UpdateTexture( page.get(), nullptr, transparent.data(), atlas_page_size * sizeof( Uint32 ) );
+        SetTextureBlendMode( page, SDL_BLENDMODE_BLEND );
+        atlas_pages.emplace_back( std::move( page ) );
+        atlas_cursor = point_zero;
+    }
+
+    const SDL_Rect src = { atlas_cursor.x, atlas_cursor.y, ch_width, height };
+    if( printErrorIf( SDL_UpdateTexture( atlas_pages.back().get(), &src, glyph->pixels,
+                                         glyph->pitch ) != 0, "SDL_UpdateTexture failed" ) ) {
+        return entry;
+    }
+    entry.page = static_cast<int>( atlas_pages.size() ) - 1;
+    entry.src = src;
+    atlas_cursor.x += ch_width + 1;
+    return entry;
+}
+
+sprite_batch &CachedTTFFont::get_batch( const SDL_Renderer_Ptr &renderer )
+{
+    if( !batch ) {
+        batch = std::make_unique<sprite_batch>( renderer );
+    }
+    return *batch;
+}
+
+void CachedTTFFont::begin_batch( const SDL_Renderer_Ptr &renderer )
+{
+    get_batch( renderer ).begin();
+}
+
+void CachedTTFFont::end_batch()
+{
+    if( batch ) {
+        batch->end();
+    }
 }
 
 bool CachedTTFFont::isGlyphProvided( const std::string &ch ) const
@@ -362,28 +425,15 @@ void CachedTTFFont::OutputChar( const SDL_Renderer_Ptr &renderer, const Geometry
                                 const std::string &ch, const point &p,
                                 unsigned char color, const float opacity )
 {
-    key_t    key {ch, static_cast<unsigned char>( color & 0xf )};
-
-    auto it = glyph_cache_map.find( key );
-    if( it == std::end( glyph_cache_map ) ) {
-        cached_t new_entry;
-        new_entry.texture = create_glyph( renderer, key.codepoints, new_entry.width, key.color );
-        it = glyph_cache_map.insert( std::make_pair( std::move( key ), std::move( new_entry ) ) ).first;
-    }
-    const cached_t &value = it->second;
-
-    if( !value.texture ) {
+    const cached_t &value = get_glyph( renderer, ch );
+    if( value.page < 0 ) {
         // Nothing we can do here )-:
         return;
     }
-    SDL_Rect rect {p.x, p.y, value.width, height};
-    if( opacity != 1.0f ) {
-        SDL_SetTextureAlphaMod( value.texture.get(), opacity * 255.0f );
-    }
-    RenderCopy( renderer, value.texture, nullptr, &rect );
-    if( opacity != 1.0f ) {
-        SDL_SetTextureAlphaMod( value.texture.get(), 255 );
-    }
+    SDL_Color tint = windowsPalette[color & 0xf];
+    tint.a = static_cast<Uint8>( opacity * 255.0f );
+    const SDL_Rect rect { p.x, p.y, value.src.w, height };
+    get_batch( renderer ).add( atlas_pages[value.page].get(), value.src, rect, tint );
 }
 
 BitmapFont::BitmapFont(
@@ -623,4 +673,18 @@ void FontFallbackList::OutputChar( const SDL_Renderer_Ptr &renderer,
     ( *cached->second )->OutputChar( renderer, geometry, ch, p, color, opacity );
 }
 
+void FontFallbackList::begin_batch( const SDL_Renderer_Ptr &renderer )
+{
+    for( const std::unique_ptr<Font> &font : fonts ) {
+        font->begin_batch( renderer );
+    }
+}
+
+void FontFallbackList::end_batch()
+{
+    for( const std::unique_ptr<Font> &font : fonts ) {
+        font->end_batch();
+    }
+}
+
 #endif // TILES
@@ -12,8 +12,10 @@
 #include <memory>
 #include <vector>
 #include <string>
+#include <unordered_map>
 
 #include "sdl_geometry.h"
+#include "sdl_sprite_batch.h"
 #include "color.h"
 #include "color_loader.h"
 #include "debug.h"
@@ -43,6 +45,11 @@ class Font
                                  const std::string &ch, const point &p,
                                  unsigned char color, float opacity = 1.0f ) = 0;
 
+        /// Glyphs drawn between these calls may be collected and drawn together at
+        /// @ref end_batch, so nothing else may be drawn over them in between.
+        virtual void begin_batch( const SDL_Renderer_Ptr & ) {}
+        virtual void end_batch() {}
+
         /// Draw an ascii line using font's palette.
         /// @param line_id Character to draw
         /// @param point Point on the screen where to draw character
@@ -68,7 +75,8 @@ class Font
 };
 using Font_Ptr = std::unique_ptr<Font>;
 
-/// Font implementation on a TrueType font. Its glyphs are cached.
+/// Font implementation on a TrueType font. Its glyphs are rendered once, as white
+/// masks in atlas textures shared by all colors, and tinted when drawn.
 class CachedTTFFont : public Font
 {
     public:
@@ -83,39 +91,27 @@ class CachedTTFFont : public Font
                          const std::string &ch,
                          const point &p,
                          unsigned char color, float opacity = 1.0f ) override;
+        void begin_batch( const SDL_Renderer_Ptr &renderer ) override;
+        void end_batch() override;
 
     protected:
-        SDL_Texture_Ptr create_glyph( const SDL_Renderer_Ptr &renderer, const std::string &ch,
-                                      int &ch_width, int color );
-
-        TTF_Font_Ptr font;
-        // Maps (character code, color) to SDL_Texture*
-
-        struct key_t {
-            std::string   codepoints;
-            unsigned char color;
-
-            std::pair<std::string, unsigned char> as_pair() const {
-                return std::make_pair( codepoints, color );
-            }
-
-            friend bool operator==( const key_t &lhs, const key_t &rhs ) noexcept {
-                return lhs.as_pair() == rhs.as_pair();
-            }
-        };
-
-        struct key_t_hash {
-            size_t operator()( const key_t &k ) const {
-                return cata::auto_hash<std::pair<std::string, unsigned char>>()( k.as_pair() );
-            }
-        };
-
         struct cached_t {
-            SDL_Texture_Ptr texture;
-            int          width;
+            // Index into atlas_pages, -1 if the glyph couldn't be rendered.
+            int page = -1;
+            SDL_Rect src = { 0, 0, 0, 0 };
         };
 
-        std::unordered_map<key_t, cached_t, key_t_hash> glyph_cache_map;
+        SDL_Surface_Ptr create_glyph( const std::string &ch, int &ch_width );
+        const cached_t &get_glyph( const SDL_Renderer_Ptr &renderer, const std::string &ch );
+        sprite_batch &get_batch( const SDL_Renderer_Ptr &renderer );
+
+        TTF_Font_Ptr font;
+        // Maps the character to its place in the atlas.
+        std::unordered_map<std::string, cached_t> glyph_cache_map;
+        // Glyphs are packed into rows of the font height, left to right and top to bottom.
+        std::vector<SDL_Texture_Ptr> atlas_pages;
+        point atlas_cursor;
+        std::unique_ptr<sprite_batch> batch;
 
         const bool fontblending;
 };
@@ -165,6 +161,8 @@ class FontFallbackList : public Font
                          const std::string &ch,
                          const point &p,
                          unsigned char color, float opacity = 1.0f ) override;
+        void begin_batch( const SDL_Renderer_Ptr &renderer ) override;
+        void end_batch() override;
     protected:
         std::vector<std::unique_ptr<Font>> fonts;
         std::map<std::string, std::vector<std::unique_ptr<Font>>::iterator> glyph_font;
@@ -0,0 +1,160 @@
+#if defined(TILES)
+#include "sdl_sprite_batch.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#if SDL_VERSION_ATLEAST(2,0,18)
+
+void sprite_batch::begin()
+{
+    flush();
+    collecting = true;
+}
+
+void sprite_batch::end()
+{
+    flush();
+    collecting = false;
+}
+
+void sprite_batch::flush()
+{
+    if( !vertices.empty() ) {
+        printErrorIf( SDL_RenderGeometry( renderer.get(), texture, vertices.data(),
+                                          static_cast<int>( vertices.size() ), indices.data(),
+                                          static_cast<int>( indices.size() ) ) != 0,
+                      "SDL_RenderGeometry failed" );
+        vertices.clear();
+        indices.clear();
+    }
+    texture = nullptr;
+}
+
+bool sprite_batch::use_texture( SDL_Texture *tex )
+{
+    if( tex == texture ) {
+        return true;
+    }
+    flush();
+    if( SDL_QueryTexture( tex, nullptr, nullptr, &texture_width, &texture_height ) != 0 ||
+        SDL_GetTextureColorMod( tex, &modulation.r, &modulation.g, &modulation.b ) != 0 ||
+        SDL_GetTextureAlphaMod( tex, &modulation.a ) != 0 ) {
+        return false;
+    }
+    texture = tex;
+    return true;
+}
+
+void sprite_batch::add_quad( const std::array<SDL_FPoint, 4> &positions, const SDL_Rect &src,
+                             const SDL_RendererFlip flip, const SDL_Color &color )
+{
+    float u0 = static_cast<float>( src.x ) / texture_width;
+    float u1 = static_cast<float>( src.x + src.w ) / texture_width;
+    float v0 = static_cast<float>( src.y ) / texture_height;
+    float v1 = static_cast<float>( src.y + src.h ) / texture_height;
+    if( flip & SDL_FLIP_HORIZONTAL ) {
+        std::swap( u0, u1 );
+    }
+    if( flip & SDL_FLIP_VERTICAL ) {
+        std::swap( v0, v1 );
+    }
+    const std::array<SDL_FPoint, 4> uvs = { { { u0, v0 }, { u1, v0 }, { u1, v1 }, { u0, v1 } } };
+
+    const int first = static_cast<int>( vertices.size() );
+    for( size_t i = 0; i < positions.size(); ++i ) {
+        vertices.push_back( SDL_Vertex{ positions[i], color, uvs[i] } );
+    }
+    static constexpr std::array<int, 6> quad_indices = { { 0, 1, 2, 0, 2, 3 } };
+    for( const int i : quad_indices ) {
+        indices.push_back( first + i );
+    }
+}
+
+int sprite_batch::add( SDL_Texture *tex, const SDL_Rect &src, const SDL_Rect &dst,
+                       const double angle, const SDL_RendererFlip flip )
+{
+    if( !collecting ) {
+        return SDL_RenderCopyEx( renderer.get(), tex, &src, &dst, angle, nullptr, flip );
+    }
+    if( !use_texture( tex ) ) {
+        return -1;
+    }
+
+    // Corners clockwise from the top left, relative to the center of the destination.
+    const float half_w = dst.w / 2.0f;
+    const float half_h = dst.h / 2.0f;
+    const std::array<SDL_FPoint, 4> corners = { {
+            { -half_w, -half_h }, { half_w, -half_h }, { half_w, half_h }, { -half_w, half_h }
+        }
+    };
+    // Same as SDL_RenderCopyEx, a positive angle turns clockwise on screen.
+    const double radians = angle * M_PI / 180.0;
+    const float cos_a = static_cast<float>( std::cos( radians ) );
+    const float sin_a = static_cast<float>( std::sin( radians ) );
+    const SDL_FPoint center = { dst.x + half_w, dst.y + half_h };
+
+    std::array<SDL_FPoint, 4> positions;
+    for( size_t i = 0; i < corners.size(); ++i ) {
+        const SDL_FPoint &c = corners[i];
+        positions[i] = { center.x + c.x * cos_a - c.y * sin_a,
+                         center.y + c.x * sin_a + c.y * cos_a
+                       };
+    }
+    add_quad( positions, src, flip, modulation );
+    return 0;
+}
+
+int sprite_batch::add( SDL_Texture *tex, const SDL_Rect &src, const SDL_Rect &dst,
+                       const SDL_Color &color )
+{
+    if( !collecting ) {
+        SDL_SetTextureColorMod( tex, color.r, color.g, color.b );
+        SDL_SetTextureAlphaMod( tex, color.a );
+        return SDL_RenderCopy( renderer.get(), tex, &src, &dst );
+    }
+    if( !use_texture( tex ) ) {
+        return -1;
+    }
+    const float x0 = static_cast<float>( dst.x );
+    const float y0 = static_cast<float>( dst.y );
+    const float x1 = static_cast<float>( dst.x + dst.w );
+    const float y1 = static_cast<float>( dst.y + dst.h );
+    add_quad( { { { x0, y0 }, { x1, y0 }, { x1, y1 }, { x0, y1 } } }, src, SDL_FLIP_NONE, color );
+    return 0;
+}
+
+#else
+
+// SDL_RenderGeometry is missing, every copy is drawn right away.
+void sprite_batch::begin()
+{
+}
+
+void sprite_batch::end()
+{
+}
+
+void sprite_batch::flush()
+{
+}
+
+int sprite_batch::add( SDL_Texture *tex, const SDL_Rect &src, const SDL_Rect &dst,
+                       const double angle, const SDL_RendererFlip flip )
+{
+    return SDL_RenderCopyEx( renderer.get(), tex, &src, &dst, angle, nullptr, flip );
+}
+
+int sprite_batch::add( SDL_Texture *tex, const SDL_Rect &src, const SDL_Rect &dst,
+                       const SDL_Color &color )
+{
+    SDL_SetTextureColorMod( tex, color.r, color.g, color.b );
+    SDL_SetTextureAlphaMod( tex, color.a );
+    return SDL_RenderCopy( renderer.get(), tex, &src, &dst );
+}
+
+#endif
+
+#endif // TILES
@@ -0,0 +1,62 @@
+#pragma once
+#ifndef CATA_SRC_SDL_SPRITE_BATCH_H
+#define CATA_SRC_SDL_SPRITE_BATCH_H
+
+#if defined(TILES)
+#include <array>
+#include <vector>
+
+#include "sdl_wrappers.h"
+
+/**
+ * Collects copies of rectangles of the same texture and submits them with a single
+ * SDL_RenderGeometry call instead of one SDL_RenderCopyEx per copy, which most backends turn
+ * into one draw call each.
+ *
+ * Copies are only collected between @ref begin and @ref end, anything else drawn in between
+ * has to @ref flush first to keep the drawing order.  Outside of that, and if SDL is too old
+ * to have SDL_RenderGeometry, every copy is drawn right away.
+ */
+class sprite_batch
+{
+    public:
+        explicit sprite_batch( const SDL_Renderer_Ptr &renderer ) : renderer( renderer ) {}
+
+        void begin();
+        void end();
+        /** Draws the copies collected so far. */
+        void flush();
+
+        /**
+         * Same as SDL_RenderCopyEx with the rotation around the center of @p dst, returns 0 on
+         * success.  The texture's color and alpha modulation are read when the copy is added.
+         */
+        int add( SDL_Texture *tex, const SDL_Rect &src, const SDL_Rect &dst, double angle,
+                 SDL_RendererFlip flip );
+        /**
+         * Same as SDL_RenderCopy with @p color as the color and alpha modulation of this copy
+         * only, so copies of one texture in different colors still go into one batch.
+         */
+        int add( SDL_Texture *tex, const SDL_Rect &src, const SDL_Rect &dst, const SDL_Color &color );
+
+    private:
+        const SDL_Renderer_Ptr &renderer;
+#if SDL_VERSION_ATLEAST(2,0,18)
+        /** Flushes if @p tex is not the texture of the current batch, returns false on error. */
+        bool use_texture( SDL_Texture *tex );
+        void add_quad( const std::array<SDL_FPoint, 4> &positions, const SDL_Rect &src,
+                       SDL_RendererFlip flip, const SDL_Color &color );
+
+        bool collecting = false;
+        SDL_Texture *texture = nullptr;
+        int texture_width = 0;
+        int texture_height = 0;
+        SDL_Color modulation = { 255, 255, 255, 255 };
+        std::vector<SDL_Vertex> vertices;
+        std::vector<int> indices;
+#endif
+};
+
+#endif // TILES
+
+#endif // CATA_SRC_SDL_SPRITE_BATCH_H
@@ -110,6 +110,9 @@ static const oter_type_str_id oter_type_forest_trail( "forest_trail" );
 static const trait_id trait_DEBUG_CLAIRVOYANCE( "DEBUG_CLAIRVOYANCE" );
 static const trait_id trait_DEBUG_NIGHTVISION( "DEBUG_NIGHTVISION" );
 
+static const option_ref<std::string> option_hide_cursor( "HIDE_CURSOR" );
+static const option_ref<bool> option_draw_ascii_lines( "USE_DRAW_ASCII_LINES_ROUTINE" );
+
 //***********************************
 //Globals                           *
 //***********************************
@@ -1217,8 +1220,10 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
     // TODO: Get this from UTF system to make sure it is exactly the kind of space we need
     static const std::string space_string = " ";
 
-    const bool option_use_draw_ascii_lines_routine = get_option<bool>( "USE_DRAW_ASCII_LINES_ROUTINE" );
+    const bool option_use_draw_ascii_lines_routine = option_draw_ascii_lines.get();
     bool update = false;
+    // The glyphs only cover their own cells, so they can all be drawn after the backgrounds.
+    font->begin_batch( renderer );
     for( int j = 0; j < win->height; j++ ) {
         if( !win->line[j].touched ) {
             continue;
@@ -1317,6 +1322,7 @@ static bool draw_window( Font_Ptr &font, const catacurses::window &w, const poin
             }
         }
     }
+    font->end_batch();
     win->draw = false; //We drew the window, mark it as so
 
     return update;
@@ -3040,7 +3046,7 @@ static void CheckMessages()
 #endif
                 is_repeat = ev.key.repeat;
                 //hide mouse cursor on keyboard input
-                if( get_option<std::string>( "HIDE_CURSOR" ) != "show" && SDL_ShowCursor( -1 ) ) {
+                if( option_hide_cursor.get() != "show" && SDL_ShowCursor( -1 ) ) {
                     SDL_ShowCursor( SDL_DISABLE );
                 }
                 keyboard_mode mode = keyboard_mode::keychar;
@@ -3204,8 +3210,7 @@ static void CheckMessages()
                 gamepad::handle_scheduler_event( ev );
                 break;
             case SDL_MOUSEMOTION:
-                if( get_option<std::string>( "HIDE_CURSOR" ) == "show" ||
-                    get_option<std::string>( "HIDE_CURSOR" ) == "hidekb" ) {
+                if( option_hide_cursor.get() == "show" || option_hide_cursor.get() == "hidekb" ) {
                     if( !SDL_ShowCursor( -1 ) ) {
                         SDL_ShowCursor( SDL_ENABLE );
                     }
@@ -3523,6 +3528,11 @@ static void CheckMessages()
     // resizing already reinitializes the render target
     if( !resized && render_target_reset ) {
         throwErrorIf( !SetupRenderTarget(), "SetupRenderTarget failed" );
+        for( cata_tiles *context : { closetilecontext.get(), fartilecontext.get() } ) {
+            if( context ) {
+                context->invalidate_map_frame();
+            }
+        }
         needupdate = true;
         restore_on_out_of_scope<input_event> prev_last_input( last_input );
         // FIXME: SDL_RENDER_TARGETS_RESET only seems to be fired after the first redraw
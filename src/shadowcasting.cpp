@@ -175,6 +175,7 @@ void cast_horizontal_zlight_segment(
     slope new_start_minor( 1, 1 );
 
     T last_intensity( 0.0 );
+    cached_calc<T, calc> intensity_at( numerator );
     tripoint delta;
     tripoint current;
 
@@ -296,7 +297,7 @@ void cast_horizontal_zlight_segment(
                     }
 
                     const int dist = rl_dist( tripoint_zero, delta ) + offset_distance;
-                    last_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    last_intensity = intensity_at( this_span->cumulative_value, dist );
 
                     if( !floor_block ) {
                         ( *output_caches[z_index] )[current.x][current.y] =
@@ -370,6 +371,7 @@ void cast_vertical_zlight_segment(
     slope new_start_minor( 1, 1 );
 
     T last_intensity( 0.0 );
+    cached_calc<T, calc> intensity_at( numerator );
     tripoint delta;
     tripoint current;
 
@@ -468,7 +470,7 @@ void cast_vertical_zlight_segment(
                     }
 
                     const int dist = rl_dist( tripoint_zero, delta ) + offset_distance;
-                    last_intensity = calc( numerator, this_span->cumulative_value, dist );
+                    last_intensity = intensity_at( this_span->cumulative_value, dist );
 
                     if( !floor_block ) {
                         ( *output_caches[z_index] )[current.x][current.y] =
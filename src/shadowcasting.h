@@ -115,6 +115,35 @@ inline float accumulate_transparency( const float &cumulative_transparency,
     return ( ( distance - 1 ) * cumulative_transparency + current_transparency ) / distance;
 }
 
+// Shadowcasting evaluates calc for every tile it visits, but the result only depends on the
+// distance and the cumulative transparency of the span, which rarely change from one tile
+// to the next along a row.  This remembers the last result so the std::exp in calc only runs
+// when one of them does.
+template<typename T, T( *calc )( const T &, const T &, const int & )>
+class cached_calc
+{
+    public:
+        explicit cached_calc( const T &numerator ) : numerator( numerator ) {}
+
+        const T &operator()( const T &cumulative_transparency, int distance ) {
+            if( !valid || distance != last_distance ||
+                !( cumulative_transparency == last_transparency ) ) {
+                valid = true;
+                last_distance = distance;
+                last_transparency = cumulative_transparency;
+                last_result = calc( numerator, cumulative_transparency, distance );
+            }
+            return last_result;
+        }
+
+    private:
+        T numerator;
+        T last_transparency{};
+        T last_result{};
+        int last_distance = 0;
+        bool valid = false;
+};
+
 template<typename T, typename Out, T( *calc )( const T &, const T &, const int & ),
          bool( *check )( const T &, const T & ),
          void( *update_output )( Out &, const T &, quadrant ),
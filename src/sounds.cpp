@@ -3,14 +3,19 @@
 #include <algorithm>
 #include <chrono>
 #include <cmath>
+#include <cstdint>
 #include <cstdlib>
 #include <memory>
+#include <numeric>
+#include <optional>
 #include <type_traits>
 #include <unordered_map>
+#include <vector>
 
 #include "activity_type.h"
 #include "cached_options.h" // IWYU pragma: keep
 #include "calendar.h"
+#include "cata_utility.h"
 #include "character.h"
 #include "coordinates.h"
 #include "creature_tracker.h"
@@ -52,7 +57,11 @@
 #   else
 #      include <SDL_mixer.h>
 #   endif
+#   include <condition_variable>
+#   include <mutex>
+#   include <random>
 #   include <thread>
+#   include <tuple>
 #   if defined(_WIN32) && !defined(_MSC_VER)
 #       include "mingw.thread.h"
 #   endif
@@ -474,10 +483,106 @@ static int get_signal_for_hordes( const centroid &centr )
     return 0;
 }
 
+namespace
+{
+
+/**
+ * The monsters of the reality bubble by the submap they are on, so a sound only has to look at
+ * the ones on submaps close enough to hear it.
+ */
+class listener_grid
+{
+    public:
+        listener_grid() {
+            for( monster &critter : g->all_monsters() ) {
+                listeners.push_back( listener{ &critter, critter.pos() } );
+            }
+            // Sorted into cells, in the order the monsters come in within each.
+            std::vector<int> cell_sizes( num_cells + 1, 0 );
+            for( const listener &l : listeners ) {
+                ++cell_sizes[cell_of( l.pos ) + 1];
+            }
+            cell_start.resize( num_cells + 1 );
+            std::partial_sum( cell_sizes.begin(), cell_sizes.end(), cell_start.begin() );
+            std::vector<int> next = cell_start;
+            by_cell.resize( listeners.size() );
+            for( size_t i = 0; i < listeners.size(); ++i ) {
+                by_cell[next[cell_of( listeners[i].pos )]++] = static_cast<int>( i );
+            }
+        }
+
+        /**
+         * Calls @p hear for every monster for which @p vol twice over carries farther than its
+         * @ref sound_distance from @p source, in the order of @ref game::all_monsters.
+         */
+        template<typename Hear>
+        void for_each_in_earshot( const tripoint &source, int vol, Hear hear ) {
+            candidates.clear();
+            for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; ++z ) {
+                // What is left for the horizontal distance after going up or down to z.
+                const int range = vol * 2 - 1 - sound_distance( source, tripoint( source.xy(), z ) );
+                if( range < 0 ) {
+                    continue;
+                }
+                const point lo = cell_xy( source.xy() - point( range, range ) );
+                const point hi = cell_xy( source.xy() + point( range, range ) );
+                for( int cx = lo.x; cx <= hi.x; ++cx ) {
+                    for( int cy = lo.y; cy <= hi.y; ++cy ) {
+                        const int cell = index_of( cx, cy, z );
+                        candidates.insert( candidates.end(), by_cell.begin() + cell_start[cell],
+                                           by_cell.begin() + cell_start[cell + 1] );
+                    }
+                }
+            }
+            std::sort( candidates.begin(), candidates.end() );
+            for( const int i : candidates ) {
+                const int dist = sound_distance( source, listeners[i].pos );
+                if( vol * 2 > dist ) {
+                    hear( *listeners[i].critter, dist );
+                }
+            }
+        }
+
+    private:
+        struct listener {
+            monster *critter;
+            tripoint pos;
+        };
+
+        static constexpr int num_cells = MAPSIZE * MAPSIZE * OVERMAP_LAYERS;
+
+        // Out of bounds positions go to the cells on the edge, which keeps the order of cells.
+        static point cell_xy( const point &p ) {
+            return point( clamp( divide_round_down( p.x, SEEX ), 0, MAPSIZE - 1 ),
+                          clamp( divide_round_down( p.y, SEEY ), 0, MAPSIZE - 1 ) );
+        }
+        static int index_of( int cx, int cy, int z ) {
+            return ( ( clamp( z, -OVERMAP_DEPTH, OVERMAP_HEIGHT ) + OVERMAP_DEPTH ) * MAPSIZE + cy ) *
+                   MAPSIZE + cx;
+        }
+        static int cell_of( const tripoint &p ) {
+            const point c = cell_xy( p.xy() );
+            return index_of( c.x, c.y, p.z );
+        }
+
+        std::vector<listener> listeners;
+        // Indices into listeners, grouped by cell.
+        std::vector<int> by_cell;
+        // Where the listeners of each cell start in by_cell, one past the end for the last.
+        std::vector<int> cell_start;
+        std::vector<int> candidates;
+};
+
+} // namespace
+
 void sounds::process_sounds()
 {
     std::vector<centroid> sound_clusters = cluster_sounds( recent_sounds );
     const int weather_vol = get_weather().weather_id->sound_attn;
+    std::optional<listener_grid> listeners;
+    if( !sound_clusters.empty() ) {
+        listeners.emplace();
+    }
     for( const centroid &this_centroid : sound_clusters ) {
         // Since monsters don't go deaf ATM we can just use the weather modified volume
         // If they later get physical effects from loud noises we'll have to change this
@@ -495,14 +600,11 @@ void sounds::process_sounds()
             overmap_buffer.signal_hordes( target, sig_power );
         }
         // Alert all monsters (that can hear) to the sound.
-        for( monster &critter : g->all_monsters() ) {
-            // TODO: Generalize this to Creature::hear_sound
-            const int dist = sound_distance( source, critter.pos() );
-            if( vol * 2 > dist ) {
-                // Exclude monsters that certainly won't hear the sound
-                critter.hear_sound( source, vol, dist, this_centroid.provocative );
-            }
-        }
+        // Exclude monsters that certainly won't hear the sound
+        // TODO: Generalize this to Creature::hear_sound
+        listeners->for_each_in_earshot( source, vol, [&]( monster & critter, int dist ) {
+            critter.hear_sound( source, vol, dist, this_centroid.provocative );
+        } );
         // Trigger sound-triggered traps and ensure they are still valid
         for( const trap *trapType : trap::get_sound_triggered_traps() ) {
             for( const tripoint_bub_ms &tp : get_map().trap_locations( trapType->id ) ) {
@@ -1371,25 +1473,150 @@ void sfx::generate_gun_sound( const Character &source_arg, const item &firing )
 
 namespace sfx
 {
-struct sound_thread {
-    sound_thread( const tripoint &source, const tripoint &target, bool hit, bool targ_mon,
-                  const std::string &material );
-
-    bool hit;
-    bool targ_mon;
-    std::string material;
+namespace
+{
+/** The sounds of one melee exchange, worked out on the main thread. */
+struct melee_sound {
+    melee_sound( const tripoint &source, const tripoint &target, bool hit, bool targ_mon,
+                 const std::string &material );
 
-    skill_id weapon_skill;
-    int weapon_volume;
+    std::string variant;
+    // Empty if the attack missed.
+    std::string hit_id;
+    std::string season;
+    bool indoors = false;
+    bool night = false;
     // volume and angle for calls to play_variant_sound
     units::angle ang_src;
-    int vol_src;
-    int vol_targ;
+    int vol_src = 0;
+    int vol_targ = 0;
     units::angle ang_targ;
+    // Range of the delay between the swing and the hit, in milliseconds.
+    int hit_delay_min = 0;
+    int hit_delay_max = 0;
+};
 
-    // Operator overload required for thread API.
-    void operator()() const;
+/**
+ * A single long-lived thread that plays the melee sounds, so a fight doesn't start a thread
+ * for every hit.  Swings and hits are played once they are due, a hit waiting for its delay
+ * doesn't hold up the sounds queued after it.
+ */
+class melee_sound_worker
+{
+    public:
+        melee_sound_worker() : worker( &melee_sound_worker::run, this ) {}
+        melee_sound_worker( const melee_sound_worker & ) = delete;
+        melee_sound_worker &operator=( const melee_sound_worker & ) = delete;
+        /** Drops the sounds that didn't play yet. */
+        ~melee_sound_worker() {
+            {
+                std::lock_guard<std::mutex> lock( mutex );
+                stopping = true;
+            }
+            wake.notify_one();
+            worker.join();
+        }
+
+        /** Queues the swing and the hit of @p sound, or drops them if too many are waiting. */
+        bool push( const melee_sound &sound );
+        size_t num_pending() const {
+            std::lock_guard<std::mutex> lock( mutex );
+            return pending.size();
+        }
+
+    private:
+        using clock = std::chrono::steady_clock;
+        // A long fight with many combatants shouldn't delay the sounds by more than a moment.
+        static constexpr size_t max_pending = 32;
+
+        struct pending_sound {
+            clock::time_point due;
+            uint64_t order = 0;
+            std::string id;
+            std::string variant;
+            std::string season;
+            bool indoors = false;
+            bool night = false;
+            int volume = 0;
+            units::angle angle;
+        };
+        // For a min-heap on the due time, sounds due at the same time keep their order.
+        static bool later( const pending_sound &lhs, const pending_sound &rhs ) {
+            return std::tie( lhs.due, lhs.order ) > std::tie( rhs.due, rhs.order );
+        }
+
+        void run();
+
+        std::vector<pending_sound> pending;
+        uint64_t next_order = 0;
+        bool stopping = false;
+        // Only used by push, the main thread's rng isn't touched so sounds don't affect the game.
+        std::minstd_rand delay_engine;
+        mutable std::mutex mutex;
+        // Signalled when a sound is queued or the worker is stopping.
+        std::condition_variable wake;
+        // Last, so everything it uses is constructed before the thread starts.
+        std::thread worker;
 };
+
+bool melee_sound_worker::push( const melee_sound &sound )
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        const size_t num_sounds = sound.hit_id.empty() ? 1 : 2;
+        if( pending.size() + num_sounds > max_pending ) {
+            return false;
+        }
+        const auto delay = [this]( int min, int max ) {
+            return std::chrono::milliseconds( std::uniform_int_distribution<int>( min,
+                                              max )( delay_engine ) );
+        };
+        const clock::time_point swing_due = clock::now() + delay( 1, 2 );
+        pending.push_back( pending_sound{ swing_due, next_order++, "melee_swing", sound.variant,
+                                          sound.season, sound.indoors, sound.night, sound.vol_src, sound.ang_src } );
+        std::push_heap( pending.begin(), pending.end(), later );
+        if( !sound.hit_id.empty() ) {
+            const clock::time_point hit_due = swing_due + delay( sound.hit_delay_min,
+                                              sound.hit_delay_max );
+            pending.push_back( pending_sound{ hit_due, next_order++, sound.hit_id, sound.variant,
+                                              sound.season, sound.indoors, sound.night, sound.vol_targ, sound.ang_targ } );
+            std::push_heap( pending.begin(), pending.end(), later );
+        }
+    }
+    wake.notify_one();
+    return true;
+}
+
+void melee_sound_worker::run()
+{
+    // This is run in a separate thread, it must only use the data queued by push.
+    std::unique_lock<std::mutex> lock( mutex );
+    while( !stopping ) {
+        if( pending.empty() ) {
+            wake.wait( lock );
+            continue;
+        }
+        const clock::time_point due = pending.front().due;
+        if( clock::now() < due ) {
+            wake.wait_until( lock, due );
+            continue;
+        }
+        std::pop_heap( pending.begin(), pending.end(), later );
+        const pending_sound next = std::move( pending.back() );
+        pending.pop_back();
+        lock.unlock();
+        play_variant_sound( next.id, next.variant, next.season, next.indoors, next.night,
+                            next.volume, next.angle, 0.8, 1.2 );
+        lock.lock();
+    }
+}
+
+melee_sound_worker &melee_sounds()
+{
+    static melee_sound_worker worker;
+    return worker;
+}
+} // namespace
 } // namespace sfx
 
 void sfx::generate_melee_sound( const tripoint &source, const tripoint &target, bool hit,
@@ -1399,17 +1626,10 @@ void sfx::generate_melee_sound( const tripoint &source, const tripoint &target,
     if( test_mode ) {
         return;
     }
-    // If creating a new thread for each invocation is to much, we have to consider a thread
-    // pool or maybe a single thread that works continuously, but that requires a queue or similar
-    // to coordinate its work.
     try {
-        std::thread the_thread( sound_thread( source, target, hit, targ_mon, material ) );
-        try {
-            if( the_thread.joinable() ) {
-                the_thread.detach();
-            }
-        } catch( std::system_error &err ) {
-            dbg( D_ERROR ) << "Failed to detach melee sound thread: std::system_error: " << err.what();
+        if( !melee_sounds().push( melee_sound( source, target, hit, targ_mon, material ) ) ) {
+            add_msg_debug( debugmode::DF_SOUND, "Dropped melee sound, %d sounds are waiting",
+                           melee_sounds().num_pending() );
         }
     } catch( std::system_error &err ) {
         // not a big deal, just skip playing the sound.
@@ -1417,13 +1637,17 @@ void sfx::generate_melee_sound( const tripoint &source, const tripoint &target,
     }
 }
 
-sfx::sound_thread::sound_thread( const tripoint &source, const tripoint &target, const bool hit,
-                                 const bool targ_mon, const std::string &material )
-    : hit( hit )
-    , targ_mon( targ_mon )
-    , material( material )
+size_t sfx::num_pending_melee_sounds()
+{
+    if( test_mode ) {
+        return 0;
+    }
+    return melee_sounds().num_pending();
+}
+
+sfx::melee_sound::melee_sound( const tripoint &source, const tripoint &target, const bool hit,
+                               const bool targ_mon, const std::string &material )
 {
-    // This is function is run in the main thread.
     const int heard_volume = get_heard_volume( source );
     npc *np = get_creature_tracker().creature_at<npc>( source );
     const Character &you = np ? static_cast<Character &>( *np ) :
@@ -1438,66 +1662,37 @@ sfx::sound_thread::sound_thread( const tripoint &source, const tripoint &target,
         vol_src = std::max( heard_volume - 30, 0 );
         vol_targ = std::max( heard_volume - 20, 0 );
     }
-    const item_location weapon = you.get_wielded_item();
     ang_targ = get_heard_angle( target );
-    weapon_skill = weapon ? weapon->melee_skill() : skill_id::NULL_ID();
-    weapon_volume = weapon ? weapon->volume() / units::legacy_volume_factor : 0;
-}
-
-// Operator overload required for thread API.
-void sfx::sound_thread::operator()() const
-{
-    // This is function is run in a separate thread. One must be careful and not access game data
-    // that might change (e.g. g->u.weapon, the character could switch weapons while this thread
-    // runs).
-    std::this_thread::sleep_for( std::chrono::milliseconds( rng( 1, 2 ) ) );
-    std::string variant_used;
-    const season_type seas = season_of_year( calendar::turn );
-    const std::string seas_str = season_str( seas );
-    const bool indoors = !is_creature_outside( get_player_character() );
-    const bool night = is_night( calendar::turn );
+    season = season_str( season_of_year( calendar::turn ) );
+    indoors = !is_creature_outside( get_player_character() );
+    night = is_night( calendar::turn );
 
+    const item_location weapon = you.get_wielded_item();
+    const skill_id weapon_skill = weapon ? weapon->melee_skill() : skill_id::NULL_ID();
+    const int weapon_volume = weapon ? weapon->volume() / units::legacy_volume_factor : 0;
     if( weapon_skill == skill_bashing && weapon_volume <= 8 ) {
-        variant_used = "small_bash";
-        play_variant_sound( "melee_swing", "small_bash", seas_str, indoors, night,
-                            vol_src, ang_src, 0.8, 1.2 );
+        variant = "small_bash";
     } else if( weapon_skill == skill_bashing && weapon_volume >= 9 ) {
-        variant_used = "big_bash";
-        play_variant_sound( "melee_swing", "big_bash", seas_str, indoors, night,
-                            vol_src, ang_src, 0.8, 1.2 );
+        variant = "big_bash";
     } else if( ( weapon_skill == skill_cutting || weapon_skill == skill_stabbing ) &&
                weapon_volume <= 6 ) {
-        variant_used = "small_cutting";
-        play_variant_sound( "melee_swing", "small_cutting", seas_str, indoors, night,
-                            vol_src, ang_src, 0.8, 1.2 );
+        variant = "small_cutting";
     } else if( ( weapon_skill == skill_cutting || weapon_skill == skill_stabbing ) &&
                weapon_volume >= 7 ) {
-        variant_used = "big_cutting";
-        play_variant_sound( "melee_swing", "big_cutting", seas_str, indoors, night,
-                            vol_src, ang_src, 0.8, 1.2 );
+        variant = "big_cutting";
     } else {
-        variant_used = "default";
-        play_variant_sound( "melee_swing", "default", seas_str, indoors, night,
-                            vol_src, ang_src, 0.8, 1.2 );
+        variant = "default";
     }
+
     if( hit ) {
         if( targ_mon ) {
-            if( material == "steel" ) {
-                std::this_thread::sleep_for( std::chrono::milliseconds( rng( weapon_volume * 12,
-                                             weapon_volume * 16 ) ) );
-                play_variant_sound( "melee_hit_metal", variant_used, seas_str, indoors,
-                                    night, vol_targ, ang_targ, 0.8, 1.2 );
-            } else {
-                std::this_thread::sleep_for( std::chrono::milliseconds( rng( weapon_volume * 12,
-                                             weapon_volume * 16 ) ) );
-                play_variant_sound( "melee_hit_flesh", variant_used, seas_str, indoors,
-                                    night, vol_targ, ang_targ, 0.8, 1.2 );
-            }
+            hit_id = material == "steel" ? "melee_hit_metal" : "melee_hit_flesh";
+            hit_delay_min = weapon_volume * 12;
+            hit_delay_max = weapon_volume * 16;
         } else {
-            std::this_thread::sleep_for( std::chrono::milliseconds( rng( weapon_volume * 9,
-                                         weapon_volume * 12 ) ) );
-            play_variant_sound( "melee_hit_flesh", variant_used, seas_str, indoors,
-                                night, vol_targ, ang_targ, 0.8, 1.2 );
+            hit_id = "melee_hit_flesh";
+            hit_delay_min = weapon_volume * 9;
+            hit_delay_max = weapon_volume * 12;
         }
     }
 }
@@ -2010,6 +2205,10 @@ void sfx::end_activity_sounds() { }
 void sfx::generate_gun_sound( const Character &, const item & ) { }
 void sfx::generate_melee_sound( const tripoint &, const tripoint &, bool, bool,
                                 const std::string & ) { }
+size_t sfx::num_pending_melee_sounds()
+{
+    return 0;
+}
 void sfx::do_hearing_loss( int ) { }
 void sfx::remove_hearing_loss() { }
 void sfx::do_projectile_hit( const Creature & ) { }
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_SOUNDS_H
 #define CATA_SRC_SOUNDS_H
 
+#include <cstddef>
 #include <optional>
 #include <string> // IWYU pragma: keep
 #include <utility>
@@ -173,6 +174,8 @@ void end_activity_sounds();
 void generate_gun_sound( const Character &source_arg, const item &firing );
 void generate_melee_sound( const tripoint &source, const tripoint &target, bool hit,
                            bool targ_mon = false, const std::string &material = "flesh" );
+/** Number of melee swings and hits waiting to be played by the sound worker. */
+size_t num_pending_melee_sounds();
 void do_hearing_loss( int turns = -1 );
 void remove_hearing_loss();
 void do_projectile_hit( const Creature &target );
@@ -242,7 +242,27 @@ event_multiset stats_tracker::get_events(
 
 cata_variant stats_tracker::value_of( const string_id<event_statistic> &stat )
 {
-    return stat->value( *this );
+    // Once asked for, a statistic is kept up to date as the events arrive, so the scores
+    // don't scan the events again every time they are shown.
+    std::unique_ptr<stats_tracker_state> &state = stat_states[ stat ];
+    if( !state ) {
+        state = stat->watch( *this );
+    }
+    return state->get_value();
+}
+
+void stats_tracker::refresh_states()
+{
+    // The reset travels on through the transformations and statistics that depend on
+    // each type.  The types are copied, resetting a watcher can add new ones.
+    std::vector<event_type> types;
+    for( const auto &p : event_type_watchers ) {
+        types.push_back( p.first );
+    }
+    for( const event_type type : types ) {
+        event_type_watchers[type].send_to_all( &event_multiset_watcher::events_reset,
+                                               get_events( type ), *this );
+    }
 }
 
 void stats_tracker::add_watcher( event_type type, event_multiset_watcher *watcher )
@@ -219,6 +219,8 @@ class stats_tracker : public event_subscriber
         void deserialize( const JsonObject &jo );
     private:
         void unwatch_all();
+        /** Tells everything watching the events that they were replaced, as on loading. */
+        void refresh_states();
 
         std::unordered_map<event_type, event_multiset> data;
 
@@ -2,11 +2,15 @@
 #ifndef CATA_SRC_STRING_FORMATTER_H
 #define CATA_SRC_STRING_FORMATTER_H
 
+#include <array>
+#include <charconv>
 #include <cstddef>
 #include <iosfwd>
 #include <new>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <type_traits>
 #include <typeinfo>
 
@@ -158,6 +162,154 @@ inline RT convert( RT *, const string_formatter &sf, T &&, ... )
 }
 /**@}*/
 
+/**
+ * One piece of a format string, as split by @ref parse_format: either literal text or a single
+ * format specifier.
+ */
+struct format_piece {
+    /// Position and length of the piece in the format string.
+    size_t begin = 0;
+    size_t length = 0;
+    /// The conversion character ('d', 's', ...), or 0 for literal text.
+    char conversion = 0;
+    /// The *index* of the argument to be formatted.
+    int argument = 0;
+    /// The specifier has no flags, width or precision, see @ref string_formatter::append_plain.
+    bool plain = false;
+    /// Offset of the flags in the piece, after the argument index ("2$").
+    size_t flags_offset = 0;
+    /// Offset of the length modifier ("ll", "h", ...) in the piece and its length. The
+    /// specifier without argument index and length modifier is what gets passed to `sprintf`.
+    size_t modifier_offset = 0;
+    size_t modifier_length = 0;
+};
+
+/** The pieces of a format string, see @ref parse_format. */
+template<size_t N>
+struct parsed_format {
+    std::array<format_piece, N> pieces;
+    size_t size = 0;
+    /// Number of arguments the format string refers to.
+    int num_arguments = 0;
+};
+
+/** Upper bound of the pieces @ref parse_format splits @p format into. */
+constexpr size_t max_format_pieces( const std::string_view format )
+{
+    size_t result = 1;
+    for( const char c : format ) {
+        if( c == '%' ) {
+            result += 2;
+        }
+    }
+    return result;
+}
+
+constexpr bool is_format_digit( const char c )
+{
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * Splits a format string into literal text and format specifiers, following the same rules as
+ * @ref string_formatter::parse. Meant to be evaluated at compile time (see @ref CATA_FORMAT),
+ * where the exceptions thrown for invalid formats become compile errors.
+ * Width and precision given as arguments ('*') are not supported.
+ */
+template<size_t N>
+constexpr parsed_format<N> parse_format( const std::string_view format )
+{
+    parsed_format<N> result{};
+    int next_argument = 0;
+    size_t literal_begin = 0;
+    size_t i = 0;
+    const auto add_literal = [&]( const size_t end ) {
+        if( end > literal_begin ) {
+            format_piece &literal = result.pieces[result.size++];
+            literal.begin = literal_begin;
+            literal.length = end - literal_begin;
+        }
+    };
+    while( i < format.size() ) {
+        if( format[i] != '%' ) {
+            ++i;
+            continue;
+        }
+        add_literal( i );
+        if( i + 1 < format.size() && format[i + 1] == '%' ) {
+            // The second '%' is literal text.
+            literal_begin = i + 1;
+            i += 2;
+            continue;
+        }
+        format_piece spec;
+        spec.begin = i;
+        size_t j = i + 1;
+        size_t k = j;
+        int index = 0;
+        while( k < format.size() && is_format_digit( format[k] ) ) {
+            index = index * 10 + ( format[k] - '0' );
+            ++k;
+        }
+        bool has_index = false;
+        if( k > j && format[j] != '0' && k < format.size() && format[k] == '$' ) {
+            has_index = true;
+            spec.argument = index - 1; // arguments are 1-based
+            j = k + 1;
+        }
+        const size_t flags_begin = j;
+        spec.flags_offset = j - i;
+        while( j < format.size() && std::string_view( "#0 +'I-" ).find( format[j] ) !=
+               std::string_view::npos ) {
+            ++j;
+        }
+        while( j < format.size() && is_format_digit( format[j] ) ) {
+            ++j;
+        }
+        if( j < format.size() && format[j] == '.' ) {
+            ++j;
+            while( j < format.size() && is_format_digit( format[j] ) ) {
+                ++j;
+            }
+        }
+        if( j < format.size() && format[j] == '*' ) {
+            throw std::logic_error( "width or precision given as argument" );
+        }
+        spec.plain = j == flags_begin;
+        spec.modifier_offset = j - i;
+        if( j < format.size() && ( format[j] == 'l' || format[j] == 'h' ) ) {
+            ++j;
+            if( j < format.size() && format[j] == format[j - 1] ) {
+                ++j;
+            }
+        } else if( j < format.size() && ( format[j] == 'z' || format[j] == 't' ) ) {
+            ++j;
+        }
+        spec.modifier_length = j - i - spec.modifier_offset;
+        if( j >= format.size() || std::string_view( "cdiouxXaAgGfFeEps" ).find( format[j] ) ==
+            std::string_view::npos ) {
+            throw std::logic_error( "unsupported format conversion" );
+        }
+        spec.conversion = format[j];
+        spec.length = j + 1 - i;
+        if( !has_index ) {
+            spec.argument = next_argument++;
+        }
+        if( spec.argument >= result.num_arguments ) {
+            result.num_arguments = spec.argument + 1;
+        }
+        result.pieces[result.size++] = spec;
+        i = j + 1;
+        literal_begin = i;
+    }
+    add_literal( format.size() );
+    return result;
+}
+
+/** Base of the types made by @ref CATA_FORMAT. */
+struct compiled_format_string {
+};
+
 /**
  * Type-safe and undefined-behavior free wrapper over `sprintf`.
  * See @ref string_format for usage.
@@ -257,6 +409,86 @@ class string_formatter
         }
         /**@}*/
 
+        /**
+         * Calls @p f with the argument at the given index, unconverted.
+         * Returns false if there is no such argument.
+         */
+        /**@{*/
+        template<unsigned int current_index, typename F>
+        bool visit_nth_arg( const unsigned int, F && ) const {
+            return false;
+        }
+        template<unsigned int current_index, typename F, typename T, typename ...Args>
+        bool visit_nth_arg( const unsigned int requested, F &&f, T &&head, Args &&... args ) const {
+            if( requested > current_index ) {
+                return visit_nth_arg < current_index + 1 > ( requested, std::forward<F>( f ),
+                        std::forward<Args>( args )... );
+            }
+            return f( head );
+        }
+        /**@}*/
+
+        template<typename T>
+        void append_integer( const T value ) {
+            std::array<char, 24> buffer;
+            const std::to_chars_result result = std::to_chars( buffer.data(),
+                                                buffer.data() + buffer.size(), value );
+            output.append( buffer.data(), result.ptr );
+        }
+
+        /// Appends what "%s" makes of @p value, if that can be done without `sprintf`.
+        template<typename T>
+        bool append_plain_string( const T &value ) {
+            if constexpr( is_string<T> || is_string_view<T> ) {
+                output.append( value );
+                return true;
+            } else if constexpr( is_cstring<T> ) {
+                const char *const text = value;
+                if( text == nullptr ) {
+                    return false;
+                }
+                output.append( text );
+                return true;
+            } else if constexpr( is_translation<T> ) {
+                output.append( value.translated() );
+                return true;
+            } else if constexpr( is_char<T> ) {
+                output.push_back( value );
+                return true;
+            } else if constexpr( is_integer<T> ) {
+                append_integer( value );
+                return true;
+            } else {
+                return false;
+            }
+        }
+
+        /**
+         * Appends the argument for a specifier without flags, width or precision directly,
+         * which gives the same text as `sprintf` for the common conversions.
+         * Returns false if the conversion needs `sprintf` after all.
+         */
+        template<typename ...Args>
+        bool append_plain( const char c, const int format_arg_index, Args &&... args ) {
+            switch( c ) {
+                case 'd':
+                case 'i':
+                    append_integer( get_nth_arg_as<signed long long int, 0>( format_arg_index,
+                                    std::forward<Args>( args )... ) );
+                    return true;
+                case 'u':
+                    append_integer( get_nth_arg_as<unsigned long long int, 0>( format_arg_index,
+                                    std::forward<Args>( args )... ) );
+                    return true;
+                case 's':
+                    return visit_nth_arg<0>( format_arg_index, [this]( const auto & value ) {
+                        return append_plain_string( value );
+                    }, std::forward<Args>( args )... );
+                default:
+                    return false;
+            }
+        }
+
         void add_long_long_length_modifier();
 
         template<typename ...Args>
@@ -276,6 +508,17 @@ class string_formatter
                 // done with it
             }
             const char c = consume_next_input();
+            format_argument( c, format_arg_index, std::forward<Args>( args )... );
+        }
+
+        /// Formats one argument, @ref current_format holds its specifier up to, but without,
+        /// the conversion character @p c and the length modifier.
+        template<typename ...Args>
+        void format_argument( const char c, const int format_arg_index, Args &&... args ) {
+            if( current_format.size() == 1 &&
+                append_plain( c, format_arg_index, std::forward<Args>( args )... ) ) {
+                return;
+            }
             current_format.push_back( c );
             switch( c ) {
                 case 'c':
@@ -358,9 +601,31 @@ class string_formatter
                 read_conversion( arg, std::forward<Args>( args )... );
             }
         }
-        std::string get_output() const {
+        /// Like @ref parse, but uses the pieces of @ref format as split by @ref parse_format.
+        template<size_t N, typename ...Args>
+        void parse( const parsed_format<N> &parsed, Args &&... args ) {
+            output.reserve( format.size() );
+            output.resize( 0 );
+            for( size_t i = 0; i < parsed.size; ++i ) {
+                const format_piece &piece = parsed.pieces[i];
+                if( piece.conversion == 0 ) {
+                    output.append( format.substr( piece.begin, piece.length ) );
+                    continue;
+                }
+                current_index_in_format = piece.begin + piece.length;
+                current_format = "%";
+                const size_t flags_begin = piece.begin + piece.flags_offset;
+                const size_t flags_length = piece.modifier_offset - piece.flags_offset;
+                current_format.append( format.substr( flags_begin, flags_length ) );
+                format_argument( piece.conversion, piece.argument, std::forward<Args>( args )... );
+            }
+        }
+        std::string get_output() const & {
             return output;
         }
+        std::string get_output() && {
+            return std::move( output );
+        }
 #if defined(__clang__)
 #define PRINTF_LIKE(a,b) __attribute__((format(printf,a,b)))
 #elif defined(__GNUC__)
@@ -419,7 +684,28 @@ inline std::string string_format( std::string_view format, Args &&...args )
     try {
         cata::string_formatter formatter( format );
         formatter.parse( std::forward<Args>( args )... );
-        return formatter.get_output();
+        return std::move( formatter ).get_output();
+    } catch( ... ) {
+        return cata::handle_string_format_error();
+    }
+}
+/**
+ * Same as above, for a format string literal wrapped in @ref CATA_FORMAT, which is split
+ * once at compile time instead of on every call.
+ */
+template<typename Format, typename ...Args>
+inline std::enable_if_t<std::is_base_of_v<cata::compiled_format_string, Format>, std::string>
+string_format( Format, Args &&...args )
+{
+    static constexpr std::string_view format = Format::text();
+    static constexpr auto parsed =
+        cata::parse_format<cata::max_format_pieces( format )>( format );
+    static_assert( parsed.num_arguments <= static_cast<int>( sizeof...( Args ) ),
+                   "The format string refers to more arguments than given" );
+    try {
+        cata::string_formatter formatter( format );
+        formatter.parse( parsed, std::forward<Args>( args )... );
+        return std::move( formatter ).get_output();
     } catch( ... ) {
         return cata::handle_string_format_error();
     }
@@ -432,4 +718,19 @@ string_format( T &&format, Args &&...args )
 }
 /**@}*/
 
+/**
+ * Wraps a format string literal for @ref string_format, so it is checked and split at compile
+ * time, e.g. `string_format( CATA_FORMAT( "%d%%" ), value )`. An invalid format string is a
+ * compile error. Only for untranslated strings, translated ones are only known at run time.
+ */
+#define CATA_FORMAT( s ) \
+    [] { \
+        struct cata_format_string : cata::compiled_format_string { \
+            static constexpr std::string_view text() { \
+                return s; \
+            } \
+        }; \
+        return cata_format_string{}; \
+    }()
+
 #endif // CATA_SRC_STRING_FORMATTER_H
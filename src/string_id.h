@@ -156,6 +156,8 @@ class string_identity_static
 
         template<typename T>
         friend class string_id;
+        template<typename T>
+        friend class generic_factory;
 
         template<typename T>
         friend struct std::hash; // NOLINT(cert-dcl58-cpp)
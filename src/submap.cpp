@@ -35,11 +35,90 @@ submap::~submap() = default;
 
 submap &submap::operator=( submap && ) noexcept = default;
 
+units::volume *submap::known_stored_volume( const point_sm_ms &p ) const
+{
+    if( stored_volumes.empty() ) {
+        return nullptr;
+    }
+    if( stored_volumes_turn != calendar::turn ) {
+        stored_volumes.clear();
+        return nullptr;
+    }
+    const auto it = stored_volumes.find( p );
+    return it == stored_volumes.end() ? nullptr : &it->second;
+}
+
+units::volume submap::get_stored_volume( const point_sm_ms &p ) const
+{
+    if( is_uniform() ) {
+        return 0_ml;
+    }
+    if( const units::volume *known = known_stored_volume( p ) ) {
+        return *known;
+    }
+    units::volume ret = 0_ml;
+    for( const item &it : m->itm[p.x()][p.y()] ) {
+        ret += it.volume();
+    }
+    stored_volumes_turn = calendar::turn;
+    stored_volumes[p] = ret;
+    return ret;
+}
+
+cata::colony<item>::iterator submap::insert_items( const point_sm_ms &p, const item &it,
+        int copies )
+{
+    ensure_nonuniform();
+    mark_modified();
+    cata::colony<item> &items = m->itm[p.x()][p.y()];
+    const cata::colony<item>::iterator ret = items.insert( it );
+    for( int i = 1; i < copies; ++i ) {
+        items.insert( it );
+    }
+    if( units::volume *known = known_stored_volume( p ) ) {
+        *known += it.volume() * std::max( copies, 1 );
+    }
+    return ret;
+}
+
+cata::colony<item>::iterator submap::erase_item( const point_sm_ms &p,
+        const cata::colony<item>::const_iterator &it )
+{
+    ensure_nonuniform();
+    mark_modified();
+    if( units::volume *known = known_stored_volume( p ) ) {
+        *known -= it->volume();
+    }
+    return m->itm[p.x()][p.y()].erase( it );
+}
+
+item *submap::merge_charges( const point_sm_ms &p, const item &it )
+{
+    if( is_uniform() ) {
+        return nullptr;
+    }
+    for( item &here : m->itm[p.x()][p.y()] ) {
+        if( !here.count_by_charges() || !here.stacks_with( it ) ) {
+            continue;
+        }
+        const units::volume before = here.volume();
+        if( here.merge_charges( it ) ) {
+            mark_modified();
+            if( units::volume *known = known_stored_volume( p ) ) {
+                *known += here.volume() - before;
+            }
+            return &here;
+        }
+    }
+    return nullptr;
+}
+
 void submap::clear_fields( const point_sm_ms &p )
 {
     field &f = get_field( p );
     field_count -= f.field_count();
     f.clear();
+    field_tiles.reset( static_cast<size_t>( p.x() * SEEY + p.y() ) );
 }
 
 static const std::string COSMETICS_GRAFFITI( "GRAFFITI" );
@@ -89,6 +168,7 @@ void submap::set_graffiti( const point_sm_ms &p, const std::string &new_graffiti
     // Find signage at p if available
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
+        mark_modified();
         cosmetics[ fresult.ndx ].str = new_graffiti;
     } else {
         insert_cosmetic( p, COSMETICS_GRAFFITI, new_graffiti );
@@ -100,6 +180,7 @@ void submap::delete_graffiti( const point_sm_ms &p )
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_GRAFFITI );
     if( fresult.result ) {
         ensure_nonuniform();
+        mark_modified();
         cosmetics[ fresult.ndx ] = cosmetics.back();
         cosmetics.pop_back();
     }
@@ -129,6 +210,7 @@ void submap::set_signage( const point_sm_ms &p, const std::string &s )
     // Find signage at p if available
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
+        mark_modified();
         cosmetics[ fresult.ndx ].str = s;
     } else {
         insert_cosmetic( p, COSMETICS_SIGNAGE, s );
@@ -139,6 +221,7 @@ void submap::delete_signage( const point_sm_ms &p )
     const cosmetic_find_result fresult = find_cosmetic( cosmetics, p, COSMETICS_SIGNAGE );
     if( fresult.result ) {
         ensure_nonuniform();
+        mark_modified();
         cosmetics[ fresult.ndx ] = cosmetics.back();
         cosmetics.pop_back();
     }
@@ -164,6 +247,7 @@ computer *submap::get_computer( const point_sm_ms &p )
 {
     const auto it = computers.find( p );
     if( it != computers.end() ) {
+        mark_modified();
         return &it->second;
     }
     return nullptr;
@@ -171,6 +255,7 @@ computer *submap::get_computer( const point_sm_ms &p )
 
 void submap::set_computer( const point_sm_ms &p, const computer &c )
 {
+    mark_modified();
     const auto it = computers.find( p );
     if( it != computers.end() ) {
         it->second = c;
@@ -181,9 +266,16 @@ void submap::set_computer( const point_sm_ms &p, const computer &c )
 
 void submap::delete_computer( const point_sm_ms &p )
 {
+    mark_modified();
     computers.erase( p );
 }
 
+bool submap::needs_saving() const
+{
+    return modified_generation != saved_generation || !vehicles.empty() || !active_items.empty() ||
+           camp || !partial_constructions.empty();
+}
+
 bool submap::contains_vehicle( vehicle *veh )
 {
     const auto match = std::find_if(
@@ -194,6 +286,51 @@ bool submap::contains_vehicle( vehicle *veh )
     return match != vehicles.end();
 }
 
+static std::uint8_t scent_weight( const ter_t &ter, const furn_id &furn )
+{
+    if( ter.has_flag( ter_furn_flag::TFLAG_NO_SCENT ) ) {
+        return 0;
+    } else if( ter.has_flag( ter_furn_flag::TFLAG_REDUCE_SCENT ) ||
+               furn.obj().has_flag( ter_furn_flag::TFLAG_REDUCE_SCENT ) ) {
+        return 2;
+    }
+    return 10;
+}
+
+const cata::mdarray<std::uint8_t, point_sm_ms> &submap::get_scent_weights() const
+{
+    if( is_uniform() ) {
+        // Shared by all uniform submaps, there are only the three weights to choose from.
+        static const std::array<cata::mdarray<std::uint8_t, point_sm_ms>, 3> uniform_weights = [] {
+            std::array<cata::mdarray<std::uint8_t, point_sm_ms>, 3> ret;
+            ret[0].fill( 0 );
+            ret[1].fill( 2 );
+            ret[2].fill( 10 );
+            return ret;
+        }();
+        switch( scent_weight( uniform_ter.obj(), furn_str_id::NULL_ID() ) ) {
+            case 0:
+                return uniform_weights[0];
+            case 2:
+                return uniform_weights[1];
+            default:
+                return uniform_weights[2];
+        }
+    }
+    cata::mdarray<std::uint8_t, point_sm_ms> &scent_weights = m->scent_weights;
+    if( !scent_weights_dirty ) {
+        return scent_weights;
+    }
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            const point_sm_ms p( x, y );
+            scent_weights[p] = scent_weight( get_ter( p ).obj(), get_furn( p ) );
+        }
+    }
+    scent_weights_dirty = false;
+    return scent_weights;
+}
+
 bool submap::is_open_air( const point_sm_ms &p ) const
 {
     const ter_id &t = get_ter( p );
@@ -205,6 +342,9 @@ void submap::rotate( int turns )
     if( is_uniform() ) {
         return;
     }
+    mark_modified();
+    scent_weights_dirty = true;
+    stored_volumes.clear();
     turns = turns % 4;
 
     if( turns == 0 ) {
@@ -249,6 +389,8 @@ void submap::rotate( int turns )
     }
 
     active_items.rotate_locations( turns, { SEEX, SEEY } );
+    // Sorted out again by the next field processing.
+    field_tiles.set();
 
     for( submap::cosmetic_t &elem : cosmetics ) {
         elem.pos = point_sm_ms( rotate_point( elem.pos.raw() ) );
@@ -282,6 +424,10 @@ void submap::mirror( bool horizontally )
     if( is_uniform() ) {
         return;
     }
+    mark_modified();
+    scent_weights_dirty = true;
+    stored_volumes.clear();
+    field_tiles.set();
     std::map<point_sm_ms, computer> mirror_comp;
 
     if( horizontally ) {
@@ -324,9 +470,13 @@ void submap::mirror( bool horizontally )
 void submap::revert_submap( submap &sr )
 {
     reverted = true;
+    mark_modified();
+    scent_weights_dirty = true;
+    stored_volumes.clear();
     if( sr.is_uniform() ) {
         m.reset();
         set_all_ter( sr.get_ter( point_sm_ms_zero ), true );
+        count_contents();
         return;
     }
 
@@ -346,6 +496,7 @@ void submap::revert_submap( submap &sr )
             }
         }
     }
+    count_contents();
 }
 
 submap submap::get_revert_submap() const
@@ -355,10 +506,28 @@ submap submap::get_revert_submap() const
     if( !is_uniform() ) {
         ret.m = std::make_unique<maptile_soa>( *m );
     }
+    ret.count_contents();
 
     return ret;
 }
 
+void submap::count_contents()
+{
+    trap_tiles = 0;
+    furn_tiles = 0;
+    lum_tiles = 0;
+    if( is_uniform() ) {
+        return;
+    }
+    for( int x = 0; x < SEEX; x++ ) {
+        for( int y = 0; y < SEEY; y++ ) {
+            trap_tiles += m->trp[x][y] != tr_null;
+            furn_tiles += m->frn[x][y] != f_null;
+            lum_tiles += m->lum[x][y] != 0;
+        }
+    }
+}
+
 void submap::update_lum_rem( const point_sm_ms &p, const item &i )
 {
     ensure_nonuniform();
@@ -366,6 +535,9 @@ void submap::update_lum_rem( const point_sm_ms &p, const item &i )
         return;
     } else if( m->lum[p.x()][p.y()] && m->lum[p.x()][p.y()] < 255 ) {
         m->lum[p.x()][p.y()]--;
+        if( m->lum[p.x()][p.y()] == 0 ) {
+            lum_tiles--;
+        }
         return;
     }
 
@@ -379,12 +551,16 @@ void submap::update_lum_rem( const point_sm_ms &p, const item &i )
     }
 
     if( count <= 256 ) {
+        lum_tiles += ( count > 1 ) - ( m->lum[p.x()][p.y()] != 0 );
         m->lum[p.x()][p.y()] = static_cast<uint8_t>( count - 1 );
     }
 }
 
 void submap::merge_submaps( submap *copy_from, bool copy_from_is_overlay )
 {
+    mark_modified();
+    scent_weights_dirty = true;
+    stored_volumes.clear();
     this->field_count = 0;
 
     for( int x = 0; x < SEEX; x++ ) {
@@ -421,6 +597,7 @@ void submap::merge_submaps( submap *copy_from, bool copy_from_is_overlay )
             for( std::map<field_type_id, field_entry>::iterator it = this->m->fld[x][y].begin();
                  it != this->m->fld[x][y].end(); it++ ) {
                 this->field_count++;
+                mark_field_tile( { x, y } );
             }
 
             if( copy_from->m->trp[x][y] != tr_null && ( copy_from_is_overlay ||
@@ -489,4 +666,5 @@ void submap::merge_submaps( submap *copy_from, bool copy_from_is_overlay )
     if( copy_from->temperature_mod != 0 && this->temperature_mod == 0 ) {
         this->temperature_mod = copy_from->temperature_mod;
     }
+    count_contents();
 }
@@ -2,6 +2,7 @@
 #ifndef CATA_SRC_SUBMAP_H
 #define CATA_SRC_SUBMAP_H
 
+#include <bitset>
 #include <cstddef>
 #include <cstdint>
 #include <iosfwd>
@@ -64,6 +65,7 @@ struct maptile_soa {
     cata::mdarray<field, point_sm_ms>              fld; // Field on each square
     cata::mdarray<trap_id, point_sm_ms>            trp; // Trap on each square
     cata::mdarray<int, point_sm_ms>                rad; // Irradiation of each square
+    cata::mdarray<std::uint8_t, point_sm_ms>       scent_weights; // See submap::get_scent_weights
 
     void swap_soa_tile( const point_sm_ms &p1, const point_sm_ms &p2 );
 };
@@ -77,8 +79,13 @@ class submap
 
         submap &operator=( submap && ) noexcept;
 
+        /**
+         * Uniform submaps share everything per tile with every other submap of the same
+         * terrain and only get tiles of their own here, on the first write that changes one.
+         */
         void ensure_nonuniform() {
             if( is_uniform() ) {
+                scent_weights_dirty = true;
                 m = std::make_unique<maptile_soa>();
                 std::uninitialized_fill_n( &m->ter[0][0], elements, uniform_ter );
                 std::uninitialized_fill_n( &m->frn[0][0], elements, furn_str_id::NULL_ID() );
@@ -100,13 +107,24 @@ class submap
         }
 
         void set_trap( const point_sm_ms &p, trap_id trap ) {
+            if( is_uniform() && trap == tr_null ) {
+                return;
+            }
             ensure_nonuniform();
-            m->trp[p.x()][p.y()] = trap;
+            mark_modified();
+            trap_id &old_trap = m->trp[p.x()][p.y()];
+            trap_tiles += ( trap != tr_null ) - ( old_trap != tr_null );
+            old_trap = trap;
         }
 
         void set_all_traps( const trap_id &trap ) {
+            if( is_uniform() && trap == tr_null ) {
+                return;
+            }
             ensure_nonuniform();
+            mark_modified();
             std::uninitialized_fill_n( &m->trp[0][0], elements, trap );
+            trap_tiles = trap == tr_null ? 0 : static_cast<int>( elements );
         }
 
         furn_id get_furn( const point_sm_ms &p ) const {
@@ -117,13 +135,27 @@ class submap
         }
 
         void set_furn( const point_sm_ms &p, furn_id furn ) {
+            if( is_uniform() && furn == furn_str_id::NULL_ID() ) {
+                return;
+            }
             ensure_nonuniform();
-            m->frn[p.x()][p.y()] = furn;
+            mark_modified();
+            scent_weights_dirty = true;
+            furn_id &old_furn = m->frn[p.x()][p.y()];
+            const furn_id &null_furn = furn_str_id::NULL_ID();
+            furn_tiles += ( furn != null_furn ) - ( old_furn != null_furn );
+            old_furn = furn;
         }
 
         void set_all_furn( const furn_id &furn ) {
+            if( is_uniform() && furn == furn_str_id::NULL_ID() ) {
+                return;
+            }
             ensure_nonuniform();
+            mark_modified();
+            scent_weights_dirty = true;
             std::uninitialized_fill_n( &m->frn[0][0], elements, furn );
+            furn_tiles = furn == furn_str_id::NULL_ID() ? 0 : static_cast<int>( elements );
         }
         int get_map_damage( const point_sm_ms &p ) const {
             auto it = ephemeral_data.find( p );
@@ -134,6 +166,7 @@ class submap
         }
 
         void set_map_damage( const point_sm_ms &p, int dmg ) {
+            mark_modified();
             ephemeral_data[p] = { dmg };
         }
 
@@ -145,11 +178,21 @@ class submap
         }
 
         void set_ter( const point_sm_ms &p, ter_id terr ) {
+            if( is_uniform() && terr == uniform_ter ) {
+                return;
+            }
             ensure_nonuniform();
+            mark_modified();
+            scent_weights_dirty = true;
             m->ter[p.x()][p.y()] = terr;
         }
 
         void set_all_ter( const ter_id &terr, bool uniform_ok = false ) {
+            if( is_uniform() && terr == uniform_ter ) {
+                return;
+            }
+            mark_modified();
+            scent_weights_dirty = true;
             if( !uniform_ok ) {
                 ensure_nonuniform();
             }
@@ -168,7 +211,11 @@ class submap
         }
 
         void set_radiation( const point_sm_ms &p, const int radiation ) {
+            if( is_uniform() && radiation == 0 ) {
+                return;
+            }
             ensure_nonuniform();
+            mark_modified();
             m->rad[p.x()][p.y()] = radiation;
         }
 
@@ -180,13 +227,24 @@ class submap
         }
 
         void set_lum( const point_sm_ms &p, uint8_t luminance ) {
+            if( is_uniform() && luminance == 0 ) {
+                return;
+            }
             ensure_nonuniform();
-            m->lum[p.x()][p.y()] = luminance;
+            std::uint8_t &old_lum = m->lum[p.x()][p.y()];
+            lum_tiles += ( luminance != 0 ) - ( old_lum != 0 );
+            old_lum = luminance;
         }
 
         void update_lum_add( const point_sm_ms &p, const item &i ) {
+            if( !i.is_emissive() ) {
+                return;
+            }
             ensure_nonuniform();
-            if( i.is_emissive() && m->lum[p.x()][p.y()] < 255 ) {
+            if( m->lum[p.x()][p.y()] == 0 ) {
+                lum_tiles++;
+            }
+            if( m->lum[p.x()][p.y()] < 255 ) {
                 m->lum[p.x()][p.y()]++;
             }
         }
@@ -199,6 +257,8 @@ class submap
                 cata::colony<item> static noitems;
                 return noitems;
             }
+            mark_modified();
+            forget_stored_volume( p );
             return m->itm[p.x()][p.y()];
         }
 
@@ -210,12 +270,28 @@ class submap
             return m->itm[p.x()][p.y()];
         }
 
+        /**
+         * Total volume of the items at p.  Kept once asked for, until the items there are
+         * handed out by @ref get_items or the turn ends, so changes made through references
+         * to the items kept elsewhere are picked up by the next turn.  Adding, removing and
+         * merging through the functions below keeps it up to date.
+         */
+        units::volume get_stored_volume( const point_sm_ms &p ) const;
+        /** Adds @p copies copies of @p it at p and returns the first. */
+        cata::colony<item>::iterator insert_items( const point_sm_ms &p, const item &it,
+                int copies = 1 );
+        cata::colony<item>::iterator erase_item( const point_sm_ms &p,
+                const cata::colony<item>::const_iterator &it );
+        /** Merges the charges of @p it into an item at p it stacks with, nullptr if none does. */
+        item *merge_charges( const point_sm_ms &p, const item &it );
+
         // TODO: Replace this as it essentially makes fld public
         field &get_field( const point_sm_ms &p ) {
             if( is_uniform() ) {
                 field static nofield;
                 return nofield;
             }
+            mark_modified();
             return m->fld[p.x()][p.y()];
         }
 
@@ -243,6 +319,7 @@ class submap
             ins.str = str;
 
             cosmetics.push_back( ins );
+            mark_modified();
         }
 
         units::temperature_delta get_temperature_mod() const {
@@ -250,6 +327,7 @@ class submap
         }
 
         void set_temperature_mod( units::temperature_delta new_temperature_mod ) {
+            mark_modified();
             temperature_mod = units::to_fahrenheit_delta( new_temperature_mod );
         }
 
@@ -283,8 +361,36 @@ class submap
         void mirror( bool horizontally );
 
         void store( JsonOut &jsout ) const;
+        /** The parts of @ref store that are not per-tile layers (terrain, furniture, radiation). */
+        void store_header( JsonOut &jsout ) const;
+        /** Items, traps, fields and everything else @ref store writes after the tile layers.
+         * Must not be called on uniform submaps. */
+        void store_contents( JsonOut &jsout ) const;
         void load( const JsonValue &jv, const std::string &member_name, int version );
 
+        /**
+         * Modification tracking for incremental saving.  The mutators above bump the
+         * generation themselves, code changing the public members below directly has to
+         * call mark_modified().
+         */
+        void mark_modified() {
+            ++modified_generation;
+        }
+        /** Changes whenever the submap is modified, @see mark_modified. */
+        uint64_t get_modified_generation() const {
+            return modified_generation;
+        }
+        /** Record that the current state has been written to (or read from) disk. */
+        void mark_saved() {
+            saved_generation = modified_generation;
+        }
+        /**
+         * False if this submap is known to match its savefile.  Submaps holding state
+         * that changes behind our back (vehicles, active items, camps, constructions)
+         * always count as modified.
+         */
+        bool needs_saving() const;
+
         // If is_uniform is true, this submap is a solid block of terrain
         // Uniform submaps aren't saved/loaded, because regenerating them is faster
         bool is_uniform() const {
@@ -305,6 +411,61 @@ class submap
         active_item_cache active_items;
 
         int field_count = 0;
+        /**
+         * Tiles that may hold fields, indexed x * SEEY + y.  Set whenever a field is added and
+         * cleared by field processing once it finds the tile empty, so it can skip the others.
+         */
+        std::bitset<SEEX * SEEY> field_tiles; // NOLINT(cata-serialize)
+        void mark_field_tile( const point_sm_ms &p ) {
+            field_tiles.set( static_cast<size_t>( p.x() * SEEY + p.y() ) );
+        }
+        /** False if the tile at p is known to hold no fields, see @ref field_tiles. */
+        bool may_have_field( const point_sm_ms &p ) const {
+            return field_tiles.test( static_cast<size_t>( p.x() * SEEY + p.y() ) );
+        }
+        /**
+         * Calls f( const point_sm_ms &, const field & ) for every tile holding fields, column
+         * by column.  Only the tiles marked in @ref field_tiles are looked at.
+         */
+        template<typename F>
+        void for_each_field( const F &f ) const {
+            if( is_uniform() || field_tiles.none() ) {
+                return;
+            }
+            for( size_t tile = 0; tile < field_tiles.size(); tile++ ) {
+                if( !field_tiles.test( tile ) ) {
+                    continue;
+                }
+                const point_sm_ms p( static_cast<int>( tile / SEEY ), static_cast<int>( tile % SEEY ) );
+                const field &fld = m->fld[p.x()][p.y()];
+                if( fld.displayed_field_type() ) {
+                    f( p, fld );
+                }
+            }
+        }
+        /**
+         * Number of tiles with a trap, with furniture and with light emitting items, kept up
+         * by the setters so passes looking for those can skip submaps that have none.  Any
+         * code writing the tiles directly calls @ref count_contents afterwards.  Fields are
+         * summed up by @ref field_count and @ref field_tiles and graffiti lives in
+         * @ref cosmetics.
+         */
+        int trap_count() const {
+            return trap_tiles;
+        }
+        int furn_count() const {
+            return furn_tiles;
+        }
+        int lum_count() const {
+            return lum_tiles;
+        }
+        void count_contents();
+        /**
+         * How much scent passes through each tile, from its terrain and furniture: 0 where
+         * NO_SCENT blocks it, 2 where REDUCE_SCENT lets only a fifth through and 10 elsewhere.
+         * Worked out again on first use after the terrain or furniture changed.
+         */
+        const cata::mdarray<std::uint8_t, point_sm_ms> &get_scent_weights() const;
         time_point last_touched = calendar::turn_zero;
         bool reverted = false; // NOLINT(cata-serialize)
         std::vector<spawn_point> spawns;
@@ -322,11 +483,29 @@ class submap
         };
 
     private:
+        void forget_stored_volume( const point_sm_ms &p ) {
+            if( !stored_volumes.empty() ) {
+                stored_volumes.erase( p );
+            }
+        }
+        /** The known stored volume at p, see @ref get_stored_volume, nullptr if not known. */
+        units::volume *known_stored_volume( const point_sm_ms &p ) const;
+
         std::map<point_sm_ms, tile_data> ephemeral_data;
         std::map<point_sm_ms, computer> computers;
         std::unique_ptr<maptile_soa> m;
         ter_id uniform_ter = t_null;
+        mutable bool scent_weights_dirty = true; // NOLINT(cata-serialize)
+        int trap_tiles = 0; // NOLINT(cata-serialize)
+        int furn_tiles = 0; // NOLINT(cata-serialize)
+        int lum_tiles = 0; // NOLINT(cata-serialize)
+        // See get_stored_volume.
+        mutable std::map<point_sm_ms, units::volume> stored_volumes; // NOLINT(cata-serialize)
+        mutable time_point stored_volumes_turn; // NOLINT(cata-serialize)
         int temperature_mod = 0; // delta in F
+        // Freshly created submaps have never been saved.
+        uint64_t modified_generation = 1; // NOLINT(cata-serialize)
+        uint64_t saved_generation = 0; // NOLINT(cata-serialize)
 
         static constexpr size_t elements = SEEX * SEEY;
 };
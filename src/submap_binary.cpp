@@ -0,0 +1,296 @@
+#include "submap_binary.h"
+
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "cata_utility.h"
+#include "coordinates.h"
+#include "flexbuffer_json.h"
+#include "game_constants.h"
+#include "json.h"
+#include "mapdata.h"
+#include "point.h"
+#include "string_formatter.h"
+#include "submap.h"
+
+namespace
+{
+
+constexpr std::string_view quad_magic = "CDDAQUAD";
+constexpr int tiles_per_submap = SEEX * SEEY;
+
+// Bits of the per-submap flags field.
+constexpr uint64_t flag_uniform = 1;
+
+point_sm_ms tile_at( int index )
+{
+    // Same traversal order as the JSON format, x varies fastest.
+    return point_sm_ms( index % SEEX, index / SEEX );
+}
+
+class quad_writer
+{
+    public:
+        void write_varint( uint64_t v ) {
+            while( v >= 0x80 ) {
+                out.push_back( static_cast<char>( ( v & 0x7f ) | 0x80 ) );
+                v >>= 7;
+            }
+            out.push_back( static_cast<char>( v ) );
+        }
+        void write_signed( int64_t v ) {
+            write_varint( ( static_cast<uint64_t>( v ) << 1 ) ^ static_cast<uint64_t>( v >> 63 ) );
+        }
+        void write_string( std::string_view s ) {
+            write_varint( s.size() );
+            out.append( s );
+        }
+        void write_raw( std::string_view s ) {
+            out.append( s );
+        }
+        // Writes (value, run length) pairs for the per-tile values produced by @p value_at.
+        template<typename F>
+        void write_runs( F value_at, bool is_signed ) {
+            int64_t current = value_at( tile_at( 0 ) );
+            uint64_t run = 1;
+            for( int i = 1; i < tiles_per_submap; ++i ) {
+                const int64_t v = value_at( tile_at( i ) );
+                if( v == current ) {
+                    ++run;
+                    continue;
+                }
+                write_run( current, run, is_signed );
+                current = v;
+                run = 1;
+            }
+            write_run( current, run, is_signed );
+        }
+
+        std::string out;
+
+    private:
+        void write_run( int64_t value, uint64_t run, bool is_signed ) {
+            if( is_signed ) {
+                write_signed( value );
+            } else {
+                write_varint( static_cast<uint64_t>( value ) );
+            }
+            write_varint( run );
+        }
+};
+
+class quad_reader
+{
+    public:
+        explicit quad_reader( std::string_view data ) : data( data ) {}
+
+        uint64_t read_varint() {
+            uint64_t result = 0;
+            for( int shift = 0; shift < 64; shift += 7 ) {
+                const uint8_t byte = static_cast<uint8_t>( read_raw( 1 )[0] );
+                result |= static_cast<uint64_t>( byte & 0x7f ) << shift;
+                if( !( byte & 0x80 ) ) {
+                    return result;
+                }
+            }
+            throw std::runtime_error( "malformed varint in binary map quad" );
+        }
+        int64_t read_signed() {
+            const uint64_t v = read_varint();
+            return static_cast<int64_t>( v >> 1 ) ^ -static_cast<int64_t>( v & 1 );
+        }
+        // Bounded so a corrupt count can't make us allocate absurd amounts of memory.
+        size_t read_count( size_t max ) {
+            const uint64_t v = read_varint();
+            if( v > max ) {
+                throw std::runtime_error( string_format( "count %d out of range in binary map quad", v ) );
+            }
+            return static_cast<size_t>( v );
+        }
+        std::string_view read_string() {
+            return read_raw( read_count( data.size() - pos ) );
+        }
+        std::string_view read_raw( size_t len ) {
+            if( len > data.size() - pos ) {
+                throw std::runtime_error( "unexpected end of binary map quad" );
+            }
+            std::string_view result = data.substr( pos, len );
+            pos += len;
+            return result;
+        }
+        // Reads (value, run length) pairs and hands every tile's value to @p set.
+        template<typename F>
+        void read_runs( F set, bool is_signed ) {
+            int tile = 0;
+            while( tile < tiles_per_submap ) {
+                const int64_t value = is_signed ? read_signed() : static_cast<int64_t>( read_varint() );
+                const size_t run = read_count( tiles_per_submap - tile );
+                if( run == 0 ) {
+                    throw std::runtime_error( "empty run in binary map quad" );
+                }
+                for( size_t i = 0; i < run; ++i, ++tile ) {
+                    set( tile_at( tile ), value );
+                }
+            }
+        }
+
+    private:
+        std::string_view data;
+        size_t pos = 0;
+};
+
+template<typename Id>
+class palette_builder
+{
+    public:
+        uint64_t index_of( const Id &id ) {
+            auto it = indices.find( id );
+            if( it == indices.end() ) {
+                it = indices.emplace( id, ids.size() ).first;
+                ids.push_back( id );
+            }
+            return it->second;
+        }
+        void write( quad_writer &w ) const {
+            w.write_varint( ids.size() );
+            for( const Id &id : ids ) {
+                w.write_string( id.id().str() );
+            }
+        }
+
+    private:
+        std::unordered_map<Id, uint64_t> indices;
+        std::vector<Id> ids;
+};
+
+template<typename T>
+T palette_entry( const std::vector<T> &palette, int64_t index )
+{
+    if( index < 0 || static_cast<size_t>( index ) >= palette.size() ) {
+        throw std::runtime_error( "palette index out of range in binary map quad" );
+    }
+    return palette[index];
+}
+
+} // namespace
+
+namespace submap_binary
+{
+
+bool is_binary_quad( std::string_view data )
+{
+    return string_starts_with( data, quad_magic );
+}
+
+std::string write_quad( const std::vector<std::pair<tripoint_abs_sm, submap *>> &submaps,
+                        int savegame_version )
+{
+    // The palettes must precede the submaps, so encode those into a separate buffer first.
+    palette_builder<ter_id> ter_palette;
+    palette_builder<furn_id> furn_palette;
+    quad_writer body;
+    body.write_varint( submaps.size() );
+    for( const std::pair<tripoint_abs_sm, submap *> &elem : submaps ) {
+        const submap &sm = *elem.second;
+        body.write_signed( elem.first.x() );
+        body.write_signed( elem.first.y() );
+        body.write_signed( elem.first.z() );
+        body.write_varint( savegame_version );
+        body.write_varint( sm.is_uniform() ? flag_uniform : 0 );
+        body.write_runs( [&]( const point_sm_ms & p ) {
+            return ter_palette.index_of( sm.get_ter( p ) );
+        }, false );
+        if( !sm.is_uniform() ) {
+            body.write_runs( [&]( const point_sm_ms & p ) {
+                return furn_palette.index_of( sm.get_furn( p ) );
+            }, false );
+            body.write_runs( [&]( const point_sm_ms & p ) {
+                return sm.get_radiation( p );
+            }, true );
+        }
+        body.write_string( serialize_wrapper( [&]( JsonOut & jsout ) {
+            jsout.start_object();
+            sm.store_header( jsout );
+            if( !sm.is_uniform() ) {
+                sm.store_contents( jsout );
+            }
+            jsout.end_object();
+        } ) );
+    }
+
+    quad_writer result;
+    result.write_raw( quad_magic );
+    result.write_varint( format_version );
+    ter_palette.write( result );
+    furn_palette.write( result );
+    result.write_raw( body.out );
+    return std::move( result.out );
+}
+
+void read_quad( std::string_view data,
+                const std::function<void( const tripoint_abs_sm &, std::unique_ptr<submap> &, int )> &add_submap )
+{
+    if( !is_binary_quad( data ) ) {
+        throw std::runtime_error( "not a binary map quad" );
+    }
+    quad_reader r( data.substr( quad_magic.size() ) );
+    const uint64_t version = r.read_varint();
+    if( version != format_version ) {
+        throw std::runtime_error( string_format( "unsupported binary map quad version %d", version ) );
+    }
+
+    std::vector<std::pair<ter_id, furn_id>> ter_palette( r.read_count( tiles_per_submap * 4 ) );
+    for( std::pair<ter_id, furn_id> &entry : ter_palette ) {
+        entry = ter_furn_migrations::migrate( ter_str_id( std::string( r.read_string() ) ) );
+    }
+    std::vector<std::pair<ter_id, furn_id>> furn_palette( r.read_count( tiles_per_submap * 4 ) );
+    for( std::pair<ter_id, furn_id> &entry : furn_palette ) {
+        entry = ter_furn_migrations::migrate( furn_str_id( std::string( r.read_string() ) ) );
+    }
+
+    const size_t num_submaps = r.read_count( 4 );
+    for( size_t n = 0; n < num_submaps; ++n ) {
+        const int x = static_cast<int>( r.read_signed() );
+        const int y = static_cast<int>( r.read_signed() );
+        const int z = static_cast<int>( r.read_signed() );
+        const tripoint_abs_sm pos( x, y, z );
+        const int savegame_version = static_cast<int>( r.read_varint() );
+        const uint64_t flags = r.read_varint();
+
+        std::unique_ptr<submap> sm = std::make_unique<submap>();
+        // Like the JSON loader, loaded submaps are never uniform.
+        sm->ensure_nonuniform();
+        r.read_runs( [&]( const point_sm_ms & p, int64_t idx ) {
+            const std::pair<ter_id, furn_id> &entry = palette_entry( ter_palette, idx );
+            sm->set_ter( p, entry.first );
+            if( entry.second ) {
+                sm->set_furn( p, entry.second );
+            }
+        }, false );
+        if( !( flags & flag_uniform ) ) {
+            r.read_runs( [&]( const point_sm_ms & p, int64_t idx ) {
+                const std::pair<ter_id, furn_id> &entry = palette_entry( furn_palette, idx );
+                if( entry.first ) {
+                    sm->set_ter( p, entry.first );
+                }
+                // Don't wipe furniture placed by a terrain migration.
+                if( entry.second ) {
+                    sm->set_furn( p, entry.second );
+                }
+            }, false );
+            r.read_runs( [&]( const point_sm_ms & p, int64_t rad ) {
+                sm->set_radiation( p, static_cast<int>( rad ) );
+            }, true );
+        }
+        deserialize_wrapper( [&]( const JsonValue & jsin ) {
+            for( JsonMember member : jsin.get_object() ) {
+                sm->load( member, member.name(), savegame_version );
+            }
+        }, std::string( r.read_string() ) );
+
+        add_submap( pos, sm, savegame_version );
+    }
+}
+
+} // namespace submap_binary
@@ -0,0 +1,56 @@
+#pragma once
+#ifndef CATA_SRC_SUBMAP_BINARY_H
+#define CATA_SRC_SUBMAP_BINARY_H
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "coords_fwd.h"
+
+class submap;
+
+/**
+ * Compact binary encoding of a map quad (the submaps of one overmap terrain), used in
+ * place of the JSON .map files when the MAP_SAVE_FORMAT option asks for it.
+ *
+ * Terrain and furniture are written as indices into a per-quad palette of string ids,
+ * so the files stay valid when int ids change between game versions.  The terrain,
+ * furniture and radiation layers are run-length encoded.  Everything else a submap
+ * stores (items, fields, vehicles, ...) is kept as an embedded JSON object, so those
+ * parts share their (de)serialization code and migrations with the JSON format.
+ *
+ * Layout, all integers are LEB128 varints, signed ones zigzag encoded:
+ *   magic "CDDAQUAD", format version,
+ *   terrain palette (count, then length-prefixed strings), furniture palette,
+ *   submap count, then per submap:
+ *     x, y, z, savegame version, flags (1 = uniform),
+ *     terrain runs (palette index, length) covering all SEEX * SEEY tiles,
+ *     unless uniform: furniture runs, then radiation runs (value, length),
+ *     length-prefixed JSON object holding the remaining submap members.
+ */
+namespace submap_binary
+{
+
+/** Increase this when changing the layout, @ref read_quad rejects unknown versions. */
+constexpr int format_version = 1;
+
+/** Whether @p data starts like a binary quad, anything else is assumed to be JSON. */
+bool is_binary_quad( std::string_view data );
+
+std::string write_quad( const std::vector<std::pair<tripoint_abs_sm, submap *>> &submaps,
+                        int savegame_version );
+
+/**
+ * Decode a quad, calling @p add_submap for every submap in it.
+ * @throws std::runtime_error or JsonError on corrupt data.
+ */
+void read_quad( std::string_view data,
+                const std::function<void( const tripoint_abs_sm &, std::unique_ptr<submap> &, int )> &add_submap );
+
+} // namespace submap_binary
+
+#endif // CATA_SRC_SUBMAP_BINARY_H
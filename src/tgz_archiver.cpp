@@ -1,21 +1,93 @@
 #include "tgz_archiver.h"
 
+#include <algorithm>
 #include <array>
 #include <chrono>
 #include <cmath>
+#include <exception>
 #include <fstream>
 #include <iomanip>
 #include <locale>
 #include <numeric>
 #include <sstream>
 
+#include "cata_utility.h"
 #include "debug.h"
 #include "filesystem.h"
-#include "zlib.h"
+#include "thread_pool.h"
+
+// Fast, the archive is mostly read once and thrown away.
+static constexpr int compression_level = 3;
+
+tgz_archiver::tgz_archiver( std::string ofile )
+    : output( std::move( ofile ) ), _fsnow( fs::file_time_type::clock::now() ),
+      _sysnow( std::chrono::system_clock::now() )
+{
+}
 
 tgz_archiver::~tgz_archiver()
 {
-    finalize();
+    try {
+        finalize();
+    } catch( ... ) {
+        // ignored in destructor
+    }
+}
+
+bool tgz_archiver::_open()
+{
+    if( out.is_open() ) {
+        return true;
+    }
+    out.open( fs::u8path( output ), std::ios::binary );
+    if( !out ) {
+        return false;
+    }
+    pool = std::make_unique<thread_pool>();
+    chunk.reserve( chunk_size );
+    return true;
+}
+
+void tgz_archiver::_append( char const *data, std::size_t size )
+{
+    while( size > 0 ) {
+        std::size_t const part = std::min( size, chunk_size - chunk.size() );
+        chunk.append( data, part );
+        data += part;
+        size -= part;
+        if( chunk.size() == chunk_size ) {
+            queued.push_back( std::move( chunk ) );
+            chunk = std::string();
+            chunk.reserve( chunk_size );
+            // Two chunks per worker keep them busy while the next batch is read.
+            if( queued.size() >= pool->size() * 2 ) {
+                _flush_batch();
+            }
+        }
+    }
+}
+
+void tgz_archiver::_flush_batch()
+{
+    try {
+        pool->wait();
+    } catch( std::exception const &err ) {
+        DebugLog( DebugLevel::D_ERROR, DebugClass::D_MAIN )
+                << "compressing archive failed: " << err.what();
+        failed = true;
+        compressing.clear();
+    }
+    for( std::string const &member : compressing ) {
+        out.write( member.data(), member.size() );
+    }
+    failed |= !out;
+    compressing = std::move( queued );
+    queued.clear();
+    for( std::string &member : compressing ) {
+        pool->push( [&member]() {
+            member = gzip_compress( member, compression_level );
+        } );
+    }
 }
 
 std::string tgz_archiver::_gen_tar_header( fs::path const &file_name, fs::path const &prefix,
@@ -55,7 +127,7 @@ std::string tgz_archiver::_gen_tar_header( fs::path const &file_name, fs::path c
 
 bool tgz_archiver::add_file( fs::path const &real_path, fs::path const &archived_path )
 {
-    if( fd == nullptr && ( fd = gzopen( output.c_str(), "wb" ), fd == nullptr ) ) {
+    if( !_open() ) {
         return false;
     }
 
@@ -96,30 +168,39 @@ bool tgz_archiver::add_file( fs::path const &real_path, fs::path const &archived
     } else {
         header = _gen_tar_header( file_name, prefix, real_path, 0 );
     }
-    bool ret = gzwrite( fd, header.c_str(), tar_block_size ) != 0;
+    _append( header.c_str(), tar_block_size );
 
-    if( !ret || !fs::is_regular_file( real_path ) || size == 0 ) {
-        return ret;
+    if( failed || !fs::is_regular_file( real_path ) || size == 0 ) {
+        return !failed;
     }
 
     double const buf_size = std::ceil( static_cast<double>( size ) / tar_block_size ) * tar_block_size;
     std::string buf( static_cast<std::string::size_type>( buf_size ), '\0' );
     if( file.read( buf.data(), size ) ) {
-        ret &= gzwrite( fd, buf.data(), buf.size() ) != 0;
+        _append( buf.data(), buf.size() );
     } else {
         debugmsg( "failed to read file %s", real_path.string() );
     }
 
-    return ret;
+    return !failed;
 }
 
-void tgz_archiver::finalize()
+bool tgz_archiver::finalize()
 {
-    if( fd == nullptr ) {
-        return;
+    if( !out.is_open() ) {
+        return !failed;
     }
     std::array<char, tar_block_size * 2> const fin{};
-    gzwrite( fd, fin.data(), fin.size() );
-    gzclose_w( fd );
-    fd = nullptr;
+    _append( fin.data(), fin.size() );
+    if( !chunk.empty() ) {
+        queued.push_back( std::move( chunk ) );
+        chunk.clear();
+    }
+    // The first flush starts on the last chunks, the second one writes them.
+    _flush_batch();
+    _flush_batch();
+    out.close();
+    failed |= !out;
+    pool.reset();
+    return !failed;
 }
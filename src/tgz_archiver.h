@@ -3,31 +3,55 @@
 #define CATA_SRC_MAP_TGZ_ARCHIVER_H
 #include <array>
 #include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <memory>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include <ghc/fs_std_fwd.hpp>
 
 #include "filesystem.h"
-#include "zlib.h"
 
+class thread_pool;
+
+/**
+ * Writes a .tar.gz archive.
+ *
+ * The tar stream is cut into chunks that are compressed as independent gzip members on a
+ * thread pool, like pigz does.  A gzip file may consist of several members, so the result
+ * is read by any gzip tool.  While one batch of chunks is being compressed the next one is
+ * already read from disk.
+ */
 class tgz_archiver
 {
     private:
         static constexpr std::size_t tar_block_size = 512;
+        static constexpr std::size_t chunk_size = 1024 * 1024;
         using tar_block_t = std::array<char, tar_block_size>;
         std::string _gen_tar_header( fs::path const &file_name, fs::path const &prefix,
                                      fs::path const &real_path, std::streamsize size );
+        bool _open();
+        void _append( char const *data, std::size_t size );
+        /** Write the chunks compressed so far and start on the queued ones. */
+        void _flush_batch();
 
-        gzFile fd = nullptr;
+        std::ofstream out;
+        bool failed = false;
+        // Tar data not yet filling a whole chunk.
+        std::string chunk;
+        // Full chunks waiting for the next batch.
+        std::vector<std::string> queued;
+        // Chunks the workers are compressing in place, written out on the next flush.
+        std::vector<std::string> compressing;
+        std::unique_ptr<thread_pool> pool;
         std::string const output;
         fs::file_time_type const _fsnow;
         std::chrono::system_clock::time_point const _sysnow;
 
     public:
-        explicit tgz_archiver( std::string ofile )
-            : output( std::move( ofile ) ), _fsnow( fs::file_time_type::clock::now() ),
-              _sysnow( std::chrono::system_clock::now() ) {};
+        explicit tgz_archiver( std::string ofile );
         ~tgz_archiver();
 
         tgz_archiver( tgz_archiver const & ) = delete;
@@ -36,7 +60,8 @@ class tgz_archiver
         tgz_archiver &operator=( tgz_archiver && ) = delete;
 
         bool add_file( fs::path const &real_path, fs::path const &archived_path );
-        void finalize();
+        /** Write the remaining data and close the archive. @return false on any write error. */
+        bool finalize();
 };
 
 #endif // CATA_SRC_MAP_TGZ_ARCHIVER_H
@@ -0,0 +1,245 @@
+#include "thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "options.h"
+
+thread_pool::thread_pool( unsigned int num_threads, size_t max_queued ) : max_queued( max_queued )
+{
+    if( num_threads == 0 ) {
+        num_threads = default_size();
+    }
+    workers.reserve( num_threads );
+    for( unsigned int i = 0; i < num_threads; ++i ) {
+        workers.emplace_back( &thread_pool::worker_loop, this );
+    }
+}
+
+thread_pool::~thread_pool()
+{
+    {
+        std::lock_guard<std::mutex> lock( mutex );
+        stopping = true;
+    }
+    task_available.notify_all();
+    for( std::thread &worker : workers ) {
+        worker.join();
+    }
+}
+
+static thread_local bool is_worker_thread = false;
+
+unsigned int thread_pool::default_size()
+{
+    return std::max( 1U, std::thread::hardware_concurrency() );
+}
+
+bool thread_pool::on_worker_thread()
+{
+    return is_worker_thread;
+}
+
+void thread_pool::push( std::function<void()> task )
+{
+    {
+        std::unique_lock<std::mutex> lock( mutex );
+        task_done.wait( lock, [this]() {
+            return max_queued == 0 || queue.size() < max_queued;
+        } );
+        queue.emplace_back( std::move( task ) );
+    }
+    task_available.notify_one();
+}
+
+bool thread_pool::push_for( std::function<void()> &task, std::chrono::milliseconds timeout )
+{
+    {
+        std::unique_lock<std::mutex> lock( mutex );
+        if( !task_done.wait_for( lock, timeout, [this]() {
+        return max_queued == 0 || queue.size() < max_queued;
+    } ) ) {
+            return false;
+        }
+        queue.emplace_back( std::move( task ) );
+    }
+    task_available.notify_one();
+    return true;
+}
+
+bool thread_pool::idle() const
+{
+    return queue.empty() && running == 0;
+}
+
+void thread_pool::rethrow_failure()
+{
+    if( failure ) {
+        std::exception_ptr err = std::exchange( failure, nullptr );
+        std::rethrow_exception( err );
+    }
+}
+
+void thread_pool::wait()
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    task_done.wait( lock, [this]() {
+        return idle();
+    } );
+    rethrow_failure();
+}
+
+bool thread_pool::wait_for( std::chrono::milliseconds timeout )
+{
+    std::unique_lock<std::mutex> lock( mutex );
+    if( !task_done.wait_for( lock, timeout, [this]() {
+    return idle();
+    } ) ) {
+        return false;
+    }
+    rethrow_failure();
+    return true;
+}
+
+size_t thread_pool::num_completed() const
+{
+    std::lock_guard<std::mutex> lock( mutex );
+    return completed;
+}
+
+void thread_pool::worker_loop()
+{
+    is_worker_thread = true;
+    std::unique_lock<std::mutex> lock( mutex );
+    while( true ) {
+        task_available.wait( lock, [this]() {
+            return stopping || !queue.empty();
+        } );
+        if( queue.empty() ) {
+            // Only reachable when stopping, the queue is drained before exiting.
+            return;
+        }
+        std::function<void()> task = std::move( queue.front() );
+        queue.pop_front();
+        ++running;
+        lock.unlock();
+        // Room in the queue for a blocked producer.
+        task_done.notify_all();
+
+        std::exception_ptr err;
+        try {
+            task();
+        } catch( ... ) {
+            err = std::current_exception();
+        }
+
+        lock.lock();
+        --running;
+        ++completed;
+        if( err && !failure ) {
+            failure = err;
+        }
+        task_done.notify_all();
+    }
+}
+
+thread_pool *shared_thread_pool()
+{
+    static const unsigned int num_threads = []() {
+        const int configured = has_option( "WORKER_THREADS" ) ?
+                               get_option<int>( "WORKER_THREADS" ) : 0;
+        if( configured > 0 ) {
+            return static_cast<unsigned int>( configured );
+        }
+        return thread_pool::default_size() - 1;
+    }();
+    if( num_threads == 0 ) {
+        return nullptr;
+    }
+    static thread_pool pool( num_threads );
+    return &pool;
+}
+
+unsigned int num_parallel_threads()
+{
+    const thread_pool *pool = shared_thread_pool();
+    return pool == nullptr ? 1 : pool->size() + 1;
+}
+
+void parallel_for( const size_t count, const std::function<void( size_t )> &fn )
+{
+    thread_pool *pool = shared_thread_pool();
+    const size_t num_helpers = pool == nullptr || count < 2 ? 0 :
+                               std::min<size_t>( pool->size(), count - 1 );
+    if( num_helpers == 0 ) {
+        std::exception_ptr failure;
+        for( size_t i = 0; i < count; ++i ) {
+            try {
+                fn( i );
+            } catch( ... ) {
+                if( !failure ) {
+                    failure = std::current_exception();
+                }
+            }
+        }
+        if( failure ) {
+            std::rethrow_exception( failure );
+        }
+        return;
+    }
+
+    // Helpers may only get to run after all the indices are done, so they share this
+    // with the caller instead of referring to its stack.  fn is only called while an
+    // index is left, which means the caller is still waiting.
+    struct shared_state {
+        const std::function<void( size_t )> *fn;
+        size_t count;
+        std::atomic<size_t> next{ 0 };
+        std::mutex mutex;
+        std::condition_variable all_done;
+        size_t num_done = 0;
+        std::exception_ptr failure;
+    };
+    std::shared_ptr<shared_state> state = std::make_shared<shared_state>();
+    state->fn = &fn;
+    state->count = count;
+    const auto work = [state]() {
+        size_t num_done = 0;
+        std::exception_ptr failure;
+        for( size_t i = state->next++; i < state->count; i = state->next++ ) {
+            try {
+                ( *state->fn )( i );
+            } catch( ... ) {
+                if( !failure ) {
+                    failure = std::current_exception();
+                }
+            }
+            ++num_done;
+        }
+        if( num_done == 0 ) {
+            return;
+        }
+        std::lock_guard<std::mutex> lock( state->mutex );
+        state->num_done += num_done;
+        if( failure && !state->failure ) {
+            state->failure = failure;
+        }
+        if( state->num_done == state->count ) {
+            state->all_done.notify_all();
+        }
+    };
+    for( size_t i = 0; i < num_helpers; ++i ) {
+        pool->push( work );
+    }
+    work();
+
+    std::unique_lock<std::mutex> lock( state->mutex );
+    state->all_done.wait( lock, [&state]() {
+        return state->num_done == state->count;
+    } );
+    if( state->failure ) {
+        std::rethrow_exception( state->failure );
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+#ifndef CATA_SRC_THREAD_POOL_H
+#define CATA_SRC_THREAD_POOL_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * A fixed-size set of worker threads consuming a bounded queue of tasks.
+ *
+ * Producers that outrun the workers are blocked once @ref max_queued tasks are waiting,
+ * which keeps memory bounded and avoids spawning a thread per task.  The timed variants of
+ * push and wait let the main thread keep the UI alive while it waits.
+ *
+ * Exceptions thrown by tasks are caught on the worker thread; the first one is rethrown
+ * on the thread that calls @ref wait or @ref wait_for once the pool has gone idle.
+ */
+class thread_pool
+{
+    public:
+        /**
+         * @param num_threads Number of worker threads, 0 means @ref default_size.
+         * @param max_queued Number of pending tasks after which push blocks, 0 means unbounded.
+         */
+        explicit thread_pool( unsigned int num_threads = 0, size_t max_queued = 0 );
+        thread_pool( const thread_pool & ) = delete;
+        thread_pool &operator=( const thread_pool & ) = delete;
+        /** Finishes all queued tasks, then joins the workers. */
+        ~thread_pool();
+
+        /** Queue a task, blocking as long as the queue is full. */
+        void push( std::function<void()> task );
+        /**
+         * Queue a task, blocking at most @p timeout for room in the queue.
+         * @return false if the queue stayed full, @p task is left untouched in that case.
+         */
+        bool push_for( std::function<void()> &task, std::chrono::milliseconds timeout );
+
+        /** Block until every queued task has finished. */
+        void wait();
+        /**
+         * Block at most @p timeout for every queued task to finish.
+         * @return true if the pool is idle.
+         */
+        bool wait_for( std::chrono::milliseconds timeout );
+
+        /** Number of tasks finished since the pool was created. */
+        size_t num_completed() const;
+        /** Number of worker threads. */
+        unsigned int size() const {
+            return static_cast<unsigned int>( workers.size() );
+        }
+
+        /** One worker per hardware thread, at least one. */
+        static unsigned int default_size();
+        /** Whether the calling thread is a worker of any thread_pool. */
+        static bool on_worker_thread();
+
+    private:
+        void worker_loop();
+        bool idle() const;
+        void rethrow_failure();
+
+        std::vector<std::thread> workers;
+        std::deque<std::function<void()>> queue;
+        size_t max_queued;
+        size_t running = 0;
+        size_t completed = 0;
+        bool stopping = false;
+        std::exception_ptr failure;
+
+        mutable std::mutex mutex;
+        // Signalled when a task is queued or the pool is stopping.
+        std::condition_variable task_available;
+        // Signalled when a task is taken from the queue or finishes.
+        std::condition_variable task_done;
+};
+
+/**
+ * The pool shared by the code that spreads its work over threads, so they don't each start
+ * a thread per processor.  It is made on first use with the number of threads of the
+ * WORKER_THREADS option, 0 there means one per logical processor besides the calling
+ * thread.  nullptr if that comes to no threads at all.
+ */
+thread_pool *shared_thread_pool();
+
+/** Number of threads @ref parallel_for spreads its work over, the calling one included. */
+unsigned int num_parallel_threads();
+
+/**
+ * Calls @p fn for every index in [0, @p count), spread over the calling thread and the
+ * shared pool, and returns once all calls are done.  The calling thread takes indices
+ * as well, so it is safe to call from a task of the shared pool.
+ * The first exception thrown by @p fn is rethrown after the others have finished.
+ */
+void parallel_for( size_t count, const std::function<void( size_t )> &fn );
+
+#endif // CATA_SRC_THREAD_POOL_H
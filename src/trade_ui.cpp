@@ -4,6 +4,7 @@
 #include <cmath>
 #include <cstdlib>
 #include <memory>
+#include <tuple>
 
 #include "character.h"
 #include "clzones.h"
@@ -12,6 +13,7 @@
 #include "game_constants.h"
 #include "inventory_ui.h"
 #include "item.h"
+#include "item_category.h"
 #include "npc.h"
 #include "npctrade.h"
 #include "npctrade_utils.h"
@@ -45,7 +47,7 @@ trade_preset::trade_preset( Character const &you, Character const &trader )
     save_state = &inventory_ui_default_state;
     append_cell(
     [&]( item_location const & loc ) {
-        return format_money( npc_trading::trading_price( _trader, _u, { loc, 1 } ) );
+        return format_money( price( { loc, 1 } ) );
     },
     _( "Unit price" ) );
 }
@@ -57,9 +59,42 @@ bool trade_preset::is_shown( item_location const &loc ) const
            ( !_u.is_wielding( *loc ) || !loc->has_flag( json_flag_NO_UNWIELD ) );
 }
 
+int trade_preset::price( trade_selector::entry_t const &it ) const
+{
+    return _prices.trading_price( _trader, _u, it );
+}
+
+int trade_price_cache::trading_price( Character const &buyer, Character const &seller,
+                                      trade_selector::entry_t const &it )
+{
+    const auto key = std::make_tuple( &buyer, it.first.get_item(), it.second );
+    auto iter = prices.find( key );
+    if( iter == prices.end() ) {
+        iter = prices.emplace( key, npc_trading::trading_price( buyer, seller, it, this ) ).first;
+    }
+    return iter->second;
+}
+
+faction_price_rule const *trade_price_cache::price_rules( npc const &np, item const &it )
+{
+    // The rules only look at the type and category of the item
+    const auto key = std::make_tuple( &np, it.typeId(), it.get_category_shallow().get_id() );
+    auto iter = rules.find( key );
+    if( iter == rules.end() ) {
+        iter = rules.emplace( key, np.get_price_rules( it ) ).first;
+    }
+    return iter->second;
+}
+
+void trade_price_cache::clear()
+{
+    prices.clear();
+    rules.clear();
+}
+
 std::string trade_preset::get_denial( const item_location &loc ) const
 {
-    int const price = npc_trading::trading_price( _trader, _u, { loc, 1 } );
+    int const price = this->price( { loc, 1 } );
 
     if( _u.is_npc() ) {
         npc const &np = *_u.as_npc();
@@ -193,10 +228,9 @@ void trade_ui::recalc_values_cpane()
 {
     _trade_values[_cpane] = 0;
 
+    trade_preset const &preset = _cpane == _you ? _upreset : _tpreset;
     for( entry_t const &it : _panes[_cpane]->to_trade() ) {
-        // FIXME: cache trading_price
-        _trade_values[_cpane] +=
-            npc_trading::trading_price( *_parties[-_cpane + 1], *_parties[_cpane], it );
+        _trade_values[_cpane] += preset.price( it );
     }
     if( !_parties[_trader]->as_npc()->will_exchange_items_freely() ) {
         _balance = _cost + _trade_values[_you] - _trade_values[_trader] + _delta_bank;
@@ -210,8 +244,8 @@ void trade_ui::autobalance()
     if( ( sign < 0 && _balance < 0 ) || ( sign > 0 && _balance > 0 ) ) {
         inventory_entry &entry = _panes[_cpane]->get_active_column().get_highlighted();
         size_t const avail = entry.get_available_count() - entry.chosen_count;
-        double const price = npc_trading::trading_price( *_parties[-_cpane + 1], *_parties[_cpane],
-                             entry_t{ entry.any_item(), 1 } ) * sign;
+        trade_preset const &preset = _cpane == _you ? _upreset : _tpreset;
+        double const price = preset.price( entry_t{ entry.any_item(), 1 } ) * sign;
         double const num = _balance / price;
         double const extra = sign < 0 ? std::ceil( num ) : std::floor( num );
         _panes[_cpane]->toggle_entry( entry, entry.chosen_count +
@@ -4,9 +4,11 @@
 
 #include <array>
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <queue>
 #include <string>
+#include <tuple>
 #include <utility>
 #include <vector>
 
@@ -16,10 +18,12 @@
 #include "inventory_ui.h"
 #include "item_location.h"
 #include "translations.h"
+#include "type_id.h"
 #include "ui_manager.h"
 
 class npc;
 class trade_ui;
+struct faction_price_rule;
 struct point;
 
 class trade_selector : public inventory_drop_selector
@@ -51,6 +55,25 @@ class trade_selector : public inventory_drop_selector
         input_context _ctxt_trade;
 };
 
+/**
+ * Prices of the items on offer while the trade window is open, so that each is worked out
+ * once, and the faction price rule for each kind of item, so that the rules are checked
+ * once per kind. Nothing changes hands until the trade is done; @ref clear() if it does.
+ */
+class trade_price_cache
+{
+    public:
+        int trading_price( Character const &buyer, Character const &seller,
+                           trade_selector::entry_t const &it );
+        faction_price_rule const *price_rules( npc const &np, item const &it );
+        void clear();
+
+    private:
+        std::map<std::tuple<Character const *, item const *, int>, int> prices;
+        std::map<std::tuple<npc const *, itype_id, item_category_id>, faction_price_rule const *>
+        rules;
+};
+
 class trade_preset : public inventory_selector_preset
 {
     public:
@@ -60,8 +83,12 @@ class trade_preset : public inventory_selector_preset
         std::string get_denial( const item_location &loc ) const override;
         bool cat_sort_compare( const inventory_entry &lhs, const inventory_entry &rhs ) const override;
 
+        /** What the trader pays for these items of ours. */
+        int price( trade_selector::entry_t const &it ) const;
+
     private:
         Character const &_u, &_trader;
+        mutable trade_price_cache _prices;
 };
 
 class trade_ui
@@ -300,30 +300,43 @@ std::string translation::translated( const int num ) const
     // in the places where they are changed, cache is explicitly invalidated
     // Note2: if `raw_pl` is defined, `num` becomes part of the "cache key"
     // otherwise `num` is ignored (for both translation and cache)
-    if( cached_language_version != detail::get_current_language_version() ||
-        ( raw_pl && cached_num != num ) || !cached_translation ) {
-        cached_language_version = detail::get_current_language_version();
+    const int language_version = detail::get_current_language_version();
+    const bool same_language = cached_language_version == language_version && cached_translation;
+    if( !same_language || ( raw_pl && cached_num != num ) ) {
+        cached_language_version = language_version;
         cached_num = num;
 
-        if( !ctxt ) {
-            if( !raw_pl ) {
-                cached_translation = cata::make_value<std::string>( detail::_translate_internal( raw ) );
-            } else {
-                cached_translation = cata::make_value<std::string>(
-                                         n_gettext( raw.c_str(), raw_pl->c_str(), num ) );
-            }
+        if( raw_pl ) {
+            cached_translation = cata::make_value<std::string>( plural_form( num, same_language ) );
+        } else if( !ctxt ) {
+            cached_translation = cata::make_value<std::string>( detail::_translate_internal( raw ) );
         } else {
-            if( !raw_pl ) {
-                cached_translation = cata::make_value<std::string>( pgettext( ctxt->c_str(), raw.c_str() ) );
-            } else {
-                cached_translation = cata::make_value<std::string>(
-                                         npgettext( ctxt->c_str(), raw.c_str(), raw_pl->c_str(), num ) );
-            }
+            cached_translation = cata::make_value<std::string>( pgettext( ctxt->c_str(), raw.c_str() ) );
         }
     }
     return *cached_translation;
 }
 
+const char *translation::plural_form( const int num, const bool entry_known ) const
+{
+#if defined(LOCALIZE)
+    const TranslationManager &manager = TranslationManager::GetInstance();
+    if( !entry_known ) {
+        cached_entry = manager.FindEntry( ctxt ? ctxt->c_str() : nullptr, raw.c_str() );
+    }
+    if( cached_entry ) {
+        return manager.TranslateEntryPlural( *cached_entry, num );
+    }
+    return num == 1 ? raw.c_str() : raw_pl->c_str();
+#else
+    static_cast<void>( entry_known );
+    if( ctxt ) {
+        return npgettext( ctxt->c_str(), raw.c_str(), raw_pl->c_str(), num );
+    }
+    return n_gettext( raw.c_str(), raw_pl->c_str(), num );
+#endif
+}
+
 bool translation::empty() const
 {
     return raw.empty();
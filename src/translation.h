@@ -143,6 +143,9 @@ class translation
         struct no_translation_tag {};
         translation( const std::string &str, no_translation_tag );
 
+        /** The plural form of `raw` for @p num, @p entry_known if `cached_entry` is up to date. */
+        const char *plural_form( int num, bool entry_known ) const;
+
         cata::value_ptr<std::string> ctxt;
         std::string raw;
         cata::value_ptr<std::string> raw_pl;
@@ -152,6 +155,11 @@ class translation
         // `num`, which `cached_translation` corresponds to
         mutable int cached_num = 0;
         mutable cata::value_ptr<std::string> cached_translation;
+#if defined(LOCALIZE)
+        // Catalog entry of a plural translation, valid with `cached_language_version`, so
+        // a different `num` only picks another of its forms
+        mutable std::optional<TranslationManager::Entry> cached_entry;
+#endif
 };
 
 /**
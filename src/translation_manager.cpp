@@ -57,4 +57,15 @@ const char *TranslationManager::TranslatePluralWithContext( const char *context,
     return impl->TranslatePluralWithContext( context, singular, plural, n );
 }
 
+std::optional<TranslationManager::Entry> TranslationManager::FindEntry( const char *context,
+        const char *message ) const
+{
+    return impl->FindEntry( context, message );
+}
+
+const char *TranslationManager::TranslateEntryPlural( const Entry &entry, std::size_t n ) const
+{
+    return impl->TranslateEntryPlural( entry, n );
+}
+
 #endif // defined(LOCALIZE)
@@ -4,8 +4,11 @@
 
 #if defined(LOCALIZE)
 
+#include <cstddef>
 #include <memory>
+#include <optional>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "pimpl.h"
@@ -31,6 +34,16 @@ class TranslationManager
         const char *TranslateWithContext( const char *context, const char *message ) const;
         const char *TranslatePluralWithContext( const char *context, const char *singular,
                                                 const char *plural, std::size_t n ) const;
+
+        /** Document and index of a message in the loaded translation documents. */
+        using Entry = std::pair<std::size_t, std::size_t>;
+        /**
+         * Look up @p message, with @p context unless it is null, once for picking several of its
+         * plural forms with @ref TranslateEntryPlural. The entry is valid until the language
+         * changes. Returns nullopt if the message has no translation.
+         */
+        std::optional<Entry> FindEntry( const char *context, const char *message ) const;
+        const char *TranslateEntryPlural( const Entry &entry, std::size_t n ) const;
 };
 
 #endif // defined(LOCALIZE)
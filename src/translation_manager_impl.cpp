@@ -234,4 +234,19 @@ const char *TranslationManager::Impl::TranslatePluralWithContext( const char *co
     }
 }
 
+std::optional<TranslationManager::Entry> TranslationManager::Impl::FindEntry(
+    const char *context, const char *message ) const
+{
+    if( context == nullptr ) {
+        return LookupString( message );
+    }
+    return LookupString( ConstructContextualQuery( context, message ).c_str() );
+}
+
+const char *TranslationManager::Impl::TranslateEntryPlural( const TranslationManager::Entry &entry,
+        std::size_t n ) const
+{
+    return documents[entry.first].GetTranslatedStringPlural( entry.second, n );
+}
+
 #endif // defined(LOCALIZE)
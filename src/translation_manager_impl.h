@@ -38,6 +38,10 @@ class TranslationManager::Impl
         const char *TranslateWithContext( const char *context, const char *message ) const;
         const char *TranslatePluralWithContext( const char *context, const char *singular,
                                                 const char *plural, std::size_t n ) const;
+        std::optional<TranslationManager::Entry> FindEntry( const char *context,
+                const char *message ) const;
+        const char *TranslateEntryPlural( const TranslationManager::Entry &entry,
+                                          std::size_t n ) const;
 };
 
 #endif // defined(LOCALIZE)
@@ -0,0 +1,229 @@
+#include "turn_profiler.h"
+
+#include <algorithm>
+#include <ostream>
+
+#include "json.h"
+
+namespace turn_profiler
+{
+
+namespace detail
+{
+bool enabled = false;
+} // namespace detail
+
+namespace
+{
+
+// Fixed capacity buffer that overwrites its oldest entry once full.
+template<typename T>
+class ring_buffer
+{
+    public:
+        explicit ring_buffer( size_t capacity ) : capacity( capacity ) {}
+
+        void push( const T &value ) {
+            if( data.size() < capacity ) {
+                data.push_back( value );
+            } else {
+                data[next] = value;
+            }
+            next = ( next + 1 ) % capacity;
+        }
+        void clear() {
+            data.clear();
+            next = 0;
+        }
+        std::vector<T> ordered() const {
+            if( data.size() < capacity ) {
+                return data;
+            }
+            std::vector<T> result( data.begin() + next, data.end() );
+            result.insert( result.end(), data.begin(), data.begin() + next );
+            return result;
+        }
+
+    private:
+        size_t capacity;
+        size_t next = 0;
+        std::vector<T> data;
+};
+
+struct profiler_state {
+    ring_buffer<turn_record> turns{ max_turns };
+    ring_buffer<timer_event> events{ max_events };
+    clock_type::time_point epoch;
+    turn_record current;
+    bool in_turn = false;
+};
+
+profiler_state &state()
+{
+    static profiler_state s;
+    return s;
+}
+
+// Phases are instrumented in this order in do_turn, keep the names in sync with the enum.
+const std::array<const char *, num_phases> phase_names = { {
+        "turn",
+        "player_input",
+        "timed_events",
+        "hordes",
+        "update_body",
+        "autosave",
+        "weather",
+        "activity",
+        "sound_markers",
+        "scent",
+        "floor_caches",
+        "falling",
+        "vehicle_movement",
+        "fields",
+        "items",
+        "explosions",
+        "sounds",
+        "map_cache",
+        "monmove",
+        "overmap_npc_move",
+        "overmap_generation",
+        "map_generation",
+        "emissions",
+        "player_turn",
+        "redraw",
+        "body_update",
+        "sfx",
+    }
+};
+
+double to_us( std::chrono::nanoseconds ns )
+{
+    return std::chrono::duration<double, std::micro>( ns ).count();
+}
+
+} // namespace
+
+std::string phase_name( phase p )
+{
+    const size_t index = static_cast<size_t>( p );
+    return index < num_phases ? phase_names[index] : "unknown";
+}
+
+void detail::record( phase p, clock_type::time_point start, clock_type::time_point end )
+{
+    profiler_state &s = state();
+    if( !s.in_turn ) {
+        return;
+    }
+    const size_t index = static_cast<size_t>( p );
+    const std::chrono::nanoseconds duration = end - start;
+    s.current.time[index] += duration;
+    ++s.current.calls[index];
+    s.events.push( timer_event{ p, start - s.epoch, duration } );
+}
+
+void set_enabled( bool enable )
+{
+    if( enable && !detail::enabled ) {
+        reset();
+    }
+    if( !enable ) {
+        // Drop the turn in progress, its timers would be incomplete.
+        state().in_turn = false;
+    }
+    detail::enabled = enable;
+}
+
+void reset()
+{
+    profiler_state &s = state();
+    s.turns.clear();
+    s.events.clear();
+    s.epoch = clock_type::now();
+    s.in_turn = false;
+}
+
+void begin_turn( int64_t turn )
+{
+    profiler_state &s = state();
+    s.current = turn_record();
+    s.current.turn = turn;
+    s.current.start = clock_type::now() - s.epoch;
+    s.in_turn = true;
+}
+
+void end_turn()
+{
+    profiler_state &s = state();
+    if( !s.in_turn ) {
+        return;
+    }
+    s.turns.push( s.current );
+    s.in_turn = false;
+}
+
+std::vector<turn_record> recorded_turns()
+{
+    return state().turns.ordered();
+}
+
+std::vector<phase_summary> summarize( const std::vector<turn_record> &turns )
+{
+    std::vector<phase_summary> result( num_phases );
+    for( size_t i = 0; i < num_phases; ++i ) {
+        result[i].p = static_cast<phase>( i );
+    }
+    for( const turn_record &rec : turns ) {
+        for( size_t i = 0; i < num_phases; ++i ) {
+            result[i].total += rec.time[i];
+            result[i].max = std::max( result[i].max, rec.time[i] );
+            result[i].calls += rec.calls[i];
+        }
+    }
+    std::stable_sort( result.begin(), result.end(), []( const phase_summary & l,
+    const phase_summary & r ) {
+        return l.total > r.total;
+    } );
+    return result;
+}
+
+void write_csv( std::ostream &out )
+{
+    out << "turn,start_us";
+    for( size_t i = 0; i < num_phases; ++i ) {
+        out << ',' << phase_names[i] << "_us," << phase_names[i] << "_calls";
+    }
+    out << '\n';
+    for( const turn_record &rec : recorded_turns() ) {
+        out << rec.turn << ',' << to_us( rec.start );
+        for( size_t i = 0; i < num_phases; ++i ) {
+            out << ',' << to_us( rec.time[i] ) << ',' << rec.calls[i];
+        }
+        out << '\n';
+    }
+}
+
+void write_chrome_trace( std::ostream &out )
+{
+    JsonOut jsout( out );
+    jsout.start_object();
+    jsout.member( "displayTimeUnit", "ms" );
+    jsout.member( "traceEvents" );
+    jsout.start_array();
+    for( const timer_event &ev : state().events.ordered() ) {
+        jsout.start_object();
+        jsout.member( "name", phase_names[static_cast<size_t>( ev.p )] );
+        jsout.member( "cat", "do_turn" );
+        // Complete events, timestamps are in microseconds.
+        jsout.member( "ph", "X" );
+        jsout.member( "ts", to_us( ev.start ) );
+        jsout.member( "dur", to_us( ev.duration ) );
+        jsout.member( "pid", 1 );
+        jsout.member( "tid", 1 );
+        jsout.end_object();
+    }
+    jsout.end_array();
+    jsout.end_object();
+}
+
+} // namespace turn_profiler
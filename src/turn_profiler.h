@@ -0,0 +1,175 @@
+#pragma once
+#ifndef CATA_SRC_TURN_PROFILER_H
+#define CATA_SRC_TURN_PROFILER_H
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * Lightweight per-phase timing of @ref do_turn.
+ *
+ * The phases of a turn are wrapped in @ref turn_profiler::scoped_timer objects.  While the
+ * profiler is disabled (the default) a timer only tests a global flag, so the
+ * instrumentation stays compiled into release builds.  When enabled, the wall time and
+ * number of calls of each phase are accumulated per turn and kept in a ring buffer of the
+ * most recent turns, along with the individual timer events for a Chrome trace
+ * (chrome://tracing or https://ui.perfetto.dev).
+ *
+ * Everything here must be called from the main thread.
+ */
+namespace turn_profiler
+{
+
+enum class phase : int {
+    turn,
+    player_input,
+    timed_events,
+    hordes,
+    update_body,
+    autosave,
+    weather,
+    activity,
+    sound_markers,
+    scent,
+    floor_caches,
+    falling,
+    vehicle_movement,
+    fields,
+    items,
+    explosions,
+    sounds,
+    map_cache,
+    monmove,
+    overmap_npc_move,
+    overmap_generation,
+    map_generation,
+    emissions,
+    player_turn,
+    redraw,
+    body_update,
+    sfx,
+    last
+};
+
+constexpr size_t num_phases = static_cast<size_t>( phase::last );
+
+std::string phase_name( phase p );
+
+using clock_type = std::chrono::steady_clock;
+
+/** Totals of one profiled turn. */
+struct turn_record {
+    /** Value of calendar::turn when the turn started, in turns since the Cataclysm. */
+    int64_t turn = 0;
+    /** Start of the turn, relative to when profiling was enabled. */
+    std::chrono::nanoseconds start{ 0 };
+    std::array<std::chrono::nanoseconds, num_phases> time{};
+    std::array<uint32_t, num_phases> calls{};
+};
+
+/** A single completed @ref scoped_timer, for the trace output. */
+struct timer_event {
+    phase p = phase::turn;
+    std::chrono::nanoseconds start{ 0 };
+    std::chrono::nanoseconds duration{ 0 };
+};
+
+/** Number of turns kept in the ring buffer. */
+constexpr size_t max_turns = 1024;
+/** Number of timer events kept for the trace, older ones are dropped first. */
+constexpr size_t max_events = 32768;
+
+namespace detail
+{
+// Kept outside of a function so the disabled check in scoped_timer is a single load.
+extern bool enabled;
+void record( phase p, clock_type::time_point start, clock_type::time_point end );
+} // namespace detail
+
+inline bool is_enabled()
+{
+    return detail::enabled;
+}
+
+/** Enabling starts a fresh recording, disabling keeps the recorded turns for inspection. */
+void set_enabled( bool enable );
+void reset();
+
+/** Marks the start and end of a turn.  Timers outside of a turn are ignored. */
+void begin_turn( int64_t turn );
+void end_turn();
+
+/** Recorded turns, oldest first. */
+std::vector<turn_record> recorded_turns();
+
+/** Per-phase sums over all recorded turns, ordered by total time, longest first. */
+struct phase_summary {
+    phase p = phase::turn;
+    std::chrono::nanoseconds total{ 0 };
+    std::chrono::nanoseconds max{ 0 };
+    uint64_t calls = 0;
+};
+std::vector<phase_summary> summarize( const std::vector<turn_record> &turns );
+
+/** One row per recorded turn, one time (in microseconds) and call count column per phase. */
+void write_csv( std::ostream &out );
+/** Chrome trace event format, see https://docs.google.com/document/d/1CvAClvFfyA5R-PhYUmn5OOQtYMH4h6I0nSsKchNAySU */
+void write_chrome_trace( std::ostream &out );
+
+/** Times the enclosing scope as @p p, unless the profiler is disabled. */
+class scoped_timer
+{
+    public:
+        explicit scoped_timer( phase p ) : p( p ) {
+            if( detail::enabled ) {
+                active = true;
+                start = clock_type::now();
+            }
+        }
+        ~scoped_timer() {
+            if( active ) {
+                detail::record( p, start, clock_type::now() );
+            }
+        }
+        scoped_timer( const scoped_timer & ) = delete;
+        scoped_timer &operator=( const scoped_timer & ) = delete;
+
+    private:
+        phase p;
+        bool active = false;
+        clock_type::time_point start;
+};
+
+/** Brackets a whole turn, including the early returns of @ref do_turn. */
+class turn_scope
+{
+    public:
+        explicit turn_scope( int64_t turn ) {
+            if( detail::enabled ) {
+                active = true;
+                begin_turn( turn );
+                start = clock_type::now();
+            }
+        }
+        ~turn_scope() {
+            if( active ) {
+                detail::record( phase::turn, start, clock_type::now() );
+                end_turn();
+            }
+        }
+        turn_scope( const turn_scope & ) = delete;
+        turn_scope &operator=( const turn_scope & ) = delete;
+
+    private:
+        bool active = false;
+        clock_type::time_point start;
+};
+
+} // namespace turn_profiler
+
+#endif // CATA_SRC_TURN_PROFILER_H
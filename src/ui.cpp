@@ -6,7 +6,9 @@
 #include <cstdlib>
 #include <iterator>
 #include <memory>
+#include <numeric>
 #include <set>
+#include <utility>
 
 #include "avatar.h"
 #include "cached_options.h" // IWYU pragma: keep
@@ -569,27 +571,46 @@ input_context uilist::create_filter_input_context() const
  * repopulate filtered entries list (fentries) and set fselected accordingly
  */
 void uilist::filterlist()
+{
+    filter_entries( false );
+}
+
+void uilist::filter_entries( const bool narrow )
 {
     // TODO: && is_all_lc( filter )
+    std::vector<int> candidates;
+    if( narrow ) {
+        candidates = std::move( fentries );
+    } else {
+        candidates.resize( entries.size() );
+        std::iota( candidates.begin(), candidates.end(), 0 );
+    }
+    const bool nocase_filter = filtering && filtering_nocase && !filter.empty();
+    const lcmatcher matches( nocase_filter ? filter : std::string() );
+    if( nocase_filter ) {
+        filter_keys.resize( entries.size() );
+    }
     fentries.clear();
     fselected = -1;
     int f = 0;
-    for( size_t i = 0; i < entries.size(); i++ ) {
+    for( const int i : candidates ) {
         bool visible = true;
         if( !categories.empty() && !category_filter( entries[i], categories[current_category].first ) ) {
             continue;
         }
-        if( filtering && !filter.empty() ) {
-            if( filtering_nocase ) {
-                // case-insensitive match
-                visible = lcmatch( entries[i].txt, filter );
-            } else {
-                // case-sensitive match
-                visible = entries[i].txt.find( filter ) != std::string::npos;
+        if( nocase_filter ) {
+            // case-insensitive match, against the text converted once while typing the filter
+            std::pair<std::string, lcmatch_subject> &key = filter_keys[i];
+            if( key.first != entries[i].txt ) {
+                key = { entries[i].txt, lcmatch_subject( entries[i].txt ) };
             }
+            visible = matches( key.second );
+        } else if( filtering && !filter.empty() ) {
+            // case-sensitive match
+            visible = entries[i].txt.find( filter ) != std::string::npos;
         }
         if( visible ) {
-            fentries.push_back( static_cast<int>( i ) );
+            fentries.push_back( i );
             if( hilight_disabled || entries[i].enabled ) {
                 if( static_cast<int>( i ) == selected || ( static_cast<int>( i ) > selected && fselected == -1 ) ) {
                     // Either this is selected, or we are past the previously selected entry,
@@ -630,12 +651,14 @@ void uilist::inputfilter()
     bool loop = true;
     do {
         ui_manager::redraw();
+        const std::string previous_filter = filter;
         filter = filter_popup->query_string( false );
         recalc_start = false;
         if( !filter_popup->confirmed() ) {
             const std::string action = ctxt.input_to_action( ctxt.get_raw_input() );
             if( filter_popup->handled() ) {
-                filterlist();
+                // Typing on only narrows down the entries that matched so far.
+                filter_entries( string_starts_with( filter, previous_filter ) );
                 recalc_start = true;
             } else if( scrollby( scroll_amount_from_action( action ) ) ) {
                 recalc_start = true;
@@ -41,6 +41,7 @@ const int UILIST_TIMEOUT = -1028;
 const int UILIST_ADDITIONAL = -1029;
 const int MENU_AUTOASSIGN = -1;
 
+class lcmatch_subject;
 class string_input_popup;
 class uilist_impl;
 
@@ -404,6 +405,9 @@ class uilist // NOLINT(cata-xy)
         // This function assumes it's being called from `query` and should
         // not be made public.
         void inputfilter();
+        // filterlist(), with @p narrow only the entries shown so far are checked again.
+        // That's only valid if the filter was extended and the entries are unchanged.
+        void filter_entries( bool narrow );
 
     public:
         // Parameters
@@ -474,6 +478,8 @@ class uilist // NOLINT(cata-xy)
 
         std::unique_ptr<string_input_popup> filter_popup;
         std::string filter;
+        // Entry texts converted for case insensitive filtering, each with the text it was made from
+        std::vector<std::pair<std::string, lcmatch_subject>> filter_keys;
 
         int max_entry_len = 0;
         int max_column_len = 0;
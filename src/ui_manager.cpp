@@ -1,5 +1,7 @@
 #include "ui_manager.h"
 
+#include <algorithm>
+#include <chrono>
 #include <functional>
 #include <iterator>
 #include <optional>
@@ -25,6 +27,9 @@ static bool imgui_frame_started = false;
 static bool redraw_in_progress = false;
 static bool showing_debug_message = false;
 static bool restart_redrawing = false;
+// Frame pacing of `request_redraw`.
+static bool redraw_pending = false;
+static std::chrono::steady_clock::time_point last_frame_time;
 #if defined( TILES )
 static std::optional<SDL_Rect> prev_clip_rect;
 #endif
@@ -353,6 +358,29 @@ void ui_adaptor::redraw()
     redraw_invalidated();
 }
 
+bool ui_adaptor::request_redraw()
+{
+    if( test_mode || ui_stack.empty() ) {
+        return false;
+    }
+    ui_stack.back().get().invalidated = true;
+    const std::chrono::steady_clock::duration frame_interval =
+        std::chrono::microseconds( 1000000 / std::max( ui_redraw_fps, 1 ) );
+    if( std::chrono::steady_clock::now() - last_frame_time < frame_interval ) {
+        redraw_pending = true;
+        return false;
+    }
+    redraw_invalidated();
+    return true;
+}
+
+void ui_adaptor::flush_redraw()
+{
+    if( redraw_pending ) {
+        redraw_invalidated();
+    }
+}
+
 void ui_adaptor::redraw_invalidated( )
 {
     if( test_mode || ui_stack.empty() ) {
@@ -470,6 +498,8 @@ void ui_adaptor::redraw_invalidated( )
 
     imclient->end_frame();
     imgui_frame_started = false;
+    redraw_pending = false;
+    last_frame_time = std::chrono::steady_clock::now();
 
     // if any ImGui window needed to calculate the size of its contents,
     //  it needs an extra frame to draw. We do that here.
@@ -516,6 +546,16 @@ void redraw()
     ui_adaptor::redraw();
 }
 
+bool request_redraw()
+{
+    return ui_adaptor::request_redraw();
+}
+
+void flush_redraw()
+{
+    ui_adaptor::flush_redraw();
+}
+
 void redraw_invalidated()
 {
     ui_adaptor::redraw_invalidated();
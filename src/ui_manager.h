@@ -228,6 +228,8 @@ class ui_adaptor
         static void invalidate( const rectangle<point> &rect, bool reenable_uis_below );
         static bool has_imgui();
         static void redraw();
+        static bool request_redraw();
+        static void flush_redraw();
         static void redraw_invalidated();
         static void screen_resized();
     private:
@@ -285,6 +287,23 @@ void invalidate( const rectangle<point> &rect, bool reenable_uis_below );
  * calculated within the respective callbacks.
  **/
 void redraw();
+/**
+ * Invalidate the top window like `redraw`, but only redraw if the last frame
+ * was drawn at least 1 / UI_REDRAW_FPS seconds ago. Otherwise the invalidated
+ * windows are kept for the next frame, so any number of calls in between are
+ * coalesced into one redraw. Returns whether a frame was drawn, so the caller
+ * can skip `refresh_display` otherwise.
+ *
+ * Meant for progress popups and activity loops that aren't waiting for input.
+ * Anything that echoes input or is about to read input should call `redraw`,
+ * which always draws right away.
+ **/
+bool request_redraw();
+/**
+ * Draw the frame held back by `request_redraw`, if any. Called before
+ * reading input so the screen is never stale while waiting for the player.
+ **/
+void flush_redraw();
 /**
  * Redraw all invalidated windows without invalidating the top window.
  **/
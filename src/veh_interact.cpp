@@ -3342,7 +3342,7 @@ void veh_interact::complete_vehicle( Character &you )
                 // Ensure the position, pivot, and precalc points are up-to-date
                 veh.pos -= veh.pivot_anchor[0];
                 veh.precalc_mounts( 0, veh.turn_dir, point_rel_ms_zero );
-                here.rebuild_vehicle_level_caches();
+                here.add_vehicle_to_cache( &veh );
 
                 if( auto newpart = here.veh_at( act_pos ).part_with_feature( VPFLAG_APPLIANCE, false ) ) {
                     vp = &newpart->part();
@@ -233,7 +233,10 @@ vehicle::vehicle( const vproto_id &proto_id )
     }
 }
 
-vehicle::~vehicle() = default;
+vehicle::~vehicle()
+{
+    invalidate_power_grids();
+}
 
 turret_cpu::~turret_cpu() = default;
 
@@ -1916,7 +1919,7 @@ bool vehicle::merge_rackable_vehicle( vehicle *carry_veh, const std::vector<int>
         here.set_transparency_cache_dirty( sm_pos.z );
         here.set_seen_cache_dirty( tripoint_bub_ms_zero );
         here.invalidate_map_cache( here.get_abs_sub().z() );
-        here.rebuild_vehicle_level_caches();
+        here.add_vehicle_to_cache( this );
     } else {
         //~ %1$s is the vehicle being loaded onto the bicycle rack
         add_msg( m_bad, _( "You can't get the %1$s on the rack." ), carry_veh->name );
@@ -2063,8 +2066,8 @@ void vehicle::separate_from_grid( const point_rel_ms mount )
 
     add_msg( _( "You separate the %s from the power grid" ), part_name );
 
+    // Caches what is left of this grid, the split off parts were cached with their new vehicles.
     part_removal_cleanup();
-    here.rebuild_vehicle_level_caches();
 }
 
 bool vehicle::is_powergrid() const
@@ -2377,7 +2380,7 @@ bool vehicle::remove_carried_vehicle( const std::vector<int> &carried_parts,
             vp.enabled = !vp.is_broken();
         }
         here.invalidate_map_cache( here.get_abs_sub().z() );
-        here.rebuild_vehicle_level_caches();
+        here.add_vehicle_to_cache( new_vehicle );
         return true;
     } else {
         for( const int &rack_part : racks ) {
@@ -2662,6 +2665,7 @@ bool vehicle::split_vehicles( map &here,
         new_vehicle->precalc_mounts( 1, new_vehicle->skidding ?
                                      new_vehicle->turn_dir : new_vehicle->face.dir(),
                                      new_vehicle->pivot_point() );
+        here.add_vehicle_to_cache( new_vehicle );
         if( !passengers.empty() ) {
             new_vehicle->relocate_passengers( passengers );
         }
@@ -2704,18 +2708,7 @@ std::vector<int> vehicle::parts_at_relative( const point &dp, const bool use_cac
             }
         }
     } else {
-        const auto &iter = relative_parts.find( dp );
-        if( iter != relative_parts.end() ) {
-            if( include_fake ) {
-                return iter->second;
-            } else {
-                for( const int vp : iter->second ) {
-                    if( !parts.at( vp ).is_fake ) {
-                        res.push_back( vp );
-                    }
-                }
-            }
-        }
+        return cached_parts_at_relative( point_rel_ms( dp ), include_fake );
     }
     return res;
 }
@@ -2739,22 +2732,21 @@ std::vector<int> vehicle::parts_at_relative( const point_rel_ms &dp, const bool
             }
         }
     } else {
-        const auto &iter = relative_parts.find( dp.raw() );
-        if( iter != relative_parts.end() ) {
-            if( include_fake ) {
-                return iter->second;
-            } else {
-                for( const int vp : iter->second ) {
-                    if( !parts.at( vp ).is_fake ) {
-                        res.push_back( vp );
-                    }
-                }
-            }
-        }
+        return cached_parts_at_relative( dp, include_fake );
     }
     return res;
 }
 
+const std::vector<int> &vehicle::cached_parts_at_relative( const point_rel_ms &dp,
+        bool include_fake ) const
+{
+    static const std::vector<int> no_parts;
+    const std::map<point, std::vector<int>> &cache = include_fake ? relative_parts :
+                                          relative_real_parts;
+    const auto iter = cache.find( dp.raw() );
+    return iter != cache.end() ? iter->second : no_parts;
+}
+
 std::optional<vpart_reference> vpart_position::obstacle_at_part() const
 {
     std::optional<vpart_reference> part = part_with_feature( VPFLAG_OBSTACLE, true, true );
@@ -2926,7 +2918,7 @@ int vehicle::part_with_feature( int part, vpart_bitflags flag, bool unbroken,
     if( vp.info().has_flag( flag ) && !( unbroken && vp.is_broken() ) ) {
         return part;
     }
-    for( const int p : parts_at_relative( vp.mount, /* use_cache = */ true, include_fake ) ) {
+    for( const int p : cached_parts_at_relative( vp.mount, include_fake ) ) {
         const vehicle_part &vp_here = this->part( p );
         if( vp_here.info().has_flag( flag ) && !( unbroken && vp_here.is_broken() ) ) {
             return p;
@@ -2938,7 +2930,7 @@ int vehicle::part_with_feature( int part, vpart_bitflags flag, bool unbroken,
 int vehicle::part_with_feature( const point_rel_ms &pt, vpart_bitflags f, bool unbroken,
                                 bool include_fake ) const
 {
-    for( const int p : parts_at_relative( pt, /* use_cache = */ true, include_fake ) ) {
+    for( const int p : cached_parts_at_relative( pt, include_fake ) ) {
         const vehicle_part &vp_here = this->part( p );
         if( vp_here.info().has_flag( f ) && !( unbroken && vp_here.is_broken() ) ) {
             return p;
@@ -3115,10 +3107,10 @@ void vpart_position::set_label( const std::string &text ) const
 
 int vehicle::next_part_to_close( int p, bool outside ) const
 {
-    std::vector<int> parts_here = parts_at_relative( parts[p].mount, true, true );
+    const std::vector<int> &parts_here = cached_parts_at_relative( parts[p].mount, true );
 
     // We want reverse, since we close the innermost thing first (door), and then the outermost thing (curtains)
-    for( std::vector<int>::reverse_iterator part_it = parts_here.rbegin();
+    for( std::vector<int>::const_reverse_iterator part_it = parts_here.rbegin();
          part_it != parts_here.rend();
          ++part_it ) {
         const vehicle_part &vp = part( *part_it );
@@ -3136,7 +3128,7 @@ int vehicle::next_part_to_open( int p, bool outside ) const
     const bool has_lock = part_has_lock( p );
     // We want forwards, since we open the outermost thing first (curtains), and then the innermost thing (door)
 
-    for( const int elem : parts_at_relative( parts[p].mount, true, true ) ) {
+    for( const int elem : cached_parts_at_relative( parts[p].mount, true ) ) {
         const vehicle_part &vp = part( elem );
         const vpart_info &vpi = vp.info();
         if( vpi.has_flag( VPFLAG_OPENABLE ) && vp.is_available() && vp.open == 0 &&
@@ -3150,7 +3142,7 @@ int vehicle::next_part_to_open( int p, bool outside ) const
 
 bool vehicle::part_has_lock( int p ) const
 {
-    for( const int elem : parts_at_relative( parts[p].mount, true, true ) ) {
+    for( const int elem : cached_parts_at_relative( parts[p].mount, true ) ) {
         const vehicle_part &vp = parts[elem];
         if( vp.info().has_flag( "DOOR_LOCKING" ) && vp.is_available() ) {
             return true;
@@ -3164,9 +3156,9 @@ int vehicle::next_part_to_lock( int p, bool outside ) const
     if( !part_has_lock( p ) ) {
         return -1;
     }
-    std::vector<int> parts_here = parts_at_relative( parts[p].mount, true, true );
+    const std::vector<int> &parts_here = cached_parts_at_relative( parts[p].mount, true );
     // We want reverse, since we lock the innermost thing first (door), and then the outermost thing
-    for( std::vector<int>::reverse_iterator part_it = parts_here.rbegin();
+    for( std::vector<int>::const_reverse_iterator part_it = parts_here.rbegin();
          part_it != parts_here.rend();
          ++part_it ) {
         const vehicle_part &vp = part( *part_it );
@@ -3185,7 +3177,7 @@ int vehicle::next_part_to_unlock( int p, bool outside ) const
     if( !part_has_lock( p ) ) {
         return -1;
     }
-    for( const int elem : parts_at_relative( parts[p].mount, true, true ) ) {
+    for( const int elem : cached_parts_at_relative( parts[p].mount, true ) ) {
         const vehicle_part &vp = part( elem );
         if( vp.info().has_flag( "LOCKABLE_DOOR" ) && vp.is_available() && vp.locked && !outside ) {
             return elem;
@@ -3453,7 +3445,7 @@ int vehicle::part_displayed_at( const point_rel_ms &dp, bool include_fake, bool
     // it's clear where the magic number comes from.
     const int ON_ROOF_Z = 9;
 
-    std::vector<int> parts_in_square = parts_at_relative( dp, true, include_fake );
+    const std::vector<int> &parts_in_square = cached_parts_at_relative( dp, include_fake );
 
     if( parts_in_square.empty() ) {
         return -1;
@@ -4548,18 +4540,10 @@ double vehicle::coeff_air_drag() const
     return coefficient_air_resistance;
 }
 
-double vehicle::coeff_rolling_drag() const
+void vehicle::calc_drag_layout() const
 {
-    if( !coeff_rolling_dirty ) {
-        return coefficient_rolling_resistance;
-    }
     constexpr double wheel_ratio = 1.25;
     constexpr double base_wheels = 4.0;
-    // SAE J2452 measurements are in F_rr = N * C_rr * 0.000225 * ( v + 33.33 )
-    // Don't ask me why, but it's the numbers we have. We want N * C_rr * 0.000225 here,
-    // and N is mass * accel from gravity (aka weight)
-    constexpr double sae_ratio = 0.000225;
-    constexpr double newton_ratio = accel_g * sae_ratio;
     double wheel_factor = 0;
     if( wheelcache.empty() ) {
         wheel_factor = 50;
@@ -4573,7 +4557,35 @@ double vehicle::coeff_rolling_drag() const
         wheel_factor *= wheel_ratio /
                         ( base_wheels * wheel_ratio - base_wheels + wheelcache.size() );
     }
-    coefficient_rolling_resistance = newton_ratio * wheel_factor * to_kilogram( total_mass() );
+    rolling_wheel_factor = wheel_factor;
+
+    int structural_part_count = 0;
+    for( int structural_part_idx : all_parts_at_location( part_location_structure ) ) {
+        const vehicle_part &vp = part( structural_part_idx );
+        const vpart_info &vpi = vp.info();
+        if( !vp.has_flag( vp_flag::carried_flag ) &&
+            !vpi.has_flag( "PROTRUSION" ) ) {
+            ++structural_part_count;
+        }
+    }
+    hull_structure_count = structural_part_count;
+    drag_layout_dirty = false;
+}
+
+double vehicle::coeff_rolling_drag() const
+{
+    if( !coeff_rolling_dirty ) {
+        return coefficient_rolling_resistance;
+    }
+    if( drag_layout_dirty ) {
+        calc_drag_layout();
+    }
+    // SAE J2452 measurements are in F_rr = N * C_rr * 0.000225 * ( v + 33.33 )
+    // Don't ask me why, but it's the numbers we have. We want N * C_rr * 0.000225 here,
+    // and N is mass * accel from gravity (aka weight)
+    constexpr double sae_ratio = 0.000225;
+    constexpr double newton_ratio = accel_g * sae_ratio;
+    coefficient_rolling_resistance = newton_ratio * rolling_wheel_factor * to_kilogram( total_mass() );
     coeff_rolling_dirty = false;
     return coefficient_rolling_resistance;
 }
@@ -4751,15 +4763,10 @@ double vehicle::coeff_water_drag() const
     if( !coeff_water_dirty ) {
         return coefficient_water_resistance;
     }
-    int structural_part_count = 0;
-    for( int structural_part_idx : all_parts_at_location( part_location_structure ) ) {
-        const vehicle_part &vp = part( structural_part_idx );
-        const vpart_info &vpi = vp.info();
-        if( !vp.has_flag( vp_flag::carried_flag ) &&
-            !vpi.has_flag( "PROTRUSION" ) ) {
-            ++structural_part_count;
-        }
+    if( drag_layout_dirty ) {
+        calc_drag_layout();
     }
+    const int structural_part_count = hull_structure_count;
     if( structural_part_count == 0 ) {
         // Invalid vehicle.  Return some default values.  Sinks.
         coeff_water_dirty = false;
@@ -5699,14 +5706,31 @@ std::map<Vehicle *, float> vehicle::search_connected_vehicles( Vehicle *start )
     return distances;
 }
 
+// Bumped whenever a cached power grid could have changed shape
+static int power_grid_generation = 0;
+
+void vehicle::invalidate_power_grids()
+{
+    power_grid_generation++;
+}
+
 std::map<vehicle *, float> vehicle::search_connected_vehicles()
 {
-    return search_connected_vehicles( this );
+    if( grid_cache.owner != this || grid_cache.generation != power_grid_generation ||
+        grid_cache.turn != calendar::turn ) {
+        grid_cache.distances = search_connected_vehicles( this );
+        grid_cache.owner = this;
+        grid_cache.generation = power_grid_generation;
+        grid_cache.turn = calendar::turn;
+    }
+    return grid_cache.distances;
 }
 
 std::map<const vehicle *, float> vehicle::search_connected_vehicles() const
 {
-    return search_connected_vehicles( this );
+    const std::map<vehicle *, float> distances =
+        const_cast<vehicle *>( this )->search_connected_vehicles();
+    return std::map<const vehicle *, float>( distances.begin(), distances.end() );
 }
 
 void vehicle::get_connected_vehicles( std::unordered_set<vehicle *> &dest )
@@ -6469,6 +6493,7 @@ void vehicle::refresh_active_item_cache()
  */
 void vehicle::refresh( const bool remove_fakes )
 {
+    invalidate_power_grids();
     if( no_refresh ) {
         return;
     }
@@ -6483,6 +6508,7 @@ void vehicle::refresh( const bool remove_fakes )
     funnels.clear();
     emitters.clear();
     relative_parts.clear();
+    relative_real_parts.clear();
     loose_parts.clear();
     wheelcache.clear();
     rail_wheelcache.clear();
@@ -6548,6 +6574,10 @@ void vehicle::refresh( const bool remove_fakes )
                                          relative_parts[pt].end(),
                                          static_cast<int>( p ), svpv );
         relative_parts[pt].insert( vii, p );
+        // Fake parts are only ever added to relative_parts, so this one stays sorted alike
+        std::vector<int> &real_here = relative_real_parts[pt];
+        real_here.insert( std::lower_bound( real_here.begin(), real_here.end(), static_cast<int>( p ),
+                                            svpv ), p );
 
         //If it doesn't leak or it's health is less than 50% then The hull has been breached and the air is leaking out
         if( vpi.has_flag( VPFLAG_FLOATS ) && ( vpi.has_flag( VPFLAG_NO_LEAK ) ||
@@ -6762,11 +6792,60 @@ void vehicle::refresh( const bool remove_fakes )
     insides_dirty = true;
     zones_dirty = true;
     coeff_air_dirty = true;
+    drag_layout_dirty = true;
     invalidate_mass();
     occupied_cache_pos = { -1, -1, -1 };
     refresh_active_item_cache();
 }
 
+void vehicle::refresh_unavailable_part( const int p )
+{
+    invalidate_power_grids();
+    if( no_refresh ) {
+        return;
+    }
+    const vehicle_part &vp = parts[p];
+    const vpart_info &vpi = vp.info();
+    // Steering looks at the other parts on the same mount and the rail wheel bounds look at
+    // every rail wheel, so those are only handled by a full refresh.
+    if( vp.is_available() || vpi.has_flag( "STEERABLE" ) || vpi.has_flag( "TRACKED" ) ||
+        ( vpi.has_flag( VPFLAG_WHEEL ) && vpi.has_flag( VPFLAG_RAIL ) ) ||
+        vpi.has_flag( "SMART_ENGINE_CONTROLLER" ) ) {
+        refresh( false );
+        return;
+    }
+
+    const auto drop = [p]( std::vector<int> &list ) {
+        list.erase( std::remove( list.begin(), list.end(), p ), list.end() );
+    };
+    for( std::vector<int> *list : {
+             &alternators, &engines, &reactors, &solar_panels, &rotors, &batteries, &fuel_containers,
+             &turret_locations, &wind_turbines, &sails, &water_wheels, &funnels, &loose_parts,
+             &emitters, &wheelcache, &speciality, &mufflers, &planters, &accessories, &cable_ports,
+             &control_req_parts
+         } ) {
+        drop( *list );
+    }
+    if( vpi.has_flag( VPFLAG_FLOATS ) && !vpi.has_flag( VPFLAG_NO_LEAK ) &&
+        vp.health_percent() < vp.floating_leak_threshold() ) {
+        drop( floating );
+    }
+    if( vpi.has_flag( "EXTRA_DRAG" ) ) {
+        if( vp.enabled ) {
+            extra_drag -= vpi.power;
+        }
+        if( vpi.has_flag( "WIND_TURBINE" ) || vpi.has_flag( "WATER_WHEEL" ) ) {
+            extra_drag -= vpi.power;
+        }
+    }
+
+    check_environmental_effects = true;
+    insides_dirty = true;
+    coeff_air_dirty = true;
+    drag_layout_dirty = true;
+    invalidate_mass();
+}
+
 vpart_edge_info vehicle::get_edge_info( const point_rel_ms &mount ) const
 {
     point_rel_ms forward = mount + point_east;
@@ -7262,8 +7341,8 @@ void vehicle::remove_remote_part( const vehicle_part &vp_local ) const
     const auto part = get_remote_part( vp_local );
     if( part ) {
         part->vehicle().remove_part( part->part() );
-        // Rebuild vehicle cache to avoid creating an illusion of the remote car.
-        get_map().rebuild_vehicle_level_caches();
+        // Recache the remote vehicle to avoid creating an illusion of the remote car.
+        get_map().add_vehicle_to_cache( &part->vehicle() );
     }
 }
 
@@ -7580,7 +7659,7 @@ void vehicle::shift_parts( map &here, const point_rel_ms &delta )
     pivot_anchor[0] -= delta.raw();
     refresh();
     //Need to also update the map after this
-    here.rebuild_vehicle_level_caches();
+    here.add_vehicle_to_cache( this );
 }
 
 /**
@@ -7821,9 +7900,8 @@ int vehicle::damage_direct( map &here, vehicle_part &vp, int dmg, const damage_t
         if( vp.has_fake ) {
             parts[vp.fake_part_at].base = vp.base;
         }
-        // refresh cache in case the broken part has changed the status
-        // do not remove fakes parts in case external vehicle part references get invalidated
-        refresh( false );
+        // the part is still mounted, so only drop it from the caches it was counted in
+        refresh_unavailable_part( index_of_part( &vp, /* include_removed = */ true ) );
     }
 
     if( vp.is_fuel_store() ) {
@@ -301,7 +301,8 @@ struct vehicle_part {
         };
 
         // each time this vehicle part is racked this will push the data required to unrack to stack
-        std::stack<carried_part_data> carried_stack;
+        // backed by a vector so the (usually empty) stack costs no allocation per part
+        std::stack<carried_part_data, std::vector<carried_part_data>> carried_stack;
 
         /** Specific type of fuel, charges or ammunition currently contained by a part */
         itype_id ammo_current() const;
@@ -858,6 +859,8 @@ class vehicle
         void refresh_pivot() const;
 
         void calc_mass_center( bool precalc ) const;
+        // refresh the wheel and hull terms of the drag coefficients, clear drag_layout_dirty
+        void calc_drag_layout() const;
 
         /** empty the contents of a tank, battery or turret spilling liquids randomly on the ground */
         void leak_fuel( vehicle_part &pt ) const;
@@ -881,6 +884,7 @@ class vehicle
         // every vehicle part instead of just the vehicle's position
         static vehicle *find_vehicle_using_parts( const tripoint_abs_ms &where );
         //! @copydoc vehicle::search_connected_vehicles( Vehicle *start )
+        /// The result is cached until the end of the turn or invalidate_power_grids().
         std::map<vehicle *, float> search_connected_vehicles();
         //! @copydoc vehicle::search_connected_vehicles( Vehicle *start )
         std::map<const vehicle *, float> search_connected_vehicles() const;
@@ -892,6 +896,9 @@ class vehicle
         /// Values are line loss, 0.01 corresponds to 1% charge loss to wire resistance
         /// May load the connected vehicles' submaps
         std::map<vpart_reference, float> search_connected_batteries();
+        /// Forgets every cached search_connected_vehicles() result. Called whenever vehicles
+        /// are created, destroyed, moved or have their parts changed.
+        static void invalidate_power_grids();
 
         // constructs a vehicle, if the given \p proto_id is an empty string the vehicle is
         // constructed empty, invalid proto_id will construct empty and raise a debugmsg,
@@ -911,6 +918,13 @@ class vehicle
         void enable_refresh();
         //Refresh all caches and re-locate all parts
         void refresh( bool remove_fakes = true );
+        /**
+         * Update the caches after part \p p stopped being available (e.g. it broke) without
+         * being removed. The layout of the vehicle is unchanged, so only the part lists and
+         * aggregates the part contributed to are adjusted. Falls back to refresh( false ) when
+         * the part affects caches that depend on its neighbors.
+         */
+        void refresh_unavailable_part( int p );
 
         // Refresh active_item cache for vehicle parts
         void refresh_active_item_cache();
@@ -1007,6 +1021,8 @@ class vehicle
         // project a tileray forward to predict obstacles
         std::set<point_abs_ms> immediate_path( const units::angle &rotate = 0_degrees );
         std::set<point_abs_ms> collision_check_points; // NOLINT(cata-serialize)
+        // Where map::add_vehicle_to_cache last put this vehicle's parts in the level caches.
+        std::vector<tripoint_bub_ms> cached_part_points; // NOLINT(cata-serialize)
         void autopilot_patrol();
         units::angle get_angle_from_targ( const tripoint_abs_ms &targ ) const;
         void drive_to_local_target( const tripoint_abs_ms &target, bool follow_protocol );
@@ -1200,6 +1216,13 @@ class vehicle
                                             bool include_fake = false ) const;
         std::vector<int> parts_at_relative( const point_rel_ms &dp, bool use_cache,
                                             bool include_fake = false ) const;
+        /**
+        *  Same as parts_at_relative( dp, true, include_fake ) but without copying.
+        *  @note uses relative_parts cache, so the returned list is only valid until the next refresh()
+        *  and must not be held on to while parts are installed or removed.
+        */
+        const std::vector<int> &cached_parts_at_relative( const point_rel_ms &dp,
+                bool include_fake = false ) const;
 
         /**
         *  Returns index of part at mount point \p pt which has given \p f flag
@@ -2189,6 +2212,9 @@ class vehicle
         mutable double coefficient_water_resistance = 1; // NOLINT(cata-serialize)
         mutable double draft_m = 1; // NOLINT(cata-serialize)
         mutable double hull_height = 0.3; // NOLINT(cata-serialize)
+        // Drag terms that depend on the parts but not on the mass, so cargo changes can reuse them
+        mutable double rolling_wheel_factor = 50; // NOLINT(cata-serialize)
+        mutable int hull_structure_count = 0; // NOLINT(cata-serialize)
 
         // Bubble location when cache was last refreshed.
         mutable tripoint_bub_ms occupied_cache_pos = { -1, -1, -1 }; // NOLINT(cata-serialize)
@@ -2197,6 +2223,16 @@ class vehicle
         // Cached points occupied by the vehicle
         mutable std::set<tripoint_bub_ms> occupied_points; // NOLINT(cata-serialize)
 
+        // Result of the last search_connected_vehicles() from this vehicle, reused while the
+        // power grid generation and the turn are unchanged.
+        struct connected_vehicles_cache {
+            const vehicle *owner = nullptr;
+            int generation = -1;
+            time_point turn = calendar::before_time_starts;
+            std::map<vehicle *, float> distances;
+        };
+        mutable connected_vehicles_cache grid_cache; // NOLINT(cata-serialize)
+
         // Master list of parts installed in the vehicle.
         std::vector<vehicle_part> parts; // NOLINT(cata-serialize)
         // Used in savegame.cpp to only save real parts to json
@@ -2287,6 +2323,8 @@ class vehicle
         vproto_id type;
         // parts_at_relative(dp) is used a lot (to put it mildly)
         std::map<point, std::vector<int>> relative_parts; // NOLINT(cata-serialize)
+        // relative_parts without the fake parts
+        std::map<point, std::vector<int>> relative_real_parts; // NOLINT(cata-serialize)
         std::set<label> labels;            // stores labels
         std::set<std::string> tags;        // Properties of the vehicle
         // After fuel consumption, this tracks the remainder of fuel < 1, and applies it the next time.
@@ -2406,6 +2444,8 @@ class vehicle
         mutable bool coeff_rolling_dirty = true; // NOLINT(cata-serialize)
         mutable bool coeff_air_dirty = true; // NOLINT(cata-serialize)
         mutable bool coeff_water_dirty = true; // NOLINT(cata-serialize)
+        // rolling_wheel_factor and hull_structure_count need recalculating; only set by refresh
+        mutable bool drag_layout_dirty = true; // NOLINT(cata-serialize)
         // air uses a two stage dirty check: one dirty bit gets set on part install,
         // removal, or breakage. The other dirty bit only gets set during part_removal_cleanup,
         // and that's the bit that controls recalculation.  The intent is to only recalculate
@@ -309,6 +309,12 @@ struct auto_navigation_data {
     int max_steer;
 
     std::array<vehicle_profile, NUM_ORIENTATIONS> profiles;
+    // the vehicle layout the profiles were computed for; they are reused on every
+    // OMT until the vehicle's shape changes
+    bool profiles_valid = false;
+    point_rel_ms profiles_pivot;
+    std::vector<point_rel_ms> profiles_mounts;
+    std::vector<int> profiles_rotors;
     // known obstacles on the view map
     cata::mdarray<bool, point, NAV_VIEW_SIZE_X, NAV_VIEW_SIZE_Y> is_obstacle;
     // z-level of where the ground is per point on the view map
@@ -328,6 +334,7 @@ struct auto_navigation_data {
     void clear() {
         current_omt = { 0, 0, -100 };
         path.clear();
+        profiles_valid = false;
     }
     vehicle_profile &profile( orientation dir ) {
         return profiles.at( static_cast<int>( dir ) );
@@ -859,15 +866,22 @@ void vehicle::autodrive_controller::compute_obstacles_from_enqueued_ramp_points(
 void vehicle::autodrive_controller::compute_valid_positions()
 {
     const coord_transformation veh_rot = {point_zero, -data.nav_to_map.rotation, point_zero};
+    const point veh_origin = veh_rot.transform( point_zero );
+    std::vector<point> offsets;
     for( orientation facing : all_orientations() ) {
         const vehicle_profile &profile = data.profile( data.nav_to_map.transform( facing ) );
+        // rotate the profile into view map space once rather than once per nav map point
+        offsets.clear();
+        for( const point &veh_pt : profile.occupied_zone ) {
+            offsets.push_back( veh_rot.transform( veh_pt ) - veh_origin );
+        }
         for( int mx = 0; mx < NAV_MAP_SIZE_X; mx++ ) {
             for( int my = 0; my < NAV_MAP_SIZE_Y; my++ ) {
                 const point nav_pt( mx, my );
+                const point view_origin = data.nav_to_view.transform( nav_pt );
                 bool valid = true;
-                for( const point &veh_pt : profile.occupied_zone ) {
-                    const point view_pt = data.nav_to_view.transform( nav_pt ) + veh_rot.transform(
-                                              veh_pt ) - veh_rot.transform( point_zero );
+                for( const point &offset : offsets ) {
+                    const point view_pt = view_origin + offset;
                     if( !data.view_bounds.contains( view_pt ) || data.is_obstacle[view_pt.x][view_pt.y] ) {
                         valid = false;
                         break;
@@ -937,8 +951,22 @@ void vehicle::autodrive_controller::precompute_data()
         // TODO: change it during simulation based on vehicle speed and terrain
         // or maybe just keep track of player moves?
         data.max_steer = 1;
-        for( orientation dir : all_orientations() ) {
-            data.profile( dir ) = compute_profile( dir );
+        std::vector<point_rel_ms> mounts;
+        for( const vehicle_part &part : driven_veh.parts ) {
+            if( !part.removed ) {
+                mounts.push_back( part.mount );
+            }
+        }
+        const point_rel_ms pivot = driven_veh.pivot_point();
+        if( !data.profiles_valid || pivot != data.profiles_pivot || mounts != data.profiles_mounts ||
+            driven_veh.rotors != data.profiles_rotors ) {
+            for( orientation dir : all_orientations() ) {
+                data.profile( dir ) = compute_profile( dir );
+            }
+            data.profiles_valid = true;
+            data.profiles_pivot = pivot;
+            data.profiles_mounts = std::move( mounts );
+            data.profiles_rotors = driven_veh.rotors;
         }
 
         // initialize navigation data
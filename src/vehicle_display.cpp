@@ -152,7 +152,7 @@ int vehicle::print_part_list( const catacurses::window &win, int y1, const int m
     if( p < 0 || p >= static_cast<int>( parts.size() ) ) {
         return y1;
     }
-    std::vector<int> pl = this->parts_at_relative( parts[p].mount, true, include_fakes );
+    const std::vector<int> &pl = this->cached_parts_at_relative( parts[p].mount, include_fakes );
     int y = y1;
     for( size_t i = 0; i < pl.size(); i++ ) {
         const vehicle_part &vp = parts[pl[i]];
@@ -251,7 +251,7 @@ void vehicle::print_vparts_descs( const catacurses::window &win, int max_y, int
         return;
     }
 
-    std::vector<int> pl = this->parts_at_relative( parts[p].mount, true );
+    const std::vector<int> &pl = this->cached_parts_at_relative( parts[p].mount );
     std::string msg;
 
     int lines = 0;
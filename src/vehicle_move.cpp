@@ -837,8 +837,6 @@ veh_collision vehicle::part_collision( int part, const tripoint_bub_ms &p,
     Creature *critter = get_creature_tracker().creature_at( p, true );
     Character *ph = dynamic_cast<Character *>( critter );
 
-    Character *driver = get_driver();
-
     // If in a vehicle assume it's this one
     if( ph != nullptr && ph->in_vehicle ) {
         critter = nullptr;
@@ -1080,6 +1078,8 @@ veh_collision vehicle::part_collision( int part, const tripoint_bub_ms &p,
             // We know critter is set for this type.  Assert to inform static
             // analysis.
             cata_assert( critter );
+            // Looking up the driver scans every part, so only do it when someone gets hit
+            Character *driver = get_driver();
 
             // No blood from hallucinations
             if( !critter->is_hallucination() ) {
@@ -110,12 +110,17 @@ static int has_quality_internal( const T &self, const quality_id &qual, int leve
     int qty = 0;
 
     self.visit_items( [&qual, level, &limit, &qty]( item * e, item * ) {
-        if( e->get_quality( qual ) >= level ) {
+        const int quality = e->get_quality( qual );
+        if( quality >= level ) {
             qty = sum_no_wrap( qty, static_cast<int>( e->count() ) );
             if( qty >= limit ) {
                 // found sufficient items
                 return VisitResponse::ABORT;
             }
+        } else if( quality != INT_MIN ) {
+            // The quality of an item covers everything it contains, so nothing inside can
+            // reach the level either. Only a full pot (INT_MIN for BOIL) hides its contents.
+            return VisitResponse::SKIP;
         }
         return VisitResponse::NEXT;
     } );
@@ -128,7 +133,7 @@ static int has_quality_from_vpart( const vehicle &veh, int part, const quality_i
     int qty = 0;
 
     point_rel_ms pos = veh.part( part ).mount;
-    for( const int n : veh.parts_at_relative( pos, true ) ) {
+    for( const int n : veh.cached_parts_at_relative( pos ) ) {
         const vehicle_part &vp = veh.part( n );
         // only unbroken parts can provide tool qualities
         if( !vp.is_broken() ) {
@@ -231,8 +236,11 @@ static int max_quality_internal( const T &self, const quality_id &qual )
 {
     int res = INT_MIN;
     self.visit_items( [&res, &qual]( item * e, item * ) {
-        res = std::max( res, e->get_quality( qual ) );
-        return VisitResponse::NEXT;
+        const int quality = e->get_quality( qual );
+        res = std::max( res, quality );
+        // The quality of an item already includes the best of its contents, unless it is a
+        // full pot which has no BOIL quality of its own.
+        return quality != INT_MIN ? VisitResponse::SKIP : VisitResponse::NEXT;
     } );
     return res;
 }
@@ -242,7 +250,7 @@ static int max_quality_from_vpart( const vehicle &veh, int part, const quality_i
     int res = INT_MIN;
 
     point_rel_ms pos = veh.part( part ).mount;
-    for( const int &n : veh.parts_at_relative( pos, true ) ) {
+    for( const int n : veh.cached_parts_at_relative( pos ) ) {
         const vehicle_part &vp = veh.part( n );
 
         // only unbroken parts can provide tool qualities
@@ -634,6 +642,7 @@ std::list<item> inventory::remove_items_with( const
 
     // Invalidate binning cache
     binned = false;
+    stack_index.invalidate();
 
     return res;
 }
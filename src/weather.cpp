@@ -4,9 +4,11 @@
 #include <array>
 #include <cmath>
 #include <functional>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "activity_type.h"
@@ -177,7 +179,7 @@ static void proc_weather_sum( const weather_type_id &wtype, weather_sum &data,
 weather_type_id current_weather( const tripoint_abs_ms &location, const time_point &t )
 {
     weather_manager &weather = get_weather();
-    const weather_generator wgen = weather.get_cur_weather_gen();
+    const weather_generator &wgen = weather.get_cur_weather_gen();
     if( weather.weather_override != WEATHER_NULL ) {
         return weather.weather_override;
     }
@@ -185,13 +187,58 @@ weather_type_id current_weather( const tripoint_abs_ms &location, const time_poi
 }
 
 ////// Funnels.
+// The weather of whole hours per overmap tile, for integrating weather over long absences.
+// The weather generator's noise only changes over thousands of tiles and over hours, so the
+// funnels, plants and solar panels of a base share a few generated samples instead of running
+// the generator and the weather conditions for every minute of every item.
+static weather_type_id sampled_weather( const tripoint_abs_ms &location, const time_point &t )
+{
+    weather_manager &weather = get_weather();
+    if( weather.weather_override != WEATHER_NULL ) {
+        return weather.weather_override;
+    }
+    struct weather_timeline {
+        const weather_generator *wgen = nullptr;
+        unsigned seed = 0;
+        std::map<std::pair<tripoint_abs_omt, int>, weather_type_id> samples;
+    };
+    // Plenty for years of absence around a base, just in case.
+    static constexpr size_t max_samples = 1 << 16;
+    static weather_timeline timeline;
+    const weather_generator &wgen = weather.get_cur_weather_gen();
+    if( timeline.wgen != &wgen || timeline.seed != g->get_seed() ||
+        timeline.samples.size() >= max_samples ) {
+        timeline.samples.clear();
+        timeline.wgen = &wgen;
+        timeline.seed = g->get_seed();
+    }
+    const tripoint_abs_omt omt = project_to<coords::omt>( location );
+    const int hour = to_hours<int>( t - calendar::turn_zero );
+    const auto found = timeline.samples.find( { omt, hour } );
+    if( found != timeline.samples.end() ) {
+        return found->second;
+    }
+    const time_point sample_time = calendar::turn_zero + time_duration::from_hours( hour );
+    const weather_type_id sample = wgen.get_weather_conditions( project_to<coords::ms>( omt ),
+                                   sample_time, g->get_seed() );
+    timeline.samples.emplace( std::make_pair( omt, hour ), sample );
+    return sample;
+}
+
 weather_sum sum_conditions( const time_point &start, const time_point &end,
                             const tripoint_abs_ms &location )
 {
     time_duration tick_size = 0_turns;
     weather_sum data;
 
+    // Wind is taken from the current weather, not the weather at each tick, so it is the same
+    // for every tick and only needs scaling by the length of the period.
     weather_manager &weather = get_weather();
+    if( start < end ) {
+        data.wind_amount = get_local_windpower( weather.windspeed,
+                                                overmap_buffer.ter( project_to<coords::omt>( location ) ),
+                                                location, weather.winddirection, false ) * to_turns<int>( end - start );
+    }
     for( time_point t = start; t < end; t += tick_size ) {
         const time_duration diff = end - t;
         if( diff < 10_turns ) {
@@ -202,12 +249,10 @@ weather_sum sum_conditions( const time_point &start, const time_point &end,
             tick_size = 1_minutes;
         }
 
-        weather_type_id wtype = current_weather( location, t );
+        // The last few turns are close enough to the present to use the exact weather.
+        const weather_type_id wtype = tick_size < 1_minutes ? current_weather( location, t ) :
+                                      sampled_weather( location, t );
         proc_weather_sum( wtype, data, t, tick_size );
-        data.wind_amount += get_local_windpower( weather.windspeed,
-                            overmap_buffer.ter( project_to<coords::omt>( location ) ),
-                            location,
-                            weather.winddirection, false ) * to_turns<int>( tick_size );
     }
     return data;
 }
@@ -222,13 +267,23 @@ void retroactively_fill_from_funnel( item &it, const trap &tr, const time_point
         return;
     }
 
+    retroactively_fill_from_funnel( it, tr, end, sum_conditions( start, end, pos ) );
+}
+
+void retroactively_fill_from_funnel( item &it, const trap &tr, const time_point &end,
+                                     const weather_sum &since_last_fill )
+{
+    if( !tr.is_funnel() ) {
+        return;
+    }
+
     // bday == last fill check
     it.set_birthday( end );
-    weather_sum data = sum_conditions( start, end, pos );
 
     // Technically 0.0 division is OK, but it will be cleaner without it
-    if( data.rain_amount > 0 ) {
-        const int rain = roll_remainder( 1.0 / tr.funnel_turns_per_charge( data.rain_amount ) );
+    if( since_last_fill.rain_amount > 0 ) {
+        const int rain = roll_remainder( 1.0 / tr.funnel_turns_per_charge(
+                                             since_last_fill.rain_amount ) );
         it.add_rain_to_container( rain );
         // add_msg_debug( "Retroactively adding %d water from turn %d to %d", rain, startturn, endturn);
     }
@@ -556,7 +611,7 @@ std::string weather_forecast( const point_abs_sm &abs_sm_pos )
                                  1_hours;
     for( int d = 0; d < 6; d++ ) {
         weather_type_id forecast = WEATHER_NULL;
-        const weather_generator wgen = get_weather().get_cur_weather_gen();
+        const weather_generator &wgen = get_weather().get_cur_weather_gen();
         for( time_point i = last_hour + d * 12_hours; i < last_hour + ( d + 1 ) * 12_hours; i += 1_hours ) {
             w_point w = wgen.get_weather( abs_ms_pos, i, g->get_seed() );
             *weather.weather_precise = w;
@@ -156,6 +156,9 @@ weather_sum sum_conditions( const time_point &start,
  */
 void retroactively_fill_from_funnel( item &it, const trap &tr, const time_point &start,
                                      const time_point &end, const tripoint_abs_ms &pos );
+/** Like the above, with the weather since the last fill summed up already. */
+void retroactively_fill_from_funnel( item &it, const trap &tr, const time_point &end,
+                                     const weather_sum &since_last_fill );
 
 double funnel_charges_per_turn( double surface_area_mm2, double rain_depth_mm_per_hour );
 
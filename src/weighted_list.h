@@ -5,12 +5,83 @@
 #include "json.h"
 #include "rng.h"
 
+#include <algorithm>
 #include <climits>
+#include <cstdint>
 #include <cstdlib>
 #include <functional>
 #include <sstream>
 #include <vector>
 
+/**
+ * Walker's alias method: after an O(N) build, an index is picked with probability
+ * proportional to its weight from a single random number, in constant time.
+ * Each of the N columns keeps its own index with probability keep[i] / 2^32 and
+ * hands the rest of its share to alias[i].
+ */
+class weighted_alias_table
+{
+    public:
+        template<typename W>
+        void build( const std::vector<W> &weights ) {
+            clear();
+            double total = 0;
+            for( const W &w : weights ) {
+                total += std::max<double>( w, 0 );
+            }
+            const size_t n = weights.size();
+            if( n == 0 || total <= 0 ) {
+                return;
+            }
+            std::vector<double> scaled( n );
+            std::vector<uint32_t> small;
+            std::vector<uint32_t> large;
+            for( size_t i = 0; i < n; i++ ) {
+                scaled[i] = std::max<double>( weights[i], 0 ) * n / total;
+                ( scaled[i] < 1.0 ? small : large ).push_back( static_cast<uint32_t>( i ) );
+            }
+            keep.assign( n, full_share );
+            alias.resize( n );
+            for( size_t i = 0; i < n; i++ ) {
+                alias[i] = static_cast<uint32_t>( i );
+            }
+            while( !small.empty() && !large.empty() ) {
+                const uint32_t s = small.back();
+                small.pop_back();
+                const uint32_t l = large.back();
+                keep[s] = static_cast<uint64_t>( scaled[s] * full_share );
+                alias[s] = l;
+                scaled[l] -= 1.0 - scaled[s];
+                if( scaled[l] < 1.0 ) {
+                    large.pop_back();
+                    small.push_back( l );
+                }
+            }
+            // Whatever is left over only differs from a full column by rounding error.
+        }
+
+        size_t pick( unsigned int randi ) const {
+            // The high bits of randi * N choose the column, the low bits are the coin.
+            const uint64_t r = static_cast<uint64_t>( randi ) * keep.size();
+            const size_t column = r >> 32;
+            return ( r & UINT32_MAX ) < keep[column] ? column : alias[column];
+        }
+
+        void clear() {
+            keep.clear();
+            alias.clear();
+        }
+
+        bool empty() const noexcept {
+            return keep.empty();
+        }
+
+    private:
+        static constexpr uint64_t full_share = uint64_t( 1 ) << 32;
+        std::vector<uint64_t> keep;
+        std::vector<uint32_t> alias;
+};
+
 template <typename W, typename T> struct weighted_object {
     weighted_object( const T &obj, const W &weight ) : obj( obj ), weight( weight ) {}
 
@@ -270,11 +341,22 @@ static_assert( std::is_nothrow_move_constructible_v<weighted_int_list<int>> );
 
 template <typename T> struct weighted_float_list : public weighted_list<double, T> {
 
-        // TODO: precalc using alias method
+        // populate the alias table for O(1) lookups
+        void precalc() {
+            std::vector<double> weights;
+            weights.reserve( this->objects.size() );
+            for( const weighted_object<double, T> &o : this->objects ) {
+                weights.push_back( o.weight );
+            }
+            alias_table.build( weights );
+        }
 
     protected:
 
         size_t pick_ent( unsigned int randi ) const override {
+            if( !alias_table.empty() ) {
+                return alias_table.pick( randi );
+            }
             const double picked = static_cast<double>( randi ) / UINT_MAX * this->total_weight;
             double accumulated_weight = 0;
             size_t i;
@@ -287,6 +369,11 @@ template <typename T> struct weighted_float_list : public weighted_list<double,
             return i;
         }
 
+        void invalidate_precalc() override {
+            alias_table.clear();
+        }
+
+        weighted_alias_table alias_table;
 };
 
 template<typename W, typename T>
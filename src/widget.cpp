@@ -1,5 +1,10 @@
 #include "widget.h"
 
+#include <functional>
+#include <map>
+#include <tuple>
+
+#include "calendar.h"
 #include "character_martial_arts.h"
 #include "color.h"
 #include "condition.h"
@@ -9,6 +14,7 @@
 #include "output.h"
 #include "overmapbuffer.h"
 #include "npctalk.h"
+#include "string_formatter.h"
 
 const static flag_id json_flag_W_DISABLED_BY_DEFAULT( "W_DISABLED_BY_DEFAULT" );
 const static flag_id json_flag_W_DISABLED_WHEN_EMPTY( "W_DISABLED_WHEN_EMPTY" );
@@ -23,6 +29,18 @@ const static std::string default_separator = ": ";
 namespace
 {
 generic_factory<widget> widget_factory( "widgets" );
+
+// Text laid out for a sidebar panel, by widget, width, label width and skip_pad.
+using panel_text_key = std::tuple<widget_id, int, int, bool>;
+struct panel_text {
+    std::string text;
+    // Height of the widget after laying it out
+    int height = 0;
+    int generation = -1;
+    time_point turn = calendar::before_time_starts;
+};
+std::map<panel_text_key, panel_text> panel_text_cache;
+int panel_text_generation = 0;
 } // namespace
 
 template<>
@@ -45,6 +63,12 @@ void widget::load_widget( const JsonObject &jo, const std::string &src )
 void widget::reset()
 {
     widget_factory.reset();
+    panel_text_cache.clear();
+}
+
+void widget::invalidate_panel_cache()
+{
+    panel_text_generation++;
 }
 
 const std::vector<widget> &widget::get_all()
@@ -920,6 +944,21 @@ int widget::custom_draw_multiline( const std::string &widget_string, const catac
     return row_num;
 }
 
+// The sidebar is redrawn for nearly every keystroke and below every menu, but what it shows only
+// changes with the game.  So the text of a panel is laid out again only once the turn has passed
+// or a player action was handled, see widget::invalidate_panel_cache.
+static const panel_text &cached_panel_text( const panel_text_key &key,
+        const std::function<std::string( int &height )> &lay_out )
+{
+    panel_text &cached = panel_text_cache[key];
+    if( cached.generation != panel_text_generation || cached.turn != calendar::turn ) {
+        cached.text = lay_out( cached.height );
+        cached.generation = panel_text_generation;
+        cached.turn = calendar::turn;
+    }
+    return cached;
+}
+
 // Drawing function, provided as a callback to the window_panel constructor.
 // Handles rendering a widget's content into a window panel.
 static int custom_draw_func( const draw_args &args )
@@ -953,16 +992,21 @@ static int custom_draw_func( const draw_args &args )
             std::vector<string_id<widget>> widgets = wgt->widgets( !wgt->_clauses.empty() );
             int row_num = 0;
             for( const widget_id &row_wid : widgets ) {
-                widget row_widget = row_wid.obj();
-
-                const std::string txt = row_widget.layout( u, widt, wgt->_label_width,
-                                        skip_pad || row_wid->has_flag( json_flag_W_NO_PADDING ) );
-                if( row_wid->has_flag( json_flag_W_DISABLED_WHEN_EMPTY ) && txt.empty() ) {
+                const bool row_skip_pad = skip_pad || row_wid->has_flag( json_flag_W_NO_PADDING );
+                const panel_text_key key( row_wid, widt, wgt->_label_width, row_skip_pad );
+                const panel_text &row = cached_panel_text( key, [&]( int &height ) {
+                    widget row_widget = row_wid.obj();
+                    std::string laid_out = row_widget.layout( u, widt, wgt->_label_width,
+                                           row_skip_pad );
+                    height = row_widget._height;
+                    return laid_out;
+                } );
+                if( row_wid->has_flag( json_flag_W_DISABLED_WHEN_EMPTY ) && row.text.empty() ) {
                     // reclaim the skipped height in the sidebar
-                    height_diff -= row_widget._height;
+                    height_diff -= row.height;
                 } else {
                     // draw normally
-                    row_num = widget::custom_draw_multiline( txt, w, margin, widt, row_num );
+                    row_num = widget::custom_draw_multiline( row.text, w, margin, widt, row_num );
                 }
             }
 
@@ -978,7 +1022,12 @@ static int custom_draw_func( const draw_args &args )
             // For now, this is the default when calling layout()
             // So, just layout self on a single line
 
-            const std::string txt = wgt->layout( u, widt, wgt->_label_width, skip_pad );
+            const panel_text_key key( wgt->getId(), widt, wgt->_label_width, skip_pad );
+            const std::string &txt = cached_panel_text( key, [&]( int &height ) {
+                std::string laid_out = wgt->layout( u, widt, wgt->_label_width, skip_pad );
+                height = wgt->_height;
+                return laid_out;
+            } ).text;
             if( disable_empty && txt.empty() ) {
                 // reclaim the skipped height in the sidebar
                 height_diff -= wgt->_height;
@@ -989,7 +1038,12 @@ static int custom_draw_func( const draw_args &args )
         }
     } else {
         // No layout, just a widget
-        const std::string txt = wgt->layout( u, widt, 0, skip_pad );
+        const panel_text_key key( wgt->getId(), widt, 0, skip_pad );
+        const std::string &txt = cached_panel_text( key, [&]( int &height ) {
+            std::string laid_out = wgt->layout( u, widt, 0, skip_pad );
+            height = wgt->_height;
+            return laid_out;
+        } ).text;
         if( disable_empty && txt.empty() ) {
             // reclaim the skipped height in the sidebar
             height_diff -= wgt->_height;
@@ -1369,7 +1423,7 @@ nc_color widget::value_color( int value )
 
 std::string widget::number( int value, bool from_condition ) const
 {
-    return from_condition ? number_cond() : string_format( "%d", value );
+    return from_condition ? number_cond() : string_format( CATA_FORMAT( "%d" ), value );
 }
 
 std::string widget::text( bool from_condition, int width )
@@ -1406,13 +1460,13 @@ std::string widget::number_cond( enumeration_conjunction join_type ) const
     std::vector<const widget_clause *> wplist = get_clauses();
     if( wplist.empty() ) {
         // All clauses returned false conditions, use default
-        std::string txt = string_format( "%d", _default_clause.value );
+        std::string txt = string_format( CATA_FORMAT( "%d" ), _default_clause.value );
         return _default_clause.value == INT_MIN ? "" :
                _default_clause.color == c_unset ? txt : colorize( txt, _default_clause.color );
     }
     // Get values as a comma-separated list
     return enumerate_as_string( wplist.begin(), wplist.end(), []( const widget_clause * wp ) {
-        std::string txt = string_format( "%d", wp->value );
+        std::string txt = string_format( CATA_FORMAT( "%d" ), wp->value );
         return wp->color == c_unset ? txt : colorize( txt, wp->color );
     }, join_type );
 }
@@ -1487,7 +1541,7 @@ std::string widget::sym_text_cond( bool no_join, int width )
         if( wp->should_parse_tags ) {
             parse_tags( txt_str, get_player_character(), get_player_character() );
         }
-        std::string txt = string_format( "%s %s", s, txt_str );
+        std::string txt = string_format( CATA_FORMAT( "%s %s" ), s, txt_str );
         strings.emplace_back( txt );
     }
     int h = 0;
@@ -303,6 +303,8 @@ class widget
                 const std::string &label_separator, int col_padding );
         // Reset to defaults using generic widget_factory
         static void reset();
+        // Lay out the sidebar panels again on their next redraw, the game may have changed
+        static void invalidate_panel_cache();
         // Get all widget instances from the factory
         static const std::vector<widget> &get_all();
         // Get this widget's id
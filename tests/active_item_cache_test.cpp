@@ -1,7 +1,12 @@
+#include <optional>
 #include <set>
+#include <utility>
+#include <vector>
 
+#include "active_item_cache.h"
 #include "calendar.h"
 #include "cata_catch.h"
+#include "coordinate_constants.h"
 #include "game_constants.h"
 #include "item.h"
 #include "map.h"
@@ -40,3 +45,62 @@ TEST_CASE( "place_active_item_at_various_coordinates", "[item]" )
         }
     }
 }
+
+TEST_CASE( "active_items_are_handed_out_when_due", "[item]" )
+{
+    active_item_cache cache;
+    std::optional<item> cookie( std::in_place, "cookies" );
+    const int speed = cookie->processing_speed();
+    REQUIRE( speed > 1 );
+    REQUIRE( speed != item::NO_PROCESSING );
+    REQUIRE( cache.add( *cookie, point_sm_ms_zero ) );
+    REQUIRE_FALSE( cache.empty() );
+
+    // The first item added is due right away, then once per processing interval.
+    CHECK( cache.get_for_processing().size() == 1 );
+    CHECK( cache.get_for_processing().empty() );
+    calendar::turn += time_duration::from_turns( speed - 1 );
+    CHECK( cache.get_for_processing().empty() );
+    calendar::turn += 1_turns;
+    CHECK( cache.get_for_processing().size() == 1 );
+    CHECK( cache.get().size() == 1 );
+
+    cookie.reset();
+    CHECK( cache.empty() );
+    CHECK( cache.get().empty() );
+}
+
+TEST_CASE( "active_item_cache_keeps_track_of_items_it_moves_around", "[item]" )
+{
+    active_item_cache cache;
+    std::vector<std::optional<item>> cookies( 4 );
+    for( std::optional<item> &cookie : cookies ) {
+        cookie.emplace( "cookies" );
+        REQUIRE( cache.add( *cookie, point_sm_ms_zero ) );
+    }
+    REQUIRE( cache.get().size() == 4 );
+
+    // Removing the first ones moves the last ones into their places.
+    cookies[0].reset();
+    cookies[1].reset();
+    std::vector<item_reference> left = cache.get();
+    REQUIRE( left.size() == 2 );
+    std::set<const item *> expected = { &*cookies[2], &*cookies[3] };
+    for( const item_reference &ref : left ) {
+        CHECK( expected.count( ref.item_ref.get() ) == 1 );
+    }
+
+    // They are still handed out once per processing interval.
+    const int speed = cookies[2]->processing_speed();
+    int handed_out = 0;
+    for( int turn = 0; turn < speed; ++turn ) {
+        handed_out += cache.get_for_processing().size();
+        calendar::turn += 1_turns;
+    }
+    CHECK( handed_out == 2 );
+
+    // And adding them again doesn't cache them twice.
+    CHECK( cache.add( *cookies[3], point_sm_ms_zero ) );
+    CHECK( cache.get().size() == 2 );
+    CHECK( cache.get_for_processing().size() == 1 );
+}
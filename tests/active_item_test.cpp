@@ -1,15 +1,23 @@
 #include <list>
 #include <new>
 #include <optional>
+#include <vector>
 
 #include "avatar.h"
 #include "calendar.h"
 #include "cata_catch.h"
+#include "coordinates.h"
 #include "item.h"
 #include "itype.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "player_helpers.h"
+#include "point.h"
+#include "type_id.h"
+#include "units.h"
+#include "weather.h"
+
+static const flag_id json_flag_COLD( "COLD" );
 
 TEST_CASE( "active_items_processed_regularly", "[active_item]" )
 {
@@ -98,3 +106,56 @@ TEST_CASE( "tool_power_consumption_rate", "[active_item]" )
     CHECK( seconds_of_discharge > to_seconds<int>( 9_hours + 30_minutes ) );
     CHECK( seconds_of_discharge < to_seconds<int>( 10_hours ) );
 }
+
+TEST_CASE( "food_on_the_map_rots_like_food_processed_on_its_own", "[active_item]" )
+{
+    clear_map();
+    map &here = get_map();
+    get_weather().temperature = units::from_fahrenheit( 65 );
+    get_weather().clear_temp_cache();
+
+    // Enough food on more than one submap to be processed ahead in parallel.
+    item food( "meat_cooked" );
+    food.process( here, nullptr, tripoint_bub_ms( 60, 60, 0 ), 1, temperature_flag::NORMAL );
+    REQUIRE( food.only_changes_temperature_and_rot() );
+    std::vector<tripoint_bub_ms> spots;
+    for( int x = 0; x < 2 * SEEX; ++x ) {
+        for( int y = 0; y < 2 * SEEY; ++y ) {
+            spots.emplace_back( 60 + x, 60 + y, 0 );
+            here.add_item( spots.back(), food );
+        }
+    }
+    item on_its_own = food;
+
+    calendar::turn += 3_hours;
+    here.process_items();
+    on_its_own.process( here, nullptr, spots.front(), 1, temperature_flag::NORMAL );
+    REQUIRE( on_its_own.get_rot() > 0_turns );
+
+    for( const tripoint_bub_ms &p : spots ) {
+        CAPTURE( p );
+        const item &it = here.i_at( p ).only_item();
+        CHECK( it.get_rot() == on_its_own.get_rot() );
+        CHECK( it.has_own_flag( json_flag_COLD ) == on_its_own.has_own_flag( json_flag_COLD ) );
+    }
+}
+
+TEST_CASE( "carried_guns_cool_down_between_turns", "[active_item][gun]" )
+{
+    clear_avatar();
+    clear_map();
+    avatar &player_character = get_avatar();
+
+    item storage( "debug_backpack", calendar::turn_zero );
+    REQUIRE( player_character.wear_item( storage ) );
+
+    item hot_gun( "glock_19" );
+    hot_gun.set_var( "gun_heat", 50 );
+    item_location carried_gun = player_character.try_add( hot_gun );
+    REQUIRE( carried_gun != item_location::nowhere );
+    REQUIRE( carried_gun->needs_processing() );
+
+    player_character.process_items();
+
+    CHECK( carried_gun->get_var( "gun_heat", 0.0 ) < 50 );
+}
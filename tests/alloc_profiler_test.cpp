@@ -0,0 +1,53 @@
+#include "cata_catch.h"
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "alloc_profiler.h"
+
+TEST_CASE( "alloc_profiler_tags_nest", "[alloc_profiler][nogame]" )
+{
+    const alloc_profiler::tag outer = alloc_profiler::current_tag();
+    {
+        const alloc_profiler::scoped_tag items( alloc_profiler::tag::items );
+        {
+            const alloc_profiler::scoped_tag tiles( alloc_profiler::tag::tiles );
+            if( alloc_profiler::is_available() ) {
+                CHECK( alloc_profiler::current_tag() == alloc_profiler::tag::tiles );
+            }
+        }
+        if( alloc_profiler::is_available() ) {
+            CHECK( alloc_profiler::current_tag() == alloc_profiler::tag::items );
+        }
+    }
+    CHECK( alloc_profiler::current_tag() == outer );
+
+    std::ostringstream csv;
+    alloc_profiler::write_csv( csv );
+    CHECK( csv.str().find( "\nmap_memory," ) != std::string::npos );
+}
+
+TEST_CASE( "alloc_profiler_credits_frees_to_the_allocating_tag", "[alloc_profiler][nogame]" )
+{
+    if( !alloc_profiler::is_available() ) {
+        return;
+    }
+    const size_t creatures = static_cast<size_t>( alloc_profiler::tag::creatures );
+    const alloc_profiler::snapshot before = alloc_profiler::take_snapshot();
+    std::unique_ptr<std::vector<char>> block;
+    {
+        const alloc_profiler::scoped_tag tag( alloc_profiler::tag::creatures );
+        block = std::make_unique<std::vector<char>>( 1000 );
+    }
+    const alloc_profiler::snapshot during = alloc_profiler::take_snapshot();
+    CHECK( during.stats[creatures].allocations - before.stats[creatures].allocations == 2 );
+    CHECK( during.stats[creatures].live_bytes - before.stats[creatures].live_bytes >= 1000 );
+
+    // Freed outside of the tag, but still taken off its count.
+    block.reset();
+    const alloc_profiler::snapshot after = alloc_profiler::take_snapshot();
+    CHECK( after.stats[creatures].live_bytes == before.stats[creatures].live_bytes );
+    CHECK( after.stats[creatures].live_blocks == before.stats[creatures].live_blocks );
+}
@@ -0,0 +1,47 @@
+#include "cata_catch.h"
+
+#include <cstddef>
+
+#include "cata_bitset.h"
+
+TEST_CASE( "tiny_bitset_union_and_intersection", "[bitset][nogame]" )
+{
+    // One bitset stays inline, the other needs heap storage.
+    tiny_bitset small( 10 );
+    small.set( 3 );
+    small.set( 9 );
+    tiny_bitset large( 300 );
+    large.set( 3 );
+    large.set( 70 );
+    large.set( 299 );
+
+    tiny_bitset merged = small;
+    merged.set_union( large );
+    REQUIRE( merged.size() == 300 );
+    for( size_t i = 0; i < merged.size(); ++i ) {
+        CAPTURE( i );
+        CHECK( merged.test( i ) == ( i == 3 || i == 9 || i == 70 || i == 299 ) );
+    }
+
+    tiny_bitset copy = merged;
+    REQUIRE( copy.size() == 300 );
+    CHECK( copy.test( 299 ) );
+
+    merged.set_intersection( small );
+    for( size_t i = 0; i < merged.size(); ++i ) {
+        CAPTURE( i );
+        CHECK( merged.test( i ) == ( i == 3 || i == 9 ) );
+    }
+
+    small.set_intersection( large );
+    CHECK( small.test( 3 ) );
+    CHECK_FALSE( small.test( 9 ) );
+
+    // Growing again must not bring back the bits that were cut off.
+    copy.resize( 10 );
+    copy.resize( 400 );
+    CHECK( copy.test( 3 ) );
+    CHECK_FALSE( copy.test( 70 ) );
+    CHECK_FALSE( copy.test( 299 ) );
+    CHECK_FALSE( copy.test( 399 ) );
+}
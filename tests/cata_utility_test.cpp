@@ -409,3 +409,69 @@ TEST_CASE( "lcmatch", "[utility][nogame]" )
     CHECK( lcmatch( "無効", "無" ) == true );
     CHECK( lcmatch( "無効", "無效" ) == false );
 }
+
+TEST_CASE( "lcmatcher_matches_like_lcmatch", "[utility][nogame]" )
+{
+    const lcmatcher bo( "bO" );
+    CHECK( bo( "Bo" ) );
+    CHECK( bo( "BŌ" ) );
+    CHECK_FALSE( bo( "co" ) );
+    const lcmatcher pri( "прИ" );
+    CHECK( pri( "«101 борцовский приём»" ) );
+    CHECK_FALSE( pri( "борцовский" ) );
+    // Like lcmatch, an empty query matches everything.
+    CHECK( lcmatcher( "" )( "anything" ) );
+}
+
+TEST_CASE( "lcmatch_subject_matches_like_the_plain_string", "[utility][nogame]" )
+{
+    for( const char *str : {
+             "Bo", "BŌ", "co", "«101 борцовский приём»", ""
+         } ) {
+        const lcmatch_subject subject( str );
+        for( const char *qry : {
+                 "bO", "ō", "прИ", "борцовский", "x", ""
+             } ) {
+            CAPTURE( str, qry );
+            const lcmatcher matches( qry );
+            CHECK( matches( subject ) == matches( std::string_view( str ) ) );
+        }
+    }
+}
+
+TEST_CASE( "wildcard_matcher", "[utility][nogame]" )
+{
+    const std::string text = "Wood Arrow";
+    CHECK( wildcard_matcher( "*" )( text ) );
+    CHECK( wildcard_matcher( "wooD aRrow" )( text ) );
+    CHECK( wildcard_matcher( "wood*" )( text ) );
+    CHECK( wildcard_matcher( "*arrow" )( text ) );
+    CHECK( wildcard_matcher( "wood*arrow" )( text ) );
+    CHECK( wildcard_matcher( "*wood**arrow*" )( text ) );
+    CHECK( wildcard_matcher( "*d*r*w" )( text ) );
+    CHECK_FALSE( wildcard_matcher( "wood" )( text ) );
+    CHECK_FALSE( wildcard_matcher( "arrow*" )( text ) );
+    CHECK_FALSE( wildcard_matcher( "*arrow*wood*" )( text ) );
+    // The pieces may not overlap
+    CHECK_FALSE( wildcard_matcher( "ab*bc" )( "abc" ) );
+    CHECK_FALSE( wildcard_matcher( "*" )( "" ) );
+}
+
+TEST_CASE( "gzip_compress_roundtrips", "[utility][nogame]" )
+{
+    std::string data;
+    for( int i = 0; i < 1000; ++i ) {
+        data += R"({"ter":"t_dirt","furn":"f_null","items":[]},)";
+    }
+
+    for( int level : { 1, 6, 9 } ) {
+        CAPTURE( level );
+        const std::string compressed = gzip_compress( data, level );
+        CHECK( is_gzip_data( compressed ) );
+        CHECK( compressed.size() < data.size() / 10 );
+        CHECK( gzip_decompress( compressed ) == data );
+    }
+    CHECK( gzip_decompress( gzip_compress( "", 6 ) ).empty() );
+    CHECK_FALSE( is_gzip_data( data ) );
+    CHECK_THROWS( gzip_decompress( data ) );
+}
@@ -6,6 +6,7 @@
 #include "cata_catch.h"
 #include "clzones.h"
 #include "coordinate_constants.h"
+#include "coordinates.h"
 #include "item.h"
 #include "item_category.h"
 #include "map_helpers.h"
@@ -21,6 +22,7 @@ static const faction_id faction_your_followers( "your_followers" );
 static const itype_id itype_556( "556" );
 static const itype_id itype_ammolink223( "ammolink223" );
 static const itype_id itype_belt223( "belt223" );
+static const itype_id itype_test_bitter_almond( "test_bitter_almond" );
 
 static const vproto_id vehicle_prototype_shopping_cart( "shopping_cart" );
 
@@ -121,6 +123,60 @@ TEST_CASE( "zone_unloading_ammo_belts", "[zones][items][ammo_belt][activities][u
 // Comestibles sorting is a bit awkward. Unlike other loot, they're almost
 // always inside of a container, and their sort zone changes based on their
 // shelf life and whether the container prevents rotting.
+TEST_CASE( "zone_sorting_moves_every_item_to_its_zone", "[zones][items][activities]" )
+{
+    avatar &dummy = get_avatar();
+    map &here = get_map();
+    clear_avatar();
+    clear_map();
+
+    const tripoint_bub_ms src = tripoint_bub_ms_zero + tripoint_east;
+    const tripoint_bub_ms food_a = src + tripoint_east;
+    const tripoint_bub_ms food_b = src + tripoint_west;
+    dummy.set_location( here.getglobal( src ) );
+    create_tile_zone( "Unsorted", zone_type_LOOT_UNSORTED, src.raw() );
+    create_tile_zone( "Food", zone_type_LOOT_FOOD, food_a.raw() );
+    create_tile_zone( "More food", zone_type_LOOT_FOOD, food_b.raw() );
+
+    for( int i = 0; i < 20; ++i ) {
+        here.add_item( src, item( itype_test_bitter_almond, calendar::turn, 1 ) );
+    }
+    const int almonds = count_items_or_charges( src.raw(), itype_test_bitter_almond, std::nullopt );
+    REQUIRE( almonds > 0 );
+
+    dummy.assign_activity( player_activity( ACT_MOVE_LOOT ) );
+    process_activity( dummy );
+
+    // Every item goes to one of the two tiles of the same zone type.
+    CHECK( here.i_at( src ).empty() );
+    CHECK( count_items_or_charges( food_a.raw(), itype_test_bitter_almond, std::nullopt ) +
+           count_items_or_charges( food_b.raw(), itype_test_bitter_almond,
+                                   std::nullopt ) == almonds );
+}
+
+TEST_CASE( "zone_queries_cover_large_zones", "[zones]" )
+{
+    clear_map();
+    zone_manager &zm = zone_manager::get_manager();
+    zm.add( "Big", zone_type_LOOT_FOOD, faction_your_followers, false, true,
+            tripoint( 100, 100, 0 ), tripoint( 299, 299, 0 ) );
+
+    const tripoint_abs_ms inside( 150, 150, 0 );
+    const tripoint_abs_ms outside( 90, 150, 0 );
+    CHECK( zm.has( zone_type_LOOT_FOOD, inside, faction_your_followers ) );
+    CHECK_FALSE( zm.has( zone_type_LOOT_FOOD, outside, faction_your_followers ) );
+    CHECK( zm.has_near( zone_type_LOOT_FOOD, outside, 10, faction_your_followers ) );
+    CHECK_FALSE( zm.has_near( zone_type_LOOT_FOOD, outside, 9, faction_your_followers ) );
+    CHECK( zm.get_nearest( zone_type_LOOT_FOOD, outside, 20, faction_your_followers ) ==
+           tripoint_abs_ms( 100, 150, 0 ) );
+    CHECK_FALSE( zm.get_nearest( zone_type_LOOT_FOOD, outside, 9, faction_your_followers ) );
+    // Only the corner of the zone is within range.
+    CHECK( zm.get_near( zone_type_LOOT_FOOD, tripoint_abs_ms( 99, 99, 0 ), 2, nullptr,
+                        faction_your_followers ).size() == 4 );
+    CHECK( zm.get_near( zone_type_LOOT_FOOD, tripoint_abs_ms( 99, 99, 3 ), 2, nullptr,
+                        faction_your_followers ).empty() );
+}
+
 TEST_CASE( "zone_sorting_comestibles_", "[zones][items][food][activities]" )
 {
     clear_map();
@@ -0,0 +1,224 @@
+#include <array>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "creature_tracker.h"
+#include "flexbuffer_json.h"
+#include "game_constants.h"
+#include "item.h"
+#include "json.h"
+#include "json_loader.h"
+#include "lightmap.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "mdarray.h"
+#include "monster.h"
+#include "pathfinding.h"
+#include "player_helpers.h"
+#include "point.h"
+#include "rng.h"
+#include "scent_map.h"
+#include "shadowcasting.h"
+#include "type_id.h"
+
+// Micro-benchmarks of the engine primitives that dominate a turn.  Hidden, run them with
+//   cata_test "[benchmark]" --benchmark-json benchmark.json
+// or "make benchmark" in tests/, which keeps the results for comparing runs.
+
+static const itype_id itype_neccowafers( "neccowafers" );
+static const itype_id itype_test_backpack( "test_backpack" );
+static const itype_id itype_test_sonic_screwdriver( "test_sonic_screwdriver" );
+
+static const quality_id qual_DRILL( "DRILL" );
+static const quality_id qual_PRY( "PRY" );
+
+static const ter_str_id ter_t_brick_wall( "t_brick_wall" );
+
+TEST_CASE( "map_route_benchmark", "[.][benchmark][pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    // A wall with a single gap, so the search has to look around.
+    for( int y = 20; y <= 100; ++y ) {
+        if( y != 90 ) {
+            here.ter_set( tripoint_bub_ms( 60, y, 0 ), ter_t_brick_wall );
+        }
+    }
+    const pathfinding_settings settings( 0, 100, 400, 0, false, false, false, false, false, false );
+    const tripoint from( 30, 40, 0 );
+    const tripoint to( 90, 40, 0 );
+    REQUIRE_FALSE( here.route( from, to, settings ).empty() );
+
+    BENCHMARK( "map::route around a wall" ) {
+        return here.route( from, to, settings );
+    };
+    BENCHMARK( "map::route over open ground" ) {
+        return here.route( from, tripoint( 50, 100, 0 ), settings );
+    };
+}
+
+TEST_CASE( "shadowcasting_benchmark", "[.][benchmark][shadowcasting][nogame]" )
+{
+    struct grids {
+        cata::mdarray<float, point_bub_ms> transparency;
+        cata::mdarray<float, point_bub_ms> seen;
+        cata::mdarray<bool, point_bub_ms> floor;
+    };
+    std::unique_ptr<grids> g = std::make_unique<grids>();
+    // A fixed scattering of opaque tiles, one in ten.
+    rng_set_engine_seed( 1 );
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            g->transparency[x][y] = one_in( 10 ) ? LIGHT_TRANSPARENCY_SOLID :
+                                    LIGHT_TRANSPARENCY_OPEN_AIR;
+            g->floor[x][y] = true;
+        }
+    }
+    const tripoint_bub_ms origin( 65, 65, 0 );
+
+    BENCHMARK( "castLightAll" ) {
+        castLightAll<float, float, sight_calc, sight_check, update_light, accumulate_transparency>(
+            g->seen, g->transparency, origin.xy() );
+        return g->seen[origin.x()][origin.y()];
+    };
+
+    array_of_grids_of<const float> transparency_caches;
+    array_of_grids_of<float> seen_caches;
+    array_of_grids_of<const bool> floor_caches;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        transparency_caches[z + OVERMAP_DEPTH] = &g->transparency;
+        seen_caches[z + OVERMAP_DEPTH] = &g->seen;
+        floor_caches[z + OVERMAP_DEPTH] = &g->floor;
+    }
+    BENCHMARK( "cast_zlight" ) {
+        cast_zlight<float, sight_calc, sight_check, accumulate_transparency>(
+            seen_caches, transparency_caches, floor_caches, origin, 0, 1.0 );
+        return g->seen[origin.x()][origin.y()];
+    };
+}
+
+TEST_CASE( "scent_map_update_benchmark", "[.][benchmark][scent]" )
+{
+    clear_map();
+    clear_avatar();
+    map &here = get_map();
+    scent_map &scent = get_scent();
+    const tripoint center = get_avatar().pos();
+    scent.reset();
+
+    BENCHMARK( "scent_map::update" ) {
+        scent.update( center, here );
+        return scent.get( center );
+    };
+}
+
+TEST_CASE( "build_map_cache_benchmark", "[.][benchmark][map]" )
+{
+    clear_map();
+    map &here = get_map();
+    here.build_map_cache( 0 );
+
+    BENCHMARK( "map::build_map_cache, nothing changed" ) {
+        here.build_map_cache( 0 );
+    };
+    BENCHMARK( "map::build_map_cache, all dirty" ) {
+        here.set_transparency_cache_dirty( 0 );
+        here.set_seen_cache_dirty( 0 );
+        here.set_outside_cache_dirty( 0 );
+        here.set_floor_cache_dirty( 0 );
+        here.build_map_cache( 0 );
+    };
+}
+
+TEST_CASE( "item_benchmark", "[.][benchmark][item]" )
+{
+    item backpack( itype_test_backpack );
+    REQUIRE( backpack.put_in( item( itype_test_sonic_screwdriver ),
+                              pocket_type::CONTAINER ).success() );
+    const item wafers( itype_neccowafers );
+    const item other_wafers( itype_neccowafers );
+
+    BENCHMARK( "item::tname" ) {
+        return wafers.tname();
+    };
+    BENCHMARK( "item::tname of a container" ) {
+        return backpack.tname();
+    };
+    BENCHMARK( "item::stacks_with" ) {
+        return static_cast<bool>( wafers.stacks_with( other_wafers ) );
+    };
+    BENCHMARK( "visitable::has_quality, found" ) {
+        return backpack.has_quality( qual_PRY, 2 );
+    };
+    BENCHMARK( "visitable::has_quality, missing" ) {
+        return backpack.has_quality( qual_DRILL, 1 );
+    };
+}
+
+TEST_CASE( "json_benchmark", "[.][benchmark][json][nogame]" )
+{
+    const auto write_document = []() {
+        std::ostringstream out;
+        JsonOut jsout( out );
+        jsout.start_array();
+        for( int i = 0; i < 1000; ++i ) {
+            jsout.start_object();
+            jsout.member( "id", "object_" + std::to_string( i ) );
+            jsout.member( "count", i );
+            jsout.member( "weight", i * 0.25 );
+            jsout.member( "active", i % 2 == 0 );
+            jsout.member( "position", std::array<int, 3> { { i, -i, 0 } } );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        return out.str();
+    };
+    const std::string document = write_document();
+
+    BENCHMARK( "JsonOut writes" ) {
+        return write_document();
+    };
+    BENCHMARK( "flexbuffer parsing" ) {
+        int total = 0;
+        for( const JsonValue jv : json_loader::from_string( document ).get_array() ) {
+            JsonObject jo = jv.get_object();
+            jo.allow_omitted_members();
+            total += jo.get_int( "count" );
+        }
+        return total;
+    };
+}
+
+TEST_CASE( "creature_tracker_benchmark", "[.][benchmark][creature_tracker]" )
+{
+    clear_map();
+    clear_avatar();
+    creature_tracker &tracker = get_creature_tracker();
+    const tripoint_bub_ms origin = get_avatar().pos_bub();
+    std::vector<tripoint_bub_ms> occupied;
+    for( int i = 0; i < 50; ++i ) {
+        const tripoint_bub_ms pos = origin + tripoint( 2 + i % 10, 2 + i / 10, 0 );
+        spawn_test_monster( "mon_zombie", pos );
+        occupied.push_back( pos );
+    }
+
+    BENCHMARK( "creature_tracker::creature_at, hits" ) {
+        int found = 0;
+        for( const tripoint_bub_ms &pos : occupied ) {
+            found += tracker.creature_at<monster>( pos ) != nullptr;
+        }
+        return found;
+    };
+    BENCHMARK( "creature_tracker::creature_at, misses" ) {
+        int found = 0;
+        for( const tripoint_bub_ms &pos : occupied ) {
+            found += tracker.creature_at<monster>( pos + tripoint( 0, 20, 0 ) ) != nullptr;
+        }
+        return found;
+    };
+}
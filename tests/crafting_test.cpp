@@ -2397,3 +2397,38 @@ TEST_CASE( "pseudo_tools_in_crafting_inventory", "[crafting][tools]" )
         clear_map();
     }
 }
+
+TEST_CASE( "crafting_inventory_stacks_map_items_by_type", "[crafting][inventory]" )
+{
+    clear_map();
+    clear_avatar();
+    map &here = get_map();
+    avatar &player = get_avatar();
+    player.setpos( tripoint_bub_ms( 60, 60, 0 ) );
+    player.i_add( item( itype_hammer ) );
+
+    // Interleave the types so every tile holds more than one stack.
+    int placed = 0;
+    for( const tripoint_bub_ms &p : here.points_in_radius( player.pos_bub(), 2 ) ) {
+        here.add_item( p, item( itype_hammer ) );
+        here.add_item( p, item( itype_chisel ) );
+        here.add_item( p, item( itype_hacksaw ) );
+        placed++;
+    }
+
+    player.invalidate_crafting_inventory();
+    const inventory &crafting_inv = player.crafting_inventory();
+    CHECK( crafting_inv.count_item( itype_hammer ) == placed + 1 );
+    CHECK( crafting_inv.count_item( itype_chisel ) == placed );
+    CHECK( crafting_inv.count_item( itype_hacksaw ) == placed );
+    CHECK( crafting_inv.const_stack( crafting_inv.position_by_type( itype_chisel ) ).size() ==
+           static_cast<size_t>( placed ) );
+
+    // A copy has to find the stacks of the original without borrowing its index.
+    inventory copy = crafting_inv;
+    copy.add_item( item( itype_chisel ) );
+    CHECK( copy.size() == crafting_inv.size() );
+    CHECK( copy.count_item( itype_chisel ) == placed + 1 );
+
+    clear_map();
+}
@@ -0,0 +1,145 @@
+#include <algorithm>
+#include <vector>
+
+#include "avatar.h"
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "creature.h"
+#include "creature_tracker.h"
+#include "game.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "monster.h"
+#include "player_helpers.h"
+#include "point.h"
+
+static bool contains( const std::vector<Creature *> &critters, const Creature &critter )
+{
+    return std::find( critters.begin(), critters.end(), &critter ) != critters.end();
+}
+
+TEST_CASE( "creature_tracker_range_queries", "[creature_tracker][monster]" )
+{
+    clear_map();
+    clear_avatar();
+    creature_tracker &tracker = get_creature_tracker();
+    const avatar &you = get_avatar();
+    const tripoint_bub_ms origin = you.pos_bub();
+
+    monster &near = spawn_test_monster( "mon_zombie", origin + tripoint( 3, 0, 0 ) );
+    monster &far = spawn_test_monster( "mon_zombie", origin + tripoint( 40, 0, 0 ) );
+
+    std::vector<Creature *> found = tracker.creatures_in_radius( you.get_location(), 10 );
+    CHECK( contains( found, you ) );
+    CHECK( contains( found, near ) );
+    CHECK_FALSE( contains( found, far ) );
+
+    SECTION( "moving across submaps updates the index" ) {
+        far.setpos( origin + tripoint( -5, 2, 0 ) );
+        near.setpos( origin + tripoint( 30, 0, 0 ) );
+        found = tracker.creatures_in_radius( you.get_location(), 10 );
+        CHECK( contains( found, far ) );
+        CHECK_FALSE( contains( found, near ) );
+    }
+
+    SECTION( "box bounds are inclusive" ) {
+        const tripoint_abs_ms corner = near.get_location();
+        found = tracker.creatures_in_box( corner, corner );
+        REQUIRE( found.size() == 1 );
+        CHECK( found.front() == &near );
+    }
+
+    SECTION( "removed monsters are not returned" ) {
+        g->remove_zombie( near );
+        found = tracker.creatures_in_box( you.get_location() - tripoint( 60, 60, 0 ),
+                                          you.get_location() + tripoint( 60, 60, 0 ) );
+        CHECK_FALSE( contains( found, near ) );
+        CHECK( contains( found, far ) );
+    }
+}
+
+TEST_CASE( "creature_tracker_faction_revision_follows_the_population", "[creature_tracker][monster]" )
+{
+    clear_map();
+    clear_avatar();
+    creature_tracker &tracker = get_creature_tracker();
+    const tripoint_bub_ms origin = get_avatar().pos_bub();
+
+    const int empty_revision = tracker.get_faction_revision();
+    monster &zombie = spawn_test_monster( "mon_zombie", origin + tripoint( 3, 0, 0 ) );
+    const int populated_revision = tracker.get_faction_revision();
+    CHECK( populated_revision != empty_revision );
+
+    zombie.setpos( origin + tripoint( 20, 0, 0 ) );
+    CHECK( tracker.get_faction_revision() == populated_revision );
+
+    g->remove_zombie( zombie );
+    CHECK( tracker.get_faction_revision() != populated_revision );
+}
+
+TEST_CASE( "creature_tracker_drops_every_dead_monster_at_once", "[creature_tracker][monster]" )
+{
+    clear_map();
+    clear_avatar();
+    creature_tracker &tracker = get_creature_tracker();
+    const tripoint_bub_ms origin = get_avatar().pos_bub();
+
+    std::vector<monster *> survivors;
+    std::vector<tripoint_abs_ms> dead_locations;
+    for( int i = 0; i < 10; i++ ) {
+        monster &zombie = spawn_test_monster( "mon_zombie", origin + tripoint( 3 + i, 2, 0 ) );
+        if( i % 2 == 0 ) {
+            zombie.set_hp( 0 );
+            dead_locations.push_back( zombie.get_location() );
+        } else {
+            survivors.push_back( &zombie );
+        }
+    }
+    const int revision = tracker.get_faction_revision();
+    g->cleanup_dead();
+
+    std::vector<monster *> remaining;
+    for( const shared_ptr_fast<monster> &mon_ptr : tracker.get_monsters_list() ) {
+        remaining.push_back( mon_ptr.get() );
+    }
+    // Survivors keep their order.
+    CHECK( remaining == survivors );
+    for( const tripoint_abs_ms &loc : dead_locations ) {
+        CHECK( tracker.creature_at<monster>( loc ) == nullptr );
+    }
+    CHECK( tracker.get_faction_revision() != revision );
+}
+
+TEST_CASE( "mon_info_update_follows_monsters_within_a_turn", "[creature_tracker][monster]" )
+{
+    clear_map();
+    clear_avatar();
+    set_time_to_day();
+    avatar &you = get_avatar();
+    const tripoint_bub_ms origin = you.pos_bub();
+    const monster_visible_info &visible = you.get_mon_visible();
+    // Directions as in monster_visible_info.
+    const int north = 0;
+    const int south = 4;
+
+    monster &zombie = spawn_test_monster( "mon_zombie", origin + tripoint( 0, -15, 0 ) );
+    g->mon_info_update();
+    REQUIRE( you.sees( zombie ) );
+    CHECK( visible.unique_mons[north].size() == 1 );
+    CHECK( visible.unique_mons[south].empty() );
+
+    // Asking again without anything changing gives the same answer.
+    g->mon_info_update();
+    CHECK( visible.unique_mons[north].size() == 1 );
+
+    const int revision = get_creature_tracker().get_location_revision();
+    zombie.setpos( origin + tripoint( 0, 15, 0 ) );
+    CHECK( get_creature_tracker().get_location_revision() != revision );
+    g->mon_info_update();
+    CHECK( visible.unique_mons[north].empty() );
+    CHECK( visible.unique_mons[south].size() == 1 );
+
+    g->remove_zombie( zombie );
+    g->mon_info_update();
+    CHECK( visible.unique_mons[south].empty() );
+}
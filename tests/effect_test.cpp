@@ -786,3 +786,28 @@ TEST_CASE( "Death_Effects", "[effect][death]" )
     test_deadliness( deadly_effect, 50, 25 );
     test_deadliness( fatal_effect, 100, 0 );
 }
+
+TEST_CASE( "monster_effects_all_decay_each_turn", "[effect][monster]" )
+{
+    clear_map();
+    clear_creatures();
+    monster &mon = spawn_test_monster( "mon_zombie", tripoint_bub_ms( 20, 20, 0 ) );
+    const std::vector<efftype_id> applied = { effect_debugged, effect_intensified, effect_max_effected };
+
+    std::vector<time_duration> initial;
+    for( const efftype_id &id : applied ) {
+        mon.add_effect( id, 10_turns );
+        initial.push_back( mon.get_effect_dur( id ) );
+    }
+    REQUIRE_FALSE( mon.get_effect( effect_debugged ).can_kill() );
+
+    for( int i = 0; i < 3; ++i ) {
+        calendar::turn += 1_turns;
+        mon.process_effects();
+    }
+
+    for( size_t i = 0; i < applied.size(); ++i ) {
+        CAPTURE( applied[i].str() );
+        CHECK( mon.get_effect_dur( applied[i] ) == initial[i] - 3_turns );
+    }
+}
@@ -7,6 +7,7 @@
 #include "item_location.h"
 #include "game.h"
 #include "map.h"
+#include "magic_enchantment.h"
 #include "map_helpers.h"
 #include "monster.h"
 #include "npc.h"
@@ -388,3 +389,27 @@ TEST_CASE( "Enchantment_PAIN_PENALTY_MOD_test", "[magic][enchantments]" )
     REQUIRE( guy.get_per() == 1 );
     REQUIRE( guy.get_speed() == 89 );
 }
+
+TEST_CASE( "enchant_cache_sums_values_per_mod", "[magic][enchantments]" )
+{
+    enchant_cache first;
+    first.add_value_add( enchant_vals::mod::SPEED, 10 );
+    first.add_value_mult( enchant_vals::mod::MAX_HP, 0.25f );
+    enchant_cache second;
+    second.add_value_add( enchant_vals::mod::SPEED, -4 );
+    second.add_value_add( enchant_vals::mod::STRENGTH, 2 );
+
+    enchant_cache total;
+    total.force_add( first );
+    total.force_add( second );
+    CHECK( total.get_value_add( enchant_vals::mod::SPEED ) == 6 );
+    CHECK( total.get_value_add( enchant_vals::mod::STRENGTH ) == 2 );
+    CHECK( total.get_value_multiply( enchant_vals::mod::MAX_HP ) == Approx( 0.25 ) );
+    // Mods nothing touched read as no change
+    CHECK( total.get_value_add( enchant_vals::mod::DEXTERITY ) == 0 );
+    CHECK( total.get_value_multiply( enchant_vals::mod::SPEED ) == 0 );
+
+    total.clear();
+    CHECK( total.get_value_add( enchant_vals::mod::SPEED ) == 0 );
+    CHECK( total == enchant_cache() );
+}
@@ -174,3 +174,31 @@ TEST_CASE( "tiny_character", "[encumbrance]" )
         test_encumbrance_items( { i }, "torso", longshirt_e, add_trait( "SMALL2" ) );
     }
 }
+
+TEST_CASE( "clothing_warmth_follows_worn_items", "[encumbrance][warmth]" )
+{
+    Character &p = get_player_character();
+    p.set_body();
+    p.clear_mutations();
+    p.clear_worn();
+    p.set_all_parts_wetness( 0 );
+    const bodypart_id torso( "torso" );
+    CHECK( p.worn.warmth( p ).at( torso ) == 0 );
+
+    const item shirt( "test_longshirt" );
+    const item jacket( "test_jacket_jean" );
+    p.worn.wear_item( p, shirt, false, false, false );
+    CHECK( p.worn.warmth( p ).at( torso ) == shirt.get_warmth( torso ) );
+    p.worn.wear_item( p, jacket, false, false, false );
+    const int dry_warmth = shirt.get_warmth( torso ) + jacket.get_warmth( torso );
+    CHECK( p.worn.warmth( p ).at( torso ) == dry_warmth );
+
+    // Wetness is applied on every query, not when the worn items change.
+    p.set_part_wetness( torso, p.get_part_drench_capacity( torso ) );
+    CHECK( p.worn.warmth( p ).at( torso ) <= dry_warmth );
+    p.set_all_parts_wetness( 0 );
+    CHECK( p.worn.warmth( p ).at( torso ) == dry_warmth );
+
+    p.clear_worn();
+    CHECK( p.worn.warmth( p ).at( torso ) == 0 );
+}
@@ -2,9 +2,11 @@
 #include "calendar.h"
 #include "cata_catch.h"
 #include "character_martial_arts.h"
+#include "condition.h"
 #include "coordinates.h"
 #include "effect_on_condition.h"
 #include "game.h"
+#include "json_loader.h"
 #include "make_static.h"
 #include "map_helpers.h"
 #include "mutation.h"
@@ -1500,3 +1502,24 @@ TEST_CASE( "EOC_run_eocs", "[eoc]" )
     CHECK( effect_on_condition_run_eocs_talker_mixes_loc->activate( d2 ) );
     CHECK( globvars.get_global_value( "npctalk_var_alpha_name" ) == zombie->get_name() );
 }
+
+TEST_CASE( "conditions_keep_their_meaning_when_merged_and_reordered", "[eoc]" )
+{
+    clear_avatar();
+    avatar &u = get_avatar();
+    u.toggle_trait( trait_process_mutation );
+    dialogue d( get_talker_for( u ), nullptr );
+    const auto holds = [&d]( const std::string & json ) {
+        return conditional_t( json_loader::from_string( json ) )( d );
+    };
+
+    CHECK( holds( R"({ "and": [] })" ) );
+    CHECK_FALSE( holds( R"({ "or": [] })" ) );
+    CHECK( holds( R"({ "and": [ { "and": [ "u_is_avatar", { "u_has_trait": "process_mutation" } ] }, "u_is_alive" ] })" ) );
+    CHECK_FALSE( holds( R"({ "and": [ { "and": [ "u_is_avatar", { "u_has_trait": "process_mutation_two" } ] }, "u_is_alive" ] })" ) );
+    CHECK_FALSE( holds( R"({ "or": [ { "or": [ "u_is_npc", { "u_has_trait": "process_mutation_two" } ] }, { "not": "u_is_alive" } ] })" ) );
+    CHECK( holds( R"({ "or": [ { "or": [ "u_is_npc", { "u_has_trait": "process_mutation_two" } ] }, { "not": "u_is_npc" } ] })" ) );
+    CHECK( holds( R"({ "not": { "not": { "u_has_trait": "process_mutation" } } })" ) );
+    CHECK_FALSE( holds( R"({ "not": { "not": { "not": { "u_has_trait": "process_mutation" } } } })" ) );
+    CHECK_FALSE( holds( R"({ "and": [ { "or": [ "u_is_npc", { "u_has_trait": "process_mutation_two" } ] }, "u_is_avatar" ] })" ) );
+}
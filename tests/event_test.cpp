@@ -80,6 +80,34 @@ TEST_CASE( "destroy_bus_before_subscriber", "[event]" )
     CHECK( sub.events.size() == 1 );
 }
 
+struct kills_subscriber : public test_subscriber {
+    bool wants( const event_type type ) const override {
+        return type == event_type::character_kills_monster;
+    }
+};
+
+TEST_CASE( "bus_sends_only_wanted_event_types", "[event]" )
+{
+    event_bus bus;
+    test_subscriber all;
+    kills_subscriber kills;
+    bus.subscribe( &all );
+    bus.subscribe( &kills );
+
+    bus.send( cata::event::make<event_type::character_kills_monster>(
+                  character_id( 5 ), zombie, 0 ) );
+    bus.send( cata::event::make<event_type::game_start>( "VERSION" ) );
+    CHECK( all.events.size() == 2 );
+    REQUIRE( kills.events.size() == 1 );
+    CHECK( kills.events[0].type() == event_type::character_kills_monster );
+
+    bus.unsubscribe( &kills );
+    bus.send( cata::event::make<event_type::character_kills_monster>(
+                  character_id( 5 ), zombie, 0 ) );
+    CHECK( all.events.size() == 3 );
+    CHECK( kills.events.size() == 1 );
+}
+
 struct expect_subscriber : public event_subscriber {
     using event_subscriber::notify;
     void notify( const cata::event & ) override {
@@ -159,3 +159,32 @@ TEST_CASE( "faction_price_rules", "[npc][factions][trade]" )
                  .margin( 1 ) );
     }
 }
+
+TEST_CASE( "trade_price_cache_prices_like_trading_price", "[npc][factions][trade]" )
+{
+    clear_avatar();
+    npc &guy = spawn_npc( { 50, 50 }, "test_npc_trader" );
+    clear_character( guy );
+    avatar &u = get_avatar();
+
+    item backpack( "debug_backpack" );
+    item const hammer( "hammer" );
+    item const fmcnote( "FMCNote" );
+    backpack.put_in( hammer, pocket_type::CONTAINER );
+    backpack.put_in( fmcnote, pocket_type::CONTAINER );
+    trade_selector::entry_t const entry{
+        item_location{ map_cursor( tripoint_bub_ms( tripoint_zero ) ), &backpack }, 1 };
+
+    trade_price_cache cache;
+    CHECK( cache.price_rules( guy, hammer ) == guy.get_price_rules( hammer ) );
+    CHECK( cache.price_rules( guy, fmcnote ) == guy.get_price_rules( fmcnote ) );
+    for( bool const u_buy : { true, false } ) {
+        CAPTURE( u_buy );
+        Character const &buyer = u_buy ? static_cast<Character const &>( u ) : guy;
+        Character const &seller = u_buy ? static_cast<Character const &>( guy ) : u;
+        int const price = npc_trading::trading_price( buyer, seller, entry );
+        CHECK( cache.trading_price( buyer, seller, entry ) == price );
+        // Again, from the cache
+        CHECK( cache.trading_price( buyer, seller, entry ) == price );
+    }
+}
@@ -1,9 +1,12 @@
+#include <algorithm>
+#include <cstdlib>
 #include <iosfwd>
 #include <vector>
 
 #include "avatar.h"
 #include "calendar.h"
 #include "cata_catch.h"
+#include "coordinates.h"
 #include "effect.h"
 #include "field.h"
 #include "field_type.h"
@@ -11,10 +14,12 @@
 #include "map.h"
 #include "map_helpers.h"
 #include "map_iterator.h"
+#include "mapbuffer.h"
 #include "mapdata.h"
 #include "options_helpers.h"
 #include "player_helpers.h"
 #include "point.h"
+#include "submap.h"
 #include "type_id.h"
 #include "weather.h"
 
@@ -85,6 +90,36 @@ static void test_field_expiry( const std::string &field_type_str )
     CHECK( alive == Approx( decayed ).epsilon( 0.1f ) );
 }
 
+TEST_CASE( "field_processing_tracks_the_tiles_holding_fields", "[field]" )
+{
+    clear_map();
+    map &m = get_map();
+    const tripoint_bub_ms acid_loc{ 35, 37, 0 };
+    const submap *sm = MAPBUFFER.lookup_submap( project_to<coords::sm>( m.getglobal( acid_loc ) ) );
+    REQUIRE( sm != nullptr );
+    CHECK( sm->field_tiles.none() );
+
+    m.add_field( acid_loc, field_fd_acid, 1 );
+    // x * SEEY + y within the submap.
+    CHECK( sm->field_tiles.count() == 1 );
+    CHECK( sm->field_tiles.test( ( 35 % SEEX ) * SEEY + 37 % SEEY ) );
+    std::vector<point_sm_ms> visited;
+    sm->for_each_field( [&visited]( const point_sm_ms & p, const field & ) {
+        visited.push_back( p );
+    } );
+    CHECK( visited == std::vector<point_sm_ms> { point_sm_ms( 35 % SEEX, 37 % SEEY ) } );
+    CHECK( m.has_field_at( acid_loc ) );
+    CHECK_FALSE( m.has_field_at( acid_loc + tripoint_rel_ms( 0, -1, 0 ) ) );
+
+    m.remove_field( acid_loc, field_fd_acid );
+    for( int i = 0; i < 2; ++i ) {
+        m.process_fields();
+        calendar::turn += 1_seconds;
+    }
+    CHECK( sm->field_count == 0 );
+    CHECK( sm->field_tiles.none() );
+}
+
 TEST_CASE( "field_expiry", "[field]" )
 {
     // Test fields with a wide range of half lives.
@@ -350,6 +385,39 @@ TEST_CASE( "wandering_field_test", "[field]" )
     fields_test_cleanup();
 }
 
+TEST_CASE( "deferred_gas_spread_moves_gas_a_tile_per_turn", "[field]" )
+{
+    fields_test_setup();
+    override_option deferred( "DEFERRED_GAS_SPREAD", "true" );
+    scoped_weather_override weather_clear( WEATHER_CLEAR );
+    weather_clear.with_windspeed( 0 );
+    map &m = get_map();
+
+    // Thick smoke across a submap border, before processing it could spread again from every
+    // tile it reached.
+    const int y = 66;
+    const int min_x = 54;
+    const int max_x = 65;
+    for( int x = min_x; x <= max_x; ++x ) {
+        m.add_field( tripoint_bub_ms( x, y, 0 ), fd_smoke, 3, 1_seconds );
+    }
+
+    for( int turn = 1; turn <= 3; ++turn ) {
+        calendar::turn += 1_turns;
+        m.process_fields();
+        for( const tripoint_bub_ms &p : m.points_on_zlevel() ) {
+            if( !m.get_field( p, fd_smoke ) ) {
+                continue;
+            }
+            CAPTURE( turn, p );
+            const int dx = std::max( { 0, min_x - p.x(), p.x() - max_x } );
+            CHECK( std::max( dx, std::abs( p.y() - y ) ) <= turn );
+        }
+    }
+
+    fields_test_cleanup();
+}
+
 TEST_CASE( "radioactive_field", "[field]" )
 {
     fields_test_setup();
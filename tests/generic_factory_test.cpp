@@ -9,7 +9,10 @@
 #include "cata_catch.h"
 #include "colony_list_test_helpers.h"
 #include "flat_set.h"
+#include "flexbuffer_json.h"
 #include "generic_factory.h"
+#include "json_loader.h"
+#include "options_helpers.h"
 #include "type_id.h"
 
 #ifdef _MSC_VER
@@ -29,6 +32,23 @@ struct test_obj {
     std::string value;
 };
 
+struct lazy_test_obj;
+
+using lazy_test_obj_id = string_id<lazy_test_obj>;
+
+int lazy_test_obj_loads = 0;
+
+struct lazy_test_obj {
+    lazy_test_obj_id id;
+    std::string value;
+    bool was_loaded = false;
+
+    void load( const JsonObject &jo, std::string_view ) {
+        mandatory( jo, was_loaded, "value", value );
+        ++lazy_test_obj_loads;
+    }
+};
+
 } // namespace
 
 static const test_obj_id test_obj_id_0( "id_0" );
@@ -158,6 +178,85 @@ TEST_CASE( "generic_factory_version_wrapper", "[generic_factory]" )
     CHECK_FALSE( test_factory.is_valid( v2 ) );
 }
 
+TEST_CASE( "generic_factory_finds_ids_after_finalize", "[generic_factory]" )
+{
+    generic_factory<test_obj> test_factory( "test_factory" );
+    constexpr int num_ids = 100;
+    for( int i = 0; i < num_ids; ++i ) {
+        test_factory.insert( { test_obj_id( "finalized_" + std::to_string( i ) ), std::to_string( i ) } );
+    }
+    test_factory.finalize();
+
+    for( int i = 0; i < num_ids; ++i ) {
+        const test_obj_id id( "finalized_" + std::to_string( i ) );
+        REQUIRE( test_factory.is_valid( id ) );
+        CHECK( test_factory.obj( id ).value == std::to_string( i ) );
+    }
+    CHECK_FALSE( test_factory.is_valid( test_obj_id( "finalized_missing" ) ) );
+
+    // Inserting after finalization falls back to the map until the next finalize.
+    test_factory.insert( { test_obj_id( "inserted_late" ), "late" } );
+    CHECK( test_factory.obj( test_obj_id( "inserted_late" ) ).value == "late" );
+    CHECK( test_factory.obj( test_obj_id( "finalized_7" ) ).value == "7" );
+}
+
+TEST_CASE( "generic_factory_loads_lazily_on_first_access", "[generic_factory]" )
+{
+    override_option lazy( "LAZY_DATA_LOADING", "true" );
+    override_option skip( "SKIP_VERIFICATION", "true" );
+    const lazy_test_obj_id id_a( "lazy_a" );
+    const lazy_test_obj_id id_b( "lazy_b" );
+    generic_factory<lazy_test_obj> test_factory( "lazy test object" );
+    lazy_test_obj_loads = 0;
+
+    test_factory.load_lazily( json_loader::from_string(
+                                  R"({ "id": "lazy_a", "value": "first" })" ).get_object(), "dda" );
+    test_factory.load_lazily( json_loader::from_string(
+                                  R"({ "id": "lazy_b", "value": "b" })" ).get_object(), "dda" );
+    // A mod replacing the object only replaces the recorded JSON.
+    test_factory.load_lazily( json_loader::from_string(
+                                  R"({ "id": "lazy_a", "value": "second" })" ).get_object(), "mod" );
+    CHECK( lazy_test_obj_loads == 0 );
+    CHECK( test_factory.is_valid( id_a ) );
+    CHECK( test_factory.size() == 2 );
+
+    CHECK( test_factory.obj( id_a ).value == "second" );
+    CHECK( lazy_test_obj_loads == 1 );
+    CHECK( test_factory.obj( id_a ).value == "second" );
+    CHECK( lazy_test_obj_loads == 1 );
+
+    CHECK( test_factory.get_all().size() == 2 );
+    CHECK( lazy_test_obj_loads == 2 );
+    CHECK( test_factory.obj( id_b ).value == "b" );
+}
+
+TEST_CASE( "int_id_map_is_indexed_by_the_id", "[generic_factory][int_id]" )
+{
+    using test_obj_int_id = int_id<test_obj>;
+    int_id_map<test_obj, std::string> map;
+    CHECK( map.find( test_obj_int_id( 3 ) ) == nullptr );
+
+    map.reserve( 4 );
+    CHECK_FALSE( map.contains( test_obj_int_id( 3 ) ) );
+    map[test_obj_int_id( 3 )] = "three";
+    // Past the reserved size grows the map.
+    map[test_obj_int_id( 10 )] = "ten";
+    CHECK( map[test_obj_int_id( 5 )].empty() );
+
+    REQUIRE( map.find( test_obj_int_id( 3 ) ) != nullptr );
+    CHECK( *map.find( test_obj_int_id( 3 ) ) == "three" );
+    CHECK( *map.find( test_obj_int_id( 10 ) ) == "ten" );
+    CHECK( map.contains( test_obj_int_id( 5 ) ) );
+    CHECK_FALSE( map.contains( test_obj_int_id( 4 ) ) );
+    CHECK_FALSE( map.contains( test_obj_int_id( 11 ) ) );
+
+    map.erase( test_obj_int_id( 3 ) );
+    map.erase( test_obj_int_id( 42 ) );
+    CHECK_FALSE( map.contains( test_obj_int_id( 3 ) ) );
+    map.clear();
+    CHECK_FALSE( map.contains( test_obj_int_id( 10 ) ) );
+}
+
 TEST_CASE( "string_ids_comparison", "[generic_factory][string_id]" )
 {
     //  checks equality correctness for the following combinations of parameters:
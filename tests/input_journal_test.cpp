@@ -0,0 +1,92 @@
+#include "cata_catch.h"
+
+#include <optional>
+#include <set>
+#include <sstream>
+#include <string>
+
+#include "calendar.h"
+#include "input_context.h"
+#include "input_enums.h"
+#include "input_journal.h"
+#include "json.h"
+#include "json_loader.h"
+#include "turn_profiler.h"
+
+static input_journal::journal two_key_journal()
+{
+    input_journal::journal j;
+    j.seed = 1234;
+    input_journal::entry ctrl_a;
+    ctrl_a.turn = 10;
+    ctrl_a.context = "TEST";
+    ctrl_a.action = "ANY_INPUT";
+    ctrl_a.event = input_event( std::set<keymod_t>( { keymod_t::ctrl } ), 'a',
+                                input_event_t::keyboard_code );
+    input_journal::entry click;
+    click.turn = 11;
+    click.context = "TEST";
+    click.action = "SELECT";
+    click.event = input_event( MouseInput::LeftButtonReleased, input_event_t::mouse );
+    click.event.mouse_pos = point( 3, 4 );
+    j.entries = { ctrl_a, click };
+    return j;
+}
+
+TEST_CASE( "input_journal_survives_save_and_load", "[input_journal]" )
+{
+    const input_journal::journal j = two_key_journal();
+    std::ostringstream os;
+    JsonOut jsout( os );
+    j.serialize( jsout );
+    input_journal::journal loaded;
+    loaded.deserialize( json_loader::from_string( os.str() ) );
+
+    CHECK( loaded.seed == j.seed );
+    REQUIRE( loaded.entries.size() == j.entries.size() );
+    for( size_t i = 0; i < j.entries.size(); ++i ) {
+        CAPTURE( i );
+        CHECK( loaded.entries[i].turn == j.entries[i].turn );
+        CHECK( loaded.entries[i].context == j.entries[i].context );
+        CHECK( loaded.entries[i].action == j.entries[i].action );
+        CHECK( loaded.entries[i].event == j.entries[i].event );
+        CHECK( loaded.entries[i].event.mouse_pos == j.entries[i].event.mouse_pos );
+    }
+}
+
+TEST_CASE( "input_journal_records_only_while_recording", "[input_journal]" )
+{
+    const input_event key( 'x', input_event_t::keyboard_char );
+    input_journal::record( key, "TEST", "ANY_INPUT" );
+
+    input_journal::start_recording();
+    CHECK( input_journal::is_recording() );
+    input_journal::record( key, "TEST", "ANY_INPUT" );
+    const input_journal::journal j = input_journal::stop_recording();
+    CHECK_FALSE( input_journal::is_recording() );
+    input_journal::record( key, "TEST", "ANY_INPUT" );
+
+    CHECK( j.seed != 0 );
+    REQUIRE( j.entries.size() == 1 );
+    CHECK( j.entries[0].turn == to_turns<int64_t>( calendar::turn - calendar::turn_zero ) );
+    CHECK( j.entries[0].event == key );
+}
+
+TEST_CASE( "input_journal_replays_through_input_contexts", "[input_journal]" )
+{
+    const input_journal::journal j = two_key_journal();
+    input_context ctxt( "TEST" );
+    ctxt.register_action( "ANY_INPUT" );
+
+    input_journal::start_replay( j );
+    CHECK( input_journal::is_replaying() );
+    CHECK( turn_profiler::is_enabled() );
+    for( const input_journal::entry &e : j.entries ) {
+        ctxt.handle_input();
+        CHECK( ctxt.get_raw_input() == e.event );
+    }
+    // Asking for more ends the replay and the profiling.
+    CHECK( input_journal::next_replayed_event() == std::nullopt );
+    CHECK_FALSE( input_journal::is_replaying() );
+    CHECK_FALSE( turn_profiler::is_enabled() );
+}
@@ -1,3 +1,4 @@
+#include "auto_pickup.h"
 #include "avatar.h"
 #include "cata_catch.h"
 #include "item.h"
@@ -619,3 +620,33 @@ TEST_CASE( "auto_pickup_should_not_implicitly_pickup_corpses", "[autopickup][ite
         }
     }
 }
+
+TEST_CASE( "auto_pickup_material_rules_match_by_material", "[autopickup][item]" )
+{
+    const item lump( itype_steel_lump );
+    const item paper( itype_paper );
+    const auto compiled = []( const std::string & pattern ) {
+        return auto_pickup::compiled_rule( auto_pickup::rule( pattern, true, false ) );
+    };
+
+    CHECK( compiled( "m:steel" ).matches( "x", lump.made_of() ) );
+    CHECK( compiled( "M:paper,steel" ).matches( "x", lump.made_of() ) );
+    CHECK_FALSE( compiled( "m:steel" ).matches( "x", paper.made_of() ) );
+    CHECK_FALSE( compiled( "M:steel" ).matches( "x", paper.made_of() ) );
+    // Where materials are ignored, a material rule is only a pattern
+    CHECK_FALSE( compiled( "m:steel" ).matches( lump.tname( 1, false ) ) );
+    CHECK( compiled( "*" ).matches( lump.tname( 1, false ) ) );
+}
+
+TEST_CASE( "auto_pickup_rules_apply_to_items_no_rule_matched_before", "[autopickup][item]" )
+{
+    clear_everything();
+    item lump( itype_steel_lump );
+    const std::string name = lump.tname( 1, false );
+    auto_pickup::player_settings &rules = get_auto_pickup();
+
+    rules.create_rule( &lump, name );
+    CHECK( rules.check_item( name ) == rule_state::NONE );
+    // The cached miss must not hide the new rule
+    add_autopickup_rule( &lump, true );
+}
@@ -1,11 +1,16 @@
 #include <functional>
 #include <optional>
 #include <list>
+#include <sstream>
+#include <string>
+#include <vector>
 
 #include "cata_catch.h"
 #include "character.h"
 #include "item.h"
 #include "item_location.h"
+#include "json.h"
+#include "json_loader.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "map_selector.h"
@@ -71,6 +76,56 @@ TEST_CASE( "item_location_doesnt_return_stale_map_item", "[item][item_location]"
     CHECK( !item_loc );
 }
 
+static std::string serialized( const item_location &loc )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    loc.serialize( jsout );
+    return os.str();
+}
+
+TEST_CASE( "item_locations_of_one_square_save_and_load_together", "[item][item_location]" )
+{
+    clear_map();
+    map &m = get_map();
+    const tripoint_bub_ms pos( 60, 60, 0 );
+    m.i_clear( pos );
+    for( int i = 0; i < 6; ++i ) {
+        m.add_item( pos, item( i % 2 == 0 ? itype_jeans : itype_tshirt ) );
+    }
+    map_cursor cursor( pos );
+    std::vector<item_location> locations;
+    cursor.visit_items( [&]( item * it, item * ) {
+        locations.emplace_back( cursor, it );
+        return VisitResponse::NEXT;
+    } );
+    REQUIRE( locations.size() == 6 );
+
+    std::vector<std::string> saved;
+    for( const item_location &loc : locations ) {
+        saved.push_back( serialized( loc ) );
+    }
+    {
+        // The tables give the same indices as walking the square for each location.
+        const item_location::index_cache_scope item_indices;
+        for( size_t i = 0; i < locations.size(); ++i ) {
+            CAPTURE( i );
+            CHECK( serialized( locations[i] ) == saved[i] );
+        }
+    }
+
+    std::vector<item_location> loaded( saved.size() );
+    for( size_t i = 0; i < saved.size(); ++i ) {
+        loaded[i].deserialize( json_loader::from_string( saved[i] ) );
+    }
+    // The first lookup finds the items of all the others too.
+    for( size_t i = loaded.size(); i-- > 0; ) {
+        CAPTURE( i );
+        REQUIRE( loaded[i] );
+        CHECK( loaded[i].get_item() == locations[i].get_item() );
+    }
+}
+
 TEST_CASE( "item_in_container", "[item][item_location]" )
 {
     Character &dummy = get_player_character();
@@ -5,6 +5,7 @@
 #include <initializer_list>
 #include <limits>
 #include <memory>
+#include <sstream>
 #include <vector>
 
 #include "avatar.h"
@@ -16,6 +17,8 @@
 #include "item_category.h"
 #include "item_factory.h"
 #include "itype.h"
+#include "json.h"
+#include "json_loader.h"
 #include "math_defines.h"
 #include "monstergenerator.h"
 #include "mtype.h"
@@ -327,6 +330,42 @@ TEST_CASE( "item_variables_round-trip_accurately", "[item]" )
     CHECK( i.get_var( "C", tripoint() ) == tripoint( 2, 3, 4 ) );
 }
 
+TEST_CASE( "item_variables_keep_their_text_through_save_and_load", "[item]" )
+{
+    item i( "water" );
+    i.set_var( "int", 17 );
+    i.set_var( "double", 0.1 );
+    i.set_var( "point", tripoint( -2, 3, 4 ) );
+    i.set_var( "text", std::string( "some text" ) );
+    // Text in the form set_var writes numbers in reads as that number.
+    i.set_var( "int_text", std::string( "42" ) );
+    // Legacy format with a localized fraction separator.
+    i.set_var( "legacy", std::string( "1,5" ) );
+
+    CHECK( i.get_var( "int" ) == "17" );
+    CHECK( i.get_var( "double" ) == "0.100000" );
+    CHECK( i.get_var( "point" ) == "-2,3,4" );
+    CHECK( i.get_var( "int_text", 0 ) == 42 );
+    CHECK( i.get_var( "legacy", 0.0 ) == 1.5 );
+    CHECK_FALSE( i.has_var( "missing" ) );
+
+    std::ostringstream os;
+    JsonOut jsout( os );
+    i.serialize( jsout );
+    item loaded;
+    loaded.deserialize( json_loader::from_string( os.str() ) );
+    for( const char *name : {
+             "int", "double", "point", "text", "int_text", "legacy"
+         } ) {
+        CAPTURE( name );
+        CHECK( loaded.get_var( name ) == i.get_var( name ) );
+    }
+    CHECK( loaded.get_var( "double", 0.0 ) == i.get_var( "double", 0.0 ) );
+    CHECK( loaded.stacks_with( i ) );
+    loaded.set_var( "double", 0.2 );
+    CHECK_FALSE( loaded.stacks_with( i ) );
+}
+
 TEST_CASE( "water_affect_items_while_swimming_check", "[item][water][swimming]" )
 {
     avatar &guy = get_avatar();
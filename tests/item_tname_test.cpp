@@ -246,6 +246,26 @@ TEST_CASE( "wet_item", "[item][tname][wet]" )
     CHECK( sheet_cotton.tname() == "cotton sheet (wet)" );
 }
 
+TEST_CASE( "item_name_follows_changes_within_a_turn", "[item][tname]" )
+{
+    item sheet_cotton( "sheet_cotton" );
+    REQUIRE( sheet_cotton.tname() == "cotton sheet" );
+    CHECK( sheet_cotton.tname( 2 ) == "cotton sheets" );
+
+    sheet_cotton.set_flag( flag_WET );
+    CHECK( sheet_cotton.tname() == "cotton sheet (wet)" );
+    sheet_cotton.unset_flag( flag_WET );
+    CHECK( sheet_cotton.tname() == "cotton sheet" );
+
+    sheet_cotton.set_var( "item_note", "mine" );
+    CHECK( sheet_cotton.tname() == "*cotton sheet*" );
+    sheet_cotton.erase_var( "item_note" );
+    CHECK( sheet_cotton.tname() == "cotton sheet" );
+
+    sheet_cotton.is_favorite = true;
+    CHECK( sheet_cotton.tname() != "cotton sheet" );
+}
+
 TEST_CASE( "filthy_item", "[item][tname][filthy]" )
 {
     item sheet_cotton( "sheet_cotton" );
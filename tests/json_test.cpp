@@ -1,7 +1,9 @@
 #include <algorithm>
 #include <array>
+#include <cstdint>
 #include <functional>
 #include <iterator>
+#include <limits>
 #include <list>
 #include <map>
 #include <optional>
@@ -14,12 +16,14 @@
 #include "bodypart.h"
 #include "cached_options.h"
 #include "cata_scope_helpers.h"
+#include "cata_path.h"
 #include "cata_utility.h"
 #include "cata_catch.h"
 #include "colony.h"
 #include "damage.h"
 #include "debug.h"
 #include "enum_bitset.h"
+#include "filesystem.h"
 #include "item.h"
 #include "json.h"
 #include "json_loader.h"
@@ -81,6 +85,85 @@ TEST_CASE( "avoid_serializing_default_values", "[json]" )
     REQUIRE( os.str() == "\"bar\":\"foo\"" );
 }
 
+TEST_CASE( "jsonout_writes_numbers_and_escapes", "[json]" )
+{
+    std::ostringstream os;
+    JsonOut jsout( os );
+    jsout.start_array();
+    jsout.write( 0 );
+    jsout.write( -42 );
+    jsout.write( std::numeric_limits<int64_t>::min() );
+    jsout.write( 4000000000u );
+    jsout.write( true );
+    jsout.write( false );
+    jsout.write( 1.5 );
+    jsout.write( "a\"b\\c/d\ne\x01" );
+    jsout.end_array();
+    CHECK( os.str() ==
+           R"([0,-42,-9223372036854775808,4000000000,true,false,1.500000,"a\"b\\c/d\ne\u0001"])" );
+}
+
+TEST_CASE( "text_jsonin_reads_strings_and_whitespace_from_the_buffer", "[json]" )
+{
+    const std::string plain( 300, 'x' );
+    // NOLINTBEGIN(cata-text-style)
+    std::istringstream is( " \n\t[ \"" + plain + "\" ,\r\n"
+                           R"( "a\tb…c\u0041", "skipped\"" , 7 ]  )" );
+    TextJsonIn jsin( is );
+    jsin.start_array();
+    CHECK( jsin.get_string() == plain );
+    CHECK( jsin.get_string() == "a\tb…cA" );
+    // NOLINTEND(cata-text-style)
+    jsin.skip_string();
+    CHECK( jsin.get_int() == 7 );
+    CHECK( jsin.end_array() );
+    jsin.eat_whitespace();
+    CHECK( is.eof() );
+}
+
+TEST_CASE( "json_loader_reads_mapped_and_compressed_files", "[json]" )
+{
+    const cata_path path( cata_path::root_path::unknown, "test_json_loader_file.json" );
+    on_out_of_scope cleanup( [&]() {
+        remove_file( path.get_unrelative_path() );
+    } );
+    // The mapping of the 4096 byte file has no null after the text, so it is read into memory.
+    for( const size_t size : {
+             4095, 4096
+         } ) {
+        for( const int compression_level : {
+                 0, 1
+             } ) {
+            CAPTURE( size, compression_level );
+            const std::string text( size - 4, 'a' );
+            write_to_file_compressed( path, compression_level, [&]( std::ostream & fout ) {
+                fout << "[\"" << text << "\"]";
+            } );
+            JsonValue jsin = json_loader::from_path( path );
+            CHECK( jsin.get_array().get_string( 0 ) == text );
+        }
+    }
+}
+
+TEST_CASE( "jsonout_throughput_benchmark", "[.][json][benchmark]" )
+{
+    BENCHMARK( "objects with string, int and bool members" ) {
+        std::ostringstream os;
+        JsonOut jsout( os );
+        jsout.start_array();
+        for( int i = 0; i < 1000; ++i ) {
+            jsout.start_object();
+            jsout.member( "typeid", "test_rag" );
+            jsout.member( "charges", i );
+            jsout.member( "active", i % 2 == 0 );
+            jsout.member( "name", "a \"quoted\" name" );
+            jsout.end_object();
+        }
+        jsout.end_array();
+        return os.str().size();
+    };
+}
+
 TEST_CASE( "spell_type_handles_all_members", "[json]" )
 {
     const spell_type &test_spell = spell_test_spell_json.obj();
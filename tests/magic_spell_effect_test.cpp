@@ -20,6 +20,8 @@
 static const spell_id spell_AO_CLOSE_TEAR( "AO_CLOSE_TEAR" );
 static const spell_id spell_test_line_spell( "test_line_spell" );
 
+static const ter_str_id ter_t_wall( "t_wall" );
+
 static std::set<tripoint_abs_ms> count_fields_near(
     const tripoint_abs_ms &p, const field_type_str_id &field_type )
 {
@@ -202,3 +204,35 @@ TEST_CASE( "remove_field_fd_fatigue", "[magic]" )
     CHECK( tear_in_reality_msg ==
            "A nearby tear in reality pulls you in as it closes and ejects you violently!" );
 }
+
+TEST_CASE( "blast_area_stops_at_walls", "[magic]" )
+{
+    clear_map();
+    map &here = get_map();
+    avatar &dummy = get_avatar();
+    clear_avatar();
+
+    spell_effect::override_parameters params( spell( spell_AO_CLOSE_TEAR ), dummy );
+    params.aoe_radius = 2;
+    params.range = 0;
+    const tripoint_bub_ms center = dummy.pos_bub() + tripoint_rel_ms_south * 5;
+    const tripoint_bub_ms wall = center + tripoint_rel_ms_east;
+    REQUIRE( here.ter_set( wall, ter_t_wall ) );
+
+    SECTION( "walls block the blast" ) {
+        params.ignore_walls = false;
+        const std::set<tripoint_bub_ms> area = spell_effect::spell_effect_blast( params, center,
+                                               center );
+        CHECK( area.count( center ) == 1 );
+        CHECK( area.count( center + tripoint_rel_ms_west * 2 ) == 1 );
+        CHECK( area.count( wall ) == 0 );
+        CHECK( area.count( center + tripoint_rel_ms_east * 2 ) == 0 );
+    }
+    SECTION( "ignoring walls reaches past them" ) {
+        params.ignore_walls = true;
+        const std::set<tripoint_bub_ms> area = spell_effect::spell_effect_blast( params, center,
+                                               center );
+        CHECK( area.count( wall ) == 1 );
+        CHECK( area.count( center + tripoint_rel_ms_east * 2 ) == 1 );
+    }
+}
@@ -292,3 +292,29 @@ TEST_CASE( "tripoint_range_predicates", "[tripoint_range]" )
     }
     CHECK( i == tested.size() );
 }
+
+TEST_CASE( "tripoint_range_clipped", "[tripoint_range]" )
+{
+    const tripoint_range<tripoint> tested( { -2, -2, -1 }, { 2, 2, 1 } );
+    const tripoint_range<tripoint> clipped = tested.clipped( { 0, -1, 0 }, { 5, 5, 0 } );
+    CHECK( clipped.min() == tripoint( 0, -1, 0 ) );
+    CHECK( clipped.max() == tripoint( 2, 2, 0 ) );
+    CHECK( clipped.size() == 12 );
+    for( const tripoint &p : clipped ) {
+        CHECK( p.x >= 0 );
+        CHECK( p.y >= -1 );
+        CHECK( p.z == 0 );
+    }
+
+    // A range outside of the box in x or y yields nothing, even though its z span overlaps.
+    const tripoint_range<tripoint> outside = tested.clipped( { 3, 0, 0 }, { 5, 5, 0 } );
+    CHECK( outside.empty() );
+    CHECK( outside.begin() == outside.end() );
+
+    // The predicate is kept.
+    const tripoint_range<tripoint> circle = points_in_radius_where( tripoint_zero, 2,
+    []( const tripoint & p ) {
+        return p.x == p.y;
+    } ).clipped( { 0, 0, 0 }, { 5, 5, 0 } );
+    CHECK( circle.size() == 3 );
+}
@@ -4,6 +4,7 @@
 #include <type_traits>
 
 #include "cata_catch.h"
+#include "cata_utility.h"
 #include "game_constants.h"
 #include "json.h"
 #include "lru_cache.h"
@@ -123,7 +124,57 @@ TEST_CASE( "map_memory_forgets", "[map_memory]" )
     CHECK( mt.get_dec_rotation() == 0 );
 }
 
-// TODO: map memory save / load
+TEST_CASE( "map_memory_region_round_trip", "[map_memory]" )
+{
+    mm_region region;
+    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+        for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+            region.submaps[x][y] = make_shared_fast<mm_submap>();
+        }
+    }
+    memorized_tile floor;
+    floor.set_ter_id( "t_floor" );
+    floor.symbol = '.';
+    memorized_tile chair = floor;
+    chair.set_dec_id( "f_chair" );
+    chair.set_dec_rotation( 2 );
+    chair.symbol = '#';
+    mm_submap &sm = *region.submaps[1][2];
+    for( int y = 0; y < SEEY; y++ ) {
+        for( int x = 0; x < SEEX; x++ ) {
+            sm.set_tile( point_sm_ms( x, y ), x == y ? chair : floor );
+        }
+    }
+    CHECK( sm.is_dirty() );
+    CHECK( region.is_dirty() );
+
+    const std::string saved = serialize_wrapper( [&]( JsonOut & jsout ) {
+        region.serialize( jsout );
+    } );
+    // Each id is written once, in the palette.
+    CHECK( saved.find( "t_floor" ) == saved.rfind( "t_floor" ) );
+
+    mm_region loaded;
+    deserialize_wrapper( [&]( const JsonValue & jsin ) {
+        loaded.deserialize( jsin );
+    }, saved );
+    CHECK_FALSE( loaded.is_dirty() );
+    for( size_t y = 0; y < MM_REG_SIZE; y++ ) {
+        for( size_t x = 0; x < MM_REG_SIZE; x++ ) {
+            CAPTURE( x, y );
+            CHECK( loaded.submaps[x][y]->is_empty() == region.submaps[x][y]->is_empty() );
+        }
+    }
+    const mm_submap &loaded_sm = *loaded.submaps[1][2];
+    for( int y = 0; y < SEEY; y++ ) {
+        for( int x = 0; x < SEEX; x++ ) {
+            CAPTURE( x, y );
+            CHECK( loaded_sm.get_tile( point_sm_ms( x, y ) ) == ( x == y ? chair : floor ) );
+        }
+    }
+    CHECK( loaded_sm.get_tile( point_sm_ms( 3, 3 ) ).get_dec_id() == "f_chair" );
+    CHECK( loaded_sm.get_tile( point_sm_ms( 3, 3 ) ).get_dec_rotation() == 2 );
+}
 
 #include <chrono>
 
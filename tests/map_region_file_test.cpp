@@ -0,0 +1,47 @@
+#include <cstdint>
+#include <optional>
+#include <string>
+
+#include "cata_catch.h"
+#include "cata_path.h"
+#include "cata_scope_helpers.h"
+#include "filesystem.h"
+#include "map_region_file.h"
+
+static constexpr size_t num_slots = 1024;
+
+TEST_CASE( "map_region_file_roundtrips_and_reuses_space", "[map][nogame]" )
+{
+    const cata_path path( cata_path::root_path::unknown, "test_map_region_file.region" );
+    remove_file( path.get_unrelative_path() );
+    on_out_of_scope cleanup( [&]() {
+        remove_file( path.get_unrelative_path() );
+    } );
+
+    const std::string big( map_region_file::sector_size + 100, 'a' );
+    {
+        map_region_file region( path, num_slots );
+        CHECK_FALSE( region.contains( 5 ) );
+        CHECK_FALSE( region.read( 5 ) );
+
+        region.write( 5, big );
+        region.write( 7, "small" );
+        CHECK( region.read( 5 ) == big );
+        CHECK( region.read( 7 ) == "small" );
+        const uintmax_t size_before = fs::file_size( path.get_unrelative_path() );
+
+        // The rewritten quad moves behind the others, the next write fills the gap it left.
+        region.write( 5, "shrunk" );
+        region.write( 9, "new" );
+        CHECK( fs::file_size( path.get_unrelative_path() ) ==
+               size_before + map_region_file::sector_size );
+
+        region.erase( 7 );
+        CHECK_FALSE( region.contains( 7 ) );
+    }
+
+    map_region_file reopened( path, num_slots );
+    CHECK( reopened.read( 5 ) == "shrunk" );
+    CHECK( reopened.read( 9 ) == "new" );
+    CHECK_FALSE( reopened.contains( 7 ) );
+}
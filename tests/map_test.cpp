@@ -1,6 +1,8 @@
 #include "cata_catch.h"
 #include "map.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
 #include <vector>
 
@@ -9,13 +11,21 @@
 #include "coordinates.h"
 #include "enums.h"
 #include "itype.h"
+#include "level_cache.h"
 #include "game.h"
 #include "game_constants.h"
 #include "map_helpers.h"
+#include "player_helpers.h"
 #include "point.h"
 #include "submap.h"
 #include "type_id.h"
 
+static const itype_id itype_battery( "battery" );
+static const itype_id itype_test_rag( "test_rag" );
+
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_wall( "t_wall" );
+
 TEST_CASE( "map_coordinate_conversion_functions" )
 {
     map &here = get_map();
@@ -168,6 +178,188 @@ TEST_CASE( "place_player_can_safely_move_multiple_submaps" )
     get_map().check_submap_active_item_consistency();
 }
 
+TEST_CASE( "shift_keeps_caches_consistent_with_full_rebuild", "[map][shift]" )
+{
+    map &here = get_map();
+    here.build_map_cache( 0, true );
+
+    const on_out_of_scope restore_shift( [&here]() {
+        here.shift( point_rel_sm_west );
+    } );
+    here.shift( point_rel_sm_east );
+    here.build_map_cache( 0, true );
+
+    std::vector<level_cache> shifted;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        shifted.push_back( here.get_cache_ref( z ) );
+        here.invalidate_map_cache( z );
+    }
+    here.build_map_cache( 0, true );
+
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        CAPTURE( z );
+        const level_cache &rebuilt = here.get_cache_ref( z );
+        const level_cache &kept = shifted[z + OVERMAP_DEPTH];
+        CHECK( std::equal( &kept.transparency_cache[0][0],
+                           &kept.transparency_cache[0][0] + MAPSIZE_X * MAPSIZE_Y,
+                           &rebuilt.transparency_cache[0][0] ) );
+        CHECK( kept.transparent_cache_wo_fields == rebuilt.transparent_cache_wo_fields );
+        CHECK( std::equal( &kept.floor_cache[0][0], &kept.floor_cache[0][0] + MAPSIZE_X * MAPSIZE_Y,
+                           &rebuilt.floor_cache[0][0] ) );
+        CHECK( kept.no_floor_gaps == rebuilt.no_floor_gaps );
+    }
+}
+
+TEST_CASE( "sunlight_kept_on_unchanged_levels_matches_a_full_cast", "[map][lightmap]" )
+{
+    clear_map();
+    set_time_to_day();
+    map &here = get_map();
+    here.build_map_cache( 0 );
+
+    // A roof one level up changes the sunlight of that level and the ones below only.
+    for( int x = 50; x < 70; x++ ) {
+        for( int y = 50; y < 70; y++ ) {
+            here.ter_set( tripoint_bub_ms( x, y, 1 ), ter_t_floor );
+        }
+    }
+    here.build_map_cache( 0 );
+    for( int z = 2; z <= OVERMAP_HEIGHT; z++ ) {
+        CAPTURE( z );
+        const level_cache &ch = here.get_cache_ref( z );
+        CHECK( ch.sunlight_built_generation == ch.sunlight_inputs_generation );
+    }
+
+    std::vector<level_cache> kept;
+    for( int z = -OVERMAP_DEPTH; z <= OVERMAP_HEIGHT; z++ ) {
+        kept.push_back( here.get_cache_ref( z ) );
+        here.invalidate_map_cache( z );
+    }
+    here.build_map_cache( 0 );
+
+    for( int z = 0; z <= OVERMAP_HEIGHT; z++ ) {
+        CAPTURE( z );
+        const level_cache &cast = here.get_cache_ref( z );
+        const level_cache &old = kept[z + OVERMAP_DEPTH];
+        CHECK( std::equal( &old.lm[0][0], &old.lm[0][0] + MAPSIZE_X * MAPSIZE_Y, &cast.lm[0][0],
+        []( const four_quadrants & l, const four_quadrants & r ) {
+            return l.values == r.values;
+        } ) );
+    }
+}
+
+TEST_CASE( "repeated_sees_from_one_origin_follow_map_changes", "[map][vision]" )
+{
+    clear_map();
+    map &here = get_map();
+    here.build_map_cache( 0, true );
+
+    const tripoint_bub_ms origin( 60, 60, 0 );
+    const tripoint_bub_ms wall_pos = origin + tripoint_east * 2;
+    const tripoint_bub_ms behind_wall = origin + tripoint_east * 4;
+    const tripoint_bub_ms beside = origin + tripoint_north * 4;
+
+    // The origin gets its own visibility field from the second query on.
+    for( int i = 0; i < 3; i++ ) {
+        CHECK( here.sees( origin, behind_wall, 10 ) );
+        CHECK( here.sees( origin, beside, 10 ) );
+        CHECK( here.sees( origin, behind_wall, 60 ) );
+    }
+    CHECK_FALSE( here.sees( origin, origin + tripoint_east * 11, 10 ) );
+
+    REQUIRE( here.ter_set( wall_pos, ter_t_wall ) );
+    here.build_map_cache( 0, true );
+    for( int i = 0; i < 3; i++ ) {
+        CHECK_FALSE( here.sees( origin, behind_wall, 10 ) );
+        CHECK( here.sees( origin, wall_pos, 10 ) );
+        CHECK( here.sees( origin, beside, 10 ) );
+    }
+
+    here.ter_set( wall_pos, ter_t_floor );
+    here.build_map_cache( 0, true );
+    CHECK( here.sees( origin, behind_wall, 10 ) );
+}
+
+TEST_CASE( "many_origins_watching_one_target_share_its_field", "[map][vision]" )
+{
+    clear_map();
+    map &here = get_map();
+    here.build_map_cache( 0, true );
+
+    const tripoint_bub_ms target( 60, 60, 0 );
+    const tripoint_bub_ms wall_pos = target + tripoint_west * 2;
+    // Watchers in a column west of the target, skipping those whose line of sight only
+    // grazes the tile where the wall goes.
+    std::vector<tripoint_bub_ms> watchers;
+    for( int dy = -10; dy <= 10; dy++ ) {
+        if( dy == 0 || std::abs( dy ) > 2 ) {
+            watchers.push_back( target + tripoint_west * 4 + tripoint_north * dy );
+        }
+    }
+    const tripoint_bub_ms watcher_behind_wall = target + tripoint_west * 4;
+
+    for( int i = 0; i < 3; i++ ) {
+        for( const tripoint_bub_ms &watcher : watchers ) {
+            CHECK( here.sees( watcher, target, 20 ) );
+        }
+    }
+
+    REQUIRE( here.ter_set( wall_pos, ter_t_wall ) );
+    here.build_map_cache( 0, true );
+    for( int i = 0; i < 3; i++ ) {
+        for( const tripoint_bub_ms &watcher : watchers ) {
+            CAPTURE( watcher );
+            CHECK( here.sees( watcher, target, 20 ) != ( watcher == watcher_behind_wall ) );
+        }
+    }
+}
+
+TEST_CASE( "visible_item_tiles_follow_items_within_a_turn", "[map][vision]" )
+{
+    clear_avatar();
+    clear_map();
+    set_time_to_day();
+    map &here = get_map();
+    avatar &player_character = get_avatar();
+    here.build_map_cache( 0, true );
+
+    const tripoint_bub_ms near_pos = player_character.pos_bub() + tripoint_east * 2;
+    const tripoint_bub_ms far_pos = player_character.pos_bub() + tripoint_north * 5;
+    CHECK( g->visible_item_tiles().empty() );
+
+    here.add_item( far_pos, item( itype_test_rag ) );
+    here.add_item( near_pos, item( itype_test_rag ) );
+    std::vector<tripoint_abs_ms> expected = {
+        here.getglobal( near_pos ), here.getglobal( far_pos )
+    };
+    CHECK( g->visible_item_tiles() == expected );
+
+    here.i_clear( near_pos );
+    expected = { here.getglobal( far_pos ) };
+    CHECK( g->visible_item_tiles() == expected );
+}
+
+TEST_CASE( "find_clear_path_follows_transparency_changes", "[map][vision]" )
+{
+    clear_map();
+    map &here = get_map();
+    here.build_map_cache( 0, true );
+
+    const tripoint_bub_ms source( 60, 60, 0 );
+    const tripoint_bub_ms target = source + point( 6, 1 );
+    const std::vector<tripoint_bub_ms> open_path = here.find_clear_path( source, target );
+    REQUIRE( open_path.size() == 6 );
+    CHECK( here.find_clear_path( source, target ) == open_path );
+
+    // Blocking the line found must bend the next one around the wall.
+    const tripoint_bub_ms wall = open_path[2];
+    here.ter_set( wall, ter_t_wall );
+    here.build_map_cache( 0, true );
+    const std::vector<tripoint_bub_ms> blocked_path = here.find_clear_path( source, target );
+    CHECK( blocked_path.back() == target );
+    CHECK( std::find( blocked_path.begin(), blocked_path.end(), wall ) == blocked_path.end() );
+}
+
 TEST_CASE( "inactive_container_with_active_contents", "[active_item][map]" )
 {
     map &here = get_map();
@@ -303,3 +495,31 @@ TEST_CASE( "active_monster_drops", "[active_item][map]" )
     }
     CHECK( dropped_bag.empty() );
 }
+
+TEST_CASE( "stored_volume_follows_items_added_to_a_tile", "[map]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint_bub_ms pos( 60, 60, 0 );
+    const auto summed_volume = [&here, &pos]() {
+        units::volume ret = 0_ml;
+        for( const item &it : here.i_at( pos ) ) {
+            ret += it.volume();
+        }
+        return ret;
+    };
+    REQUIRE( here.stored_volume( pos ) == 0_ml );
+
+    const item rag( itype_test_rag );
+    here.add_item( pos, rag, 3 );
+    here.add_item_or_charges( pos, item( itype_battery, calendar::turn, 10 ) );
+    // Merges into the batteries already there.
+    here.add_item_or_charges( pos, item( itype_battery, calendar::turn, 490 ) );
+    const units::volume stored = here.stored_volume( pos );
+    CHECK( stored == rag.volume() * 3 + item( itype_battery, calendar::turn, 500 ).volume() );
+    CHECK( stored == summed_volume() );
+    CHECK( here.free_volume( pos ) == here.max_volume( pos ) - stored );
+
+    here.i_clear( pos );
+    CHECK( here.stored_volume( pos ) == 0_ml );
+}
@@ -87,6 +87,20 @@ TEST_CASE( "Martial_art_required_weapon_categories", "[martial_arts]" )
     }
 }
 
+TEST_CASE( "Martial_art_buff_found_from_its_effect", "[martial_arts]" )
+{
+    REQUIRE( !test_style_ma1->onmiss_buffs.empty() );
+    const mabuff_id &buff = test_style_ma1->onmiss_buffs[0];
+    standard_npc dude( "TestCharacter", dude_pos.raw(), {}, 0, 8, 8, 8, 8 );
+    clear_character( dude, true );
+    CHECK( !dude.has_mabuff( buff ) );
+
+    buff->apply_buff( dude );
+    CHECK( dude.has_mabuff( buff ) );
+    const effect &eff = dude.get_effect( buff->get_effect_id() );
+    CHECK( ma_buff::from_effect( eff ) == &buff.obj() );
+}
+
 TEST_CASE( "Attack_vector_test", "[martial_arts][limb]" )
 {
     clear_map();
@@ -346,3 +346,47 @@ TEST_CASE( "math_parser_dialogue_integration", "[math_parser]" )
         CHECK_FALSE( testexp.parse( "val( 'stamina' ) * 3", true ) ); // eval expression in assignment tree
     } );
 }
+
+TEST_CASE( "math_parser_folds_constants", "[math_parser]" )
+{
+    standard_npc dude;
+    dialogue d( get_talker_for( get_avatar() ), get_talker_for( &dude ) );
+    math_exp testexp;
+    get_globals().set_global_value( "npctalk_var_x", "7" );
+
+    CHECK( testexp.parse( "(2 + 3) * 4 ^ 2 - 10 / 5" ) );
+    CHECK( testexp.eval( d ) == Approx( 78 ) );
+    CHECK( testexp.parse( "1 ? 2 + 3 : x" ) );
+    CHECK( testexp.eval( d ) == Approx( 5 ) );
+    // a folded constant right after the end of a ternary
+    CHECK( testexp.parse( "( x > 5 ? 2 : 3 ) + 4 * 10" ) );
+    CHECK( testexp.eval( d ) == Approx( 42 ) );
+    CHECK( testexp.parse( "( x < 5 ? 2 : 3 ) + 4 * 10" ) );
+    CHECK( testexp.eval( d ) == Approx( 43 ) );
+    CHECK( testexp.parse( "max( x, 2 * 5, -( x < 0 ? 1 : 2 ) ) + x" ) );
+    CHECK( testexp.eval( d ) == Approx( 17 ) );
+
+    // copies evaluate on their own
+    math_exp copy = testexp;
+    testexp.parse( "0" );
+    CHECK( copy.eval( d ) == Approx( 17 ) );
+}
+
+TEST_CASE( "math_parser_eval_benchmark", "[.][math_parser][benchmark]" )
+{
+    standard_npc dude;
+    dialogue d( get_talker_for( get_avatar() ), get_talker_for( &dude ) );
+    get_globals().set_global_value( "npctalk_var_x", "7" );
+
+    math_exp constant;
+    REQUIRE( constant.parse( "(2 + 3) * 4 ^ 2 - 10 / 5" ) );
+    math_exp mixed;
+    REQUIRE( mixed.parse( "x * 2 + ( x > 5 ? u_val('stamina') : 3 ) - max( x, 4, 1 + 1 )" ) );
+
+    BENCHMARK( "constant" ) {
+        return constant.eval( d );
+    };
+    BENCHMARK( "variables and functions" ) {
+        return mixed.eval( d );
+    };
+}
@@ -8,6 +8,9 @@
 #include "monster.h"
 #include "options_helpers.h"
 
+static const efftype_id effect_no_sight( "no_sight" );
+
+static const ter_str_id ter_t_brick_wall( "t_brick_wall" );
 static const ter_str_id ter_t_floor( "t_floor" );
 
 struct tripoint;
@@ -73,3 +76,26 @@ TEST_CASE( "monsters_should_not_see_through_floors", "[vision]" )
     CHECK( sky.sees( distant ) );
     CHECK( distant.sees( sky ) );
 }
+
+TEST_CASE( "monster_sight_follows_changes_within_a_turn", "[vision]" )
+{
+    calendar::turn = midday;
+    clear_map();
+    map &here = get_map();
+    monster &watcher = spawn_test_monster( "mon_zombie", { 50, 50, 0 } );
+    monster &target = spawn_test_monster( "mon_zombie", { 55, 50, 0 } );
+    here.build_map_cache( 0 );
+    CHECK( watcher.sees( target ) );
+
+    const tripoint_bub_ms between( 52, 50, 0 );
+    here.ter_set( between, ter_t_brick_wall );
+    here.build_map_cache( 0 );
+    CHECK_FALSE( watcher.sees( target ) );
+
+    here.ter_set( between, ter_t_floor );
+    here.build_map_cache( 0 );
+    CHECK( watcher.sees( target ) );
+
+    watcher.add_effect( effect_no_sight, 1_hours );
+    CHECK_FALSE( watcher.sees( target ) );
+}
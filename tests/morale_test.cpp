@@ -69,6 +69,15 @@ TEST_CASE( "player_morale_decay", "[player_morale]" )
                 CHECK( m.has( morale_food_bad ) == -5 );
                 CHECK( m.get_level() == 5 );
             }
+            AND_WHEN( "it fades in steps after a quiet stretch" ) {
+                m.decay( 5_turns );
+                CHECK( m.get_level() == 10 );
+                m.decay( 5_turns );
+                CHECK( m.get_level() == 10 );
+                m.decay( 5_turns );
+                CHECK( m.has( morale_food_good ) == 10 );
+                CHECK( m.get_level() == 5 );
+            }
             AND_WHEN( "it's finished" ) {
                 m.decay( 20_turns );
                 CHECK( m.has( morale_food_good ) == 0 );
@@ -1,5 +1,6 @@
 #include "cata_catch.h"
 #include "options.h"
+#include "options_helpers.h"
 
 static const option_slider_id option_slider_test_world_difficulty( "test_world_difficulty" );
 
@@ -73,3 +74,21 @@ TEST_CASE( "option_slider_test", "[option]" )
     }
     CHECK( checked == 7 );
 }
+
+TEST_CASE( "option_ref_follows_changed_options", "[option]" )
+{
+    const option_ref<int> proximity( "SAFEMODEPROXIMITY" );
+    const option_ref<std::string> sidebar( "SIDEBAR_POSITION" );
+    CHECK( proximity.get() == get_option<int>( "SAFEMODEPROXIMITY" ) );
+    {
+        override_option near( "SAFEMODEPROXIMITY", "7" );
+        override_option left( "SIDEBAR_POSITION", "left" );
+        CHECK( proximity.get() == 7 );
+        CHECK( sidebar.get() == "left" );
+
+        get_options().get_option( "SAFEMODEPROXIMITY" ).setValue( 9 );
+        CHECK( proximity.get() == 9 );
+    }
+    CHECK( proximity.get() == get_option<int>( "SAFEMODEPROXIMITY" ) );
+    CHECK( sidebar.get() == get_option<std::string>( "SIDEBAR_POSITION" ) );
+}
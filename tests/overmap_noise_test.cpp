@@ -1,4 +1,7 @@
 #include "cata_catch.h"
+
+#include <memory>
+
 #include "coordinates.h"
 #include "filesystem.h"
 #include "game_constants.h"
@@ -65,3 +68,24 @@ TEST_CASE( "om_noise_layer_lake_export", "[.]" )
     export_raw_noise( "lake-map-raw.pgm", f, OMAPX * 5, OMAPY * 5 );
     export_interpreted_noise( "lake-map-interp.pgm", f, OMAPX * 5, OMAPY * 5, 0.25 );
 }
+
+TEST_CASE( "om_noise_grid_matches_layer", "[overmap][nogame]" )
+{
+    const point_abs_omt base( OMAPX * 3, OMAPY * -2 );
+    const om_noise::om_noise_layer_forest forest( base, 1920237457 );
+    const om_noise::om_noise_layer_lake lake( base, 1920237457 );
+    const om_noise::om_noise_grid forest_grid(
+        std::make_unique<om_noise::om_noise_layer_forest>( base, 1920237457 ), 0 );
+    const om_noise::om_noise_grid lake_grid(
+        std::make_unique<om_noise::om_noise_layer_lake>( base, 1920237457 ), 5 );
+
+    // Inside, on the border and past the border of the grids.
+    for( int x = -7; x < OMAPX + 7; x += 3 ) {
+        for( int y = -7; y < OMAPY + 7; y += 5 ) {
+            const point_om_omt p( x, y );
+            CAPTURE( x, y );
+            CHECK( forest_grid.noise_at( p ) == forest.noise_at( p ) );
+            CHECK( lake_grid.noise_at( p ) == lake.noise_at( p ) );
+        }
+    }
+}
@@ -1,25 +1,41 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <memory>
+#include <sstream>
+#include <string>
 #include <vector>
 
 #include "all_enum_values.h"
 #include "ammo.h"
+#include "cached_options.h"
 #include "calendar.h"
+#include "cata_path.h"
 #include "cata_catch.h"
+#include "cata_scope_helpers.h"
 #include "city.h"
 #include "common_types.h"
 #include "coordinates.h"
 #include "enums.h"
+#include "faction.h"
+#include "filesystem.h"
 #include "game.h"
 #include "game_constants.h"
 #include "global_vars.h"
 #include "item_factory.h"
 #include "itype.h"
+#include "json.h"
+#include "json_loader.h"
 #include "map.h"
 #include "map_iterator.h"
 #include "mapbuffer.h"
+#include "memory_fast.h"
+#include "mongroup.h"
+#include "npc.h"
 #include "omdata.h"
 #include "output.h"
 #include "overmap.h"
+#include "overmap_connectivity.h"
 #include "overmap_types.h"
 #include "overmapbuffer.h"
 #include "test_data.h"
@@ -27,11 +43,17 @@
 #include "vehicle.h"
 #include "vpart_position.h"
 
+static const mongroup_id GROUP_ZOMBIE( "GROUP_ZOMBIE" );
+
+static const faction_id faction_free_merchants( "free_merchants" );
+
 static const oter_str_id oter_cabin( "cabin" );
 static const oter_str_id oter_cabin_east( "cabin_east" );
 static const oter_str_id oter_cabin_north( "cabin_north" );
 static const oter_str_id oter_cabin_south( "cabin_south" );
 static const oter_str_id oter_cabin_west( "cabin_west" );
+static const oter_str_id oter_field( "field" );
+static const oter_str_id oter_river_center( "river_center" );
 
 static const overmap_special_id overmap_special_Cabin( "Cabin" );
 static const overmap_special_id overmap_special_Lab( "Lab" );
@@ -57,6 +79,78 @@ TEST_CASE( "set_and_get_overmap_scents", "[overmap]" )
     REQUIRE( test_overmap->scent_at( { 75, 85, 0} ).initial_strength == 90 );
 }
 
+TEST_CASE( "overmap_save_writes_only_changed_files", "[overmap]" )
+{
+    // Far from anything the other tests load, the files are removed again below.
+    const point_abs_om pos( 97, -97 );
+    const cata_path terrain_file = overmapbuffer::terrain_filename( pos );
+    const cata_path view_file = overmapbuffer::player_filename( pos );
+    on_out_of_scope cleanup( [&]() {
+        remove_file( terrain_file.get_unrelative_path() );
+        remove_file( view_file.get_unrelative_path() );
+    } );
+    std::unique_ptr<overmap> test_overmap = std::make_unique<overmap>( pos );
+
+    std::vector<overmap_file_write> files;
+    test_overmap->collect_changed_files( files );
+    REQUIRE( files.size() == 2 );
+    for( const overmap_file_write &file : files ) {
+        overmap::write_file( file, 0 );
+    }
+    CHECK( file_exist( terrain_file ) );
+    CHECK( file_exist( view_file ) );
+
+    files.clear();
+    test_overmap->collect_changed_files( files );
+    CHECK( files.empty() );
+
+    test_overmap->ter_set( tripoint_om_omt( 10, 10, 0 ), oter_cabin.id() );
+    test_overmap->collect_changed_files( files );
+    REQUIRE( files.size() == 1 );
+    CHECK( files.front().path == terrain_file );
+}
+
+static std::unique_ptr<overmap> reload_overmap( const overmap &om )
+{
+    std::ostringstream saved;
+    om.serialize( saved );
+    // Skip the version line.
+    const std::string contents = saved.str();
+    std::unique_ptr<overmap> loaded = std::make_unique<overmap>( om.pos() );
+    loaded->unserialize( json_loader::from_string( contents.substr( contents.find( '\n' ) ) )
+                         .get_object() );
+    return loaded;
+}
+
+TEST_CASE( "overmap_defers_npcs_until_first_access", "[overmap][npc]" )
+{
+    const point_abs_om pos( 97, -98 );
+    std::unique_ptr<overmap> original = std::make_unique<overmap>( pos );
+    shared_ptr_fast<npc> guy = make_shared_fast<npc>();
+    guy->normalize();
+    guy->randomize();
+    guy->set_fac( faction_free_merchants );
+    guy->spawn_at_omt( project_combine( pos, tripoint_om_omt( 10, 10, 0 ) ) );
+    original->insert_npc( guy );
+
+    faction *merchants = g->faction_manager_ptr->get( faction_free_merchants );
+    merchants->remove_member( guy->getID() );
+    std::unique_ptr<overmap> loaded = reload_overmap( *original );
+    CHECK( loaded->has_unloaded_npcs() );
+    // The summary alone restores the faction membership.
+    CHECK( merchants->members.count( guy->getID() ) == 1 );
+
+    // Saving without touching the npcs keeps them.
+    loaded = reload_overmap( *loaded );
+    REQUIRE( loaded->has_unloaded_npcs() );
+    const shared_ptr_fast<npc> reloaded = loaded->find_npc( guy->getID() );
+    CHECK_FALSE( loaded->has_unloaded_npcs() );
+    REQUIRE( reloaded );
+    CHECK( reloaded->get_name() == guy->get_name() );
+    CHECK( reloaded->get_location() == guy->get_location() );
+    CHECK( loaded->get_npcs().size() == 1 );
+}
+
 TEST_CASE( "default_overmap_generation_always_succeeds", "[overmap][slow]" )
 {
     overmap_buffer.clear();
@@ -622,3 +716,194 @@ TEST_CASE( "overmap_terrain_coverage", "[overmap][slow]" )
         }
     }
 }
+
+TEST_CASE( "overmap_connectivity_rules_out_enclosed_destinations", "[overmap][pathfinding]" )
+{
+    const tripoint_abs_omt island( 90, 90, 0 );
+    const tripoint_abs_omt shore = island + point( -10, 0 );
+    // A field surrounded by a ring of river, with a road of fields up to the ring.
+    for( int x = -4; x <= 4; ++x ) {
+        for( int y = -4; y <= 4; ++y ) {
+            const bool ring = std::max( std::abs( x ), std::abs( y ) ) == 4;
+            overmap_buffer.ter_set( island + point( x, y ), ring ? oter_river_center.id() : oter_field.id() );
+        }
+    }
+    for( int x = -10; x < -4; ++x ) {
+        overmap_buffer.ter_set( island + point( x, 0 ), oter_field.id() );
+    }
+    const overmap_path_params params = overmap_path_params::for_npc();
+
+    CHECK_FALSE( overmap_connectivity::may_connect( shore, island, 4 * OMAPX, params ) );
+    CHECK( overmap_buffer.get_travel_path( shore, island, params ).empty() );
+
+    overmap_buffer.ter_set( island + point( -4, 0 ), oter_field.id() );
+    CHECK( overmap_connectivity::may_connect( shore, island, 4 * OMAPX, params ) );
+    CHECK_FALSE( overmap_buffer.get_travel_path( shore, island, params ).empty() );
+}
+
+TEST_CASE( "overmap_display_follows_terrain_and_vision_changes", "[overmap]" )
+{
+    const tripoint_abs_omt p( 50, 50, 0 );
+    const auto symbol_at = [&]( om_vision_level vision ) {
+        oter_display_options opts( p + point( 5, 5 ), 0 );
+        opts.blink = false;
+        oter_display_args args( vision );
+        return oter_symbol_and_color( p, args, opts ).first;
+    };
+    REQUIRE_FALSE( oter_field->blends_adjacent( om_vision_level::full ) );
+    REQUIRE_FALSE( oter_cabin->blends_adjacent( om_vision_level::full ) );
+
+    overmap_buffer.ter_set( p, oter_field.id() );
+    overmap_buffer.set_seen( p, om_vision_level::full );
+    CHECK( symbol_at( om_vision_level::full ) == oter_field->get_symbol( om_vision_level::full ) );
+    // Drawn again from the cache.
+    CHECK( symbol_at( om_vision_level::full ) == oter_field->get_symbol( om_vision_level::full ) );
+
+    overmap_buffer.ter_set( p, oter_cabin.id() );
+    CHECK( symbol_at( om_vision_level::full ) == oter_cabin->get_symbol( om_vision_level::full ) );
+    if( !oter_cabin->blends_adjacent( om_vision_level::outlines ) ) {
+        CHECK( symbol_at( om_vision_level::outlines ) ==
+               oter_cabin->get_symbol( om_vision_level::outlines ) );
+    }
+}
+
+TEST_CASE( "overmap_generated_ahead_of_the_border", "[overmap][slow]" )
+{
+    overmap_buffer.clear();
+    const point_abs_om here( 4, 4 );
+    const point_abs_om east = here + point_east;
+    const tripoint_abs_omt near_east_border( project_combine( here, point_om_omt( OMAPX - 5,
+            OMAPY / 2 ) ), 0 );
+    overmap_buffer.get( here );
+    REQUIRE_FALSE( overmap_buffer.has( east ) );
+
+    // No budget still runs a stage, but the overmap isn't visible until it's complete.
+    overmap_buffer.generate_ahead( near_east_border, std::chrono::milliseconds( 0 ) );
+    CHECK( overmap_buffer.has( east ) );
+    CHECK( overmap_buffer.get_existing( east ) == nullptr );
+
+    // Asking for it runs the rest of its stages.
+    const overmap &generated = overmap_buffer.get( east );
+    CHECK( generated.pos() == east );
+    CHECK( overmap_buffer.get_existing( east ) == &generated );
+
+    // Nothing more to generate with the neighbour ahead in place.
+    const int overmap_count = overmap_buffer.get_overmap_count();
+    overmap_buffer.generate_ahead( near_east_border, std::chrono::milliseconds( 0 ) );
+    CHECK( overmap_buffer.get_overmap_count() == overmap_count );
+    overmap_buffer.clear();
+}
+
+TEST_CASE( "overmap_find_follows_terrain_changes", "[overmap]" )
+{
+    const tripoint_abs_omt origin( 90, 90, 0 );
+    for( int dy = -10; dy <= 10; ++dy ) {
+        for( int dx = -10; dx <= 10; ++dx ) {
+            overmap_buffer.ter_set( origin + tripoint( dx, dy, 0 ), oter_field.id() );
+        }
+    }
+    const tripoint_abs_omt near_cabin = origin + tripoint( 3, 0, 0 );
+    const tripoint_abs_omt far_cabin = origin + tripoint( -7, 5, 0 );
+    overmap_buffer.ter_set( near_cabin, oter_cabin.id() );
+    overmap_buffer.ter_set( far_cabin, oter_cabin.id() );
+
+    omt_find_params params;
+    params.types = { { oter_cabin.str(), ot_match_type::exact } };
+    params.search_range = 10;
+    params.min_z = 0;
+    params.max_z = 0;
+    CHECK( overmap_buffer.find_closest( origin, params ) == near_cabin );
+    CHECK( overmap_buffer.find_all( origin, params ) ==
+           std::vector<tripoint_abs_omt> { near_cabin, far_cabin } );
+
+    params.min_distance = 4;
+    CHECK( overmap_buffer.find_closest( origin, params ) == far_cabin );
+    params.min_distance = 0;
+
+    overmap_buffer.ter_set( near_cabin, oter_field.id() );
+    CHECK( overmap_buffer.find_closest( origin, params ) == far_cabin );
+    overmap_buffer.ter_set( far_cabin, oter_field.id() );
+    CHECK( overmap_buffer.find_closest( origin, params ) == overmap::invalid_tripoint );
+}
+
+TEST_CASE( "hordes_hear_signals_across_the_overmap_edge", "[overmap]" )
+{
+    overmap om( point_abs_om( 0, 0 ) );
+    const point_abs_sm far_away( 1000, 1000 );
+    const auto add_horde = [&]( const tripoint_abs_sm & p ) {
+        mongroup mg( GROUP_ZOMBIE, p, 10 );
+        mg.horde = true;
+        mg.target = far_away;
+        om.debug_force_add_group( mg );
+    };
+    const auto target_of_horde = [&]( const tripoint_abs_sm & p ) {
+        tripoint_abs_omt omt = project_to<coords::omt>( p );
+        const std::vector<std::reference_wrapper<mongroup>> groups = om.debug_unsafe_get_groups_at( omt );
+        REQUIRE( groups.size() == 1 );
+        return groups.front().get().target;
+    };
+    const tripoint_abs_sm near( 8, 50, 0 );
+    // Walked off the west edge, so it is keyed by its position wrapped into the overmap.
+    const tripoint_abs_sm off_the_edge( -6, 50, 0 );
+    const tripoint_abs_sm too_far_east( 20, 50, 0 );
+    const tripoint_abs_sm too_far_south( 2, 70, 0 );
+    for( const tripoint_abs_sm &p : {
+             near, off_the_edge, too_far_east, too_far_south
+         } ) {
+        add_horde( p );
+    }
+
+    om.signal_hordes( tripoint_rel_sm( 2, 50, 0 ), 10 );
+    CHECK( target_of_horde( near ) == point_abs_sm( 2, 50 ) );
+    CHECK( target_of_horde( off_the_edge ) == point_abs_sm( 2, 50 ) );
+    CHECK( target_of_horde( too_far_east ) == far_away );
+    CHECK( target_of_horde( too_far_south ) == far_away );
+}
+
+TEST_CASE( "overmap_rect_queries_match_single_queries", "[overmap]" )
+{
+    // Straddles the corner of four overmaps.
+    const tripoint_abs_omt corner( OMAPX - 3, OMAPY - 2, 0 );
+    const point size( 7, 5 );
+    overmap_buffer.ter_set( corner + point( 4, 3 ), oter_cabin.id() );
+    overmap_buffer.set_seen( corner + point( 1, 1 ), om_vision_level::full );
+    overmap_buffer.set_seen( corner + point( 5, 4 ), om_vision_level::outlines );
+
+    std::vector<oter_id> ter;
+    overmap_buffer.ter_rect( corner, size, ter );
+    std::vector<om_vision_level> seen;
+    overmap_buffer.seen_rect( corner, size, seen );
+    REQUIRE( ter.size() == static_cast<size_t>( size.x * size.y ) );
+    REQUIRE( seen.size() == ter.size() );
+    for( int y = 0; y < size.y; ++y ) {
+        for( int x = 0; x < size.x; ++x ) {
+            const tripoint_abs_omt p = corner + point( x, y );
+            CAPTURE( p );
+            CHECK( ter[x + y * size.x] == overmap_buffer.ter( p ) );
+            CHECK( seen[x + y * size.x] == overmap_buffer.seen( p ) );
+        }
+    }
+    CHECK( ter[4 + 3 * size.x] == oter_cabin.id() );
+    CHECK( seen[5 + 4 * size.x] == om_vision_level::outlines );
+}
+
+TEST_CASE( "overmap_reveal_covers_the_circle_across_overmaps", "[overmap]" )
+{
+    restore_on_out_of_scope<bool> restore_trigdist( trigdist );
+    trigdist = GENERATE( true, false );
+    CAPTURE( trigdist );
+    const int radius = 6;
+    const int z = trigdist ? -2 : -3;
+    const tripoint_abs_omt center( OMAPX, OMAPY + 2, z );
+    REQUIRE( overmap_buffer.reveal( center, radius ) );
+    for( int dy = -radius - 1; dy <= radius + 1; ++dy ) {
+        for( int dx = -radius - 1; dx <= radius + 1; ++dx ) {
+            const tripoint_abs_omt p = center + point( dx, dy );
+            CAPTURE( p );
+            const bool in_range = std::abs( dx ) <= radius && std::abs( dy ) <= radius &&
+                                  ( !trigdist || dx * dx + dy * dy <= radius * radius );
+            CHECK( ( overmap_buffer.seen( p ) == om_vision_level::full ) == in_range );
+        }
+    }
+    CHECK_FALSE( overmap_buffer.reveal( center, radius ) );
+}
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_catch.h"
+#include "game_constants.h"
+#include "line.h"
+#include "map.h"
+#include "map_helpers.h"
+#include "pathfinding.h"
+#include "point.h"
+#include "type_id.h"
+
+static const ter_str_id ter_t_brick_wall( "t_brick_wall" );
+
+static void check_path( const map &here, const std::vector<tripoint> &path, const tripoint &from,
+                        const tripoint &to )
+{
+    REQUIRE_FALSE( path.empty() );
+    CHECK( path.back() == to );
+    tripoint prev = from;
+    for( const tripoint &p : path ) {
+        CAPTURE( p );
+        CHECK( square_dist( prev, p ) == 1 );
+        CHECK( here.passable( tripoint_bub_ms( p ) ) );
+        prev = p;
+    }
+}
+
+TEST_CASE( "shared_route_finds_the_way_around_a_wall", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    // A wall with a single gap between the monsters and the target.
+    const tripoint target( 60, 60, 0 );
+    for( int y = 40; y <= 80; ++y ) {
+        if( y != 70 ) {
+            here.ter_set( tripoint_bub_ms( 55, y, 0 ), ter_t_brick_wall );
+        }
+    }
+    const pathfinding_settings settings( 0, 30, 150, 0, false, false, false, false, false, false );
+    const auto avoid_nothing = []( const tripoint & ) {
+        return false;
+    };
+    // Make sure this is a new turn for the shared fields.
+    calendar::turn += 1_turns;
+
+    const std::vector<tripoint> starts = { tripoint( 45, 55, 0 ), tripoint( 45, 65, 0 ), tripoint( 50, 50, 0 ) };
+    for( const tripoint &start : starts ) {
+        CAPTURE( start );
+        const std::vector<tripoint> shared = here.shared_route( start, target, settings, avoid_nothing );
+        const std::vector<tripoint> astar = here.route( start, target, settings, avoid_nothing );
+        check_path( here, shared, start, target );
+        check_path( here, astar, start, target );
+        // Going around the end of the wall would be much longer.
+        const tripoint gap( 55, 70, 0 );
+        CHECK( std::find( shared.begin(), shared.end(), gap ) != shared.end() );
+        CHECK( std::find( astar.begin(), astar.end(), gap ) != astar.end() );
+    }
+
+    SECTION( "avoided tiles are respected" ) {
+        calendar::turn += 1_turns;
+        here.shared_route( starts[1], target, settings, avoid_nothing );
+        const tripoint blocked( 55, 70, 0 );
+        const auto avoid_gap = [&]( const tripoint & p ) {
+            return p == blocked;
+        };
+        const std::vector<tripoint> path = here.shared_route( starts[0], target, settings, avoid_gap );
+        // Around the end of the wall instead.
+        check_path( here, path, starts[0], target );
+        CHECK( std::find( path.begin(), path.end(), blocked ) == path.end() );
+    }
+}
+
+TEST_CASE( "route_detours_beyond_the_local_search_box", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    // Much longer than the padding of the local search, open only at its far end.
+    for( int y = 10; y <= 110; ++y ) {
+        here.ter_set( tripoint_bub_ms( 40, y, 0 ), ter_t_brick_wall );
+    }
+    const pathfinding_settings settings( 0, 60, 400, 0, false, false, false, false, false, false );
+    const tripoint from( 30, 60, 0 );
+    const tripoint to( 50, 60, 0 );
+
+    const std::vector<tripoint> path = here.route( from, to, settings );
+    check_path( here, path, from, to );
+    // It has to go around one of the ends of the wall.
+    CHECK( std::any_of( path.begin(), path.end(), []( const tripoint & p ) {
+        return p.y < 10 || p.y > 110;
+    } ) );
+}
+
+TEST_CASE( "route_jumps_across_open_ground_without_losing_the_shortest_path", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    for( int y = 0; y < MAPSIZE_Y; ++y ) {
+        if( y != 50 ) {
+            here.ter_set( tripoint_bub_ms( 60, y, 0 ), ter_t_brick_wall );
+        }
+    }
+    const pathfinding_settings settings( 0, 30, 150, 0, false, false, false, false, false, false );
+    const tripoint from( 50, 60, 0 );
+    const tripoint to( 70, 60, 0 );
+
+    // Diagonally up to the gap and down again is as short as it gets.
+    const std::vector<tripoint> path = here.route( from, to, settings );
+    check_path( here, path, from, to );
+    CHECK( path.size() == 20 );
+    CHECK( std::find( path.begin(), path.end(), tripoint( 60, 50, 0 ) ) != path.end() );
+
+    // Blocking the diagonals through the gap costs a step on either side.
+    here.ter_set( tripoint_bub_ms( 59, 51, 0 ), ter_t_brick_wall );
+    here.ter_set( tripoint_bub_ms( 61, 51, 0 ), ter_t_brick_wall );
+    const std::vector<tripoint> around = here.route( from, to, settings );
+    check_path( here, around, from, to );
+    CHECK( around.size() == 22 );
+}
+
+TEST_CASE( "route_reuses_cached_paths_until_the_map_changes", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    for( int y = 50; y <= 70; ++y ) {
+        if( y != 60 ) {
+            here.ter_set( tripoint_bub_ms( 60, y, 0 ), ter_t_brick_wall );
+        }
+    }
+    const pathfinding_settings settings( 0, 30, 150, 0, false, false, false, false, false, false );
+    const tripoint from( 55, 55, 0 );
+    const tripoint to( 65, 62, 0 );
+
+    const std::vector<tripoint> first = here.route( from, to, settings );
+    check_path( here, first, from, to );
+    CHECK( here.route( from, to, settings ) == first );
+
+    // Further along the same path, the rest of it is returned.
+    const std::vector<tripoint> rest = here.route( first[2], to, settings );
+    CHECK( rest == std::vector<tripoint>( first.begin() + 3, first.end() ) );
+
+    // Closing the gap invalidates the cached path.
+    here.ter_set( tripoint_bub_ms( 60, 60, 0 ), ter_t_brick_wall );
+    const std::vector<tripoint> detour = here.route( from, to, settings );
+    check_path( here, detour, from, to );
+    CHECK( std::find( detour.begin(), detour.end(), tripoint( 60, 60, 0 ) ) == detour.end() );
+}
+
+TEST_CASE( "prepared_routes_match_routes_searched_on_demand", "[pathfinding]" )
+{
+    clear_map();
+    map &here = get_map();
+    // The gap is the only way through.
+    for( int y = 0; y < MAPSIZE_Y; ++y ) {
+        if( y != 60 ) {
+            here.ter_set( tripoint_bub_ms( 60, y, 0 ), ter_t_brick_wall );
+        }
+    }
+    const pathfinding_settings settings( 0, 30, 150, 0, false, false, false, false, false, false );
+    std::vector<route_request> requests;
+    for( int i = 0; i < 32; ++i ) {
+        requests.push_back( { tripoint( 50, 45 + i, 0 ), tripoint( 70, 45 + i, 0 ), settings } );
+    }
+    std::vector<std::vector<tripoint>> expected;
+    for( const route_request &req : requests ) {
+        expected.push_back( here.route( req.from, req.to, req.settings ) );
+    }
+
+    // Depending on the number of cores this may not search anything up front, either way
+    // the results must be the same.
+    here.prepare_routes( requests );
+    for( size_t i = 0; i < requests.size(); ++i ) {
+        const route_request &req = requests[i];
+        const std::vector<tripoint> path = here.route( req.from, req.to, req.settings );
+        check_path( here, path, req.from, req.to );
+        CHECK( path.size() == expected[i].size() );
+    }
+
+    // Something to avoid on the prepared path makes route search again.
+    here.prepare_routes( requests );
+    const tripoint gap( 60, 60, 0 );
+    const std::vector<tripoint> avoiding = here.route( requests[0].from, requests[0].to, settings,
+    [&gap]( const tripoint & p ) {
+        return p == gap;
+    } );
+    CHECK( avoiding.empty() );
+}
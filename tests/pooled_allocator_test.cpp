@@ -0,0 +1,43 @@
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+#include "cata_catch.h"
+#include "colony.h"
+#include "pooled_allocator.h"
+
+TEST_CASE( "pooled_allocator_reuses_freed_blocks", "[colony][nogame]" )
+{
+    cata::pooled_allocator<int64_t> alloc;
+    int64_t *first = alloc.allocate( 100 );
+    alloc.deallocate( first, 100 );
+    // A block of about the same size is handed the same memory.
+    int64_t *second = alloc.allocate( 98 );
+    CHECK( second == first );
+    second[97] = 1;
+    alloc.deallocate( second, 98 );
+
+    // Large blocks are not kept.
+    int64_t *large = alloc.allocate( 100000 );
+    large[99999] = 1;
+    alloc.deallocate( large, 100000 );
+}
+
+TEST_CASE( "colony_groups_come_from_the_pool", "[colony][nogame]" )
+{
+    // Large enough for its groups to be of another size than the group bookkeeping.
+    using element = std::array<int64_t, 8>;
+    static_assert( std::is_same_v<cata::colony<element>::allocator_type, cata::pooled_allocator<element>> );
+    const element *first_address = nullptr;
+    {
+        cata::colony<element> c;
+        first_address = &*c.insert( element{} );
+    }
+    // The group of a destroyed colony is reused by the next one.
+    cata::colony<element> c;
+    CHECK( &*c.insert( element{} ) == first_address );
+    for( int i = 0; i < 1000; ++i ) {
+        c.insert( element{ i } );
+    }
+    CHECK( c.size() == 1001 );
+}
@@ -1,10 +1,14 @@
+#include <array>
+#include <climits>
 #include <functional>
 #include <optional>
 #include <vector>
 
 #include "cata_catch.h"
+#include "point.h"
 #include "rng.h"
 #include "test_statistics.h"
+#include "weighted_list.h"
 
 static void check_remainder( float proportion )
 {
@@ -78,3 +82,123 @@ TEST_CASE( "random_entry_preserves_constness", "[rng]" )
     i1 = 5678;
     CHECK( v1[0] == 5678 );
 }
+
+static std::vector<int> draw_from_stream( unsigned int seed, const tripoint &key )
+{
+    std::optional<cata_default_random_engine> engine =
+        rng_stream_engine( seed, rng_stream::mapgen, key );
+    const rng_stream_scope scope( engine );
+    std::vector<int> result;
+    for( int i = 0; i < 16; ++i ) {
+        result.push_back( rng( 0, 1000000 ) );
+    }
+    return result;
+}
+
+TEST_CASE( "rng_streams_depend_only_on_seed_and_key", "[rng]" )
+{
+    const tripoint key( 12, -7, 0 );
+    const std::vector<int> first = draw_from_stream( 1234, key );
+    // Draws from the global engine in between don't change the stream.
+    rng( 0, 100 );
+    CHECK( draw_from_stream( 1234, key ) == first );
+    CHECK( draw_from_stream( 1234, key + tripoint_east ) != first );
+    CHECK( draw_from_stream( 4321, key ) != first );
+}
+
+TEST_CASE( "rng_stream_scope_leaves_global_engine_alone", "[rng]" )
+{
+    const cata_default_random_engine before = rng_get_engine();
+    draw_from_stream( 1234, tripoint_zero );
+    CHECK( rng_get_engine() == before );
+
+    // Without a world seed there is no stream, the global engine is used.
+    draw_from_stream( 0, tripoint_zero );
+    CHECK( rng_get_engine() != before );
+}
+
+TEST_CASE( "xoshiro256ss_matches_the_reference_sequence", "[rng]" )
+{
+    cata::xoshiro256ss engine( 1234 );
+    CHECK( engine() == 0x0bab45d9a0e3ae53ULL );
+    CHECK( engine() == 0xd7c640660c19433eULL );
+    CHECK( engine() == 0xb0dedaa0d09a6691ULL );
+
+    cata::xoshiro256ss same( 1234 );
+    CHECK( same != engine );
+    same.discard( 3 );
+    CHECK( same == engine );
+}
+
+TEST_CASE( "xoshiro256ss_ranges_are_uniform", "[rng]" )
+{
+    cata::xoshiro256ss engine( 42 );
+    // Chi-squared over the faces of a die.  With 9 degrees of freedom the statistic is above
+    // 27.88 in 0.1% of the runs; the seed is fixed, so this does not flicker.
+    constexpr int faces = 10;
+    constexpr int samples = 100000;
+    std::array<int, faces> counts{};
+    for( int i = 0; i < samples; ++i ) {
+        const int roll = engine.uniform_int( -3, faces - 4 );
+        REQUIRE( roll >= -3 );
+        REQUIRE( roll <= faces - 4 );
+        ++counts[roll + 3];
+    }
+    const double expected = static_cast<double>( samples ) / faces;
+    double chi_squared = 0.0;
+    for( const int count : counts ) {
+        chi_squared += ( count - expected ) * ( count - expected ) / expected;
+    }
+    CHECK( chi_squared < 27.88 );
+
+    statistics<double> stats;
+    for( int i = 0; i < samples; ++i ) {
+        const double u = engine.uniform_double();
+        REQUIRE( u >= 0.0 );
+        REQUIRE( u < 1.0 );
+        stats.add( u );
+    }
+    CHECK( stats.avg() == Approx( 0.5 ).margin( 0.005 ) );
+
+    // The whole int range does not overflow.
+    for( int i = 0; i < 1000; ++i ) {
+        engine.uniform_int( INT_MIN, INT_MAX );
+    }
+    CHECK( engine.uniform_int( 7, 7 ) == 7 );
+}
+
+static std::vector<double> pick_shares( const weighted_float_list<int> &list )
+{
+    // Sweep the whole range of random numbers evenly rather than sampling it.
+    constexpr int samples = 100000;
+    std::vector<double> shares( list.size() );
+    for( int i = 0; i < samples; i++ ) {
+        const unsigned int randi = static_cast<unsigned int>( UINT_MAX / samples * static_cast<double>( i ) );
+        shares[*list.pick( randi )] += 1.0 / samples;
+    }
+    return shares;
+}
+
+TEST_CASE( "weighted_float_list_alias_table_matches_weights", "[rng]" )
+{
+    const std::vector<double> weights = { 3.0, 0.0, 1.5, 5.5, 0.25 };
+    double total = 0;
+    weighted_float_list<int> list;
+    for( size_t i = 0; i < weights.size(); i++ ) {
+        list.add( static_cast<int>( i ), weights[i] );
+        total += weights[i];
+    }
+    const std::vector<double> linear = pick_shares( list );
+    list.precalc();
+    const std::vector<double> alias = pick_shares( list );
+    for( size_t i = 0; i < weights.size(); i++ ) {
+        CAPTURE( i );
+        CHECK( linear[i] == Approx( weights[i] / total ).margin( 0.001 ) );
+        CHECK( alias[i] == Approx( weights[i] / total ).margin( 0.001 ) );
+    }
+    CHECK( alias[1] == 0.0 );
+
+    // Changing the list drops the table until it is rebuilt.
+    list.add_or_replace( 1, 10.0 );
+    CHECK( pick_shares( list )[1] == Approx( 10.0 / ( total + 10.0 ) ).margin( 0.001 ) );
+}
@@ -1,5 +1,8 @@
+#include <optional>
+
 #include "calendar.h"
 #include "cata_catch.h"
+#include "coordinates.h"
 #include "enums.h"
 #include "item.h"
 #include "map.h"
@@ -134,3 +137,41 @@ TEST_CASE( "Hourly_rotpoints", "[rot]" )
     CHECK( normal_item.calc_hourly_rotpoints_at_temp( units::from_fahrenheit( 107 ) ) == Approx(
                20364.67 ) );
 }
+
+TEST_CASE( "Settled_food_waits_for_its_next_rot_threshold", "[rot]" )
+{
+    if( calendar::turn <= calendar::start_of_cataclysm ) {
+        calendar::turn = calendar::start_of_cataclysm + 1_minutes;
+    }
+    set_map_temperature( units::from_fahrenheit( 65 ) ); // 18,3 C
+
+    item food( "meat_cooked" );
+    food.process( get_map(), nullptr, tripoint_zero, 1, temperature_flag::NORMAL );
+    REQUIRE( food.active );
+    const time_duration shelf_life = food.get_shelf_life();
+
+    // At 65 F it rots at 1h/h, so it won't look old before 90% of its shelf life.
+    std::optional<time_point> settled = food.temperature_rot_settled_until( tripoint_bub_ms( tripoint_zero ),
+                                        temperature_flag::NORMAL, 1.0f );
+    REQUIRE( settled );
+    CHECK( to_turns<int>( *settled - calendar::turn ) ==
+           Approx( to_turns<int>( shelf_life * 0.9 ) ).epsilon( 0.01 ) );
+
+    // Next it turns rotten.
+    food.set_relative_rot( 0.95 );
+    settled = food.temperature_rot_settled_until( tripoint_bub_ms( tripoint_zero ), temperature_flag::NORMAL,
+              1.0f );
+    REQUIRE( settled );
+    CHECK( to_turns<int>( *settled - calendar::turn ) ==
+           Approx( to_turns<int>( shelf_life * 0.05 ) ).epsilon( 0.01 ) );
+
+    // Where it doesn't spoil there is nothing to wait for.
+    settled = food.temperature_rot_settled_until( tripoint_bub_ms( tripoint_zero ), temperature_flag::NORMAL,
+              0.0f );
+    CHECK( settled == calendar::turn_max );
+
+    // Not before it has warmed up to its surroundings.
+    set_map_temperature( units::from_fahrenheit( 85 ) );
+    CHECK_FALSE( food.temperature_rot_settled_until( tripoint_bub_ms( tripoint_zero ), temperature_flag::NORMAL,
+                 1.0f ) );
+}
@@ -0,0 +1,265 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "calendar.h"
+#include "cata_catch.h"
+#include "cata_path.h"
+#include "cata_scope_helpers.h"
+#include "colony.h"
+#include "coordinates.h"
+#include "filesystem.h"
+#include "game_constants.h"
+#include "item.h"
+#include "json.h"
+#include "json_loader.h"
+#include "mapbuffer.h"
+#include "memory_fast.h"
+#include "npc.h"
+#include "overmap.h"
+#include "path_info.h"
+#include "point.h"
+#include "ret_val.h"
+#include "string_formatter.h"
+#include "submap.h"
+#include "try_parse_integer.h"
+#include "type_id.h"
+#include "vehicle.h"
+
+// Save and load throughput over synthetic worlds.  Hidden, run them with
+//   cata_test "[savegame][benchmark]"
+// The scale is read from the environment, all of these are optional:
+//   CATA_BENCH_SUBMAPS          submaps written and read back (default 256, at most 4096)
+//   CATA_BENCH_ITEMS_PER_TILE   items on every tile of those submaps (default 2)
+//   CATA_BENCH_VEHICLES         submaps that also hold a vehicle (default 16)
+//   CATA_BENCH_NPCS             npcs on the saved overmap (default 50)
+//   CATA_BENCH_RUNS             runs per measurement, the fastest is reported (default 3)
+
+static const itype_id itype_test_rag( "test_rag" );
+
+static const ter_str_id ter_t_dirt( "t_dirt" );
+static const ter_str_id ter_t_floor( "t_floor" );
+
+static const vproto_id vehicle_prototype_bicycle( "bicycle" );
+
+namespace
+{
+
+struct bench_scale {
+    int submaps;
+    int items_per_tile;
+    int vehicles;
+    int npcs;
+    int runs;
+};
+
+struct bench_payload {
+    size_t bytes = 0;
+    size_t items = 0;
+};
+
+int scale_from_env( const char *name, int fallback )
+{
+    const char *value = std::getenv( name );
+    if( value == nullptr ) {
+        return fallback;
+    }
+    ret_val<int> parsed = try_parse_integer<int>( value, false );
+    if( !parsed.success() || parsed.value() < 0 ) {
+        return fallback;
+    }
+    return parsed.value();
+}
+
+bench_scale scale_from_env()
+{
+    bench_scale scale;
+    // One segment holds 64x64 submaps per z-level, the benchmark stays within one.
+    scale.submaps = std::min( scale_from_env( "CATA_BENCH_SUBMAPS", 256 ), 64 * 64 );
+    scale.items_per_tile = scale_from_env( "CATA_BENCH_ITEMS_PER_TILE", 2 );
+    scale.vehicles = scale_from_env( "CATA_BENCH_VEHICLES", 16 );
+    scale.npcs = scale_from_env( "CATA_BENCH_NPCS", 50 );
+    scale.runs = std::max( scale_from_env( "CATA_BENCH_RUNS", 3 ), 1 );
+    return scale;
+}
+
+// Runs @p setup untimed and then @p work, @p runs times, and prints the throughput of the
+// fastest run of @p work.
+void report_throughput( const std::string &name, int runs, const std::function<void()> &setup,
+                        const std::function<bench_payload()> &work )
+{
+    double best_seconds = 0.0;
+    bench_payload payload;
+    for( int run = 0; run < runs; ++run ) {
+        setup();
+        const auto start = std::chrono::steady_clock::now();
+        payload = work();
+        const auto end = std::chrono::steady_clock::now();
+        const double seconds = std::chrono::duration<double>( end - start ).count();
+        if( run == 0 || seconds < best_seconds ) {
+            best_seconds = seconds;
+        }
+    }
+    const double seconds = std::max( best_seconds, 1e-9 );
+    printf( "%-24s %9.2f MB/s %12.0f items/s  (%.2f ms, %zu bytes, %zu items)\n", name.c_str(),
+            static_cast<double>( payload.bytes ) / ( 1024.0 * 1024.0 ) / seconds,
+            static_cast<double>( payload.items ) / seconds, seconds * 1000.0, payload.bytes,
+            payload.items );
+}
+
+// Far away from anything the tests or the test world use.
+const tripoint_abs_seg bench_segment( 50, 50, 0 );
+
+tripoint_abs_sm bench_submap_pos( int index )
+{
+    return project_to<coords::sm>( bench_segment ) + tripoint( index % 64, index / 64, 0 );
+}
+
+std::unique_ptr<submap> make_bench_submap( const bench_scale &scale, int index )
+{
+    std::unique_ptr<submap> sm = std::make_unique<submap>();
+    sm->set_all_ter( ter_t_floor.id() );
+    for( int x = 0; x < SEEX; ++x ) {
+        for( int y = 0; y < SEEY; ++y ) {
+            const point_sm_ms p( x, y );
+            if( ( x + y + index ) % 5 == 0 ) {
+                sm->set_ter( p, ter_t_dirt.id() );
+            }
+            cata::colony<item> &items = sm->get_items( p );
+            for( int i = 0; i < scale.items_per_tile; ++i ) {
+                items.insert( item( itype_test_rag, calendar::turn_zero ) );
+            }
+        }
+    }
+    if( index < scale.vehicles ) {
+        std::unique_ptr<vehicle> veh = std::make_unique<vehicle>( vehicle_prototype_bicycle );
+        veh->sm_pos = bench_submap_pos( index ).raw();
+        veh->pos = point( SEEX / 2, SEEY / 2 );
+        sm->vehicles.push_back( std::move( veh ) );
+    }
+    return sm;
+}
+
+size_t directory_size( const cata_path &dir )
+{
+    size_t total = 0;
+    std::error_code ec;
+    for( const fs::directory_entry &entry : fs::recursive_directory_iterator(
+             dir.get_unrelative_path(), ec ) ) {
+        if( entry.is_regular_file( ec ) ) {
+            total += entry.file_size( ec );
+        }
+    }
+    return total;
+}
+
+} // namespace
+
+TEST_CASE( "mapbuffer_save_and_load_throughput", "[.][savegame][benchmark]" )
+{
+    const bench_scale scale = scale_from_env();
+    const cata_path segment_dir = PATH_INFO::world_base_save_path_path() / "maps" /
+                                  string_format( "%d.%d.%d", bench_segment.x(), bench_segment.y(),
+                                          bench_segment.z() );
+    const auto remove_segment = [&]() {
+        std::error_code ec;
+        fs::remove_all( segment_dir.get_unrelative_path(), ec );
+    };
+    remove_segment();
+    on_out_of_scope cleanup( remove_segment );
+
+    const size_t items = static_cast<size_t>( scale.submaps ) * SEEX * SEEY *
+                         scale.items_per_tile;
+    std::unique_ptr<mapbuffer> buffer;
+    const auto fill_buffer = [&]() {
+        remove_segment();
+        buffer = std::make_unique<mapbuffer>();
+        for( int i = 0; i < scale.submaps; ++i ) {
+            std::unique_ptr<submap> sm = make_bench_submap( scale, i );
+            buffer->add_submap( bench_submap_pos( i ), sm );
+        }
+    };
+    report_throughput( "mapbuffer::save", scale.runs, fill_buffer, [&]() {
+        buffer->save( true );
+        return bench_payload{ directory_size( segment_dir ), items };
+    } );
+
+    size_t loaded_items = 0;
+    report_throughput( "unserialize_submaps", scale.runs, [&]() {
+        buffer = std::make_unique<mapbuffer>();
+        loaded_items = 0;
+    }, [&]() {
+        for( int i = 0; i < scale.submaps; ++i ) {
+            const submap *sm = buffer->lookup_submap( bench_submap_pos( i ) );
+            loaded_items += sm == nullptr ? 0 : sm->get_items( point_sm_ms_zero ).size();
+        }
+        return bench_payload{ directory_size( segment_dir ), items };
+    } );
+    CHECK( loaded_items == static_cast<size_t>( scale.submaps * scale.items_per_tile ) );
+}
+
+TEST_CASE( "overmap_and_character_serialization_throughput", "[.][savegame][benchmark]" )
+{
+    const bench_scale scale = scale_from_env();
+    const point_abs_om pos( 97, -99 );
+    std::unique_ptr<overmap> om = std::make_unique<overmap>( pos );
+    for( int i = 0; i < scale.npcs; ++i ) {
+        shared_ptr_fast<npc> guy = make_shared_fast<npc>();
+        guy->normalize();
+        guy->randomize();
+        guy->spawn_at_omt( project_combine( pos, tripoint_om_omt( i % OMAPX, i / OMAPX, 0 ) ) );
+        om->insert_npc( guy );
+    }
+
+    std::string saved;
+    report_throughput( "overmap save", scale.runs, []() {}, [&]() {
+        std::ostringstream out;
+        om->serialize( out );
+        saved = out.str();
+        return bench_payload{ saved.size(), static_cast<size_t>( scale.npcs ) };
+    } );
+    // Drop the version line, unserialize takes the json after it.
+    const std::string saved_json = saved.substr( saved.find( '\n' ) );
+    size_t loaded_npcs = 0;
+    report_throughput( "overmap load", scale.runs, []() {}, [&]() {
+        overmap loaded( pos );
+        loaded.unserialize( json_loader::from_string( saved_json ).get_object() );
+        // Deserializes the deferred npcs as well.
+        loaded_npcs = loaded.get_npcs().size();
+        return bench_payload{ saved.size(), static_cast<size_t>( scale.npcs ) };
+    } );
+    CHECK( loaded_npcs == static_cast<size_t>( scale.npcs ) );
+
+    if( scale.npcs == 0 ) {
+        return;
+    }
+    const npc &guy = *om->get_npcs().front();
+    std::string character_json;
+    report_throughput( "character serialize", scale.runs, []() {}, [&]() {
+        std::ostringstream out;
+        JsonOut jsout( out );
+        for( int i = 0; i < scale.npcs; ++i ) {
+            guy.serialize( jsout );
+        }
+        character_json = out.str();
+        return bench_payload{ character_json.size(), static_cast<size_t>( scale.npcs ) };
+    } );
+    std::ostringstream single;
+    JsonOut single_out( single );
+    guy.serialize( single_out );
+    const std::string single_json = single.str();
+    report_throughput( "character deserialize", scale.runs, []() {}, [&]() {
+        for( int i = 0; i < scale.npcs; ++i ) {
+            npc copy;
+            copy.deserialize( json_loader::from_string( single_json ) );
+        }
+        return bench_payload{ single_json.size() * scale.npcs, static_cast<size_t>( scale.npcs ) };
+    } );
+}
@@ -1004,3 +1004,26 @@ TEST_CASE( "legacy_stats_tracker_save_loading", "[stats]" )
     CHECK( s.get_events( event_type::character_triggers_trap ).count() == 2 );
     CHECK( s.get_events( event_type::character_kills_monster ).count() == 0 );
 }
+
+TEST_CASE( "stats_tracker_values_follow_loaded_events", "[stats]" )
+{
+    const character_id u_id = get_player_character().getID();
+    stats_tracker saved;
+    event_bus b;
+    b.subscribe( &saved );
+    send_game_start( b, u_id );
+    b.send<event_type::character_kills_monster>( u_id, mon_zombie, 0 );
+    CHECK( score_score_kills->value( saved ).get<int>() == 1 );
+    b.send<event_type::character_kills_monster>( u_id, mon_dog, 0 );
+    CHECK( score_score_kills->value( saved ).get<int>() == 2 );
+
+    std::ostringstream os;
+    JsonOut jsout( os );
+    saved.serialize( jsout );
+
+    stats_tracker loaded;
+    // Asked for before loading, the value has to follow the loaded events.
+    CHECK( score_score_kills->value( loaded ).get<int>() == 0 );
+    loaded.deserialize( json_loader::from_string( os.str() ).get_object() );
+    CHECK( score_score_kills->value( loaded ).get<int>() == 2 );
+}
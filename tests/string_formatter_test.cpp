@@ -605,3 +605,42 @@ TEST_CASE( "string_formatter_errors" )
 
     CHECK_THROWS( test_for_error( "%d %d %d %d %d", 1, 2, 3, 4 ) );
 }
+
+// Runs the format string literal through both the compiled and the run time parsing.
+#define CHECK_COMPILED_FORMAT( expected, format, ... ) \
+    do { \
+        CHECK( string_format( CATA_FORMAT( format ), __VA_ARGS__ ) == ( expected ) ); \
+        CHECK( throwing_string_format( format, __VA_ARGS__ ) == ( expected ) ); \
+    } while( false )
+
+TEST_CASE( "string_formatter_compiled_format" )
+{
+    constexpr std::string_view format = "a%d %-5s|%%%2$s";
+    constexpr auto parsed = cata::parse_format<cata::max_format_pieces( format )>( format );
+    STATIC_REQUIRE( parsed.size == 7 );
+    STATIC_REQUIRE( parsed.num_arguments == 2 );
+    STATIC_REQUIRE( parsed.pieces[1].conversion == 'd' );
+    STATIC_REQUIRE( parsed.pieces[1].plain );
+    STATIC_REQUIRE( parsed.pieces[3].conversion == 's' );
+    STATIC_REQUIRE( !parsed.pieces[3].plain );
+    STATIC_REQUIRE( parsed.pieces[6].argument == 1 );
+
+    // The plain specifiers that bypass sprintf.
+    CHECK_COMPILED_FORMAT( "42%", "%d%%", 42 );
+    CHECK_COMPILED_FORMAT( "-9223372036854775808", "%lld",
+                           std::numeric_limits<long long>::min() );
+    CHECK_COMPILED_FORMAT( "18446744073709551615", "%u", -1 );
+    CHECK_COMPILED_FORMAT( "7 x", "%zu %c", static_cast<size_t>( 7 ), 'x' );
+    CHECK_COMPILED_FORMAT( "a b c d 12", "%s %s %s %s %s", "a", std::string( "b" ),
+                           std::string_view( "c" ), 'd', 12 );
+    CHECK_COMPILED_FORMAT( "1.500000", "%s", 1.5 );
+    // Everything else still goes through sprintf.
+    CHECK_COMPILED_FORMAT( "  x|-3  |1.50", "%3s|%-4d|%.2f", "x", -3, 1.5 );
+    CHECK_COMPILED_FORMAT( "ff 0XFF 0010", "%x %#X %04d", 255, 255, 10 );
+    CHECK_COMPILED_FORMAT( "b a b", "%2$s %1$s %2$s", "a", "b" );
+    CHECK_COMPILED_FORMAT( "x", "%1$s", "x" );
+    CHECK( string_format( CATA_FORMAT( "no arguments" ) ) == "no arguments" );
+    // Mismatching arguments are run time errors, as they are without CATA_FORMAT.
+    CHECK( string_format( CATA_FORMAT( "%d" ), "string" ).find( "Tried to convert" ) !=
+           std::string::npos );
+}
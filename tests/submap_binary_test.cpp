@@ -0,0 +1,75 @@
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "cata_catch.h"
+#include "coordinates.h"
+#include "game_constants.h"
+#include "point.h"
+#include "submap.h"
+#include "submap_binary.h"
+#include "type_id.h"
+
+static const furn_str_id furn_f_bookcase( "f_bookcase" );
+
+static const ter_str_id ter_t_dirt( "t_dirt" );
+static const ter_str_id ter_t_floor( "t_floor" );
+static const ter_str_id ter_t_rock_floor( "t_rock_floor" );
+
+TEST_CASE( "submap_binary_round_trip", "[submap][binary]" )
+{
+    submap uniform;
+    uniform.set_all_ter( ter_t_rock_floor, true );
+    REQUIRE( uniform.is_uniform() );
+
+    submap detailed;
+    detailed.set_all_ter( ter_t_dirt );
+    detailed.set_ter( point_sm_ms( 3, 4 ), ter_t_floor );
+    detailed.set_ter( point_sm_ms( SEEX - 1, SEEY - 1 ), ter_t_floor );
+    detailed.set_furn( point_sm_ms( 5, 6 ), furn_f_bookcase );
+    detailed.set_radiation( point_sm_ms( 1, 2 ), 7 );
+
+    const tripoint_abs_sm first( 12, -34, 0 );
+    const tripoint_abs_sm second( 13, -34, 0 );
+    const std::vector<std::pair<tripoint_abs_sm, submap *>> quad = {
+        { first, &uniform }, { second, &detailed }
+    };
+    const std::string data = submap_binary::write_quad( quad, 1 );
+    REQUIRE( submap_binary::is_binary_quad( data ) );
+    CHECK_FALSE( submap_binary::is_binary_quad( "[{\"version\":1}]" ) );
+
+    std::vector<std::pair<tripoint_abs_sm, std::unique_ptr<submap>>> loaded;
+    submap_binary::read_quad( data, [&]( const tripoint_abs_sm & pos, std::unique_ptr<submap> &sm,
+    int version ) {
+        CHECK( version == 1 );
+        loaded.emplace_back( pos, std::move( sm ) );
+    } );
+
+    REQUIRE( loaded.size() == 2 );
+    CHECK( loaded[0].first == first );
+    CHECK( loaded[1].first == second );
+    for( int x = 0; x < SEEX; ++x ) {
+        for( int y = 0; y < SEEY; ++y ) {
+            const point_sm_ms p( x, y );
+            CAPTURE( p );
+            CHECK( loaded[0].second->get_ter( p ) == uniform.get_ter( p ) );
+            CHECK( loaded[1].second->get_ter( p ) == detailed.get_ter( p ) );
+            CHECK( loaded[1].second->get_furn( p ) == detailed.get_furn( p ) );
+            CHECK( loaded[1].second->get_radiation( p ) == detailed.get_radiation( p ) );
+        }
+    }
+}
+
+TEST_CASE( "submap_binary_rejects_truncated_data", "[submap][binary]" )
+{
+    submap sm;
+    sm.set_all_ter( ter_t_dirt );
+    const std::vector<std::pair<tripoint_abs_sm, submap *>> quad = {
+        { tripoint_abs_sm( 0, 0, 0 ), &sm }
+    };
+    const std::string data = submap_binary::write_quad( quad, 1 );
+    const std::string truncated = data.substr( 0, data.size() / 2 );
+    CHECK_THROWS( submap_binary::read_quad( truncated, []( const tripoint_abs_sm &,
+    std::unique_ptr<submap> &, int ) {} ) );
+}
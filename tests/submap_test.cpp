@@ -1,7 +1,10 @@
 #include "cata_catch.h"
 #include "submap.h"
 
+#include <optional>
+
 #include "game_constants.h"
+#include "mapdata.h"
 #include "point.h"
 #include "type_id.h"
 
@@ -115,3 +118,130 @@ TEST_CASE( "submap_rotation2", "[submap]" )
         }
     }
 }
+
+TEST_CASE( "submap_modification_tracking", "[submap]" )
+{
+    submap sm;
+    REQUIRE( sm.needs_saving() );
+
+    sm.mark_saved();
+    CHECK_FALSE( sm.needs_saving() );
+
+    SECTION( "const access does not dirty the submap" ) {
+        const submap &csm = sm;
+        CHECK( csm.get_ter( point_sm_ms_zero ) == sm.get_ter( point_sm_ms_zero ) );
+        CHECK( csm.get_items( point_sm_ms_zero ).empty() );
+        CHECK_FALSE( sm.needs_saving() );
+    }
+
+    SECTION( "terrain changes dirty the submap" ) {
+        sm.set_ter( point_sm_ms_zero, ter_id( 1 ) );
+        CHECK( sm.needs_saving() );
+        sm.mark_saved();
+        CHECK_FALSE( sm.needs_saving() );
+    }
+
+    SECTION( "mutable item access dirties the submap" ) {
+        sm.ensure_nonuniform();
+        sm.mark_saved();
+        sm.get_items( point_sm_ms_zero );
+        CHECK( sm.needs_saving() );
+    }
+
+    SECTION( "direct changes need an explicit mark" ) {
+        sm.mark_modified();
+        CHECK( sm.needs_saving() );
+    }
+}
+
+TEST_CASE( "submap_stays_uniform_on_writes_that_change_nothing", "[submap]" )
+{
+    submap sm;
+    sm.set_all_ter( ter_id( 1 ), true );
+    REQUIRE( sm.is_uniform() );
+    const point_sm_ms p( 4, 7 );
+
+    sm.set_ter( p, ter_id( 1 ) );
+    sm.set_furn( p, furn_str_id::NULL_ID() );
+    sm.set_trap( p, tr_null );
+    sm.set_radiation( p, 0 );
+    sm.set_lum( p, 0 );
+    sm.set_all_furn( furn_str_id::NULL_ID() );
+    sm.set_all_traps( tr_null );
+    CHECK( sm.is_uniform() );
+    CHECK( sm.get_scent_weights()[p] == sm.get_scent_weights()[point_sm_ms_zero] );
+
+    sm.set_radiation( p, 5 );
+    CHECK_FALSE( sm.is_uniform() );
+    CHECK( sm.get_ter( point_sm_ms_zero ) == ter_id( 1 ) );
+    CHECK( sm.get_radiation( p ) == 5 );
+}
+
+TEST_CASE( "submap_scent_weights_follow_terrain_changes", "[submap]" )
+{
+    std::optional<ter_id> blocking;
+    std::optional<ter_id> open;
+    for( size_t i = 0; i < ter_t::count(); ++i ) {
+        const ter_id ter( static_cast<int>( i ) );
+        if( ter->has_flag( ter_furn_flag::TFLAG_NO_SCENT ) ) {
+            blocking = blocking.value_or( ter );
+        } else if( !ter->has_flag( ter_furn_flag::TFLAG_REDUCE_SCENT ) ) {
+            open = open.value_or( ter );
+        }
+    }
+    REQUIRE( blocking );
+    REQUIRE( open );
+
+    submap sm;
+    sm.set_all_ter( *open );
+    sm.set_all_furn( furn_str_id::NULL_ID() );
+    const point_sm_ms p( 3, 5 );
+    CHECK( sm.get_scent_weights()[p] == 10 );
+
+    sm.set_ter( p, *blocking );
+    CHECK( sm.get_scent_weights()[p] == 0 );
+
+    sm.rotate( 1 );
+    CHECK( sm.get_scent_weights()[p] == 10 );
+    CHECK( sm.get_scent_weights()[point_sm_ms( p.rotate( 1, { SEEX, SEEY } ) )] == 0 );
+}
+
+TEST_CASE( "submap_content_counts_follow_the_setters", "[submap]" )
+{
+    submap sm;
+    sm.set_all_ter( ter_id( 1 ), true );
+    CHECK( sm.trap_count() == 0 );
+    CHECK( sm.furn_count() == 0 );
+    CHECK( sm.lum_count() == 0 );
+
+    const point_sm_ms p( 4, 7 );
+    const point_sm_ms q( 2, 3 );
+    sm.set_trap( p, trap_id( 1 ) );
+    sm.set_trap( p, trap_id( 1 ) );
+    sm.set_furn( p, furn_id( 1 ) );
+    sm.set_furn( q, furn_id( 1 ) );
+    sm.set_lum( q, 2 );
+    CHECK( sm.trap_count() == 1 );
+    CHECK( sm.furn_count() == 2 );
+    CHECK( sm.lum_count() == 1 );
+
+    sm.set_trap( p, tr_null );
+    sm.set_furn( q, furn_str_id::NULL_ID() );
+    sm.set_lum( q, 0 );
+    CHECK( sm.trap_count() == 0 );
+    CHECK( sm.furn_count() == 1 );
+    CHECK( sm.lum_count() == 0 );
+
+    sm.set_all_traps( trap_id( 1 ) );
+    sm.set_all_furn( furn_str_id::NULL_ID() );
+    CHECK( sm.trap_count() == SEEX * SEEY );
+    CHECK( sm.furn_count() == 0 );
+
+    // Rotating moves the contents around without changing how much there is.
+    sm.set_furn( q, furn_id( 1 ) );
+    sm.rotate( 1 );
+    sm.count_contents();
+    CHECK( sm.trap_count() == SEEX * SEEY );
+    CHECK( sm.furn_count() == 1 );
+    CHECK( sm.lum_count() == 0 );
+}
@@ -5,14 +5,19 @@
 #define CATCH_CONFIG_RUNNER
 #include <algorithm>
 #include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
 #include <ctime>
 #include <exception>
+#include <fstream>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <ostream>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -24,6 +29,9 @@
 #else
 #include <unistd.h>
 #endif
+#if defined(_WIN32) && !defined(_MSC_VER)
+#include "mingw.thread.h"
+#endif
 
 #include "avatar.h"
 #include "cached_options.h"
@@ -37,6 +45,8 @@
 #include "game.h"
 #include "help.h"
 #include "json.h"
+#include "json_error.h"
+#include "json_loader.h"
 #include "map.h"
 #include "messages.h"
 #include "options.h"
@@ -44,7 +54,10 @@
 #include "overmap.h"
 #include "overmapbuffer.h"
 #include "path_info.h"
+#include "ret_val.h"
 #include "rng.h"
+#include "string_formatter.h"
+#include "try_parse_integer.h"
 #include "type_id.h"
 #include "weather.h"
 #include "worldfactory.h"
@@ -67,6 +80,27 @@ static bool fail_to_init_game_state{ false };
 
 static bool needs_game{ false };
 
+static std::string test_durations_path;
+static std::string test_durations_out_path;
+// Seconds each test case took, by test name: as loaded from test_durations_path and as
+// measured in this run.
+static std::map<std::string, double> recorded_durations;
+static std::map<std::string, double> measured_durations;
+
+struct benchmark_result {
+    std::string test_case;
+    std::string name;
+    int samples;
+    int iterations;
+    // All in nanoseconds per run of the benchmark.
+    double mean;
+    double mean_lower_bound;
+    double mean_upper_bound;
+    double standard_deviation;
+};
+static std::string benchmark_json_path;
+static std::vector<benchmark_result> benchmark_results;
+
 static std::vector<mod_id> extract_mod_selection( const std::string_view mod_string )
 {
     std::vector<std::string> mod_names = string_split( mod_string, ',' );
@@ -197,9 +231,244 @@ static option_overrides_t extract_option_overrides( const std::string_view optio
     return ret;
 }
 
+static std::map<std::string, double> load_test_durations( const std::string &path )
+{
+    std::map<std::string, double> ret;
+    const std::string data = read_entire_file( path );
+    if( data.empty() ) {
+        return ret;
+    }
+    try {
+        JsonObject jo = json_loader::from_string( data ).get_object();
+        for( const JsonMember member : jo ) {
+            ret[member.name()] = member.get_float();
+        }
+    } catch( const JsonError &err ) {
+        printf( "Ignoring the test durations in %s: %s\n", path.c_str(), err.what() );
+        ret.clear();
+    }
+    return ret;
+}
+
+static void save_test_durations( const std::string &path,
+                                 const std::map<std::string, double> &durations )
+{
+    try {
+        write_to_file( path, [&]( std::ostream & fout ) {
+            JsonOut jsout( fout, true );
+            jsout.start_object();
+            for( const std::pair<const std::string, double> &test : durations ) {
+                jsout.member( test.first, test.second );
+            }
+            jsout.end_object();
+        } );
+    } catch( const std::exception &err ) {
+        printf( "Saving the test durations to %s failed: %s\n", path.c_str(), err.what() );
+    }
+}
+
+// Splits the tests @p names into @p num_shards shards of about the same run time and returns
+// the names in shard @p shard (0-based).  The longest tests are handed out first, each to the
+// shard with the least work so far.  Tests without a recorded duration count as the average
+// of those with one.  Every shard process computes the same split from the same input.
+static std::vector<std::string> tests_of_shard( const std::vector<std::string> &names,
+        const std::map<std::string, double> &durations, const int shard, const int num_shards )
+{
+    std::vector<std::pair<double, std::string>> tests;
+    double known_total = 0.0;
+    int known = 0;
+    for( const std::string &name : names ) {
+        const auto it = durations.find( name );
+        if( it != durations.end() ) {
+            known_total += it->second;
+            ++known;
+        }
+    }
+    const double fallback = known == 0 ? 1.0 : known_total / known;
+    for( const std::string &name : names ) {
+        const auto it = durations.find( name );
+        tests.emplace_back( it == durations.end() ? fallback : it->second, name );
+    }
+    std::sort( tests.begin(), tests.end(), []( const std::pair<double, std::string> &l,
+    const std::pair<double, std::string> &r ) {
+        return l.first != r.first ? l.first > r.first : l.second < r.second;
+    } );
+
+    std::vector<double> load( num_shards, 0.0 );
+    std::vector<std::string> ret;
+    for( const std::pair<double, std::string> &test : tests ) {
+        const int target = static_cast<int>( std::min_element( load.begin(), load.end() ) -
+                                             load.begin() );
+        load[target] += test.first;
+        if( target == shard ) {
+            ret.push_back( test.second );
+        }
+    }
+    return ret;
+}
+
+// A test spec matching exactly the test named @p name, as Catch2 builds from --input-file.
+static std::string exact_test_spec( const std::string &name )
+{
+    std::string ret = "\"";
+    for( const char c : name ) {
+        if( c == '\\' || c == '"' || c == ',' ) {
+            ret += '\\';
+        }
+        ret += c;
+    }
+    return ret + "\",";
+}
+
+static std::string shell_quote( const std::string &arg )
+{
+#if defined(_WIN32)
+    return "\"" + arg + "\"";
+#else
+    std::string ret = "'";
+    for( const char c : arg ) {
+        if( c == '\'' ) {
+            ret += "'\\''";
+        } else {
+            ret += c;
+        }
+    }
+    return ret + "'";
+#endif
+}
+
+// The arguments in @p args (without the program name), except the options @p dropped together
+// with their values.
+static std::vector<std::string> args_without( const std::vector<const char *> &args,
+        const std::vector<std::string> &dropped )
+{
+    std::vector<std::string> ret;
+    for( size_t i = 1; i < args.size(); ++i ) {
+        const std::string arg = args[i];
+        bool drop = false;
+        for( const std::string &opt : dropped ) {
+            if( arg == opt ) {
+                // The value is the next argument.
+                ++i;
+                drop = true;
+            } else if( string_starts_with( arg, opt + "=" ) ||
+                       string_starts_with( arg, opt + ":" ) ) {
+                drop = true;
+            }
+        }
+        if( !drop ) {
+            ret.push_back( arg );
+        }
+    }
+    return ret;
+}
+
+// Runs this executable once per shard, all of them at the same time, and prints the output of
+// each shard once it is done.  Every shard gets its own user dir for its test world.  They
+// share the data dir and so the flexbuffer cache, whose files are written aside and renamed
+// into place, so a shard never maps another one's half written file.
+static int run_shards_in_parallel( const std::vector<const char *> &args, const int num_shards,
+                                   const unsigned int seed )
+{
+    std::vector<std::string> forwarded = args_without( args, {
+        "--parallel", "--shard", "--user-dir", "--test-durations-out", "--rng-seed"
+    } );
+    assure_dir_exist( user_dir );
+
+    std::mutex output_mutex;
+    int failed = 0;
+    const auto run_shard = [&]( const int shard ) {
+        const std::string shard_dir = string_format( "%sshard-%d/", user_dir, shard + 1 );
+        std::string command = shell_quote( args[0] );
+        for( const std::string &arg : forwarded ) {
+            command += " " + shell_quote( arg );
+        }
+        command += string_format( " --shard %d/%d --user-dir %s", shard + 1, num_shards,
+                                  shell_quote( shard_dir ) );
+        if( seed ) {
+            // One seed for all of them, so the run can be repeated.
+            command += string_format( " --rng-seed %u", seed );
+        }
+        if( !test_durations_path.empty() ) {
+            command += " --test-durations-out " + shell_quote( shard_dir + "durations.json" );
+        }
+        const std::string log_path = string_format( "%sshard-%d.log", user_dir, shard + 1 );
+        command += " > " + shell_quote( log_path ) + " 2>&1";
+#if defined(_WIN32)
+        // cmd.exe strips the outermost quotes.
+        command = "\"" + command + "\"";
+#endif
+        const int status = std::system( command.c_str() );
+
+        std::lock_guard<std::mutex> lock( output_mutex );
+        printf( "===== Shard %d/%d %s =====\n%s\n", shard + 1, num_shards,
+                status == 0 ? "passed" : "FAILED", read_entire_file( log_path ).c_str() );
+        fflush( stdout );
+        if( status != 0 ) {
+            ++failed;
+        }
+    };
+    const auto start_time = std::chrono::steady_clock::now();
+    std::vector<std::thread> shards;
+    for( int shard = 0; shard < num_shards; ++shard ) {
+        shards.emplace_back( run_shard, shard );
+    }
+    for( std::thread &shard : shards ) {
+        shard.join();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start_time;
+
+    if( !test_durations_path.empty() ) {
+        std::map<std::string, double> durations = recorded_durations;
+        for( int shard = 0; shard < num_shards; ++shard ) {
+            for( const std::pair<const std::string, double> &test : load_test_durations(
+                     string_format( "%sshard-%d/durations.json", user_dir, shard + 1 ) ) ) {
+                durations[test.first] = test.second;
+            }
+        }
+        save_test_durations( test_durations_path, durations );
+    }
+    printf( "%d of %d shards failed, finished in %.1f seconds\n", failed, num_shards,
+            elapsed.count() );
+    return failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+// Writes the results in a form meant for tracking them from run to run.
+static void save_benchmark_results( const std::string &path )
+{
+    try {
+        write_to_file( path, [&]( std::ostream & fout ) {
+            JsonOut jsout( fout, true );
+            jsout.start_object();
+            jsout.member( "time", static_cast<int64_t>( std::time( nullptr ) ) );
+            jsout.member( "unit", "ns" );
+            jsout.member( "benchmarks" );
+            jsout.start_array();
+            for( const benchmark_result &result : benchmark_results ) {
+                jsout.start_object();
+                jsout.member( "test_case", result.test_case );
+                jsout.member( "name", result.name );
+                jsout.member( "samples", result.samples );
+                jsout.member( "iterations", result.iterations );
+                jsout.member( "mean", result.mean );
+                jsout.member( "mean_lower_bound", result.mean_lower_bound );
+                jsout.member( "mean_upper_bound", result.mean_upper_bound );
+                jsout.member( "standard_deviation", result.standard_deviation );
+                jsout.end_object();
+            }
+            jsout.end_array();
+            jsout.end_object();
+        } );
+    } catch( const std::exception &err ) {
+        printf( "Saving the benchmark results to %s failed: %s\n", path.c_str(), err.what() );
+    }
+}
+
 struct CataListener : Catch::TestEventListenerBase {
     using TestEventListenerBase::TestEventListenerBase;
 
+    std::chrono::steady_clock::time_point test_case_start;
+
     void testRunStarting( Catch::TestRunInfo const & ) override {
         if( needs_game ) {
             try {
@@ -224,6 +493,31 @@ struct CataListener : Catch::TestEventListenerBase {
         end = std::chrono::system_clock::now();
     }
 
+    void testCaseStarting( Catch::TestCaseInfo const &testInfo ) override {
+        TestEventListenerBase::testCaseStarting( testInfo );
+        test_case_start = std::chrono::steady_clock::now();
+    }
+
+    void testCaseEnded( Catch::TestCaseStats const &testCaseStats ) override {
+        TestEventListenerBase::testCaseEnded( testCaseStats );
+        const std::chrono::duration<double> took = std::chrono::steady_clock::now() -
+                test_case_start;
+        // NOLINTNEXTLINE(cata-tests-must-restore-global-state)
+        measured_durations[testCaseStats.testInfo.name] = took.count();
+    }
+
+#if defined(CATCH_CONFIG_ENABLE_BENCHMARKING)
+    void benchmarkEnded( Catch::BenchmarkStats<> const &stats ) override {
+        TestEventListenerBase::benchmarkEnded( stats );
+        // NOLINTNEXTLINE(cata-tests-must-restore-global-state)
+        benchmark_results.push_back( {
+            currentTestCaseInfo->name, stats.info.name, stats.info.samples, stats.info.iterations,
+            stats.mean.point.count(), stats.mean.lower_bound.count(),
+            stats.mean.upper_bound.count(), stats.standardDeviation.point.count()
+        } );
+    }
+#endif
+
     void sectionStarting( Catch::SectionInfo const &sectionInfo ) override {
         TestEventListenerBase::sectionStarting( sectionInfo );
         // Initialize the cata RNG with the Catch seed for reproducible tests
@@ -300,6 +594,8 @@ int main( int argc, const char *argv[] )
     std::string option_overrides;
     std::string mods_string;
     std::string check_plural_str;
+    std::string shard_str;
+    int parallel_shards = 1;
     Parser cli = session.cli()
                  | Opt( mods_string, "mod1,mod2,…" )
                  ["--mods"]
@@ -319,6 +615,21 @@ int main( int argc, const char *argv[] )
                  | Opt( check_plural_str, "none|certain|possbile" )
                  ["--check-plural"]
                  ( "[CataclysmDDA] (TBW)" )
+                 | Opt( shard_str, "i/n" )
+                 ["--shard"]
+                 ( "[CataclysmDDA] Run only the i-th of n shards of about equal run time of the selected tests." )
+                 | Opt( parallel_shards, "n" )
+                 ["--parallel"]
+                 ( "[CataclysmDDA] Run the selected tests as n shards in parallel processes, 0 for one per core." )
+                 | Opt( test_durations_path, "filename" )
+                 ["--test-durations"]
+                 ( "[CataclysmDDA] Balance shards by the test durations in this file and update it with the measured ones." )
+                 | Opt( test_durations_out_path, "filename" )
+                 ["--test-durations-out"]
+                 ( "[CataclysmDDA] Write only the test durations measured in this run to this file instead." )
+                 | Opt( benchmark_json_path, "filename" )
+                 ["--benchmark-json"]
+                 ( "[CataclysmDDA] Write the results of the benchmarks that ran to this file as json." )
                  ;
     session.cli( cli );
 
@@ -368,6 +679,38 @@ int main( int argc, const char *argv[] )
         return EXIT_FAILURE;
     }
 
+    int shard_index = 0;
+    int num_shards = 1;
+    if( !shard_str.empty() ) {
+        const std::vector<std::string> parts = string_split( shard_str, '/' );
+        ret_val<int> index = ret_val<int>::make_failure( 0 );
+        ret_val<int> count = ret_val<int>::make_failure( 0 );
+        if( parts.size() == 2 ) {
+            index = try_parse_integer<int>( parts[0], false );
+            count = try_parse_integer<int>( parts[1], false );
+        }
+        if( !index.success() || !count.success() || count.value() < 1 || index.value() < 1 ||
+            index.value() > count.value() ) {
+            printf( "Invalid shard %s, expected i/n with 1 <= i <= n", shard_str.c_str() );
+            return EXIT_FAILURE;
+        }
+        shard_index = index.value() - 1;
+        num_shards = count.value();
+    }
+    if( parallel_shards == 0 ) {
+        parallel_shards = std::max( 1U, std::thread::hardware_concurrency() );
+    }
+    if( parallel_shards < 0 || ( parallel_shards > 1 && num_shards > 1 ) ) {
+        printf( "--parallel needs a positive number of shards and can't be combined with --shard" );
+        return EXIT_FAILURE;
+    }
+    if( !test_durations_path.empty() ) {
+        recorded_durations = load_test_durations( test_durations_path );
+    }
+    if( parallel_shards > 1 ) {
+        return run_shards_in_parallel( arg_vec, parallel_shards, session.config().rngSeed() );
+    }
+
     // NOLINTNEXTLINE(cata-tests-must-restore-global-state)
     test_mode = true;
 
@@ -389,6 +732,28 @@ int main( int argc, const char *argv[] )
         DebugLog( D_INFO, DC_ALL ) << "Default randomness seeded to: " << rng_get_first_seed();
     }
 
+    if( num_shards > 1 ) {
+        using namespace Catch;
+        Config const &config = session.config();
+        std::vector<std::string> names;
+        for( TestCase const &tc : filterTests( getAllTestCasesSorted( config ), config.testSpec(),
+                                               config ) ) {
+            names.push_back( tc.getTestCaseInfo().name );
+        }
+        const std::vector<std::string> shard_tests = tests_of_shard( names, recorded_durations,
+                shard_index, num_shards );
+        if( shard_tests.empty() ) {
+            DebugLog( D_INFO, DC_ALL ) << "No tests in shard " << shard_str;
+            return EXIT_SUCCESS;
+        }
+        ConfigData data = session.configData();
+        data.testsOrTags.clear();
+        for( const std::string &name : shard_tests ) {
+            data.testsOrTags.push_back( exact_test_spec( name ) );
+        }
+        session.useConfigData( data );
+    }
+
     // Tests not requiring the global game initialized are tagged with [nogame]
     {
         using namespace Catch;
@@ -437,6 +802,18 @@ int main( int argc, const char *argv[] )
         }
     }
 
+    if( !benchmark_json_path.empty() ) {
+        save_benchmark_results( benchmark_json_path );
+    }
+    if( !test_durations_out_path.empty() ) {
+        save_test_durations( test_durations_out_path, measured_durations );
+    } else if( !test_durations_path.empty() ) {
+        for( const std::pair<const std::string, double> &test : measured_durations ) {
+            recorded_durations[test.first] = test.second;
+        }
+        save_test_durations( test_durations_path, recorded_durations );
+    }
+
     std::chrono::duration<double> elapsed_seconds = end - start;
     DebugLog( D_INFO, DC_ALL ) << "Finished in " << elapsed_seconds.count() << " seconds";
 
@@ -0,0 +1,105 @@
+#include "cata_catch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "thread_pool.h"
+
+TEST_CASE( "thread_pool_runs_every_task", "[thread_pool][nogame]" )
+{
+    std::atomic<int> sum( 0 );
+    thread_pool pool( 3, 2 );
+    for( int i = 1; i <= 100; ++i ) {
+        pool.push( [&sum, i]() {
+            sum += i;
+        } );
+    }
+    pool.wait();
+    CHECK( sum == 5050 );
+    CHECK( pool.num_completed() == 100 );
+    CHECK( pool.size() == 3 );
+}
+
+TEST_CASE( "thread_pool_timed_push_respects_queue_bound", "[thread_pool][nogame]" )
+{
+    std::atomic<bool> release( false );
+    thread_pool pool( 1, 1 );
+    const auto blocker = [&release]() {
+        while( !release ) {
+            std::this_thread::yield();
+        }
+    };
+    pool.push( blocker );
+    // Blocks until the worker has taken the first task, so this one stays queued.
+    pool.push( blocker );
+    std::function<void()> overflow = blocker;
+    CHECK_FALSE( pool.push_for( overflow, std::chrono::milliseconds( 1 ) ) );
+    // A rejected task is not consumed.
+    CHECK( static_cast<bool>( overflow ) );
+    CHECK_FALSE( pool.wait_for( std::chrono::milliseconds( 1 ) ) );
+    release = true;
+    pool.wait();
+    CHECK( pool.num_completed() == 2 );
+}
+
+TEST_CASE( "thread_pool_rethrows_task_exceptions", "[thread_pool][nogame]" )
+{
+    thread_pool pool( 2 );
+    pool.push( []() {
+        throw std::runtime_error( "task failed" );
+    } );
+    pool.push( []() {} );
+    CHECK_THROWS_AS( pool.wait(), std::runtime_error );
+    // The failure is only reported once.
+    CHECK_NOTHROW( pool.wait() );
+    CHECK( pool.num_completed() == 2 );
+}
+
+TEST_CASE( "parallel_for_calls_every_index_once", "[thread_pool][nogame]" )
+{
+    std::vector<std::atomic<int>> calls( 1000 );
+    parallel_for( calls.size(), [&calls]( size_t i ) {
+        ++calls[i];
+    } );
+    CHECK( std::all_of( calls.begin(), calls.end(), []( const std::atomic<int> &n ) {
+        return n == 1;
+    } ) );
+
+    // Nested calls run on the pool's own threads, the callers take part so they finish.
+    std::atomic<int> sum( 0 );
+    parallel_for( 16, [&sum]( size_t ) {
+        parallel_for( 16, [&sum]( size_t j ) {
+            sum += static_cast<int>( j );
+        } );
+    } );
+    CHECK( sum == 16 * 120 );
+}
+
+TEST_CASE( "parallel_for_rethrows_after_every_index", "[thread_pool][nogame]" )
+{
+    std::atomic<int> calls( 0 );
+    CHECK_THROWS_AS( parallel_for( 100, [&calls]( size_t i ) {
+        ++calls;
+        if( i == 10 ) {
+            throw std::runtime_error( "index failed" );
+        }
+    } ), std::runtime_error );
+    CHECK( calls == 100 );
+}
+
+TEST_CASE( "thread_pool_knows_its_worker_threads", "[thread_pool][nogame]" )
+{
+    CHECK_FALSE( thread_pool::on_worker_thread() );
+    std::atomic<bool> on_worker( false );
+    thread_pool pool( 1 );
+    pool.push( [&on_worker]() {
+        on_worker = thread_pool::on_worker_thread();
+    } );
+    pool.wait();
+    CHECK( on_worker );
+}
@@ -1,7 +1,10 @@
 #include "avatar.h"
 #include "cata_catch.h"
+#include "item.h"
 #include "itype.h"
 #include "player_helpers.h"
+#include "pocket_type.h"
+#include "ret_val.h"
 #include "type_id.h"
 
 static const quality_id qual_BOIL( "BOIL" );
@@ -206,3 +209,35 @@ TEST_CASE( "battery-powered_tool_qualities", "[tool][battery][quality]" )
     }
 }
 
+
+// Quality queries on a container stop at the container when its own quality (which already
+// includes the best of its contents) decides the answer, but still find what is inside.
+TEST_CASE( "quality_queries_look_inside_containers", "[tool][quality][visitable]" )
+{
+    item backpack( "test_backpack" );
+    item sonic( "test_sonic_screwdriver" );
+    REQUIRE( backpack.put_in( sonic, pocket_type::CONTAINER ).success() );
+
+    CHECK( backpack.max_quality( qual_PRY ) == 2 );
+    CHECK( backpack.max_quality( qual_DRILL ) == 0 );
+    CHECK( backpack.has_quality( qual_PRY, 2 ) );
+    CHECK_FALSE( backpack.has_quality( qual_PRY, 3 ) );
+    // The backpack counts as well, as it provides the quality of its contents.
+    CHECK( backpack.has_quality( qual_PRY, 2, 2 ) );
+    CHECK_FALSE( backpack.has_quality( qual_PRY, 2, 3 ) );
+
+    SECTION( "a full pot hides nothing from the search" ) {
+        item tin_can( "test_can_food" );
+        item broth( "test_liquid" );
+        tin_can.put_in( broth, pocket_type::CONTAINER );
+        REQUIRE( tin_can.get_quality( qual_BOIL ) == INT_MIN );
+        REQUIRE( backpack.put_in( tin_can, pocket_type::CONTAINER ).success() );
+        CHECK( backpack.max_quality( qual_BOIL ) == 0 );
+        CHECK_FALSE( backpack.has_quality( qual_BOIL, 1 ) );
+
+        item empty_can( "test_can_food" );
+        REQUIRE( backpack.put_in( empty_can, pocket_type::CONTAINER ).success() );
+        CHECK( backpack.max_quality( qual_BOIL ) == 1 );
+        CHECK( backpack.has_quality( qual_BOIL, 1, 2 ) );
+    }
+}
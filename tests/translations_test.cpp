@@ -3,6 +3,7 @@
 #include <vector>
 
 #include "cata_catch.h"
+#include "translation.h"
 #include "translations.h"
 
 // wrapping in another macro to prevent collection of the test string for translation
@@ -23,6 +24,23 @@ TEST_CASE( "translations_sanity_test", "[translations]" )
     CHECK( TRANSLATE_TRANSLATION( test_string ) == test_string );
 }
 
+// test should succeed both with and without the LOCALIZE
+TEST_CASE( "translations_plural_form_follows_count", "[translations]" )
+{
+    const std::string singular = "__untranslated_test_arrow__";
+    const std::string plural = "__untranslated_test_arrows__";
+    const translation arrows = pl_translation( singular, plural );
+    const translation ctxt_arrows = pl_translation( "__test_context__", singular, plural );
+
+    // the cached form has to change with the count, in both directions
+    for( const translation &tr : { arrows, ctxt_arrows } ) {
+        CHECK( tr.translated( 1 ) == singular );
+        CHECK( tr.translated( 2 ) == plural );
+        CHECK( tr.translated( 1 ) == singular );
+        CHECK( tr.translated( 5 ) == plural );
+    }
+}
+
 // assuming [en] language is used for this test
 // test should succeed both with and without the LOCALIZE
 TEST_CASE( "translations_macro_string_stability", "[translations]" )
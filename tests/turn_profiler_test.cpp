@@ -0,0 +1,61 @@
+#include "cata_catch.h"
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "turn_profiler.h"
+
+TEST_CASE( "turn_profiler_records_phases_per_turn", "[turn_profiler][nogame]" )
+{
+    turn_profiler::set_enabled( true );
+    for( int turn = 0; turn < 3; ++turn ) {
+        const turn_profiler::turn_scope scope( turn );
+        for( int i = 0; i < 2; ++i ) {
+            const turn_profiler::scoped_timer timer( turn_profiler::phase::monmove );
+        }
+    }
+    {
+        // Outside of a turn, so not recorded.
+        const turn_profiler::scoped_timer timer( turn_profiler::phase::items );
+    }
+    turn_profiler::set_enabled( false );
+    {
+        const turn_profiler::turn_scope scope( 99 );
+    }
+
+    const std::vector<turn_profiler::turn_record> turns = turn_profiler::recorded_turns();
+    REQUIRE( turns.size() == 3 );
+    for( size_t i = 0; i < turns.size(); ++i ) {
+        CHECK( turns[i].turn == static_cast<int64_t>( i ) );
+        CHECK( turns[i].calls[static_cast<size_t>( turn_profiler::phase::turn )] == 1 );
+        CHECK( turns[i].calls[static_cast<size_t>( turn_profiler::phase::monmove )] == 2 );
+        CHECK( turns[i].calls[static_cast<size_t>( turn_profiler::phase::items )] == 0 );
+    }
+
+    std::ostringstream csv;
+    turn_profiler::write_csv( csv );
+    const std::string csv_text = csv.str();
+    CHECK( csv_text.rfind( "turn,start_us,turn_us,turn_calls", 0 ) == 0 );
+    CHECK( std::count( csv_text.begin(), csv_text.end(), '\n' ) == 4 );
+
+    std::ostringstream trace;
+    turn_profiler::write_chrome_trace( trace );
+    CHECK( trace.str().find( "\"name\":\"monmove\"" ) != std::string::npos );
+}
+
+TEST_CASE( "turn_profiler_ring_buffer_keeps_latest_turns", "[turn_profiler][nogame]" )
+{
+    turn_profiler::set_enabled( true );
+    const int num_turns = static_cast<int>( turn_profiler::max_turns ) + 10;
+    for( int turn = 0; turn < num_turns; ++turn ) {
+        const turn_profiler::turn_scope scope( turn );
+    }
+    turn_profiler::set_enabled( false );
+
+    const std::vector<turn_profiler::turn_record> turns = turn_profiler::recorded_turns();
+    REQUIRE( turns.size() == turn_profiler::max_turns );
+    CHECK( turns.front().turn == 10 );
+    CHECK( turns.back().turn == num_turns - 1 );
+}
@@ -21,6 +21,8 @@ using efficiency_stat = statistics<long>;
 
 static const efftype_id effect_blind( "blind" );
 
+static const vproto_id vehicle_prototype_car( "car" );
+
 static void clear_game_drag( const ter_id &terrain )
 {
     // Set to turn 0 to prevent solars from producing power
@@ -150,6 +152,32 @@ TEST_CASE( "vehicle_drag_calc_baseline", "[.]" )
 
 // format is vehicle, coeff_air_drag, coeff_rolling_drag, coeff_water_drag, safe speed, max speed
 // coeffs are dimensionless, speeds are 100ths of mph, so 6101 is 61.01 mph
+TEST_CASE( "drag_follows_cargo_mass", "[vehicle]" )
+{
+    clear_game_drag( ter_id( "t_pavement" ) );
+    vehicle *veh_ptr = setup_drag_test( vehicle_prototype_car );
+    vehicle &veh = *veh_ptr;
+    const double rolling_per_kg = veh.coeff_rolling_drag() / to_kilogram( veh.total_mass() );
+
+    vehicle_part *cargo = nullptr;
+    for( const vpart_reference &vp : veh.get_avail_parts( "CARGO" ) ) {
+        cargo = &vp.part();
+        break;
+    }
+    REQUIRE( cargo != nullptr );
+    for( int i = 0; i < 20; i++ ) {
+        REQUIRE( veh.add_item( *cargo, item( "rock" ) ) );
+    }
+    const double loaded_kg = to_kilogram( veh.total_mass() );
+    const double loaded_draft = veh.water_draft();
+    CHECK( veh.coeff_rolling_drag() / loaded_kg == Approx( rolling_per_kg ) );
+
+    // the wheel and hull terms are unchanged, so a full refresh gives the same values
+    veh.refresh();
+    CHECK( veh.coeff_rolling_drag() / loaded_kg == Approx( rolling_per_kg ) );
+    CHECK( veh.water_draft() == Approx( loaded_draft ) );
+}
+
 TEST_CASE( "vehicle_drag", "[vehicle] [engine]" )
 {
     clear_game_drag( ter_id( "t_pavement" ) );
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -443,3 +444,32 @@ TEST_CASE( "open_and_close_fake_doors", "[vehicle][vehicle_fake]" )
     }
     REQUIRE( fakes_tested == 4 );
 }
+
+TEST_CASE( "cached_parts_at_relative_matches_part_scan", "[vehicle] [vehicle_fake]" )
+{
+    clear_avatar();
+    really_clear_map();
+    map &here = get_map();
+    vehicle *veh = here.add_vehicle( vehicle_prototype_test_van, tripoint_bub_ms( 30, 30, 0 ),
+                                     45_degrees, 100, 0 );
+    REQUIRE( veh != nullptr );
+    REQUIRE( num_fake_parts( *veh ) > 0 );
+
+    for( const vpart_reference &vp : veh->get_all_parts_with_fakes( true ) ) {
+        const point_rel_ms mount = vp.part().mount;
+        CAPTURE( mount );
+        std::vector<int> real_cached = veh->cached_parts_at_relative( mount );
+        std::vector<int> real_scanned = veh->parts_at_relative( mount, false );
+        std::sort( real_cached.begin(), real_cached.end() );
+        std::sort( real_scanned.begin(), real_scanned.end() );
+        CHECK( real_cached == real_scanned );
+
+        const std::vector<int> &with_fakes = veh->cached_parts_at_relative( mount, true );
+        for( const int p : with_fakes ) {
+            const bool listed_as_real = std::find( real_cached.begin(), real_cached.end(),
+                                                   p ) != real_cached.end();
+            CHECK( listed_as_real == !veh->part( p ).is_fake );
+        }
+    }
+    CHECK( veh->cached_parts_at_relative( point_rel_ms( 1000, 1000 ), true ).empty() );
+}
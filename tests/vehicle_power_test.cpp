@@ -11,6 +11,9 @@
 #include "type_id.h"
 #include "units.h"
 #include "vehicle.h"
+#include "veh_type.h"
+#include "vpart_position.h"
+#include "vpart_range.h"
 #include "weather.h"
 #include "weather_type.h"
 
@@ -37,6 +40,47 @@ static void reset_player()
     player_character.add_effect( effect_blind, 1_turns, true );
 }
 
+static void connect_debug_cord( map &here, const tripoint_bub_ms &source,
+                                const tripoint_bub_ms &target )
+{
+    const optional_vpart_position target_vp = here.veh_at( target );
+    const optional_vpart_position source_vp = here.veh_at( source );
+
+    item cord( "test_power_cord_25_loss" );
+    cord.set_var( "source_x", source.x() );
+    cord.set_var( "source_y", source.y() );
+    cord.set_var( "source_z", source.z() );
+    cord.set_var( "state", "pay_out_cable" );
+    cord.active = true;
+
+    if( !target_vp ) {
+        debugmsg( "missing target at %s", target.to_string() );
+    }
+    vehicle *const target_veh = &target_vp->vehicle();
+    vehicle *const source_veh = &source_vp->vehicle();
+    if( source_veh == target_veh ) {
+        debugmsg( "source same as target" );
+    }
+
+    tripoint_abs_ms target_global = here.getglobal( target );
+    const vpart_id vpid( cord.typeId().str() );
+
+    point vcoords = source_vp->mount();
+    vehicle_part source_part( vpid, item( cord ) );
+    source_part.target.first = target_global;
+    source_part.target.second = target_veh->global_square_location();
+    source_veh->install_part( vcoords, std::move( source_part ) );
+
+    vcoords = target_vp->mount();
+    vehicle_part target_part( vpid, item( cord ) );
+    tripoint_bub_ms source_global( cord.get_var( "source_x", 0 ),
+                                   cord.get_var( "source_y", 0 ),
+                                   cord.get_var( "source_z", 0 ) );
+    target_part.target.first = here.getglobal( source_global );
+    target_part.target.second = source_veh->global_square_location();
+    target_veh->install_part( vcoords, std::move( target_part ) );
+}
+
 TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
 {
     clear_vehicles();
@@ -44,45 +88,6 @@ TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
     build_test_map( ter_id( "t_pavement" ) );
     map &here = get_map();
 
-    const auto connect_debug_cord = [&here]( const tripoint_bub_ms & source,
-    const tripoint_bub_ms & target ) {
-        const optional_vpart_position target_vp = here.veh_at( target );
-        const optional_vpart_position source_vp = here.veh_at( source );
-
-        item cord( "test_power_cord_25_loss" );
-        cord.set_var( "source_x", source.x() );
-        cord.set_var( "source_y", source.y() );
-        cord.set_var( "source_z", source.z() );
-        cord.set_var( "state", "pay_out_cable" );
-        cord.active = true;
-
-        if( !target_vp ) {
-            debugmsg( "missing target at %s", target.to_string() );
-        }
-        vehicle *const target_veh = &target_vp->vehicle();
-        vehicle *const source_veh = &source_vp->vehicle();
-        if( source_veh == target_veh ) {
-            debugmsg( "source same as target" );
-        }
-
-        tripoint_abs_ms target_global = here.getglobal( target );
-        const vpart_id vpid( cord.typeId().str() );
-
-        point vcoords = source_vp->mount();
-        vehicle_part source_part( vpid, item( cord ) );
-        source_part.target.first = target_global;
-        source_part.target.second = target_veh->global_square_location();
-        source_veh->install_part( vcoords, std::move( source_part ) );
-
-        vcoords = target_vp->mount();
-        vehicle_part target_part( vpid, item( cord ) );
-        tripoint_bub_ms source_global( cord.get_var( "source_x", 0 ),
-                                       cord.get_var( "source_y", 0 ),
-                                       cord.get_var( "source_z", 0 ) );
-        target_part.target.first = here.getglobal( source_global );
-        target_part.target.second = source_veh->global_square_location();
-        target_veh->install_part( vcoords, std::move( target_part ) );
-    };
 
     const std::vector<tripoint_bub_ms> placements { { 4, 10, 0 }, { 6, 10, 0 }, { 8, 10, 0 } };
     std::vector<vpart_reference> batteries;
@@ -101,7 +106,7 @@ TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
     // connect first to second and second to third, each cord is 25% lossy
     // third battery will on average take twice as many charges to charge as the first
     for( size_t i = 0; i < placements.size() - 1; i++ ) {
-        connect_debug_cord( placements[i], placements[i + 1] );
+        connect_debug_cord( here, placements[i], placements[i + 1] );
     }
     const optional_vpart_position ovp_first = here.veh_at( placements[0] );
     REQUIRE( ovp_first.has_value() );
@@ -131,6 +136,43 @@ TEST_CASE( "power_loss_to_cables", "[vehicle][power]" )
     }
 }
 
+TEST_CASE( "connected_vehicles_follow_cable_changes", "[vehicle][power]" )
+{
+    clear_vehicles();
+    reset_player();
+    build_test_map( ter_id( "t_pavement" ) );
+    map &here = get_map();
+
+    const std::vector<tripoint_bub_ms> placements { { 4, 10, 0 }, { 6, 10, 0 } };
+    std::vector<vehicle *> vehicles;
+    for( const tripoint_bub_ms &p : placements ) {
+        vehicle *veh = here.add_vehicle( vehicle_prototype_none, p, 0_degrees, 0, 0 );
+        REQUIRE( veh != nullptr );
+        REQUIRE( veh->install_part( point_rel_ms_zero, vpart_frame ) != -1 );
+        REQUIRE( veh->install_part( point_rel_ms_zero, vpart_small_storage_battery ) != -1 );
+        veh->refresh();
+        here.add_vehicle_to_cache( veh );
+        vehicles.push_back( veh );
+    }
+    vehicle &first = *vehicles[0];
+
+    // Queried twice in the same turn, the second answer comes from the cache
+    CHECK( first.search_connected_vehicles().size() == 1 );
+    CHECK( first.search_connected_vehicles().size() == 1 );
+
+    connect_debug_cord( here, placements[0], placements[1] );
+    CHECK( first.search_connected_vehicles().size() == 2 );
+    CHECK( first.search_connected_batteries().size() == 2 );
+
+    for( vehicle *veh : vehicles ) {
+        for( const vpart_reference &vp : veh->get_any_parts( VPFLAG_POWER_TRANSFER ) ) {
+            veh->remove_part( vp.part() );
+        }
+        veh->part_removal_cleanup();
+    }
+    CHECK( first.search_connected_vehicles().size() == 1 );
+}
+
 TEST_CASE( "Solar_power", "[vehicle][power]" )
 {
     clear_vehicles();
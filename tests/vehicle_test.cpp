@@ -1,8 +1,10 @@
+#include <memory>
 #include <optional>
 #include <vector>
 
 #include "avatar.h"
 #include "cata_catch.h"
+#include "cata_utility.h"
 #include "character.h"
 #include "coordinate_constants.h"
 #include "damage.h"
@@ -53,6 +55,29 @@ TEST_CASE( "detaching_vehicle_unboards_passengers", "[vehicle]" )
     REQUIRE( !player_character.in_vehicle );
 }
 
+TEST_CASE( "vehicle_cache_updates_one_vehicle_at_a_time", "[vehicle]" )
+{
+    clear_map();
+    map &here = get_map();
+    const tripoint_bub_ms moved_origin( 60, 60, 0 );
+    const tripoint_bub_ms parked_origin( 60, 70, 0 );
+    vehicle *moved = here.add_vehicle( vehicle_prototype_bicycle, moved_origin, 0_degrees, 0, 0 );
+    vehicle *parked = here.add_vehicle( vehicle_prototype_bicycle, parked_origin, 0_degrees, 0, 0 );
+    REQUIRE( moved != nullptr );
+    REQUIRE( parked != nullptr );
+    REQUIRE( veh_pointer_or_null( here.veh_at( moved_origin ) ) == moved );
+    REQUIRE( veh_pointer_or_null( here.veh_at( parked_origin ) ) == parked );
+
+    here.displace_vehicle( *moved, tripoint_rel_ms( 5, 0, 0 ) );
+    CHECK_FALSE( here.veh_at( moved_origin ) );
+    CHECK( veh_pointer_or_null( here.veh_at( moved_origin + tripoint_rel_ms( 5, 0, 0 ) ) ) == moved );
+    CHECK( veh_pointer_or_null( here.veh_at( parked_origin ) ) == parked );
+
+    std::unique_ptr<vehicle> detached = here.detach_vehicle( moved );
+    CHECK_FALSE( here.veh_at( moved_origin + tripoint_rel_ms( 5, 0, 0 ) ) );
+    CHECK( veh_pointer_or_null( here.veh_at( parked_origin ) ) == parked );
+}
+
 TEST_CASE( "destroy_grabbed_vehicle_section", "[vehicle]" )
 {
     GIVEN( "A vehicle grabbed by the player" ) {
@@ -134,6 +159,58 @@ TEST_CASE( "starting_bicycle_damaged_pedal", "[vehicle]" )
     here.detach_vehicle( veh_ptr );
 }
 
+TEST_CASE( "breaking_a_part_updates_caches_like_a_full_refresh", "[vehicle]" )
+{
+    clear_map();
+    map &here = get_map();
+    vehicle *veh_ptr = here.add_vehicle( vehicle_prototype_car, tripoint_bub_ms( 60, 60, 0 ),
+                                         0_degrees, 0, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    vehicle &veh = *veh_ptr;
+    REQUIRE( !veh.engines.empty() );
+    REQUIRE( !veh.batteries.empty() );
+
+    for( const int p : { veh.engines[0], veh.batteries[0] } ) {
+        vehicle_part &vp = veh.part( p );
+        veh.set_hp( vp, 0, true );
+        REQUIRE( vp.is_broken() );
+        veh.refresh_unavailable_part( p );
+    }
+
+    const std::vector<int> engines = veh.engines;
+    const std::vector<int> batteries = veh.batteries;
+    const std::vector<int> fuel_containers = veh.fuel_containers;
+    const std::vector<int> emitters = veh.emitters;
+    const std::vector<int> floating = veh.floating;
+    const units::power extra_drag = veh.extra_drag;
+    veh.refresh( false );
+    CHECK( engines == veh.engines );
+    CHECK( batteries == veh.batteries );
+    CHECK( fuel_containers == veh.fuel_containers );
+    CHECK( emitters == veh.emitters );
+    CHECK( floating == veh.floating );
+    CHECK( extra_drag == veh.extra_drag );
+}
+
+TEST_CASE( "vehicle_part_serialization_roundtrips_without_default_members", "[vehicle]" )
+{
+    clear_map();
+    vehicle *veh_ptr = get_map().add_vehicle( vehicle_prototype_car, tripoint_bub_ms( 60, 60, 0 ),
+                                              0_degrees, 0, 0 );
+    REQUIRE( veh_ptr != nullptr );
+    for( const vpart_reference &vp : veh_ptr->get_all_parts() ) {
+        const vehicle_part &part = vp.part();
+        const std::string json = serialize( part );
+        CAPTURE( json );
+        if( veh_ptr->get_items( vp.part() ).empty() ) {
+            CHECK( json.find( "\"items\"" ) == std::string::npos );
+        }
+        vehicle_part loaded;
+        deserialize_from_string( loaded, json );
+        CHECK( serialize( loaded ) == json );
+    }
+}
+
 struct vehicle_preset {
     itype_id vehicle_itype_id; // folding vehicle to test
     std::vector<itype_id> tool_itype_ids; // tool to grant
@@ -15,10 +15,13 @@
 #include "character.h"
 #include "game.h"
 #include "item.h"
+#include "level_cache.h"
+#include "lightmap.h"
 #include "map.h"
 #include "map_helpers.h"
 #include "map_test_case.h"
 #include "mapdata.h"
+#include "mdarray.h"
 #include "mtype.h"
 #include "options_helpers.h"
 #include "player_helpers.h"
@@ -1171,3 +1174,56 @@ TEST_CASE( "pl_sees-oob-nocrash", "[vision]" )
 
     clear_avatar();
 }
+
+TEST_CASE( "vision_incremental_lightmap_matches_full_rebuild", "[shadowcasting][vision]" )
+{
+    clear_map();
+    clear_avatar();
+    set_time( midnight );
+    map &here = get_map();
+    const int z = get_avatar().posz();
+    const tripoint_bub_ms origin = get_avatar().pos_bub();
+
+    here.ter_set( origin + tripoint( 10, 0, 0 ), ter_t_utility_light );
+    here.ter_set( origin + tripoint( -30, 5, 0 ), ter_t_utility_light );
+    here.invalidate_map_cache( z );
+    here.build_map_cache( z );
+
+    // Only the first light is near the change, the second one is reused.
+    here.ter_set( origin + tripoint( 8, 0, 0 ), ter_t_brick_wall );
+    here.ter_set( origin + tripoint( 12, 3, 0 ), ter_t_utility_light );
+    here.build_map_cache( z );
+    const level_cache &cache = here.access_cache( z );
+    // The light maps are too large for the stack.
+    const auto incremental_lm = std::make_unique<cata::mdarray<four_quadrants, point_bub_ms>>
+                                ( cache.lm );
+    const auto incremental_sm = std::make_unique<cata::mdarray<float, point_bub_ms>>( cache.sm );
+
+    here.invalidate_map_cache( z );
+    here.build_map_cache( z );
+
+    for( int x = 0; x < MAPSIZE_X; ++x ) {
+        for( int y = 0; y < MAPSIZE_Y; ++y ) {
+            CAPTURE( x, y );
+            CHECK( ( *incremental_lm )[x][y].to_string() == cache.lm[x][y].to_string() );
+            CHECK( ( *incremental_sm )[x][y] == cache.sm[x][y] );
+        }
+    }
+}
+
+TEST_CASE( "vision_generation_follows_changes_to_what_blocks_sight", "[vision]" )
+{
+    clear_map();
+    clear_avatar();
+    map &here = get_map();
+    const int z = get_avatar().posz();
+    here.build_map_cache( z );
+    const int before = here.get_vision_generation();
+
+    here.build_map_cache( z );
+    CHECK( here.get_vision_generation() == before );
+
+    here.ter_set( get_avatar().pos_bub() + tripoint( 5, 0, 0 ), ter_t_brick_wall );
+    here.build_map_cache( z );
+    CHECK( here.get_vision_generation() != before );
+}
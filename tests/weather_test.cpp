@@ -6,8 +6,11 @@
 #include "calendar.h"
 #include "cata_catch.h"
 #include "cata_scope_helpers.h"
+#include "item.h"
 #include "options_helpers.h"
 #include "point.h"
+#include "rng.h"
+#include "trap.h"
 #include "type_id.h"
 #include "weather.h"
 #include "weather_gen.h"
@@ -471,3 +474,47 @@ TEST_CASE( "local_wind_chill_calculation", "[weather][wind_chill]" )
     }
 }
 
+TEST_CASE( "weather_sums_are_shared_within_an_overmap_tile", "[weather]" )
+{
+    const time_point start = calendar::turn_zero + 10_days;
+    const time_point end = start + 3_days;
+    const tripoint_abs_ms corner( 1200, 2400, 0 );
+    const tripoint_abs_ms inside = corner + tripoint( 13, 7, 0 );
+    REQUIRE( project_to<coords::omt>( corner ) == project_to<coords::omt>( inside ) );
+
+    const weather_sum at_corner = sum_conditions( start, end, corner );
+    const weather_sum at_inside = sum_conditions( start, end, inside );
+    CHECK( at_corner.rain_amount == at_inside.rain_amount );
+    CHECK( at_corner.sunlight == Approx( at_inside.sunlight ) );
+    CHECK( at_corner.radiant_exposure == Approx( at_inside.radiant_exposure ) );
+    CHECK( at_corner.sunlight > 0.0f );
+
+    SECTION( "overridden weather is used for every tick" ) {
+        scoped_weather_override clear_sky( WEATHER_CLEAR );
+        const weather_sum clear = sum_conditions( start, end, corner );
+        CHECK( clear.rain_amount == 0 );
+        CHECK( clear.sunlight >= at_corner.sunlight );
+    }
+}
+
+TEST_CASE( "funnels_fill_the_same_from_a_shared_weather_sum", "[weather]" )
+{
+    scoped_weather_override rain( weather_type_id( "rain" ) );
+    const trap &funnel = trap_str_id( "tr_funnel" ).obj();
+    const time_point end = calendar::turn;
+    const time_point start = end - 2_days;
+    const tripoint_abs_ms pos( 1200, 2400, 0 );
+    const weather_sum shared = sum_conditions( start, end, pos );
+    REQUIRE( shared.rain_amount > 0 );
+
+    item by_span( "jug_plastic" );
+    item by_sum( "jug_plastic" );
+    rng_set_engine_seed( 1234 );
+    retroactively_fill_from_funnel( by_span, funnel, start, end, pos );
+    rng_set_engine_seed( 1234 );
+    retroactively_fill_from_funnel( by_sum, funnel, end, shared );
+
+    CHECK( by_sum.total_contained_volume() == by_span.total_contained_volume() );
+    CHECK( by_sum.birthday() == end );
+    CHECK( by_span.birthday() == end );
+}
@@ -0,0 +1,319 @@
+// cata_bench: loads an existing world without initializing curses or SDL, replays a
+// scripted sequence of avatar actions for a fixed number of turns and reports the
+// latency distribution of do_turn().
+//
+// Usage:
+//   cata_bench --world <name> [--user-dir <dir>] [--turns <n>] [--seed <n>]
+//              [--script wait:100,walk:100,drive:100] [--csv <file>] [--profile <file>]
+//
+// The script is repeated until the requested number of turns has run.  The world is
+// never saved, so the same save can be benchmarked over and over.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "avatar.h"
+#include "avatar_action.h"
+#include "cached_options.h"
+#include "cata_utility.h"
+#include "color.h"
+#include "debug.h"
+#include "do_turn.h"
+#include "filesystem.h"
+#include "game.h"
+#include "help.h"
+#include "map.h"
+#include "options.h"
+#include "path_info.h"
+#include "point.h"
+#include "ret_val.h"
+#include "rng.h"
+#include "string_formatter.h"
+#include "translations.h"
+#include "try_parse_integer.h"
+#include "turn_profiler.h"
+#include "vehicle.h"
+#include "vpart_position.h"
+
+namespace
+{
+
+enum class bench_action : int {
+    wait,
+    walk,
+    drive
+};
+
+struct script_step {
+    bench_action action = bench_action::wait;
+    int turns = 0;
+};
+
+struct bench_options {
+    std::string world;
+    std::string user_dir = "./";
+    int turns = 1000;
+    unsigned int seed = 42;
+    std::vector<script_step> script = { { bench_action::wait, 1 } };
+    std::string csv_path;
+    std::string profile_path;
+};
+
+// Cruise speed used for the "drive" steps, in vehicle velocity units (0.01 mph).
+constexpr int drive_velocity = 2000;
+// Walk in a square of this many steps per side, so the avatar stays near the start.
+constexpr int walk_side = 8;
+
+void print_usage()
+{
+    printf( "Usage: cata_bench --world <name> [--user-dir <dir>] [--turns <n>] [--seed <n>]\n"
+            "                  [--script <action:turns,…>] [--csv <file>] [--profile <file>]\n"
+            "\n"
+            "Actions are wait, walk and drive.  The script repeats until <n> turns have run.\n"
+            "--csv writes the latency of every turn, --profile the per-phase turn profile.\n" );
+}
+
+std::optional<std::vector<script_step>> parse_script( const std::string &text )
+{
+    std::vector<script_step> result;
+    for( const std::string &part : string_split( text, ',' ) ) {
+        const std::vector<std::string> fields = string_split( part, ':' );
+        if( fields.size() != 2 ) {
+            return std::nullopt;
+        }
+        script_step step;
+        if( fields[0] == "wait" ) {
+            step.action = bench_action::wait;
+        } else if( fields[0] == "walk" ) {
+            step.action = bench_action::walk;
+        } else if( fields[0] == "drive" ) {
+            step.action = bench_action::drive;
+        } else {
+            return std::nullopt;
+        }
+        ret_val<int> turns = try_parse_integer<int>( fields[1], false );
+        if( !turns.success() || turns.value() <= 0 ) {
+            return std::nullopt;
+        }
+        step.turns = turns.value();
+        result.push_back( step );
+    }
+    if( result.empty() ) {
+        return std::nullopt;
+    }
+    return result;
+}
+
+std::optional<bench_options> parse_args( int argc, const char *argv[] )
+{
+    bench_options opts;
+    for( int i = 1; i < argc; ++i ) {
+        const std::string arg = argv[i];
+        if( i + 1 >= argc ) {
+            printf( "Missing value for %s\n", arg.c_str() );
+            return std::nullopt;
+        }
+        const std::string value = argv[++i];
+        if( arg == "--world" ) {
+            opts.world = value;
+        } else if( arg == "--user-dir" ) {
+            opts.user_dir = value;
+        } else if( arg == "--turns" || arg == "--seed" ) {
+            ret_val<int> n = try_parse_integer<int>( value, false );
+            if( !n.success() || n.value() < 0 ) {
+                printf( "Invalid value for %s: %s\n", arg.c_str(), value.c_str() );
+                return std::nullopt;
+            }
+            if( arg == "--turns" ) {
+                opts.turns = n.value();
+            } else {
+                opts.seed = static_cast<unsigned int>( n.value() );
+            }
+        } else if( arg == "--script" ) {
+            std::optional<std::vector<script_step>> script = parse_script( value );
+            if( !script ) {
+                printf( "Invalid script: %s\n", value.c_str() );
+                return std::nullopt;
+            }
+            opts.script = std::move( *script );
+        } else if( arg == "--csv" ) {
+            opts.csv_path = value;
+        } else if( arg == "--profile" ) {
+            opts.profile_path = value;
+        } else {
+            printf( "Unknown argument %s\n", arg.c_str() );
+            return std::nullopt;
+        }
+    }
+    if( opts.world.empty() ) {
+        printf( "--world is required\n" );
+        return std::nullopt;
+    }
+    if( !string_ends_with( opts.user_dir, "/" ) ) {
+        opts.user_dir += "/";
+    }
+    return opts;
+}
+
+bool init_game( const bench_options &opts )
+{
+    PATH_INFO::init_base_path( "" );
+    PATH_INFO::init_user_dir( opts.user_dir );
+    PATH_INFO::set_standard_filenames();
+
+    get_options().init();
+    get_options().load();
+    init_colors();
+    set_language_from_options();
+
+    rng_set_engine_seed( opts.seed );
+
+    g = std::make_unique<game>();
+    g->load_static_data();
+    get_help().load();
+    // Loads the world's mods and its first save.
+    return g->load( opts.world );
+}
+
+vehicle *controlled_vehicle( avatar &u )
+{
+    if( !u.in_vehicle || !u.controlling_vehicle ) {
+        return nullptr;
+    }
+    return veh_pointer_or_null( get_map().veh_at( u.pos_bub() ) );
+}
+
+// Spends the avatar's moves for one turn, so do_turn never waits for input.
+void perform( bench_action action, int step_turn )
+{
+    avatar &u = get_avatar();
+    map &here = get_map();
+    vehicle *veh = controlled_vehicle( u );
+
+    if( action == bench_action::drive && veh != nullptr ) {
+        veh->engine_on = true;
+        veh->cruise_velocity = drive_velocity;
+    } else if( veh != nullptr ) {
+        veh->cruise_velocity = 0;
+    }
+
+    if( action == bench_action::walk && veh == nullptr ) {
+        static const std::array<point, 4> directions = { { point_east, point_south, point_west, point_north } };
+        const point &dir = directions[( step_turn / walk_side ) % directions.size()];
+        // A blocked step still costs the rest of the turn below.
+        for( int attempt = 0; attempt < 4 && u.get_moves() > 0; ++attempt ) {
+            if( !avatar_action::move( u, here, dir ) ) {
+                break;
+            }
+        }
+    }
+
+    if( u.get_moves() > 0 ) {
+        u.set_moves( 0 );
+    }
+}
+
+double percentile( const std::vector<double> &sorted, double p )
+{
+    if( sorted.empty() ) {
+        return 0.0;
+    }
+    const size_t index = std::min( sorted.size() - 1,
+                                   static_cast<size_t>( p * static_cast<double>( sorted.size() ) ) );
+    return sorted[index];
+}
+
+} // namespace
+
+int main( int argc, const char *argv[] )
+{
+    std::optional<bench_options> opts = parse_args( argc, argv );
+    if( !opts ) {
+        print_usage();
+        return EXIT_FAILURE;
+    }
+
+    // Keeps curses and SDL uninitialized and makes UI code skip drawing and prompts.
+    test_mode = true;
+    setupDebug( DebugOutput::std_err );
+
+    try {
+        if( !init_game( *opts ) ) {
+            printf( "Failed to load world \"%s\"\n", opts->world.c_str() );
+            return EXIT_FAILURE;
+        }
+    } catch( const std::exception &err ) {
+        printf( "Failed to load world \"%s\": %s\n", opts->world.c_str(), err.what() );
+        return EXIT_FAILURE;
+    }
+
+    if( std::any_of( opts->script.begin(), opts->script.end(), []( const script_step & s ) {
+    return s.action == bench_action::drive;
+} ) && controlled_vehicle( get_avatar() ) == nullptr ) {
+        printf( "Warning: the avatar is not controlling a vehicle, drive steps will wait instead.\n" );
+    }
+
+    // Reseed after loading, so the turns don't depend on how much randomness loading used.
+    rng_set_engine_seed( opts->seed );
+    turn_profiler::set_enabled( !opts->profile_path.empty() );
+
+    std::vector<double> latencies;
+    latencies.reserve( opts->turns );
+    size_t step_index = 0;
+    int step_turn = 0;
+    for( int turn = 0; turn < opts->turns; ++turn ) {
+        const script_step &step = opts->script[step_index];
+        perform( step.action, step_turn );
+        if( ++step_turn >= step.turns ) {
+            step_turn = 0;
+            step_index = ( step_index + 1 ) % opts->script.size();
+        }
+
+        const auto start = std::chrono::steady_clock::now();
+        const bool game_over = do_turn();
+        const auto end = std::chrono::steady_clock::now();
+        latencies.push_back( std::chrono::duration<double, std::milli>( end - start ).count() );
+        if( game_over ) {
+            printf( "Game over after %d turns.\n", turn + 1 );
+            break;
+        }
+    }
+    turn_profiler::set_enabled( false );
+
+    if( !opts->csv_path.empty() ) {
+        write_to_file( opts->csv_path, [&]( std::ostream & fout ) {
+            fout << "turn,ms\n";
+            for( size_t i = 0; i < latencies.size(); ++i ) {
+                fout << i << ',' << latencies[i] << '\n';
+            }
+        }, "turn latencies" );
+    }
+    if( !opts->profile_path.empty() ) {
+        write_to_file( opts->profile_path, []( std::ostream & fout ) {
+            turn_profiler::write_csv( fout );
+        }, "turn profile" );
+    }
+
+    std::vector<double> sorted = latencies;
+    std::sort( sorted.begin(), sorted.end() );
+    double total = 0.0;
+    for( double ms : sorted ) {
+        total += ms;
+    }
+    printf( "turns: %zu  total: %.1f ms  mean: %.3f ms\n", sorted.size(), total,
+            sorted.empty() ? 0.0 : total / static_cast<double>( sorted.size() ) );
+    printf( "p50: %.3f ms  p90: %.3f ms  p99: %.3f ms  max: %.3f ms\n",
+            percentile( sorted, 0.50 ), percentile( sorted, 0.90 ), percentile( sorted, 0.99 ),
+            sorted.empty() ? 0.0 : sorted.back() );
+
+    return debug_has_error_been_observed() ? EXIT_FAILURE : EXIT_SUCCESS;
+}